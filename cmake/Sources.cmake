@@ -34,23 +34,36 @@ endif()
 set(LUMINOVEAU_SOURCES
     # Platform
     src/platform/audio/audio.cpp
+    src/platform/audio/dsp.cpp
+    src/platform/audio/musicstream.cpp
+    src/platform/cpu/cputopology.cpp
     src/platform/input/inputdevice.cpp
     src/platform/input/input.cpp
+    src/platform/input/replay.cpp
     src/platform/input/virtualcontrols.cpp
     src/platform/window/window.cpp
     src/platform/net/net.cpp
+    src/platform/net/packetpool.cpp
+    src/platform/net/impairment.cpp
+    src/platform/net/loopback.cpp
+    src/platform/net/reliable.cpp
+    src/platform/net/replication.cpp
 
     # Core
     src/core/eventbus/eventbus.cpp
     src/core/settings/settings.cpp
+    src/core/timestep/timestep.cpp
     src/core/log/log.cpp
     src/core/log/logentry.cpp
+    src/core/log/logrecord.cpp
     src/core/log/sinks/sdlconsolesink.cpp
+    src/core/log/sinks/binaryfilesink.cpp
     src/core/log/sinks/filesink.cpp
     src/core/log/sinks/memorybuffersink.cpp
 
     # Profiler
     src/profiler/perf.cpp
+    src/profiler/profiler.cpp
 
     # File
     src/file/filehandler.cpp
@@ -61,11 +74,16 @@ set(LUMINOVEAU_SOURCES
     src/math/vectors.cpp
 
     # Util
+    src/util/hash.cpp
     src/util/helpers.cpp
     src/util/lerp.cpp
+    src/util/random.cpp
+    src/util/spatialindex.cpp
+    src/util/tween.cpp
 
     # GPU
     src/gpu/buffer/buffermanager.cpp
+    src/gpu/memory/gpumemory.cpp
     src/gpu/IGpu.cpp
 
     # Renderer
@@ -74,6 +92,8 @@ set(LUMINOVEAU_SOURCES
     # Assets
     src/assets/assethandler.cpp
     src/assets/DroidSansMono.cpp
+    src/assets/effect/effectfusion.cpp
+    src/assets/font/glyphatlas.cpp
 
     # Scene
     src/scene/scene3d.cpp
@@ -141,15 +161,26 @@ set(LUMINOVEAU_HEADERS
     src/math/constants.h
     src/math/easings.h
     src/math/rectangles.h
+    src/math/simd.h
     src/math/vectors.h
 
     # Types
     src/types/color.h
 
     # Util
+    src/util/arena.h
+    src/util/hash.h
     src/util/helpers.h
     src/util/lerp.h
     src/util/quadtree.h
+    src/util/random.h
+    src/util/spatialindex.h
+    src/util/tween.h
+    src/util/mpscqueue.h
+    src/util/spscqueue.h
+
+    # Profiler
+    src/profiler/profiler.h
 
     # GPU buffer
     src/gpu/buffer/uniformobject.h
@@ -164,6 +195,7 @@ set(LUMINOVEAU_HEADERS
     src/gpu/geometry/geometry2d.h
     src/gpu/buffer/buffer.h
     src/gpu/buffer/buffermanager.h
+    src/gpu/memory/gpumemory.h
 
     # GPU backends
     src/gpu/backends/sdl/SdlGpuBackend.h
@@ -178,12 +210,15 @@ set(LUMINOVEAU_HEADERS
     src/assets/texture/texture.h
     src/assets/shader/shader.h
     src/assets/font/font.h
+    src/assets/font/glyphatlas.h
+    src/assets/font/skylinepacker.h
     src/assets/audio/sound.h
     src/assets/audio/music.h
     src/assets/audio/pcmsound.h
     src/assets/model/model.h
     src/assets/effect/effect.h
     src/assets/effect/effects.h
+    src/assets/effect/effectfusion.h
     src/assets/compute/computepipeline.h
 
     # Renderer
@@ -199,15 +234,20 @@ set(LUMINOVEAU_HEADERS
     src/core/enginestate/enginestate.h
     src/core/settings/settings.h
     src/core/settings/mini.h
+    src/core/timestep/timestep.h
     src/core/state/state.h
     src/core/state/basestate.h
     src/core/log/log.h
 
     # Platform
     src/platform/audio/audio.h
+    src/platform/audio/dsp.h
+    src/platform/audio/musicstream.h
+    src/platform/cpu/cputopology.h
     src/platform/input/input.h
     src/platform/input/inputconstants.h
     src/platform/input/inputdevice.h
+    src/platform/input/replay.h
     src/platform/input/virtualcontrols.h
     src/platform/window/window.h
 
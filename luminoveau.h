@@ -9,6 +9,8 @@
 #include <math/constants.h>
 #include <util/helpers.h>
 #include <util/lerp.h>
+#include <util/random.h>
+#include <util/tween.h>
 #include <math/rectangles.h>
 #include <math/vectors.h>
 
@@ -30,6 +32,7 @@
 #include <gpu/presets.h>
 #include <gpu/buffer/buffer.h>
 #include <gpu/buffer/buffermanager.h>
+#include <gpu/memory/gpumemory.h>
 
 // SDL-backend type converters (toSDL / fromSDL). SDL-only — the WebGPU build has no
 // SDL_GPU types, so it's excluded there. Projects doing SDL interop (e.g. swapchain
@@ -42,7 +45,9 @@
 #include <assets/assethandler.h>
 #include <platform/audio/audio.h>
 #include <core/eventbus/eventbus.h>
+#include <core/timestep/timestep.h>
 #include <platform/input/input.h>
+#include <platform/input/replay.h>
 #include <platform/net/net.h>
 #include <renderer/renderer.h>
 #include <platform/window/window.h>
@@ -53,6 +58,7 @@
 #include <draw/particles.h>
 #include <draw/text.h>
 #include <profiler/perf.h>
+#include <profiler/profiler.h>
 
 // ── Scene ────────────────────────────────────────────────────────────────────
 #include <scene/camera.h>
@@ -2,7 +2,11 @@
 #include "platform/window/window.h"
 #include "core/log/log.h"
 #include "file/filehandler.h"
+#include "platform/audio/musicstream.h"
 #include "util/helpers.h"
+#include "gpu/memory/gpumemory.h"
+#include "profiler/profiler.h"
+#include "assets/font/glyphatlas.h"
 
 #include <iostream>
 #include <vector>
@@ -21,7 +25,110 @@
 #include <msdf-atlas-gen/msdf-atlas-gen.h>
 #include <msdfgen/msdfgen.h>
 
-#include "picosha2.h"
+#include "util/hash.h"
+
+namespace {
+// Same scale, range and miter as the baked atlases (tools/font_baker), so dynamic glyphs
+// match them and draw through the same MSDF shader path
+constexpr int    GLYPH_GENERATION_SIZE = 64;
+constexpr double GLYPH_PIXEL_RANGE     = 4.0;
+
+// Where a dynamic atlas gets its outlines. A FreeType face isn't thread-safe, so loading an
+// outline is serialized; edge colouring and MSDF generation run in parallel on the workers.
+struct GlyphSource {
+    std::mutex           mutex;
+    msdfgen::FontHandle *handle        = nullptr;
+    double               geometryScale = 0.0;
+
+    // Opened on the first glyph when set (the default font, whose baked atlas usually
+    // suffices); the face is then owned here
+    const unsigned char     *data     = nullptr;
+    size_t                   size     = 0;
+    msdfgen::FreetypeHandle *freetype = nullptr;
+
+    ~GlyphSource() {
+        if (freetype) {
+            if (handle)
+                msdfgen::destroyFont(handle);
+            msdfgen::deinitializeFreetype(freetype);
+        }
+    }
+};
+
+double geometryScaleOf(msdfgen::FontHandle *handle) {
+    msdf_atlas::FontGeometry geometry;
+    geometry.loadMetrics(handle, 1.0);
+    return geometry.getGeometryScale();
+}
+
+bool rasterizeGlyph(GlyphSource &source, uint32_t codepoint, GlyphBitmap &out) {
+    LUMI_ZONE("AssetHandler::RasterizeGlyph");
+    msdf_atlas::GlyphGeometry glyph;
+    {
+        std::lock_guard<std::mutex> lock(source.mutex);
+        if (!source.handle && source.data) {
+            source.freetype = msdfgen::initializeFreetype();
+            if (source.freetype)
+                source.handle = msdfgen::loadFontData(source.freetype, source.data, static_cast<int>(source.size));
+            if (source.handle)
+                source.geometryScale = geometryScaleOf(source.handle);
+            source.data = nullptr; // one attempt
+        }
+        if (!source.handle || !glyph.load(source.handle, source.geometryScale, codepoint))
+            return false;
+    }
+
+    out.metrics.codepoint = codepoint;
+    out.metrics.advance   = glyph.getAdvance();
+    if (glyph.isWhitespace())
+        return true;
+
+    glyph.edgeColoring(&msdfgen::edgeColoringInkTrap, 3.0, 0);
+
+    msdf_atlas::TightAtlasPacker packer;
+    packer.setDimensionsConstraint(msdf_atlas::DimensionsConstraint::NONE);
+    packer.setMinimumScale(GLYPH_GENERATION_SIZE);
+    packer.setPixelRange(GLYPH_PIXEL_RANGE);
+    packer.setMiterLimit(1.0);
+    if (packer.pack(&glyph, 1) != 0)
+        return false;
+    int width = 0, height = 0;
+    packer.getDimensions(width, height);
+
+    msdf_atlas::ImmediateAtlasGenerator<
+        float, 3,
+        msdf_atlas::msdfGenerator,
+        msdf_atlas::BitmapAtlasStorage<unsigned char, 3>>
+        generator(width, height);
+    generator.setThreadCount(1); // one glyph per job; the parallelism is across jobs
+    generator.generate(&glyph, 1);
+    msdfgen::BitmapConstRef<unsigned char, 3> bitmap = generator.atlasStorage();
+
+    glyph.getQuadPlaneBounds(out.metrics.pl, out.metrics.pb, out.metrics.pr, out.metrics.pt);
+    glyph.getQuadAtlasBounds(out.metrics.al, out.metrics.ab, out.metrics.ar, out.metrics.at);
+
+    out.width  = width;
+    out.height = height;
+    out.rgba.resize(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const unsigned char *pixel = bitmap(x, height - 1 - y);
+            uint8_t             *dst   = &out.rgba[(static_cast<size_t>(y) * width + x) * 4];
+            dst[0]                     = pixel[0];
+            dst[1]                     = pixel[1];
+            dst[2]                     = pixel[2];
+            dst[3]                     = 255;
+        }
+    }
+    return true;
+}
+
+GlyphAtlas::Rasterizer glyphRasterizer(std::shared_ptr<GlyphSource> source) {
+    return [source = std::move(source)](uint32_t codepoint, GlyphBitmap &out) {
+        return rasterizeGlyph(*source, codepoint, out);
+    };
+}
+} // namespace
 
 AssetHandler::AssetHandler() {
     // Reserve space to prevent map reallocation (important since we return references!)
@@ -37,16 +144,18 @@ AssetHandler::AssetHandler() {
 
     // Load default font using MSDF from embedded data
 
-    // Compute hash of embedded font data for cache validation
-    std::string embeddedHash = _computeFontCacheKeyFromData(DROID_SANS_MONO_TTF, DROID_SANS_MONO_TTF_LEN);
-
-    bool loaded = false;
+    GpuMemoryScope memScope(GpuMemoryCategory::Fonts, "AssetHandler");
+    bool           loaded = false;
 #if defined(LUMINOVEAU_HAVE_FONT_ATLAS_BLOB)
     // Prefer the baked atlas blob: no MSDF generation, and no dependence on a persistent cache
     // (Emscripten MEMFS is wiped each reload, so the runtime font cache never survives on the web).
     loaded = _loadDefaultFontFromBlob(_defaultFont);
 #endif
-    // Otherwise the on-disk font cache; generate from scratch only as a last resort.
+    // Otherwise the on-disk font cache, validated by a hash of the embedded data (not needed
+    // with the blob); generate from scratch only as a last resort.
+    std::string embeddedHash;
+    if (!loaded)
+        embeddedHash = _computeFontCacheKeyFromData(DROID_SANS_MONO_TTF, DROID_SANS_MONO_TTF_LEN);
     if (!loaded && !_loadFontFromCache("__default_font__", 16, _defaultFont, embeddedHash)) {
         // Cache miss — generate from scratch
         LOG_INFO("Default font not in cache, generating MSDF atlas");
@@ -99,7 +208,7 @@ AssetHandler::AssetHandler() {
             msdf_atlas::BitmapAtlasStorage<unsigned char, 3>>
             generator(_defaultFont.atlasWidth, _defaultFont.atlasHeight);
 
-        generator.setThreadCount(Platform::DefaultThreadCount());
+        generator.setThreadCount(Platform::ThreadBudget());
         generator.generate(msdfGlyphs.data(), msdfGlyphs.size());
 
         msdfgen::BitmapConstRef<unsigned char, 3> bitmap = generator.atlasStorage();
@@ -155,6 +264,14 @@ AssetHandler::AssetHandler() {
         // Save to cache for next startup
         _saveFontToCache("__default_font__", _defaultFont, rgbaData, embeddedHash);
     }
+
+    // Anything outside the baked range is rasterized on demand from the embedded TTF; page 0
+    // is the baked atlas
+    auto source  = std::make_shared<GlyphSource>();
+    source->data = DROID_SANS_MONO_TTF;
+    source->size = DROID_SANS_MONO_TTF_LEN;
+
+    _defaultFont.atlas = new GlyphAtlas(glyphRasterizer(std::move(source)), Platform::Workers(ThreadRole::Background), 1);
 };
 
 void AssetHandler::_cleanup() {
@@ -190,28 +307,8 @@ void AssetHandler::_cleanup() {
     _computePipelines.clear();
 
     // Cleanup fonts
-    for (auto &[name, font] : _fonts) {
-        if (font.fontHandle) {
-            msdfgen::destroyFont(font.fontHandle);
-            font.fontHandle = nullptr;
-        }
-        if (font.glyphs) {
-            delete font.glyphs;
-            font.glyphs = nullptr;
-        }
-        if (font.glyphMap) {
-            delete font.glyphMap;
-            font.glyphMap = nullptr;
-        }
-        if (font.atlasTexture) {
-            gpu.ReleaseTexture(font.atlasTexture);
-            font.atlasTexture = 0;
-        }
-        if (font.fontData) {
-            free(font.fontData);
-            font.fontData = nullptr;
-        }
-    }
+    for (auto &[name, font] : _fonts)
+        _releaseFont(font);
     _fonts.clear();
 
     // Cleanup sounds
@@ -230,41 +327,12 @@ void AssetHandler::_cleanup() {
 
     // Cleanup music
     for (auto &[name, music] : _musics) {
-        if (music.music) {
-            ma_sound_uninit(music.music);
-            delete music.music;
-            music.music = nullptr;
-        }
-        if (music.decoder) { // uninit before freeing the bytes it reads from
-            ma_decoder_uninit(music.decoder);
-            delete music.decoder;
-            music.decoder = nullptr;
-        }
-        if (music.fileData) {
-            free(music.fileData);
-            music.fileData = nullptr;
-        }
+        _releaseMusic(music);
     }
     _musics.clear();
 
-    // Cleanup default font
-    if (_defaultFont.fontHandle) {
-        msdfgen::destroyFont(_defaultFont.fontHandle);
-        _defaultFont.fontHandle = nullptr;
-    }
-    if (_defaultFont.glyphs) {
-        delete _defaultFont.glyphs;
-        _defaultFont.glyphs = nullptr;
-    }
-    if (_defaultFont.glyphMap) {
-        delete _defaultFont.glyphMap;
-        _defaultFont.glyphMap = nullptr;
-    }
-    if (_defaultFont.atlasTexture) {
-        gpu.ReleaseTexture(_defaultFont.atlasTexture);
-        _defaultFont.atlasTexture = 0;
-    }
-    // Note: defaultFont.fontData is NOT allocated (uses embedded data), so no need to free
+    // Cleanup default font (its TTF is embedded data, not an owned fontData)
+    _releaseFont(_defaultFont);
 
     // Cleanup font cache
     if (_fontCache) {
@@ -287,6 +355,8 @@ Texture AssetHandler::_getTexture(const std::string &fileName) {
 }
 
 TextureAsset AssetHandler::_loadTexture(const std::string &fileName) {
+    LUMI_ZONE("AssetHandler::LoadTexture");
+    GpuMemoryScope memScope(GpuMemoryCategory::Textures, "AssetHandler");
 
     if (!Renderer::IsReady()) {
         LOG_WARNING("Skipping texture load after shutdown: {}", fileName);
@@ -368,7 +438,8 @@ TextureAsset AssetHandler::_loadTexture(const std::string &fileName) {
 
 // Uncached load to a GPU asset; dispatches KTX2/Basis (transcode -> BC) vs SDL_image (RGBA8).
 TextureAsset AssetHandler::_loadTextureFile(const std::string &path) {
-    TextureAsset out;
+    GpuMemoryScope memScope(GpuMemoryCategory::Textures, "AssetHandler");
+    TextureAsset   out;
     if (!Renderer::IsReady())
         return out;
 
@@ -569,6 +640,7 @@ TextureAsset AssetHandler::_createEmptyTexture(const vf2d &size) {
         .sampleCount   = GpuSampleCount::X1,
         .usage         = GpuTextureUsage::ColorTarget | GpuTextureUsage::Sampler,
     };
+    GpuMemoryScope memScope(GpuMemoryCategory::RenderTargets, "AssetHandler");
     texture.gpuSampler = Renderer::GetSampler(_defaultMode);
     texture.gpuTexture = Renderer::GetGpu().CreateTexture(info);
     return texture;
@@ -589,6 +661,7 @@ TextureAsset AssetHandler::_createEmptyTexture(const vf2d &size, GpuTextureForma
         .usage         = GpuTextureUsage::ColorTarget | GpuTextureUsage::Sampler
             | GpuTextureUsage::StorageRead | GpuTextureUsage::StorageWrite,
     };
+    GpuMemoryScope memScope(GpuMemoryCategory::RenderTargets, "AssetHandler");
     texture.gpuSampler = Renderer::GetSampler(_defaultMode);
     texture.gpuTexture = Renderer::GetGpu().CreateTexture(info);
     return texture;
@@ -602,6 +675,7 @@ Sound AssetHandler::_getSound(const std::string &fileName) {
     std::lock_guard<std::mutex> lock(_assetMutex);
 
     if (_sounds.find(fileName) == _sounds.end()) {
+        LUMI_ZONE("AssetHandler::LoadSound");
         SoundAsset soundAsset;
         soundAsset.sound    = new ma_sound();
         soundAsset.fileName = fileName;
@@ -641,30 +715,47 @@ Sound AssetHandler::_getSound(const std::string &fileName) {
     }
 }
 
-Music AssetHandler::_getMusic(const std::string &fileName) {
+Music AssetHandler::_getMusic(const std::string &fileName, MusicLoadMode mode) {
     std::lock_guard<std::mutex> lock(_assetMutex);
 
     if (_musics.find(fileName) == _musics.end()) {
+        LUMI_ZONE("AssetHandler::LoadMusic");
         MusicAsset musicAsset;
 
         musicAsset.music = new ma_sound();
 
         auto filedata = FileHandler::ReadFile(fileName);
 
-        // Keep the encoded bytes alive; both paths below reference them.
+        // Keep the encoded bytes alive; every mode below references them.
         musicAsset.fileData = filedata.data;
 
         bool isAbs = (fileName.size() > 1 && fileName[1] == ':')
             || (!fileName.empty() && (fileName[0] == '/' || fileName[0] == '\\'));
 
+        // A file referenced by absolute path (e.g. an audio clip you sent): the resource
+        // manager's register-encoded-data + init-from-file path mishandles this and returns
+        // MA_OUT_OF_MEMORY, so full decoding isn't available there; decode on demand instead.
+        if (isAbs && mode == MusicLoadMode::Decoded)
+            mode = MusicLoadMode::Compressed;
+        musicAsset.mode = mode;
+
+        ma_uint32 eng_rate = ma_engine_get_sample_rate(Audio::GetAudioEngine());
+        ma_uint32 eng_ch   = ma_engine_get_channels(Audio::GetAudioEngine());
+
         ma_result result = MA_ERROR;
-        if (isAbs) {
-            // A file referenced by absolute path (e.g. an audio clip you sent). The resource
-            // manager's register-encoded-data + init-from-file path mishandles this and returns
-            // MA_OUT_OF_MEMORY, so decode the in-memory bytes directly as a data source — decodes
-            // on demand (no up-front full-length allocation) and needs no filename/VFS lookup.
-            ma_uint32         eng_rate = ma_engine_get_sample_rate(Audio::GetAudioEngine());
-            ma_uint32         eng_ch   = ma_engine_get_channels(Audio::GetAudioEngine());
+        if (mode == MusicLoadMode::Stream) {
+            // Decoded ahead on the music stream thread into a small ring; the audio thread only
+            // copies PCM out of it. Memory is the read-ahead window, not the whole song.
+            musicAsset.stream = filedata.data
+                ? MusicStreamer::Create(filedata.data, (size_t)filedata.fileSize, eng_ch, eng_rate)
+                : nullptr;
+            result = musicAsset.stream
+                ? ma_sound_init_from_data_source(Audio::GetAudioEngine(), &musicAsset.stream->base, 0,
+                    Audio::GetChannelGroup(AudioChannel::Music), musicAsset.music)
+                : MA_INVALID_DATA;
+        } else if (mode == MusicLoadMode::Compressed) {
+            // Decode the in-memory bytes directly as a data source — decodes on demand on the
+            // audio thread (no up-front full-length allocation) and needs no filename/VFS lookup.
             // Decode straight into the engine's format so the data source has a definite,
             // non-zero channel count / sample rate for the engine node.
             ma_decoder_config dcfg = ma_decoder_config_init(ma_format_f32, eng_ch, eng_rate);
@@ -676,7 +767,7 @@ Music AssetHandler::_getMusic(const std::string &fileName) {
                 result = ma_sound_init_from_data_source(Audio::GetAudioEngine(), musicAsset.decoder, 0,
                     Audio::GetChannelGroup(AudioChannel::Music), musicAsset.music);
         } else {
-            // Bundled/relative assets: unchanged resource-manager path.
+            // Fully decoded through the resource manager.
             ma_resource_manager_register_encoded_data(Audio::GetAudioEngine()->pResourceManager, fileName.c_str(), filedata.data, filedata.fileSize);
             result = ma_sound_init_from_file(Audio::GetAudioEngine(), fileName.c_str(),
                 MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC,
@@ -685,6 +776,10 @@ Music AssetHandler::_getMusic(const std::string &fileName) {
         }
 
         if (result != MA_SUCCESS) {
+            if (musicAsset.stream) {
+                MusicStreamer::Destroy(musicAsset.stream);
+                musicAsset.stream = nullptr;
+            }
             if (musicAsset.decoder) {
                 ma_decoder_uninit(musicAsset.decoder);
                 delete musicAsset.decoder;
@@ -704,6 +799,27 @@ Music AssetHandler::_getMusic(const std::string &fileName) {
     }
 }
 
+void AssetHandler::_releaseMusic(MusicAsset &music) {
+    if (music.music) {
+        ma_sound_uninit(music.music);
+        delete music.music;
+        music.music = nullptr;
+    }
+    if (music.stream) { // after the sound: the audio thread may still be reading it until then
+        MusicStreamer::Destroy(music.stream);
+        music.stream = nullptr;
+    }
+    if (music.decoder) { // uninit before freeing the bytes it reads from
+        ma_decoder_uninit(music.decoder);
+        delete music.decoder;
+        music.decoder = nullptr;
+    }
+    if (music.fileData) {
+        free(music.fileData);
+        music.fileData = nullptr;
+    }
+}
+
 Font AssetHandler::_getFont(const std::string &fileName, const int fontSize) {
     std::lock_guard<std::mutex> lock(_assetMutex);
 
@@ -714,17 +830,12 @@ Font AssetHandler::_getFont(const std::string &fileName, const int fontSize) {
         return _fonts[fileName];
     }
 
-    // Try loading from font cache
-    FontAsset fontAsset;
-    if (_loadFontFromCache(fileName, fontSize, fontAsset)) {
-        _fonts[fileName] = fontAsset;
-        return _fonts[fileName];
-    }
+    LUMI_ZONE("AssetHandler::LoadFont");
 
-    // Cache miss - generate MSDF atlas from scratch
-    LOG_INFO("Generating MSDF font {} (atlas size: 64, default render: {})", fileName.c_str(), fontSize);
-
-    auto filedata      = FileHandler::ReadFile(fileName);
+    // No atlas is baked up front: glyphs are rasterized on the glyph workers the first time
+    // they're drawn (or prefetched below) and packed into the font's GlyphAtlas pages
+    FontAsset fontAsset;
+    auto      filedata = FileHandler::ReadFile(fileName);
     fontAsset.fontData = filedata.data;
 
     msdfgen::FreetypeHandle *ft = msdfgen::initializeFreetype();
@@ -742,101 +853,117 @@ Font AssetHandler::_getFont(const std::string &fileName, const int fontSize) {
         LOG_CRITICAL("Failed to load font for MSDF: {}", fileName.c_str());
     }
 
-    std::vector<msdf_atlas::GlyphGeometry> msdfGlyphs;
-
-    msdf_atlas::FontGeometry fontGeometry(&msdfGlyphs);
-    msdf_atlas::Charset      charset;
-    for (uint32_t cp = 0x20; cp <= 0x17F; ++cp)
-        charset.add(cp);
-    fontGeometry.loadCharset(fontAsset.fontHandle, 1.0, charset);
-
-    fontAsset.ascender   = fontGeometry.getMetrics().ascenderY;
-    fontAsset.descender  = fontGeometry.getMetrics().descenderY;
-    fontAsset.lineHeight = fontGeometry.getMetrics().lineHeight;
-
-    const double maxCornerAngle = 3.0;
-    for (msdf_atlas::GlyphGeometry &glyph : msdfGlyphs) {
-        glyph.edgeColoring(&msdfgen::edgeColoringInkTrap, maxCornerAngle, 0);
-    }
-
-    const int ATLAS_GENERATION_SIZE = 64; // NOLINT(readability-identifier-naming)
+    msdf_atlas::FontGeometry fontGeometry;
+    fontGeometry.loadMetrics(fontAsset.fontHandle, 1.0);
 
-    msdf_atlas::TightAtlasPacker packer;
-    packer.setDimensionsConstraint(msdf_atlas::DimensionsConstraint::SQUARE);
-    packer.setMinimumScale(ATLAS_GENERATION_SIZE);
-    packer.setPixelRange(4.0);
-    packer.setMiterLimit(1.0);
-    packer.pack(msdfGlyphs.data(), msdfGlyphs.size());
+    fontAsset.ascender          = fontGeometry.getMetrics().ascenderY;
+    fontAsset.descender         = fontGeometry.getMetrics().descenderY;
+    fontAsset.lineHeight        = fontGeometry.getMetrics().lineHeight;
+    fontAsset.generatedSize     = GLYPH_GENERATION_SIZE;
+    fontAsset.defaultRenderSize = fontSize;
 
-    packer.getDimensions(fontAsset.atlasWidth, fontAsset.atlasHeight);
+    // The face stays owned by the FontAsset; _releaseFont drops the atlas (and with it the
+    // rasterizer) before destroying it. No baked atlas, but page 0 stays reserved for one.
+    auto source           = std::make_shared<GlyphSource>();
+    source->handle        = fontAsset.fontHandle;
+    source->geometryScale = fontGeometry.getGeometryScale();
+    fontAsset.atlas       = new GlyphAtlas(glyphRasterizer(std::move(source)), Platform::Workers(ThreadRole::Background), 1);
 
-    LOG_INFO("MSDF atlas for {}: {}x{}", fileName.c_str(), fontAsset.atlasWidth, fontAsset.atlasHeight);
+    // Printable ASCII is what nearly every string starts with; queue it now so the first
+    // frames of text rarely see a placeholder
+    for (uint32_t cp = 0x20; cp <= 0x7E; ++cp)
+        fontAsset.atlas->Request(cp);
 
-    msdf_atlas::ImmediateAtlasGenerator<
-        float, 3,
-        msdf_atlas::msdfGenerator,
-        msdf_atlas::BitmapAtlasStorage<unsigned char, 3>>
-        generator(fontAsset.atlasWidth, fontAsset.atlasHeight);
-
-    generator.setThreadCount(Platform::DefaultThreadCount());
-    generator.generate(msdfGlyphs.data(), msdfGlyphs.size());
+    LOG_INFO("Loaded MSDF font {} (glyphs on demand, default render size: {})", fileName.c_str(), fontSize);
 
-    msdfgen::BitmapConstRef<unsigned char, 3> bitmap = generator.atlasStorage();
+    _fonts[fileName] = fontAsset;
+    return _fonts[fileName];
+}
 
-    std::vector<unsigned char> rgbaData(fontAsset.atlasWidth * fontAsset.atlasHeight * 4);
-    for (int y = 0; y < fontAsset.atlasHeight; ++y) {
-        for (int x = 0; x < fontAsset.atlasWidth; ++x) {
-            int                  srcY  = fontAsset.atlasHeight - 1 - y;
-            int                  idx   = (y * fontAsset.atlasWidth + x);
-            const unsigned char *pixel = bitmap(x, srcY);
-            rgbaData[idx * 4 + 0]      = pixel[0];
-            rgbaData[idx * 4 + 1]      = pixel[1];
-            rgbaData[idx * 4 + 2]      = pixel[2];
-            rgbaData[idx * 4 + 3]      = 255;
+void AssetHandler::_releaseFont(FontAsset &font) {
+    // The atlas first: it waits for glyphs still on the workers, which use the font handle
+    if (font.atlas) {
+        for (GlyphAtlas::Page &page : font.atlas->Pages()) {
+            if (page.texture)
+                Renderer::GetGpu().ReleaseTexture(page.texture);
         }
+        delete font.atlas;
+        font.atlas = nullptr;
     }
-
-    GpuTextureCreateInfo textureInfo {
-        .width         = static_cast<uint32_t>(fontAsset.atlasWidth),
-        .height        = static_cast<uint32_t>(fontAsset.atlasHeight),
-        .depthOrLayers = 1,
-        .numLevels     = 1,
-        .format        = GpuTextureFormat::R8G8B8A8_Unorm,
-        .sampleCount   = GpuSampleCount::X1,
-        .usage         = GpuTextureUsage::Sampler | GpuTextureUsage::Transfer,
-    };
-    fontAsset.atlasTexture = Renderer::GetGpu().CreateTexture(textureInfo);
-
-    if (!_copyToTexture(rgbaData.data(), (uint32_t)rgbaData.size(),
-            fontAsset.atlasTexture, fontAsset.atlasWidth, fontAsset.atlasHeight)) {
-        LOG_CRITICAL("Failed to upload MSDF atlas to GPU: {}", fileName.c_str());
-    }
-
-    // Convert msdf_atlas::GlyphGeometry -> CachedGlyph
-    fontAsset.glyphs   = new std::vector<CachedGlyph>();
-    fontAsset.glyphMap = new std::unordered_map<uint32_t, size_t>();
-    for (size_t i = 0; i < msdfGlyphs.size(); ++i) {
-        CachedGlyph cached;
-        cached.codepoint = msdfGlyphs[i].getCodepoint();
-        cached.advance   = msdfGlyphs[i].getAdvance();
-        msdfGlyphs[i].getQuadPlaneBounds(cached.pl, cached.pb, cached.pr, cached.pt);
-        msdfGlyphs[i].getQuadAtlasBounds(cached.al, cached.ab, cached.ar, cached.at);
-        fontAsset.glyphs->push_back(cached);
-        if (cached.codepoint > 0) {
-            (*fontAsset.glyphMap)[cached.codepoint] = i;
-        }
+    if (font.glyphs) {
+        delete font.glyphs;
+        font.glyphs = nullptr;
+    }
+    if (font.glyphMap) {
+        delete font.glyphMap;
+        font.glyphMap = nullptr;
+    }
+    if (font.atlasTexture) {
+        Renderer::GetGpu().ReleaseTexture(font.atlasTexture);
+        font.atlasTexture = 0;
+    }
+    if (font.fontHandle) {
+        msdfgen::destroyFont(font.fontHandle);
+        font.fontHandle = nullptr;
+    }
+    if (font.fontData) {
+        free(font.fontData);
+        font.fontData = nullptr;
     }
+}
 
-    fontAsset.generatedSize     = ATLAS_GENERATION_SIZE;
-    fontAsset.defaultRenderSize = fontSize;
+void AssetHandler::_updateFontAtlases() {
+    LUMI_ZONE("AssetHandler::UpdateFontAtlases");
+    std::lock_guard<std::mutex> lock(_assetMutex);
+    GpuMemoryScope              memScope(GpuMemoryCategory::Fonts, "AssetHandler");
 
-    // Save to font cache
-    _saveFontToCache(fileName, fontAsset, rgbaData);
+    _syncFontAtlas(_defaultFont);
+    for (auto &[name, font] : _fonts)
+        _syncFontAtlas(font);
+}
 
-    LOG_INFO("Loaded MSDF font {} ({} glyphs, default render size: {})", fileName.c_str(), fontAsset.glyphs->size(), fontSize);
+void AssetHandler::_syncFontAtlas(FontAsset &font) {
+    if (!font.atlas)
+        return;
+    font.atlas->Update();
 
-    _fonts[fileName] = fontAsset;
-    return _fonts[fileName];
+    auto &gpu = Renderer::GetGpu();
+    for (GlyphAtlas::Page &page : font.atlas->Pages()) {
+        if (page.resized) {
+            // New or grown: a texture at the new size, filled whole. Frames already queued
+            // keep the old one alive until they're done with it.
+            if (page.texture)
+                gpu.ReleaseTexture(page.texture);
+            GpuTextureCreateInfo textureInfo {
+                .width         = static_cast<uint32_t>(page.width),
+                .height        = static_cast<uint32_t>(page.height),
+                .depthOrLayers = 1,
+                .numLevels     = 1,
+                .format        = GpuTextureFormat::R8G8B8A8_Unorm,
+                .sampleCount   = GpuSampleCount::X1,
+                .usage         = GpuTextureUsage::Sampler | GpuTextureUsage::Transfer,
+            };
+            page.texture = gpu.CreateTexture(textureInfo);
+            if (!page.texture || !_copyToTexture(page.pixels.data(), (uint32_t)page.pixels.size(), page.texture, page.width, page.height))
+                LOG_WARNING("Failed to upload a {}x{} glyph atlas page", page.width, page.height);
+            else
+                font.atlas->CountUpload(page.pixels.size());
+        } else if (page.dirtyX0 < page.dirtyX1) {
+            // Only the rectangle the new glyphs went into
+            const auto width  = static_cast<uint32_t>(page.dirtyX1 - page.dirtyX0);
+            const auto height = static_cast<uint32_t>(page.dirtyY1 - page.dirtyY0);
+            _glyphUpload.resize(static_cast<size_t>(width) * height * 4);
+            for (uint32_t row = 0; row < height; ++row)
+                std::memcpy(&_glyphUpload[static_cast<size_t>(row) * width * 4],
+                    &page.pixels[(static_cast<size_t>(page.dirtyY0 + row) * page.width + page.dirtyX0) * 4], static_cast<size_t>(width) * 4);
+            if (!_copyToTextureRegion(_glyphUpload.data(), (uint32_t)_glyphUpload.size(), page.texture, page.dirtyX0, page.dirtyY0, width, height))
+                LOG_WARNING("Failed to upload new glyphs to the font atlas");
+            else
+                font.atlas->CountUpload(_glyphUpload.size());
+        }
+        page.resized = false;
+        page.dirtyX0 = page.dirtyX1 = 0;
+    }
 }
 
 void AssetHandler::_setDefaultTextureScaleMode(ScaleMode mode) {
@@ -851,6 +978,7 @@ Shader AssetHandler::_getShader(const std::string &fileName) {
     std::lock_guard<std::mutex> lock(_assetMutex);
 
     if (_shaders.find(fileName) == _shaders.end()) {
+        LUMI_ZONE("AssetHandler::LoadShader");
         LOG_INFO("loading shader: {}", fileName.c_str());
         _shaders[std::string(fileName)] = _loadShaderFromDisk(fileName);
         return _shaders[fileName];
@@ -866,6 +994,7 @@ ComputePipelineAsset &AssetHandler::_getComputePipeline(const std::string &fileN
         return it->second;
     }
 
+    LUMI_ZONE("AssetHandler::LoadComputePipeline");
     LOG_INFO("loading compute pipeline: {}", fileName.c_str());
     _computePipelines[fileName] = Renderer::CreateComputePipelineAsset(fileName);
     return _computePipelines[fileName];
@@ -874,6 +1003,12 @@ ComputePipelineAsset &AssetHandler::_getComputePipeline(const std::string &fileN
 bool AssetHandler::_copyToTexture(void *srcData, uint32_t srcDataLen,
     GpuTextureHandle dstTexture,
     uint32_t dstTextureWidth, uint32_t dstTextureHeight) {
+    return _copyToTextureRegion(srcData, srcDataLen, dstTexture, 0, 0, dstTextureWidth, dstTextureHeight);
+}
+
+bool AssetHandler::_copyToTextureRegion(const void *srcData, uint32_t srcDataLen,
+    GpuTextureHandle dstTexture,
+    uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
     auto &gpu = Renderer::GetGpu();
 
     GpuTransferBufferCreateInfo tbInfo { .size = srcDataLen, .usage = GpuTransferUsage::Upload };
@@ -900,11 +1035,11 @@ bool AssetHandler::_copyToTexture(void *srcData, uint32_t srcDataLen,
                .texture  = dstTexture,
                .mipLevel = 0,
                .layer    = 0,
-               .x        = 0,
-               .y        = 0,
+               .x        = x,
+               .y        = y,
                .z        = 0,
-               .width    = dstTextureWidth,
-               .height   = dstTextureHeight,
+               .width    = width,
+               .height   = height,
                .depth    = 1,
     };
     gpu.UploadToTexture(cmd, src, dst, false);
@@ -993,6 +1128,7 @@ TextureAsset AssetHandler::_createDepthTarget(uint32_t width, uint32_t height) {
         .sampleCount   = GpuSampleCount::X1,
         .usage         = GpuTextureUsage::DepthStencilTarget,
     };
+    GpuMemoryScope   memScope(GpuMemoryCategory::RenderTargets, "AssetHandler");
     GpuTextureHandle handle = Renderer::GetGpu().CreateTexture(info);
     if (!handle)
         LOG_CRITICAL("failed to create depth texture");
@@ -1017,6 +1153,7 @@ TextureAsset AssetHandler::_createWhitePixel() {
         .usage         = GpuTextureUsage::ColorTarget | GpuTextureUsage::Sampler
             | GpuTextureUsage::Transfer,
     };
+    GpuMemoryScope memScope(GpuMemoryCategory::Textures, "AssetHandler");
     whitePixel.gpuSampler = Renderer::GetSampler(_defaultMode);
     whitePixel.gpuTexture = Renderer::GetGpu().CreateTexture(info);
 
@@ -1036,6 +1173,7 @@ TextureAsset AssetHandler::_loadFromPixelData(const vf2d &size, void *pixelData,
     if (w == 0 || h == 0)
         return texture;
 
+    GpuMemoryScope       memScope(GpuMemoryCategory::Textures, "AssetHandler");
     auto                &gpu = Renderer::GetGpu();
     GpuTextureCreateInfo tci {
         .width         = w,
@@ -1304,15 +1442,13 @@ void AssetHandler::_saveFontCache() {
 
 std::string AssetHandler::_computeFontCacheKey(const std::string &fileName) {
     auto        filedata = FileHandler::ReadFile(fileName);
-    std::string data(static_cast<char *>(filedata.data), filedata.fileSize);
-    std::string hash = picosha2::hash256_hex_string(data);
+    std::string hash     = _computeFontCacheKeyFromData(filedata.data, filedata.fileSize);
     free(filedata.data);
     return hash;
 }
 
 std::string AssetHandler::_computeFontCacheKeyFromData(const void *data, size_t size) {
-    std::string str(static_cast<const char *>(data), size);
-    return picosha2::hash256_hex_string(str);
+    return ContentHash::Of(data, size).ToHex();
 }
 
 bool AssetHandler::_loadFontFromCache(const std::string &fileName, int fontSize, FontAsset &outFont, const std::string &precomputedHash) {
@@ -26,6 +26,7 @@
 #include "file/filehandler.h"
 #include "file/resourcepack.h"
 
+
 // Forward declarations for cleanup
 namespace msdfgen {
 class FontHandle;
@@ -143,11 +144,17 @@ public:
     /**
      * @brief Retrieves a music asset.
      *
+     * Music streams by default: a background thread decodes a short window ahead of playback,
+     * so long tracks cost a few hundred KB instead of their full decoded size. Use
+     * MusicLoadMode::Compressed for short loops and MusicLoadMode::Decoded when seeks must be
+     * instant. The mode only applies to the first load of a file.
+     *
      * @param fileName The filename of the music asset.
+     * @param mode     How the decoded audio is kept in memory.
      * @return The music asset.
      */
-    static Music &GetMusic(const char *fileName) {
-        return Get()._getMusic(fileName);
+    static Music &GetMusic(const char *fileName, MusicLoadMode mode = MusicLoadMode::Stream) {
+        return Get()._getMusic(fileName, mode);
     }
 
     /**
@@ -243,6 +250,11 @@ public:
      */
     static void Cleanup() { Get()._cleanup(); }
 
+    /// @cond INTERNAL
+    /// Packs glyphs the font workers finished and uploads the changed atlas pages. Once per frame.
+    static void UpdateFontAtlases() { Get()._updateFontAtlases(); }
+    /// @endcond
+
 private:
     // Textures
 
@@ -294,11 +306,24 @@ private:
 
     Font _getFont(const std::string &fileName, int fontSize);
 
+    void _releaseFont(FontAsset &font);
+
+    // Dynamic glyph atlases (assets/font/glyphatlas.h): glyphs are rasterized on the background
+    // workers (Platform::Workers) and the pages synced to their GPU textures once per frame.
+    void _updateFontAtlases();
+    void _syncFontAtlas(FontAsset &font);
+    bool _copyToTextureRegion(const void *srcData, uint32_t srcDataLen, GpuTextureHandle dstTexture,
+        uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+    std::vector<uint8_t> _glyphUpload; // dirty rectangle of a page, packed
+
     // Audio
 
     Sound _getSound(const std::string &fileName);
 
-    Music _getMusic(const std::string &fileName);
+    Music _getMusic(const std::string &fileName, MusicLoadMode mode);
+
+    void _releaseMusic(MusicAsset &music);
 
     // Shaders
 
@@ -358,27 +383,7 @@ private:
             });
 
             if (it != _fonts.end()) {
-                // Cleanup MSDF resources
-                if (asset.glyphs) {
-                    delete asset.glyphs;
-                    asset.glyphs = nullptr;
-                }
-                if (asset.glyphMap) {
-                    delete asset.glyphMap;
-                    asset.glyphMap = nullptr;
-                }
-                if (asset.atlasTexture) {
-                    Renderer::GetGpu().ReleaseTexture(asset.atlasTexture);
-                    asset.atlasTexture = 0;
-                }
-                if (asset.fontHandle) {
-                    msdfgen::destroyFont(asset.fontHandle);
-                    asset.fontHandle = nullptr;
-                }
-                if (asset.fontData) {
-                    free(asset.fontData);
-                    asset.fontData = nullptr;
-                }
+                _releaseFont(asset);
                 _fonts.erase(it);
             } else {
                 LOG_CRITICAL("font not found in the map");
@@ -390,7 +395,7 @@ private:
             });
 
             if (it != _musics.end()) {
-                ma_sound_uninit(static_cast<MusicAsset>(asset).music);
+                _releaseMusic(it->second);
                 _musics.erase(it);
             } else {
                 LOG_CRITICAL("MusicAsset not found in the map");
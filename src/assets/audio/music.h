@@ -1,7 +1,20 @@
 #pragma once
 
+#include <cstdint>
+
 #include "miniaudio.h"
 
+struct LumiMusicStream;
+
+/**
+ * @brief How a music asset keeps its audio in memory.
+ */
+enum class MusicLoadMode : uint8_t {
+    Stream,     ///< Decoded ahead on the music stream thread into a small ring (default; long tracks)
+    Compressed, ///< Encoded bytes in RAM, decoded on demand on the audio thread (short loops)
+    Decoded     ///< Fully decoded up front by the resource manager (largest; instant seeks)
+};
+
 /**
  * @brief Represents a music asset for playing audio using miniaudio.
  * @typedef Music Music
@@ -14,6 +27,9 @@ struct MusicAsset {
     void       *fileData   = nullptr; /**< Internal: encoded file bytes kept alive for cleanup. */
     ma_decoder *decoder    = nullptr; /**< Internal: memory decoder (used for absolute-path sources). */
     ma_uint64   lengthFrames = 0;     /**< Internal: cached total length; the length query scans the file, so compute it once. */
+
+    MusicLoadMode    mode   = MusicLoadMode::Stream; /**< How the track was loaded (see MusicLoadMode). */
+    LumiMusicStream *stream = nullptr;               /**< Internal: ring-buffer data source (Stream mode). */
 };
 
 using Music = MusicAsset &;
\ No newline at end of file
@@ -0,0 +1,524 @@
+#include "effectfusion.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "util/hash.h"
+
+namespace {
+using Token     = EffectStage::Token;
+using TokenKind = EffectStage::TokenKind;
+using Decl      = EffectStage::Decl;
+using DeclKind  = EffectStage::DeclKind;
+
+bool isIdentStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+bool isIdentChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+bool isDigit(char c) { return std::isdigit(static_cast<unsigned char>(c)); }
+bool isSpace(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+
+// Splits GLSL into tokens, keeping whitespace and comments (as Space) so the source can be
+// re-emitted as written. Operators come out one character at a time, which is all the analysis
+// needs.
+std::vector<Token> tokenize(const std::string &src) {
+    std::vector<Token> tokens;
+    bool               lineStart = true;
+
+    for (size_t i = 0; i < src.size();) {
+        size_t start = i;
+        char   c     = src[i];
+
+        if (c == '/' && i + 1 < src.size() && src[i + 1] == '/') {
+            while (i < src.size() && src[i] != '\n')
+                ++i;
+            tokens.push_back({ TokenKind::Space, src.substr(start, i - start) });
+            continue;
+        }
+        if (c == '/' && i + 1 < src.size() && src[i + 1] == '*') {
+            size_t close = src.find("*/", i + 2);
+            i            = close == std::string::npos ? src.size() : close + 2;
+            tokens.push_back({ TokenKind::Space, src.substr(start, i - start) });
+            continue;
+        }
+        if (isSpace(c)) {
+            for (; i < src.size() && isSpace(src[i]); ++i)
+                lineStart = lineStart || src[i] == '\n';
+            tokens.push_back({ TokenKind::Space, src.substr(start, i - start) });
+            continue;
+        }
+
+        if (c == '#' && lineStart) {
+            while (i < src.size() && src[i] != '\n')
+                i += (src[i] == '\\' && i + 1 < src.size()) ? 2 : 1;
+            tokens.push_back({ TokenKind::Directive, src.substr(start, i - start) });
+        } else if (isIdentStart(c)) {
+            while (i < src.size() && isIdentChar(src[i]))
+                ++i;
+            tokens.push_back({ TokenKind::Identifier, src.substr(start, i - start) });
+        } else if (isDigit(c) || (c == '.' && i + 1 < src.size() && isDigit(src[i + 1]))) {
+            for (++i; i < src.size(); ++i) {
+                bool exponentSign = (src[i] == '+' || src[i] == '-') && (src[i - 1] == 'e' || src[i - 1] == 'E');
+                if (!isIdentChar(src[i]) && src[i] != '.' && !exponentSign)
+                    break;
+            }
+            tokens.push_back({ TokenKind::Number, src.substr(start, i - start) });
+        } else {
+            ++i;
+            tokens.push_back({ TokenKind::Punctuation, std::string(1, c) });
+        }
+        lineStart = false;
+    }
+    return tokens;
+}
+
+bool is(const Token &token, const std::string &text) {
+    return token.kind != TokenKind::Space && token.text == text;
+}
+
+bool opens(const Token &token) { return is(token, "(") || is(token, "[") || is(token, "{"); }
+bool closes(const Token &token) { return is(token, ")") || is(token, "]") || is(token, "}"); }
+
+// Index of the next non-space token at or after `i`, or `end`.
+size_t skipSpace(const std::vector<Token> &tokens, size_t i, size_t end) {
+    while (i < end && tokens[i].kind == TokenKind::Space)
+        ++i;
+    return i;
+}
+
+// Index of the token closing the bracket at `open`, or `end`.
+size_t matchBracket(const std::vector<Token> &tokens, size_t open, size_t end) {
+    int depth = 0;
+    for (size_t i = open; i < end; ++i) {
+        if (opens(tokens[i]))
+            ++depth;
+        else if (closes(tokens[i]) && --depth == 0)
+            return i;
+    }
+    return end;
+}
+
+bool precededByDot(const std::vector<Token> &tokens, size_t i) {
+    while (i > 0 && tokens[i - 1].kind == TokenKind::Space)
+        --i;
+    return i > 0 && is(tokens[i - 1], ".");
+}
+
+// "version" for "#  version 450"
+std::string directiveName(const std::string &text) {
+    size_t begin = text.find_first_not_of(" \t", 1);
+    size_t end   = begin;
+    while (end < text.size() && isIdentChar(text[end]))
+        ++end;
+    return begin == std::string::npos ? std::string() : text.substr(begin, end - begin);
+}
+
+// Matches `texture(<sampler>, <uv>)` at `i`; returns the index past the closing parenthesis,
+// or 0.
+size_t matchPointSample(const std::vector<Token> &tokens, size_t i, const std::string &sampler, const std::string &uv) {
+    for (const std::string &expected : { std::string("texture"), std::string("("), sampler, std::string(","), uv, std::string(")") }) {
+        i = skipSpace(tokens, i, tokens.size());
+        if (i == tokens.size() || !is(tokens[i], expected))
+            return 0;
+        ++i;
+    }
+    return i;
+}
+
+// Name declared by one comma-separated piece of a declaration: the identifier before `=` or
+// `[`, or else the last one.
+std::string declaredName(const std::vector<Token> &tokens, size_t begin, size_t end) {
+    std::string name;
+    for (size_t i = begin; i < end && !is(tokens[i], "=") && !is(tokens[i], "["); ++i) {
+        if (tokens[i].kind == TokenKind::Identifier)
+            name = tokens[i].text;
+    }
+    return name;
+}
+
+// Re-emits a stage's tokens with its names moved into the fused shader's namespace.
+class Renamer {
+public:
+    enum class Scope : uint8_t {
+        Code,    // functions and globals
+        Struct,  // struct declarations: field names stay
+        Members, // uniform block members
+    };
+
+    Renamer(const EffectStage &stage, size_t index)
+        : _stage(stage)
+        , _index(index) { }
+
+    std::string Emit(const Decl &decl, Scope scope = Scope::Code) const {
+        const auto &tokens = _stage.tokens;
+        std::string out;
+        int         depth = 0;
+
+        for (size_t i = decl.begin; i < decl.end; ++i) {
+            const Token &token = tokens[i];
+            depth += opens(token) ? 1 : closes(token) ? -1 : 0;
+            if (token.kind != TokenKind::Identifier || precededByDot(tokens, i)) {
+                out += token.text;
+                continue;
+            }
+
+            const std::string &name = token.text;
+            if (scope == Scope::Struct) {
+                bool rename = _stage.structs.contains(name) || (depth == 0 && _stage.globals.contains(name));
+                out += rename ? EffectFusion::MemberName(_index, name) : name;
+                continue;
+            }
+            if (scope == Scope::Members) {
+                bool rename = _stage.structs.contains(name) || _stage.globals.contains(name) || _stage.memberNames.contains(name);
+                out += rename ? EffectFusion::MemberName(_index, name) : name;
+                continue;
+            }
+
+            if (_index > 0 && name == "texture") {
+                if (size_t next = matchPointSample(tokens, i, _stage.sampler, _stage.input)) {
+                    out += "lfx_prev";
+                    i = next - 1;
+                    continue;
+                }
+            }
+            if (!_stage.instance.empty() && name == _stage.instance) {
+                // Parse checked it's always `instance.member`
+                size_t member = skipSpace(tokens, skipSpace(tokens, i + 1, decl.end) + 1, decl.end);
+                out += EffectFusion::MemberName(_index, tokens[member].text);
+                i = member;
+                continue;
+            }
+
+            if (name == _stage.sampler)
+                out += "lfx_input";
+            else if (name == _stage.input)
+                out += "lfx_uv";
+            else if (name == _stage.output)
+                out += "lfx_out";
+            else if (name == "main" || _stage.globals.contains(name)
+                     || (_stage.instance.empty() && _stage.memberNames.contains(name)))
+                out += EffectFusion::MemberName(_index, name);
+            else
+                out += name;
+        }
+        return out;
+    }
+
+private:
+    const EffectStage &_stage;
+    size_t             _index;
+};
+} // namespace
+
+EffectStage EffectStage::Parse(const std::string &glsl) {
+    EffectStage  stage;
+    const auto  &tokens = stage.tokens = tokenize(glsl);
+    const size_t count  = tokens.size();
+
+    auto reject = [&](std::string reason) {
+        EffectStage rejected;
+        rejected.reason = std::move(reason);
+        return rejected;
+    };
+
+    // Top-level declarations: up to `;`, or to the `}` closing a function body
+    for (size_t i = skipSpace(tokens, 0, count); i < count; i = skipSpace(tokens, i, count)) {
+        if (tokens[i].kind == TokenKind::Directive) {
+            std::string directive = directiveName(tokens[i].text);
+            if (directive == "version")
+                stage.version = tokens[i].text;
+            else if (directive == "extension")
+                stage.extensions.push_back(tokens[i].text);
+            else
+                return reject("preprocessor directive '" + tokens[i].text + "'");
+            ++i;
+            continue;
+        }
+        if (is(tokens[i], ";")) {
+            ++i;
+            continue;
+        }
+
+        size_t j = i;
+        if (is(tokens[j], "layout")) {
+            j = skipSpace(tokens, j + 1, count);
+            if (j == count || !is(tokens[j], "("))
+                return reject("malformed layout qualifier");
+            j = matchBracket(tokens, j, count) + 1;
+        }
+
+        Decl decl { i, count };
+        bool signature  = false; // `(` before any `=`: a function
+        bool assigned   = false;
+        bool terminated = false;
+        for (; j < count && !terminated; ++j) {
+            const Token &token = tokens[j];
+            if (token.kind == TokenKind::Directive)
+                return reject("preprocessor directive '" + token.text + "'");
+            if (is(token, "="))
+                assigned = true;
+            else if (is(token, "(") && !assigned)
+                signature = true;
+
+            if (opens(token)) {
+                size_t close = matchBracket(tokens, j, count);
+                if (close == count)
+                    return reject("unbalanced brackets");
+                terminated = is(token, "{") && signature;
+                j          = close;
+            } else {
+                terminated = is(token, ";");
+            }
+            decl.end = j + 1;
+        }
+        if (!terminated)
+            return reject("unterminated declaration");
+        stage.decls.push_back(decl);
+        i = decl.end;
+    }
+
+    bool hasMain = false;
+    for (Decl &decl : stage.decls) {
+        size_t end = decl.end;
+        size_t i   = skipSpace(tokens, decl.begin, end);
+
+        std::string layout;
+        if (is(tokens[i], "layout")) {
+            size_t close = matchBracket(tokens, skipSpace(tokens, i + 1, end), end);
+            for (size_t k = i; k <= close; ++k)
+                layout += tokens[k].text;
+            if (layout.find("push_constant") != std::string::npos)
+                return reject("push constants");
+            i = skipSpace(tokens, close + 1, end);
+        }
+        if (is(tokens[i], "precision"))
+            continue;
+
+        // Qualifiers and type: the words before the first bracket, `=` or `;`
+        std::unordered_set<std::string> words;
+        size_t                          stop = i;
+        for (; stop < end && !opens(tokens[stop]) && !is(tokens[stop], "=") && !is(tokens[stop], ";"); ++stop) {
+            if (tokens[stop].kind == TokenKind::Identifier)
+                words.insert(tokens[stop].text);
+        }
+        if (words.contains("buffer") || words.contains("shared"))
+            return reject("storage or shared declaration");
+
+        bool braced = stop < end && is(tokens[stop], "{");
+        if (words.contains("uniform") && braced) {
+            if (stage.hasBlock)
+                return reject("more than one uniform block");
+            stage.hasBlock    = true;
+            stage.blockLayout = layout;
+            decl.kind         = DeclKind::Block;
+
+            size_t close = matchBracket(tokens, stop, end);
+            for (size_t m = skipSpace(tokens, stop + 1, close); m < close; m = skipSpace(tokens, m, close)) {
+                Decl member { m, close };
+                for (size_t k = m; k < close && member.end == close; ++k) {
+                    if (is(tokens[k], ","))
+                        return reject("uniform block member list");
+                    if (is(tokens[k], ";"))
+                        member.end = k + 1;
+                }
+                std::string name = declaredName(tokens, m, member.end);
+                if (member.end == close || name.empty())
+                    return reject("unsupported uniform block member");
+                stage.members.push_back(member);
+                stage.memberNames.insert(name);
+                m = member.end;
+            }
+            for (size_t k = close + 1; k < end; ++k) {
+                if (is(tokens[k], "["))
+                    return reject("arrayed uniform block");
+                if (tokens[k].kind == TokenKind::Identifier)
+                    stage.instance = tokens[k].text;
+            }
+            continue;
+        }
+        if (words.contains("uniform")) {
+            std::string name = declaredName(tokens, i, end);
+            if (!words.contains("sampler2D"))
+                return reject("uniform '" + name + "' is not a sampler2D or in a block");
+            if (!stage.sampler.empty())
+                return reject("more than one sampler");
+            stage.sampler       = name;
+            stage.samplerLayout = layout;
+            decl.kind           = DeclKind::Sampler;
+            continue;
+        }
+        if (words.contains("in") || words.contains("out")) {
+            bool         in   = words.contains("in");
+            std::string  name = declaredName(tokens, i, end);
+            std::string &slot = in ? stage.input : stage.output;
+            if (!words.contains(in ? "vec2" : "vec4") || !slot.empty())
+                return reject(std::string(in ? "input" : "output") + " '" + name + "' is not the only " + (in ? "vec2" : "vec4"));
+            slot      = name;
+            decl.kind = in ? DeclKind::Input : DeclKind::Output;
+            continue;
+        }
+        if (words.contains("struct") && braced) {
+            decl.kind = DeclKind::Struct;
+            for (size_t k = i; k < stop; ++k) {
+                if (tokens[k].kind == TokenKind::Identifier && tokens[k].text != "struct") {
+                    stage.structs.insert(tokens[k].text);
+                    stage.globals.insert(tokens[k].text);
+                }
+            }
+            for (size_t k = matchBracket(tokens, stop, end) + 1; k < end; ++k) {
+                if (tokens[k].kind == TokenKind::Identifier)
+                    stage.globals.insert(tokens[k].text);
+            }
+            continue;
+        }
+        if (stop < end && is(tokens[stop], "(")) {
+            decl.kind        = DeclKind::Function;
+            std::string name = declaredName(tokens, i, stop);
+            if (name == "main")
+                hasMain = true;
+            else
+                stage.globals.insert(name);
+            continue;
+        }
+
+        // Plain globals, possibly several: `const float a = 1.0, b[2] = ...;`
+        size_t piece = i;
+        for (size_t k = i; k < end; ++k) {
+            if (opens(tokens[k])) {
+                k = matchBracket(tokens, k, end);
+            } else if (is(tokens[k], ",") || is(tokens[k], ";")) {
+                if (std::string name = declaredName(tokens, piece, k); !name.empty())
+                    stage.globals.insert(name);
+                piece = k + 1;
+            }
+        }
+    }
+
+    if (stage.sampler.empty() || stage.input.empty() || stage.output.empty() || !hasMain)
+        return reject("not the effect interface (one sampler2D, vec2 input, vec4 output, main)");
+
+    // Every use of the sampler and block instance, and anything that can't move into a function
+    size_t samplerUses = 0, pointUses = 0;
+    for (const Decl &decl : stage.decls) {
+        if (decl.kind == DeclKind::Sampler || decl.kind == DeclKind::Block)
+            continue;
+        for (size_t i = decl.begin; i < decl.end; ++i) {
+            const std::string &name = tokens[i].text;
+            if (tokens[i].kind != TokenKind::Identifier || precededByDot(tokens, i))
+                continue;
+
+            if (name == "discard")
+                return reject("discard");
+            if (name.starts_with("gl_") && name != "gl_FragCoord")
+                return reject("uses " + name);
+            if (name == stage.sampler) {
+                ++samplerUses;
+            } else if (!stage.instance.empty() && name == stage.instance) {
+                size_t dot    = skipSpace(tokens, i + 1, decl.end);
+                size_t member = skipSpace(tokens, dot + 1, decl.end);
+                if (member >= decl.end || !is(tokens[dot], ".") || !stage.memberNames.contains(tokens[member].text))
+                    return reject("uniform block instance used as a whole");
+            } else if (matchPointSample(tokens, i, stage.sampler, stage.input)) {
+                ++pointUses;
+            } else if (name == "textureSize") {
+                // Size queries read no texels
+                size_t open = skipSpace(tokens, i + 1, decl.end);
+                size_t arg  = skipSpace(tokens, open + 1, decl.end);
+                if (arg < decl.end && is(tokens[open], "(") && is(tokens[arg], stage.sampler))
+                    ++pointUses;
+            }
+        }
+    }
+
+    stage.fusable   = true;
+    stage.pointwise = samplerUses == pointUses;
+    if (!stage.pointwise)
+        stage.reason = "samples its input away from the current pixel";
+    return stage;
+}
+
+std::vector<EffectFusion::Run> EffectFusion::Plan(const std::vector<const EffectStage *> &stages, const std::vector<uint64_t> &vertShaders) {
+    std::vector<Run> runs;
+    for (size_t first = 0; first < stages.size();) {
+        size_t next = first + 1;
+        if (stages[first]->fusable) {
+            while (next < stages.size() && stages[next]->pointwise && vertShaders[next] == vertShaders[first])
+                ++next;
+        }
+        runs.push_back({ first, next - first });
+        first = next;
+    }
+    return runs;
+}
+
+std::string EffectFusion::Generate(const std::vector<const EffectStage *> &stages) {
+    const EffectStage &head = *stages.front();
+    using Scope             = Renamer::Scope;
+
+    auto withSpace = [](const std::string &layout) { return layout.empty() ? layout : layout + " "; };
+
+    std::string out = (head.version.empty() ? std::string("#version 450") : head.version) + "\n";
+    std::vector<std::string> extensions;
+    for (const EffectStage *stage : stages) {
+        for (const std::string &extension : stage->extensions) {
+            if (std::find(extensions.begin(), extensions.end(), extension) == extensions.end()) {
+                extensions.push_back(extension);
+                out += extension + "\n";
+            }
+        }
+    }
+    out += "\n// " + std::to_string(stages.size()) + " effects fused by EffectFusion\n\n";
+    out += withSpace(head.samplerLayout) + "uniform sampler2D lfx_input;\n";
+    out += "layout(location = 0) in vec2 lfx_uv;\n";
+    out += "layout(location = 0) out vec4 lfx_result;\n\n";
+
+    // Struct types first, as block members may use them
+    for (size_t s = 0; s < stages.size(); ++s) {
+        Renamer renamer(*stages[s], s);
+        for (const Decl &decl : stages[s]->decls) {
+            if (decl.kind == DeclKind::Struct)
+                out += renamer.Emit(decl, Scope::Struct) + "\n\n";
+        }
+    }
+
+    // Constants next, as block members may size arrays with them
+    for (size_t s = 0; s < stages.size(); ++s) {
+        Renamer renamer(*stages[s], s);
+        for (const Decl &decl : stages[s]->decls) {
+            if (decl.kind == DeclKind::Other)
+                out += renamer.Emit(decl) + "\n\n";
+        }
+    }
+
+    // One instance-less block with every stage's members, under the first block's layout
+    std::string members, blockLayout;
+    for (size_t s = 0; s < stages.size(); ++s) {
+        Renamer renamer(*stages[s], s);
+        for (const Decl &member : stages[s]->members)
+            members += "    " + renamer.Emit(member, Scope::Members) + "\n";
+        if (blockLayout.empty())
+            blockLayout = stages[s]->blockLayout;
+    }
+    if (!members.empty())
+        out += withSpace(blockLayout) + "uniform FusedEffectParams {\n" + members + "};\n\n";
+
+    out += "vec4 lfx_prev;\nvec4 lfx_out;\n\n";
+    for (size_t s = 0; s < stages.size(); ++s) {
+        Renamer renamer(*stages[s], s);
+        for (const Decl &decl : stages[s]->decls) {
+            if (decl.kind == DeclKind::Function)
+                out += renamer.Emit(decl) + "\n\n";
+        }
+    }
+
+    out += "void main() {\n";
+    for (size_t s = 0; s < stages.size(); ++s) {
+        if (s > 0)
+            out += "    lfx_prev = clamp(lfx_out, 0.0, 1.0);\n";
+        out += "    " + MemberName(s, "main") + "();\n";
+    }
+    out += "    lfx_result = lfx_out;\n}\n";
+    return out;
+}
+
+std::string EffectFusion::ShaderName(const std::string &source) {
+    return "[Lumi]fused_" + ContentHash::Of(source).ToHex() + ".frag";
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+// Effect-chain fusion: a run of effects that only recolour each pixel (grayscale, tint,
+// vignette...) is compiled into a single fragment shader, so the run costs one full-screen
+// pass instead of one read and one write of the whole target per effect.
+//
+// A stage may start a fused run if its fragment shader has the plain effect interface: one
+// sampler2D, one vec2 input, one vec4 output, at most one uniform block, no discard and no
+// preprocessor beyond #version/#extension. It may continue a run only if it is point-wise: it
+// reads its input solely as texture(sampler, <its input uv>), the previous effect's result at
+// the same pixel. Effects sampling anywhere else (distortion, blur, outlines) need that result
+// in a texture, so they start a new pass.
+//
+// Fusing renames each stage's globals to lfx<stage>_<name>, turns its main() into a function
+// and merges the uniform blocks into one; the effects' uniform bytes are copied to their
+// members' reflected offsets in the fused block (MemberName). Results between stages are
+// clamped to [0, 1], as the RGBA8 ping-pong targets would.
+//
+// The SDL SpriteRenderPass plans each chain, compiles fused runs through
+// Shaders::CreateShaderAssetFromSource and caches them by chain signature. WebGPU effects are
+// WGSL and run unfused. tests/test_effectfusion compiles generated runs with glslang; fusion
+// stays opt-in (SetEnabled) until their output is also compared against the unfused chain.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/// @brief An effect fragment shader as far as fusion is concerned (see Parse).
+struct EffectStage {
+    bool        fusable   = false; ///< Has the plain effect interface; may start a fused run.
+    bool        pointwise = false; ///< Fusable, and reads its input only at its own pixel.
+    std::string reason;            ///< Why it's not fusable / not point-wise (for logs).
+
+    /// @brief Analyses a GLSL fragment shader's source.
+    static EffectStage Parse(const std::string &glsl);
+
+    /// @cond INTERNAL
+    enum class TokenKind : uint8_t { Identifier, Number, Punctuation, Space, Directive };
+    struct Token {
+        TokenKind   kind;
+        std::string text;
+    };
+    enum class DeclKind : uint8_t { Sampler, Input, Output, Block, Struct, Function, Other };
+    struct Decl {
+        size_t   begin = 0, end = 0; // token range
+        DeclKind kind  = DeclKind::Other;
+    };
+
+    std::vector<Token>              tokens;
+    std::vector<Decl>               decls;
+    std::string                     version;    // "#version ..." line
+    std::vector<std::string>        extensions; // "#extension ..." lines
+    std::string                     samplerLayout, blockLayout; // "layout(...)" text, may be empty
+    std::string                     sampler, input, output, instance;
+    bool                            hasBlock = false;
+    std::vector<Decl>               members; // of the uniform block, token ranges
+    std::unordered_set<std::string> memberNames;
+    std::unordered_set<std::string> globals; // renamed per stage: functions, constants, structs
+    std::unordered_set<std::string> structs;
+    /// @endcond
+};
+
+/// @brief Plans and generates fused effect chains; keeps fusion statistics.
+class EffectFusion {
+public:
+    /// @brief Effects applied and passes run since startup (totals; diff them per frame).
+    struct Stats {
+        uint64_t effects      = 0; ///< Effects applied to batches.
+        uint64_t passes       = 0; ///< Full-screen passes that took (fewer when fused).
+        uint64_t bytes        = 0; ///< Target bytes read and written by those passes.
+        uint32_t fusedShaders = 0; ///< Fused shaders compiled (or loaded from the shader cache).
+    };
+
+    /// @brief Turns fusion on or off (default off). Takes effect on the next frame.
+    static void SetEnabled(bool enabled) { Get()._enabled = enabled; }
+    /// @brief Returns whether effect chains are fused.
+    static bool IsEnabled() { return Get()._enabled; }
+    /// @brief Returns the totals so far.
+    static const Stats &GetStats() { return Get()._stats; }
+
+    /// @cond INTERNAL
+    /// A run of consecutive effects drawn as one pass.
+    struct Run {
+        size_t first = 0;
+        size_t count = 1;
+    };
+
+    /// Splits a chain into runs. `vertShaders[i]` identifies stage i's vertex shader; a run
+    /// only spans stages sharing one.
+    static std::vector<Run> Plan(const std::vector<const EffectStage *> &stages, const std::vector<uint64_t> &vertShaders);
+
+    /// GLSL for the stages of one run, in order.
+    static std::string Generate(const std::vector<const EffectStage *> &stages);
+
+    /// Name of a stage's uniform member in the fused block.
+    static std::string MemberName(size_t stage, const std::string &member) { return "lfx" + std::to_string(stage) + "_" + member; }
+
+    /// Shader cache name for generated source: a hash of it, so a cached compile matches.
+    static std::string ShaderName(const std::string &source);
+
+    static void CountPasses(size_t effects, size_t passes, uint64_t bytes) {
+        Stats &stats = Get()._stats;
+        stats.effects += effects;
+        stats.passes += passes;
+        stats.bytes += bytes;
+    }
+    static void CountFusedShader() { ++Get()._stats.fusedShaders; }
+
+    EffectFusion(const EffectFusion &) = delete;
+
+    static EffectFusion &Get() {
+        static EffectFusion instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    EffectFusion() = default;
+
+    bool  _enabled = false;
+    Stats _stats;
+};
@@ -19,6 +19,9 @@ struct CachedGlyph {
 
     // Atlas bounds (pixel coordinates in atlas)
     double al = 0.0, ab = 0.0, ar = 0.0, at = 0.0;
+
+    // Atlas page: 0 is the font's baked atlas, higher ones belong to its GlyphAtlas
+    uint16_t page = 0;
 };
 /// @endcond
 
@@ -30,6 +33,7 @@ struct CachedGlyph {
 namespace msdfgen {
 class FontHandle;
 }
+class GlyphAtlas;
 
 /// @brief A loaded font with its MSDF glyph atlas and metrics.
 struct FontAsset {
@@ -40,6 +44,7 @@ struct FontAsset {
 
     std::vector<CachedGlyph>             *glyphs   = nullptr; ///< Cached per-glyph atlas/metric data.
     std::unordered_map<uint32_t, size_t> *glyphMap = nullptr; ///< Maps codepoint to glyph index.
+    GlyphAtlas                           *atlas    = nullptr; ///< Glyphs rasterized on demand (those not in the baked atlas).
 
     void *fontData          = nullptr; ///< Owned font file bytes (kept for cleanup).
     int   generatedSize     = 0;       ///< Pixel size the atlas was generated at.
@@ -0,0 +1,194 @@
+#include "assets/font/glyphatlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/log/log.h"
+#include "util/threadpool.h"
+
+namespace {
+// Opaque black, the "outside" of an MSDF, like the baked atlases
+void clearPixels(std::vector<uint8_t> &pixels, size_t count) {
+    pixels.assign(count * 4, 0);
+    for (size_t i = 3; i < pixels.size(); i += 4)
+        pixels[i] = 255;
+}
+} // namespace
+
+GlyphAtlas::GlyphAtlas(Rasterizer rasterizer, ThreadPool &workers, uint16_t firstPage)
+    : _rasterizer(std::move(rasterizer))
+    , _workers(workers)
+    , _firstPage(firstPage) { }
+
+GlyphAtlas::~GlyphAtlas() {
+    _closing = true; // glyphs still queued skip the rasterizer
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] { return _inFlight == 0; });
+}
+
+const CachedGlyph *GlyphAtlas::Find(uint32_t codepoint) {
+    auto it = _entries.find(codepoint);
+    if (it == _entries.end()) {
+        Request(codepoint);
+        return nullptr;
+    }
+    return it->second.state == State::Ready ? &it->second.glyph : nullptr;
+}
+
+bool GlyphAtlas::IsPending(uint32_t codepoint) const {
+    auto it = _entries.find(codepoint);
+    return it != _entries.end() && it->second.state == State::Pending;
+}
+
+void GlyphAtlas::Request(uint32_t codepoint) {
+    if (!_entries.try_emplace(codepoint).second)
+        return;
+    ++_pending;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_inFlight;
+    }
+    _workers.Enqueue([this, codepoint] {
+        Finished done { codepoint, false, {} };
+        if (!_closing)
+            done.found = _rasterizer(codepoint, done.bitmap);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _finished.push_back(std::move(done));
+        _anyFinished = true;
+        if (--_inFlight == 0)
+            _idle.notify_all();
+    });
+}
+
+void GlyphAtlas::Update() {
+    if (!_anyFinished.exchange(false))
+        return;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _taken.swap(_finished);
+    }
+    for (Finished &done : _taken) {
+        Entry &entry = _entries[done.codepoint];
+        --_pending;
+        if (done.found)
+            _place(entry, done.bitmap);
+        else
+            entry.state = State::Missing;
+    }
+    _taken.clear();
+}
+
+void GlyphAtlas::Finish() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return _inFlight == 0; });
+    }
+    _anyFinished = true;
+    Update();
+}
+
+GlyphAtlas::Stats GlyphAtlas::GetStats() const {
+    Stats stats;
+    for (const auto &[codepoint, entry] : _entries) {
+        stats.glyphs += entry.state == State::Ready;
+        stats.missing += entry.state == State::Missing;
+    }
+    stats.pending  = _pending;
+    stats.pages    = static_cast<uint32_t>(_pages.size());
+    stats.uploaded = _uploaded;
+    for (const Page &page : _pages)
+        stats.bytes += page.pixels.size();
+    return stats;
+}
+
+void GlyphAtlas::_place(Entry &entry, GlyphBitmap &bitmap) {
+    entry.glyph = bitmap.metrics;
+    if (bitmap.width == 0 || bitmap.height == 0) { // whitespace: an advance, nothing to draw
+        entry.state = State::Ready;
+        return;
+    }
+
+    const int w = bitmap.width + PADDING;
+    const int h = bitmap.height + PADDING;
+    int       x = 0, y = 0;
+    size_t    index = 0;
+    while (index < _pages.size() && !_packInto(index, w, h, x, y))
+        ++index;
+    if (index == _pages.size()) {
+        if (w > MAX_PAGE_SIZE || h > MAX_PAGE_SIZE) {
+            LOG_WARNING("Glyph U+{:04X} is too large for the font atlas ({}x{})", entry.glyph.codepoint, bitmap.width, bitmap.height);
+            entry.state = State::Missing;
+            return;
+        }
+        // Every page starts small, so a page holding a handful of stray glyphs stays cheap
+        int size = FIRST_PAGE_SIZE;
+        while (size < std::max(w, h))
+            size *= 2;
+        Page &page  = _pages.emplace_back();
+        page.width  = size;
+        page.height = size;
+        page.packer = SkylinePacker(size, size);
+        clearPixels(page.pixels, static_cast<size_t>(size) * size);
+        _packInto(index, w, h, x, y);
+    }
+
+    Page &page = _pages[index];
+    for (int row = 0; row < bitmap.height; ++row)
+        std::memcpy(&page.pixels[(static_cast<size_t>(y + row) * page.width + x) * 4],
+            &bitmap.rgba[static_cast<size_t>(row) * bitmap.width * 4], static_cast<size_t>(bitmap.width) * 4);
+    if (page.dirtyX0 >= page.dirtyX1) {
+        page.dirtyX0 = x;
+        page.dirtyY0 = y;
+        page.dirtyX1 = x + bitmap.width;
+        page.dirtyY1 = y + bitmap.height;
+    } else {
+        page.dirtyX0 = std::min(page.dirtyX0, x);
+        page.dirtyY0 = std::min(page.dirtyY0, y);
+        page.dirtyX1 = std::max(page.dirtyX1, x + bitmap.width);
+        page.dirtyY1 = std::max(page.dirtyY1, y + bitmap.height);
+    }
+
+    const double bottom = page.height - y - bitmap.height; // the bitmap's bottom edge, y up
+    entry.glyph.page    = static_cast<uint16_t>(_firstPage + index);
+    entry.glyph.al += x;
+    entry.glyph.ar += x;
+    entry.glyph.ab += bottom;
+    entry.glyph.at += bottom;
+    entry.state = State::Ready;
+}
+
+bool GlyphAtlas::_packInto(size_t pageIndex, int w, int h, int &x, int &y) {
+    while (!_pages[pageIndex].packer.Pack(w, h, x, y)) {
+        if (_pages[pageIndex].width >= MAX_PAGE_SIZE)
+            return false;
+        _grow(pageIndex, _pages[pageIndex].width * 2);
+    }
+    return true;
+}
+
+void GlyphAtlas::_grow(size_t pageIndex, int size) {
+    Page                &page = _pages[pageIndex];
+    std::vector<uint8_t> pixels;
+    clearPixels(pixels, static_cast<size_t>(size) * size);
+    for (int row = 0; row < page.height; ++row)
+        std::memcpy(&pixels[static_cast<size_t>(row) * size * 4], &page.pixels[static_cast<size_t>(row) * page.width * 4],
+            static_cast<size_t>(page.width) * 4);
+
+    // Placed glyphs keep their pixels; measured from the new bottom edge they sit higher
+    const double   shift = size - page.height;
+    const uint16_t index = static_cast<uint16_t>(_firstPage + pageIndex);
+    for (auto &[codepoint, entry] : _entries) {
+        CachedGlyph &glyph = entry.glyph;
+        if (entry.state == State::Ready && glyph.page == index && glyph.ar > glyph.al) {
+            glyph.ab += shift;
+            glyph.at += shift;
+        }
+    }
+
+    page.pixels.swap(pixels);
+    page.packer.Grow(size, size);
+    page.width   = size;
+    page.height  = size;
+    page.resized = true;
+    page.dirtyX0 = page.dirtyX1 = 0; // the whole page goes up anyway
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+// Dynamic MSDF glyph atlas: glyphs are rasterized the first time they're asked for, on worker
+// threads, and packed into a set of atlas pages that grows with the text the game shows.
+//
+//   Find(codepoint)  main thread; returns the glyph once it's in a page, else queues it
+//   Update()         main thread, once per frame; packs what the workers finished
+//
+// A page starts at FIRST_PAGE_SIZE and doubles until MAX_PAGE_SIZE; after that a new page is
+// opened. Pages keep a CPU copy of their pixels and the rectangle written since the last
+// upload, so AssetHandler only sends the new glyphs to the GPU (or the whole page after it
+// grew). Glyph atlas bounds follow msdf-atlas-gen (pixels, y up from the page's bottom edge),
+// so static and dynamic glyphs draw the same way; they're rewritten when a page grows.
+//
+// The rasterizer is supplied by AssetHandler (msdfgen); it runs on the workers and must do its
+// own locking around anything shared, such as the FreeType face.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "assets/font/font.h"
+#include "assets/font/skylinepacker.h"
+
+class ThreadPool;
+
+/// @cond INTERNAL
+/// One rasterized glyph, as handed from a worker to the atlas.
+struct GlyphBitmap {
+    CachedGlyph          metrics; // atlas bounds relative to the bitmap, y up
+    int                  width  = 0;
+    int                  height = 0; // 0×0 for whitespace
+    std::vector<uint8_t> rgba;       // top row first
+};
+
+class GlyphAtlas {
+public:
+    /// Fills `out` for a codepoint; false if the font has no such glyph. Runs on a worker.
+    using Rasterizer = std::function<bool(uint32_t codepoint, GlyphBitmap &out)>;
+
+    static constexpr int FIRST_PAGE_SIZE = 256;
+    static constexpr int MAX_PAGE_SIZE   = 2048;
+    static constexpr int PADDING         = 1; // empty pixels between glyphs
+
+    struct Page {
+        int                  width  = 0;
+        int                  height = 0;
+        std::vector<uint8_t> pixels; // RGBA, top row first
+        SkylinePacker        packer { 0, 0 };
+
+        // Written since the last upload (top-down pixels; empty when x0 >= x1)
+        int dirtyX0 = 0, dirtyY0 = 0, dirtyX1 = 0, dirtyY1 = 0;
+        // The texture must be (re)created at the page's size and filled whole
+        bool resized = true;
+
+        GpuTextureHandle texture = 0; // created and released by AssetHandler
+    };
+
+    struct Stats {
+        uint32_t glyphs   = 0; // in a page (whitespace included)
+        uint32_t pending  = 0; // queued or being rasterized
+        uint32_t missing  = 0; // not in the font
+        uint32_t pages    = 0;
+        size_t   bytes    = 0; // page pixels (CPU copy; the GPU holds as much again)
+        uint64_t uploaded = 0; // bytes handed to the GPU so far
+    };
+
+    /// @param firstPage Page index of this atlas's first page in CachedGlyph::page (the font's
+    ///                  static atlas, if it has one, is page 0).
+    GlyphAtlas(Rasterizer rasterizer, ThreadPool &workers, uint16_t firstPage);
+    ~GlyphAtlas(); // waits for glyphs still on the workers
+
+    GlyphAtlas(const GlyphAtlas &)            = delete;
+    GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+
+    /// The glyph if it's ready; otherwise null, and it's queued unless known to be missing.
+    const CachedGlyph *Find(uint32_t codepoint);
+    /// True if the glyph is queued or being rasterized.
+    bool IsPending(uint32_t codepoint) const;
+    /// Queues a glyph ahead of its first use (no-op if it's known already).
+    void Request(uint32_t codepoint);
+
+    /// Packs the glyphs the workers finished into pages. Main thread, once per frame.
+    void Update();
+
+    /// Blocks until nothing is pending and packs it all (tools, tests, loading screens).
+    void Finish();
+
+    std::vector<Page> &Pages() { return _pages; }
+    uint16_t           FirstPage() const { return _firstPage; }
+    Stats              GetStats() const;
+
+    /// Records an upload of `bytes` (AssetHandler, after syncing a page).
+    void CountUpload(size_t bytes) { _uploaded += bytes; }
+
+private:
+    enum class State : uint8_t { Pending, Ready, Missing };
+
+    struct Entry {
+        State       state = State::Pending;
+        CachedGlyph glyph;
+    };
+
+    struct Finished {
+        uint32_t    codepoint;
+        bool        found;
+        GlyphBitmap bitmap;
+    };
+
+    void _place(Entry &entry, GlyphBitmap &bitmap);
+    bool _packInto(size_t pageIndex, int w, int h, int &x, int &y);
+    void _grow(size_t pageIndex, int size);
+
+    Rasterizer _rasterizer;
+    ThreadPool &_workers;
+    uint16_t   _firstPage;
+
+    std::unordered_map<uint32_t, Entry> _entries; // main thread only; references stay valid
+    std::vector<Page>                   _pages;
+    uint32_t                            _pending  = 0;
+    uint64_t                            _uploaded = 0;
+
+    // Shared with the workers
+    std::mutex              _mutex;
+    std::condition_variable _idle;
+    std::vector<Finished>   _finished;
+    std::vector<Finished>   _taken; // swapped with _finished by Update
+    uint32_t                _inFlight = 0;
+    std::atomic<bool>       _anyFinished { false };
+    std::atomic<bool>       _closing { false };
+};
+/// @endcond
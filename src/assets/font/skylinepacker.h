@@ -0,0 +1,124 @@
+#pragma once
+
+// Online rectangle packer for the dynamic glyph atlas (glyphatlas.h). The skyline is the
+// outline of everything placed so far, one segment per run of equal height; a new rectangle
+// goes where its bottom edge ends up highest (bottom-left rule), ties to the narrowest spot.
+// Coordinates are top-down: (0, 0) is the top-left corner, y grows downwards.
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @cond INTERNAL
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height)
+        : _width(width)
+        , _height(height) {
+        _skyline.push_back({ 0, 0, width });
+    }
+
+    /// Places a w×h rectangle; false if it doesn't fit anywhere.
+    bool Pack(int w, int h, int &x, int &y) {
+        if (w <= 0 || h <= 0 || w > _width || h > _height)
+            return false;
+
+        size_t best       = SIZE_MAX;
+        int    bestBottom = INT_MAX;
+        int    bestWidth  = INT_MAX;
+        for (size_t i = 0; i < _skyline.size(); ++i) {
+            int top;
+            if (!_fits(i, w, h, top))
+                continue;
+            const int bottom = top + h;
+            if (bottom < bestBottom || (bottom == bestBottom && _skyline[i].width < bestWidth)) {
+                best       = i;
+                bestBottom = bottom;
+                bestWidth  = _skyline[i].width;
+            }
+        }
+        if (best == SIZE_MAX)
+            return false;
+
+        x = _skyline[best].x;
+        y = bestBottom - h;
+        _place(best, x, w, bestBottom);
+        _used += static_cast<long long>(w) * h;
+        return true;
+    }
+
+    /// Enlarges the bin; everything placed so far keeps its position.
+    void Grow(int width, int height) {
+        if (width > _width) {
+            if (_skyline.back().y == 0)
+                _skyline.back().width += width - _width;
+            else
+                _skyline.push_back({ _width, 0, width - _width });
+            _width = width;
+        }
+        _height = std::max(_height, height);
+    }
+
+    int       Width() const { return _width; }
+    int       Height() const { return _height; }
+    long long UsedArea() const { return _used; }
+
+private:
+    struct Segment {
+        int x;
+        int y; // bottom of what's placed over [x, x + width)
+        int width;
+    };
+
+    // Top edge a w×h rectangle would get with its left side at segment i
+    bool _fits(size_t i, int w, int h, int &top) const {
+        if (_skyline[i].x + w > _width)
+            return false;
+        top           = 0;
+        int remaining = w;
+        for (size_t j = i; remaining > 0; ++j) {
+            top = std::max(top, _skyline[j].y);
+            if (top + h > _height)
+                return false;
+            remaining -= _skyline[j].width;
+        }
+        return true;
+    }
+
+    void _place(size_t index, int x, int w, int bottom) {
+        _skyline.insert(_skyline.begin() + static_cast<std::ptrdiff_t>(index), { x, bottom, w });
+
+        // Trim the segments the new one now covers
+        const int right = x + w;
+        size_t    next  = index + 1;
+        while (next < _skyline.size() && _skyline[next].x < right) {
+            Segment  &segment = _skyline[next];
+            const int end     = segment.x + segment.width;
+            if (end <= right) {
+                _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(next));
+                continue;
+            }
+            segment.width = end - right;
+            segment.x     = right;
+            break;
+        }
+
+        // Merge neighbours of equal height
+        for (size_t i = 0; i + 1 < _skyline.size();) {
+            if (_skyline[i].y == _skyline[i + 1].y) {
+                _skyline[i].width += _skyline[i + 1].width;
+                _skyline.erase(_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    int                  _width;
+    int                  _height;
+    long long            _used = 0;
+    std::vector<Segment> _skyline; // left to right, covering [0, _width)
+};
+/// @endcond
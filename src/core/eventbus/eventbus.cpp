@@ -1,13 +1,126 @@
 #include "eventbus.h"
 
-void EventBus::_fire(std::string eventName, std::optional<EventData> eventData) {
+// ── Typed events ──
+
+EventBus::Channel &EventBus::_channel(uint32_t typeId) {
+    if (typeId >= _channels.size()) {
+        _channels.resize(typeId + 1);
+    }
+    return _channels[typeId];
+}
+
+SubscriptionId EventBus::_subscribe(uint32_t typeId, std::function<void(const void *)> fn) {
+    const uint32_t serial = _nextSerial++;
+    Channel       &ch     = _channel(typeId);
+    // Mid-dispatch the handler list must not reallocate (a running handler lives in it)
+    (ch.dispatchDepth > 0 ? ch.added : ch.handlers).push_back({ serial, std::move(fn) });
+    return (static_cast<SubscriptionId>(typeId) << 32) | serial;
+}
+
+void EventBus::_unsubscribe(SubscriptionId id) {
+    const auto typeId = static_cast<uint32_t>(id >> 32);
+    const auto serial = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    if (typeId >= _channels.size()) {
+        return;
+    }
+
+    Channel &ch = _channels[typeId];
+    for (auto *list : { &ch.handlers, &ch.added }) {
+        for (size_t i = 0; i < list->size(); ++i) {
+            if ((*list)[i].serial != serial) {
+                continue;
+            }
+            if (ch.dispatchDepth > 0) {
+                // Mid-dispatch: the handler may be the one running; only mark it
+                (*list)[i].removed = true;
+                ch.needsCompact    = true;
+            } else {
+                list->erase(list->begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            return;
+        }
+    }
+}
+
+void EventBus::_emit(uint32_t typeId, const void *event) {
+    if (typeId >= _channels.size()) {
+        return;
+    }
+
+    // Re-fetch the channel each step: a handler subscribing to a new type grows _channels.
+    // The handler list itself is stable during dispatch (see _subscribe/_unsubscribe).
+    _channels[typeId].dispatchDepth++;
+    const size_t count = _channels[typeId].handlers.size();
+    for (size_t i = 0; i < count; ++i) {
+        const Handler &handler = _channels[typeId].handlers[i];
+        if (!handler.removed) {
+            handler.fn(event);
+        }
+    }
+
+    Channel &ch = _channels[typeId];
+    if (--ch.dispatchDepth == 0) {
+        if (ch.needsCompact) {
+            ch.handlers.erase(std::remove_if(ch.handlers.begin(), ch.handlers.end(),
+                                  [](const Handler &h) { return h.removed; }),
+                ch.handlers.end());
+            ch.added.erase(std::remove_if(ch.added.begin(), ch.added.end(),
+                               [](const Handler &h) { return h.removed; }),
+                ch.added.end());
+            ch.needsCompact = false;
+        }
+        if (!ch.added.empty()) {
+            for (auto &handler : ch.added) {
+                ch.handlers.push_back(std::move(handler));
+            }
+            ch.added.clear();
+        }
+    }
+}
+
+void EventBus::_flush() {
+    if (_flushing || _pendingTypes.empty()) {
+        return; // a handler calling Flush just lets the outer flush finish
+    }
+    _flushing = true;
+
+    // Swap in fresh queues first so handlers can Enqueue follow-ups for the next flush
+    Arena &frame = _arenas[_writeArena];
+    _writeArena ^= 1;
+    std::swap(_pendingTypes, _flushingTypes);
+
+    for (uint32_t typeId : _flushingTypes) {
+        std::swap(_channels[typeId].pending, _channels[typeId].flushing);
+
+        // One type at a time: the handler list stays hot in cache for the whole batch
+        for (size_t i = 0; i < _channels[typeId].flushing.size(); ++i) {
+            _emit(typeId, _channels[typeId].flushing[i]);
+        }
+
+        Channel &ch = _channels[typeId];
+        if (ch.destroy) {
+            for (void *event : ch.flushing) {
+                ch.destroy(event);
+            }
+        }
+        ch.flushing.clear(); // keeps capacity: steady-state flushing never allocates
+    }
+
+    _flushingTypes.clear();
+    frame.Reset();
+    _flushing = false;
+}
+
+// ── Named events ──
+
+void EventBus::_fire(const std::string &eventName, const EventData *eventData) {
     bool eventFound = false;
 
-    if (eventData.has_value()) {
+    if (eventData) {
         auto datait = _eventsData.find(eventName);
         if (datait != _eventsData.end()) {
             for (const auto &callback : datait->second) {
-                callback(eventData.value());
+                callback(*eventData);
             }
             eventFound = true;
         }
@@ -38,7 +151,7 @@ void EventBus::_register(SystemEvent eventName, EventCallbackData callback) {
     _systemEvents[eventName].push_back(callback);
 }
 
-void EventBus::_fire(SystemEvent eventName, EventData eventData) {
+void EventBus::_fire(SystemEvent eventName, const EventData &eventData) {
     for (auto &callback : _systemEvents[eventName]) {
         callback(eventData);
     }
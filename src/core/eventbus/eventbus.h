@@ -1,13 +1,32 @@
 #pragma once
 
+// Two event APIs share this bus:
+//
+//   Typed (preferred)  any struct is an event. Subscribe<T>/Emit/Enqueue, dispatched through a
+//                      flat per-type handler list indexed by an interned type ID — no strings,
+//                      no maps, no allocation per event. Enqueue defers to Flush (once per frame,
+//                      from Window), with payloads placed in a per-frame arena.
+//   Named (legacy)     string/SystemEvent names with an EventData map payload. Convenient for
+//                      scripting-style glue, but builds and copies a map per call; keep it off
+//                      hot paths.
+//
+// The bus is main-thread only.
+
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <new>
 #include <vector>
 #include <unordered_map>
 #include <string>
 #include <functional>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <optional>
 
+#include "util/arena.h"
+
 // Event names are a public SCREAMING_CASE vocabulary, matched to the SDL event style.
 // NOLINTBEGIN(readability-identifier-naming)
 enum class SystemEvent {
@@ -24,11 +43,91 @@ using EventData = std::unordered_map<std::string, std::variant<int, float, std::
 using EventCallback     = std::function<void()>;
 using EventCallbackData = std::function<void(EventData)>;
 
+/// @brief Typed counterpart of SystemEvent::WINDOW_RESIZE (main window, logical size).
+struct WindowResizeEvent {
+    int width;
+    int height;
+};
+
+/// @brief Handle returned by EventBus::Subscribe, used to unsubscribe.
+using SubscriptionId = uint64_t;
+
+/// @brief Interns event types as small sequential IDs (assigned on first use).
+class EventType {
+public:
+    template <typename T>
+    static uint32_t Id() {
+        static const uint32_t id = _next()++;
+        return id;
+    }
+
+private:
+    static uint32_t &_next() {
+        static uint32_t next = 0;
+        return next;
+    }
+};
+
 /**
  * @brief Provides functionality for event registration and firing.
  */
 class EventBus {
 public:
+    /**
+     * @brief Subscribes to a typed event.
+     *
+     * @param callback Called with each emitted T. Subscribing/unsubscribing from inside a
+     *                 handler is allowed; new handlers start with the next event.
+     * @return ID for Unsubscribe.
+     */
+    template <typename T, typename F>
+    static SubscriptionId Subscribe(F &&callback) {
+        static_assert(std::is_invocable_v<F, const T &>, "EventBus::Subscribe<T>: callback must accept const T &");
+        return Get()._subscribe(EventType::Id<T>(), [fn = std::forward<F>(callback)](const void *event) {
+            fn(*static_cast<const T *>(event));
+        });
+    }
+
+    /// @brief Removes a typed subscription. Unknown or already-removed IDs are ignored.
+    static void Unsubscribe(SubscriptionId id) {
+        Get()._unsubscribe(id);
+    }
+
+    /// @brief Dispatches a typed event to its subscribers immediately.
+    template <typename T>
+    static void Emit(const T &event) {
+        Get()._emit(EventType::Id<T>(), &event);
+    }
+
+    /**
+     * @brief Queues a typed event for the next Flush.
+     *
+     * The payload is copied into the frame arena. Events of one type are delivered in the order
+     * they were queued; different types are delivered in batches, one type at a time.
+     */
+    template <typename T>
+    static void Enqueue(T event) {
+        using U = std::decay_t<T>;
+        EventBus &bus  = Get();
+        Channel  &ch   = bus._channel(EventType::Id<U>());
+        void     *slot = bus._arenas[bus._writeArena].Allocate(sizeof(U), alignof(U));
+        new (slot) U(std::move(event));
+        if constexpr (!std::is_trivially_destructible_v<U>)
+            ch.destroy = [](void *p) { static_cast<U *>(p)->~U(); };
+        if (ch.pending.empty())
+            bus._pendingTypes.push_back(EventType::Id<U>());
+        ch.pending.push_back(slot);
+    }
+
+    /**
+     * @brief Delivers every queued event, then recycles the frame arena. Called by Window each
+     * frame after input; call it yourself for extra sync points. Events queued by handlers
+     * during a flush are delivered by the next one.
+     */
+    static void Flush() {
+        Get()._flush();
+    }
+
     /**
      * @brief Registers a callback function for the specified event name.
      *
@@ -54,8 +153,8 @@ public:
      *
      * @param eventName The name of the event to fire.
      */
-    static void Fire(std::string eventName) {
-        Get()._fire(eventName, std::nullopt);
+    static void Fire(const std::string &eventName) {
+        Get()._fire(eventName, nullptr);
     }
 
     /**
@@ -64,8 +163,8 @@ public:
      * @param eventName The name of the event to fire.
      * @param eventData The data associated with the event.
      */
-    static void Fire(std::string eventName, EventData eventData) {
-        Get()._fire(eventName, eventData);
+    static void Fire(const std::string &eventName, const EventData &eventData) {
+        Get()._fire(eventName, &eventData);
     }
 
     /**
@@ -84,12 +183,46 @@ public:
      * @param eventName The system event to fire.
      * @param eventData The data associated with the event.
      */
-    static void Fire(SystemEvent eventName, EventData eventData) {
+    static void Fire(SystemEvent eventName, const EventData &eventData) {
         Get()._fire(eventName, eventData);
     }
 
 private:
-    void _fire(std::string eventName, std::optional<EventData> eventData);
+    struct Handler {
+        uint32_t                          serial;
+        std::function<void(const void *)> fn;
+        bool                              removed = false; // unsubscribed mid-dispatch
+    };
+
+    struct Channel {
+        std::vector<Handler> handlers;
+        std::vector<Handler> added;              // subscribed mid-dispatch, merged afterwards
+        std::vector<void *>  pending;            // queued payloads (in the write arena)
+        std::vector<void *>  flushing;           // the batch being delivered (swapped with pending)
+        void (*destroy)(void *)   = nullptr;     // null for trivially destructible payloads
+        int  dispatchDepth        = 0;
+        bool needsCompact         = false;
+    };
+
+    Channel &_channel(uint32_t typeId);
+
+    SubscriptionId _subscribe(uint32_t typeId, std::function<void(const void *)> fn);
+
+    void _unsubscribe(SubscriptionId id);
+
+    void _emit(uint32_t typeId, const void *event);
+
+    void _flush();
+
+    std::vector<Channel>  _channels;        // indexed by EventType ID
+    std::vector<uint32_t> _pendingTypes;    // channels with queued events, in first-queued order
+    std::vector<uint32_t> _flushingTypes;
+    Arena                 _arenas[2];       // write arena / arena being flushed
+    int                   _writeArena = 0;
+    uint32_t              _nextSerial = 1;
+    bool                  _flushing   = false;
+
+    void _fire(const std::string &eventName, const EventData *eventData);
 
     void _register(std::string eventName, EventCallback callback);
 
@@ -97,7 +230,7 @@ private:
 
     void _register(SystemEvent eventName, EventCallbackData callback);
 
-    void _fire(SystemEvent eventName, EventData eventData);
+    void _fire(SystemEvent eventName, const EventData &eventData);
 
     std::unordered_map<std::string, std::vector<EventCallback>>     _events;
     std::unordered_map<std::string, std::vector<EventCallbackData>> _eventsData;
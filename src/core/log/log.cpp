@@ -2,6 +2,8 @@
 
 #include <SDL3/SDL.h>
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <sstream>
 
 #ifdef _WIN32
@@ -31,32 +33,52 @@ Log::Log()
     auto memSink      = std::make_unique<MemoryBufferSink>(1000);
     _memoryBufferSink = memSink.get();
     _sinks.push_back(std::move(memSink));
+    _updateThreshold();
+
+    // Sink thread. Without thread support (single-threaded web builds) every call drains inline.
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+    _running = true;
+    _thread  = std::thread([this] { _sinkThread(); });
+#endif
 }
 
 // Log destructor - auto-cleanup on program exit
 Log::~Log() {
+    if (_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _running = false;
+        }
+        _wake.notify_all();
+        _thread.join();
+    }
     _flushAll();
     _sinks.clear();
     _memoryBufferSink = nullptr;
 }
 
 void Log::_addSink(std::unique_ptr<LogSink> sink) {
+    _drain(); // entries logged before the sink existed stay out of it
     size_t count;
     {
         std::lock_guard<std::mutex> lock(_sinkMutex);
         _sinks.push_back(std::move(sink));
         count = _sinks.size();
+        _updateThreshold();
     }
     LOG_INFO("Log sink added ({} total)", count);
 }
 
 void Log::_clearSinks() {
+    _drain();
     std::lock_guard<std::mutex> lock(_sinkMutex);
     _sinks.clear();
     _memoryBufferSink = nullptr;
+    _updateThreshold();
 }
 
 void Log::_flushAll() {
+    _drain();
     std::lock_guard<std::mutex> lock(_sinkMutex);
     for (auto &sink : _sinks) {
         sink->Flush();
@@ -64,17 +86,31 @@ void Log::_flushAll() {
 }
 
 void Log::_setMinLevel(LogLevel level) {
+    _drain(); // already-queued entries were filtered against the old level
     std::lock_guard<std::mutex> lock(_sinkMutex);
 
-    // Update SDL console sink min level
+    // Update console and history min level; with both raised, lower levels aren't even formatted
     for (auto &sink : _sinks) {
         if (auto *sdlSink = dynamic_cast<SDLConsoleSink *>(sink.get())) {
             sdlSink->SetMinLevel(level);
+        } else if (auto *memorySink = dynamic_cast<MemoryBufferSink *>(sink.get())) {
+            memorySink->SetMinLevel(level);
         }
     }
+    _updateThreshold();
+}
+
+void Log::_updateThreshold() {
+    // No sinks: nothing below Error is worth formatting (Error/Critical are never filtered)
+    LogLevel lowest = LogLevel::Error;
+    for (auto &sink : _sinks) {
+        lowest = std::min(lowest, sink->GetMinLevel());
+    }
+    _threshold.store(lowest, std::memory_order_relaxed);
 }
 
 std::vector<LogEntry> Log::_getLines(LogLevel minLevel) {
+    _drain();
     if (_memoryBufferSink) {
         return _memoryBufferSink->GetEntries(minLevel);
     }
@@ -82,6 +118,7 @@ std::vector<LogEntry> Log::_getLines(LogLevel minLevel) {
 }
 
 std::vector<LogEntry> Log::_getUserLines() {
+    _drain();
     if (_memoryBufferSink) {
         return _memoryBufferSink->GetUserEntries();
     }
@@ -107,75 +144,159 @@ bool Log::_dumpToFile(const std::string &filename, LogLevel minLevel) {
     return true;
 }
 
-std::string Log::_extractFilename(const char *path) {
-    std::string pathStr(path);
-
-    // Find last slash or backslash
-    size_t lastSlash = pathStr.find_last_of("/\\");
-    if (lastSlash != std::string::npos) {
-        return pathStr.substr(lastSlash + 1);
+template <typename F>
+void Log::_push(LogLevel level, F &&fill) {
+    bool pushed = _queue.TryPush(fill);
+    if (!pushed && level >= LogLevel::Error) {
+        _drain();
+        pushed = _queue.TryPush(fill);
+    }
+    // Ring full: help drain if the sinks are free, otherwise give the sink thread a moment.
+    // Only a sustained flood (sinks busy the whole time) ends up dropping.
+    for (int attempt = 0; !pushed && attempt < FULL_RETRIES; ++attempt) {
+        std::unique_lock<std::mutex> lock(_sinkMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            _drainLocked();
+        } else {
+            std::this_thread::yield();
+        }
+        pushed = _queue.TryPush(fill);
+    }
+    if (!pushed) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
 
-    return pathStr;
+    if (!_thread.joinable()) {
+        _drain();
+    } else if (_queue.Size() >= QUEUE_CAPACITY / 2) {
+        _wake.notify_one();
+    }
 }
 
-std::string Log::_cleanFunctionName(const char *funcName) {
-    std::string func(funcName);
+void Log::_enqueueEncoded(LogLevel level, const char *file, int line, const char *func,
+    fmt::string_view format, const char *data, size_t size) {
+    const auto now = std::chrono::system_clock::now();
+    _push(level, [&](LogRecord &record) {
+        record.timestamp    = now;
+        record.file         = file;
+        record.function     = func;
+        record.format       = format.data();
+        record.formatLength = static_cast<uint32_t>(format.size());
+        record.overflow     = nullptr;
+        record.line         = line;
+        record.length       = static_cast<uint32_t>(size);
+        record.level        = level;
+        record.isUserFacing = false;
+        record.encoded      = true;
+        if (size > 0) {
+            std::memcpy(record.message, data, size);
+        }
+    });
+}
 
-    // GCC/Clang format: "returnType ClassName::methodName(params)"
-    // MSVC format: "ClassName::methodName"
+void Log::_enqueue(LogLevel level, bool isUserFacing, const char *file, int line, const char *func,
+    fmt::string_view format, fmt::format_args args) {
+    const auto now = std::chrono::system_clock::now();
+    _push(level, [&](LogRecord &record) {
+        record.timestamp    = now;
+        record.file         = file;
+        record.function     = func;
+        record.format       = format.data();
+        record.formatLength = static_cast<uint32_t>(format.size());
+        record.line         = line;
+        record.level        = level;
+        record.isUserFacing = isUserFacing;
+        record.encoded      = false;
 
-    // Remove template parameters: "Foo<T>::bar" -> "Foo::bar"
-    size_t templateStart = func.find('<');
-    while (templateStart != std::string::npos) {
-        size_t templateEnd = func.find('>', templateStart);
-        if (templateEnd != std::string::npos) {
-            func.erase(templateStart, templateEnd - templateStart + 1);
-            templateStart = func.find('<');
+        auto result = fmt::vformat_to_n(record.message, LogRecord::MESSAGE_CAPACITY, format, args);
+        if (result.size <= LogRecord::MESSAGE_CAPACITY) {
+            record.length   = static_cast<uint32_t>(result.size);
+            record.overflow = nullptr;
         } else {
-            break;
+            record.length   = 0;
+            record.overflow = new std::string(fmt::vformat(format, args));
         }
-    }
+    });
+}
 
-    // Find opening parenthesis to locate the end of function name
-    size_t parenPos = func.find('(');
-    if (parenPos == std::string::npos) {
-        // No parenthesis, return as-is
-        return func;
-    }
+void Log::_drain() {
+    std::lock_guard<std::mutex> lock(_sinkMutex);
+    _drainLocked();
+}
+
+void Log::_drainLocked() {
+    _queue.Drain([this](LogRecord &record) {
+        // Binary sinks take the record as-is; the LogEntry (and any formatting) is only built
+        // if a text sink actually wants this level.
+        bool wantsText = false;
+        for (auto &sink : _sinks) {
+            if (record.level < sink->GetMinLevel()) {
+                continue;
+            }
+            if (sink->IsBinary()) {
+                sink->WriteRecord(record);
+            } else {
+                wantsText = true;
+            }
+        }
 
-    // Find the last :: before the parenthesis
-    size_t lastScope = func.rfind("::", parenPos);
+        if (wantsText) {
+            LogEntry entry;
+            entry.timestamp    = record.timestamp;
+            entry.level        = record.level;
+            entry.message      = record.Text();
+            entry.file         = LogEntry::ExtractFilename(record.file);
+            entry.line         = record.line;
+            entry.function     = LogEntry::CleanFunctionName(record.function);
+            entry.isUserFacing = record.isUserFacing;
 
-    if (lastScope != std::string::npos) {
-        // Found scope operator - extract "ClassName::methodName"
-        // Find the start of the class name (space or start of string)
-        size_t classStart = func.rfind(' ', lastScope);
-        if (classStart == std::string::npos) {
-            classStart = 0;
-        } else {
-            classStart++; // Skip the space
+            for (auto &sink : _sinks) {
+                if (!sink->IsBinary()) {
+                    sink->Write(entry);
+                }
+            }
         }
 
-        // Extract from class name to opening parenthesis
-        return func.substr(classStart, parenPos - classStart);
-    } else {
-        // No scope operator - it's a free function
-        // Find the function name (after last space before parenthesis)
-        size_t funcStart = func.rfind(' ', parenPos);
-        if (funcStart == std::string::npos) {
-            funcStart = 0;
-        } else {
-            funcStart++;
+        delete record.overflow;
+        record.overflow = nullptr;
+    });
+
+    const uint32_t dropped = _dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        LogEntry entry;
+        entry.timestamp    = std::chrono::system_clock::now();
+        entry.level        = LogLevel::Warning;
+        entry.message      = fmt::format("{} log entries dropped (logging faster than the sinks can keep up)", dropped);
+        entry.file         = "log.cpp";
+        entry.line         = __LINE__;
+        entry.function     = "Log::_drain";
+        entry.isUserFacing = false;
+        for (auto &sink : _sinks) {
+            sink->Write(entry);
         }
-        return func.substr(funcStart, parenPos - funcStart);
     }
 }
 
-void Log::_writeToSinks(const LogEntry &entry) {
-    std::lock_guard<std::mutex> lock(_sinkMutex);
+void Log::_sinkThread() {
+    auto lastFlush = std::chrono::steady_clock::now();
 
-    for (auto &sink : _sinks) {
-        sink->Write(entry);
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    while (_running) {
+        _wake.wait_for(lock, std::chrono::milliseconds(DRAIN_INTERVAL_MS));
+        lock.unlock();
+
+        _drain();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastFlush >= std::chrono::milliseconds(FLUSH_INTERVAL_MS)) {
+            std::lock_guard<std::mutex> sinkLock(_sinkMutex);
+            for (auto &sink : _sinks) {
+                sink->Flush();
+            }
+            lastFlush = now;
+        }
+
+        lock.lock();
     }
 }
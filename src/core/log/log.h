@@ -4,12 +4,23 @@
 //
 // The record type and the output destinations live alongside this header:
 //   core/log/logentry.h              LogLevel + LogEntry
+//   core/log/logrecord.h             LogRecord (the queued form) + the raw argument encoding
 //   core/log/logsink.h               LogSink base (implement to add your own destination)
-//   core/log/sinks/*.h               built-in sinks (console, file, memory buffer)
-
+//   core/log/sinks/*.h               built-in sinks (console, file, binary file, memory buffer)
+//
+// Cost model: a disabled LOG_DEBUG/INFO/WARNING is one relaxed atomic load (or nothing at all
+// when compiled out via LUMINOVEAU_LOG_MIN_LEVEL). An enabled one copies its arguments raw into
+// a slot of a lock-free ring (or formats them there, for types LogArgs can't encode); a
+// background thread feeds the sinks, formatting only for text sinks that want the level. The
+// calling thread never takes a lock or touches a file. LOG_ERROR/LOG_CRITICAL are never
+// filtered and drain the ring synchronously before throwing/exiting.
+
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <cstdlib>   // for std::exit
 #include <stdexcept> // for std::runtime_error
@@ -17,10 +28,19 @@
 #include <fmt/format.h>
 
 #include "core/log/logentry.h"
+#include "core/log/logrecord.h"
 #include "core/log/logsink.h"
+#include "core/log/sinks/binaryfilesink.h"
 #include "core/log/sinks/filesink.h"
 #include "core/log/sinks/memorybuffersink.h"
 #include "core/log/sinks/sdlconsolesink.h"
+#include "util/mpscqueue.h"
+
+// Lowest level compiled in: 0 = Debug, 1 = Info, 2 = Warning (set via the LUMINOVEAU_LOG_LEVEL
+// CMake cache variable). Calls below it vanish entirely — arguments are not even evaluated.
+#ifndef LUMINOVEAU_LOG_MIN_LEVEL
+#define LUMINOVEAU_LOG_MIN_LEVEL 0
+#endif
 
 // Cross-platform function name macro
 #ifdef _MSC_VER
@@ -32,12 +52,24 @@
 #endif
 
 // Logging macros with automatic location capture
-// LOG_DEBUG, LOG_INFO, LOG_WARNING - Log messages only
+// LOG_DEBUG, LOG_INFO, LOG_WARNING - Log messages only; skipped before formatting when no sink wants the level
 // LOG_ERROR - Logs the error and throws std::runtime_error (catchable)
 // LOG_CRITICAL - Logs the error, flushes all sinks, and exits program with EXIT_FAILURE
-#define LOG_DEBUG(fmt, ...) Log::DebugImpl(__FILE__, __LINE__, CURRENT_METHOD(), fmt, ##__VA_ARGS__)
-#define LOG_INFO(fmt, ...) Log::InfoImpl(__FILE__, __LINE__, CURRENT_METHOD(), fmt, ##__VA_ARGS__)
-#define LOG_WARNING(fmt, ...) Log::WarningImpl(__FILE__, __LINE__, CURRENT_METHOD(), fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(fmt, ...)                                                                    \
+    do {                                                                                       \
+        if (LUMINOVEAU_LOG_MIN_LEVEL <= 0 && Log::IsEnabled(LogLevel::Debug))                  \
+            Log::DebugImpl(__FILE__, __LINE__, CURRENT_METHOD(), fmt, ##__VA_ARGS__);          \
+    } while (0)
+#define LOG_INFO(fmt, ...)                                                                     \
+    do {                                                                                       \
+        if (LUMINOVEAU_LOG_MIN_LEVEL <= 1 && Log::IsEnabled(LogLevel::Info))                   \
+            Log::InfoImpl(__FILE__, __LINE__, CURRENT_METHOD(), fmt, ##__VA_ARGS__);           \
+    } while (0)
+#define LOG_WARNING(fmt, ...)                                                                  \
+    do {                                                                                       \
+        if (LUMINOVEAU_LOG_MIN_LEVEL <= 2 && Log::IsEnabled(LogLevel::Warning))                \
+            Log::WarningImpl(__FILE__, __LINE__, CURRENT_METHOD(), fmt, ##__VA_ARGS__);        \
+    } while (0)
 #define LOG_ERROR(fmt, ...) Log::ErrorImpl(__FILE__, __LINE__, CURRENT_METHOD(), fmt, ##__VA_ARGS__)
 #define LOG_CRITICAL(fmt, ...) Log::CriticalImpl(__FILE__, __LINE__, CURRENT_METHOD(), fmt, ##__VA_ARGS__)
 
@@ -50,51 +82,70 @@ public:
     // Internal implementation - called by macros
     template <typename... Args>
     static void DebugImpl(const char *file, int line, const char *func, fmt::format_string<Args...> fmt, Args &&...args) {
-        Get()._logImpl(LogLevel::Debug, false, file, line, func, fmt::format(fmt, std::forward<Args>(args)...));
+        Get()._log(LogLevel::Debug, file, line, func, fmt::string_view(fmt), args...);
     }
 
     template <typename... Args>
     static void InfoImpl(const char *file, int line, const char *func, fmt::format_string<Args...> fmt, Args &&...args) {
-        Get()._logImpl(LogLevel::Info, false, file, line, func, fmt::format(fmt, std::forward<Args>(args)...));
+        Get()._log(LogLevel::Info, file, line, func, fmt::string_view(fmt), args...);
     }
 
     template <typename... Args>
     static void WarningImpl(const char *file, int line, const char *func, fmt::format_string<Args...> fmt, Args &&...args) {
-        Get()._logImpl(LogLevel::Warning, false, file, line, func, fmt::format(fmt, std::forward<Args>(args)...));
+        Get()._log(LogLevel::Warning, file, line, func, fmt::string_view(fmt), args...);
     }
 
     template <typename... Args>
     [[noreturn]] static void ErrorImpl(const char *file, int line, const char *func, fmt::format_string<Args...> fmt, Args &&...args) {
         std::string message = fmt::format(fmt, std::forward<Args>(args)...);
-        Get()._logImpl(LogLevel::Error, false, file, line, func, message);
+        Get()._enqueue(LogLevel::Error, false, file, line, func, "{}", fmt::make_format_args(message));
+        Get()._flushAll(); // The throw may end the program; make sure the record is out first
         throw std::runtime_error(message);
     }
 
     template <typename... Args>
     [[noreturn]] static void CriticalImpl(const char *file, int line, const char *func, fmt::format_string<Args...> fmt, Args &&...args) {
         std::string message = fmt::format(fmt, std::forward<Args>(args)...);
-        Get()._logImpl(LogLevel::Critical, false, file, line, func, message);
+        Get()._enqueue(LogLevel::Critical, false, file, line, func, "{}", fmt::make_format_args(message));
         Get()._flushAll(); // Flush all logs before exit
         std::exit(EXIT_FAILURE);
     }
     /// @endcond
 
+    /**
+     * @brief True if at least one sink accepts this level. One relaxed atomic load; the LOG_*
+     * macros call it so disabled messages are never formatted.
+     */
+    static bool IsEnabled(LogLevel level) { return level >= Get()._threshold.load(std::memory_order_relaxed); }
+
 private:
-    // Core logging implementation
-    void _logImpl(LogLevel level, bool isUserFacing, const char *file, int line, const char *func,
-        const std::string &message) {
-        LogEntry entry;
-        entry.timestamp    = std::chrono::system_clock::now();
-        entry.level        = level;
-        entry.message      = message;
-        entry.file         = _extractFilename(file);
-        entry.line         = line;
-        entry.function     = _cleanFunctionName(func);
-        entry.isUserFacing = isUserFacing;
-
-        _writeToSinks(entry);
+    // Arguments LogArgs can encode are queued raw (a call without any queues no bytes); anything
+    // else is formatted now.
+    template <typename... Args>
+    void _log(LogLevel level, const char *file, int line, const char *func, fmt::string_view format, const Args &...args) {
+        if constexpr (sizeof...(Args) == 0) {
+            _enqueueEncoded(level, file, line, func, format, nullptr, 0);
+            return;
+        } else if constexpr ((LogArgs::IsEncodable<std::decay_t<Args>> && ...)) {
+            char      encoded[LogRecord::MESSAGE_CAPACITY];
+            const int size = LogArgs::Encode(encoded, sizeof(encoded), args...);
+            if (size >= 0) {
+                _enqueueEncoded(level, file, line, func, format, encoded, static_cast<size_t>(size));
+                return;
+            }
+        }
+        _enqueue(level, false, file, line, func, format, fmt::make_format_args(args...));
     }
 
+    void _enqueueEncoded(LogLevel level, const char *file, int line, const char *func,
+        fmt::string_view format, const char *data, size_t size);
+
+    // Formats into a ring slot on the calling thread. Never waits on a lock for Debug..Warning: on
+    // a full ring it helps drain when the sinks are free, and drops (counted) if they stay busy.
+    // Error/Critical drain the ring on the calling thread to make room instead.
+    void _enqueue(LogLevel level, bool isUserFacing, const char *file, int line, const char *func,
+        fmt::string_view format, fmt::format_args args);
+
 public:
     // Sink management
     static void AddSink(std::unique_ptr<LogSink> sink) { Get()._addSink(std::move(sink)); }
@@ -114,10 +165,28 @@ public:
     }
 
 private:
+    /// Ring slots (~0.5 KB each). A burst larger than this before the sink thread wakes is dropped.
+    static constexpr size_t QUEUE_CAPACITY = 2048;
+    /// How often the sink thread wakes on its own; it's also woken early once the ring is half full.
+    static constexpr int DRAIN_INTERVAL_MS = 10;
+    /// How often buffered sinks (FileSink) are flushed while idle.
+    static constexpr int FLUSH_INTERVAL_MS = 250;
+    /// Push attempts (each a drain or a yield) before a record is dropped on a full ring.
+    static constexpr int FULL_RETRIES = 64;
+
     std::vector<std::unique_ptr<LogSink>> _sinks;
-    std::mutex                            _sinkMutex;
+    std::mutex                            _sinkMutex; // guards _sinks and is the single consumer lock
     MemoryBufferSink                     *_memoryBufferSink; // Quick access to memory buffer
 
+    MpscQueue<LogRecord, QUEUE_CAPACITY> _queue;
+    std::atomic<LogLevel>                _threshold { LogLevel::Debug }; // lowest level any sink accepts
+    std::atomic<uint32_t>                _dropped { 0 };
+
+    std::thread             _thread;
+    std::atomic<bool>       _running { false };
+    std::mutex              _wakeMutex;
+    std::condition_variable _wake;
+
     // Instance methods
     void                  _addSink(std::unique_ptr<LogSink> sink);
     void                  _clearSinks();
@@ -128,9 +197,12 @@ private:
     bool                  _dumpToFile(const std::string &filename, LogLevel minLevel);
 
     // Helper functions
-    static std::string _extractFilename(const char *path);       // NOLINT(readability-identifier-naming) — private static; clang-tidy files statics as ClassMethod
-    static std::string _cleanFunctionName(const char *funcName); // NOLINT(readability-identifier-naming) — private static; clang-tidy files statics as ClassMethod
-    void               _writeToSinks(const LogEntry &entry);
+    template <typename F>
+    void               _push(LogLevel level, F &&fill); // Claims a slot (retry/drop policy above)
+    void               _drain();        // Moves queued records into the sinks (any thread)
+    void               _drainLocked();  // Same, with _sinkMutex already held
+    void               _sinkThread();
+    void               _updateThreshold(); // Call with _sinkMutex held
 
 public:
     /// @cond INTERNAL
@@ -166,3 +166,68 @@ std::string LogEntry::ToColoredString() const {
 
     return oss.str();
 }
+
+std::string LogEntry::ExtractFilename(const char *path) {
+    std::string pathStr(path);
+
+    // Find last slash or backslash
+    size_t lastSlash = pathStr.find_last_of("/\\");
+    if (lastSlash != std::string::npos) {
+        return pathStr.substr(lastSlash + 1);
+    }
+
+    return pathStr;
+}
+
+std::string LogEntry::CleanFunctionName(const char *funcName) {
+    std::string func(funcName);
+
+    // GCC/Clang format: "returnType ClassName::methodName(params)"
+    // MSVC format: "ClassName::methodName"
+
+    // Remove template parameters: "Foo<T>::bar" -> "Foo::bar"
+    size_t templateStart = func.find('<');
+    while (templateStart != std::string::npos) {
+        size_t templateEnd = func.find('>', templateStart);
+        if (templateEnd != std::string::npos) {
+            func.erase(templateStart, templateEnd - templateStart + 1);
+            templateStart = func.find('<');
+        } else {
+            break;
+        }
+    }
+
+    // Find opening parenthesis to locate the end of function name
+    size_t parenPos = func.find('(');
+    if (parenPos == std::string::npos) {
+        // No parenthesis, return as-is
+        return func;
+    }
+
+    // Find the last :: before the parenthesis
+    size_t lastScope = func.rfind("::", parenPos);
+
+    if (lastScope != std::string::npos) {
+        // Found scope operator - extract "ClassName::methodName"
+        // Find the start of the class name (space or start of string)
+        size_t classStart = func.rfind(' ', lastScope);
+        if (classStart == std::string::npos) {
+            classStart = 0;
+        } else {
+            classStart++; // Skip the space
+        }
+
+        // Extract from class name to opening parenthesis
+        return func.substr(classStart, parenPos - classStart);
+    } else {
+        // No scope operator - it's a free function
+        // Find the function name (after last space before parenthesis)
+        size_t funcStart = func.rfind(' ', parenPos);
+        if (funcStart == std::string::npos) {
+            funcStart = 0;
+        } else {
+            funcStart++;
+        }
+        return func.substr(funcStart, parenPos - funcStart);
+    }
+}
@@ -36,5 +36,9 @@ struct LogEntry {
     // Default formats for ToString
     std::string ToString() const;
     std::string ToColoredString() const; // For terminal/console with ANSI colors
+
+    // Source-location cleanup, applied once per entry on the sink thread
+    static std::string ExtractFilename(const char *path);       // "/src/foo/bar.cpp" -> "bar.cpp"
+    static std::string CleanFunctionName(const char *funcName); // "void Foo<T>::bar(int)" -> "Foo::bar"
 };
 /// @endcond
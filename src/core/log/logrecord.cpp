@@ -0,0 +1,101 @@
+#include "core/log/logrecord.h"
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+std::string LogRecord::Text() const {
+    if (overflow) {
+        return *overflow;
+    }
+    if (encoded) {
+        return LogArgs::Format(std::string_view(format, formatLength), message, length);
+    }
+    return std::string(message, length);
+}
+
+std::string LogArgs::Format(std::string_view format, const char *data, size_t size) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+
+    const char *cursor = data;
+    const char *end    = data + size;
+    auto        read   = [&](void *out, size_t bytes) {
+        if (static_cast<size_t>(end - cursor) < bytes) {
+            return false;
+        }
+        std::memcpy(out, cursor, bytes);
+        cursor += bytes;
+        return true;
+    };
+
+    while (cursor < end) {
+        const auto tag = static_cast<Tag>(*cursor++);
+        bool       ok  = true;
+        switch (tag) {
+        case Tag::Int: {
+            int64_t v = 0;
+            ok        = read(&v, sizeof(v));
+            store.push_back(v);
+            break;
+        }
+        case Tag::UInt: {
+            uint64_t v = 0;
+            ok         = read(&v, sizeof(v));
+            store.push_back(v);
+            break;
+        }
+        case Tag::Float: {
+            float v = 0.0f;
+            ok      = read(&v, sizeof(v));
+            store.push_back(v);
+            break;
+        }
+        case Tag::Double: {
+            double v = 0.0;
+            ok       = read(&v, sizeof(v));
+            store.push_back(v);
+            break;
+        }
+        case Tag::Bool: {
+            uint8_t v = 0;
+            ok        = read(&v, 1);
+            store.push_back(v != 0);
+            break;
+        }
+        case Tag::Char: {
+            char v = 0;
+            ok     = read(&v, 1);
+            store.push_back(v);
+            break;
+        }
+        case Tag::Pointer: {
+            uint64_t v = 0;
+            ok         = read(&v, sizeof(v));
+            store.push_back(reinterpret_cast<const void *>(static_cast<uintptr_t>(v)));
+            break;
+        }
+        case Tag::String: {
+            uint32_t length = 0;
+            ok              = read(&length, sizeof(length)) && static_cast<size_t>(end - cursor) >= length;
+            if (ok) {
+                store.push_back(std::string(cursor, length));
+                cursor += length;
+            }
+            break;
+        }
+        default:
+            ok = false;
+            break;
+        }
+        if (!ok) {
+            return fmt::format("<corrupt log arguments> {}", format);
+        }
+    }
+
+    try {
+        return fmt::vformat(fmt::string_view(format.data(), format.size()), store);
+    } catch (const fmt::format_error &error) {
+        // Only reachable from the decoder with a mismatched binary log (the engine checks
+        // format strings at compile time)
+        return fmt::format("<{}> {}", error.what(), format);
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+// The raw form of a log call, as it travels from the calling thread to the sinks, plus the
+// compact argument encoding that lets a call skip formatting entirely.
+//
+// A record is in one of two forms:
+//   encoded    `format` + the arguments as tagged raw bytes (LogArgs::Encode). Nothing has been
+//              formatted yet; text sinks format on the sink thread, binary sinks store the bytes.
+//   formatted  `message` holds the finished text (arguments LogArgs can't encode, Error/Critical).
+//
+// Encoding (all host byte order):   arg := u8 tag, payload
+//   Int i64 | UInt u64 | Float f32 | Double f64 | Bool u8 | Char u8 | Pointer u64 | String u32 len, bytes
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <fmt/core.h>
+
+#include "core/log/logentry.h"
+
+/// @cond INTERNAL
+/// @brief A log call as captured on the calling thread. Turned into a LogEntry on the sink thread
+/// (or written as-is by binary sinks).
+struct LogRecord {
+    static constexpr size_t MESSAGE_CAPACITY = 424; ///< Formatted text longer than this spills to `overflow`
+
+    std::chrono::system_clock::time_point timestamp;
+    const char                           *file     = nullptr; ///< __FILE__ (static storage)
+    const char                           *function = nullptr; ///< Raw CURRENT_METHOD() (static storage)
+    const char                           *format   = nullptr; ///< Format string literal (static storage)
+    uint32_t                              formatLength = 0;
+    std::string                          *overflow = nullptr; ///< Heap copy when the message didn't fit
+    int                                   line     = 0;
+    uint32_t                              length   = 0;     ///< Bytes used in `message`
+    LogLevel                              level    = LogLevel::Debug;
+    bool                                  isUserFacing = false;
+    bool                                  encoded  = false; ///< `message` holds LogArgs bytes, not text
+    char                                  message[MESSAGE_CAPACITY];
+
+    /// @brief The finished message text (formats encoded records).
+    std::string Text() const;
+};
+
+namespace LogArgs {
+
+enum class Tag : uint8_t { Int, UInt, Float, Double, Bool, Char, Pointer, String };
+
+/// True for argument types that can be stored raw and formatted later with identical output.
+template <typename T>
+inline constexpr bool IsEncodable = (std::is_integral_v<T>) || std::is_same_v<T, float> || std::is_same_v<T, double>
+    || std::is_same_v<T, const char *> || std::is_same_v<T, char *> || std::is_same_v<T, std::string>
+    || std::is_same_v<T, std::string_view> || std::is_same_v<T, const void *> || std::is_same_v<T, void *>;
+
+/// @cond INTERNAL
+inline bool Put(char *&dst, char *end, Tag tag, const void *payload, size_t size) {
+    if (static_cast<size_t>(end - dst) < 1 + size)
+        return false;
+    *dst++ = static_cast<char>(tag);
+    std::memcpy(dst, payload, size);
+    dst += size;
+    return true;
+}
+
+inline bool PutString(char *&dst, char *end, const char *text, size_t length) {
+    if (static_cast<size_t>(end - dst) < 1 + sizeof(uint32_t) + length)
+        return false;
+    const auto size = static_cast<uint32_t>(length);
+    *dst++          = static_cast<char>(Tag::String);
+    std::memcpy(dst, &size, sizeof(size));
+    std::memcpy(dst + sizeof(size), text, length);
+    dst += sizeof(size) + length;
+    return true;
+}
+
+template <typename T>
+bool EncodeOne(char *&dst, char *end, const T &value) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        const uint8_t v = value ? 1 : 0;
+        return Put(dst, end, Tag::Bool, &v, 1);
+    } else if constexpr (std::is_same_v<U, char>) {
+        return Put(dst, end, Tag::Char, &value, 1);
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+        const int64_t v = value;
+        return Put(dst, end, Tag::Int, &v, sizeof(v));
+    } else if constexpr (std::is_integral_v<U>) {
+        const uint64_t v = value;
+        return Put(dst, end, Tag::UInt, &v, sizeof(v));
+    } else if constexpr (std::is_same_v<U, float>) {
+        return Put(dst, end, Tag::Float, &value, sizeof(value));
+    } else if constexpr (std::is_same_v<U, double>) {
+        return Put(dst, end, Tag::Double, &value, sizeof(value));
+    } else if constexpr (std::is_same_v<U, const void *> || std::is_same_v<U, void *>) {
+        const auto v = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+        return Put(dst, end, Tag::Pointer, &v, sizeof(v));
+    } else if constexpr (std::is_array_v<T>) { // string literal: never null
+        return PutString(dst, end, value, std::strlen(value));
+    } else if constexpr (std::is_same_v<U, const char *> || std::is_same_v<U, char *>) {
+        return value ? PutString(dst, end, value, std::strlen(value)) : false;
+    } else {
+        return PutString(dst, end, value.data(), value.size()); // std::string / std::string_view
+    }
+}
+/// @endcond
+
+/**
+ * @brief Encodes every argument into dst.
+ * @return Bytes written, or -1 if they don't fit in capacity (format the call instead).
+ */
+template <typename... Args>
+int Encode(char *dst, size_t capacity, const Args &...args) {
+    char *cursor = dst;
+    [[maybe_unused]] char *end = dst + capacity; // unused when Args is empty
+    if (!(EncodeOne(cursor, end, args) && ...))
+        return -1;
+    return static_cast<int>(cursor - dst);
+}
+
+/// @brief Formats encoded arguments with their format string (what fmt::format would have produced).
+std::string Format(std::string_view format, const char *data, size_t size);
+
+} // namespace LogArgs
+/// @endcond
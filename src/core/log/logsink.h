@@ -4,15 +4,28 @@
 // entries somewhere new; the built-in sinks live in core/log/sinks/.
 
 #include "core/log/logentry.h"
+#include "core/log/logrecord.h"
 
 /// @brief Base class for log output destinations.
 class LogSink {
 public:
     virtual ~LogSink() = default;
 
-    /// @brief Called for every entry that passes the logger's minimum level.
+    /// @brief Called for every entry that passes the logger's minimum level. Runs on the
+    /// logger's sink thread (or the logging thread for Error/Critical), never concurrently.
     virtual void Write(const LogEntry &entry) = 0;
 
+    /// @brief Lowest level this sink keeps. The logger skips formatting anything below the
+    /// minimum of all sinks, so report it honestly. Debug (everything) by default.
+    virtual LogLevel GetMinLevel() const { return LogLevel::Debug; }
+
     /// @brief Flushes any buffered output. No-op by default.
     virtual void Flush() { }
+
+    /// @brief True for sinks that store raw records (WriteRecord) instead of formatted entries.
+    /// Queued records go only to WriteRecord; Write still receives the logger's own notices.
+    virtual bool IsBinary() const { return false; }
+
+    /// @brief Called instead of Write for binary sinks, with the record as queued.
+    virtual void WriteRecord(const LogRecord &/*record*/) { }
 };
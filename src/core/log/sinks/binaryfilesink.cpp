@@ -0,0 +1,121 @@
+#include "core/log/sinks/binaryfilesink.h"
+
+#include <SDL3/SDL.h>
+#include <chrono>
+#include <cstring>
+
+namespace {
+int64_t toNanoseconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+} // namespace
+
+BinaryFileSink::BinaryFileSink(const std::string &filename, LogLevel minLevel)
+    : _filename(filename)
+    , _minLevel(minLevel)
+    , _file(nullptr) {
+    _file = std::fopen(_filename.c_str(), "wb");
+    if (!_file) {
+        SDL_Log("Failed to open binary log file: %s", _filename.c_str());
+        return;
+    }
+    _buffer.reserve(BUFFER_SIZE + 1024);
+    _put(MAGIC, sizeof(MAGIC));
+    _putValue(VERSION);
+}
+
+BinaryFileSink::~BinaryFileSink() {
+    if (_file) {
+        _writeBuffer();
+        std::fclose(_file);
+    }
+}
+
+void BinaryFileSink::WriteRecord(const LogRecord &record) {
+    if (!_file || record.level < _minLevel) {
+        return;
+    }
+
+    const uint32_t siteId = _internSite(record);
+
+    uint8_t flags = record.isUserFacing ? FLAG_USER_FACING : 0;
+    if (record.encoded) {
+        flags |= FLAG_ENCODED;
+    }
+
+    _putValue(Block::Record);
+    _putValue(siteId);
+    _putValue(static_cast<uint8_t>(record.level));
+    _putValue(flags);
+    _putValue(toNanoseconds(record.timestamp));
+    if (record.overflow) {
+        _putValue(static_cast<uint32_t>(record.overflow->size()));
+        _put(record.overflow->data(), record.overflow->size());
+    } else {
+        _putValue(record.length);
+        _put(record.message, record.length);
+    }
+
+    if (_buffer.size() >= BUFFER_SIZE) {
+        _writeBuffer();
+    }
+}
+
+void BinaryFileSink::Write(const LogEntry &entry) {
+    if (!_file || entry.level < _minLevel) {
+        return;
+    }
+
+    _putValue(Block::Entry);
+    _putValue(static_cast<uint8_t>(entry.level));
+    _putValue(static_cast<uint8_t>(entry.isUserFacing ? FLAG_USER_FACING : 0));
+    _putValue(toNanoseconds(entry.timestamp));
+    _putValue(static_cast<uint32_t>(entry.line));
+    _putString(entry.file);
+    _putString(entry.function);
+    _putString(entry.message);
+}
+
+void BinaryFileSink::Flush() {
+    if (_file) {
+        _writeBuffer();
+        std::fflush(_file);
+    }
+}
+
+uint32_t BinaryFileSink::_internSite(const LogRecord &record) {
+    const SiteKey key { record.file, record.format, record.line };
+    auto          it = _sites.find(key);
+    if (it != _sites.end()) {
+        return it->second;
+    }
+
+    // First record from this call site: write its strings once, cleaned up like text sinks show them
+    const auto id = static_cast<uint32_t>(_sites.size() + 1);
+    _sites.emplace(key, id);
+
+    _putValue(Block::Site);
+    _putValue(id);
+    _putValue(static_cast<uint32_t>(record.line));
+    _putString(LogEntry::ExtractFilename(record.file));
+    _putString(LogEntry::CleanFunctionName(record.function));
+    _putString(std::string(record.format, record.formatLength));
+    return id;
+}
+
+void BinaryFileSink::_put(const void *data, size_t size) {
+    const auto *bytes = static_cast<const char *>(data);
+    _buffer.insert(_buffer.end(), bytes, bytes + size);
+}
+
+void BinaryFileSink::_putString(const std::string &text) {
+    _putValue(static_cast<uint32_t>(text.size()));
+    _put(text.data(), text.size());
+}
+
+void BinaryFileSink::_writeBuffer() {
+    if (!_buffer.empty()) {
+        std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+        _buffer.clear();
+    }
+}
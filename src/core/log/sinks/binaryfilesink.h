@@ -0,0 +1,81 @@
+#pragma once
+
+// Writes log records to a compact binary file instead of text, nanolog-style: each call site's
+// file/function/format string is written once and referred to by ID afterwards, and encoded
+// arguments are stored as their raw bytes — nothing is formatted at log time. Meant for soak
+// tests and per-frame diagnostics; read the file back with tools/log_decoder.
+//
+// File layout (host byte order; the decoder assumes a same-endian machine):
+//   header  "LUMILOG\0", u32 version
+//   block   u8 kind, then
+//     Site   (1)  u32 id, u32 line, str file, str function, str format
+//     Record (2)  u32 siteId, u8 level, u8 flags, i64 timestamp (ns since epoch), u32 size, size bytes
+//                 flags: bit 0 user-facing, bit 1 bytes are LogArgs-encoded (else finished text)
+//     Entry  (3)  u8 level, u8 flags, i64 timestamp, u32 line, str file, str function, str message
+//                 (entries that didn't come through the queue, e.g. the logger's own notices)
+//   str := u32 length, bytes
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/log/logsink.h"
+
+/// @brief Log sink that writes raw, un-formatted records to a binary file.
+class BinaryFileSink : public LogSink {
+public:
+    static constexpr char     MAGIC[8] = { 'L', 'U', 'M', 'I', 'L', 'O', 'G', '\0' };
+    static constexpr uint32_t VERSION  = 1;
+
+    enum class Block : uint8_t { Site = 1, Record = 2, Entry = 3 };
+
+    static constexpr uint8_t FLAG_USER_FACING = 1 << 0;
+    static constexpr uint8_t FLAG_ENCODED     = 1 << 1;
+
+    explicit BinaryFileSink(const std::string &filename, LogLevel minLevel = LogLevel::Debug);
+    ~BinaryFileSink() override;
+
+    void     Write(const LogEntry &entry) override;
+    void     WriteRecord(const LogRecord &record) override;
+    void     Flush() override;
+    bool     IsBinary() const override { return true; }
+    LogLevel GetMinLevel() const override { return _minLevel; }
+
+private:
+    /// Pending bytes are written out once they reach this size (or on Flush).
+    static constexpr size_t BUFFER_SIZE = 256 * 1024;
+
+    struct SiteKey {
+        const char *file;
+        const char *format;
+        int         line;
+
+        bool operator==(const SiteKey &other) const {
+            return file == other.file && format == other.format && line == other.line;
+        }
+    };
+
+    struct SiteKeyHash {
+        size_t operator()(const SiteKey &key) const {
+            size_t h = std::hash<const void *>()(key.file);
+            h ^= std::hash<const void *>()(key.format) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            return h ^ (static_cast<size_t>(key.line) * 0x9e3779b97f4a7c15ull);
+        }
+    };
+
+    uint32_t _internSite(const LogRecord &record);
+    void     _put(const void *data, size_t size);
+    void     _putString(const std::string &text);
+    void     _writeBuffer();
+
+    template <typename T>
+    void _putValue(const T &value) { _put(&value, sizeof(T)); }
+
+    std::string                                        _filename;
+    LogLevel                                           _minLevel;
+    FILE                                              *_file;
+    std::vector<char>                                  _buffer;
+    std::unordered_map<SiteKey, uint32_t, SiteKeyHash> _sites;
+};
@@ -10,11 +10,14 @@ FileSink::FileSink(const std::string &filename, LogLevel minLevel)
     _file = std::fopen(_filename.c_str(), "a");
     if (!_file) {
         SDL_Log("Failed to open log file: %s", _filename.c_str());
+        return;
     }
+    _buffer.reserve(BUFFER_SIZE + 512);
 }
 
 FileSink::~FileSink() {
     if (_file) {
+        _writeBuffer();
         std::fclose(_file);
     }
 }
@@ -24,11 +27,23 @@ void FileSink::Write(const LogEntry &entry) {
         return;
     }
 
-    std::fprintf(_file, "%s\n", entry.ToString().c_str());
+    _buffer += entry.ToString();
+    _buffer += '\n';
+    if (_buffer.size() >= BUFFER_SIZE) {
+        _writeBuffer();
+    }
 }
 
 void FileSink::Flush() {
     if (_file) {
+        _writeBuffer();
         std::fflush(_file);
     }
 }
+
+void FileSink::_writeBuffer() {
+    if (!_buffer.empty()) {
+        std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+        _buffer.clear();
+    }
+}
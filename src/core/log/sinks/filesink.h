@@ -1,6 +1,7 @@
 #pragma once
 
-// Appends log entries to a file on disk.
+// Appends log entries to a file on disk. Lines are collected in memory and written in large
+// blocks; the logger flushes it periodically and before Error/Critical.
 
 #include <cstdio>
 #include <string>
@@ -13,11 +14,18 @@ public:
     explicit FileSink(const std::string &filename, LogLevel minLevel = LogLevel::Debug);
     ~FileSink() override;
 
-    void Write(const LogEntry &entry) override;
-    void Flush() override;
+    void     Write(const LogEntry &entry) override;
+    void     Flush() override;
+    LogLevel GetMinLevel() const override { return _minLevel; }
 
 private:
+    /// Pending text is written out once it reaches this size (or on Flush).
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    void _writeBuffer();
+
     std::string _filename;
     LogLevel    _minLevel;
     FILE       *_file;
+    std::string _buffer;
 };
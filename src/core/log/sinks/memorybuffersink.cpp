@@ -1,11 +1,16 @@
 #include "core/log/sinks/memorybuffersink.h"
 
-MemoryBufferSink::MemoryBufferSink(size_t maxEntries)
-    : _maxEntries(maxEntries) {
+MemoryBufferSink::MemoryBufferSink(size_t maxEntries, LogLevel minLevel)
+    : _maxEntries(maxEntries)
+    , _minLevel(minLevel) {
     _entries.reserve(maxEntries);
 }
 
 void MemoryBufferSink::Write(const LogEntry &entry) {
+    if (entry.level < _minLevel) {
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(_mutex);
 
     if (_entries.size() >= _maxEntries) {
@@ -12,9 +12,13 @@
 /// @brief Log sink that retains a bounded ring of recent entries in memory.
 class MemoryBufferSink : public LogSink {
 public:
-    explicit MemoryBufferSink(size_t maxEntries = 1000);
+    explicit MemoryBufferSink(size_t maxEntries = 1000, LogLevel minLevel = LogLevel::Debug);
 
-    void Write(const LogEntry &entry) override;
+    void     Write(const LogEntry &entry) override;
+    LogLevel GetMinLevel() const override { return _minLevel; }
+
+    /// @brief Stops retaining entries below this level.
+    void SetMinLevel(LogLevel level) { _minLevel = level; }
 
     /// @brief Returns retained entries at or above the given level.
     std::vector<LogEntry> GetEntries(LogLevel minLevel = LogLevel::Debug) const;
@@ -26,5 +30,6 @@ public:
 private:
     std::vector<LogEntry> _entries;
     size_t                _maxEntries;
+    LogLevel              _minLevel;
     mutable std::mutex    _mutex;
 };
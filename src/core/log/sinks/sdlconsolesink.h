@@ -11,6 +11,8 @@ public:
 
     void Write(const LogEntry &entry) override;
 
+    LogLevel GetMinLevel() const override { return _minLevel; }
+
     /// @brief Drops entries below this level.
     void SetMinLevel(LogLevel level) { _minLevel = level; }
 
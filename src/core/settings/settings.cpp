@@ -35,6 +35,22 @@ int Settings::_getMonitorRefreshRate() const {
     return (int)currentDisplayMode->refresh_rate;
 }
 
+void Settings::_setThreadBudget(unsigned int threads) {
+    Platform::SetThreadBudget(threads);
+}
+
+unsigned int Settings::_getThreadBudget() const {
+    return Platform::ThreadBudget();
+}
+
+void Settings::_setThreadAffinity(ThreadAffinity affinity) {
+    Platform::SetThreadAffinity(affinity);
+}
+
+void Settings::_setThreadPriority(ThreadRole role, ThreadPriority priority) {
+    Platform::SetThreadPriority(role, priority);
+}
+
 void Settings::_saveSettings() const {
     //	const mINI::INIFile file("settings.ini");
     //	mINI::INIStructure ini;
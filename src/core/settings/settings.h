@@ -43,6 +43,18 @@ public:
     /// @brief Returns the monitor's refresh rate in Hz.
     static int GetMonitorRefreshRate() { return Get()._getMonitorRefreshRate(); }
 
+    // Threading. The engine's worker pools are created on first use (during Window init), with
+    // the values set at that point; set these before opening the window.
+
+    /// @brief Caps the threads the engine's worker pools use; 0 (default) sizes them from the CPU.
+    static void SetThreadBudget(unsigned int threads) { Get()._setThreadBudget(threads); }
+    /// @brief Returns the thread budget in effect (set, or detected: Platform::ThreadBudget).
+    static unsigned int GetThreadBudget() { return Get()._getThreadBudget(); }
+    /// @brief Sets where worker threads may run (default ThreadAffinity::None).
+    static void SetThreadAffinity(ThreadAffinity affinity) { Get()._setThreadAffinity(affinity); }
+    /// @brief Sets the priority of a role's worker threads (defaults: Frame Normal, Background Low).
+    static void SetThreadPriority(ThreadRole role, ThreadPriority priority) { Get()._setThreadPriority(role, priority); }
+
 private:
     bool _vsync      = true;
     bool _fullscreen = false;
@@ -72,6 +84,11 @@ private:
 
     int _getMonitorRefreshRate() const;
 
+    void         _setThreadBudget(unsigned int threads);
+    unsigned int _getThreadBudget() const;
+    void         _setThreadAffinity(ThreadAffinity affinity);
+    void         _setThreadPriority(ThreadRole role, ThreadPriority priority);
+
 public:
     /// @cond INTERNAL
     Settings(const Settings &) = delete;
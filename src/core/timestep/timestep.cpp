@@ -0,0 +1,69 @@
+#include "core/timestep/timestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "profiler/profiler.h"
+
+void Timestep::_setTickRate(double ticksPerSecond) {
+    _tickRate  = std::max(ticksPerSecond, 0.0);
+    _tickDelta = _tickRate > 0.0 ? 1.0 / _tickRate : 0.0;
+
+    // Keep the fraction of a tick already accumulated so a rate change doesn't hitch
+    _accumulator = _alpha * _tickDelta;
+}
+
+int Timestep::_advance(double frameTime) {
+    _ticksThisFrame = 0;
+    if (_tickDelta <= 0.0) {
+        _alpha = 0.0f;
+        return 0;
+    }
+
+    _accumulator += std::max(frameTime, 0.0);
+
+    while (_accumulator >= _tickDelta && _ticksThisFrame < _maxTicksPerFrame) {
+        _accumulator -= _tickDelta;
+        _runTick();
+        ++_ticksThisFrame;
+    }
+
+    // Hit the cap: the simulation can't keep up, so drop the backlog instead of letting it grow
+    // (which would make the next frame slower still)
+    if (_accumulator >= _tickDelta) {
+        double keep = std::fmod(_accumulator, _tickDelta);
+        if (_tickDelta - keep < _tickDelta * 1e-6)
+            keep = 0.0; // rounding left (almost) a whole tick; it belongs to the dropped backlog
+        _droppedTime += _accumulator - keep;
+        _accumulator = keep;
+    }
+
+    _alpha = static_cast<float>(_accumulator / _tickDelta);
+    return _ticksThisFrame;
+}
+
+int Timestep::_step(int ticks) {
+    if (_tickDelta <= 0.0)
+        return 0;
+
+    for (int i = 0; i < ticks; ++i)
+        _runTick();
+    return std::max(ticks, 0);
+}
+
+void Timestep::_runTick() {
+    LUMI_ZONE("Timestep::Tick");
+    _inTick = true;
+    if (_callback)
+        _callback(_tickDelta);
+    _inTick = false;
+    ++_tickCount;
+}
+
+void Timestep::_reset() {
+    _accumulator    = 0.0;
+    _droppedTime    = 0.0;
+    _alpha          = 0.0f;
+    _tickCount      = 0;
+    _ticksThisFrame = 0;
+}
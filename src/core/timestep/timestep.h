@@ -0,0 +1,122 @@
+#pragma once
+
+// Fixed-rate simulation ticks. Window feeds each frame's real delta into an accumulator and runs
+// the tick callback once per whole tick interval, so gameplay and physics step by the same dt
+// regardless of frame rate (and replay identically). Whatever is left in the accumulator becomes
+// GetAlpha(): how far the frame sits between the last two ticks, for interpolating what's drawn.
+//
+// Spiral-of-death protection: at most MaxTicksPerFrame ticks run per frame; time beyond that is
+// dropped (counted in GetDroppedTime) rather than carried into the next frame.
+//
+// Nothing here touches the window or renderer. Step() runs ticks directly, so a simulation can be
+// driven, tested and benchmarked headless.
+
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief Fixed-timestep accumulator and tick dispatcher.
+ */
+class Timestep {
+public:
+    /// @brief Callback run once per tick with the fixed tick delta in seconds.
+    using TickCallback = std::function<void(double dt)>;
+
+    /**
+     * @brief Sets the simulation rate. 0 disables fixed ticks (the callback never runs).
+     *
+     * @param ticksPerSecond Tick rate in Hz; the default is 60.
+     */
+    static void SetTickRate(double ticksPerSecond) { Get()._setTickRate(ticksPerSecond); }
+
+    /// @brief Current tick rate in Hz (0 = fixed ticks disabled).
+    static double GetTickRate() { return Get()._tickRate; }
+
+    /// @brief Seconds per tick (the dt passed to the callback), or 0 when disabled.
+    static double GetTickDelta() { return Get()._tickDelta; }
+
+    /// @brief Caps ticks per frame; time beyond the cap is dropped. Default 8.
+    static void SetMaxTicksPerFrame(int maxTicks) { Get()._maxTicksPerFrame = maxTicks < 1 ? 1 : maxTicks; }
+
+    static int GetMaxTicksPerFrame() { return Get()._maxTicksPerFrame; }
+
+    /// @brief Sets the function run on every tick (replaces the previous one; nullptr clears it).
+    static void SetTickCallback(TickCallback callback) { Get()._callback = std::move(callback); }
+
+    /**
+     * @brief Adds a frame's elapsed time and runs the ticks that are now due. Window calls this
+     * once per frame, after input has been handled.
+     *
+     * @param frameTime Real time since the previous frame, in seconds.
+     * @return Number of ticks run.
+     */
+    static int Advance(double frameTime) { return Get()._advance(frameTime); }
+
+    /**
+     * @brief Runs `ticks` ticks immediately, independent of the clock and the per-frame cap.
+     *
+     * For headless simulation, tests and benchmarks. Leaves the accumulator (and GetAlpha) alone.
+     *
+     * @return Number of ticks run (0 when fixed ticks are disabled).
+     */
+    static int Step(int ticks = 1) { return Get()._step(ticks); }
+
+    /// @brief Fraction of a tick accumulated since the last tick, in [0, 1).
+    static float GetAlpha() { return Get()._alpha; }
+
+    /**
+     * @brief Blends the previous and current tick's state by GetAlpha().
+     *
+     * @return previous + (current - previous) * alpha.
+     */
+    template <typename T>
+    static T Interpolate(const T &previous, const T &current) {
+        return previous + (current - previous) * Get()._alpha;
+    }
+
+    /// @brief Ticks run since start (or the last Reset).
+    static uint64_t GetTickCount() { return Get()._tickCount; }
+
+    /// @brief Ticks run by the most recent Advance().
+    static int GetTicksThisFrame() { return Get()._ticksThisFrame; }
+
+    /// @brief Total seconds discarded by the per-frame tick cap.
+    static double GetDroppedTime() { return Get()._droppedTime; }
+
+    /// @brief True while the tick callback is running.
+    static bool InTick() { return Get()._inTick; }
+
+    /// @brief Clears the accumulator and counters (e.g. after loading a level).
+    static void Reset() { Get()._reset(); }
+
+private:
+    void _setTickRate(double ticksPerSecond);
+    int  _advance(double frameTime);
+    int  _step(int ticks);
+    void _runTick();
+    void _reset();
+
+    TickCallback _callback;
+    double       _tickRate         = 60.0;
+    double       _tickDelta        = 1.0 / 60.0;
+    double       _accumulator      = 0.0;
+    double       _droppedTime      = 0.0;
+    float        _alpha            = 0.0f;
+    uint64_t     _tickCount        = 0;
+    int          _ticksThisFrame   = 0;
+    int          _maxTicksPerFrame = 8;
+    bool         _inTick           = false;
+
+public:
+    /// @cond INTERNAL
+    Timestep(const Timestep &) = delete;
+
+    static Timestep &Get() {
+        static Timestep instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    Timestep() { }
+};
@@ -1,6 +1,7 @@
 #include "draw.h"
 #include "draw/particles.h"
 #include "gpu/IGpu.h"
+#include "gpu/memory/gpumemory.h"
 #include "SDL3/SDL.h"
 
 #include <utility>
@@ -70,7 +71,8 @@ void Draw::_initPixelBuffer() {
 
     _pixelBufferData.resize(_pixelBufferWidth * _pixelBufferHeight, 0x00000000);
 
-    uint32_t sz          = static_cast<uint32_t>(_pixelBufferWidth * _pixelBufferHeight * sizeof(uint32_t));
+    GpuMemoryScope memScope(GpuMemoryCategory::Textures, "Draw pixel buffer");
+    uint32_t       sz    = static_cast<uint32_t>(_pixelBufferWidth * _pixelBufferHeight * sizeof(uint32_t));
     _pixelTransferBuffer = Renderer::GetGpu().CreateTransferBuffer({ sz, GpuTransferUsage::Upload });
     if (!_pixelTransferBuffer) {
         LOG_ERROR("failed to create pixel transfer buffer");
@@ -83,7 +85,8 @@ void Draw::_flushPixels() {
     if (!_pixelTransferBuffer)
         return;
 
-    IGpu &gpu = Renderer::GetGpu();
+    IGpu          &gpu = Renderer::GetGpu();
+    GpuMemoryScope memScope(GpuMemoryCategory::Textures, "Draw pixel buffer");
 
     GpuTextureHandle gpuTex = gpu.CreateTexture({ _pixelBufferWidth, _pixelBufferHeight, 1, 1,
         GpuTextureFormat::R8G8B8A8_Unorm,
@@ -1,5 +1,6 @@
 #include "particles.h"
 #include "gpu/IGpu.h"
+#include "gpu/memory/gpumemory.h"
 #include "gpu/presets.h"
 
 #include <cstring>
@@ -365,7 +366,8 @@ static bool importPreset(const char *encoded, ParticleSystemConfig &cfg) {
 // state (s_*) directly. Free helpers b64Dec/importPreset above stay file-local.
 
 void Particles::_init() {
-    IGpu &gpu = Renderer::GetGpu();
+    IGpu          &gpu = Renderer::GetGpu();
+    GpuMemoryScope memScope(GpuMemoryCategory::Particles, "Particles");
 
     // Particle buffer: compute RW + vertex read
     _particleBuf = gpu.CreateBuffer({ static_cast<uint32_t>(MAX_PARTICLES * sizeof(GPUParticle)),
@@ -636,6 +638,7 @@ ParticleSystemHandle Particles::_createSystem(const ParticleSystemConfig &cfg) {
         }
 
         IGpu                   &gpu      = Renderer::GetGpu();
+        GpuMemoryScope          memScope(GpuMemoryCategory::Particles, "Particles");
         uint32_t                uploadSz = static_cast<uint32_t>(n * sizeof(GPUParticle));
         GpuTransferBufferHandle ptb      = gpu.CreateTransferBuffer({ uploadSz, GpuTransferUsage::Upload });
         void                   *pmapped  = gpu.MapTransferBuffer(ptb, false);
@@ -1321,6 +1324,7 @@ bool ParticleRenderPass::Init(GpuTextureFormat swapchainFormat,
     }
 
     // ── POV textures (ping-pong) ───────────────────────────────────────────────
+    GpuMemoryScope       memScope(GpuMemoryCategory::Particles, "Particles POV");
     GpuTextureCreateInfo povTexInfo {};
     povTexInfo.width  = width;
     povTexInfo.height = height;
@@ -1,5 +1,6 @@
 #include "text.h"
 #include "draw/draw.h"
+#include "assets/font/glyphatlas.h"
 #include <algorithm>
 
 // Helper function to decode UTF-8 character
@@ -30,6 +31,33 @@ static uint32_t decodeUTF8(const std::string &str, size_t &pos) {
     return codepoint;
 }
 
+static const CachedGlyph *bakedGlyph(Font font, uint32_t codepoint) {
+    if (!font.glyphMap)
+        return nullptr;
+    auto it = font.glyphMap->find(codepoint);
+    return it == font.glyphMap->end() ? nullptr : &(*font.glyphs)[it->second];
+}
+
+// Baked atlas first, then the font's dynamic atlas. A glyph still being rasterized stands in as
+// U+FFFD (or '?') for the frame or two it takes; one the font doesn't have is skipped.
+static const CachedGlyph *findGlyph(Font font, uint32_t codepoint) {
+    if (const CachedGlyph *glyph = bakedGlyph(font, codepoint))
+        return glyph;
+    if (!font.atlas)
+        return nullptr;
+    if (const CachedGlyph *glyph = font.atlas->Find(codepoint))
+        return glyph;
+    if (!font.atlas->IsPending(codepoint))
+        return nullptr;
+    for (uint32_t fallback : { 0xFFFDu, static_cast<uint32_t>('?') }) {
+        if (const CachedGlyph *glyph = bakedGlyph(font, fallback))
+            return glyph;
+        if (const CachedGlyph *glyph = font.atlas->Find(fallback))
+            return glyph;
+    }
+    return nullptr;
+}
+
 void Text::_drawText(Font font, const vf2d &pos, const std::string &textToDraw, Color color, float renderSize) {
     Draw::FlushPixels(); // Preserve layering order with pixel draws
 
@@ -67,14 +95,31 @@ void Text::_drawText(Font font, const vf2d &pos, const std::string &textToDraw,
         uint32_t codepoint = decodeUTF8(textToDraw, i);
 
         // Look up glyph
-        auto it = font.glyphMap->find(codepoint);
-        if (it == font.glyphMap->end())
+        const CachedGlyph *found = findGlyph(font, codepoint);
+        if (!found)
             continue;
 
-        const CachedGlyph &glyph = (*font.glyphs)[it->second];
+        const CachedGlyph &glyph = *found;
 
         double advance = glyph.advance;
 
+        // Whitespace only advances the cursor
+        if (glyph.ar <= glyph.al) {
+            cursorX += static_cast<float>(advance * font.generatedSize);
+            continue;
+        }
+
+        // Page 0 is the baked atlas; the rest belong to the dynamic one
+        GpuTextureHandle atlasTexture = font.atlasTexture;
+        double           atlasWidth   = font.atlasWidth;
+        double           atlasHeight  = font.atlasHeight;
+        if (glyph.page != 0) {
+            const GlyphAtlas::Page &page = font.atlas->Pages()[glyph.page - font.atlas->FirstPage()];
+            atlasTexture                 = page.texture;
+            atlasWidth                   = page.width;
+            atlasHeight                  = page.height;
+        }
+
         // Plane bounds (em-square coordinates)
         double pl = glyph.pl, pb = glyph.pb, pr = glyph.pr, pt = glyph.pt;
 
@@ -94,7 +139,7 @@ void Text::_drawText(Font font, const vf2d &pos, const std::string &textToDraw,
         // Create renderable quad
         Renderable ren = {
             .texture = {
-                .gpuTexture = font.atlasTexture,
+                .gpuTexture = atlasTexture,
                 .gpuSampler = Renderer::GetSampler(ScaleMode::Linear),
             },
             .geometry = Renderer::GetQuadGeometry(),
@@ -105,10 +150,10 @@ void Text::_drawText(Font font, const vf2d &pos, const std::string &textToDraw,
 
             .rotation = 0.f,
 
-            .texU = static_cast<float>(al / font.atlasWidth),
-            .texV = static_cast<float>(1.0f - (at / font.atlasHeight)),
-            .texW = static_cast<float>((ar - al) / font.atlasWidth),
-            .texH = static_cast<float>((at - ab) / font.atlasHeight),
+            .texU = static_cast<float>(al / atlasWidth),
+            .texV = static_cast<float>(1.0f - (at / atlasHeight)),
+            .texW = static_cast<float>((ar - al) / atlasWidth),
+            .texH = static_cast<float>((at - ab) / atlasHeight),
 
             .r = color.r / 255.f,
             .g = color.g / 255.f,
@@ -154,14 +199,12 @@ vf2d Text::_getRenderedTextSize(Font font, const std::string &textToDraw, float
     for (size_t i = 0; i < textToDraw.length();) {
         uint32_t codepoint = decodeUTF8(textToDraw, i);
 
-        auto it = font.glyphMap->find(codepoint);
-        if (it == font.glyphMap->end())
+        const CachedGlyph *glyph = findGlyph(font, codepoint);
+        if (!glyph)
             continue;
 
-        const CachedGlyph &glyph = (*font.glyphs)[it->second];
-
-        double advance = glyph.advance;
-        double pr      = glyph.pr;
+        double advance = glyph->advance;
+        double pr      = glyph->pr;
 
         pr *= font.generatedSize;
         advance *= font.generatedSize;
@@ -192,6 +235,16 @@ TextureAsset Text::_drawTextToTexture(Font font, std::string textToDraw, Color c
     return tex;
 }
 
+void Text::_prefetchGlyphs(Font font, const std::string &text) {
+    if (!font.atlas)
+        return;
+    for (size_t i = 0; i < text.length();) {
+        uint32_t codepoint = decodeUTF8(text, i);
+        if (!bakedGlyph(font, codepoint))
+            font.atlas->Request(codepoint);
+    }
+}
+
 void Text::_drawWrappedText(Font font, vf2d pos, std::string textToDraw, float maxWidth, Color color, float renderSize) {
     if (textToDraw.empty() || maxWidth <= 0)
         return;
@@ -93,6 +93,20 @@ public:
         return Get()._drawTextToTexture(font, textToDraw, color);
     }
 
+    /**
+     * @brief Queues the glyphs of a string for rasterization ahead of drawing it.
+     *
+     * Glyphs outside a font's baked atlas are generated on worker threads the first time they're
+     * drawn and show a placeholder until they're ready; prefetching (e.g. while a dialogue loads)
+     * avoids that.
+     *
+     * @param font The font the text will be drawn with.
+     * @param text The text (UTF-8) whose glyphs to prepare.
+     */
+    static void PrefetchGlyphs(Font font, const std::string &text) {
+        Get()._prefetchGlyphs(font, text);
+    }
+
 private:
     void _drawText(Font font, const vf2d &pos, const std::string &textToDraw, Color color, float renderSize = -1.0f);
 
@@ -104,6 +118,8 @@ private:
 
     TextureAsset _drawTextToTexture(Font font, std::string textToDraw, Color color);
 
+    void _prefetchGlyphs(Font font, const std::string &text);
+
 public:
     /// @cond INTERNAL
     Text(const Text &) = delete;
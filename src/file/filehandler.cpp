@@ -414,6 +414,26 @@ size_t FileHandler::_getFileSize(const std::string &filepath) {
     return 0;
 }
 
+FileStamp FileHandler::_getFileStamp(const std::string &filename) {
+    if (std::filesystem::path(filename).is_absolute())
+        return FileStamp::Of(filename);
+#ifdef __ANDROID__
+    return {}; // APK assets: nothing on disk to stamp
+#else
+    _ensurePhysFS();
+    const char *realDir = PHYSFS_isInit() ? PHYSFS_getRealDir(filename.c_str()) : nullptr;
+    if (!realDir)
+        return {};
+
+    // A loose file under a mounted directory, or else the archive that holds it
+    std::error_code       error;
+    std::filesystem::path loose = std::filesystem::path(realDir) / filename;
+    if (std::filesystem::is_regular_file(loose, error))
+        return FileStamp::Of(loose.string());
+    return FileStamp::Of(realDir);
+#endif
+}
+
 // ============================================================================
 // FILE DELETION
 // ============================================================================
@@ -6,6 +6,8 @@
 
 #include <SDL3/SDL.h>
 
+#include "util/hash.h"
+
 /// @cond INTERNAL
 struct PhysFSFileData {
     void                *data;
@@ -186,6 +188,17 @@ public:
      */
     static size_t GetFileSize(const std::string &filepath) { return Get()._getFileSize(filepath); }
 
+    /**
+     * @brief Stamps the file a PhysFS path (or absolute path) resolves to, for cache pre-checks.
+     *
+     * A file inside a mounted archive is stamped by the archive itself, so any change to the
+     * archive invalidates it. Invalid where there's no file on disk (Android APK assets).
+     *
+     * @param filename PhysFS-relative or absolute path
+     * @return The stamp, or an invalid one if the file can't be stamped
+     */
+    static FileStamp GetFileStamp(const std::string &filename) { return Get()._getFileStamp(filename); }
+
     // ========================================================================
     // FILE/DIRECTORY DELETION
     // ========================================================================
@@ -286,9 +299,10 @@ private:
     bool _writeFile(const std::string &filepath, const void *data, size_t size);
 
     // File queries
-    bool   _fileExists(const std::string &filepath);
-    bool   _directoryExists(const std::string &dirpath);
-    size_t _getFileSize(const std::string &filepath);
+    bool      _fileExists(const std::string &filepath);
+    bool      _directoryExists(const std::string &dirpath);
+    size_t    _getFileSize(const std::string &filepath);
+    FileStamp _getFileStamp(const std::string &filename);
 
     // File deletion
     bool _deleteFile(const std::string &filepath);
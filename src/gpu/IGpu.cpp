@@ -8,6 +8,26 @@
 #include <thread>
 #include <utility>
 
+void IGpu::_beginTimedScope(GpuCmdBufferHandle /*cmd*/, const char *name) {
+    _cpuScopeStack.push_back(_cpuScopes.size());
+    _cpuScopes.push_back({ name, 0.0, static_cast<uint32_t>(_cpuScopeStack.size() - 1) });
+    _cpuScopeStarts.push_back(std::chrono::steady_clock::now());
+}
+
+void IGpu::_endTimedScope(GpuCmdBufferHandle /*cmd*/) {
+    if (_cpuScopeStack.empty())
+        return;
+    const size_t index = _cpuScopeStack.back();
+    _cpuScopeStack.pop_back();
+    _cpuScopes[index].ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _cpuScopeStarts[index]).count();
+}
+
+void IGpu::_resolveTimedScopes(GpuCmdBufferHandle /*cmd*/) {
+    _cpuScopeStack.clear(); // a scope left open is dropped with its time at 0
+    _cpuScopeStarts.clear();
+    _publishScopeTimings(_cpuScopes);
+}
+
 void IGpu::RequestScreenshot(GpuCmdBufferHandle cmd,
     GpuTextureHandle                            src,
     uint32_t width, uint32_t height,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -21,6 +22,13 @@ struct GpuStorageBufferBinding {
     bool            cycle  = false;
 };
 
+// One timed scope of a finished frame (see IGpu::BeginTimedScope). Inclusive of nested scopes.
+struct GpuScopeTiming {
+    const char *name  = nullptr;
+    double      ms    = 0.0;
+    uint32_t    depth = 0; // nesting level, 0 = top
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 // IGpu — GPU backend interface.
 // Implemented by SdlGpuBackend, OpenGLGpuBackend, SoftwareGpuBackend, etc.
@@ -56,6 +64,38 @@ public:
     virtual uint64_t    FrameDrawVerts() const { return 0; }
     virtual void        ResetFrameDrawStats() { }
     virtual const char *BackendName() const { return "GPU"; }
+
+    // ── Pass timing ───────────────────────────────────────────────────────────
+    // The renderer brackets every render pass and compute group in a timed scope; passes can
+    // nest their own (Model3DRenderPass times its shadow maps). Scopes are only recorded while
+    // SetTimedScopesEnabled(true), and ResolveTimedScopes, encoded before the frame's submit,
+    // closes the frame. The default times the CPU between Begin and End: the real cost on the
+    // software backend, command encoding cost elsewhere. A backend with timestamp queries can
+    // override the hooks to time the GPU passes inside each scope instead, reading the results
+    // back a few frames later (HasGpuTimestamps tells which); none does yet.
+    //
+    // name must stay valid until the timings are read: a literal or a Profiler::Intern'ed string.
+    void BeginTimedScope(GpuCmdBufferHandle cmd, const char *name) {
+        if (_timedScopes)
+            _beginTimedScope(cmd, name);
+    }
+    void EndTimedScope(GpuCmdBufferHandle cmd) {
+        if (_timedScopes)
+            _endTimedScope(cmd);
+    }
+    void ResolveTimedScopes(GpuCmdBufferHandle cmd) {
+        if (_timedScopes)
+            _resolveTimedScopes(cmd);
+    }
+    void SetTimedScopesEnabled(bool enabled) { _timedScopes = enabled; }
+    bool TimedScopesEnabled() const { return _timedScopes; }
+
+    virtual bool HasGpuTimestamps() const { return false; }
+
+    // Latest complete frame of scope timings, in begin order; ScopeTimingsSerial bumps whenever
+    // a new frame lands.
+    const std::vector<GpuScopeTiming> &ScopeTimings() const { return _scopeTimings; }
+    uint64_t                           ScopeTimingsSerial() const { return _scopeTimingsSerial; }
     // Whether BC/BCn compressed textures can be created. Default true: backends that simply
     // null-return on an unsupported format (SDL/Metal) let the KTX2 loader fall back via that.
     // WebGPU overrides false when the device lacks texture-compression-bc, because there
@@ -324,6 +364,26 @@ public:
     void ProcessPendingScreenshots();
 
 protected:
+    virtual void _beginTimedScope(GpuCmdBufferHandle cmd, const char *name);
+    virtual void _endTimedScope(GpuCmdBufferHandle cmd);
+    virtual void _resolveTimedScopes(GpuCmdBufferHandle cmd);
+
+    // Publishes one finished frame of timings
+    void _publishScopeTimings(std::vector<GpuScopeTiming> &timings) {
+        _scopeTimings.swap(timings);
+        timings.clear();
+        ++_scopeTimingsSerial;
+    }
+
+    bool                        _timedScopes = false;
+    std::vector<GpuScopeTiming> _scopeTimings;
+    uint64_t                    _scopeTimingsSerial = 0;
+
+    // CPU-timed default: the frame being recorded and its open scopes
+    std::vector<GpuScopeTiming>                        _cpuScopes;
+    std::vector<std::chrono::steady_clock::time_point> _cpuScopeStarts;
+    std::vector<size_t>                                _cpuScopeStack;
+
     struct PendingScreenshot {
         std::string             filename;
         GpuTransferBufferHandle transferBuffer = 0;
@@ -334,3 +394,21 @@ protected:
     };
     std::vector<PendingScreenshot> _pendingScreenshots;
 };
+
+// Times its scope with IGpu::BeginTimedScope / EndTimedScope.
+class GpuTimedScope {
+public:
+    GpuTimedScope(IGpu &gpu, GpuCmdBufferHandle cmd, const char *name)
+        : _gpu(gpu)
+        , _cmd(cmd) {
+        _gpu.BeginTimedScope(_cmd, name);
+    }
+    ~GpuTimedScope() { _gpu.EndTimedScope(_cmd); }
+
+    GpuTimedScope(const GpuTimedScope &)            = delete;
+    GpuTimedScope &operator=(const GpuTimedScope &) = delete;
+
+private:
+    IGpu              &_gpu;
+    GpuCmdBufferHandle _cmd;
+};
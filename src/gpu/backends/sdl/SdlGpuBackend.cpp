@@ -1,77 +1,14 @@
 #include "gpu/backends/sdl/SdlGpuBackend.h"
 #include "gpu/backends/sdl/sdlgpu.h"
-#include "profiler/perf.h"
+#include "gpu/memory/gpumemory.h"
 #include "core/log/log.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3_shadercross/SDL_shadercross.h>
 #include <vector>
 #include <cstring>
-#include <unordered_map>
 
-// ── VRAM accounting (tracked allocations -> Perf HUD) ─────────────────────────
 namespace {
-std::unordered_map<void *, size_t> allocSizes;
-int64_t                            vramTotal = 0;
-
-// Bits per pixel for the formats we allocate (BC7 is 8bpp; uncompressed by channel size).
-int bppOf(GpuTextureFormat f) {
-    switch (f) {
-    case GpuTextureFormat::R8_Unorm:
-        return 8;
-    case GpuTextureFormat::R8G8_Unorm:
-    case GpuTextureFormat::R16_Float:
-    case GpuTextureFormat::D16_Unorm:
-        return 16;
-    case GpuTextureFormat::R8G8B8A8_Unorm:
-    case GpuTextureFormat::B8G8R8A8_Unorm:
-    case GpuTextureFormat::R8G8B8A8_Unorm_SRGB:
-    case GpuTextureFormat::B8G8R8A8_Unorm_SRGB:
-    case GpuTextureFormat::R16G16_Float:
-    case GpuTextureFormat::R32_Float:
-    case GpuTextureFormat::R10G10B10A2_Unorm:
-    case GpuTextureFormat::D32_Float:
-    case GpuTextureFormat::D24_Unorm:
-        return 32;
-    case GpuTextureFormat::R16G16B16A16_Float:
-    case GpuTextureFormat::R32G32_Float:
-    case GpuTextureFormat::D32_Float_S8_Uint:
-        return 64;
-    case GpuTextureFormat::R32G32B32A32_Float:
-        return 128;
-    case GpuTextureFormat::BC7_Unorm:
-    case GpuTextureFormat::ASTC_4x4_Unorm:
-    case GpuTextureFormat::B5G6R5_Unorm:
-        return 8;
-    default:
-        return 32;
-    }
-}
-size_t texBytes(const GpuTextureCreateInfo &i) {
-    uint32_t layers = i.depthOrLayers ? i.depthOrLayers : 1;
-    double   base   = (double)i.width * i.height * layers * bppOf(i.format) / 8.0;
-    if (i.numLevels > 1)
-        base *= 1.34; // approx mip chain
-    return (size_t)base;
-}
-void vramAdd(void *h, size_t bytes) {
-    if (!h || !bytes)
-        return;
-    allocSizes[h] = bytes;
-    vramTotal += (int64_t)bytes;
-    Perf::ReportVRAM(vramTotal);
-}
-void vramRemove(void *h) {
-    auto it = allocSizes.find(h);
-    if (it == allocSizes.end())
-        return;
-    vramTotal -= (int64_t)it->second;
-    allocSizes.erase(it);
-    if (vramTotal < 0)
-        vramTotal = 0;
-    Perf::ReportVRAM(vramTotal);
-}
-
 uint32_t drawCalls = 0;
 uint64_t drawVerts = 0;
 } // namespace
@@ -450,20 +387,22 @@ void SdlGpuBackend::SetViewport(GpuRenderPassHandle pass,
 GpuTextureHandle SdlGpuBackend::CreateTexture(const GpuTextureCreateInfo &info) {
     SDL_GPUTextureCreateInfo ci  = toSDL(info);
     auto                     tex = reinterpret_cast<GpuTextureHandle>(SDL_CreateGPUTexture(_device, &ci));
-    vramAdd((void *)tex, texBytes(info));
+    GpuMemory::TrackTexture(tex, info);
     return tex;
 }
 
 GpuBufferHandle SdlGpuBackend::CreateBuffer(const GpuBufferCreateInfo &info) {
     SDL_GPUBufferCreateInfo ci  = toSDL(info);
     auto                    buf = reinterpret_cast<GpuBufferHandle>(SDL_CreateGPUBuffer(_device, &ci));
-    vramAdd((void *)buf, info.size);
+    GpuMemory::TrackBuffer(buf, info);
     return buf;
 }
 
 GpuTransferBufferHandle SdlGpuBackend::CreateTransferBuffer(const GpuTransferBufferCreateInfo &info) {
     SDL_GPUTransferBufferCreateInfo ci = toSDL(info);
-    return reinterpret_cast<GpuTransferBufferHandle>(SDL_CreateGPUTransferBuffer(_device, &ci));
+    auto                            tb = reinterpret_cast<GpuTransferBufferHandle>(SDL_CreateGPUTransferBuffer(_device, &ci));
+    GpuMemory::TrackTransferBuffer(tb, info);
+    return tb;
 }
 
 GpuSamplerHandle SdlGpuBackend::CreateSampler(const GpuSamplerCreateInfo &info) {
@@ -682,21 +621,23 @@ GpuComputePipelineHandle SdlGpuBackend::CreateComputePipelineFromSPIRV(const uin
 
 void SdlGpuBackend::ReleaseTexture(GpuTextureHandle handle) {
     if (handle) {
-        vramRemove((void *)handle);
+        GpuMemory::Untrack(handle);
         SDL_ReleaseGPUTexture(_device, reinterpret_cast<SDL_GPUTexture *>(handle));
     }
 }
 
 void SdlGpuBackend::ReleaseBuffer(GpuBufferHandle handle) {
     if (handle) {
-        vramRemove((void *)handle);
+        GpuMemory::Untrack(handle);
         SDL_ReleaseGPUBuffer(_device, reinterpret_cast<SDL_GPUBuffer *>(handle));
     }
 }
 
 void SdlGpuBackend::ReleaseTransferBuffer(GpuTransferBufferHandle handle) {
-    if (handle)
+    if (handle) {
+        GpuMemory::Untrack(handle);
         SDL_ReleaseGPUTransferBuffer(_device, reinterpret_cast<SDL_GPUTransferBuffer *>(handle));
+    }
 }
 
 void SdlGpuBackend::ReleaseSampler(GpuSamplerHandle handle) {
@@ -1,6 +1,7 @@
 #include "WebGpuGpuBackend.h"
 #include "WebGpuHandles.h"
 #include "core/log/log.h"
+#include "gpu/memory/gpumemory.h"
 
 #include <cstring>
 #include <cstdlib>
@@ -1234,6 +1235,7 @@ GpuTextureHandle WebGpuGpuBackend::CreateTexture(const GpuTextureCreateInfo &inf
         }
     }
 
+    GpuMemory::TrackTexture(reinterpret_cast<GpuTextureHandle>(t), info);
     return reinterpret_cast<GpuTextureHandle>(t);
 }
 
@@ -1248,6 +1250,7 @@ GpuBufferHandle WebGpuGpuBackend::CreateBuffer(const GpuBufferCreateInfo &info)
     desc.usage = toWGPUUsage(info.usage) | WGPUBufferUsage_CopyDst | WGPUBufferUsage_CopySrc;
     b->buffer  = wgpuDeviceCreateBuffer(m_device, &desc);
 
+    GpuMemory::TrackBuffer(reinterpret_cast<GpuBufferHandle>(b), info);
     return reinterpret_cast<GpuBufferHandle>(b);
 }
 
@@ -1267,6 +1270,9 @@ GpuTransferBufferHandle WebGpuGpuBackend::CreateTransferBuffer(const GpuTransfer
         tb->stagingData.resize((info.size + 3u) & ~3u);
     }
 
+    // Upload staging lives in wasm/host memory here, but it is still per-resource memory the
+    // engine asked for, so it's counted like the SDL backend's transfer buffers
+    GpuMemory::TrackTransferBuffer(reinterpret_cast<GpuTransferBufferHandle>(tb), info);
     return reinterpret_cast<GpuTransferBufferHandle>(tb);
 }
 
@@ -1596,6 +1602,7 @@ GpuComputePipelineHandle WebGpuGpuBackend::CreateComputePipeline(const GpuComput
 void WebGpuGpuBackend::ReleaseTexture(GpuTextureHandle handle) {
     if (!handle)
         return;
+    GpuMemory::Untrack(handle);
     auto *t = reinterpret_cast<WgpuTexture *>(handle);
     if (t->defaultView)
         _evictSamplerBgsByView(t->defaultView);
@@ -1612,6 +1619,7 @@ void WebGpuGpuBackend::ReleaseTexture(GpuTextureHandle handle) {
 void WebGpuGpuBackend::ReleaseBuffer(GpuBufferHandle handle) {
     if (!handle)
         return;
+    GpuMemory::Untrack(handle);
     auto *b = reinterpret_cast<WgpuBuffer *>(handle);
     if (b->buffer)
         wgpuBufferRelease(b->buffer);
@@ -1621,6 +1629,7 @@ void WebGpuGpuBackend::ReleaseBuffer(GpuBufferHandle handle) {
 void WebGpuGpuBackend::ReleaseTransferBuffer(GpuTransferBufferHandle handle) {
     if (!handle)
         return;
+    GpuMemory::Untrack(handle);
     auto *tb = reinterpret_cast<WgpuTransferBuffer *>(handle);
     if (tb->downloadBuffer)
         wgpuBufferRelease(tb->downloadBuffer);
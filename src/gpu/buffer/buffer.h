@@ -10,6 +10,7 @@
 #include <type_traits>
 
 #include "core/log/log.h"
+#include "gpu/memory/gpumemory.h"
 
 enum class BufferType { CPU,
     GPU };
@@ -48,6 +49,7 @@ public:
         if (!_data) {
             LOG_CRITICAL("Buffer '{}': failed to allocate {} bytes", _name, allocSize);
         }
+        GpuMemory::Track(_memoryId(), GpuMemoryCategory::CpuStaging, GpuMemory::Intern(_name), allocSize);
 
         LOG_DEBUG("Buffer '{}': allocated {} entries ({:.1f} MB)",
             _name, capacity, static_cast<float>(allocSize) / (1024.0f * 1024.0f));
@@ -107,7 +109,9 @@ public:
     T       *Data() { return _data; }
     const T *Data() const { return _data; }
 
+    // Ends a fill: what it used is reported to GpuMemory (the rest of the capacity counts as wasted)
     void Reset() override {
+        GpuMemory::SetUsed(_memoryId(), _count * sizeof(T));
         if constexpr (!std::is_trivially_destructible_v<T>) {
             for (size_t i = 0; i < _count; i++) {
                 _data[i].~T();
@@ -135,6 +139,7 @@ public:
 
         _data  = nullptr;
         _count = 0;
+        GpuMemory::Untrack(_memoryId());
     }
 
     size_t             Count() const override { return _count; }
@@ -146,6 +151,8 @@ public:
     BufferType         Type() const override { return _type; }
 
 private:
+    uintptr_t _memoryId() const { return reinterpret_cast<uintptr_t>(this); }
+
     void _grow() {
         size_t newCapacity = _capacity * 2;
         LOG_WARNING("Buffer '{}': capacity exceeded ({} items), growing to {} — increase initial capacity to avoid this",
@@ -177,6 +184,9 @@ private:
 #endif
         _data     = newData;
         _capacity = newCapacity;
+
+        // Growth goes through the tracker so a CpuStaging budget callback sees it
+        GpuMemory::Track(_memoryId(), GpuMemoryCategory::CpuStaging, nullptr, newCapacity * sizeof(T));
     }
 
     T          *_data          = nullptr;
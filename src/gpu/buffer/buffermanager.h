@@ -83,6 +83,7 @@ public:
     }
 
 private:
-    BufferManager() = default;
+    // Constructed first so GpuMemory outlives the buffers that untrack themselves at exit
+    BufferManager() { GpuMemory::Get(); }
     ~BufferManager() { _destroyAll(); }
 };
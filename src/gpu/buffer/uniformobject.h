@@ -108,6 +108,12 @@ public:
         }
     }
 
+    /// Copies raw bytes to a reflected offset; a fused effect gathers each stage's block this way.
+    void Write(size_t offset, const void *data, size_t size) {
+        if (offset + size <= _buffer.size())
+            std::memcpy(&_buffer[offset], data, size);
+    }
+
     template <typename T>
     T GetVariable(const std::string &name) const {
         for (const auto &var : _variables) {
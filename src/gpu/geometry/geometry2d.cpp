@@ -1,6 +1,7 @@
 #include "gpu/geometry/geometry2d.h"
 #include "gpu/halffloat.h"
 #include "gpu/IGpu.h"
+#include "gpu/memory/gpumemory.h"
 #include "renderer/renderer.h"
 #include <cmath>
 #include <unordered_map>
@@ -17,7 +18,8 @@ CompactVertex2D CompactVertex2D::FromVertex(const Vertex2D &v) {
 }
 
 void Geometry2D::UploadToGPU() {
-    IGpu &gpu = Renderer::GetGpu();
+    IGpu          &gpu = Renderer::GetGpu();
+    GpuMemoryScope memScope(GpuMemoryCategory::Geometry, "Geometry2D");
 
     // Convert to compact format
     std::vector<CompactVertex2D> compactVertices;
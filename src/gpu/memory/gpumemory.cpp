@@ -0,0 +1,350 @@
+#include "gpu/memory/gpumemory.h"
+
+#include <algorithm>
+
+#include "core/log/log.h"
+
+namespace {
+thread_local const GpuMemoryScope *currentScope = nullptr;
+
+const char *const UNTAGGED = "untagged";
+
+// Bits per pixel for the formats we allocate (BC7 / ASTC 4x4 are 8bpp; uncompressed by channel size).
+int bppOf(GpuTextureFormat f) {
+    switch (f) {
+    case GpuTextureFormat::R8_Unorm:
+        return 8;
+    case GpuTextureFormat::R8G8_Unorm:
+    case GpuTextureFormat::R16_Float:
+    case GpuTextureFormat::D16_Unorm:
+    case GpuTextureFormat::B5G6R5_Unorm:
+        return 16;
+    case GpuTextureFormat::R8G8B8A8_Unorm:
+    case GpuTextureFormat::B8G8R8A8_Unorm:
+    case GpuTextureFormat::R8G8B8A8_Unorm_SRGB:
+    case GpuTextureFormat::B8G8R8A8_Unorm_SRGB:
+    case GpuTextureFormat::R16G16_Float:
+    case GpuTextureFormat::R32_Float:
+    case GpuTextureFormat::R10G10B10A2_Unorm:
+    case GpuTextureFormat::D32_Float:
+    case GpuTextureFormat::D24_Unorm:
+        return 32;
+    case GpuTextureFormat::R16G16B16A16_Float:
+    case GpuTextureFormat::R32G32_Float:
+    case GpuTextureFormat::D32_Float_S8_Uint:
+        return 64;
+    case GpuTextureFormat::R32G32B32A32_Float:
+        return 128;
+    case GpuTextureFormat::BC7_Unorm:
+    case GpuTextureFormat::ASTC_4x4_Unorm:
+        return 8;
+    default:
+        return 32;
+    }
+}
+
+bool isBlockCompressed(GpuTextureFormat f) {
+    return f == GpuTextureFormat::BC7_Unorm || f == GpuTextureFormat::ASTC_4x4_Unorm;
+}
+
+GpuMemoryCategory textureCategory(const GpuTextureCreateInfo &info) {
+    if ((info.usage & GpuTextureUsage::ColorTarget) || (info.usage & GpuTextureUsage::DepthStencilTarget))
+        return GpuMemoryCategory::RenderTargets;
+    return GpuMemoryCategory::Textures;
+}
+
+GpuMemoryCategory bufferCategory(const GpuBufferCreateInfo &info) {
+    if ((info.usage & GpuBufferUsage::Vertex) || (info.usage & GpuBufferUsage::Index))
+        return GpuMemoryCategory::Geometry;
+    if ((info.usage & GpuBufferUsage::StorageWrite) || (info.usage & GpuBufferUsage::Indirect))
+        return GpuMemoryCategory::Compute;
+    return GpuMemoryCategory::Other;
+}
+
+std::string formatBytes(uint64_t bytes) {
+    char buf[32];
+    if (bytes >= 1024ull * 1024)
+        std::snprintf(buf, sizeof(buf), "%.1f MB", bytes / (1024.0 * 1024.0));
+    else
+        std::snprintf(buf, sizeof(buf), "%.1f KB", bytes / 1024.0);
+    return buf;
+}
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Scopes
+// ─────────────────────────────────────────────────────────────────────────────
+
+GpuMemoryScope::GpuMemoryScope(GpuMemoryCategory category, const char *owner)
+    : _category(category)
+    , _owner(owner ? owner : UNTAGGED)
+    , _previous(currentScope) {
+    currentScope = this;
+}
+
+GpuMemoryScope::~GpuMemoryScope() {
+    currentScope = _previous;
+}
+
+const GpuMemoryScope *GpuMemoryScope::Current() {
+    return currentScope;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tracking
+// ─────────────────────────────────────────────────────────────────────────────
+
+void GpuMemory::TrackTexture(GpuTextureHandle texture, const GpuTextureCreateInfo &info) {
+    Get()._trackScoped(texture, textureCategory(info), TextureBytes(info));
+}
+
+void GpuMemory::TrackBuffer(GpuBufferHandle buffer, const GpuBufferCreateInfo &info) {
+    Get()._trackScoped(buffer, bufferCategory(info), info.size);
+}
+
+void GpuMemory::TrackTransferBuffer(GpuTransferBufferHandle buffer, const GpuTransferBufferCreateInfo &info) {
+    Get()._trackScoped(buffer, GpuMemoryCategory::Transfer, info.size);
+}
+
+void GpuMemory::_trackScoped(uintptr_t id, GpuMemoryCategory fallback, uint64_t bytes) {
+    if (const GpuMemoryScope *scope = GpuMemoryScope::Current())
+        _track(id, scope->Category(), scope->Owner(), bytes);
+    else
+        _track(id, fallback, UNTAGGED, bytes);
+}
+
+uint64_t GpuMemory::TextureBytes(const GpuTextureCreateInfo &info) {
+    const uint64_t layers = info.type == GpuTextureType::TexCube ? 6 : std::max(info.depthOrLayers, 1u);
+
+    const bool     blocks = isBlockCompressed(info.format);
+    const uint64_t bpp    = bppOf(info.format);
+
+    uint64_t total  = 0;
+    uint32_t width  = std::max(info.width, 1u);
+    uint32_t height = std::max(info.height, 1u);
+    for (uint32_t level = 0; level < std::max(info.numLevels, 1u); ++level) {
+        // Compressed levels are stored in whole 4x4 blocks, down to the last 1x1 mip
+        const uint64_t w = blocks ? (width + 3u) / 4u * 4u : width;
+        const uint64_t h = blocks ? (height + 3u) / 4u * 4u : height;
+        total += w * h * bpp / 8;
+        width  = std::max(width / 2u, 1u);
+        height = std::max(height / 2u, 1u);
+    }
+    return total * layers * std::max(static_cast<uint32_t>(info.sampleCount), 1u);
+}
+
+void GpuMemory::_track(uintptr_t id, GpuMemoryCategory category, const char *owner, uint64_t bytes) {
+    if (!id || category >= GpuMemoryCategory::Total)
+        return;
+
+    std::vector<GpuMemoryBudgetEvent> crossed;
+    {
+        std::lock_guard lock(_mutex);
+        auto [it, inserted] = _allocations.try_emplace(id, Allocation { category, owner ? owner : UNTAGGED, bytes, bytes });
+        Allocation &allocation = it->second;
+        if (inserted) {
+            _apply(allocation, static_cast<int64_t>(bytes), 0, 1);
+        } else {
+            // Resized in place (a grown buffer): keep the tags and the used bytes
+            const uint64_t used      = std::min(allocation.used, bytes);
+            const int64_t  oldWasted = static_cast<int64_t>(allocation.bytes - allocation.used);
+            const int64_t  newWasted = static_cast<int64_t>(bytes - used);
+            _apply(allocation, static_cast<int64_t>(bytes) - static_cast<int64_t>(allocation.bytes), newWasted - oldWasted, 0);
+            allocation.bytes = bytes;
+            allocation.used  = used;
+        }
+        _checkBudgets(allocation.category, crossed);
+        for (GpuMemoryBudgetEvent &event : crossed) {
+            event.owner = allocation.owner;
+            event.bytes = bytes;
+        }
+    }
+
+    for (const GpuMemoryBudgetEvent &event : crossed) {
+        BudgetCallback callback;
+        {
+            std::lock_guard lock(_mutex);
+            callback = _budgets[static_cast<size_t>(event.category)].callback;
+        }
+        if (callback) {
+            callback(event);
+        } else {
+            LOG_WARNING("GpuMemory: {} over budget ({} of {}) after {} allocated {}", CategoryName(event.category),
+                formatBytes(event.current), formatBytes(event.budget), event.owner, formatBytes(event.bytes));
+        }
+    }
+}
+
+void GpuMemory::_untrack(uintptr_t id) {
+    std::lock_guard lock(_mutex);
+    auto            it = _allocations.find(id);
+    if (it == _allocations.end())
+        return;
+
+    const Allocation &allocation = it->second;
+    _apply(allocation, -static_cast<int64_t>(allocation.bytes), -static_cast<int64_t>(allocation.bytes - allocation.used), -1);
+    const GpuMemoryCategory category = allocation.category;
+    _allocations.erase(it);
+
+    // Back under budget: the next crossing reports again
+    for (GpuMemoryCategory c : { category, GpuMemoryCategory::Total }) {
+        Budget &budget = _budgets[static_cast<size_t>(c)];
+        if (budget.over && _categories[static_cast<size_t>(c)].current <= budget.bytes)
+            budget.over = false;
+    }
+}
+
+void GpuMemory::_setUsed(uintptr_t id, uint64_t usedBytes) {
+    std::lock_guard lock(_mutex);
+    auto            it = _allocations.find(id);
+    if (it == _allocations.end())
+        return;
+
+    Allocation    &allocation = it->second;
+    const uint64_t used       = std::min(usedBytes, allocation.bytes);
+    if (used == allocation.used)
+        return;
+    _apply(allocation, 0, static_cast<int64_t>(allocation.used) - static_cast<int64_t>(used), 0);
+    allocation.used = used;
+}
+
+void GpuMemory::_apply(const Allocation &allocation, int64_t bytes, int64_t wasted, int32_t count) {
+    auto add = [&](Totals &totals) {
+        totals.current += static_cast<uint64_t>(bytes); // unsigned wrap-around subtracts
+        totals.wasted += static_cast<uint64_t>(wasted);
+        totals.allocations += static_cast<uint32_t>(count);
+        totals.peak = std::max(totals.peak, totals.current);
+    };
+
+    add(_categories[static_cast<size_t>(allocation.category)]);
+    if (allocation.category != GpuMemoryCategory::CpuStaging)
+        add(_categories[static_cast<size_t>(GpuMemoryCategory::Total)]);
+
+    auto owner = _owners.find({ allocation.owner, allocation.category });
+    if (owner == _owners.end())
+        owner = _owners.emplace(OwnerKey { allocation.owner, allocation.category }, Totals {}).first;
+    add(owner->second);
+}
+
+void GpuMemory::_checkBudgets(GpuMemoryCategory category, std::vector<GpuMemoryBudgetEvent> &crossed) {
+    for (GpuMemoryCategory c : { category, GpuMemoryCategory::Total }) {
+        if (c == GpuMemoryCategory::Total && category == GpuMemoryCategory::CpuStaging)
+            continue;
+
+        Budget        &budget  = _budgets[static_cast<size_t>(c)];
+        const uint64_t current = _categories[static_cast<size_t>(c)].current;
+        if (budget.bytes == 0)
+            continue;
+        if (current <= budget.bytes) {
+            budget.over = false;
+        } else if (!budget.over) {
+            budget.over = true;
+            crossed.push_back({ c, current, budget.bytes, nullptr, 0 });
+        }
+    }
+}
+
+void GpuMemory::_setBudget(GpuMemoryCategory category, uint64_t bytes, BudgetCallback callback) {
+    std::lock_guard lock(_mutex);
+    Budget         &budget = _budgets[static_cast<size_t>(category)];
+    budget.bytes           = bytes;
+    budget.callback        = std::move(callback);
+    budget.over            = false; // an existing overrun reports on the next allocation
+}
+
+uint64_t GpuMemory::_stat(GpuMemoryCategory category, uint64_t Totals::*field) {
+    std::lock_guard lock(_mutex);
+    return _categories[static_cast<size_t>(category)].*field;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Reporting
+// ─────────────────────────────────────────────────────────────────────────────
+
+GpuMemoryReport GpuMemory::_getReport() {
+    GpuMemoryReport report;
+
+    std::lock_guard lock(_mutex);
+    auto            fill = [&](GpuMemoryCategoryStats &stats, size_t index) {
+        const Totals &totals = _categories[index];
+        stats.current        = totals.current;
+        stats.peak           = totals.peak;
+        stats.wasted         = totals.wasted;
+        stats.allocations    = totals.allocations;
+        stats.budget         = _budgets[index].bytes;
+    };
+
+    fill(report.total, static_cast<size_t>(GpuMemoryCategory::Total));
+    for (size_t i = 0; i < static_cast<size_t>(GpuMemoryCategory::Total); ++i) {
+        if (_categories[i].peak == 0 && _budgets[i].bytes == 0)
+            continue;
+        GpuMemoryCategoryStats stats { static_cast<GpuMemoryCategory>(i) };
+        fill(stats, i);
+        report.categories.push_back(stats);
+    }
+
+    for (const auto &[key, totals] : _owners) {
+        if (totals.allocations == 0)
+            continue;
+        report.owners.push_back({ key.owner, key.category, totals.current, totals.peak, totals.wasted, totals.allocations });
+    }
+    std::sort(report.owners.begin(), report.owners.end(),
+        [](const GpuMemoryOwnerStats &a, const GpuMemoryOwnerStats &b) { return a.current > b.current; });
+    return report;
+}
+
+void GpuMemory::LogReport() {
+    const GpuMemoryReport report = GetReport();
+
+    LOG_INFO("GPU memory: {} in {} allocations (peak {}, wasted {})", formatBytes(report.total.current),
+        report.total.allocations, formatBytes(report.total.peak), formatBytes(report.total.wasted));
+    for (const GpuMemoryCategoryStats &c : report.categories) {
+        LOG_INFO("  {:<16} {:>10}  peak {:>10}  wasted {:>10}  {:>5} allocs{}", CategoryName(c.category),
+            formatBytes(c.current), formatBytes(c.peak), formatBytes(c.wasted), c.allocations,
+            c.budget ? "  budget " + formatBytes(c.budget) : std::string());
+    }
+    for (const GpuMemoryOwnerStats &o : report.owners) {
+        LOG_INFO("    {:<28} {:<16} {:>10}  wasted {:>10}  {:>5} allocs", o.owner, CategoryName(o.category),
+            formatBytes(o.current), formatBytes(o.wasted), o.allocations);
+    }
+}
+
+const char *GpuMemory::CategoryName(GpuMemoryCategory category) {
+    switch (category) {
+    case GpuMemoryCategory::Other:
+        return "Other";
+    case GpuMemoryCategory::Textures:
+        return "Textures";
+    case GpuMemoryCategory::RenderTargets:
+        return "Render targets";
+    case GpuMemoryCategory::ShadowMaps:
+        return "Shadow maps";
+    case GpuMemoryCategory::Fonts:
+        return "Fonts";
+    case GpuMemoryCategory::SpriteInstances:
+        return "Sprite instances";
+    case GpuMemoryCategory::Particles:
+        return "Particles";
+    case GpuMemoryCategory::Meshes:
+        return "Meshes";
+    case GpuMemoryCategory::Geometry:
+        return "Geometry";
+    case GpuMemoryCategory::Compute:
+        return "Compute";
+    case GpuMemoryCategory::Transfer:
+        return "Transfer";
+    case GpuMemoryCategory::CpuStaging:
+        return "CPU staging";
+    case GpuMemoryCategory::Total:
+        return "Total";
+    }
+    return "?";
+}
+
+const char *GpuMemory::_intern(std::string_view owner) {
+    std::lock_guard lock(_namesMutex);
+    auto            it = _names.find(owner);
+    if (it == _names.end())
+        it = _names.emplace(owner).first;
+    return it->c_str();
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+// GPU memory accounting. Backends record every texture, buffer and transfer buffer they create
+// (TrackTexture / TrackBuffer / TrackTransferBuffer, Untrack on release) with its size, a category
+// and an owner; BufferManager's CPU staging buffers report in as well. Per category and per owner
+// it keeps current, peak and wasted bytes (allocated minus what the owner says it used, see
+// SetUsed), checks budgets on every allocation, and produces a report for logs and the perf HUD.
+//
+// Category and owner come from the innermost GpuMemoryScope on the allocating thread:
+//
+//   GpuMemoryScope memScope(GpuMemoryCategory::ShadowMaps, "Model3DRenderPass");
+//   _shadowDepthTex = gpu.CreateTexture(sd);
+//
+// Allocations made outside a scope are categorized from their usage flags (render targets,
+// geometry, compute, transfer, textures) under the owner "untagged".
+//
+// Sizes are computed from the create info, not queried from the driver: block-compressed formats,
+// mip chains, array layers, cube faces and MSAA samples are accounted for, driver padding is not.
+// The tracker has no backend dependency, so it can be driven (and checked) without a GPU device.
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "gpu/types.h"
+
+enum class GpuMemoryCategory : uint8_t {
+    Other,
+    Textures,
+    RenderTargets,
+    ShadowMaps,
+    Fonts,
+    SpriteInstances,
+    Particles,
+    Meshes,
+    Geometry,
+    Compute,
+    Transfer,
+    CpuStaging, ///< CPU-side buffers from BufferManager; not part of the GPU total
+    Total,      ///< All GPU categories together (for budgets); not a category of its own
+};
+
+/// @brief One category's totals in a GpuMemoryReport.
+struct GpuMemoryCategoryStats {
+    GpuMemoryCategory category;
+    uint64_t          current     = 0; ///< Bytes allocated now
+    uint64_t          peak        = 0; ///< Highest `current` since startup
+    uint64_t          wasted      = 0; ///< Allocated but not used (see GpuMemory::SetUsed)
+    uint64_t          budget      = 0; ///< 0 when no budget is set
+    uint32_t          allocations = 0;
+};
+
+/// @brief One owner's totals within one category.
+struct GpuMemoryOwnerStats {
+    const char       *owner;
+    GpuMemoryCategory category;
+    uint64_t          current     = 0;
+    uint64_t          peak        = 0;
+    uint64_t          wasted      = 0;
+    uint32_t          allocations = 0;
+};
+
+/// @brief Snapshot returned by GpuMemory::GetReport.
+struct GpuMemoryReport {
+    GpuMemoryCategoryStats              total { GpuMemoryCategory::Total }; ///< GPU categories summed
+    std::vector<GpuMemoryCategoryStats> categories;                         ///< Every category with a live allocation, a peak or a budget
+    std::vector<GpuMemoryOwnerStats>    owners;                             ///< Largest first
+};
+
+/// @brief Passed to a budget callback when a category (or the total) goes over its budget.
+struct GpuMemoryBudgetEvent {
+    GpuMemoryCategory category; ///< Total for the overall budget
+    uint64_t          current;
+    uint64_t          budget;
+    const char       *owner; ///< Owner of the allocation that crossed the budget
+    uint64_t          bytes; ///< Size of that allocation
+};
+
+/**
+ * @brief Tracks GPU allocations by category and owner, with budgets and reporting.
+ */
+class GpuMemory {
+public:
+    using BudgetCallback = std::function<void(const GpuMemoryBudgetEvent &)>;
+
+    /**
+     * @brief Records an allocation, or updates its size if `id` is already tracked.
+     *
+     * For memory the backends don't create (BufferManager's CPU buffers, say); GPU resources
+     * are recorded by the backends through TrackTexture / TrackBuffer / TrackTransferBuffer.
+     * A size update keeps the allocation's category, owner and used bytes (clamped to the new size).
+     *
+     * @param id Any value unique among live allocations (a GPU handle, a pointer).
+     * @param bytes Allocated size.
+     */
+    static void Track(uintptr_t id, GpuMemoryCategory category, const char *owner, uint64_t bytes) {
+        Get()._track(id, category, owner, bytes);
+    }
+
+    /// @brief Records a texture under the calling thread's GpuMemoryScope (backends call this from CreateTexture).
+    static void TrackTexture(GpuTextureHandle texture, const GpuTextureCreateInfo &info);
+
+    /// @brief Records a buffer under the calling thread's GpuMemoryScope (backends call this from CreateBuffer).
+    static void TrackBuffer(GpuBufferHandle buffer, const GpuBufferCreateInfo &info);
+
+    /// @brief Records a transfer buffer under the calling thread's GpuMemoryScope.
+    static void TrackTransferBuffer(GpuTransferBufferHandle buffer, const GpuTransferBufferCreateInfo &info);
+
+    /// @brief Forgets an allocation (no-op for ids that aren't tracked).
+    static void Untrack(uintptr_t id) { Get()._untrack(id); }
+
+    /**
+     * @brief Sets how many of an allocation's bytes are in use; the rest counts as wasted.
+     *
+     * Allocations start fully used. Owners of capacity-sized buffers (instance buffers,
+     * grow-only render targets) call this when their fill changes.
+     */
+    static void SetUsed(uintptr_t id, uint64_t usedBytes) { Get()._setUsed(id, usedBytes); }
+
+    /**
+     * @brief Sets a budget for a category, or for all GPU memory with GpuMemoryCategory::Total.
+     *
+     * Checked on every allocation: the callback runs (on the allocating thread, after the
+     * allocation is recorded) each time usage goes from within budget to over it. Without a
+     * callback a warning is logged instead. A budget of 0 removes it.
+     */
+    static void SetBudget(GpuMemoryCategory category, uint64_t bytes, BudgetCallback callback = {}) {
+        Get()._setBudget(category, bytes, std::move(callback));
+    }
+
+    /// @brief Bytes allocated now in a category (Total: all GPU categories).
+    static uint64_t GetCurrentBytes(GpuMemoryCategory category = GpuMemoryCategory::Total) { return Get()._stat(category, &Totals::current); }
+
+    /// @brief Highest allocated bytes in a category since startup (Total: all GPU categories).
+    static uint64_t GetPeakBytes(GpuMemoryCategory category = GpuMemoryCategory::Total) { return Get()._stat(category, &Totals::peak); }
+
+    /// @brief Allocated but unused bytes in a category (Total: all GPU categories).
+    static uint64_t GetWastedBytes(GpuMemoryCategory category = GpuMemoryCategory::Total) { return Get()._stat(category, &Totals::wasted); }
+
+    /// @brief Totals per category and per owner.
+    static GpuMemoryReport GetReport() { return Get()._getReport(); }
+
+    /// @brief Writes GetReport to the log as a table.
+    static void LogReport();
+
+    /// @brief Display name of a category ("Shadow maps", ...).
+    static const char *CategoryName(GpuMemoryCategory category);
+
+    /**
+     * @brief Estimated size of a texture: block-compressed formats, mips, layers, cube faces and
+     * MSAA samples included.
+     */
+    static uint64_t TextureBytes(const GpuTextureCreateInfo &info);
+
+    /// @cond INTERNAL
+    static const char *Intern(std::string_view owner) { return Get()._intern(owner); }
+    /// @endcond
+
+private:
+    static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(GpuMemoryCategory::Total) + 1;
+
+    struct Allocation {
+        GpuMemoryCategory category;
+        const char       *owner;
+        uint64_t          bytes;
+        uint64_t          used;
+    };
+
+    struct Totals {
+        uint64_t current     = 0;
+        uint64_t peak        = 0;
+        uint64_t wasted      = 0;
+        uint32_t allocations = 0;
+    };
+
+    struct Budget {
+        uint64_t       bytes = 0;
+        BudgetCallback callback;
+        bool           over = false; ///< re-armed when usage drops back under the budget
+    };
+
+    struct OwnerKey {
+        const char       *owner;
+        GpuMemoryCategory category;
+        bool              operator==(const OwnerKey &other) const { return owner == other.owner && category == other.category; }
+    };
+
+    struct OwnerKeyHash {
+        size_t operator()(const OwnerKey &key) const {
+            return std::hash<const void *>()(key.owner) ^ (static_cast<size_t>(key.category) << 1);
+        }
+    };
+
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+    };
+
+    void        _track(uintptr_t id, GpuMemoryCategory category, const char *owner, uint64_t bytes);
+    void        _trackScoped(uintptr_t id, GpuMemoryCategory fallback, uint64_t bytes);
+    void        _untrack(uintptr_t id);
+    void        _setUsed(uintptr_t id, uint64_t usedBytes);
+    void        _setBudget(GpuMemoryCategory category, uint64_t bytes, BudgetCallback callback);
+    uint64_t    _stat(GpuMemoryCategory category, uint64_t Totals::*field);
+    GpuMemoryReport _getReport();
+    const char *_intern(std::string_view owner);
+
+    // Adds `bytes` / `wasted` (either may be negative) to a category, its owner and the GPU total
+    void _apply(const Allocation &allocation, int64_t bytes, int64_t wasted, int32_t count);
+    void _checkBudgets(GpuMemoryCategory category, std::vector<GpuMemoryBudgetEvent> &crossed);
+
+    std::mutex                                          _mutex;
+    std::unordered_map<uintptr_t, Allocation>           _allocations;
+    std::array<Totals, CATEGORY_COUNT>                  _categories {};
+    std::array<Budget, CATEGORY_COUNT>                  _budgets {};
+    std::unordered_map<OwnerKey, Totals, OwnerKeyHash> _owners;
+
+    std::mutex                                                 _namesMutex;
+    std::unordered_set<std::string, NameHash, std::equal_to<>> _names;
+
+public:
+    /// @cond INTERNAL
+    GpuMemory(const GpuMemory &) = delete;
+
+    static GpuMemory &Get() {
+        static GpuMemory instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    GpuMemory() = default;
+};
+
+/**
+ * @brief Tags the GPU allocations made on this thread during its lifetime with a category and owner.
+ *
+ * Scopes nest; the innermost wins. An owner given as const char* must have static storage
+ * (a string literal); a std::string_view is interned.
+ */
+class GpuMemoryScope {
+public:
+    GpuMemoryScope(GpuMemoryCategory category, const char *owner);
+    GpuMemoryScope(GpuMemoryCategory category, std::string_view owner)
+        : GpuMemoryScope(category, GpuMemory::Intern(owner)) { }
+    ~GpuMemoryScope();
+
+    GpuMemoryScope(const GpuMemoryScope &)            = delete;
+    GpuMemoryScope &operator=(const GpuMemoryScope &) = delete;
+
+    /// @brief The calling thread's innermost scope, or nullptr outside any scope.
+    static const GpuMemoryScope *Current();
+
+    GpuMemoryCategory Category() const { return _category; }
+    const char       *Owner() const { return _owner; }
+
+private:
+    GpuMemoryCategory     _category;
+    const char           *_owner;
+    const GpuMemoryScope *_previous;
+};
@@ -0,0 +1,187 @@
+#pragma once
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Simd — a thin 4-wide float vector over SSE / NEON, with a scalar fallback.
+//
+// Just enough surface for the engine's data-parallel inner loops (audio DSP, batch math).
+// Everything is force-inlined wrappers over the native intrinsics, so a loop written
+// against Simd::Float4 compiles to the same code as hand-written intrinsics.
+//
+// Backend is picked at compile time:
+//   LUMI_SIMD_SSE    x86-64 / x86 with SSE2 (always on x86-64)
+//   LUMI_SIMD_NEON   AArch64 / ARMv7 with NEON
+//   LUMI_SIMD_SCALAR everything else (Emscripten without -msimd128, exotic targets)
+// LUMI_SIMD_AVX is additionally defined when the translation unit is built with AVX
+// (e.g. -march=native on a modern x86), for the few loops that have an 8-wide path.
+// ─────────────────────────────────────────────────────────────────────────────
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LUMI_SIMD_SSE 1
+#include <immintrin.h>
+#if defined(__AVX__)
+#define LUMI_SIMD_AVX 1
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LUMI_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define LUMI_SIMD_SCALAR 1
+#endif
+
+#if defined(_MSC_VER)
+#define LUMI_SIMD_INLINE __forceinline
+#else
+#define LUMI_SIMD_INLINE inline __attribute__((always_inline))
+#endif
+
+// Free functions are PascalCase like the rest of the engine API (Simd::Add, Simd::Load).
+// NOLINTBEGIN(readability-identifier-naming)
+namespace Simd {
+
+/// Number of float lanes in a Float4.
+inline constexpr size_t Width = 4;
+
+#if defined(LUMI_SIMD_SSE)
+struct Float4 {
+    __m128 v;
+};
+
+LUMI_SIMD_INLINE Float4 Load(const float *p) { return { _mm_loadu_ps(p) }; }
+LUMI_SIMD_INLINE void   Store(float *p, Float4 a) { _mm_storeu_ps(p, a.v); }
+LUMI_SIMD_INLINE Float4 Set1(float s) { return { _mm_set1_ps(s) }; }
+LUMI_SIMD_INLINE Float4 Zero() { return { _mm_setzero_ps() }; }
+LUMI_SIMD_INLINE Float4 Add(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Sub(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Mul(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Min(Float4 a, Float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Max(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Abs(Float4 a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+LUMI_SIMD_INLINE Float4 Sqrt(Float4 a) { return { _mm_sqrt_ps(a.v) }; }
+/// Bit i set where lane i of a <= lane i of b.
+LUMI_SIMD_INLINE int LessEqualMask(Float4 a, Float4 b) { return _mm_movemask_ps(_mm_cmple_ps(a.v, b.v)); }
+/// Round to nearest (ties to even), like std::nearbyint under the default rounding mode.
+LUMI_SIMD_INLINE Float4 Round(Float4 a) { return { _mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)) }; }
+/// a * b + c (fused where the target has FMA).
+LUMI_SIMD_INLINE Float4 MulAdd(Float4 a, Float4 b, Float4 c) {
+#if defined(__FMA__)
+    return { _mm_fmadd_ps(a.v, b.v, c.v) };
+#else
+    return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) };
+#endif
+}
+#elif defined(LUMI_SIMD_NEON)
+struct Float4 {
+    float32x4_t v;
+};
+
+LUMI_SIMD_INLINE Float4 Load(const float *p) { return { vld1q_f32(p) }; }
+LUMI_SIMD_INLINE void   Store(float *p, Float4 a) { vst1q_f32(p, a.v); }
+LUMI_SIMD_INLINE Float4 Set1(float s) { return { vdupq_n_f32(s) }; }
+LUMI_SIMD_INLINE Float4 Zero() { return { vdupq_n_f32(0.0f) }; }
+LUMI_SIMD_INLINE Float4 Add(Float4 a, Float4 b) { return { vaddq_f32(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Sub(Float4 a, Float4 b) { return { vsubq_f32(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Mul(Float4 a, Float4 b) { return { vmulq_f32(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Min(Float4 a, Float4 b) { return { vminq_f32(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Max(Float4 a, Float4 b) { return { vmaxq_f32(a.v, b.v) }; }
+LUMI_SIMD_INLINE Float4 Abs(Float4 a) { return { vabsq_f32(a.v) }; }
+LUMI_SIMD_INLINE Float4 Sqrt(Float4 a) {
+#if defined(__aarch64__)
+    return { vsqrtq_f32(a.v) };
+#else
+    float lanes[4];
+    vst1q_f32(lanes, a.v);
+    for (float &lane : lanes)
+        lane = std::sqrt(lane);
+    return { vld1q_f32(lanes) };
+#endif
+}
+LUMI_SIMD_INLINE int LessEqualMask(Float4 a, Float4 b) {
+    static const uint32_t bits[4] = { 1, 2, 4, 8 };
+    const uint32x4_t      lanes   = vandq_u32(vcleq_f32(a.v, b.v), vld1q_u32(bits));
+#if defined(__aarch64__)
+    return static_cast<int>(vaddvq_u32(lanes));
+#else
+    const uint32x2_t pair = vadd_u32(vget_low_u32(lanes), vget_high_u32(lanes));
+    return static_cast<int>(vget_lane_u32(vpadd_u32(pair, pair), 0));
+#endif
+}
+LUMI_SIMD_INLINE Float4 Round(Float4 a) {
+#if defined(__aarch64__)
+    return { vrndnq_f32(a.v) };
+#else
+    return { vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(a.v, vbslq_f32(vcltq_f32(a.v, vdupq_n_f32(0.0f)), vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f))))) };
+#endif
+}
+LUMI_SIMD_INLINE Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return { vmlaq_f32(c.v, a.v, b.v) }; }
+#else
+struct Float4 {
+    float v[4];
+};
+
+LUMI_SIMD_INLINE Float4 Load(const float *p) { return { { p[0], p[1], p[2], p[3] } }; }
+LUMI_SIMD_INLINE void   Store(float *p, Float4 a) {
+    for (int i = 0; i < 4; ++i)
+        p[i] = a.v[i];
+}
+LUMI_SIMD_INLINE Float4 Set1(float s) { return { { s, s, s, s } }; }
+LUMI_SIMD_INLINE Float4 Zero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+
+#define LUMI_SIMD_SCALAR_OP(name, expr)                  \
+    LUMI_SIMD_INLINE Float4 name(Float4 a, Float4 b) {   \
+        Float4 r;                                        \
+        for (int i = 0; i < 4; ++i) {                    \
+            float x = a.v[i], y = b.v[i];                \
+            r.v[i]  = (expr);                            \
+        }                                                \
+        return r;                                        \
+    }
+LUMI_SIMD_SCALAR_OP(Add, x + y)
+LUMI_SIMD_SCALAR_OP(Sub, x - y)
+LUMI_SIMD_SCALAR_OP(Mul, x *y)
+LUMI_SIMD_SCALAR_OP(Min, x < y ? x : y)
+LUMI_SIMD_SCALAR_OP(Max, x > y ? x : y)
+#undef LUMI_SIMD_SCALAR_OP
+
+LUMI_SIMD_INLINE Float4 Abs(Float4 a) { return { { std::fabs(a.v[0]), std::fabs(a.v[1]), std::fabs(a.v[2]), std::fabs(a.v[3]) } }; }
+LUMI_SIMD_INLINE Float4 Sqrt(Float4 a) { return { { std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) } }; }
+LUMI_SIMD_INLINE int    LessEqualMask(Float4 a, Float4 b) {
+    int mask = 0;
+    for (int i = 0; i < 4; ++i)
+        mask |= (a.v[i] <= b.v[i]) << i;
+    return mask;
+}
+LUMI_SIMD_INLINE Float4 Round(Float4 a) { return { { std::nearbyint(a.v[0]), std::nearbyint(a.v[1]), std::nearbyint(a.v[2]), std::nearbyint(a.v[3]) } }; }
+LUMI_SIMD_INLINE Float4 MulAdd(Float4 a, Float4 b, Float4 c) { return Add(Mul(a, b), c); }
+#endif
+
+/// Clamp every lane to [lo, hi].
+LUMI_SIMD_INLINE Float4 Clamp(Float4 a, Float4 lo, Float4 hi) { return Min(Max(a, lo), hi); }
+
+// ── Span helpers (vector body + scalar tail) ──────────────────────────────────
+
+/// dst[i] *= gain
+inline void Scale(float *dst, size_t count, float gain) {
+    const Float4 g = Set1(gain);
+    size_t       i = 0;
+    for (; i + Width <= count; i += Width)
+        Store(dst + i, Mul(Load(dst + i), g));
+    for (; i < count; ++i)
+        dst[i] *= gain;
+}
+
+/// dst[i] = dst[i] * dryGain + src[i] * wetGain
+inline void Mix(float *dst, const float *src, size_t count, float dryGain, float wetGain) {
+    const Float4 d = Set1(dryGain), w = Set1(wetGain);
+    size_t       i = 0;
+    for (; i + Width <= count; i += Width)
+        Store(dst + i, MulAdd(Load(src + i), w, Mul(Load(dst + i), d)));
+    for (; i < count; ++i)
+        dst[i] = dst[i] * dryGain + src[i] * wetGain;
+}
+
+} // namespace Simd
+// NOLINTEND(readability-identifier-naming)
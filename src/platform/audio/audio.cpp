@@ -1,5 +1,7 @@
 #include "audio.h"
 
+#include <cstdlib>
+
 #include "miniaudio.h"
 
 #include "assets/assethandler.h"
@@ -241,6 +243,8 @@ void Audio::_updateMusicStreams() {
 #ifdef __EMSCRIPTEN__
     ma_resource_manager_process_next_job(&_resourceManager);
 #endif
+    if (!MusicStreamer::IsThreaded())
+        MusicStreamer::Pump();
     for (auto &music : AssetHandler::GetLoadedMusics()) {
         if (music.second.shouldPlay) {
             ma_sound_start(music.second.music);
@@ -309,10 +313,11 @@ void Audio::_setMusicLooping(Music &music, bool looping) {
 void Audio::_setChannelVolume(AudioChannel channel, float volume) {
     volume = std::clamp(volume, 0.0f, 1.0f);
 
+    std::lock_guard<std::mutex> lock(_commandProducerMutex);
     if (channel == AudioChannel::Master) {
         _masterVolume = volume;
         if (!_masterMuted) {
-            ma_engine_set_volume(&_engine, volume);
+            _pushCommandLocked({ AudioCommand::Type::MasterVolume, -1, volume, nullptr, nullptr });
         }
         return;
     }
@@ -323,11 +328,12 @@ void Audio::_setChannelVolume(AudioChannel channel, float volume) {
 
     _channels[idx].volume = volume;
     if (!_channels[idx].muted) {
-        ma_sound_group_set_volume(&_channels[idx].group, volume);
+        _pushCommandLocked({ AudioCommand::Type::ChannelVolume, static_cast<int8_t>(idx), volume, nullptr, nullptr });
     }
 }
 
 float Audio::_getChannelVolume(AudioChannel channel) {
+    std::lock_guard<std::mutex> lock(_commandProducerMutex);
     if (channel == AudioChannel::Master)
         return _masterVolume;
 
@@ -347,8 +353,9 @@ void Audio::_setChannelPanning(AudioChannel channel, float panning) {
     if (idx < 0 || idx >= NUM_GROUPS || !_channels[idx].initialized)
         return;
 
+    std::lock_guard<std::mutex> lock(_commandProducerMutex);
     _channels[idx].panning = panning;
-    ma_sound_group_set_pan(&_channels[idx].group, panning);
+    _pushCommandLocked({ AudioCommand::Type::ChannelPanning, static_cast<int8_t>(idx), panning, nullptr, nullptr });
 }
 
 float Audio::_getChannelPanning(AudioChannel channel) {
@@ -358,13 +365,16 @@ float Audio::_getChannelPanning(AudioChannel channel) {
     int idx = channelIndex(channel);
     if (idx < 0 || idx >= NUM_GROUPS)
         return 0.0f;
+
+    std::lock_guard<std::mutex> lock(_commandProducerMutex);
     return _channels[idx].panning;
 }
 
 void Audio::_muteChannel(AudioChannel channel, bool muted) {
+    std::lock_guard<std::mutex> lock(_commandProducerMutex);
     if (channel == AudioChannel::Master) {
         _masterMuted = muted;
-        ma_engine_set_volume(&_engine, muted ? 0.0f : _masterVolume);
+        _pushCommandLocked({ AudioCommand::Type::MasterVolume, -1, muted ? 0.0f : _masterVolume, nullptr, nullptr });
         return;
     }
 
@@ -373,10 +383,12 @@ void Audio::_muteChannel(AudioChannel channel, bool muted) {
         return;
 
     _channels[idx].muted = muted;
-    ma_sound_group_set_volume(&_channels[idx].group, muted ? 0.0f : _channels[idx].volume);
+    _pushCommandLocked({ AudioCommand::Type::ChannelVolume, static_cast<int8_t>(idx),
+        muted ? 0.0f : _channels[idx].volume, nullptr, nullptr });
 }
 
 bool Audio::_isChannelMuted(AudioChannel channel) {
+    std::lock_guard<std::mutex> lock(_commandProducerMutex);
     if (channel == AudioChannel::Master)
         return _masterMuted;
 
@@ -479,80 +491,67 @@ void Audio::_destroyPCMSound(PCMSound &sound) {
 // Channel effects
 // ═══════════════════════════════════════════════════════════════════
 
+// Each group is permanently routed group → effect node → endpoint (wired up in _init). With no
+// effect set the node is a plain copy, so setting/removing an effect never rewires the graph from
+// the game thread — it's just a callback swap applied by the audio thread between buffers.
+
 void Audio::_setChannelEffect(AudioChannel channel, PCMEffectCallback callback, void *userData) {
     // Master effect — applied in the device data callback, no node graph needed
     if (channel == AudioChannel::Master) {
-        _masterEffectCallback = callback;
-        _masterEffectUserData = userData;
+        _pushCommand({ AudioCommand::Type::MasterEffect, -1, 0.0f, callback, userData });
         return;
     }
 
     int idx = channelIndex(channel);
-    if (idx < 0 || idx >= NUM_GROUPS || !_channels[idx].initialized)
-        return;
-
-    auto &ch = _channels[idx];
-
-    // If there's already an effect node, tear it down first
-    if (ch.effectNode.initialized) {
-        _removeChannelEffect(channel);
-    }
-
-    // Set up the effect node
-    ch.effectNode.callback = callback;
-    ch.effectNode.userData = userData;
-    ch.effectNode.channels = static_cast<uint32_t>(_numberChannels);
-
-    uint32_t channelCount = ch.effectNode.channels;
-
-    ma_node_config nodeConfig  = ma_node_config_init();
-    nodeConfig.vtable          = &effectNodeVtable;
-    nodeConfig.inputBusCount   = 1;
-    nodeConfig.outputBusCount  = 1;
-    nodeConfig.pInputChannels  = &channelCount;
-    nodeConfig.pOutputChannels = &channelCount;
-
-    ma_result result = ma_node_init(ma_engine_get_node_graph(&_engine),
-        &nodeConfig, nullptr, &ch.effectNode.base);
-    if (result != MA_SUCCESS) {
-        LOG_WARNING("Failed to init effect node for channel {}", idx);
+    if (idx < 0 || idx >= NUM_GROUPS || !_channels[idx].initialized || !_channels[idx].effectNode.initialized)
         return;
-    }
-
-    ch.effectNode.initialized = true;
 
-    // Re-route: group → effect node → engine endpoint
-    ma_node *endpoint = ma_engine_get_endpoint(&_engine);
-    ma_node_detach_output_bus(&ch.group, 0);
-    ma_node_attach_output_bus(&ch.group, 0, &ch.effectNode.base, 0);
-    ma_node_attach_output_bus(&ch.effectNode.base, 0, endpoint, 0);
+    _pushCommand({ AudioCommand::Type::ChannelEffect, static_cast<int8_t>(idx), 0.0f, callback, userData });
 }
 
 void Audio::_removeChannelEffect(AudioChannel channel) {
-    if (channel == AudioChannel::Master) {
-        _masterEffectCallback = nullptr;
-        _masterEffectUserData = nullptr;
-        return;
-    }
-
-    int idx = channelIndex(channel);
-    if (idx < 0 || idx >= NUM_GROUPS || !_channels[idx].initialized)
-        return;
-
-    auto &ch = _channels[idx];
-    if (!ch.effectNode.initialized)
-        return;
+    _setChannelEffect(channel, nullptr, nullptr);
+}
 
-    // Re-route: group → engine endpoint (bypass effect)
-    ma_node *endpoint = ma_engine_get_endpoint(&_engine);
-    ma_node_detach_output_bus(&ch.group, 0);
-    ma_node_detach_output_bus(&ch.effectNode.base, 0);
-    ma_node_attach_output_bus(&ch.group, 0, endpoint, 0);
+// ═══════════════════════════════════════════════════════════════════
+// Audio-thread command queue
+// ═══════════════════════════════════════════════════════════════════
 
-    ma_node_uninit(&ch.effectNode.base, nullptr);
-    ch.effectNode.initialized = false;
-    ch.effectNode.callback    = nullptr;
-    ch.effectNode.userData    = nullptr;
+void Audio::_pushCommand(const AudioCommand &command) {
+    std::lock_guard<std::mutex> lock(_commandProducerMutex);
+    _pushCommandLocked(command);
+}
+
+void Audio::_pushCommandLocked(const AudioCommand &command) {
+    // The ring is single-producer; game code may call the setters from several threads, so the
+    // producers take turns on _commandProducerMutex. The audio thread never touches it.
+    if (!_commands.Push(command)) {
+        LOG_WARNING("Audio command queue full ({} pending), dropping parameter change", COMMAND_QUEUE_SIZE);
+    }
+}
+
+void Audio::_drainCommands() {
+    _commands.Drain([this](const AudioCommand &cmd) {
+        switch (cmd.type) {
+            case AudioCommand::Type::MasterVolume:
+                ma_engine_set_volume(&_engine, cmd.value);
+                break;
+            case AudioCommand::Type::ChannelVolume:
+                ma_sound_group_set_volume(&_channels[cmd.channel].group, cmd.value);
+                break;
+            case AudioCommand::Type::ChannelPanning:
+                ma_sound_group_set_pan(&_channels[cmd.channel].group, cmd.value);
+                break;
+            case AudioCommand::Type::ChannelEffect:
+                _channels[cmd.channel].effectNode.callback = cmd.callback;
+                _channels[cmd.channel].effectNode.userData = cmd.userData;
+                break;
+            case AudioCommand::Type::MasterEffect:
+                _masterEffectCallback = cmd.callback;
+                _masterEffectUserData = cmd.userData;
+                break;
+        }
+    });
 }
 
 // ═══════════════════════════════════════════════════════════════════
@@ -563,6 +562,11 @@ void Audio::ma_data_callback(ma_device *pDevice, void *pOutput, const void *pInp
     LUMI_UNUSED(pInput);
 
     auto &audio = Audio::Get();
+
+    // Apply queued parameter changes first so they land on a buffer boundary, before any node
+    // (including the channel effect nodes) processes this block.
+    audio._drainCommands();
+
     ma_engine_read_pcm_frames(&audio._engine, pOutput, frameCount, nullptr);
 
     // Apply master effect if one is set
@@ -583,7 +587,21 @@ void Audio::_init() {
     deviceConfig.dataCallback      = Audio::ma_data_callback;
     deviceConfig.pUserData         = &_engine;
 
-    ma_device_init(nullptr, &deviceConfig, &_device);
+    // LUMI_AUDIO_NULL_DEVICE=1 opens miniaudio's null backend: the mixer and its callback run at
+    // real-time pace on their own thread, but nothing reaches a sound card (headless CI, tests)
+    ma_context *context       = nullptr;
+    const char *nullDeviceEnv = std::getenv("LUMI_AUDIO_NULL_DEVICE");
+    if (nullDeviceEnv && *nullDeviceEnv && *nullDeviceEnv != '0') {
+        ma_backend backend = ma_backend_null;
+        if (ma_context_init(&backend, 1, nullptr, &_nullContext) == MA_SUCCESS) {
+            _nullContextInit = true;
+            context          = &_nullContext;
+        } else {
+            LOG_WARNING("LUMI_AUDIO_NULL_DEVICE: null backend unavailable, using the default device");
+        }
+    }
+
+    ma_device_init(context, &deviceConfig, &_device);
 
     ma_resource_manager_config resourceManagerConfig = ma_resource_manager_config_init();
     resourceManagerConfig.decodedFormat              = ma_format_f32;
@@ -607,6 +625,8 @@ void Audio::_init() {
         Get()._audioInit = true;
     }
 
+    MusicStreamer::Start();
+
     // Initialize mix channel groups (SFX, Voice, Music)
     for (int i = 0; i < NUM_GROUPS; i++) {
         ma_result groupResult = ma_sound_group_init(&_engine, 0, nullptr, &_channels[i].group);
@@ -617,6 +637,37 @@ void Audio::_init() {
         }
     }
 
+    // Insert a (pass-through until an effect is set) effect node after every group, once
+    ma_node *endpoint = ma_engine_get_endpoint(&_engine);
+    for (int i = 0; i < NUM_GROUPS; i++) {
+        auto &ch = _channels[i];
+        if (!ch.initialized)
+            continue;
+
+        ch.effectNode.callback = nullptr;
+        ch.effectNode.userData = nullptr;
+        ch.effectNode.channels = static_cast<uint32_t>(_numberChannels);
+
+        uint32_t channelCount = ch.effectNode.channels;
+
+        ma_node_config nodeConfig  = ma_node_config_init();
+        nodeConfig.vtable          = &effectNodeVtable;
+        nodeConfig.inputBusCount   = 1;
+        nodeConfig.outputBusCount  = 1;
+        nodeConfig.pInputChannels  = &channelCount;
+        nodeConfig.pOutputChannels = &channelCount;
+
+        if (ma_node_init(ma_engine_get_node_graph(&_engine), &nodeConfig, nullptr, &ch.effectNode.base) != MA_SUCCESS) {
+            LOG_WARNING("Failed to init effect node for channel {}", i);
+            continue;
+        }
+        ch.effectNode.initialized = true;
+
+        ma_node_detach_output_bus(&ch.group, 0);
+        ma_node_attach_output_bus(&ch.group, 0, &ch.effectNode.base, 0);
+        ma_node_attach_output_bus(&ch.effectNode.base, 0, endpoint, 0);
+    }
+
     // Initialize polyphonic sound pool
     for (size_t i = 0; i < _soundPool.size(); ++i) {
         _soundPool[i] = nullptr;
@@ -630,12 +681,22 @@ void Audio::_close() {
 
     _stopMusic();
 
-    // Remove all channel effects
+    // Stop the callback before tearing the graph down; from here on the game thread owns
+    // everything the command queue normally hands to the audio thread.
+    ma_device_stop(&_device);
+    _drainCommands();
+    MusicStreamer::Stop();
+
+    // Tear down the channel effect nodes
     for (int i = 0; i < NUM_GROUPS; i++) {
-        if (_channels[i].effectNode.initialized) {
-            AudioChannel ch = static_cast<AudioChannel>(i + 1);
-            _removeChannelEffect(ch);
-        }
+        auto &ch = _channels[i];
+        if (!ch.effectNode.initialized)
+            continue;
+        ma_node_detach_output_bus(&ch.effectNode.base, 0);
+        ma_node_uninit(&ch.effectNode.base, nullptr);
+        ch.effectNode.initialized = false;
+        ch.effectNode.callback    = nullptr;
+        ch.effectNode.userData    = nullptr;
     }
     _masterEffectCallback = nullptr;
     _masterEffectUserData = nullptr;
@@ -663,6 +724,13 @@ void Audio::_close() {
     ma_resource_manager_uninit(&_resourceManager);
     ma_engine_uninit(&_engine);
 
+    if (_nullContextInit) {
+        // The engine doesn't own a device it was handed; release it before its context
+        ma_device_uninit(&_device);
+        ma_context_uninit(&_nullContext);
+        _nullContextInit = false;
+    }
+
     _audioInit = false;
 }
 
@@ -2,14 +2,18 @@
 
 #include <unordered_map>
 #include <array>
+#include <mutex>
 #include <vector>
 
 #include "core/settings/settings.h"
+#include "util/spscqueue.h"
 
 #include "assets/audio/sound.h"
 #include "assets/audio/music.h"
 #include "assets/audio/pcmsound.h"
 #include "assets/audio/soundinstance.h"
+#include "platform/audio/dsp.h"
+#include "platform/audio/musicstream.h"
 
 /**
  * @brief Audio mix channels for routing sounds through volume/panning groups.
@@ -64,15 +68,26 @@ public:
         Get()._playMusic(music);
     }
 
+    /**
+     * @brief Sets how far ahead streamed music is decoded, in seconds (default 0.5).
+     *
+     * Applies to music loaded from now on. Raise it if streamed music stutters on slow storage
+     * or a busy machine; each streamed track holds this much decoded PCM.
+     */
+    static void SetMusicReadAhead(float seconds) {
+        MusicStreamer::SetReadAhead(seconds);
+    }
+
     /**
      * @brief Playback progress of a music asset in [0,1], or -1 if unknown (not loaded / zero length).
      */
     static float GetMusicProgress(Music &music) {
         if (!music.music)
             return -1.0f;
-        // The length query scans the file to count frames — far too expensive per frame (it
-        // stutters the audio). It's constant, so compute it once and cache it on the asset; only
-        // the cursor is polled each frame (cheap).
+        // For non-streamed music the length query scans the file to count frames — far too
+        // expensive per frame (it stutters the audio). It's constant, so compute it once and cache
+        // it on the asset; only the cursor is polled each frame (cheap). Streamed music reports 0
+        // until the stream thread has scanned it, so this returns -1 for the first few frames.
         if (music.lengthFrames == 0)
             ma_sound_get_length_in_pcm_frames(music.music, &music.lengthFrames);
         if (music.lengthFrames == 0)
@@ -354,6 +369,9 @@ public:
      * One effect per channel. Calling again replaces the previous effect.
      * For Master, the effect runs on the final mixed output before the device.
      *
+     * The swap is queued and takes effect at the start of the next audio buffer, so the old
+     * callback may still run once after this returns — keep its userData alive until then.
+     *
      * @param channel  The channel to apply the effect to.
      * @param callback Function that processes samples in-place.
      * @param userData Pointer passed to the callback. You own the lifetime.
@@ -362,6 +380,18 @@ public:
         Get()._setChannelEffect(channel, callback, userData);
     }
 
+    /**
+     * @brief Sets a built-in DSP effect (or an EffectChain) as a channel's insert effect.
+     *
+     * Same semantics as the callback overload; the effect must outlive its use on the channel.
+     *
+     * @param channel The channel to apply the effect to.
+     * @param effect  The effect to run on the channel's mixed output.
+     */
+    static void SetChannelEffect(AudioChannel channel, Dsp::Effect &effect) {
+        Get()._setChannelEffect(channel, &Dsp::Effect::Callback, &effect);
+    }
+
     /**
      * @brief Removes the insert effect from an audio channel.
      *
@@ -458,6 +488,41 @@ private:
 
     void _removeChannelEffect(AudioChannel channel);
 
+    // ── Audio-thread command queue ──
+
+    /// @cond INTERNAL
+    /// A parameter change marshalled from the game thread to the audio callback. The game side
+    /// keeps its own shadow copy (for the getters); only the callback touches the live mix state.
+    struct AudioCommand {
+        enum class Type : uint8_t {
+            MasterVolume,   ///< value = effective engine volume (0 when muted)
+            ChannelVolume,  ///< value = effective group volume (0 when muted)
+            ChannelPanning, ///< value = pan
+            ChannelEffect,  ///< callback/userData swapped on the channel's effect node
+            MasterEffect,   ///< callback/userData swapped on the device-callback effect
+        };
+
+        Type              type;
+        int8_t            channel; ///< Group index (channelIndex()), unused for master commands
+        float             value;
+        PCMEffectCallback callback;
+        void             *userData;
+    };
+    /// @endcond
+
+    /// Commands pending for the audio thread. Sized for a burst of UI slider spam between buffers.
+    static constexpr size_t COMMAND_QUEUE_SIZE = 1024;
+
+    /// Game-thread side: serializes producers (the ring is SPSC) and pushes. Never called on the audio thread.
+    void _pushCommand(const AudioCommand &command);
+
+    /// As _pushCommand, with _commandProducerMutex already held (so a setter can update the shadow
+    /// state below and push in one step).
+    void _pushCommandLocked(const AudioCommand &command);
+
+    /// Audio-thread side: applies every queued command. Called at the top of ma_data_callback.
+    void _drainCommands();
+
     // ── Lifecycle ──
 
     void _init();
@@ -483,14 +548,21 @@ private:
     };
     /// @endcond
 
+    // volume / panning / muted and the master pair are the game thread's shadow of what it sent
+    // the audio thread; guarded by _commandProducerMutex so concurrent setters can't interleave
+    // the shadow update with another setter's push
     std::array<ChannelState, NUM_GROUPS> _channels;
     float                                _masterVolume = 1.0f;
     bool                                 _masterMuted  = false;
 
-    // Master effect (applied in the device data callback)
+    // Master effect (applied in the device data callback). Owned by the audio thread once the
+    // device is running; the game thread only changes it through the command queue.
     PCMEffectCallback _masterEffectCallback = nullptr;
     void             *_masterEffectUserData = nullptr;
 
+    SpscQueue<AudioCommand, COMMAND_QUEUE_SIZE> _commands;
+    std::mutex                                  _commandProducerMutex; // game-thread only; also guards the shadow state
+
     // ── Engine state ──
 
     int _numberChannels = 2;
@@ -499,6 +571,8 @@ private:
     ma_device           _device;
     ma_engine           _engine;
     ma_resource_manager _resourceManager;
+    ma_context          _nullContext; ///< Only with LUMI_AUDIO_NULL_DEVICE set (see _init)
+    bool                _nullContextInit = false;
 
     /// Pool of polyphonic sound instances
     std::array<ma_sound *, 128> _soundPool;
@@ -0,0 +1,789 @@
+#include "dsp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "math/simd.h"
+
+namespace Dsp {
+
+static constexpr float PI_F = 3.14159265358979323846f;
+
+static float dbToLinear(float db) {
+    return std::pow(10.0f, db * 0.05f);
+}
+
+static float linearToDb(float linear) {
+    return 20.0f * std::log10(std::max(linear, 1e-9f));
+}
+
+// Per-frame lane loads for the "one channel per SIMD lane" recursive effects. Channels are
+// processed in groups of Simd::Width; the unused lanes of a partial group are zero in, discarded out.
+static Simd::Float4 loadLanes(const float *frame, uint32_t count) {
+    if (count == Simd::Width)
+        return Simd::Load(frame);
+    alignas(16) float tmp[Simd::Width] = {};
+    std::memcpy(tmp, frame, count * sizeof(float));
+    return Simd::Load(tmp);
+}
+
+static void storeLanes(float *frame, Simd::Float4 v, uint32_t count) {
+    if (count == Simd::Width) {
+        Simd::Store(frame, v);
+        return;
+    }
+    alignas(16) float tmp[Simd::Width];
+    Simd::Store(tmp, v);
+    std::memcpy(frame, tmp, count * sizeof(float));
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Biquad
+// ═══════════════════════════════════════════════════════════════════
+
+Biquad::Biquad(BiquadType type, float frequency, float q, float gainDb, float sampleRate)
+    : _type(type), _frequency(frequency), _q(q), _gainDb(gainDb), _sampleRate(sampleRate) { }
+
+void Biquad::SetType(BiquadType type) {
+    _type.store(type, std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Biquad::SetFrequency(float hz) {
+    _frequency.store(hz, std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Biquad::SetQ(float q) {
+    _q.store(q, std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Biquad::SetGain(float gainDb) {
+    _gainDb.store(gainDb, std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Biquad::_updateCoefficients() {
+    const float nyquist = _sampleRate * 0.5f;
+    const float freq    = std::clamp(_frequency.load(std::memory_order_relaxed), 1.0f, nyquist * 0.99f);
+    const float q       = std::max(_q.load(std::memory_order_relaxed), 0.01f);
+    const float gainDb  = _gainDb.load(std::memory_order_relaxed);
+
+    const float w0    = 2.0f * PI_F * freq / _sampleRate;
+    const float cosw  = std::cos(w0);
+    const float alpha = std::sin(w0) / (2.0f * q);
+    const float a     = std::pow(10.0f, gainDb / 40.0f);
+    const float sq    = 2.0f * std::sqrt(a) * alpha;
+
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a0 = 1.0f, a1 = 0.0f, a2 = 0.0f;
+    switch (_type.load(std::memory_order_relaxed)) {
+        case BiquadType::LowPass:
+            b0 = (1.0f - cosw) * 0.5f, b1 = 1.0f - cosw, b2 = b0;
+            a0 = 1.0f + alpha, a1 = -2.0f * cosw, a2 = 1.0f - alpha;
+            break;
+        case BiquadType::HighPass:
+            b0 = (1.0f + cosw) * 0.5f, b1 = -(1.0f + cosw), b2 = b0;
+            a0 = 1.0f + alpha, a1 = -2.0f * cosw, a2 = 1.0f - alpha;
+            break;
+        case BiquadType::BandPass:
+            b0 = alpha, b1 = 0.0f, b2 = -alpha;
+            a0 = 1.0f + alpha, a1 = -2.0f * cosw, a2 = 1.0f - alpha;
+            break;
+        case BiquadType::Notch:
+            b0 = 1.0f, b1 = -2.0f * cosw, b2 = 1.0f;
+            a0 = 1.0f + alpha, a1 = -2.0f * cosw, a2 = 1.0f - alpha;
+            break;
+        case BiquadType::Peak:
+            b0 = 1.0f + alpha * a, b1 = -2.0f * cosw, b2 = 1.0f - alpha * a;
+            a0 = 1.0f + alpha / a, a1 = -2.0f * cosw, a2 = 1.0f - alpha / a;
+            break;
+        case BiquadType::LowShelf:
+            b0 = a * ((a + 1.0f) - (a - 1.0f) * cosw + sq);
+            b1 = 2.0f * a * ((a - 1.0f) - (a + 1.0f) * cosw);
+            b2 = a * ((a + 1.0f) - (a - 1.0f) * cosw - sq);
+            a0 = (a + 1.0f) + (a - 1.0f) * cosw + sq;
+            a1 = -2.0f * ((a - 1.0f) + (a + 1.0f) * cosw);
+            a2 = (a + 1.0f) + (a - 1.0f) * cosw - sq;
+            break;
+        case BiquadType::HighShelf:
+            b0 = a * ((a + 1.0f) + (a - 1.0f) * cosw + sq);
+            b1 = -2.0f * a * ((a - 1.0f) + (a + 1.0f) * cosw);
+            b2 = a * ((a + 1.0f) + (a - 1.0f) * cosw - sq);
+            a0 = (a + 1.0f) - (a - 1.0f) * cosw + sq;
+            a1 = 2.0f * ((a - 1.0f) - (a + 1.0f) * cosw);
+            a2 = (a + 1.0f) - (a - 1.0f) * cosw - sq;
+            break;
+    }
+
+    const float inv = 1.0f / a0;
+    _b0 = b0 * inv, _b1 = b1 * inv, _b2 = b2 * inv;
+    _a1 = a1 * inv, _a2 = a2 * inv;
+}
+
+void Biquad::_process(float *samples, uint32_t frameCount, uint32_t channels) {
+    if (_dirty.exchange(false, std::memory_order_acquire))
+        _updateCoefficients();
+    if (_resetPending.exchange(false, std::memory_order_acquire)) {
+        _z1.fill(0.0f);
+        _z2.fill(0.0f);
+    }
+
+    const Simd::Float4 b0 = Simd::Set1(_b0), b1 = Simd::Set1(_b1), b2 = Simd::Set1(_b2);
+    const Simd::Float4 a1 = Simd::Set1(_a1), a2 = Simd::Set1(_a2);
+
+    // Transposed direct form II, one channel per lane. The recursion runs across frames, so
+    // the parallelism is across channels (4 per vector).
+    for (uint32_t group = 0; group < channels; group += Simd::Width) {
+        const uint32_t lanes = std::min<uint32_t>(Simd::Width, channels - group);
+        Simd::Float4   z1    = Simd::Load(_z1.data() + group);
+        Simd::Float4   z2    = Simd::Load(_z2.data() + group);
+
+        float *frame = samples + group;
+        for (uint32_t f = 0; f < frameCount; ++f, frame += channels) {
+            const Simd::Float4 x = loadLanes(frame, lanes);
+            const Simd::Float4 y = Simd::MulAdd(b0, x, z1);
+            z1                   = Simd::Sub(Simd::MulAdd(b1, x, z2), Simd::Mul(a1, y));
+            z2                   = Simd::Sub(Simd::Mul(b2, x), Simd::Mul(a2, y));
+            storeLanes(frame, y, lanes);
+        }
+
+        Simd::Store(_z1.data() + group, z1);
+        Simd::Store(_z2.data() + group, z2);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Compressor / Limiter
+// ═══════════════════════════════════════════════════════════════════
+
+Compressor::Compressor(float thresholdDb, float ratio, float attackMs, float releaseMs,
+    float kneeDb, float makeupDb, float sampleRate)
+    : _thresholdDb(thresholdDb), _ratio(ratio), _attackMs(attackMs), _releaseMs(releaseMs),
+      _kneeDb(kneeDb), _makeupDb(makeupDb), _sampleRate(sampleRate) { }
+
+void Compressor::SetThreshold(float db) {
+    _thresholdDb.store(db, std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Compressor::SetRatio(float ratio) {
+    _ratio.store(std::max(ratio, 1.0f), std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Compressor::SetAttack(float ms) {
+    _attackMs.store(std::max(ms, 0.01f), std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Compressor::SetRelease(float ms) {
+    _releaseMs.store(std::max(ms, 0.01f), std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Compressor::SetKnee(float db) {
+    _kneeDb.store(std::max(db, 0.0f), std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+void Compressor::SetMakeupGain(float db) {
+    _makeupDb.store(db, std::memory_order_relaxed);
+    _dirty.store(true, std::memory_order_release);
+}
+
+float Compressor::_computeGainDb(float levelDb) const {
+    const float over = levelDb - _thr;
+    if (_knee > 0.0f && 2.0f * std::fabs(over) <= _knee) {
+        const float x = over + _knee * 0.5f;
+        return -_slope * x * x / (2.0f * _knee);
+    }
+    return over <= 0.0f ? 0.0f : -_slope * over;
+}
+
+void Compressor::_process(float *samples, uint32_t frameCount, uint32_t channels) {
+    if (_dirty.exchange(false, std::memory_order_acquire)) {
+        const auto timeCoef = [this](float ms) {
+            return std::exp(-1.0f / (std::max(ms, 0.01f) * 0.001f * _sampleRate));
+        };
+        _thr         = _thresholdDb.load(std::memory_order_relaxed);
+        _slope       = 1.0f - 1.0f / std::max(_ratio.load(std::memory_order_relaxed), 1.0f);
+        _knee        = _kneeDb.load(std::memory_order_relaxed);
+        _makeup      = _makeupDb.load(std::memory_order_relaxed);
+        _attackCoef  = timeCoef(_attackMs.load(std::memory_order_relaxed));
+        _releaseCoef = timeCoef(_releaseMs.load(std::memory_order_relaxed));
+    }
+
+    alignas(16) float scratch[CONTROL_BLOCK * MAX_CHANNELS];
+    float             maxReduction = 0.0f;
+
+    for (uint32_t start = 0; start < frameCount; start += CONTROL_BLOCK) {
+        const uint32_t frames = std::min(CONTROL_BLOCK, frameCount - start);
+        const uint32_t count  = frames * channels;
+        float         *block  = samples + start * channels;
+
+        // |x| for the whole control block in one vector pass
+        uint32_t i = 0;
+        for (; i + Simd::Width <= count; i += Simd::Width)
+            Simd::Store(scratch + i, Simd::Abs(Simd::Load(block + i)));
+        for (; i < count; ++i)
+            scratch[i] = std::fabs(block[i]);
+
+        // Stereo-linked peak detector with separate attack/release ballistics
+        float blockPeak = 0.0f;
+        for (uint32_t f = 0; f < frames; ++f) {
+            float peak = 0.0f;
+            for (uint32_t c = 0; c < channels; ++c)
+                peak = std::max(peak, scratch[f * channels + c]);
+            const float coef = peak > _envelope ? _attackCoef : _releaseCoef;
+            _envelope        = coef * _envelope + (1.0f - coef) * peak;
+            blockPeak        = std::max(blockPeak, _envelope);
+        }
+
+        // Gain computer once per control block, ramped linearly across it
+        const float reductionDb = _computeGainDb(linearToDb(blockPeak));
+        const float targetGain  = dbToLinear(reductionDb + _makeup);
+        const float step        = (targetGain - _currentGain) / static_cast<float>(frames);
+        maxReduction            = std::max(maxReduction, -reductionDb);
+
+        for (uint32_t f = 0; f < frames; ++f) {
+            const float g = _currentGain + step * static_cast<float>(f + 1);
+            for (uint32_t c = 0; c < channels; ++c)
+                scratch[f * channels + c] = g;
+        }
+        _currentGain = targetGain;
+
+        i = 0;
+        for (; i + Simd::Width <= count; i += Simd::Width)
+            Simd::Store(block + i, Simd::Mul(Simd::Load(block + i), Simd::Load(scratch + i)));
+        for (; i < count; ++i)
+            block[i] *= scratch[i];
+
+        _postGain(block, count);
+    }
+
+    _meterReductionDb.store(maxReduction, std::memory_order_relaxed);
+}
+
+Limiter::Limiter(float ceilingDb, float releaseMs, float sampleRate)
+    : Compressor(ceilingDb, 1000.0f, 0.5f, releaseMs, 0.0f, 0.0f, sampleRate),
+      _ceilingLinear(dbToLinear(ceilingDb)) { }
+
+void Limiter::SetCeiling(float db) {
+    SetThreshold(db);
+    _ceilingLinear.store(dbToLinear(db), std::memory_order_relaxed);
+}
+
+void Limiter::_postGain(float *samples, uint32_t sampleCount) {
+    const float        ceiling = _ceilingLinear.load(std::memory_order_relaxed);
+    const Simd::Float4 hi = Simd::Set1(ceiling), lo = Simd::Set1(-ceiling);
+
+    uint32_t i = 0;
+    for (; i + Simd::Width <= sampleCount; i += Simd::Width)
+        Simd::Store(samples + i, Simd::Clamp(Simd::Load(samples + i), lo, hi));
+    for (; i < sampleCount; ++i)
+        samples[i] = std::clamp(samples[i], -ceiling, ceiling);
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// FFT (real, radix-2, split re/im arrays)
+// ═══════════════════════════════════════════════════════════════════
+
+// A real FFT of size N is done as a complex FFT of size M = N/2 on the even/odd-packed input,
+// plus one post-processing pass. Everything is split-complex (separate re/im arrays) so the
+// butterflies and the spectral multiply-add vectorize without shuffles.
+struct ConvolutionReverb::Fft {
+    uint32_t              n;                   ///< Real transform size
+    uint32_t              m;                   ///< Complex transform size (n / 2)
+    std::vector<uint32_t> bitReverse;          ///< m entries
+    std::vector<float>    stageRe, stageIm;    ///< Per-stage twiddles, stored contiguously (m - 1 total)
+    std::vector<float>    postRe, postIm;      ///< e^{-2πik/n}, k = 0..m
+    std::vector<float>    workRe, workIm;      ///< m-point scratch
+
+    explicit Fft(uint32_t size)
+        : n(size), m(size / 2) {
+        uint32_t bits = 0;
+        while ((1u << bits) < m)
+            ++bits;
+        bitReverse.resize(m);
+        for (uint32_t i = 0; i < m; ++i) {
+            uint32_t r = 0;
+            for (uint32_t b = 0; b < bits; ++b)
+                r |= ((i >> b) & 1u) << (bits - 1 - b);
+            bitReverse[i] = r;
+        }
+
+        for (uint32_t len = 2; len <= m; len <<= 1) {
+            for (uint32_t k = 0; k < len / 2; ++k) {
+                const double a = -2.0 * 3.14159265358979323846 * k / len;
+                stageRe.push_back(static_cast<float>(std::cos(a)));
+                stageIm.push_back(static_cast<float>(std::sin(a)));
+            }
+        }
+
+        postRe.resize(m + 1);
+        postIm.resize(m + 1);
+        for (uint32_t k = 0; k <= m; ++k) {
+            const double a = -2.0 * 3.14159265358979323846 * k / n;
+            postRe[k]      = static_cast<float>(std::cos(a));
+            postIm[k]      = static_cast<float>(std::sin(a));
+        }
+
+        workRe.resize(m);
+        workIm.resize(m);
+    }
+
+    /// In-place forward complex FFT of workRe/workIm (input already in bit-reversed order).
+    void complexForward() {
+        float   *re = workRe.data(), *im = workIm.data();
+        uint32_t tw = 0;
+        for (uint32_t len = 2; len <= m; len <<= 1) {
+            const uint32_t half = len / 2;
+            const float   *wr = stageRe.data() + tw, *wi = stageIm.data() + tw;
+            for (uint32_t start = 0; start < m; start += len) {
+                float   *ar = re + start, *ai = im + start;
+                float   *br = ar + half, *bi = ai + half;
+                uint32_t k  = 0;
+                for (; k + Simd::Width <= half; k += Simd::Width) {
+                    const Simd::Float4 xr = Simd::Load(br + k), xi = Simd::Load(bi + k);
+                    const Simd::Float4 cr = Simd::Load(wr + k), ci = Simd::Load(wi + k);
+                    const Simd::Float4 tr = Simd::Sub(Simd::Mul(xr, cr), Simd::Mul(xi, ci));
+                    const Simd::Float4 ti = Simd::MulAdd(xr, ci, Simd::Mul(xi, cr));
+                    const Simd::Float4 ur = Simd::Load(ar + k), ui = Simd::Load(ai + k);
+                    Simd::Store(br + k, Simd::Sub(ur, tr));
+                    Simd::Store(bi + k, Simd::Sub(ui, ti));
+                    Simd::Store(ar + k, Simd::Add(ur, tr));
+                    Simd::Store(ai + k, Simd::Add(ui, ti));
+                }
+                for (; k < half; ++k) {
+                    const float tr = br[k] * wr[k] - bi[k] * wi[k];
+                    const float ti = br[k] * wi[k] + bi[k] * wr[k];
+                    br[k]          = ar[k] - tr;
+                    bi[k]          = ai[k] - ti;
+                    ar[k] += tr;
+                    ai[k] += ti;
+                }
+            }
+            tw += half;
+        }
+    }
+
+    /// Real input x[n] → spectrum bins 0..m (m + 1 split-complex values).
+    void forward(const float *x, float *outRe, float *outIm) {
+        for (uint32_t i = 0; i < m; ++i) {
+            const uint32_t r = bitReverse[i];
+            workRe[r]        = x[2 * i];
+            workIm[r]        = x[2 * i + 1];
+        }
+        complexForward();
+
+        for (uint32_t k = 0; k <= m; ++k) {
+            const uint32_t a = k % m, b = (m - k) % m;
+            const float    zr = workRe[a], zi = workIm[a];
+            const float    cr = workRe[b], ci = -workIm[b]; // conj(Z[m - k])
+            const float    er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+            // O = (Z - conj(Z[m-k])) / 2i
+            const float or_ = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);
+            outRe[k]        = er + postRe[k] * or_ - postIm[k] * oi;
+            outIm[k]        = ei + postRe[k] * oi + postIm[k] * or_;
+        }
+    }
+
+    /// Spectrum bins 0..m → real output x[n], including the 1/n scale.
+    void inverse(const float *inRe, const float *inIm, float *x) {
+        // Rebuild the packed m-point spectrum Z = E + iO, conjugated so the forward kernel
+        // computes the inverse (conj(FFT(conj(Z))) = m * IFFT(Z)).
+        for (uint32_t k = 0; k < m; ++k) {
+            const float xr = inRe[k], xi = inIm[k];
+            const float cr = inRe[m - k], ci = -inIm[m - k]; // conj(X[m - k])
+            const float er = 0.5f * (xr + cr), ei = 0.5f * (xi + ci);
+            const float dr = 0.5f * (xr - cr), di = 0.5f * (xi - ci);
+            // O = D * e^{+2πik/n}
+            const float or_ = dr * postRe[k] + di * postIm[k];
+            const float oi  = di * postRe[k] - dr * postIm[k];
+            const uint32_t r = bitReverse[k];
+            workRe[r]        = er - oi;     // Re(E + iO)
+            workIm[r]        = -(ei + or_); // -Im(E + iO)
+        }
+        complexForward();
+
+        const float scale = 1.0f / static_cast<float>(m);
+        for (uint32_t i = 0; i < m; ++i) {
+            x[2 * i]     = workRe[i] * scale;
+            x[2 * i + 1] = -workIm[i] * scale;
+        }
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════
+// ConvolutionReverb
+// ═══════════════════════════════════════════════════════════════════
+
+/// acc += x * h over split-complex arrays (the hot loop: partitions × bins per block).
+static void complexMultiplyAdd(float *accRe, float *accIm, const float *xRe, const float *xIm,
+    const float *hRe, const float *hIm, uint32_t count) {
+    uint32_t i = 0;
+#if defined(LUMI_SIMD_AVX)
+    for (; i + 8 <= count; i += 8) {
+        const __m256 xr = _mm256_loadu_ps(xRe + i), xi = _mm256_loadu_ps(xIm + i);
+        const __m256 hr = _mm256_loadu_ps(hRe + i), hi = _mm256_loadu_ps(hIm + i);
+        __m256       ar = _mm256_loadu_ps(accRe + i), ai = _mm256_loadu_ps(accIm + i);
+        ar              = _mm256_add_ps(ar, _mm256_sub_ps(_mm256_mul_ps(xr, hr), _mm256_mul_ps(xi, hi)));
+        ai              = _mm256_add_ps(ai, _mm256_add_ps(_mm256_mul_ps(xr, hi), _mm256_mul_ps(xi, hr)));
+        _mm256_storeu_ps(accRe + i, ar);
+        _mm256_storeu_ps(accIm + i, ai);
+    }
+#endif
+    for (; i + Simd::Width <= count; i += Simd::Width) {
+        const Simd::Float4 xr = Simd::Load(xRe + i), xi = Simd::Load(xIm + i);
+        const Simd::Float4 hr = Simd::Load(hRe + i), hi = Simd::Load(hIm + i);
+        const Simd::Float4 ar = Simd::Add(Simd::Load(accRe + i), Simd::Sub(Simd::Mul(xr, hr), Simd::Mul(xi, hi)));
+        const Simd::Float4 ai = Simd::Add(Simd::Load(accIm + i), Simd::MulAdd(xr, hi, Simd::Mul(xi, hr)));
+        Simd::Store(accRe + i, ar);
+        Simd::Store(accIm + i, ai);
+    }
+    for (; i < count; ++i) {
+        accRe[i] += xRe[i] * hRe[i] - xIm[i] * hIm[i];
+        accIm[i] += xRe[i] * hIm[i] + xIm[i] * hRe[i];
+    }
+}
+
+ConvolutionReverb::ConvolutionReverb(uint32_t partitionSize) {
+    uint32_t b = 16;
+    while (b < partitionSize && b < 8192)
+        b <<= 1;
+    _blockSize = b;
+    _bins      = b + 1;
+    _fft       = new Fft(2 * b);
+
+    _scratchRe.resize(_bins);
+    _scratchIm.resize(_bins);
+    _scratchTime.resize(2 * b);
+}
+
+ConvolutionReverb::~ConvolutionReverb() {
+    delete _fft;
+}
+
+void ConvolutionReverb::SetImpulseResponse(const float *samples, uint32_t irFrames, uint32_t irChannels, bool normalize) {
+    _ready.store(false, std::memory_order_release);
+
+    if (!samples || irFrames == 0 || irChannels == 0 || irChannels > MAX_CHANNELS)
+        return;
+
+    const uint32_t b = _blockSize;
+    _irChannels      = irChannels;
+    _partitions      = (irFrames + b - 1) / b;
+
+    float scale = 1.0f;
+    if (normalize) {
+        float maxEnergy = 0.0f;
+        for (uint32_t c = 0; c < irChannels; ++c) {
+            double energy = 0.0;
+            for (uint32_t f = 0; f < irFrames; ++f)
+                energy += double(samples[f * irChannels + c]) * samples[f * irChannels + c];
+            maxEnergy = std::max(maxEnergy, static_cast<float>(std::sqrt(energy)));
+        }
+        if (maxEnergy > 0.0f)
+            scale = 1.0f / maxEnergy;
+    }
+
+    const size_t spectrumSize = size_t(irChannels) * _partitions * _bins;
+    _irRe.assign(spectrumSize, 0.0f);
+    _irIm.assign(spectrumSize, 0.0f);
+
+    // Each partition is zero-padded to 2B and transformed once
+    for (uint32_t c = 0; c < irChannels; ++c) {
+        for (uint32_t p = 0; p < _partitions; ++p) {
+            std::fill(_scratchTime.begin(), _scratchTime.end(), 0.0f);
+            for (uint32_t i = 0; i < b; ++i) {
+                const uint32_t f = p * b + i;
+                if (f >= irFrames)
+                    break;
+                _scratchTime[i] = samples[f * irChannels + c] * scale;
+            }
+            const size_t offset = (size_t(c) * _partitions + p) * _bins;
+            _fft->forward(_scratchTime.data(), _irRe.data() + offset, _irIm.data() + offset);
+        }
+    }
+
+    for (auto &ch : _channels) {
+        ch.history.assign(2 * b, 0.0f);
+        ch.fdlRe.assign(size_t(_partitions) * _bins, 0.0f);
+        ch.fdlIm.assign(size_t(_partitions) * _bins, 0.0f);
+        ch.output.assign(b, 0.0f);
+    }
+    _fifoPos = 0;
+    _fdlPos  = 0;
+
+    _ready.store(true, std::memory_order_release);
+}
+
+void ConvolutionReverb::_processBlock(uint32_t channel, uint32_t irChannel) {
+    auto          &ch = _channels[channel];
+    const uint32_t b  = _blockSize;
+
+    // Newest input spectrum goes into the FDL slot for this block
+    float *slotRe = ch.fdlRe.data() + size_t(_fdlPos) * _bins;
+    float *slotIm = ch.fdlIm.data() + size_t(_fdlPos) * _bins;
+    _fft->forward(ch.history.data(), slotRe, slotIm);
+
+    // Y = Σ X[block - p] · H[p]
+    std::fill(_scratchRe.begin(), _scratchRe.end(), 0.0f);
+    std::fill(_scratchIm.begin(), _scratchIm.end(), 0.0f);
+    const float *irRe = _irRe.data() + size_t(irChannel) * _partitions * _bins;
+    const float *irIm = _irIm.data() + size_t(irChannel) * _partitions * _bins;
+    for (uint32_t p = 0; p < _partitions; ++p) {
+        const uint32_t slot = (_fdlPos + _partitions - p) % _partitions;
+        complexMultiplyAdd(_scratchRe.data(), _scratchIm.data(),
+            ch.fdlRe.data() + size_t(slot) * _bins, ch.fdlIm.data() + size_t(slot) * _bins,
+            irRe + size_t(p) * _bins, irIm + size_t(p) * _bins, _bins);
+    }
+
+    // Overlap-save: the first half of the inverse is circular-wrap garbage, keep the second
+    _fft->inverse(_scratchRe.data(), _scratchIm.data(), _scratchTime.data());
+    std::memcpy(ch.output.data(), _scratchTime.data() + b, b * sizeof(float));
+
+    // Slide the input window by one block
+    std::memcpy(ch.history.data(), ch.history.data() + b, b * sizeof(float));
+}
+
+void ConvolutionReverb::_process(float *samples, uint32_t frameCount, uint32_t channels) {
+    if (!_ready.load(std::memory_order_acquire))
+        return;
+
+    const float    wet = _wet.load(std::memory_order_relaxed);
+    const float    dry = _dry.load(std::memory_order_relaxed);
+    const uint32_t b   = _blockSize;
+
+    uint32_t done = 0;
+    while (done < frameCount) {
+        const uint32_t run   = std::min(b - _fifoPos, frameCount - done);
+        float         *frame = samples + size_t(done) * channels;
+
+        // Feed the input window and emit the previous block's wet output (B frames of latency)
+        for (uint32_t c = 0; c < channels; ++c) {
+            float       *history = _channels[c].history.data() + b + _fifoPos;
+            const float *wetOut  = _channels[c].output.data() + _fifoPos;
+            for (uint32_t f = 0; f < run; ++f) {
+                float &s   = frame[f * channels + c];
+                history[f] = s;
+                s          = s * dry + wetOut[f] * wet;
+            }
+        }
+
+        _fifoPos += run;
+        done += run;
+
+        if (_fifoPos == b) {
+            _fdlPos = (_fdlPos + 1) % _partitions;
+            for (uint32_t c = 0; c < channels; ++c)
+                _processBlock(c, c % _irChannels);
+            _fifoPos = 0;
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Delay
+// ═══════════════════════════════════════════════════════════════════
+
+Delay::Delay(float maxDelaySeconds, float sampleRate)
+    : _sampleRate(sampleRate) {
+    _maxFrames = std::max<uint32_t>(2, static_cast<uint32_t>(std::ceil(maxDelaySeconds * sampleRate)) + 1);
+    _line.assign(size_t(_maxFrames) * MAX_CHANNELS, 0.0f);
+}
+
+void Delay::SetTime(float seconds) {
+    _timeSeconds.store(std::max(seconds, 0.0f), std::memory_order_relaxed);
+}
+
+void Delay::SetFeedback(float gain) {
+    _feedback.store(std::clamp(gain, 0.0f, 0.98f), std::memory_order_relaxed);
+}
+
+void Delay::SetMix(float wet) {
+    _mix.store(std::clamp(wet, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void Delay::_process(float *samples, uint32_t frameCount, uint32_t channels) {
+    if (channels != _lineChannels) {
+        std::fill(_line.begin(), _line.end(), 0.0f);
+        _writePos     = 0;
+        _lineChannels = channels;
+    }
+
+    const uint32_t delayFrames = std::clamp<uint32_t>(
+        static_cast<uint32_t>(_timeSeconds.load(std::memory_order_relaxed) * _sampleRate + 0.5f), 1, _maxFrames - 1);
+    const float feedback = _feedback.load(std::memory_order_relaxed);
+    const float mix      = _mix.load(std::memory_order_relaxed);
+
+    const Simd::Float4 fb = Simd::Set1(feedback), wet = Simd::Set1(mix), dry = Simd::Set1(1.0f - mix);
+
+    // Work in runs that touch neither ring edge and are no longer than the delay itself: then the
+    // read and write windows can't overlap, every sample in the run is independent, and the run is
+    // a flat interleaved span we can stream through 4 lanes at a time.
+    uint32_t done = 0;
+    while (done < frameCount) {
+        const uint32_t readPos = (_writePos + _maxFrames - delayFrames) % _maxFrames;
+        const uint32_t run     = std::min({ frameCount - done, _maxFrames - _writePos, _maxFrames - readPos, delayFrames });
+
+        float         *io    = samples + size_t(done) * channels;
+        float         *write = _line.data() + size_t(_writePos) * channels;
+        const float   *read  = _line.data() + size_t(readPos) * channels;
+        const uint32_t count = run * channels;
+
+        uint32_t i = 0;
+        for (; i + Simd::Width <= count; i += Simd::Width) {
+            const Simd::Float4 x = Simd::Load(io + i);
+            const Simd::Float4 d = Simd::Load(read + i);
+            Simd::Store(write + i, Simd::MulAdd(d, fb, x));
+            Simd::Store(io + i, Simd::MulAdd(d, wet, Simd::Mul(x, dry)));
+        }
+        for (; i < count; ++i) {
+            const float x = io[i], d = read[i];
+            write[i]      = x + d * feedback;
+            io[i]         = x * (1.0f - mix) + d * mix;
+        }
+
+        _writePos = (_writePos + run) % _maxFrames;
+        done += run;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Bitcrusher
+// ═══════════════════════════════════════════════════════════════════
+
+Bitcrusher::Bitcrusher(float bits, uint32_t downsample)
+    : _bits(std::clamp(bits, 1.0f, 24.0f)), _downsample(std::max(downsample, 1u)) { }
+
+void Bitcrusher::SetBits(float bits) {
+    _bits.store(std::clamp(bits, 1.0f, 24.0f), std::memory_order_relaxed);
+}
+
+void Bitcrusher::SetDownsample(uint32_t factor) {
+    _downsample.store(std::clamp(factor, 1u, 256u), std::memory_order_relaxed);
+}
+
+void Bitcrusher::_process(float *samples, uint32_t frameCount, uint32_t channels) {
+    const float    levels     = std::exp2(_bits.load(std::memory_order_relaxed)) * 0.5f;
+    const float    invLevels  = 1.0f / levels;
+    const uint32_t downsample = _downsample.load(std::memory_order_relaxed);
+
+    if (downsample <= 1) {
+        const Simd::Float4 up = Simd::Set1(levels), down = Simd::Set1(invLevels);
+        const uint32_t     count = frameCount * channels;
+        uint32_t           i     = 0;
+        for (; i + Simd::Width <= count; i += Simd::Width)
+            Simd::Store(samples + i, Simd::Mul(Simd::Round(Simd::Mul(Simd::Load(samples + i), up)), down));
+        for (; i < count; ++i)
+            samples[i] = std::nearbyint(samples[i] * levels) * invLevels;
+        return;
+    }
+
+    // Sample-and-hold: quantize on the first frame of each hold period, repeat it for the rest
+    for (uint32_t f = 0; f < frameCount; ++f) {
+        float *frame = samples + size_t(f) * channels;
+        if (_holdCounter == 0) {
+            for (uint32_t c = 0; c < channels; ++c)
+                _held[c] = std::nearbyint(frame[c] * levels) * invLevels;
+        }
+        std::memcpy(frame, _held.data(), channels * sizeof(float));
+        _holdCounter = (_holdCounter + 1) % downsample;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// EffectChain
+// ═══════════════════════════════════════════════════════════════════
+
+bool EffectChain::Add(Effect &effect) {
+    const uint32_t count = _count.load(std::memory_order_relaxed);
+    if (count >= MAX_EFFECTS)
+        return false;
+    _effects[count] = &effect;
+    _count.store(count + 1, std::memory_order_release);
+    return true;
+}
+
+void EffectChain::_process(float *samples, uint32_t frameCount, uint32_t channels) {
+    const uint32_t count = _count.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i)
+        _effects[i]->Process(samples, frameCount, channels);
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Resampler
+// ═══════════════════════════════════════════════════════════════════
+
+Resampler::Resampler(PCMGenerateCallback source, void *sourceUserData, uint32_t channels,
+    float sourceRate, float targetRate)
+    : _source(source), _sourceUserData(sourceUserData), _channels(std::clamp(channels, 1u, MAX_CHANNELS)),
+      _baseStep(double(sourceRate) / double(targetRate)) {
+    // Padded by one vector so the lane loads of the last frame never read past the end
+    _buffer.assign(size_t(HISTORY + SOURCE_CHUNK) * _channels + Simd::Width, 0.0f);
+    _available = HISTORY;
+    _position  = 1.0;
+}
+
+void Resampler::SetRatio(float speed) {
+    _ratio.store(std::clamp(speed, 0.125f, 8.0f), std::memory_order_relaxed);
+}
+
+void Resampler::_refill() {
+    // Keep the frames the 4-tap kernel still needs (from floor(pos) - 1), then append a chunk.
+    // A large step can put the read head past everything buffered; then nothing is kept and
+    // the caller loops until the head is covered again.
+    const uint32_t keepFrom = std::min(static_cast<uint32_t>(_position) - 1, _available);
+    const uint32_t kept     = _available - keepFrom;
+    std::memmove(_buffer.data(), _buffer.data() + size_t(keepFrom) * _channels, size_t(kept) * _channels * sizeof(float));
+    _position -= keepFrom;
+
+    float *dst = _buffer.data() + size_t(kept) * _channels;
+    if (_source)
+        _source(dst, SOURCE_CHUNK, _channels, _sourceUserData);
+    else
+        std::memset(dst, 0, size_t(SOURCE_CHUNK) * _channels * sizeof(float));
+    _available = kept + SOURCE_CHUNK;
+}
+
+void Resampler::Process(float *output, uint32_t frameCount, uint32_t channels) {
+    if (channels != _channels) {
+        std::memset(output, 0, size_t(frameCount) * channels * sizeof(float));
+        return;
+    }
+
+    const double step = _baseStep * _ratio.load(std::memory_order_relaxed);
+
+    for (uint32_t f = 0; f < frameCount; ++f) {
+        while (static_cast<uint32_t>(_position) + 2 >= _available)
+            _refill();
+
+        const uint32_t     i  = static_cast<uint32_t>(_position);
+        const Simd::Float4 t  = Simd::Set1(static_cast<float>(_position - i));
+        const float       *xm = _buffer.data() + size_t(i - 1) * _channels;
+
+        // Cubic Hermite (Catmull-Rom) over frames i-1..i+2, channels in lanes
+        for (uint32_t group = 0; group < _channels; group += Simd::Width) {
+            const uint32_t     lanes = std::min<uint32_t>(Simd::Width, _channels - group);
+            const Simd::Float4 x0    = Simd::Load(xm + group);
+            const Simd::Float4 x1    = Simd::Load(xm + _channels + group);
+            const Simd::Float4 x2    = Simd::Load(xm + 2 * _channels + group);
+            const Simd::Float4 x3    = Simd::Load(xm + 3 * _channels + group);
+
+            const Simd::Float4 half = Simd::Set1(0.5f);
+            const Simd::Float4 c1   = Simd::Mul(half, Simd::Sub(x2, x0));
+            const Simd::Float4 c2   = Simd::Sub(Simd::Add(Simd::Sub(x0, Simd::Mul(Simd::Set1(2.5f), x1)), Simd::Add(x2, x2)), Simd::Mul(half, x3));
+            const Simd::Float4 c3   = Simd::MulAdd(half, Simd::Sub(x3, x0), Simd::Mul(Simd::Set1(1.5f), Simd::Sub(x1, x2)));
+            const Simd::Float4 y    = Simd::MulAdd(Simd::MulAdd(Simd::MulAdd(c3, t, c2), t, c1), t, x1);
+
+            storeLanes(output + size_t(f) * _channels + group, y, lanes);
+        }
+
+        _position += step;
+    }
+}
+
+} // namespace Dsp
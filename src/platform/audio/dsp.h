@@ -0,0 +1,382 @@
+#pragma once
+
+// Built-in audio DSP blocks. Each one is a Dsp::Effect that plugs straight into a channel's
+// LumiEffectNode (or the master bus) through Audio::SetChannelEffect(channel, effect):
+//
+//   Dsp::Biquad             RBJ filter section (low/high/band-pass, notch, peak, shelves)
+//   Dsp::Compressor         feed-forward, stereo-linked, soft-knee compressor
+//   Dsp::Limiter            brickwall-ish limiter (compressor preset + ceiling clamp)
+//   Dsp::ConvolutionReverb  uniformly-partitioned FFT convolution with an impulse response
+//   Dsp::Delay              feedback delay line
+//   Dsp::Bitcrusher         bit-depth + sample-rate reduction
+//   Dsp::EffectChain        runs several effects in series on one insert slot (e.g. an EQ)
+//
+// Dsp::Resampler is the odd one out: it wraps a PCMGenerateCallback running at one rate and
+// feeds it to Audio::CreatePCMGenerator at another (or varispeed), so it's a generator.
+//
+// Threading: Process runs on the audio thread. Every Set* parameter is an atomic store, safe
+// from the game thread at any time; derived state (filter coefficients, time constants) is
+// recomputed on the audio thread at the next block. Anything that allocates (constructors,
+// ConvolutionReverb::SetImpulseResponse, EffectChain::Add) must happen before the effect is
+// attached, or after it's been removed.
+//
+// Inner loops are written against math/simd.h (SSE / NEON / scalar, with an AVX path in the
+// convolution's spectral multiply-add).
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "assets/audio/pcmsound.h"
+
+namespace Dsp {
+
+/// Most channels any effect will see (Audio clamps the device to 1..8).
+inline constexpr uint32_t MAX_CHANNELS = 8;
+
+/// Default processing rate — matches the device rate Audio::Init opens.
+inline constexpr float DEFAULT_SAMPLE_RATE = 48000.0f;
+
+/**
+ * @brief Base class for every built-in effect. Pass to Audio::SetChannelEffect.
+ */
+class Effect {
+public:
+    virtual ~Effect() = default;
+
+    /**
+     * @brief PCMEffectCallback trampoline. userData must be the Effect.
+     *
+     * Lets an effect be used anywhere a raw callback is expected:
+     * Audio::SetChannelEffect(ch, &Dsp::Effect::Callback, &myEffect).
+     */
+    static void Callback(float *samples, uint32_t frameCount, uint32_t channels, void *userData) {
+        static_cast<Effect *>(userData)->Process(samples, frameCount, channels);
+    }
+
+    /// @brief Processes interleaved float samples in-place. Audio thread.
+    void Process(float *samples, uint32_t frameCount, uint32_t channels) {
+        if (_bypass.load(std::memory_order_relaxed) || channels == 0 || channels > MAX_CHANNELS)
+            return;
+        _process(samples, frameCount, channels);
+    }
+
+    /// @brief Bypassed effects leave the buffer untouched (state is kept, not reset).
+    void SetBypass(bool bypass) { _bypass.store(bypass, std::memory_order_relaxed); }
+    bool IsBypassed() const { return _bypass.load(std::memory_order_relaxed); }
+
+protected:
+    virtual void _process(float *samples, uint32_t frameCount, uint32_t channels) = 0;
+
+private:
+    std::atomic<bool> _bypass { false };
+};
+
+// ── Biquad ──────────────────────────────────────────────────────────────────
+
+/// @brief Filter shapes from the RBJ Audio-EQ cookbook.
+enum class BiquadType : uint8_t {
+    LowPass,
+    HighPass,
+    BandPass, ///< Constant 0 dB peak gain
+    Notch,
+    Peak,     ///< Uses gainDb
+    LowShelf, ///< Uses gainDb
+    HighShelf ///< Uses gainDb
+};
+
+/**
+ * @brief One second-order filter section, applied to every channel.
+ *
+ * Channels are processed in SIMD lanes (transposed direct form II). Chain several in an
+ * EffectChain for a multi-band EQ.
+ */
+class Biquad : public Effect {
+public:
+    explicit Biquad(BiquadType type = BiquadType::LowPass, float frequency = 1000.0f, float q = 0.7071f,
+        float gainDb = 0.0f, float sampleRate = DEFAULT_SAMPLE_RATE);
+
+    void SetType(BiquadType type);
+    void SetFrequency(float hz);
+    void SetQ(float q);
+    void SetGain(float gainDb);
+
+    /// @brief Clears the filter memory (next block starts from silence).
+    void Reset() { _resetPending.store(true, std::memory_order_release); }
+
+protected:
+    void _process(float *samples, uint32_t frameCount, uint32_t channels) override;
+
+private:
+    void _updateCoefficients();
+
+    std::atomic<BiquadType> _type;
+    std::atomic<float>      _frequency;
+    std::atomic<float>      _q;
+    std::atomic<float>      _gainDb;
+    std::atomic<bool>       _dirty { true };
+    std::atomic<bool>       _resetPending { false };
+    float                   _sampleRate;
+
+    // Audio-thread state
+    float                                _b0 = 1.0f, _b1 = 0.0f, _b2 = 0.0f, _a1 = 0.0f, _a2 = 0.0f;
+    alignas(16) std::array<float, MAX_CHANNELS> _z1 {};
+    alignas(16) std::array<float, MAX_CHANNELS> _z2 {};
+};
+
+// ── Dynamics ────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Feed-forward compressor with a stereo-linked peak detector and soft knee.
+ *
+ * The gain computer runs at control rate (every 16 frames) and the gain is ramped linearly
+ * between control points, so the per-sample work is a vectorized multiply.
+ */
+class Compressor : public Effect {
+public:
+    explicit Compressor(float thresholdDb = -18.0f, float ratio = 4.0f, float attackMs = 10.0f,
+        float releaseMs = 100.0f, float kneeDb = 6.0f, float makeupDb = 0.0f,
+        float sampleRate = DEFAULT_SAMPLE_RATE);
+
+    void SetThreshold(float db);
+    void SetRatio(float ratio); ///< >= 1; use a very large value (or Limiter) for limiting
+    void SetAttack(float ms);
+    void SetRelease(float ms);
+    void SetKnee(float db);
+    void SetMakeupGain(float db);
+
+    /// @brief Current gain reduction in dB (>= 0). Safe to poll from the game thread for meters.
+    float GetGainReduction() const { return _meterReductionDb.load(std::memory_order_relaxed); }
+
+protected:
+    void _process(float *samples, uint32_t frameCount, uint32_t channels) override;
+
+    /// Post-gain hook for subclasses (the limiter clamps here). Called per control block.
+    virtual void _postGain(float * /*samples*/, uint32_t /*sampleCount*/) { }
+
+private:
+    static constexpr uint32_t CONTROL_BLOCK = 16;
+
+    float _computeGainDb(float levelDb) const;
+
+    std::atomic<float> _thresholdDb;
+    std::atomic<float> _ratio;
+    std::atomic<float> _attackMs;
+    std::atomic<float> _releaseMs;
+    std::atomic<float> _kneeDb;
+    std::atomic<float> _makeupDb;
+    std::atomic<bool>  _dirty { true };
+    std::atomic<float> _meterReductionDb { 0.0f };
+    float              _sampleRate;
+
+    // Audio-thread state (cached parameters + detector)
+    float _thr = 0.0f, _slope = 0.0f, _knee = 0.0f, _makeup = 0.0f;
+    float _attackCoef = 0.0f, _releaseCoef = 0.0f;
+    float _envelope    = 0.0f;
+    float _currentGain = 1.0f;
+};
+
+/**
+ * @brief Limiter: an infinite-ratio, fast-attack compressor followed by a hard ceiling clamp.
+ *
+ * There's no look-ahead, so the clamp catches the few samples the detector reacts to late.
+ */
+class Limiter : public Compressor {
+public:
+    explicit Limiter(float ceilingDb = -0.3f, float releaseMs = 50.0f, float sampleRate = DEFAULT_SAMPLE_RATE);
+
+    void SetCeiling(float db);
+
+protected:
+    void _postGain(float *samples, uint32_t sampleCount) override;
+
+private:
+    std::atomic<float> _ceilingLinear;
+};
+
+// ── Convolution ─────────────────────────────────────────────────────────────
+
+/**
+ * @brief Convolution reverb using uniformly-partitioned overlap-save FFT convolution.
+ *
+ * The impulse response is split into partitions of partitionSize frames, each transformed once
+ * up front; each block of input costs one FFT, one spectral multiply-add per partition and one
+ * inverse FFT, independent of IR length otherwise. Adds partitionSize frames of latency to the
+ * wet signal.
+ */
+class ConvolutionReverb : public Effect {
+public:
+    explicit ConvolutionReverb(uint32_t partitionSize = 256);
+    ~ConvolutionReverb() override;
+
+    /**
+     * @brief Loads an impulse response (interleaved floats). Allocates — not real-time safe.
+     *
+     * Output channel c convolves with IR channel (c % irChannels), so a mono IR serves any layout.
+     *
+     * @param samples    Interleaved IR samples (irFrames * irChannels floats).
+     * @param irFrames   IR length in frames.
+     * @param irChannels IR channel count (1..MAX_CHANNELS).
+     * @param normalize  Scales the IR so its loudest channel has unit energy.
+     */
+    void SetImpulseResponse(const float *samples, uint32_t irFrames, uint32_t irChannels, bool normalize = true);
+
+    void SetWet(float gain) { _wet.store(gain, std::memory_order_relaxed); }
+    void SetDry(float gain) { _dry.store(gain, std::memory_order_relaxed); }
+
+    uint32_t GetLatencyFrames() const { return _blockSize; }
+
+protected:
+    void _process(float *samples, uint32_t frameCount, uint32_t channels) override;
+
+private:
+    /// @cond INTERNAL
+    struct Fft; // radix-2 real FFT plan (twiddles + bit reversal), defined in dsp.cpp
+
+    struct ChannelState {
+        std::vector<float> history;   ///< Last 2*B input samples (overlap-save frame)
+        std::vector<float> fdlRe;     ///< Frequency-domain delay line, P slots of (B+1) bins
+        std::vector<float> fdlIm;
+        std::vector<float> output;    ///< Last computed B wet samples
+    };
+    /// @endcond
+
+    void _processBlock(uint32_t channel, uint32_t irChannel);
+
+    uint32_t _blockSize;
+    uint32_t _bins;           ///< B + 1
+    uint32_t _partitions = 0; ///< P
+    uint32_t _irChannels = 0;
+    uint32_t _fifoPos    = 0; ///< Frames buffered into the current block (shared across channels)
+    uint32_t _fdlPos     = 0; ///< Newest FDL slot
+
+    Fft *_fft = nullptr;
+
+    std::vector<float>                         _irRe; ///< [irChannel][partition][bin]
+    std::vector<float>                         _irIm;
+    std::array<ChannelState, MAX_CHANNELS>     _channels;
+    std::vector<float>                         _scratchRe, _scratchIm, _scratchTime;
+
+    std::atomic<float> _wet { 0.35f };
+    std::atomic<float> _dry { 1.0f };
+    std::atomic<bool>  _ready { false };
+};
+
+// ── Delay / lo-fi ───────────────────────────────────────────────────────────
+
+/**
+ * @brief Feedback delay (echo). Independent line per channel, shared time/feedback/mix.
+ */
+class Delay : public Effect {
+public:
+    explicit Delay(float maxDelaySeconds = 2.0f, float sampleRate = DEFAULT_SAMPLE_RATE);
+
+    void SetTime(float seconds);  ///< Clamped to [1 frame, maxDelaySeconds]
+    void SetFeedback(float gain); ///< Clamped to [0, 0.98]
+    void SetMix(float wet);       ///< 0 = dry only, 1 = wet only
+
+protected:
+    void _process(float *samples, uint32_t frameCount, uint32_t channels) override;
+
+private:
+    std::atomic<float> _timeSeconds { 0.25f };
+    std::atomic<float> _feedback { 0.35f };
+    std::atomic<float> _mix { 0.3f };
+    float              _sampleRate;
+    uint32_t           _maxFrames;
+    uint32_t           _lineChannels = 0; ///< Layout the line was last used with; changes clear it
+    uint32_t           _writePos     = 0;
+    std::vector<float> _line;             ///< Interleaved, _maxFrames * MAX_CHANNELS
+    std::vector<float> _scratch;
+};
+
+/**
+ * @brief Bit-depth and sample-rate reduction.
+ */
+class Bitcrusher : public Effect {
+public:
+    explicit Bitcrusher(float bits = 8.0f, uint32_t downsample = 1);
+
+    void SetBits(float bits);            ///< 1..24, fractional values interpolate the step size
+    void SetDownsample(uint32_t factor); ///< Hold each sample for N frames (1 = off)
+
+protected:
+    void _process(float *samples, uint32_t frameCount, uint32_t channels) override;
+
+private:
+    std::atomic<float>    _bits;
+    std::atomic<uint32_t> _downsample;
+
+    std::array<float, MAX_CHANNELS> _held {};
+    uint32_t                        _holdCounter = 0;
+};
+
+// ── Chain ───────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Runs up to MAX_EFFECTS effects in series on one insert slot.
+ *
+ * Add() publishes with a release store, so appending while attached is safe; Clear() only
+ * stops new blocks from using the effects — keep them alive until the next block has run.
+ */
+class EffectChain : public Effect {
+public:
+    static constexpr uint32_t MAX_EFFECTS = 16;
+
+    /// @brief Appends an effect. Returns false if the chain is full. The chain does not own it.
+    bool Add(Effect &effect);
+    void Clear() { _count.store(0, std::memory_order_release); }
+
+    uint32_t GetCount() const { return _count.load(std::memory_order_acquire); }
+
+protected:
+    void _process(float *samples, uint32_t frameCount, uint32_t channels) override;
+
+private:
+    std::array<Effect *, MAX_EFFECTS> _effects {};
+    std::atomic<uint32_t>             _count { 0 };
+};
+
+// ── Resampling ──────────────────────────────────────────────────────────────
+
+/**
+ * @brief Sample-rate converter for generators (cubic Hermite interpolation).
+ *
+ * Pulls from an upstream PCMGenerateCallback at sourceRate and produces targetRate. Pass
+ * &Dsp::Resampler::Generate and the resampler itself to Audio::CreatePCMGenerator. SetRatio
+ * adds a live speed factor on top (varispeed / pitch-with-tempo), 1 = nominal.
+ */
+class Resampler {
+public:
+    Resampler(PCMGenerateCallback source, void *sourceUserData, uint32_t channels,
+        float sourceRate, float targetRate = DEFAULT_SAMPLE_RATE);
+
+    /// @brief PCMGenerateCallback trampoline. userData must be the Resampler.
+    static void Generate(float *output, uint32_t frameCount, uint32_t channels, void *userData) {
+        static_cast<Resampler *>(userData)->Process(output, frameCount, channels);
+    }
+
+    /// @brief Fills frameCount output frames. Audio thread.
+    void Process(float *output, uint32_t frameCount, uint32_t channels);
+
+    void SetRatio(float speed); ///< Clamped to [1/8, 8]
+
+private:
+    static constexpr uint32_t SOURCE_CHUNK = 256;
+    static constexpr uint32_t HISTORY      = 3; ///< Frames of look-behind kept for the 4-tap kernel
+
+    void _refill();
+
+    PCMGenerateCallback _source;
+    void               *_sourceUserData;
+    uint32_t            _channels;
+    double              _baseStep; ///< sourceRate / targetRate
+    std::atomic<float>  _ratio { 1.0f };
+
+    std::vector<float> _buffer;     ///< (HISTORY + SOURCE_CHUNK) interleaved frames
+    uint32_t           _available;  ///< Valid frames in _buffer
+    double             _position;   ///< Read head in frames, relative to _buffer[0]
+};
+
+} // namespace Dsp
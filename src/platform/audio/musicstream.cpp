@@ -0,0 +1,357 @@
+#include "musicstream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "core/log/log.h"
+
+// ═══════════════════════════════════════════════════════════════════
+// miniaudio data source vtable (audio thread + game thread queries)
+// ═══════════════════════════════════════════════════════════════════
+
+static ma_result musicStreamRead(ma_data_source *pDataSource, void *pFramesOut,
+    ma_uint64 frameCount, ma_uint64 *pFramesRead) {
+    auto        *stream     = reinterpret_cast<LumiMusicStream *>(pDataSource);
+    const size_t frameBytes = size_t(stream->channels) * sizeof(float);
+    auto        *out        = static_cast<uint8_t *>(pFramesOut);
+
+    // A seek is in flight: the ring still holds audio from the old position. Play silence
+    // until the stream thread has repositioned the decoder and marked where new data starts.
+    if (stream->pendingSeek.load(std::memory_order_acquire) != 0) {
+        memset(out, 0, size_t(frameCount) * frameBytes);
+        if (pFramesRead)
+            *pFramesRead = frameCount;
+        return MA_SUCCESS;
+    }
+
+    // Drop anything decoded before the last seek was applied
+    const uint64_t boundary = stream->seekBoundary.load(std::memory_order_acquire);
+    if (stream->readTotal < boundary) {
+        ma_uint32 skip = static_cast<ma_uint32>(std::min<uint64_t>(boundary - stream->readTotal,
+            ma_pcm_rb_available_read(&stream->ring)));
+        ma_pcm_rb_seek_read(&stream->ring, skip);
+        stream->readTotal += skip;
+        if (stream->readTotal < boundary) {
+            memset(out, 0, size_t(frameCount) * frameBytes);
+            if (pFramesRead)
+                *pFramesRead = frameCount;
+            return MA_SUCCESS;
+        }
+    }
+
+    ma_uint64 total = 0;
+    while (total < frameCount) {
+        ma_uint32 chunk = static_cast<ma_uint32>(std::min<ma_uint64>(frameCount - total, 0xFFFFFFFFu));
+        void     *src   = nullptr;
+        ma_pcm_rb_acquire_read(&stream->ring, &chunk, &src);
+        if (chunk == 0)
+            break;
+        memcpy(out + total * frameBytes, src, size_t(chunk) * frameBytes);
+        ma_pcm_rb_commit_read(&stream->ring, chunk);
+        total += chunk;
+    }
+    stream->readTotal += total;
+
+    const uint64_t length = stream->length.load(std::memory_order_relaxed);
+    uint64_t       cursor = stream->cursor.load(std::memory_order_relaxed) + total;
+    if (length > 0 && stream->looping.load(std::memory_order_relaxed))
+        cursor %= length;
+    stream->cursor.store(cursor, std::memory_order_relaxed);
+
+    if (total < frameCount) {
+        // Ring is dry. Either the track really ended, or the stream thread fell behind.
+        if (stream->decoderAtEnd.load(std::memory_order_acquire) && ma_pcm_rb_available_read(&stream->ring) == 0
+            && !stream->looping.load(std::memory_order_relaxed)) {
+            if (pFramesRead)
+                *pFramesRead = total;
+            return total == 0 ? MA_AT_END : MA_SUCCESS;
+        }
+        memset(out + total * frameBytes, 0, size_t(frameCount - total) * frameBytes);
+        stream->underruns.fetch_add(1, std::memory_order_relaxed);
+        total = frameCount;
+    }
+
+    if (pFramesRead)
+        *pFramesRead = total;
+    return MA_SUCCESS;
+}
+
+static ma_result musicStreamSeek(ma_data_source *pDataSource, ma_uint64 frameIndex) {
+    // Called on the audio thread (ma_sound applies seeks there) — just post the request.
+    auto *stream = reinterpret_cast<LumiMusicStream *>(pDataSource);
+    stream->cursor.store(frameIndex, std::memory_order_relaxed);
+    stream->pendingSeek.store(frameIndex + 1, std::memory_order_release);
+    return MA_SUCCESS;
+}
+
+static ma_result musicStreamGetDataFormat(ma_data_source *pDataSource, ma_format *pFormat,
+    ma_uint32 *pChannels, ma_uint32 *pSampleRate,
+    ma_channel *pChannelMap, size_t channelMapCap) {
+    auto *stream = reinterpret_cast<LumiMusicStream *>(pDataSource);
+    if (pFormat)
+        *pFormat = ma_format_f32;
+    if (pChannels)
+        *pChannels = stream->channels;
+    if (pSampleRate)
+        *pSampleRate = stream->sampleRate;
+    if (pChannelMap)
+        ma_channel_map_init_standard(ma_standard_channel_map_default, pChannelMap, channelMapCap, stream->channels);
+    return MA_SUCCESS;
+}
+
+static ma_result musicStreamGetCursor(ma_data_source *pDataSource, ma_uint64 *pCursor) {
+    auto *stream = reinterpret_cast<LumiMusicStream *>(pDataSource);
+    if (pCursor)
+        *pCursor = stream->cursor.load(std::memory_order_relaxed);
+    return MA_SUCCESS;
+}
+
+static ma_result musicStreamGetLength(ma_data_source *pDataSource, ma_uint64 *pLength) {
+    // Never scans here (that's the stream thread's job); 0 until the scan has finished.
+    auto *stream = reinterpret_cast<LumiMusicStream *>(pDataSource);
+    if (pLength)
+        *pLength = stream->length.load(std::memory_order_acquire);
+    return MA_SUCCESS;
+}
+
+static ma_result musicStreamSetLooping(ma_data_source *pDataSource, ma_bool32 isLooping) {
+    auto *stream = reinterpret_cast<LumiMusicStream *>(pDataSource);
+    stream->looping.store(isLooping == MA_TRUE, std::memory_order_relaxed);
+    return MA_SUCCESS;
+}
+
+ma_data_source_vtable MusicStreamer::streamVtable = {
+    musicStreamRead,
+    musicStreamSeek,
+    musicStreamGetDataFormat,
+    musicStreamGetCursor,
+    musicStreamGetLength,
+    musicStreamSetLooping,
+    MA_DATA_SOURCE_SELF_MANAGED_RANGE_AND_LOOP_POINT // looping is done by the stream thread, seamlessly
+};
+
+// ═══════════════════════════════════════════════════════════════════
+// Stream thread
+// ═══════════════════════════════════════════════════════════════════
+
+void MusicStreamer::_start() {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    return; // no threads: Audio::UpdateMusicStreams pumps instead
+#else
+    std::lock_guard<std::mutex> lock(_streamsMutex);
+    if (_running)
+        return;
+    _running = true;
+    _thread  = std::thread([this] {
+        std::unique_lock<std::mutex> lock(_streamsMutex);
+        while (_running) {
+            for (auto *stream : _streams)
+                _fill(*stream);
+            // Length scans go after every ring is topped up, so a slow scan can't starve playback;
+            // after one, go round again to top the rings back up before the next
+            if (_scanPending(lock, false))
+                continue;
+            _wake.wait_for(lock, std::chrono::milliseconds(POLL_INTERVAL_MS));
+        }
+    });
+#endif
+}
+
+void MusicStreamer::_stop() {
+    {
+        std::lock_guard<std::mutex> lock(_streamsMutex);
+        if (!_running)
+            return;
+        _running = false;
+    }
+    _wake.notify_all();
+    if (_thread.joinable())
+        _thread.join();
+}
+
+void MusicStreamer::_pump() {
+    std::unique_lock<std::mutex> lock(_streamsMutex);
+    for (auto *stream : _streams)
+        _fill(*stream);
+    // Called once per frame on the game thread: a whole-file scan here would be a hitch
+    _scanPending(lock, true);
+}
+
+bool MusicStreamer::_scanPending(std::unique_lock<std::mutex> &lock, bool stepwise) {
+    auto it = std::find_if(_streams.begin(), _streams.end(),
+        [this](const LumiMusicStream *stream) { return !stream->lengthKnown && stream != _scanning; });
+    if (it == _streams.end())
+        return false;
+
+    // The scan only reads the stream's immutable fields and its own decoder, so it runs unlocked;
+    // _scanning keeps Destroy from freeing the stream meanwhile
+    LumiMusicStream *stream = *it;
+    _scanning               = stream;
+    lock.unlock();
+    const bool done = stepwise ? _scanStep(*stream) : _scanLength(*stream);
+    lock.lock();
+    if (done)
+        stream->lengthKnown = true;
+    _scanning = nullptr;
+    _scanDone.notify_all();
+    return true;
+}
+
+bool MusicStreamer::_scanLength(LumiMusicStream &stream) {
+    // Uses a throwaway decoder so the playing one never loses its position (length queries on
+    // compressed formats seek through / scan the whole file)
+    ma_decoder_config cfg = ma_decoder_config_init(ma_format_f32, stream.channels, stream.sampleRate);
+    ma_decoder        probe;
+    if (ma_decoder_init_memory(stream.encoded, stream.encodedSize, &cfg, &probe) == MA_SUCCESS) {
+        ma_uint64 frames = 0;
+        ma_decoder_get_length_in_pcm_frames(&probe, &frames);
+        stream.length.store(frames, std::memory_order_release);
+        ma_decoder_uninit(&probe);
+    }
+    return true;
+}
+
+bool MusicStreamer::_scanStep(LumiMusicStream &stream) {
+    // At the file's own rate and channel count the decoder has no converter, so skipping (null
+    // output) doesn't convert anything; the count is scaled to the output rate at the end
+    if (!stream.scanOpen) {
+        ma_decoder_config cfg = ma_decoder_config_init(ma_format_f32, 0, 0);
+        if (ma_decoder_init_memory(stream.encoded, stream.encodedSize, &cfg, &stream.scanDecoder) != MA_SUCCESS)
+            return true;
+        stream.scanOpen   = true;
+        stream.scanFrames = 0;
+    }
+
+    ma_uint64 skipped = 0;
+    ma_decoder_read_pcm_frames(&stream.scanDecoder, nullptr, SCAN_STEP_FRAMES, &skipped);
+    stream.scanFrames += skipped;
+    if (skipped == SCAN_STEP_FRAMES)
+        return false;
+
+    ma_uint32 fileRate = 0;
+    ma_decoder_get_data_format(&stream.scanDecoder, nullptr, nullptr, &fileRate, nullptr, 0);
+    const uint64_t frames = fileRate > 0 ? stream.scanFrames * stream.sampleRate / fileRate : 0;
+    stream.length.store(frames, std::memory_order_release);
+    ma_decoder_uninit(&stream.scanDecoder);
+    stream.scanOpen = false;
+    return true;
+}
+
+void MusicStreamer::_fill(LumiMusicStream &stream) {
+    // Apply a seek posted by the audio thread, then tell the reader where fresh data starts
+    const uint64_t seek = stream.pendingSeek.load(std::memory_order_acquire);
+    if (seek != 0) {
+        ma_decoder_seek_to_pcm_frame(&stream.decoder, seek - 1);
+        stream.decoderAtEnd.store(false, std::memory_order_relaxed);
+        stream.seekBoundary.store(stream.writtenTotal, std::memory_order_release);
+        uint64_t expected = seek;
+        // If another seek arrived meanwhile, leave it for the next pass
+        stream.pendingSeek.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+    }
+
+    const bool looping = stream.looping.load(std::memory_order_relaxed);
+    if (stream.decoderAtEnd.load(std::memory_order_relaxed)) {
+        if (!looping)
+            return;
+        // Looping was switched on after the track ran out
+        ma_decoder_seek_to_pcm_frame(&stream.decoder, 0);
+        stream.decoderAtEnd.store(false, std::memory_order_relaxed);
+    }
+
+    while (ma_pcm_rb_available_write(&stream.ring) > 0) {
+        ma_uint32 frames = std::min(ma_pcm_rb_available_write(&stream.ring), DECODE_CHUNK_FRAMES);
+        void     *dst    = nullptr;
+        if (ma_pcm_rb_acquire_write(&stream.ring, &frames, &dst) != MA_SUCCESS || frames == 0)
+            break;
+
+        ma_uint64 decoded  = 0;
+        bool      wrapped  = false;
+        auto     *bytes    = static_cast<uint8_t *>(dst);
+        const size_t frameBytes = size_t(stream.channels) * sizeof(float);
+        while (decoded < frames) {
+            ma_uint64 got = 0;
+            ma_decoder_read_pcm_frames(&stream.decoder, bytes + decoded * frameBytes, frames - decoded, &got);
+            decoded += got;
+            if (got > 0)
+                continue;
+            // End of track: wrap in-place for a gapless loop (once per chunk, so a broken
+            // file that yields nothing can't spin here)
+            if (!looping || wrapped)
+                break;
+            ma_decoder_seek_to_pcm_frame(&stream.decoder, 0);
+            wrapped = true;
+        }
+
+        ma_pcm_rb_commit_write(&stream.ring, static_cast<ma_uint32>(decoded));
+        stream.writtenTotal += decoded;
+
+        if (decoded < frames) {
+            stream.decoderAtEnd.store(true, std::memory_order_release);
+            break;
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Stream lifetime
+// ═══════════════════════════════════════════════════════════════════
+
+LumiMusicStream *MusicStreamer::_create(const void *data, size_t size, uint32_t channels, uint32_t sampleRate) {
+    if (!data || size == 0)
+        return nullptr;
+
+    auto *stream        = new LumiMusicStream;
+    stream->encoded     = data;
+    stream->encodedSize = size;
+    stream->channels    = channels;
+    stream->sampleRate  = sampleRate;
+
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, channels, sampleRate);
+    if (ma_decoder_init_memory(data, size, &decoderConfig, &stream->decoder) != MA_SUCCESS) {
+        delete stream;
+        return nullptr;
+    }
+
+    const auto ringFrames = static_cast<ma_uint32>(_readAheadSeconds.load() * static_cast<float>(sampleRate));
+    if (ma_pcm_rb_init(ma_format_f32, channels, ringFrames, nullptr, nullptr, &stream->ring) != MA_SUCCESS) {
+        ma_decoder_uninit(&stream->decoder);
+        delete stream;
+        return nullptr;
+    }
+
+    ma_data_source_config dsConfig = ma_data_source_config_init();
+    dsConfig.vtable                = &streamVtable;
+    if (ma_data_source_init(&dsConfig, &stream->base) != MA_SUCCESS) {
+        ma_pcm_rb_uninit(&stream->ring);
+        ma_decoder_uninit(&stream->decoder);
+        delete stream;
+        return nullptr;
+    }
+
+    // Prime the ring on this thread so the first play doesn't start with an underrun, then
+    // hand the stream to the stream thread.
+    std::lock_guard<std::mutex> lock(_streamsMutex);
+    _fill(*stream);
+    _streams.push_back(stream);
+
+    LOG_DEBUG("Music stream created: {} ch @ {} Hz, {} KB read-ahead", channels, sampleRate,
+        (ringFrames * channels * sizeof(float)) / 1024);
+    return stream;
+}
+
+void MusicStreamer::_destroy(LumiMusicStream *stream) {
+    if (!stream)
+        return;
+    {
+        std::unique_lock<std::mutex> lock(_streamsMutex);
+        _streams.erase(std::remove(_streams.begin(), _streams.end(), stream), _streams.end());
+        _scanDone.wait(lock, [this, stream] { return _scanning != stream; });
+    }
+    if (stream->scanOpen)
+        ma_decoder_uninit(&stream->scanDecoder);
+    ma_data_source_uninit(&stream->base);
+    ma_pcm_rb_uninit(&stream->ring);
+    ma_decoder_uninit(&stream->decoder);
+    delete stream;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+// Streamed music playback. A LumiMusicStream is a miniaudio data source that plays from a small
+// PCM ring buffer; one engine-wide MusicStreamer thread keeps every ring topped up by decoding
+// the track's compressed bytes a chunk at a time. Per-track decoded memory is the ring (the
+// read-ahead window, ~190 KB at the 0.5 s default) instead of the whole decoded song.
+//
+// Thread roles:
+//   game thread    Create/Destroy, ma_sound control (start/stop/looping/seek requests)
+//   audio thread   onRead/onSeek — never blocks, never touches the decoder
+//   stream thread  all decoder access: decode-ahead, seeks, looping, the one-off length scan
+// On single-threaded web builds there is no stream thread; Audio::UpdateMusicStreams pumps it.
+//
+// The length scan uses its own decoder and runs with the stream list unlocked, so a long scan
+// never holds up Create/Destroy; the result is published through the atomic `length`. Pump
+// scans a step per call instead of the whole file, so no single frame pays for it.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "miniaudio.h"
+
+/// @cond INTERNAL
+struct LumiMusicStream {
+    ma_data_source_base base; ///< Must be first member
+    ma_decoder          decoder;
+    ma_pcm_rb           ring;
+
+    const void *encoded     = nullptr; ///< Compressed file bytes (owned by the MusicAsset)
+    size_t      encodedSize = 0;
+    uint32_t    channels    = 2;
+    uint32_t    sampleRate  = 48000;
+
+    std::atomic<bool>     looping { false };
+    std::atomic<bool>     decoderAtEnd { false };
+    std::atomic<uint64_t> pendingSeek { 0 };  ///< Target frame + 1; 0 = none. Set by the audio thread.
+    std::atomic<uint64_t> seekBoundary { 0 }; ///< writtenTotal when the last seek was applied
+    std::atomic<uint64_t> length { 0 };       ///< Total frames, 0 until the stream thread has scanned it
+    std::atomic<uint64_t> cursor { 0 };       ///< Playback position in frames (audio thread writes)
+    std::atomic<uint32_t> underruns { 0 };    ///< Blocks the ring ran dry mid-track (read-ahead too small)
+
+    uint64_t writtenTotal = 0; ///< Frames ever committed to the ring (stream thread only)
+    uint64_t readTotal    = 0; ///< Frames ever consumed from the ring (audio thread only)
+    bool     lengthKnown  = false; ///< Scan finished (guarded by the streamer's mutex)
+
+    // Step-wise length scan (Pump): a second decoder at the file's own rate, skipped through
+    ma_decoder scanDecoder;
+    bool       scanOpen   = false;
+    uint64_t   scanFrames = 0;
+};
+/// @endcond
+
+/**
+ * @brief Owns the background decode thread that feeds every streamed music track.
+ */
+class MusicStreamer {
+public:
+    /// @brief Starts the stream thread (no-op without thread support). Called by Audio::Init.
+    static void Start() { Get()._start(); }
+
+    /// @brief Stops and joins the stream thread. Called by Audio::Close.
+    static void Stop() { Get()._stop(); }
+
+    /// @brief Tops up every ring on the calling thread. Used where there's no stream thread.
+    static void Pump() { Get()._pump(); }
+
+    /// @brief True if a background thread is servicing the streams (otherwise call Pump).
+    static bool IsThreaded() { return Get()._thread.joinable(); }
+
+    /**
+     * @brief Creates a stream over compressed bytes and registers it with the stream thread.
+     *
+     * @param data       Encoded file bytes. Must outlive the stream.
+     * @param size       Size of data in bytes.
+     * @param channels   Output channel count (the engine's).
+     * @param sampleRate Output sample rate (the engine's).
+     * @return The stream, or nullptr if the data can't be decoded.
+     */
+    static LumiMusicStream *Create(const void *data, size_t size, uint32_t channels, uint32_t sampleRate) {
+        return Get()._create(data, size, channels, sampleRate);
+    }
+
+    /// @brief Unregisters and frees a stream. The ma_sound playing it must be uninitialized first.
+    static void Destroy(LumiMusicStream *stream) { Get()._destroy(stream); }
+
+    /// @brief Decode-ahead window for streams created from now on, in seconds (clamped to 0.05..10).
+    static void SetReadAhead(float seconds) { Get()._readAheadSeconds.store(seconds < 0.05f ? 0.05f : (seconds > 10.0f ? 10.0f : seconds)); }
+
+    static float GetReadAhead() { return Get()._readAheadSeconds.load(); }
+
+private:
+    void _start();
+
+    void _stop();
+
+    void _pump();
+
+    LumiMusicStream *_create(const void *data, size_t size, uint32_t channels, uint32_t sampleRate);
+
+    void _destroy(LumiMusicStream *stream);
+
+    void _fill(LumiMusicStream &stream);
+
+    /// Runs the length scan (or, if `stepwise`, one step of it) for the first stream still
+    /// waiting for one, with `lock` released meanwhile. Returns false if none was waiting.
+    bool _scanPending(std::unique_lock<std::mutex> &lock, bool stepwise);
+
+    /// Whole-file length query on a throwaway decoder. Returns true (done).
+    bool _scanLength(LumiMusicStream &stream);
+
+    /// Counts another SCAN_STEP_FRAMES of the track. Returns true once the length is published.
+    bool _scanStep(LumiMusicStream &stream);
+
+    /// Frames decoded per ring write; also bounds how long one stream holds the thread.
+    static constexpr uint32_t DECODE_CHUNK_FRAMES = 4096;
+
+    /// How often the stream thread wakes to top up rings (well under the read-ahead window).
+    static constexpr int POLL_INTERVAL_MS = 5;
+
+    /// Frames skipped per stepwise scan call (~1.4 s of 48 kHz audio, a millisecond or two to decode).
+    static constexpr uint64_t SCAN_STEP_FRAMES = 65536;
+
+    std::vector<LumiMusicStream *> _streams;
+    std::mutex                     _streamsMutex;
+    std::condition_variable        _wake;
+    std::condition_variable        _scanDone;
+    std::thread                    _thread;
+    bool                           _running  = false;   // guarded by _streamsMutex
+    LumiMusicStream               *_scanning = nullptr; // guarded by _streamsMutex; Destroy waits for it
+    std::atomic<float>             _readAheadSeconds { 0.5f };
+
+    static ma_data_source_vtable streamVtable;
+
+public:
+    /// @cond INTERNAL
+    MusicStreamer(const MusicStreamer &) = delete;
+
+    static MusicStreamer &Get() {
+        static MusicStreamer instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    MusicStreamer() { }
+};
@@ -0,0 +1,316 @@
+#include "platform/cpu/cputopology.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#if defined(__EMSCRIPTEN__)
+#elif defined(_WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace {
+unsigned hardwareThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Every core the same class, every core allowed, nothing known about which CPU is which
+CpuTopology uniform(unsigned logical, unsigned physical) {
+    CpuTopology topology;
+    topology.logicalCores     = std::max(1u, logical);
+    topology.physicalCores    = std::max(1u, std::min(physical, topology.logicalCores));
+    topology.performanceCores = topology.physicalCores;
+    topology.allowedLogical   = topology.logicalCores;
+    topology.allowedPhysical  = topology.physicalCores;
+    return topology;
+}
+
+std::string firstLine(const std::string &text) {
+    return text.substr(0, text.find('\n'));
+}
+
+// Kernel CPU list format: "0-3,8,10-11"
+std::vector<int> parseCpuList(const std::string &text) {
+    std::vector<int>  cpus;
+    std::stringstream stream(text);
+    std::string       range;
+    while (std::getline(stream, range, ',')) {
+        int first = 0, last = 0;
+        if (std::sscanf(range.c_str(), "%d-%d", &first, &last) == 2) {
+            for (int cpu = first; cpu <= last && cpu - first < 65536; ++cpu)
+                cpus.push_back(cpu);
+        } else if (std::sscanf(range.c_str(), "%d", &first) == 1) {
+            cpus.push_back(first);
+        }
+    }
+    return cpus;
+}
+
+// CPUs' worth of time per period the process's cgroup allows (v2 cpu.max or v1 CFS quota),
+// the tightest limit on the way up the hierarchy; 0 when unlimited.
+double cgroupQuota(const CpuTopology::FileReader &read) {
+    double quota = 0.0;
+    auto   limit = [&quota](double cpus) {
+        if (cpus > 0.0 && (quota == 0.0 || cpus < quota))
+            quota = cpus;
+    };
+
+    std::stringstream cgroups(read("proc/self/cgroup"));
+    std::string       line;
+    while (std::getline(cgroups, line)) {
+        // "hierarchy-id:controllers:path"
+        const size_t first  = line.find(':');
+        const size_t second = first == std::string::npos ? first : line.find(':', first + 1);
+        if (second == std::string::npos)
+            continue;
+        const std::string controllers = line.substr(first + 1, second - first - 1);
+        std::string       path        = line.substr(second + 1);
+
+        if (line.compare(0, first, "0") == 0 && controllers.empty()) { // v2
+            while (true) {
+                const std::string max     = firstLine(read("sys/fs/cgroup" + (path == "/" ? "" : path) + "/cpu.max"));
+                double            allowed = 0.0, period = 0.0;
+                if (std::sscanf(max.c_str(), "%lf %lf", &allowed, &period) == 2 && period > 0.0)
+                    limit(allowed / period); // "max 100000" doesn't parse: unlimited
+                if (path.empty() || path == "/")
+                    break;
+                path.erase(path.rfind('/'));
+            }
+        } else if (("," + controllers + ",").find(",cpu,") != std::string::npos) { // v1
+            for (const char *mount : { "sys/fs/cgroup/cpu,cpuacct", "sys/fs/cgroup/cpu" }) {
+                const std::string dir    = mount + (path == "/" ? "" : path);
+                double            cfs    = std::atof(read(dir + "/cpu.cfs_quota_us").c_str());
+                double            period = std::atof(read(dir + "/cpu.cfs_period_us").c_str());
+                if (period > 0.0) {
+                    limit(cfs / period); // -1: unlimited
+                    break;
+                }
+            }
+        }
+    }
+    return quota;
+}
+} // namespace
+
+unsigned CpuTopology::UsableCores() const {
+    unsigned usable = std::max(1u, allowedPhysical);
+    // Rounded down: a thread per started CPU would be throttled at the end of each period
+    if (cpuQuota > 0.0)
+        usable = std::min(usable, std::max(1u, static_cast<unsigned>(cpuQuota + 0.01)));
+    return usable;
+}
+
+CpuTopology CpuTopology::_detectLinux(const FileReader &read, const std::vector<int> &allowed) {
+    const std::string cpuDir = "sys/devices/system/cpu/";
+    std::vector<int>  online = parseCpuList(firstLine(read(cpuDir + "online")));
+    if (online.empty()) {
+        CpuTopology topology = uniform(hardwareThreads(), hardwareThreads());
+        topology.cpuQuota    = cgroupQuota(read);
+        return topology;
+    }
+    const std::set<int> allowedSet(allowed.begin(), allowed.end());
+
+    // Core classes: Intel hybrid parts list their E-cores under the cpu_atom PMU; big.LITTLE
+    // ARM reports a relative capacity per CPU, the biggest being the performance class
+    const std::vector<int> atom = parseCpuList(firstLine(read("sys/devices/cpu_atom/cpus")));
+    const std::set<int>    atomSet(atom.begin(), atom.end());
+    std::map<int, int>     capacity;
+    int                    maxCapacity = 0;
+    if (atomSet.empty()) {
+        for (int cpu : online) {
+            const std::string text = firstLine(read(cpuDir + "cpu" + std::to_string(cpu) + "/cpu_capacity"));
+            if (!text.empty()) {
+                capacity[cpu] = std::atoi(text.c_str());
+                maxCapacity   = std::max(maxCapacity, capacity[cpu]);
+            }
+        }
+    }
+    auto isEfficiency = [&](int cpu) {
+        if (!atomSet.empty())
+            return atomSet.count(cpu) != 0;
+        auto it = capacity.find(cpu);
+        return it != capacity.end() && it->second < maxCapacity;
+    };
+
+    // SMT siblings share a core; the sibling list names the core (core_id alone repeats
+    // across packages)
+    struct Found {
+        Core core;
+        bool allowed = false;
+    };
+    std::map<std::string, Found> cores;
+    CpuTopology                  topology;
+    topology.logicalCores   = static_cast<unsigned>(online.size());
+    topology.allowedLogical = 0;
+    for (int cpu : online) {
+        const std::string topologyDir = cpuDir + "cpu" + std::to_string(cpu) + "/topology/";
+        std::string       key         = firstLine(read(topologyDir + "core_cpus_list"));
+        if (key.empty())
+            key = firstLine(read(topologyDir + "thread_siblings_list"));
+        if (key.empty())
+            key = std::to_string(cpu);
+
+        Found &found          = cores[key];
+        found.core.efficiency = isEfficiency(cpu);
+        if (allowedSet.empty() || allowedSet.count(cpu)) {
+            found.core.cpus.push_back(cpu);
+            found.allowed = true;
+            ++topology.allowedLogical;
+        }
+    }
+
+    topology.physicalCores    = static_cast<unsigned>(cores.size());
+    topology.performanceCores = 0;
+    topology.allowedPhysical  = 0;
+    for (auto &[key, found] : cores) {
+        (found.core.efficiency ? topology.efficiencyCores : topology.performanceCores) += 1;
+        if (found.allowed) {
+            ++topology.allowedPhysical;
+            topology.cores.push_back(std::move(found.core));
+        }
+    }
+    std::stable_sort(topology.cores.begin(), topology.cores.end(), [](const Core &a, const Core &b) {
+        return a.efficiency < b.efficiency || (a.efficiency == b.efficiency && a.cpus.front() < b.cpus.front());
+    });
+    if (topology.allowedLogical == 0) // an affinity mask naming no online CPU: ignore it
+        return _detectLinux(read, {});
+    topology.cpuQuota = cgroupQuota(read);
+    return topology;
+}
+
+CpuTopology CpuTopology::Detect() {
+#if defined(__EMSCRIPTEN__)
+    return uniform(1, 1);
+#elif defined(_WIN32)
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+    std::vector<char> buffer(length);
+    if (length == 0 || !GetLogicalProcessorInformationEx(RelationProcessorCore,
+            reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length))
+        return uniform(hardwareThreads(), hardwareThreads());
+
+    // The process affinity mask covers the process's processor group only; cores in other
+    // groups count as online but not allowed
+    DWORD_PTR processMask = 0, systemMask = 0;
+    GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask);
+    GROUP_AFFINITY group {};
+    GetThreadGroupAffinity(GetCurrentThread(), &group);
+
+    struct Found {
+        Core core;
+        BYTE efficiencyClass;
+    };
+    std::vector<Found> found;
+    BYTE               fastest = 0;
+    CpuTopology        topology;
+    topology.logicalCores   = 0;
+    topology.allowedLogical = 0;
+    for (DWORD offset = 0; offset < length;) {
+        const auto *info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+        offset += info->Size;
+        const GROUP_AFFINITY &mask = info->Processor.GroupMask[0];
+
+        Found core { {}, info->Processor.EfficiencyClass }; // higher is faster
+        fastest = std::max(fastest, core.efficiencyClass);
+        for (int bit = 0; bit < static_cast<int>(sizeof(KAFFINITY) * 8); ++bit) {
+            if (!(mask.Mask & (KAFFINITY(1) << bit)))
+                continue;
+            ++topology.logicalCores;
+            if (mask.Group == group.Group && (processMask & (KAFFINITY(1) << bit)))
+                core.core.cpus.push_back(bit);
+        }
+        topology.allowedLogical += static_cast<unsigned>(core.core.cpus.size());
+        found.push_back(std::move(core));
+    }
+
+    topology.physicalCores    = static_cast<unsigned>(found.size());
+    topology.performanceCores = 0;
+    topology.allowedPhysical  = 0;
+    for (Found &core : found) {
+        core.core.efficiency = core.efficiencyClass < fastest;
+        (core.core.efficiency ? topology.efficiencyCores : topology.performanceCores) += 1;
+        if (!core.core.cpus.empty()) {
+            ++topology.allowedPhysical;
+            topology.cores.push_back(std::move(core.core));
+        }
+    }
+    std::stable_sort(topology.cores.begin(), topology.cores.end(),
+        [](const Core &a, const Core &b) { return a.efficiency < b.efficiency; });
+    if (topology.allowedPhysical == 0)
+        return uniform(hardwareThreads(), hardwareThreads());
+    return topology;
+#elif defined(__APPLE__)
+    auto query = [](const char *name) {
+        int    value = 0;
+        size_t size  = sizeof(value);
+        return sysctlbyname(name, &value, &size, nullptr, 0) == 0 ? value : 0;
+    };
+    const int logical = query("hw.logicalcpu");
+    if (logical == 0)
+        return uniform(hardwareThreads(), hardwareThreads());
+    CpuTopology topology = uniform(static_cast<unsigned>(logical), static_cast<unsigned>(query("hw.physicalcpu")));
+    // Apple silicon: perflevel0 is the performance cluster, perflevel1 the efficiency one
+    if (query("hw.nperflevels") > 1) {
+        const int performance = query("hw.perflevel0.physicalcpu");
+        const int efficiency  = query("hw.perflevel1.physicalcpu");
+        if (performance > 0 && efficiency > 0) {
+            topology.performanceCores = static_cast<unsigned>(performance);
+            topology.efficiencyCores  = static_cast<unsigned>(efficiency);
+        }
+    }
+    return topology;
+#elif defined(__linux__)
+    std::vector<int> allowed;
+    cpu_set_t        set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set))
+                allowed.push_back(cpu);
+        }
+    }
+    return _detectLinux(
+        [](const std::string &path) {
+            std::ifstream file("/" + path);
+            return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        },
+        allowed);
+#else
+    return uniform(hardwareThreads(), hardwareThreads());
+#endif
+}
+
+bool CpuTopology::PinCurrentThread(const std::vector<int> &cpus) {
+    if (cpus.empty())
+        return false;
+#if defined(__EMSCRIPTEN__)
+    return false;
+#elif defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8))
+            mask |= DWORD_PTR(1) << cpu;
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0; // 0: the calling thread
+#else
+    return false; // macOS only takes affinity tags, not CPUs
+#endif
+}
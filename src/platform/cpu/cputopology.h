@@ -0,0 +1,57 @@
+#pragma once
+
+// What the CPU looks like to this process: cores (physical vs logical), the performance /
+// efficiency split on hybrid CPUs, and how much of it the process may actually use (affinity
+// mask, cgroup CPU quota in containers). Platform turns this into the engine-wide thread budget
+// and worker pools (util/helpers.h).
+//
+// Linux and Android read sysfs and /proc; Windows asks GetLogicalProcessorInformationEx; macOS
+// sysctl hw.perflevel*; Emscripten reports one core (no -pthread). Anything that can't be read
+// falls back to std::thread::hardware_concurrency() with every core counted as performance.
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/// @brief CPU cores and the share of them this process may use.
+struct CpuTopology {
+    unsigned logicalCores     = 1; ///< Hardware threads online.
+    unsigned physicalCores    = 1; ///< Cores online (SMT siblings counted once).
+    unsigned performanceCores = 1; ///< Physical cores of the fastest class (all of them if not hybrid).
+    unsigned efficiencyCores  = 0; ///< Physical cores of the slower classes (Intel E-cores, ARM LITTLE).
+
+    unsigned allowedLogical  = 1;   ///< Hardware threads in the process's affinity mask.
+    unsigned allowedPhysical = 1;   ///< Cores with at least one allowed hardware thread.
+    double   cpuQuota        = 0.0; ///< CPUs' worth of time the cgroup allows (0 = unlimited).
+
+    /// A physical core the process may use, with its allowed hardware threads.
+    struct Core {
+        std::vector<int> cpus;               ///< Logical CPU ids (SMT siblings).
+        bool             efficiency = false; ///< A slower-class core.
+    };
+    /// Allowed cores, performance class first. Used for affinity hints; empty where the OS has
+    /// no hard affinity (macOS, Emscripten).
+    std::vector<Core> cores;
+
+    /// @brief True on CPUs with more than one core class.
+    bool IsHybrid() const { return efficiencyCores > 0 && performanceCores > 0; }
+
+    /// @brief Cores compute-bound work can keep busy: allowed physical cores, capped by the quota.
+    unsigned UsableCores() const;
+
+    /// @brief Detects the current machine (Platform caches the result).
+    static CpuTopology Detect();
+
+    /// @brief Restricts the calling thread to the given logical CPUs. False where unsupported.
+    static bool PinCurrentThread(const std::vector<int> &cpus);
+
+    /// @cond INTERNAL
+    /// Contents of a sysfs/procfs file by path from the root ("sys/devices/system/cpu/online",
+    /// "proc/self/cgroup"), or "" if there's no such file.
+    using FileReader = std::function<std::string(const std::string &path)>;
+
+    /// Linux detection from file contents (the real files normally; fixture strings when
+    /// testing), given the allowed CPU ids (from sched_getaffinity).
+    static CpuTopology _detectLinux(const FileReader &read, const std::vector<int> &allowed);
+    /// @endcond
+};
@@ -4,6 +4,17 @@
 #include "platform/input/mouseinput_backend.h"
 #include "renderer/renderer.h"
 
+namespace {
+float axisToFloat(Sint16 x) {
+    if (std::abs(x) < DEADZONE) {
+        // Value is within the deadzone, ignore it
+        x = 0;
+    }
+
+    return ((float)x) / 32768.0f;
+}
+} // namespace
+
 void Input::_init() {
     if (_didInit)
         return;
@@ -81,23 +92,34 @@ void Input::_updateTimings() {
 }
 
 float Input::_getGamepadAxisMovement(int gamepadID, SDL_GamepadAxis axis) {
-    Sint16 x = SDL_GetGamepadAxis(_gamepads[gamepadID].gamepad, axis);
-
-    if (std::abs(x) < DEADZONE) {
-        // Value is within the deadzone, ignore it
-        x = 0;
+    if (_replaying) {
+        if (gamepadID < 0 || gamepadID >= (int)_replayState.pads.size() || axis < 0 || axis >= SDL_GAMEPAD_AXIS_COUNT)
+            return 0.0f;
+        return axisToFloat(_replayState.pads[gamepadID].axes[axis]);
     }
 
-    return ((float)x) / 32768.0f;
+    return axisToFloat(SDL_GetGamepadAxis(_gamepads[gamepadID].gamepad, axis));
 }
 
 bool Input::_gamepadButtonPressed(int gamepadID, int button) {
+    if (_replaying) {
+        if (gamepadID < 0 || gamepadID >= (int)_replayState.pads.size() || button < 0 || button >= SDL_GAMEPAD_BUTTON_COUNT)
+            return false;
+        const Uint32 mask = 1u << button;
+        return (_replayState.pads[gamepadID].buttons & mask) != 0 && (_replayPreviousPadButtons[gamepadID] & mask) == 0;
+    }
 
-    auto gamepadinfo = _gamepads[gamepadID];
+    const auto &gamepadinfo = _gamepads[gamepadID];
     return gamepadinfo.currentButtonState[button] && !gamepadinfo.previousButtonState[button];
 }
 
 bool Input::_gamepadButtonDown(int gamepadID, int button) {
+    if (_replaying) {
+        if (gamepadID < 0 || gamepadID >= (int)_replayState.pads.size() || button < 0 || button >= SDL_GAMEPAD_BUTTON_COUNT)
+            return false;
+        return (_replayState.pads[gamepadID].buttons & (1u << button)) != 0;
+    }
+
     return SDL_GetGamepadButton(_gamepads[gamepadID].gamepad, static_cast<SDL_GamepadButton>(button));
 }
 
@@ -129,6 +151,9 @@ bool Input::_keyDown(int key) {
 }
 
 vf2d Input::_getMousePosition() {
+    if (_replaying)
+        return _replayState.mousePosition;
+
     vf2d p = PlatformInputBackend::GetMousePosition();
     // The scene renders at canvas/scaleFactor and is upscaled to present (Window::SetScale), so the
     // cursor — reported in canvas pixels — has to be divided by the scale to land in render space.
@@ -231,6 +256,58 @@ void Input::_updateScroll(int scrollDir) {
     }
 }
 
+void Input::_captureSnapshot(InputSnapshot &out) {
+    out.keys          = currentKeyboardState;
+    out.mouseButtons  = _currentMouseButtons;
+    out.mousePosition = _getMousePosition();
+    out.mouseDelta    = _mouseDelta;
+    out.scrolledUp    = _scrolledUpTicks;
+    out.scrolledDown  = _scrolledDownTicks;
+
+    if (_replaying) {
+        out.pads = _replayState.pads;
+        return;
+    }
+
+    out.pads.resize(_gamepads.size());
+    for (size_t i = 0; i < _gamepads.size(); ++i) {
+        InputSnapshot::Pad &pad = out.pads[i];
+        pad.buttons             = 0;
+        for (int b = 0; b < SDL_GAMEPAD_BUTTON_COUNT; ++b) {
+            if (_gamepads[i].currentButtonState[b])
+                pad.buttons |= 1u << b;
+        }
+        for (int a = 0; a < SDL_GAMEPAD_AXIS_COUNT; ++a)
+            pad.axes[a] = SDL_GetGamepadAxis(_gamepads[i].gamepad, static_cast<SDL_GamepadAxis>(a));
+    }
+}
+
+void Input::_applySnapshot(const InputSnapshot *snapshot) {
+    if (!snapshot) {
+        _replaying = false;
+        _replayState.pads.clear();
+        _replayPreviousPadButtons.clear();
+        return;
+    }
+
+    // Previous-frame pad buttons for GamepadButtonPressed; keys and mouse buttons already got
+    // theirs from Update(), which ran before this frame's events (and this snapshot)
+    std::vector<Uint32> previous(snapshot->pads.size(), 0);
+    for (size_t i = 0; i < previous.size() && i < _replayState.pads.size(); ++i)
+        previous[i] = _replayState.pads[i].buttons;
+    _replayPreviousPadButtons.swap(previous);
+
+    _replaying   = true;
+    _replayState = *snapshot;
+
+    if (snapshot->keys.size() == currentKeyboardState.size())
+        currentKeyboardState = snapshot->keys;
+    _currentMouseButtons = snapshot->mouseButtons;
+    _mouseDelta          = snapshot->mouseDelta;
+    _scrolledUpTicks     = snapshot->scrolledUp;
+    _scrolledDownTicks   = snapshot->scrolledDown;
+}
+
 void Input::_handleTouchEvent(const SDL_Event *event) {
     _virtualControls.HandleTouchEvent(event);
 }
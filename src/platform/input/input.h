@@ -17,6 +17,25 @@
 
 static const int DEADZONE = 8000;
 
+/**
+ * @brief One frame of polled input state, as captured for (and fed back by) Replay.
+ */
+struct InputSnapshot {
+    /// @brief Buttons (bit per SDL_GamepadButton) and raw axis values of one gamepad.
+    struct Pad {
+        Uint32 buttons                      = 0;
+        Sint16 axes[SDL_GAMEPAD_AXIS_COUNT] = {};
+    };
+
+    std::vector<Uint8> keys; ///< SDL_SCANCODE_COUNT entries, 1 = held
+    Uint32             mouseButtons = 0;
+    vf2d               mousePosition { 0.0f, 0.0f };
+    vf2d               mouseDelta { 0.0f, 0.0f };
+    Uint32             scrolledUp   = 0;
+    Uint32             scrolledDown = 0;
+    std::vector<Pad>   pads;
+};
+
 /**
  * @brief Provides functionality for handling user input.
  */
@@ -165,6 +184,13 @@ public:
     static void RemoveGamepadDevice(SDL_JoystickID joystickID) { Get()._removeGamepadDevice(joystickID); }
 
     static void UpdateScroll(int scrollDir) { Get()._updateScroll(scrollDir); }
+
+    // Replay support: copy out this frame's state, or replace it with a recorded one. While a
+    // snapshot is applied the mouse position and gamepads read from it instead of the devices;
+    // ApplySnapshot(nullptr) goes back to live input.
+    static void CaptureSnapshot(InputSnapshot &out) { Get()._captureSnapshot(out); }
+
+    static void ApplySnapshot(const InputSnapshot *snapshot) { Get()._applySnapshot(snapshot); }
     /// @endcond
 
     /**
@@ -237,6 +263,10 @@ private:
 
     void _updateScroll(int scrollDir);
 
+    void _captureSnapshot(InputSnapshot &out);
+
+    void _applySnapshot(const InputSnapshot *snapshot);
+
     std::vector<Uint8> _previousKeyboardState;
 
     Uint32 _currentMouseButtons  = 0;
@@ -258,6 +288,10 @@ private:
 
     std::vector<GamepadInfo> _gamepads;
 
+    bool                _replaying = false;
+    InputSnapshot       _replayState;
+    std::vector<Uint32> _replayPreviousPadButtons;
+
     VirtualControls _virtualControls;
 
     bool _didInit = false;
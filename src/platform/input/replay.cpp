@@ -0,0 +1,312 @@
+#include "platform/input/replay.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "core/log/log.h"
+#include "core/timestep/timestep.h"
+#include "util/random.h"
+
+namespace {
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+bool samePad(const InputSnapshot::Pad &a, const InputSnapshot::Pad &b) {
+    return a.buttons == b.buttons && std::memcmp(a.axes, b.axes, sizeof(a.axes)) == 0;
+}
+
+bool samePads(const std::vector<InputSnapshot::Pad> &a, const std::vector<InputSnapshot::Pad> &b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!samePad(a[i], b[i]))
+            return false;
+    }
+    return true;
+}
+
+bool sameMouse(const InputSnapshot &a, const InputSnapshot &b) {
+    return a.mouseButtons == b.mouseButtons && a.mousePosition.x == b.mousePosition.x && a.mousePosition.y == b.mousePosition.y
+        && a.mouseDelta.x == b.mouseDelta.x && a.mouseDelta.y == b.mouseDelta.y && a.scrolledUp == b.scrolledUp
+        && a.scrolledDown == b.scrolledDown;
+}
+
+void resetSnapshot(InputSnapshot &snapshot) {
+    snapshot = InputSnapshot {};
+    snapshot.keys.assign(SDL_SCANCODE_COUNT, 0);
+}
+} // namespace
+
+bool Replay::_startRecording(const std::string &path, uint64_t seed) {
+    _stopPlayback();
+    _stopRecording();
+
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file) {
+        LOG_WARNING("Replay: can't open {} for writing", path);
+        return false;
+    }
+
+    if (seed == 0) {
+        std::random_device rd;
+        seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+    }
+
+    _buffer.reserve(BUFFER_SIZE + 4096);
+    _put(MAGIC, sizeof(MAGIC));
+    _putValue(VERSION);
+    _putValue(seed);
+    _putValue(Timestep::GetTickRate());
+
+    _startSession(seed);
+    return true;
+}
+
+void Replay::_stopRecording() {
+    if (!_file)
+        return;
+
+    _writeBuffer();
+    std::fclose(_file);
+    _file = nullptr;
+    _seed = 0;
+}
+
+bool Replay::_startPlayback(const std::string &path, bool quitWhenDone) {
+    _stopRecording();
+    _stopPlayback();
+
+    FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        LOG_WARNING("Replay: can't open {}", path);
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    _data.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    const size_t read = std::fread(_data.data(), 1, _data.size(), file);
+    std::fclose(file);
+    _cursor = 0;
+
+    char     magic[sizeof(MAGIC)];
+    uint32_t version  = 0;
+    uint64_t seed     = 0;
+    double   tickRate = 0.0;
+    if (read != _data.size() || !_take(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+        || !_takeValue(version) || version != VERSION || !_takeValue(seed) || !_takeValue(tickRate)) {
+        LOG_WARNING("Replay: {} is not a version {} recording", path, VERSION);
+        _data.clear();
+        return false;
+    }
+
+    _playing      = true;
+    _quitWhenDone = quitWhenDone;
+    Timestep::SetTickRate(tickRate);
+    _startSession(seed);
+    return true;
+}
+
+void Replay::_stopPlayback() {
+    if (!_playing)
+        return;
+
+    _playing = false;
+    _seed    = 0;
+    _data.clear();
+    _data.shrink_to_fit();
+    Input::ApplySnapshot(nullptr);
+}
+
+void Replay::_startSession(uint64_t seed) {
+    _checkedEnvironment = true; // an explicit start wins over the environment variables
+    _seed               = seed;
+    _frame              = 0;
+    resetSnapshot(_current);
+    resetSnapshot(_previous);
+}
+
+void Replay::_checkEnvironment() {
+    _checkedEnvironment = true;
+
+    if (const char *path = getenv("LUMI_REPLAY_PLAY")) {
+        if (StartPlayback(path, true))
+            LOG_INFO("Replay: playing {}", path);
+    } else if (const char *path = getenv("LUMI_REPLAY_RECORD")) {
+        if (StartRecording(path))
+            LOG_INFO("Replay: recording to {}", path);
+    }
+}
+
+void Replay::_beginFrame() {
+    if (!_checkedEnvironment)
+        _checkEnvironment();
+
+    if (!_playing && !_file)
+        return;
+
+    // Both sides start from an empty accumulator, whenever in the frame the session was started
+    if (_frame == 0)
+        Timestep::Reset();
+
+    if (_playing) {
+        if (!_readFrame()) {
+            const bool quit = _quitWhenDone;
+            LOG_INFO("Replay: playback finished after {} frames", _frame);
+            _stopPlayback();
+            if (quit)
+                EngineState::shouldQuit = true;
+            return;
+        }
+        EngineState::lastFrameTime = _delta;
+    } else {
+        _delta = EngineState::lastFrameTime;
+    }
+
+    _reseed();
+}
+
+void Replay::_endInput(const InputSnapshot *input) {
+    if (_playing) {
+        Input::ApplySnapshot(&_current);
+    } else if (_file) {
+        if (input) {
+            _current = *input;
+            _current.keys.resize(SDL_SCANCODE_COUNT, 0);
+        } else {
+            Input::CaptureSnapshot(_current);
+        }
+        _recordFrame();
+    } else {
+        return;
+    }
+
+    std::swap(_previous, _current);
+    ++_frame;
+}
+
+void Replay::_reseed() {
+    Random::SetSeed(splitmix64(_seed + _frame));
+}
+
+void Replay::_recordFrame() {
+    uint8_t flags = 0;
+
+    uint16_t toggled = 0;
+    for (size_t i = 0; i < _current.keys.size(); ++i)
+        toggled += _current.keys[i] != _previous.keys[i];
+    if (toggled > 0)
+        flags |= FLAG_KEYS;
+    if (!sameMouse(_current, _previous))
+        flags |= FLAG_MOUSE;
+    if (!samePads(_current.pads, _previous.pads))
+        flags |= FLAG_PADS;
+
+    _putValue(flags);
+    _putValue(_delta);
+
+    if (flags & FLAG_KEYS) {
+        _putValue(toggled);
+        for (size_t i = 0; i < _current.keys.size(); ++i) {
+            if (_current.keys[i] != _previous.keys[i])
+                _putValue(static_cast<uint16_t>(i));
+        }
+    }
+
+    if (flags & FLAG_MOUSE) {
+        _putValue(static_cast<uint32_t>(_current.mouseButtons));
+        _putValue(_current.mousePosition.x);
+        _putValue(_current.mousePosition.y);
+        _putValue(_current.mouseDelta.x);
+        _putValue(_current.mouseDelta.y);
+        _putValue(static_cast<uint16_t>(std::min<Uint32>(_current.scrolledUp, UINT16_MAX)));
+        _putValue(static_cast<uint16_t>(std::min<Uint32>(_current.scrolledDown, UINT16_MAX)));
+    }
+
+    if (flags & FLAG_PADS) {
+        const uint8_t count = static_cast<uint8_t>(std::min<size_t>(_current.pads.size(), UINT8_MAX));
+        _putValue(count);
+        for (uint8_t i = 0; i < count; ++i) {
+            _putValue(static_cast<uint32_t>(_current.pads[i].buttons));
+            _put(_current.pads[i].axes, sizeof(_current.pads[i].axes));
+        }
+    }
+
+    if (_buffer.size() >= BUFFER_SIZE)
+        _writeBuffer();
+}
+
+bool Replay::_readFrame() {
+    if (_cursor >= _data.size())
+        return false;
+
+    // Sections left out of the frame carry over unchanged from the previous one
+    _current = _previous;
+
+    uint8_t flags = 0;
+    if (!_takeValue(flags) || !_takeValue(_delta))
+        return false;
+
+    if (flags & FLAG_KEYS) {
+        uint16_t toggled = 0;
+        if (!_takeValue(toggled))
+            return false;
+        for (uint16_t i = 0; i < toggled; ++i) {
+            uint16_t scancode = 0;
+            if (!_takeValue(scancode) || scancode >= _current.keys.size())
+                return false;
+            _current.keys[scancode] ^= 1;
+        }
+    }
+
+    if (flags & FLAG_MOUSE) {
+        uint32_t buttons = 0;
+        uint16_t up = 0, down = 0;
+        if (!_takeValue(buttons) || !_takeValue(_current.mousePosition.x) || !_takeValue(_current.mousePosition.y)
+            || !_takeValue(_current.mouseDelta.x) || !_takeValue(_current.mouseDelta.y) || !_takeValue(up) || !_takeValue(down))
+            return false;
+        _current.mouseButtons = buttons;
+        _current.scrolledUp   = up;
+        _current.scrolledDown = down;
+    }
+
+    if (flags & FLAG_PADS) {
+        uint8_t count = 0;
+        if (!_takeValue(count))
+            return false;
+        _current.pads.resize(count);
+        for (auto &pad : _current.pads) {
+            uint32_t buttons = 0;
+            if (!_takeValue(buttons) || !_take(pad.axes, sizeof(pad.axes)))
+                return false;
+            pad.buttons = buttons;
+        }
+    }
+
+    return true;
+}
+
+void Replay::_put(const void *data, size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    _buffer.insert(_buffer.end(), bytes, bytes + size);
+}
+
+void Replay::_writeBuffer() {
+    if (_file && !_buffer.empty())
+        std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+    _buffer.clear();
+}
+
+bool Replay::_take(void *data, size_t size) {
+    if (_data.size() - _cursor < size)
+        return false;
+    std::memcpy(data, _data.data() + _cursor, size);
+    _cursor += size;
+    return true;
+}
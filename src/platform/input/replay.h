@@ -0,0 +1,148 @@
+#pragma once
+
+// Deterministic record/replay of a session. The recorder writes, per frame, the frame delta and
+// the polled input state (keyboard, mouse, gamepads) to a compact file; the player feeds them
+// back through Input and EngineState::lastFrameTime, so the game sees the same input at the same
+// times and replays identically. The random seed is stored once and Random (the main and thread
+// streams, so also Helpers::GetRandomValue) is reseeded from it every frame, so an RNG call that
+// differs in one frame can't shift the rest.
+//
+// With LUMI_REPLAY_RECORD=<file> or LUMI_REPLAY_PLAY=<file> set, recording / playback starts on
+// the first frame and playback quits when the file ends: a repeatable workload for profiling.
+//
+// File layout (host byte order):
+//   header  "LUMIRPL\0", u32 version, u64 seed, f64 tick rate
+//   frame   u8 flags, f64 delta, then per flag bit:
+//     KEYS  (1)  u16 n, n × u16 scancodes whose state flipped since the previous frame
+//     MOUSE (2)  u32 buttons, f32 x, f32 y, f32 dx, f32 dy, u16 scrolled up, u16 scrolled down
+//     PADS  (4)  u8 n, n × (u32 buttons, i16 axes[SDL_GAMEPAD_AXIS_COUNT])
+//   A section whose state didn't change since the previous frame is left out.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "platform/input/input.h"
+
+/**
+ * @brief Records and replays per-frame input and frame timing.
+ */
+class Replay {
+public:
+    static constexpr char     MAGIC[8] = { 'L', 'U', 'M', 'I', 'R', 'P', 'L', '\0' };
+    static constexpr uint32_t VERSION  = 1;
+
+    /**
+     * @brief Starts recording to a file from the next frame on (stops any playback).
+     *
+     * @param path Output file.
+     * @param seed Random seed for the session; 0 picks one.
+     * @return False if the file can't be opened.
+     */
+    static bool StartRecording(const std::string &path, uint64_t seed = 0) { return Get()._startRecording(path, seed); }
+
+    /// @brief Finishes the recording and closes the file.
+    static void StopRecording() { Get()._stopRecording(); }
+
+    /**
+     * @brief Loads a recording and replays it from the next frame on (stops any recording).
+     *
+     * Live input is ignored while playing. Set the same tick callbacks and load the same state
+     * as when recording; playback only reproduces what the engine feeds the game.
+     *
+     * @param path Recording to play.
+     * @param quitWhenDone Ask the window to close after the last frame.
+     * @return False if the file is missing or not a valid recording.
+     */
+    static bool StartPlayback(const std::string &path, bool quitWhenDone = false) { return Get()._startPlayback(path, quitWhenDone); }
+
+    /// @brief Stops playback and returns to live input.
+    static void StopPlayback() { Get()._stopPlayback(); }
+
+    static bool IsRecording() { return Get()._file != nullptr; }
+
+    static bool IsPlaying() { return Get()._playing; }
+
+    /// @brief Frames recorded or played so far in the current session.
+    static uint64_t GetFrame() { return Get()._frame; }
+
+    /// @brief Seed of the current session (0 when neither recording nor playing).
+    static uint64_t GetSeed() { return Get()._seed; }
+
+    /// @cond INTERNAL
+    // Called by Window each frame: BeginFrame once lastFrameTime is known, EndInput after
+    // HandleInput has polled this frame's input.
+    static void BeginFrame() { Get()._beginFrame(); }
+
+    static void EndInput() { Get()._endInput(nullptr); }
+
+    // EndInput with the frame's input given rather than polled from Input (tests). Scancodes
+    // past the end of `input.keys` are recorded as released.
+    static void EndInput(const InputSnapshot &input) { Get()._endInput(&input); }
+
+    // The input of the frame being played back, as read from the file: valid between
+    // BeginFrame and EndInput.
+    static const InputSnapshot &GetPlaybackInput() { return Get()._current; }
+    /// @endcond
+
+private:
+    static constexpr uint8_t FLAG_KEYS  = 1 << 0;
+    static constexpr uint8_t FLAG_MOUSE = 1 << 1;
+    static constexpr uint8_t FLAG_PADS  = 1 << 2;
+
+    /// Pending bytes are written out once they reach this size (or on StopRecording).
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    bool _startRecording(const std::string &path, uint64_t seed);
+    void _stopRecording();
+    bool _startPlayback(const std::string &path, bool quitWhenDone);
+    void _stopPlayback();
+    void _beginFrame();
+    void _endInput(const InputSnapshot *input);
+    void _checkEnvironment();
+    void _startSession(uint64_t seed);
+    void _reseed();
+
+    void _recordFrame();
+    bool _readFrame();
+
+    void _put(const void *data, size_t size);
+    void _writeBuffer();
+    bool _take(void *data, size_t size);
+
+    template <typename T>
+    void _putValue(const T &value) { _put(&value, sizeof(T)); }
+
+    template <typename T>
+    bool _takeValue(T &value) { return _take(&value, sizeof(T)); }
+
+    FILE             *_file = nullptr;
+    std::vector<char> _buffer;
+
+    bool                 _playing      = false;
+    bool                 _quitWhenDone = false;
+    std::vector<uint8_t> _data;
+    size_t               _cursor = 0;
+
+    bool          _checkedEnvironment = false;
+    uint64_t      _seed               = 0;
+    uint64_t      _frame              = 0;
+    double        _delta              = 0.0;
+    InputSnapshot _current;
+    InputSnapshot _previous; ///< last recorded / replayed frame; sections are deltas against it
+
+public:
+    /// @cond INTERNAL
+    Replay(const Replay &) = delete;
+
+    static Replay &Get() {
+        static Replay instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    Replay() { }
+    ~Replay() { _stopRecording(); }
+};
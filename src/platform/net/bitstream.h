@@ -0,0 +1,154 @@
+#pragma once
+
+// Bit-level serialization for replicated state (replication.h): values are written with exactly
+// as many bits as they need, LSB first, into a byte vector that keeps its capacity between
+// uses. Floats go through a fixed-point quantizer instead of travelling as 32 bits.
+//
+// The reader never reads past its span: running out sets Overflowed() and returns zeros, so a
+// truncated or hostile packet decodes to garbage the caller rejects rather than to a crash.
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// @brief Fixed-point mapping of a float range onto an unsigned integer of `bits` bits.
+struct Quantizer {
+    float    min  = 0.0f;
+    float    max  = 1.0f;
+    uint32_t bits = 16;
+
+    /// @brief The smallest bit count that keeps values in [min, max] within `precision` of the original.
+    static uint32_t BitsFor(float min, float max, float precision) {
+        const double steps = std::ceil((static_cast<double>(max) - min) / precision);
+        return std::clamp<uint32_t>(static_cast<uint32_t>(std::bit_width(static_cast<uint64_t>(std::max(steps, 1.0)))), 1, 32);
+    }
+
+    uint32_t Encode(float value) const {
+        const double scale = static_cast<double>(maxCode());
+        const double t     = std::isnan(value) ? 0.0 : (std::clamp(value, min, max) - static_cast<double>(min)) / (static_cast<double>(max) - min);
+        return static_cast<uint32_t>(std::llround(t * scale));
+    }
+
+    float Decode(uint32_t code) const {
+        return static_cast<float>(min + (static_cast<double>(max) - min) * code / static_cast<double>(maxCode()));
+    }
+
+private:
+    uint64_t maxCode() const { return (uint64_t(1) << bits) - 1; }
+};
+
+class BitWriter {
+public:
+    /// @brief Appends to `out` (which is cleared first).
+    explicit BitWriter(std::vector<uint8_t> &out)
+        : _out(out) { _out.clear(); }
+
+    ~BitWriter() { Flush(); }
+
+    BitWriter(const BitWriter &)            = delete;
+    BitWriter &operator=(const BitWriter &) = delete;
+
+    void WriteBits(uint32_t value, uint32_t bits) {
+        if (bits < 32)
+            value &= (1u << bits) - 1;
+        _scratch |= static_cast<uint64_t>(value) << _pending;
+        _pending += bits;
+        while (_pending >= 8) {
+            _out.push_back(static_cast<uint8_t>(_scratch));
+            _scratch >>= 8;
+            _pending -= 8;
+        }
+        _written += bits;
+    }
+
+    void WriteBool(bool value) { WriteBits(value ? 1 : 0, 1); }
+
+    /// @brief 4-bit groups with a continuation bit: 0..15 cost 5 bits.
+    void WriteVarUint(uint32_t value) {
+        do {
+            const uint32_t group = value & 0xF;
+            value >>= 4;
+            WriteBits(group | (value ? 0x10 : 0), 5);
+        } while (value);
+    }
+
+    void WriteFloat(float value, const Quantizer &quantizer) { WriteBits(quantizer.Encode(value), quantizer.bits); }
+
+    void WriteBytes(const uint8_t *data, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            WriteBits(data[i], 8);
+    }
+
+    /// @brief Pads the last byte with zeros; called by the destructor.
+    void Flush() {
+        if (_pending > 0) {
+            _out.push_back(static_cast<uint8_t>(_scratch));
+            _written += 8 - _pending;
+            _scratch = 0;
+            _pending = 0;
+        }
+    }
+
+    size_t BitsWritten() const { return _written; }
+
+private:
+    std::vector<uint8_t> &_out;
+    uint64_t              _scratch = 0;
+    uint32_t              _pending = 0;
+    size_t                _written = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(std::span<const uint8_t> data)
+        : _data(data) { }
+
+    uint32_t ReadBits(uint32_t bits) {
+        while (_pending < bits) {
+            if (_offset == _data.size()) {
+                _overflowed = true;
+                return 0;
+            }
+            _scratch |= static_cast<uint64_t>(_data[_offset++]) << _pending;
+            _pending += 8;
+        }
+        const uint32_t value = static_cast<uint32_t>(_scratch & ((uint64_t(1) << bits) - 1));
+        _scratch >>= bits;
+        _pending -= bits;
+        return value;
+    }
+
+    bool ReadBool() { return ReadBits(1) != 0; }
+
+    uint32_t ReadVarUint() {
+        uint32_t value = 0;
+        for (uint32_t shift = 0; shift < 32; shift += 4) {
+            const uint32_t group = ReadBits(5);
+            value |= (group & 0xF) << shift;
+            if (!(group & 0x10))
+                return value;
+        }
+        _overflowed = true; // more groups than a uint32 holds
+        return 0;
+    }
+
+    float ReadFloat(const Quantizer &quantizer) { return quantizer.Decode(ReadBits(quantizer.bits)); }
+
+    void ReadBytes(uint8_t *data, size_t size) {
+        for (size_t i = 0; i < size; ++i)
+            data[i] = static_cast<uint8_t>(ReadBits(8));
+    }
+
+    /// @brief True once a read ran past the end of the data.
+    bool Overflowed() const { return _overflowed; }
+
+private:
+    std::span<const uint8_t> _data;
+    size_t                   _offset     = 0;
+    uint64_t                 _scratch    = 0;
+    uint32_t                 _pending    = 0;
+    bool                     _overflowed = false;
+};
@@ -0,0 +1,169 @@
+#include "platform/net/impairment.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+// Heap order for the pending queues: earliest release on top, arrival order among equals
+constexpr auto releasesLater = [](const auto &a, const auto &b) {
+    return a.release != b.release ? a.release > b.release : a.sequence > b.sequence;
+};
+
+uint64_t toMicroseconds(float ms) { return ms > 0.0f ? static_cast<uint64_t>(ms * 1000.0f) : 0; }
+
+uint64_t steadyMicroseconds() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+} // namespace
+
+ImpairedTransport::ImpairedTransport(std::unique_ptr<ITransport> inner)
+    : _inner(std::move(inner))
+    , _clock(steadyMicroseconds) { }
+
+ImpairedTransport::~ImpairedTransport() = default;
+
+void ImpairedTransport::SetConditions(const NetConditions &send, const NetConditions &receive) {
+    _send.conditions    = send;
+    _receive.conditions = receive;
+    _send.rng           = send.seed ? Rng(send.seed, 1) : Random::Stream("NetConditions.send");
+    _receive.rng        = receive.seed ? Rng(receive.seed, 2) : Random::Stream("NetConditions.receive");
+}
+
+void ImpairedTransport::SetClock(Clock clock) { _clock = std::move(clock); }
+
+ImpairedTransport::Stats ImpairedTransport::GetStats() const {
+    Stats stats  = _stats;
+    stats.queued = static_cast<uint32_t>(_send.queue.size() + _receive.queue.size());
+    return stats;
+}
+
+bool ImpairedTransport::Host(uint16_t port) {
+    _clearQueues();
+    return _inner->Host(port);
+}
+
+bool ImpairedTransport::Connect(const std::string &address, uint16_t port) {
+    _clearQueues();
+    return _inner->Connect(address, port);
+}
+
+void ImpairedTransport::Disconnect() {
+    // Whatever was sent before the disconnect goes out now, delay or not: ReliableTransport's
+    // goodbye is in there, and the inner transport is about to close the socket under it
+    TransportEvent event;
+    while (_pop(_send, UINT64_MAX, event))
+        _sendNow(event);
+    _clearQueues();
+    _inner->Disconnect();
+}
+
+void ImpairedTransport::Send(Net::Peer peer, std::span<const uint8_t> data, NetChannel channel) {
+    if (!_send.conditions.Active() && _send.queue.empty()) {
+        _inner->Send(peer, data, channel);
+        return;
+    }
+    TransportEvent event;
+    event.type    = TransportEvent::Receive;
+    event.peer    = peer;
+    event.data    = PacketPool::Copy(data);
+    event.channel = channel;
+    _schedule(_send, std::move(event));
+}
+
+void ImpairedTransport::Broadcast(std::span<const uint8_t> data, NetChannel channel) {
+    Send(BROADCAST, data, channel);
+}
+
+void ImpairedTransport::Poll(std::vector<TransportEvent> &out) {
+    const uint64_t now = _clock();
+
+    TransportEvent event;
+    while (_pop(_send, now, event))
+        _sendNow(event);
+
+    _incoming.clear();
+    _inner->Poll(_incoming);
+    for (TransportEvent &incoming : _incoming) {
+        if (!_receive.conditions.Active() && _receive.queue.empty())
+            out.push_back(std::move(incoming));
+        else
+            _schedule(_receive, std::move(incoming));
+    }
+    _incoming.clear();
+
+    while (_pop(_receive, now, event))
+        out.push_back(std::move(event));
+}
+
+void ImpairedTransport::_schedule(Link &link, TransportEvent &&event) {
+    const NetConditions &conditions = link.conditions;
+    const uint64_t       now        = _clock();
+    // Connection events travel with the reliable stream so they never pass its data
+    const bool ordered = isReliable(event.channel) || event.type != TransportEvent::Receive;
+
+    if (!ordered && link.rng.Chance(conditions.loss)) {
+        ++_stats.dropped;
+        return;
+    }
+
+    uint64_t start = now;
+    if (conditions.bandwidth > 0) {
+        link.freeAt = std::max(link.freeAt, now) + event.data.Size() * 1000000ull / conditions.bandwidth;
+        start       = link.freeAt;
+    }
+
+    const bool copy = !ordered && link.rng.Chance(conditions.duplicate);
+    for (int i = copy ? 2 : 1; i > 0; --i) {
+        uint64_t release = start + toMicroseconds(conditions.latencyMs);
+        if (conditions.jitterMs > 0.0f)
+            release += toMicroseconds(link.rng.Float() * conditions.jitterMs);
+        if (ordered) {
+            release           = std::max(release, link.lastReliable);
+            link.lastReliable = release;
+        } else if (link.rng.Chance(conditions.reorder)) {
+            release += toMicroseconds(conditions.reorderDelayMs);
+            ++_stats.reordered;
+        }
+
+        if (i == 2) {
+            TransportEvent duplicate;
+            duplicate.type    = event.type;
+            duplicate.peer    = event.peer;
+            duplicate.data    = PacketPool::Copy(event.data.Span());
+            duplicate.channel = event.channel;
+            _push(link, release, std::move(duplicate));
+            ++_stats.duplicated;
+        } else {
+            _push(link, release, std::move(event));
+        }
+    }
+}
+
+void ImpairedTransport::_push(Link &link, uint64_t release, TransportEvent &&event) {
+    link.queue.push_back({ release, _sequence++, std::move(event) });
+    std::push_heap(link.queue.begin(), link.queue.end(), releasesLater);
+}
+
+bool ImpairedTransport::_pop(Link &link, uint64_t now, TransportEvent &event) {
+    if (link.queue.empty() || link.queue.front().release > now)
+        return false;
+    std::pop_heap(link.queue.begin(), link.queue.end(), releasesLater);
+    event = std::move(link.queue.back().event);
+    link.queue.pop_back();
+    return true;
+}
+
+void ImpairedTransport::_sendNow(const TransportEvent &event) {
+    if (event.peer == BROADCAST)
+        _inner->Broadcast(event.data.Span(), event.channel);
+    else
+        _inner->Send(event.peer, event.data.Span(), event.channel);
+}
+
+void ImpairedTransport::_clearQueues() {
+    _send.queue.clear();
+    _receive.queue.clear();
+    _send.freeAt = _send.lastReliable = 0;
+    _receive.freeAt = _receive.lastReliable = 0;
+}
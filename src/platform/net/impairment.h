@@ -0,0 +1,94 @@
+#pragma once
+
+// Network condition simulator: an ITransport that wraps another one (the real backend or a
+// loopback endpoint) and applies latency, jitter, loss, reordering, duplication and a bandwidth
+// cap, separately for what it sends and what it receives. Net::SetConditions installs one over
+// the active transport; tests wrap loopback endpoints directly and drive its clock by hand.
+//
+// Loss, duplication and reordering only touch unreliable packets: whatever travels on a reliable
+// channel keeps its guarantee (delivered once, in order), it just arrives later. Below a
+// ReliableTransport (see ReliableTransport::Impair) every packet is an unreliable datagram, so
+// the reliability layer gets to deal with all of it. Delayed packets are released from Poll, so
+// their timing resolves to one Net::Update.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "platform/net/itransport.h"
+#include "util/random.h"
+
+/// @cond INTERNAL
+class ImpairedTransport : public ITransport {
+public:
+    /// Microseconds on any monotonic timeline; steady_clock unless SetClock replaces it.
+    using Clock = std::function<uint64_t()>;
+
+    struct Stats {
+        uint64_t dropped    = 0;
+        uint64_t duplicated = 0;
+        uint64_t reordered  = 0;
+        uint32_t queued     = 0; ///< Packets and events waiting to be released, both directions
+    };
+
+    explicit ImpairedTransport(std::unique_ptr<ITransport> inner);
+    ~ImpairedTransport() override;
+
+    void SetConditions(const NetConditions &send, const NetConditions &receive);
+    void SetClock(Clock clock);
+
+    Stats       GetStats() const;
+    ITransport &Inner() { return *_inner; }
+
+    bool Host(uint16_t port) override;
+    bool Connect(const std::string &address, uint16_t port) override;
+    void Disconnect() override;
+
+    bool      IsServer() const override { return _inner->IsServer(); }
+    bool      IsClient() const override { return _inner->IsClient(); }
+    Net::Peer SelfId() const override { return _inner->SelfId(); }
+    uint32_t  PeerCount() const override { return _inner->PeerCount(); }
+    uint32_t  Ping(Net::Peer peer) const override { return _inner->Ping(peer); }
+
+    void Send(Net::Peer peer, std::span<const uint8_t> data, NetChannel channel) override;
+    void Broadcast(std::span<const uint8_t> data, NetChannel channel) override;
+    void Poll(std::vector<TransportEvent> &out) override;
+    void DropPeer(Net::Peer peer) override { _inner->DropPeer(peer); }
+
+    uint32_t MaxPacketSize() const override { return _inner->MaxPacketSize(); }
+    void     CollectStats(std::vector<NetPeerStats> &out) const override { _inner->CollectStats(out); }
+
+private:
+    struct Pending {
+        uint64_t       release;
+        uint64_t       sequence; // ties release in arrival order
+        TransportEvent event;    // Receive for a send; peer == BROADCAST for a broadcast
+    };
+
+    // One direction: its conditions, random stream and queue of held-back packets
+    struct Link {
+        NetConditions        conditions;
+        Rng                  rng;
+        uint64_t             freeAt       = 0; // bandwidth: when the packets already queued have gone out
+        uint64_t             lastReliable = 0; // reliable packets and connection events never overtake each other
+        std::vector<Pending> queue;            // min-heap on (release, sequence)
+    };
+
+    static constexpr Net::Peer BROADCAST = ~Net::Peer(0);
+
+    void _schedule(Link &link, TransportEvent &&event);
+    void _push(Link &link, uint64_t release, TransportEvent &&event);
+    bool _pop(Link &link, uint64_t now, TransportEvent &event);
+    void _sendNow(const TransportEvent &event);
+    void _clearQueues();
+
+    std::unique_ptr<ITransport> _inner;
+    Clock                       _clock;
+    Link                        _send;
+    Link                        _receive;
+    uint64_t                    _sequence = 0;
+    Stats                       _stats;
+    std::vector<TransportEvent> _incoming; // scratch for the inner Poll
+};
+/// @endcond
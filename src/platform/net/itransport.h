@@ -3,12 +3,22 @@
 // Internal swappable transport behind the typed Net:: API. One backend is active at a
 // time (native SDL_net, or a web WebSocket backend later). net.cpp drives it; user code
 // never sees this. Messages are opaque byte blobs ([typeId][payload], built by net.cpp).
+//
+// Transports stack: ReliableTransport (reliable.h) provides the NetChannel guarantees over any
+// transport that just moves datagrams, ImpairedTransport (impairment.h) degrades whatever it
+// wraps, and LoopbackNetwork (loopback.h) endpoints stand in for sockets.
+//
+// Nothing on this interface allocates per message: sends take a span the transport copies or
+// writes out before returning, and received payloads arrive in PacketPool buffers that go back
+// to the pool when net.cpp clears its event list.
 
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "platform/net/net.h" // Net::Peer
+#include "platform/net/packetpool.h"
 
 /// @cond INTERNAL
 
@@ -16,11 +26,15 @@ struct TransportEvent {
     enum Type { Connect,
         Disconnect,
         Receive } type;
-    Net::Peer            peer = 0;
-    std::vector<uint8_t> data; // payload for Receive
-    bool                 reliable = false;
+    Net::Peer    peer = 0;
+    PacketBuffer data; // payload for Receive
+    NetChannel   channel = NetChannel::Unreliable;
 };
 
+inline bool isReliable(NetChannel channel) {
+    return channel == NetChannel::ReliableOrdered || channel == NetChannel::ReliableUnordered;
+}
+
 class ITransport {
 public:
     virtual ~ITransport() = default;
@@ -35,10 +49,21 @@ public:
     virtual uint32_t  PeerCount() const          = 0;
     virtual uint32_t  Ping(Net::Peer peer) const = 0;
 
-    virtual void Send(Net::Peer peer, const void *data, uint32_t size, bool reliable) = 0;
-    virtual void Broadcast(const void *data, uint32_t size, bool reliable)            = 0;
+    virtual void Send(Net::Peer peer, std::span<const uint8_t> data, NetChannel channel) = 0;
+    virtual void Broadcast(std::span<const uint8_t> data, NetChannel channel)            = 0;
+
+    // Largest message that still goes out as one packet on the wire; Net fills batches up to it
+    virtual uint32_t MaxPacketSize() const { return 1200; }
+
+    // Appends the wire statistics of every connected peer: running totals, histograms and queue
+    // depths (Net derives the rates and loss). A transport that tracks none appends nothing.
+    virtual void CollectStats(std::vector<NetPeerStats> &) const { }
+
+    // Forget a peer (server side): a layer above decided it's gone. No Disconnect event follows.
+    virtual void DropPeer(Net::Peer) { }
 
-    // Poll sockets; append connect/disconnect/receive events since the last call.
+    // Poll sockets; append connect/disconnect/receive events since the last call. `out` is
+    // reused across calls, so its capacity settles after the first busy frames.
     virtual void Poll(std::vector<TransportEvent> &out) = 0;
 };
 
@@ -0,0 +1,179 @@
+#include "platform/net/loopback.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+class LoopbackEndpoint;
+} // namespace
+
+// One lock for the whole network: topology changes and deliveries both touch two endpoints
+struct LoopbackNetwork::State {
+    std::mutex                                       mutex;
+    std::unordered_map<uint16_t, LoopbackEndpoint *> hosts;
+    uint64_t                                         packets = 0;
+    uint64_t                                         bytes   = 0;
+};
+
+namespace {
+class LoopbackEndpoint final : public ITransport {
+public:
+    explicit LoopbackEndpoint(std::shared_ptr<LoopbackNetwork::State> state)
+        : _state(std::move(state)) { }
+
+    ~LoopbackEndpoint() override { Disconnect(); }
+
+    bool Host(uint16_t port) override {
+        std::lock_guard lock(_state->mutex);
+        _disconnect();
+        if (!_state->hosts.emplace(port, this).second)
+            return false; // someone already listens there
+        _isServer = true;
+        _port     = port;
+        return true;
+    }
+
+    bool Connect(const std::string &, uint16_t port) override {
+        std::lock_guard lock(_state->mutex);
+        _disconnect();
+        auto it = _state->hosts.find(port);
+        if (it == _state->hosts.end())
+            return false;
+
+        LoopbackEndpoint *server = it->second;
+        _selfId                  = server->_nextId++;
+        _server                  = server;
+        _isClient                = true;
+        server->_peers[_selfId]  = this;
+        server->_event(TransportEvent::Connect, _selfId);
+        return true;
+    }
+
+    void Disconnect() override {
+        std::lock_guard lock(_state->mutex);
+        _disconnect();
+    }
+
+    bool IsServer() const override { return _isServer; }
+    bool IsClient() const override { return _isClient; }
+
+    Net::Peer SelfId() const override {
+        std::lock_guard lock(_state->mutex);
+        return _selfId;
+    }
+
+    uint32_t PeerCount() const override {
+        std::lock_guard lock(_state->mutex);
+        return _isServer ? static_cast<uint32_t>(_peers.size()) : (_server ? 1 : 0);
+    }
+
+    uint32_t Ping(Net::Peer) const override { return 0; }
+
+    void Send(Net::Peer peer, std::span<const uint8_t> data, NetChannel channel) override {
+        std::lock_guard lock(_state->mutex);
+        if (_isServer) {
+            auto it = _peers.find(peer);
+            if (it != _peers.end())
+                it->second->_deliver(Net::SERVER_PEER, data, channel);
+        } else if (_server) {
+            _server->_deliver(_selfId, data, channel);
+        }
+    }
+
+    void Broadcast(std::span<const uint8_t> data, NetChannel channel) override {
+        std::lock_guard lock(_state->mutex);
+        if (_isServer) {
+            for (auto &[id, client] : _peers)
+                client->_deliver(Net::SERVER_PEER, data, channel);
+        } else if (_server) {
+            _server->_deliver(_selfId, data, channel);
+        }
+    }
+
+    void Poll(std::vector<TransportEvent> &out) override {
+        std::lock_guard lock(_state->mutex);
+        for (TransportEvent &event : _inbox)
+            out.push_back(std::move(event));
+        _inbox.clear();
+    }
+
+    // The client sees the server go away, as if it had been kicked
+    void DropPeer(Net::Peer peer) override {
+        std::lock_guard lock(_state->mutex);
+        auto            it = _peers.find(peer);
+        if (!_isServer || it == _peers.end())
+            return;
+        it->second->_server = nullptr;
+        it->second->_event(TransportEvent::Disconnect, Net::SERVER_PEER);
+        _peers.erase(it);
+    }
+
+private:
+    // Everything below runs with the network lock held
+
+    void _deliver(Net::Peer from, std::span<const uint8_t> data, NetChannel channel) {
+        TransportEvent event;
+        event.type    = TransportEvent::Receive;
+        event.peer    = from;
+        event.data    = PacketPool::Copy(data);
+        event.channel = channel;
+        _inbox.push_back(std::move(event));
+        ++_state->packets;
+        _state->bytes += data.size();
+    }
+
+    void _event(TransportEvent::Type type, Net::Peer peer) {
+        TransportEvent event;
+        event.type = type;
+        event.peer = peer;
+        _inbox.push_back(std::move(event));
+    }
+
+    void _disconnect() {
+        if (_isServer) {
+            for (auto &[id, client] : _peers) {
+                client->_server = nullptr;
+                client->_event(TransportEvent::Disconnect, Net::SERVER_PEER);
+            }
+            _peers.clear();
+            _state->hosts.erase(_port);
+        } else if (_server) {
+            _server->_peers.erase(_selfId);
+            _server->_event(TransportEvent::Disconnect, _selfId);
+        }
+        _inbox.clear();
+        _server   = nullptr;
+        _isServer = _isClient = false;
+        _selfId               = 0;
+        _nextId               = 1;
+        _port                 = 0;
+    }
+
+    std::shared_ptr<LoopbackNetwork::State>           _state;
+    bool                                              _isServer = false, _isClient = false;
+    uint16_t                                          _port   = 0;
+    Net::Peer                                         _selfId = 0;
+    Net::Peer                                         _nextId = 1;
+    LoopbackEndpoint                                 *_server = nullptr; // client: the host it joined
+    std::unordered_map<Net::Peer, LoopbackEndpoint *> _peers;            // server: connected clients
+    std::vector<TransportEvent>                       _inbox;
+};
+} // namespace
+
+LoopbackNetwork::LoopbackNetwork()
+    : _state(std::make_shared<State>()) { }
+
+LoopbackNetwork::~LoopbackNetwork() = default;
+
+std::unique_ptr<ITransport> LoopbackNetwork::CreateEndpoint() { return std::make_unique<LoopbackEndpoint>(_state); }
+
+uint64_t LoopbackNetwork::GetPacketsDelivered() const {
+    std::lock_guard lock(_state->mutex);
+    return _state->packets;
+}
+
+uint64_t LoopbackNetwork::GetBytesDelivered() const {
+    std::lock_guard lock(_state->mutex);
+    return _state->bytes;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// In-process network: every endpoint is an ITransport, and endpoints of one LoopbackNetwork reach
+// each other through memory queues instead of sockets. Host(port) listens on a port of the
+// network; Connect(anyAddress, port) joins that host. Peer ids, connect/disconnect events and
+// channels behave as with the SDL_net backend, so Net runs on an endpoint unchanged
+// (Net::UseTransport). Delivery is instant and lossless; wrap an endpoint in an ImpairedTransport
+// for latency, loss and the rest.
+//
+// Thread-safe: endpoints may be driven from different threads.
+
+#include <cstdint>
+#include <memory>
+
+#include "platform/net/itransport.h"
+
+/// @cond INTERNAL
+class LoopbackNetwork {
+public:
+    LoopbackNetwork();
+    ~LoopbackNetwork();
+
+    LoopbackNetwork(const LoopbackNetwork &)            = delete;
+    LoopbackNetwork &operator=(const LoopbackNetwork &) = delete;
+
+    /// A new unconnected endpoint. Endpoints keep the network's queues alive, so either may be destroyed first.
+    std::unique_ptr<ITransport> CreateEndpoint();
+
+    /// Packets delivered between endpoints so far, and their payload bytes.
+    uint64_t GetPacketsDelivered() const;
+    uint64_t GetBytesDelivered() const;
+
+    struct State;
+
+private:
+    std::shared_ptr<State> _state;
+};
+/// @endcond
@@ -1,14 +1,72 @@
 // Net — transport-agnostic core: lifecycle, typed-message framing + dispatch. The actual
-// sockets live behind ITransport (see sdl/ and webgpu/). Wire format for a typed message is
-// [uint32 typeId][payload bytes]; net.cpp adds/peels the prefix and routes to handlers.
+// sockets live behind ITransport (see sdl/ and webgpu/). A packet holds one typed message,
+// [uint32 typeId][payload bytes], or a batch of them:
+//
+//   [uint32 BATCH_ID] then per message [uint32 size][uint32 typeId][payload], each record
+//   starting 4-aligned so payloads of 4-aligned types can still be read in place.
+//
+// Sends are queued per peer and channel and coalesced into batches up to the transport's
+// packet size, flushed at the end of Update. Batch bytes keep their capacity and received
+// packets arrive in PacketPool buffers, so the steady-state send/receive path doesn't allocate.
+//
+// Statistics: messages are counted per type as they are queued and dispatched; per-peer wire
+// counters live in the transport (ITransport::CollectStats). Once per stats window Update turns
+// both into the rates of the NetStats snapshot.
 
 #include "platform/net/net.h"
+#include "platform/net/impairment.h"
 #include "platform/net/itransport.h"
+#include "platform/net/packetpool.h"
+#include "platform/net/reliable.h"
 #include "core/log/log.h"
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <unordered_map>
 #include <vector>
 
+namespace {
+constexpr uint32_t BATCH_ID    = 0; // no FNV-1a type name hashes to 0 in practice
+constexpr uint32_t RECORD_SIZE = 2 * sizeof(uint32_t);
+
+uint64_t batchKey(Net::Peer peer, bool broadcast, NetChannel channel) {
+    return static_cast<uint64_t>(peer) << 8 | static_cast<uint64_t>(broadcast) << 7 | static_cast<uint64_t>(channel);
+}
+
+uint64_t steadyMicroseconds() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+void count(NetCounter &counter, uint32_t bytes) {
+    counter.bytes += bytes;
+    ++counter.count;
+}
+
+// Per-second rates of `now` from the totals at the start of a window `seconds` long
+void rate(NetCounter &now, const NetCounter &start, double seconds) {
+    now.bytesPerSecond = static_cast<float>((now.bytes - std::min(start.bytes, now.bytes)) / seconds);
+    now.countPerSecond = static_cast<float>((now.count - std::min(start.count, now.count)) / seconds);
+}
+
+void rate(NetTraffic &now, const NetTraffic &start, double seconds) {
+    rate(now.in, start.in, seconds);
+    rate(now.out, start.out, seconds);
+}
+
+void add(NetCounter &sum, const NetCounter &counter) {
+    sum.bytes += counter.bytes;
+    sum.count += counter.count;
+    sum.bytesPerSecond += counter.bytesPerSecond;
+    sum.countPerSecond += counter.countPerSecond;
+}
+} // namespace
+
+Net::Net() {
+    PacketPool::Get(); // constructed first so it outlives the buffers Net still holds at exit
+}
+
 bool Net::_ensureTransport() {
     if (!_transport)
         _transport = createTransport();
@@ -24,12 +82,39 @@ bool Net::_init() {
 }
 
 void Net::_shutdown() {
+    _flush();
+    _useTransport(nullptr);
+    _handlers.clear();
+}
+
+void Net::_useTransport(ITransport *transport) {
     if (_transport) {
         _transport->Disconnect();
-        delete _transport;
-        _transport = nullptr;
+        delete _transport; // an ImpairedTransport deletes the backend it wraps
     }
-    _handlers.clear();
+    _transport = transport;
+    _impaired  = nullptr;
+    _batches.clear();
+    _stats.traffic = {};
+    _stats.peers.clear();
+    std::fill(std::begin(_queuedUnicast), std::end(_queuedUnicast), 0);
+    std::fill(std::begin(_queuedBroadcast), std::end(_queuedBroadcast), false);
+}
+
+void Net::_setConditions(const NetConditions &send, const NetConditions &receive) {
+    if (!_impaired) {
+        if (!send.Active() && !receive.Active())
+            return;
+        if (!_ensureTransport())
+            return;
+        if (auto *reliable = dynamic_cast<ReliableTransport *>(_transport)) {
+            _impaired = &reliable->Impair(); // impair the datagrams, so the channels see real loss
+        } else {
+            _impaired  = new ImpairedTransport(std::unique_ptr<ITransport>(_transport));
+            _transport = _impaired;
+        }
+    }
+    _impaired->SetConditions(send, receive);
 }
 
 bool Net::_host(uint16_t port) {
@@ -41,8 +126,11 @@ bool Net::_connect(const std::string &address, uint16_t port) {
 }
 
 void Net::_disconnect() {
-    if (_transport)
-        _transport->Disconnect();
+    if (!_transport)
+        return;
+    _flush(); // best effort: what was queued goes out before the goodbye
+    _transport->Disconnect();
+    _batches.clear();
 }
 
 void Net::_update() {
@@ -52,18 +140,91 @@ void Net::_update() {
     events.clear();
     _transport->Poll(events);
     for (const TransportEvent &e : events) {
-        if (e.type != TransportEvent::Receive)
+        if (e.type == TransportEvent::Disconnect) {
+            for (uint32_t channel = 0; channel < 4; ++channel) {
+                auto it = _batches.find(batchKey(e.peer, false, static_cast<NetChannel>(channel)));
+                if (it == _batches.end())
+                    continue;
+                if (it->second.count > 0)
+                    --_queuedUnicast[channel];
+                _batches.erase(it);
+            }
             continue;
-        if (e.data.size() < sizeof(uint32_t))
+        }
+        if (e.type != TransportEvent::Receive || e.data.Size() < sizeof(uint32_t))
             continue;
         uint32_t typeId;
-        std::memcpy(&typeId, e.data.data(), sizeof(uint32_t));
-        auto it = _handlers.find(typeId);
-        if (it == _handlers.end())
+        std::memcpy(&typeId, e.data.Data(), sizeof(uint32_t));
+        if (typeId != BATCH_ID) {
+            // The payload sits 16-byte aligned in the pooled buffer; typed handlers read it in place
+            _dispatch(e.peer, typeId, e.data.Data() + sizeof(uint32_t), e.data.Size() - (uint32_t)sizeof(uint32_t));
             continue;
-        it->second(e.peer, e.data.data() + sizeof(uint32_t),
-            (uint32_t)(e.data.size() - sizeof(uint32_t)));
+        }
+        uint32_t offset = sizeof(uint32_t);
+        while (offset + RECORD_SIZE <= e.data.Size()) {
+            uint32_t size;
+            std::memcpy(&size, e.data.Data() + offset, sizeof(uint32_t));
+            std::memcpy(&typeId, e.data.Data() + offset + sizeof(uint32_t), sizeof(uint32_t));
+            offset += RECORD_SIZE;
+            if (size > e.data.Size() - offset)
+                break; // truncated: drop the rest
+            _dispatch(e.peer, typeId, e.data.Data() + offset, size);
+            offset = (offset + size + 3) & ~3u;
+        }
     }
+    events.clear(); // hand the buffers back to the pool now rather than next frame
+    _flush();
+    _updateStats();
+}
+
+void Net::_updateStats() {
+    const uint64_t now = steadyMicroseconds();
+    if (_statsWindowStart == 0)
+        _statsWindowStart = now;
+    const double seconds = static_cast<double>(now - _statsWindowStart) / 1.0e6;
+    if (seconds < NetStats::WINDOW_SECONDS)
+        return;
+    _statsWindowStart = now;
+
+    // Peers: the transport's totals, against the previous snapshot of the same peer (both sorted)
+    _peerScratch.clear();
+    _transport->CollectStats(_peerScratch);
+    std::sort(_peerScratch.begin(), _peerScratch.end(), [](const NetPeerStats &a, const NetPeerStats &b) { return a.peer < b.peer; });
+    _stats.traffic = {};
+    auto previous  = _stats.peers.begin();
+    for (NetPeerStats &peer : _peerScratch) {
+        while (previous != _stats.peers.end() && previous->peer < peer.peer)
+            ++previous;
+        const bool         known = previous != _stats.peers.end() && previous->peer == peer.peer;
+        const NetPeerStats start = known ? *previous : NetPeerStats {};
+        rate(peer.traffic, start.traffic, seconds);
+        const uint64_t acked = peer.packetsAcked - std::min(start.packetsAcked, peer.packetsAcked);
+        const uint64_t lost  = peer.packetsLost - std::min(start.packetsLost, peer.packetsLost);
+        peer.loss            = acked + lost > 0 ? static_cast<float>(lost) / static_cast<float>(acked + lost) : 0.0f;
+        add(_stats.traffic.in, peer.traffic.in);
+        add(_stats.traffic.out, peer.traffic.out);
+    }
+    _stats.peers.swap(_peerScratch);
+
+    _stats.messages.clear();
+    for (auto &[id, counters] : _messageCounters) {
+        NetMessageStats &message = _stats.messages.emplace_back();
+        message.id               = id;
+        message.traffic          = counters.live;
+        rate(message.traffic, counters.windowStart, seconds);
+        counters.windowStart = counters.live;
+    }
+    std::sort(_stats.messages.begin(), _stats.messages.end(), [](const NetMessageStats &a, const NetMessageStats &b) {
+        return a.traffic.in.bytesPerSecond + a.traffic.out.bytesPerSecond > b.traffic.in.bytesPerSecond + b.traffic.out.bytesPerSecond;
+    });
+}
+
+void Net::_dispatch(Peer peer, uint32_t typeId, const uint8_t *payload, uint32_t size) {
+    auto it = _handlers.find(typeId);
+    if (it == _handlers.end())
+        return; // not counted either: a peer sending made-up ids mustn't grow the stats
+    count(_messageCounters[typeId].live.in, size);
+    it->second(peer, payload, size);
 }
 
 bool      Net::_isServer() { return _transport && _transport->IsServer(); }
@@ -72,27 +233,110 @@ Net::Peer Net::_getClientID() { return _transport ? _transport->SelfId() : 0; }
 uint32_t  Net::_getPeerCount() { return _transport ? _transport->PeerCount() : 0; }
 uint32_t  Net::_getPing(Peer peer) { return _transport ? _transport->Ping(peer) : 0; }
 
-// Build [typeId][payload] once, reused by send + broadcast.
-static std::vector<uint8_t> frame(uint32_t typeId, const void *data, uint32_t size) {
-    std::vector<uint8_t> buf(sizeof(uint32_t) + size);
-    std::memcpy(buf.data(), &typeId, sizeof(uint32_t));
+// Build [typeId][payload] in a pooled buffer, for a message too large to share a packet.
+static PacketBuffer frame(uint32_t typeId, const void *data, uint32_t size) {
+    PacketBuffer buf = PacketPool::Acquire(sizeof(uint32_t) + size);
+    std::memcpy(buf.Data(), &typeId, sizeof(uint32_t));
     if (size)
-        std::memcpy(buf.data() + sizeof(uint32_t), data, size);
+        std::memcpy(buf.Data() + sizeof(uint32_t), data, size);
     return buf;
 }
 
-void Net::_sendRaw(Peer peer, uint32_t typeId, const void *data, uint32_t size, bool reliable) {
+void Net::_sendRaw(Peer peer, uint32_t typeId, const void *data, uint32_t size, NetChannel channel) {
+    _queue(peer, false, typeId, data, size, channel);
+}
+
+void Net::_broadcastRaw(uint32_t typeId, const void *data, uint32_t size, NetChannel channel) {
+    _queue(SERVER_PEER, true, typeId, data, size, channel);
+}
+
+void Net::_queue(Peer peer, bool broadcast, uint32_t typeId, const void *data, uint32_t size, NetChannel channel) {
     if (!_transport)
         return;
-    auto buf = frame(typeId, data, size);
-    _transport->Send(peer, buf.data(), (uint32_t)buf.size(), reliable);
+    count(_messageCounters[typeId].live.out, size);
+
+    // A peer must see sends and broadcasts on one channel in call order: switching between the
+    // two sends what the other has queued first
+    const auto index = static_cast<size_t>(channel);
+    if (broadcast ? _queuedUnicast[index] > 0 : _queuedBroadcast[index])
+        _flushChannel(channel, !broadcast);
+
+    Batch &batch = _batches[batchKey(peer, broadcast, channel)];
+    if (batch.bytes.capacity() == 0) {
+        batch.peer      = peer;
+        batch.broadcast = broadcast;
+        batch.channel   = channel;
+        batch.bytes.reserve(_transport->MaxPacketSize());
+    }
+
+    const uint32_t limit  = _transport->MaxPacketSize();
+    const uint32_t header = sizeof(uint32_t) + RECORD_SIZE;
+    if (header + size > limit) { // travels alone (the transport fragments it), after what's queued
+        _flushBatch(batch);
+        PacketBuffer buf = frame(typeId, data, size);
+        if (broadcast)
+            _transport->Broadcast(buf.Span(), channel);
+        else
+            _transport->Send(peer, buf.Span(), channel);
+        return;
+    }
+
+    size_t offset = (batch.bytes.size() + 3) & ~size_t(3);
+    if (batch.count > 0 && offset + RECORD_SIZE + size > limit) {
+        _flushBatch(batch);
+        offset = 0;
+    }
+    if (batch.count == 0) {
+        batch.bytes.resize(sizeof(uint32_t));
+        std::memcpy(batch.bytes.data(), &BATCH_ID, sizeof(uint32_t));
+        offset = sizeof(uint32_t);
+        if (broadcast)
+            _queuedBroadcast[index] = true;
+        else
+            ++_queuedUnicast[index];
+    }
+    batch.bytes.resize(offset + RECORD_SIZE + size);
+    uint8_t *record = batch.bytes.data() + offset;
+    std::memcpy(record, &size, sizeof(uint32_t));
+    std::memcpy(record + sizeof(uint32_t), &typeId, sizeof(uint32_t));
+    if (size)
+        std::memcpy(record + RECORD_SIZE, data, size);
+    ++batch.count;
+}
+
+void Net::_flushBatch(Batch &batch) {
+    if (batch.count == 0)
+        return;
+
+    // A lone message goes out as plain [typeId][payload]: skip the batch id and its size
+    std::span<const uint8_t> packet(batch.bytes);
+    if (batch.count == 1)
+        packet = packet.subspan(sizeof(uint32_t) + sizeof(uint32_t));
+    if (batch.broadcast)
+        _transport->Broadcast(packet, batch.channel);
+    else
+        _transport->Send(batch.peer, packet, batch.channel);
+
+    const auto index = static_cast<size_t>(batch.channel);
+    if (batch.broadcast)
+        _queuedBroadcast[index] = false;
+    else
+        --_queuedUnicast[index];
+    batch.count = 0;
+    batch.bytes.clear();
+}
+
+void Net::_flushChannel(NetChannel channel, bool broadcast) {
+    for (auto &[key, batch] : _batches)
+        if (batch.channel == channel && batch.broadcast == broadcast)
+            _flushBatch(batch);
 }
 
-void Net::_broadcastRaw(uint32_t typeId, const void *data, uint32_t size, bool reliable) {
+void Net::_flush() {
     if (!_transport)
         return;
-    auto buf = frame(typeId, data, size);
-    _transport->Broadcast(buf.data(), (uint32_t)buf.size(), reliable);
+    for (auto &[key, batch] : _batches)
+        _flushBatch(batch);
 }
 
 void Net::_registerRaw(uint32_t typeId, std::function<void(Peer, const void *, uint32_t)> handler) {
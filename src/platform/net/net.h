@@ -7,30 +7,152 @@
 //
 //   1. Typed high-level API (Net::Send<T> / RegisterMessage<T> / ...): strongly-typed
 //      POD packet structs, auto-dispatched by type. For new games. Sits on a swappable
-//      ITransport (native SDL_net now: TCP stream = reliable, UDP datagram = unreliable;
-//      browser WebSocket later).
+//      ITransport (native: one SDL_net UDP socket with reliable-ordered, reliable-unordered
+//      and sequenced channels on top, see reliable.h; browser WebSocket later).
 //
 //   2. Net::Udp — a thin raw-datagram path (open/send/recv/resolve) for code that brings
 //      its own protocol + reliability (e.g. Quake's net_dgrm driver). Native only.
 //
-// Serialization is raw memcpy of trivially-copyable structs (all targets little-endian).
+// Messages are queued per peer and channel and go out at the end of Net::Update, coalesced into
+// as few packets as fit (see Net::Flush). Serialization is raw memcpy of trivially-copyable
+// structs (all targets little-endian).
 // Message type IDs are derived from the type name at compile time (both peers must be the
-// same build — fine for a single game).
+// same build — fine for a single game). Send and receive run out of a packet buffer pool
+// (platform/net/packetpool.h): no heap allocation per message once it has warmed up.
 // ─────────────────────────────────────────────────────────────────────────────
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <string>
 #include <functional>
+#include <span>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 /// @cond INTERNAL
 // The transport layer is internal plumbing; only a forward declaration is needed here so
 // the public header never pulls in SDL_net / socket types. Mirrors how IGpu is declared.
 class ITransport;
+class ImpairedTransport;
 /// @endcond
 
+/// @brief Delivery guarantee of a message, chosen per send.
+enum class NetChannel : uint8_t {
+    Unreliable,          ///< May be lost, duplicated or arrive out of order (Net::Send). Cheapest.
+    UnreliableSequenced, ///< May be lost; anything older than the newest message already received is dropped.
+    ReliableUnordered,   ///< Arrives exactly once, as soon as it's complete; no wait on earlier messages.
+    ReliableOrdered,     ///< Arrives exactly once, in send order (Net::SendReliable).
+};
+
+/// @brief Simulated network conditions for one direction (see Net::SetConditions).
+///
+/// Loss, duplication and reordering apply to unreliable packets only; reliable ones are
+/// delayed but still arrive once and in order.
+struct NetConditions {
+    float    latencyMs      = 0.0f;  ///< One-way delay added to every packet.
+    float    jitterMs       = 0.0f;  ///< Up to this much extra random delay per packet.
+    float    loss           = 0.0f;  ///< Chance (0..1) that a packet is dropped.
+    float    duplicate      = 0.0f;  ///< Chance (0..1) that a packet is delivered twice.
+    float    reorder        = 0.0f;  ///< Chance (0..1) that a packet is held back behind later ones.
+    float    reorderDelayMs = 20.0f; ///< How long a reordered packet is held back.
+    uint32_t bandwidth      = 0;     ///< Bytes per second; packets queue behind each other. 0 = unlimited.
+    uint64_t seed           = 0;     ///< Random seed for the above; 0 uses a stream of the engine's Random seed.
+
+    /// @brief True if any condition is set.
+    bool Active() const {
+        return latencyMs > 0.0f || jitterMs > 0.0f || loss > 0.0f || duplicate > 0.0f || reorder > 0.0f || bandwidth > 0;
+    }
+};
+
+/// @brief Millisecond samples counted in power-of-two buckets.
+///
+/// Bucket 0 holds samples under 1 ms, bucket i those in [2^(i-1), 2^i) ms, the last one
+/// everything from 2^(BUCKETS-2) ms up.
+struct NetHistogram {
+    static constexpr uint32_t BUCKETS = 12;
+
+    uint32_t counts[BUCKETS] = {};
+
+    void Add(double ms) {
+        const uint32_t whole = ms < 1.0 ? 0 : static_cast<uint32_t>(std::min(ms, 65535.0));
+        ++counts[std::min<uint32_t>(std::bit_width(whole), BUCKETS - 1)];
+    }
+
+    uint32_t Total() const {
+        uint32_t total = 0;
+        for (uint32_t count : counts)
+            total += count;
+        return total;
+    }
+
+    /// @brief Upper edge in ms of the bucket holding the given fraction (0..1) of samples; 0 if empty.
+    float Percentile(float fraction) const {
+        const uint32_t total = Total();
+        if (total == 0)
+            return 0.0f;
+        const auto target = static_cast<uint32_t>(std::ceil(fraction * static_cast<float>(total)));
+        uint32_t   seen   = 0;
+        for (uint32_t bucket = 0; bucket < BUCKETS; ++bucket)
+            if ((seen += counts[bucket]) >= std::max(target, 1u))
+                return static_cast<float>(1u << bucket);
+        return static_cast<float>(1u << (BUCKETS - 1));
+    }
+};
+
+/// @brief Totals in one direction, and their rate over the last stats window.
+struct NetCounter {
+    uint64_t bytes          = 0;
+    uint64_t count          = 0; ///< Packets for a peer, messages for a message type.
+    float    bytesPerSecond = 0.0f;
+    float    countPerSecond = 0.0f;
+};
+
+/// @brief Incoming and outgoing traffic.
+struct NetTraffic {
+    NetCounter in;
+    NetCounter out;
+};
+
+/// @brief Connection statistics for one peer (see Net::GetStats).
+///
+/// Traffic is counted on the wire: headers, acks, keepalives and resends included.
+struct NetPeerStats {
+    uint32_t     peer = 0;
+    NetTraffic   traffic;
+    uint32_t     rttMs        = 0;    ///< Smoothed round-trip time.
+    uint32_t     jitterMs     = 0;    ///< Smoothed deviation of the round-trip time.
+    uint64_t     resends      = 0;    ///< Reliable fragments sent again after the retransmission timeout.
+    uint64_t     packetsAcked = 0;
+    uint64_t     packetsLost  = 0;    ///< Packets the far side never acked.
+    float        loss         = 0.0f; ///< Share of the packets resolved in the last window that were lost.
+    uint32_t     inFlight     = 0;    ///< Reliable messages sent and not yet fully acked.
+    uint32_t     backlog      = 0;    ///< Reliable messages waiting for room in the send window.
+    NetHistogram rtt;                 ///< Every round-trip sample since the connection opened.
+    NetHistogram jitter;              ///< Each sample's distance from the smoothed round-trip time.
+};
+
+/// @brief Traffic of one message type, identified by its wire id (Net::MessageId<T>, or the id given to SendBytes).
+///
+/// Outgoing messages count once per Send or Broadcast call, before coalescing.
+struct NetMessageStats {
+    uint32_t   id = 0;
+    NetTraffic traffic;
+};
+
+/// @brief Network statistics, refreshed once per window during Net::Update.
+struct NetStats {
+    static constexpr double WINDOW_SECONDS = 1.0;
+
+    NetTraffic                   traffic;  ///< Sum over the connected peers.
+    std::vector<NetPeerStats>    peers;    ///< Ascending peer id.
+    std::vector<NetMessageStats> messages; ///< Busiest first, by bytes per second in and out.
+};
+
 /// @brief High-level client/server networking.
 class Net {
 public:
@@ -56,16 +178,26 @@ public:
     /// @return True on success.
     static bool Host(uint16_t port) { return Get()._host(port); }
     /// @brief Becomes a client and connects to a server.
+    ///
+    /// The handshake completes during Update: GetPeerCount() turns 1 once the server accepts,
+    /// and reliable messages sent before that go out then.
     /// @param address Server host name or IP.
     /// @param port Server port.
-    /// @return True on success.
+    /// @return True if the address resolved and the attempt started.
     static bool Connect(const std::string &address, uint16_t port) { return Get()._connect(address, port); }
     /// @brief Disconnects from the current session (server or client).
     static void Disconnect() { Get()._disconnect(); }
 
-    /// @brief Polls the transport and dispatches received messages to their handlers. Call each frame.
+    /// @brief Polls the transport, dispatches received messages to their handlers, then sends the
+    ///        messages queued since the last Update. Call each frame.
     static void Update() { Get()._update(); }
 
+    /// @brief Sends the messages queued so far now instead of at the end of the next Update.
+    ///
+    /// Sends are batched: every message for the same peer and channel within a tick shares
+    /// packets, up to the transport's packet size. Flushing early costs more packets.
+    static void Flush() { Get()._flush(); }
+
     /// @brief Returns true if this peer is acting as the server.
     static bool IsServer() { return Get()._isServer(); }
     /// @brief Returns true if this peer is acting as a client.
@@ -75,10 +207,24 @@ public:
     static Peer GetClientID() { return Get()._getClientID(); }
     /// @brief Returns the number of currently connected peers.
     static uint32_t GetPeerCount() { return Get()._getPeerCount(); }
-    /// @brief Returns the round-trip time to a peer in milliseconds (0 if unknown).
+    /// @brief Returns the smoothed round-trip time to a peer in milliseconds (0 if unknown).
     /// @param peer The peer to query.
     static uint32_t GetPing(Peer peer) { return Get()._getPing(peer); }
 
+    /// @brief Traffic, loss, round-trip and queue statistics per peer and per message type.
+    ///
+    /// Counting is always on and costs a few increments per packet; the snapshot returned here
+    /// is refreshed once per NetStats::WINDOW_SECONDS during Update.
+    static const NetStats &GetStats() { return Get()._stats; }
+
+    /// @brief Simulates a bad connection on top of the active transport: latency, jitter, loss,
+    ///        duplication, reordering and a bandwidth cap.
+    ///
+    /// Delayed packets go out and come in during Update. Pass default conditions to turn it off.
+    /// @param send Applied to everything this peer sends.
+    /// @param receive Applied to everything this peer receives.
+    static void SetConditions(const NetConditions &send, const NetConditions &receive = {}) { Get()._setConditions(send, receive); }
+
     // ── Typed messaging ───────────────────────────────────────────────────────
     /// @brief Sends a packet to a peer over the unreliable channel.
     /// @tparam T Trivially-copyable packet type.
@@ -87,7 +233,7 @@ public:
     template <typename T>
     static void Send(Peer peer, const T &packet) {
         static_assert(std::is_trivially_copyable_v<T>, "Net packet must be trivially copyable");
-        Get()._sendRaw(peer, _typeId<T>(), &packet, sizeof(T), false);
+        Get()._sendRaw(peer, _typeId<T>(), &packet, sizeof(T), NetChannel::Unreliable);
     }
 
     /// @brief Sends a packet to a peer over the reliable channel.
@@ -97,7 +243,18 @@ public:
     template <typename T>
     static void SendReliable(Peer peer, const T &packet) {
         static_assert(std::is_trivially_copyable_v<T>, "Net packet must be trivially copyable");
-        Get()._sendRaw(peer, _typeId<T>(), &packet, sizeof(T), true);
+        Get()._sendRaw(peer, _typeId<T>(), &packet, sizeof(T), NetChannel::ReliableOrdered);
+    }
+
+    /// @brief Sends a packet to a peer on the given channel.
+    /// @tparam T Trivially-copyable packet type.
+    /// @param peer Destination peer.
+    /// @param packet The packet to send.
+    /// @param channel Delivery guarantee.
+    template <typename T>
+    static void Send(Peer peer, const T &packet, NetChannel channel) {
+        static_assert(std::is_trivially_copyable_v<T>, "Net packet must be trivially copyable");
+        Get()._sendRaw(peer, _typeId<T>(), &packet, sizeof(T), channel);
     }
 
     /// @brief Sends a packet to all connected peers over the unreliable channel.
@@ -106,7 +263,7 @@ public:
     template <typename T>
     static void Broadcast(const T &packet) {
         static_assert(std::is_trivially_copyable_v<T>, "Net packet must be trivially copyable");
-        Get()._broadcastRaw(_typeId<T>(), &packet, sizeof(T), false);
+        Get()._broadcastRaw(_typeId<T>(), &packet, sizeof(T), NetChannel::Unreliable);
     }
 
     /// @brief Sends a packet to all connected peers over the reliable channel.
@@ -115,25 +272,83 @@ public:
     template <typename T>
     static void BroadcastReliable(const T &packet) {
         static_assert(std::is_trivially_copyable_v<T>, "Net packet must be trivially copyable");
-        Get()._broadcastRaw(_typeId<T>(), &packet, sizeof(T), true);
+        Get()._broadcastRaw(_typeId<T>(), &packet, sizeof(T), NetChannel::ReliableOrdered);
+    }
+
+    /// @brief Sends a packet to all connected peers on the given channel.
+    /// @tparam T Trivially-copyable packet type.
+    /// @param packet The packet to broadcast.
+    /// @param channel Delivery guarantee.
+    template <typename T>
+    static void Broadcast(const T &packet, NetChannel channel) {
+        static_assert(std::is_trivially_copyable_v<T>, "Net packet must be trivially copyable");
+        Get()._broadcastRaw(_typeId<T>(), &packet, sizeof(T), channel);
+    }
+
+    /// @brief Sends a variable-size message: raw bytes under an id of the caller's choosing.
+    ///
+    /// For payloads that aren't one fixed struct (replication snapshots, see replication.h).
+    /// Take the id from MessageId<SomeTag>() so it can't collide with a typed message.
+    /// @param peer Destination peer.
+    /// @param id Message id, matched by OnBytes on the other side.
+    /// @param bytes The payload.
+    /// @param channel Delivery guarantee.
+    static void SendBytes(Peer peer, uint32_t id, std::span<const uint8_t> bytes, NetChannel channel) {
+        Get()._sendRaw(peer, id, bytes.data(), static_cast<uint32_t>(bytes.size()), channel);
+    }
+
+    /// @brief Registers a handler for messages sent with SendBytes under `id`.
+    /// @param id Message id.
+    /// @param handler Receives the sender and a view of the payload, valid for the call.
+    static void OnBytes(uint32_t id, std::function<void(Peer, std::span<const uint8_t>)> handler) {
+        Get()._registerRaw(id, [handler = std::move(handler)](Peer peer, const void *data, uint32_t size) {
+            handler(peer, { static_cast<const uint8_t *>(data), size });
+        });
     }
 
     /// @brief Registers a handler invoked whenever a packet of type T arrives.
+    ///
+    /// The packet is a view into the receive buffer (copied to the stack only if T needs more
+    /// than 4-byte alignment, or 16 for a message that had a packet to itself): valid for the
+    /// duration of the call, copy it to keep it.
     /// @tparam T Trivially-copyable packet type (its type id is derived at compile time).
-    /// @param handler Callback receiving the sender peer and the decoded packet.
-    template <typename T>
-    static void RegisterMessage(MessageHandler<T> handler) {
+    /// @param handler Any callable taking (Peer, const T &); stored as is, without a std::function wrapper.
+    template <typename T, typename F>
+    static void On(F &&handler) {
         static_assert(std::is_trivially_copyable_v<T>, "Net packet must be trivially copyable");
+        static_assert(std::is_invocable_v<F &, Peer, const T &>, "Net::On handler must take (Net::Peer, const T &)");
         Get()._registerRaw(_typeId<T>(),
-            [handler](Peer peer, const void *data, uint32_t size) {
+            [handler = std::forward<F>(handler)](Peer peer, const void *data, uint32_t size) mutable {
                 if (size != sizeof(T))
                     return;
-                T packet;
-                std::memcpy(&packet, data, sizeof(T));
-                handler(peer, packet);
+                if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0) {
+                    handler(peer, *static_cast<const T *>(data));
+                } else {
+                    T packet;
+                    std::memcpy(&packet, data, sizeof(T));
+                    handler(peer, packet);
+                }
             });
     }
 
+    /// @brief Registers a handler invoked whenever a packet of type T arrives (see On).
+    /// @tparam T Trivially-copyable packet type (its type id is derived at compile time).
+    /// @param handler Callback receiving the sender peer and the decoded packet.
+    template <typename T>
+    static void RegisterMessage(MessageHandler<T> handler) {
+        On<T>(std::move(handler));
+    }
+
+    /// @cond INTERNAL
+    // Replaces the backend transport and takes ownership (a loopback endpoint in tests and
+    // benchmarks; see platform/net/loopback.h). Handlers stay registered.
+    static void UseTransport(ITransport *transport) { Get()._useTransport(transport); }
+    /// @endcond
+
+    /// @brief The wire id of message type T, as listed in NetStats::messages.
+    template <typename T>
+    static constexpr uint32_t MessageId() { return _typeId<T>(); }
+
     // ── Thin raw-UDP path (native only) ───────────────────────────────────────
     // For protocols that do their own packet format + reliability (Quake's net_dgrm).
     // Opaque handles — no SDL_net types leak out.
@@ -231,16 +446,50 @@ private:
     Peer     _getClientID();
     uint32_t _getPeerCount();
     uint32_t _getPing(Peer peer);
+    void     _setConditions(const NetConditions &send, const NetConditions &receive);
+    void     _useTransport(ITransport *transport);
 
     // Transport-agnostic primitives.
-    void _sendRaw(Peer peer, uint32_t typeId, const void *data, uint32_t size, bool reliable);
-    void _broadcastRaw(uint32_t typeId, const void *data, uint32_t size, bool reliable);
+    void _sendRaw(Peer peer, uint32_t typeId, const void *data, uint32_t size, NetChannel channel);
+    void _broadcastRaw(uint32_t typeId, const void *data, uint32_t size, NetChannel channel);
     void _registerRaw(uint32_t typeId, std::function<void(Peer, const void *, uint32_t)> handler);
 
+    // Outgoing messages for one peer (or all of them) on one channel, coalesced until the flush.
+    // The bytes keep their capacity between ticks.
+    struct Batch {
+        Peer                 peer      = 0;
+        bool                 broadcast = false;
+        NetChannel           channel   = NetChannel::Unreliable;
+        uint32_t             count     = 0;
+        std::vector<uint8_t> bytes;
+    };
+
+    void _queue(Peer peer, bool broadcast, uint32_t typeId, const void *data, uint32_t size, NetChannel channel);
+    void _flushBatch(Batch &batch);
+    void _flushChannel(NetChannel channel, bool broadcast);
+    void _flush();
+    void _dispatch(Peer peer, uint32_t typeId, const uint8_t *payload, uint32_t size);
+    void _updateStats();
+
     bool _ensureTransport();
 
     ITransport                                                                     *_transport = nullptr;
+    ImpairedTransport                                                              *_impaired  = nullptr; // wraps the backend while SetConditions is in use
     std::unordered_map<uint32_t, std::function<void(Peer, const void *, uint32_t)>> _handlers;
+    std::unordered_map<uint64_t, Batch>                                             _batches;        // by peer, broadcast flag and channel
+    uint32_t                                                                        _queuedUnicast[4] = {}; // per channel: peers with something queued
+    bool                                                                            _queuedBroadcast[4] = {};
+
+    // Per message type: live totals, and the totals at the start of the current stats window
+    struct MessageCounters {
+        NetTraffic live;
+        NetTraffic windowStart;
+    };
+
+    NetStats                                      _stats;
+    std::unordered_map<uint32_t, MessageCounters> _messageCounters;
+    std::vector<NetPeerStats>                     _peerScratch;
+    uint64_t                                      _statsWindowStart = 0; // microseconds, steady clock
 
 public:
     /// @cond INTERNAL
@@ -253,5 +502,5 @@ public:
     /// @endcond
 
 private:
-    Net() = default;
+    Net();
 };
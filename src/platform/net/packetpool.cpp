@@ -0,0 +1,96 @@
+#include "platform/net/packetpool.h"
+
+#include <cassert>
+#include <cstring>
+#include <new>
+
+PacketPool::~PacketPool() { _trim(); }
+
+void PacketBuffer::Resize(uint32_t size) {
+    assert(size <= Capacity());
+    _size = size;
+}
+
+PacketBuffer PacketPool::Copy(std::span<const uint8_t> bytes) {
+    PacketBuffer buffer = Acquire(static_cast<uint32_t>(bytes.size()));
+    if (!bytes.empty())
+        std::memcpy(buffer.Data(), bytes.data(), bytes.size());
+    return buffer;
+}
+
+uint32_t PacketPool::CapacityOf(const uint8_t *data) { return _blockOf(data)->capacity; }
+
+PacketBuffer PacketPool::_acquire(uint32_t size) {
+    for (uint8_t index = 0; index < CLASS_COUNT; ++index) {
+        if (size > CLASS_SIZES[index])
+            continue;
+
+        SizeClass &sizeClass = _classes[index];
+        Block     *block     = nullptr;
+        {
+            std::lock_guard lock(sizeClass.mutex);
+            if (sizeClass.free) {
+                block          = sizeClass.free;
+                sizeClass.free = block->next;
+                --sizeClass.freeCount;
+            }
+            ++sizeClass.inUse;
+        }
+        if (!block)
+            block = _allocateBlock(CLASS_SIZES[index], index);
+        return { _dataOf(block), size };
+    }
+
+    _oversized.fetch_add(1, std::memory_order_relaxed);
+    return { _dataOf(_allocateBlock(size, OVERSIZED)), size };
+}
+
+void PacketPool::_release(uint8_t *data) {
+    Block *block = _blockOf(data);
+    if (block->sizeClass == OVERSIZED) {
+        ::operator delete(block, std::align_val_t { ALIGNMENT });
+        return;
+    }
+
+    SizeClass      &sizeClass = _classes[block->sizeClass];
+    std::lock_guard lock(sizeClass.mutex);
+    block->next    = sizeClass.free;
+    sizeClass.free = block;
+    ++sizeClass.freeCount;
+    --sizeClass.inUse;
+}
+
+PacketPool::Block *PacketPool::_allocateBlock(uint32_t capacity, uint8_t sizeClass) {
+    _heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void *memory = ::operator new(DATA_OFFSET + capacity, std::align_val_t { ALIGNMENT });
+    return new (memory) Block { nullptr, capacity, sizeClass };
+}
+
+PacketPoolStats PacketPool::_getStats() {
+    PacketPoolStats stats;
+    for (size_t index = 0; index < CLASS_COUNT; ++index) {
+        SizeClass      &sizeClass = _classes[index];
+        std::lock_guard lock(sizeClass.mutex);
+        stats.classes[index] = { CLASS_SIZES[index], sizeClass.inUse, sizeClass.freeCount };
+    }
+    stats.heapAllocations = _heapAllocations.load(std::memory_order_relaxed);
+    stats.oversized       = _oversized.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void PacketPool::_trim() {
+    for (SizeClass &sizeClass : _classes) {
+        Block *block;
+        {
+            std::lock_guard lock(sizeClass.mutex);
+            block               = sizeClass.free;
+            sizeClass.free      = nullptr;
+            sizeClass.freeCount = 0;
+        }
+        while (block) {
+            Block *next = block->next;
+            ::operator delete(block, std::align_val_t { ALIGNMENT });
+            block = next;
+        }
+    }
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+// Size-classed pool of packet buffers for the network path. Net frames outgoing messages into
+// them and transports hand received payloads back in them, so once every class has warmed up a
+// send or receive never reaches malloc. Blocks go back to their class's free list when the
+// PacketBuffer holding them is destroyed, on whichever thread that happens.
+//
+// Payload bytes start 4 bytes short of a 16-byte boundary: after a message's uint32 type id the
+// packet struct is 16-byte aligned, which is what lets typed handlers read it in place.
+//
+// Requests larger than the biggest class get a block of their own that is freed on release.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <utility>
+
+/// @brief Live / pooled block counts of one size class (see PacketPool::GetStats).
+struct PacketPoolClassStats {
+    uint32_t capacity; ///< Bytes per block
+    uint32_t inUse;    ///< Blocks held by PacketBuffers
+    uint32_t free;     ///< Blocks waiting in the free list
+};
+
+/// @brief PacketPool totals.
+struct PacketPoolStats {
+    std::array<PacketPoolClassStats, 6> classes;
+    uint64_t                            heapAllocations = 0; ///< Blocks ever allocated (pool misses and oversized packets)
+    uint64_t                            oversized       = 0; ///< Packets larger than the biggest class
+};
+
+class PacketPool;
+
+/**
+ * @brief Move-only handle to a pooled packet buffer; returns the block to the pool when destroyed.
+ */
+class PacketBuffer {
+public:
+    PacketBuffer() = default;
+    ~PacketBuffer() { Reset(); }
+
+    PacketBuffer(PacketBuffer &&other) noexcept
+        : _data(std::exchange(other._data, nullptr))
+        , _size(std::exchange(other._size, 0)) { }
+
+    PacketBuffer &operator=(PacketBuffer &&other) noexcept {
+        if (this != &other) {
+            Reset();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+        }
+        return *this;
+    }
+
+    PacketBuffer(const PacketBuffer &)            = delete;
+    PacketBuffer &operator=(const PacketBuffer &) = delete;
+
+    uint8_t       *Data() { return _data; }
+    const uint8_t *Data() const { return _data; }
+    uint32_t       Size() const { return _size; }
+    uint32_t       Capacity() const;
+
+    std::span<uint8_t>       Span() { return { _data, _size }; }
+    std::span<const uint8_t> Span() const { return { _data, _size }; }
+
+    /// @brief Changes the size without touching the bytes; must stay within Capacity().
+    void Resize(uint32_t size);
+
+    /// @brief Returns the block to the pool now.
+    void Reset();
+
+    explicit operator bool() const { return _data != nullptr; }
+
+private:
+    friend class PacketPool;
+
+    PacketBuffer(uint8_t *data, uint32_t size)
+        : _data(data)
+        , _size(size) { }
+
+    uint8_t *_data = nullptr;
+    uint32_t _size = 0;
+};
+
+/**
+ * @brief Thread-safe, size-classed packet buffer pool.
+ */
+class PacketPool {
+public:
+    /// @brief Block sizes, smallest first. A request takes the smallest class that fits.
+    static constexpr std::array<uint32_t, 6> CLASS_SIZES = { 64, 256, 1024, 4096, 16384, 65536 };
+
+    /// @brief A buffer of `size` bytes (contents uninitialized), from the free list when one is waiting.
+    static PacketBuffer Acquire(uint32_t size) { return Get()._acquire(size); }
+
+    /// @brief A buffer holding a copy of `bytes`.
+    static PacketBuffer Copy(std::span<const uint8_t> bytes);
+
+    static PacketPoolStats GetStats() { return Get()._getStats(); }
+
+    /// @brief Frees every block waiting in a free list (buffers in use are unaffected).
+    static void Trim() { Get()._trim(); }
+
+    /// @cond INTERNAL
+    static void Release(uint8_t *data) { Get()._release(data); }
+    static uint32_t CapacityOf(const uint8_t *data);
+    /// @endcond
+
+private:
+    static constexpr size_t  CLASS_COUNT = CLASS_SIZES.size();
+    static constexpr uint8_t OVERSIZED   = 0xFF;
+    static constexpr size_t  ALIGNMENT   = 16;
+
+    // Lives in front of each block's payload; the payload starts at DATA_OFFSET
+    struct Block {
+        Block   *next;
+        uint32_t capacity;
+        uint8_t  sizeClass;
+    };
+
+    static constexpr size_t DATA_OFFSET = 2 * ALIGNMENT - sizeof(uint32_t); // payload + 4 is 16-byte aligned
+    static_assert(sizeof(Block) <= DATA_OFFSET);
+    static_assert(std::tuple_size_v<decltype(PacketPoolStats::classes)> == CLASS_COUNT);
+
+    struct SizeClass {
+        std::mutex mutex;
+        Block     *free      = nullptr;
+        uint32_t   freeCount = 0;
+        uint32_t   inUse     = 0;
+    };
+
+    static Block   *_blockOf(const uint8_t *data) { return reinterpret_cast<Block *>(const_cast<uint8_t *>(data) - DATA_OFFSET); }
+    static uint8_t *_dataOf(Block *block) { return reinterpret_cast<uint8_t *>(block) + DATA_OFFSET; }
+
+    PacketBuffer    _acquire(uint32_t size);
+    void            _release(uint8_t *data);
+    PacketPoolStats _getStats();
+    void            _trim();
+    Block          *_allocateBlock(uint32_t capacity, uint8_t sizeClass);
+
+    std::array<SizeClass, CLASS_COUNT> _classes;
+    std::atomic<uint64_t>              _heapAllocations { 0 };
+    std::atomic<uint64_t>              _oversized { 0 };
+
+public:
+    /// @cond INTERNAL
+    PacketPool(const PacketPool &) = delete;
+
+    static PacketPool &Get() {
+        static PacketPool instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    PacketPool() = default;
+    ~PacketPool();
+};
+
+inline uint32_t PacketBuffer::Capacity() const { return _data ? PacketPool::CapacityOf(_data) : 0; }
+
+inline void PacketBuffer::Reset() {
+    if (_data)
+        PacketPool::Release(_data);
+    _data = nullptr;
+    _size = 0;
+}
@@ -0,0 +1,656 @@
+#include "platform/net/reliable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "core/log/log.h"
+#include "platform/net/impairment.h"
+
+namespace {
+constexpr uint32_t MAGIC      = 0x494D554C; // "LUMI"
+constexpr uint32_t VERSION    = 1;
+constexpr uint8_t  FRAGMENTED = 0x80;
+
+constexpr uint64_t MIN_RTO     = 30'000;
+constexpr uint64_t MAX_RTO     = 1'000'000;
+constexpr uint64_t INITIAL_RTO = 200'000;
+constexpr uint64_t MAX_RESEND  = 2'000'000; // backoff stops doubling here
+constexpr uint32_t ACK_EVERY   = 16;        // received packets before an Ack goes out without waiting for Poll
+
+// True if sequence a comes after b, across the 16-bit wrap
+bool newer(uint16_t a, uint16_t b) { return a != b && static_cast<uint16_t>(a - b) < 0x8000; }
+
+uint64_t steadyMicroseconds() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+template <typename T>
+void put(uint8_t *&cursor, T value) {
+    std::memcpy(cursor, &value, sizeof(T));
+    cursor += sizeof(T);
+}
+
+template <typename T>
+T take(const uint8_t *&cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+uint16_t fragmentCount(size_t size) {
+    return size <= ReliableTransport::SINGLE_SIZE
+        ? 1
+        : static_cast<uint16_t>((size + ReliableTransport::FRAGMENT_SIZE - 1) / ReliableTransport::FRAGMENT_SIZE);
+}
+} // namespace
+
+ReliableTransport::ReliableTransport(std::unique_ptr<ITransport> datagrams)
+    : _datagrams(std::move(datagrams))
+    , _clock(steadyMicroseconds) { }
+
+ReliableTransport::~ReliableTransport() { Disconnect(); }
+
+ImpairedTransport &ReliableTransport::Impair() {
+    if (!_impaired) {
+        auto impaired = std::make_unique<ImpairedTransport>(std::move(_datagrams));
+        _impaired     = impaired.get();
+        _datagrams    = std::move(impaired);
+    }
+    return *_impaired;
+}
+
+bool ReliableTransport::Host(uint16_t port) {
+    Disconnect();
+    if (!_datagrams->Host(port))
+        return false;
+    _isServer = true;
+    return true;
+}
+
+bool ReliableTransport::Connect(const std::string &address, uint16_t port) {
+    Disconnect();
+    if (!_datagrams->Connect(address, port))
+        return false;
+    _isClient              = true;
+    Connection &connection = _open(Net::SERVER_PEER);
+    _sendControl(connection, Kind::ConnectRequest, MAGIC, VERSION);
+    connection.lastRequest = connection.started;
+    return true;
+}
+
+void ReliableTransport::Disconnect() {
+    for (auto &[peer, connection] : _connections)
+        if (connection->connected)
+            _sendControl(*connection, Kind::Disconnect);
+    _connections.clear();
+    _datagrams->Disconnect();
+    _isServer = _isClient = false;
+    _selfId               = 0;
+}
+
+uint32_t ReliableTransport::PeerCount() const {
+    uint32_t count = 0;
+    for (const auto &[peer, connection] : _connections)
+        count += connection->connected;
+    return count;
+}
+
+uint32_t ReliableTransport::Ping(Net::Peer peer) const {
+    auto it = _connections.find(peer);
+    return it == _connections.end() ? 0 : static_cast<uint32_t>(it->second->rtt / 1000.0 + 0.5);
+}
+
+void ReliableTransport::CollectStats(std::vector<NetPeerStats> &out) const {
+    for (const auto &[peer, connection] : _connections) {
+        if (!connection->connected)
+            continue;
+        NetPeerStats &stats = out.emplace_back();
+        stats.peer          = peer;
+        stats.traffic       = connection->traffic;
+        stats.rttMs         = static_cast<uint32_t>(connection->rtt / 1000.0 + 0.5);
+        stats.jitterMs      = static_cast<uint32_t>(connection->rttVar / 1000.0 + 0.5);
+        stats.resends       = connection->resends;
+        stats.packetsAcked  = connection->packetsAcked;
+        stats.packetsLost   = connection->packetsLost;
+        stats.rtt           = connection->rttHistogram;
+        stats.jitter        = connection->jitterHistogram;
+        for (const ReliableChannel &channel : connection->reliable) {
+            for (uint16_t id = channel.oldest; id != channel.nextId; ++id)
+                stats.inFlight += channel.out[id % WINDOW].active;
+            stats.backlog += static_cast<uint32_t>(channel.backlog.size());
+        }
+    }
+}
+
+void ReliableTransport::Send(Net::Peer peer, std::span<const uint8_t> data, NetChannel channel) {
+    if (Connection *connection = _find(_isServer ? peer : Net::SERVER_PEER))
+        _sendMessage(*connection, data, channel);
+}
+
+void ReliableTransport::Broadcast(std::span<const uint8_t> data, NetChannel channel) {
+    for (auto &[peer, connection] : _connections)
+        _sendMessage(*connection, data, channel);
+}
+
+void ReliableTransport::Poll(std::vector<TransportEvent> &out) {
+    // Acks owed since the last Poll that no outgoing message has carried in the meantime
+    for (auto &[peer, connection] : _connections)
+        if (connection->unacked)
+            _transmit(*connection, Kind::Ack, {}, NO_MESSAGE, 0);
+
+    _incoming.clear();
+    _datagrams->Poll(_incoming);
+    for (TransportEvent &event : _incoming) {
+        if (event.type == TransportEvent::Receive)
+            _receive(event.peer, event.data.Span(), out);
+        else if (event.type == TransportEvent::Disconnect && _find(event.peer))
+            _close(event.peer, &out);
+    }
+    _incoming.clear();
+
+    _closing.clear();
+    for (auto &[peer, connection] : _connections)
+        _update(*connection);
+    for (Net::Peer peer : _closing) {
+        _close(peer, &out);
+        _datagrams->DropPeer(peer);
+    }
+}
+
+void ReliableTransport::DropPeer(Net::Peer peer) {
+    if (Connection *connection = _find(peer)) {
+        _sendControl(*connection, Kind::Disconnect);
+        _close(peer, nullptr);
+    }
+    _datagrams->DropPeer(peer);
+}
+
+// ── Connections ───────────────────────────────────────────────────────────────
+
+ReliableTransport::Connection *ReliableTransport::_find(Net::Peer peer) {
+    auto it = _connections.find(peer);
+    return it == _connections.end() ? nullptr : it->second.get();
+}
+
+ReliableTransport::Connection &ReliableTransport::_open(Net::Peer peer) {
+    auto connection          = std::make_unique<Connection>();
+    connection->peer         = peer;
+    connection->started      = _clock();
+    connection->lastReceived = connection->started;
+    return *(_connections[peer] = std::move(connection));
+}
+
+void ReliableTransport::_close(Net::Peer peer, std::vector<TransportEvent> *out) {
+    _connections.erase(peer);
+    if (out) {
+        TransportEvent event;
+        event.type = TransportEvent::Disconnect;
+        event.peer = peer;
+        out->push_back(std::move(event));
+    }
+}
+
+void ReliableTransport::_update(Connection &connection) {
+    const uint64_t now = _clock();
+
+    if (!connection.connected) { // a client waiting for ConnectAccept
+        if (now - connection.started > CONNECT_TIMEOUT) {
+            LOG_WARNING("Net: no answer from the server, giving up");
+            _closing.push_back(connection.peer);
+        } else if (now - connection.lastRequest >= CONNECT_RETRY) {
+            _sendControl(connection, Kind::ConnectRequest, MAGIC, VERSION);
+            connection.lastRequest = now;
+        }
+        return;
+    }
+
+    if (now - connection.lastReceived > TIMEOUT) {
+        LOG_WARNING("Net: peer {} timed out", connection.peer);
+        _closing.push_back(connection.peer);
+        return;
+    }
+
+    const uint64_t rto = _retransmitTimeout(connection);
+    for (uint32_t index = 0; index < connection.reliable.size(); ++index) {
+        ReliableChannel &channel = connection.reliable[index];
+
+        size_t queued = 0;
+        while (queued < channel.backlog.size() && static_cast<uint16_t>(channel.nextId - channel.oldest) < WINDOW)
+            _queueReliable(connection, channel, index, std::move(channel.backlog[queued++]), true);
+        channel.backlog.erase(channel.backlog.begin(), channel.backlog.begin() + queued);
+
+        for (uint16_t id = channel.oldest; id != channel.nextId; ++id) {
+            OutMessage &message = channel.out[id % WINDOW];
+            if (message.active && now - message.lastSent >= std::min(rto << std::min(message.sends - 1, 6u), MAX_RESEND))
+                _sendFragments(connection, index, message, true);
+        }
+    }
+
+    if (now - connection.lastSent >= KEEPALIVE)
+        _transmit(connection, Kind::Keepalive, {}, NO_MESSAGE, 0);
+}
+
+uint64_t ReliableTransport::_retransmitTimeout(const Connection &connection) const {
+    if (connection.rtt <= 0.0)
+        return INITIAL_RTO;
+    return std::clamp(static_cast<uint64_t>(connection.rtt + 4.0 * connection.rttVar), MIN_RTO, MAX_RTO);
+}
+
+// ── Receiving ─────────────────────────────────────────────────────────────────
+
+void ReliableTransport::_receive(Net::Peer from, std::span<const uint8_t> datagram, std::vector<TransportEvent> &out) {
+    if (datagram.size() < HEADER_SIZE)
+        return;
+
+    const uint8_t *cursor   = datagram.data();
+    const auto     kind     = static_cast<Kind>(take<uint8_t>(cursor));
+    const uint16_t sequence = take<uint16_t>(cursor);
+    const uint16_t ack      = take<uint16_t>(cursor);
+    const uint32_t ackBits  = take<uint32_t>(cursor);
+    const size_t   bodySize = datagram.size() - HEADER_SIZE;
+
+    Connection *connection = _find(from);
+    if (connection) {
+        connection->traffic.in.bytes += datagram.size();
+        ++connection->traffic.in.count;
+    }
+
+    switch (kind) {
+        case Kind::ConnectRequest: {
+            if (!_isServer || bodySize < 8 || take<uint32_t>(cursor) != MAGIC || take<uint32_t>(cursor) != VERSION) {
+                if (!connection)
+                    _datagrams->DropPeer(from);
+                return;
+            }
+            if (!connection) {
+                connection            = &_open(from);
+                connection->connected = true;
+                TransportEvent event;
+                event.type = TransportEvent::Connect;
+                event.peer = from;
+                out.push_back(std::move(event));
+            }
+            connection->lastReceived = _clock();
+            _sendControl(*connection, Kind::ConnectAccept, MAGIC, from); // again for every repeated request
+            return;
+        }
+
+        case Kind::ConnectAccept: {
+            if (!_isClient || !connection || connection->connected || bodySize < 8 || take<uint32_t>(cursor) != MAGIC)
+                return;
+            _selfId                  = take<uint32_t>(cursor);
+            connection->connected    = true;
+            connection->lastReceived = _clock();
+            TransportEvent event;
+            event.type = TransportEvent::Connect;
+            event.peer = Net::SERVER_PEER;
+            out.push_back(std::move(event));
+
+            // Reliable messages sent while connecting go out now
+            for (uint32_t index = 0; index < connection->reliable.size(); ++index) {
+                ReliableChannel &channel = connection->reliable[index];
+                for (uint16_t id = channel.oldest; id != channel.nextId; ++id)
+                    _sendFragments(*connection, index, channel.out[id % WINDOW], false);
+            }
+            return;
+        }
+
+        case Kind::Disconnect:
+            if (connection) {
+                _close(from, &out);
+                _datagrams->DropPeer(from);
+            }
+            return;
+
+        case Kind::Data:
+        case Kind::Keepalive:
+        case Kind::Ack:
+            break;
+
+        default:
+            return;
+    }
+
+    if (!connection || !connection->connected) {
+        if (!connection && _isServer)
+            _datagrams->DropPeer(from); // traffic from nobody we know: don't let the socket layer keep it
+        return;
+    }
+
+    connection->lastReceived = _clock();
+
+    if (!connection->anyReceived) {
+        connection->remote      = sequence;
+        connection->remoteBits  = 0;
+        connection->anyReceived = true;
+    } else if (newer(sequence, connection->remote)) {
+        const uint16_t shift   = sequence - connection->remote;
+        connection->remoteBits = shift < 32 ? connection->remoteBits << shift : 0;
+        if (shift <= 32)
+            connection->remoteBits |= 1u << (shift - 1); // the previous newest
+        connection->remote = sequence;
+    } else {
+        const uint16_t age = connection->remote - sequence;
+        if (age >= 1 && age <= 32)
+            connection->remoteBits |= 1u << (age - 1);
+    }
+    // A burst that would push packets out of the 33-packet ack range gets acked straight away
+    if (kind != Kind::Ack && ++connection->unacked >= ACK_EVERY)
+        _transmit(*connection, Kind::Ack, {}, NO_MESSAGE, 0);
+
+    _processAcks(*connection, ack, ackBits);
+
+    if (kind == Kind::Data)
+        _receiveData(*connection, { cursor, bodySize }, out);
+}
+
+void ReliableTransport::_processAcks(Connection &connection, uint16_t ack, uint32_t ackBits) {
+    const uint64_t now = _clock();
+    _countLost(connection, ack);
+
+    for (uint32_t age = 0; age <= 32; ++age) {
+        if (age > 0 && !(ackBits & (1u << (age - 1))))
+            continue;
+        const uint16_t sequence = ack - age;
+        SentPacket    &packet   = connection.sent[sequence % SENT_PACKETS];
+        if (!packet.valid || packet.sequence != sequence)
+            continue;
+        packet.valid = false;
+        if (packet.lost) // a straggler carried an older ack
+            --connection.packetsLost;
+        ++connection.packetsAcked;
+
+        // RFC 6298 smoothing
+        const double sample = static_cast<double>(now - packet.sentAt);
+        connection.rttHistogram.Add(sample / 1000.0);
+        if (connection.rtt <= 0.0) {
+            connection.rtt    = sample;
+            connection.rttVar = sample / 2.0;
+        } else {
+            connection.jitterHistogram.Add(std::abs(sample - connection.rtt) / 1000.0);
+            connection.rttVar = 0.75 * connection.rttVar + 0.25 * std::abs(sample - connection.rtt);
+            connection.rtt    = 0.875 * connection.rtt + 0.125 * sample;
+        }
+
+        if (packet.message == NO_MESSAGE)
+            continue;
+        ReliableChannel &channel = connection.reliable[packet.message >> 16];
+        const auto       id      = static_cast<uint16_t>(packet.message);
+        OutMessage      &message = channel.out[id % WINDOW];
+        if (!message.active || message.id != id || message.ackedFragments[packet.fragment])
+            continue;
+        message.ackedFragments.set(packet.fragment);
+        if (++message.acked == message.fragments) {
+            message.active = false;
+            message.data.Reset();
+        }
+    }
+
+    for (ReliableChannel &channel : connection.reliable)
+        while (channel.oldest != channel.nextId && !channel.out[channel.oldest % WINDOW].active)
+            ++channel.oldest;
+}
+
+// Packets the newest ack has moved 33 or more past will never be acked: count the unacked ones
+// as lost. Each sequence is looked at once, as it leaves the range.
+void ReliableTransport::_countLost(Connection &connection, uint16_t ack) {
+    if (!connection.anyAck) {
+        connection.newestAck = ack;
+        connection.anyAck    = true;
+        return;
+    }
+    if (!newer(ack, connection.newestAck))
+        return;
+    const uint16_t end   = ack - 32;
+    uint16_t       first = connection.newestAck - 32;
+    if (static_cast<uint16_t>(end - first) > SENT_PACKETS)
+        first = end - SENT_PACKETS; // older ones have been overwritten in the ring anyway
+    for (uint16_t sequence = first; sequence != end; ++sequence) {
+        SentPacket &packet = connection.sent[sequence % SENT_PACKETS];
+        if (packet.valid && packet.sequence == sequence && !packet.lost) {
+            packet.lost = true;
+            ++connection.packetsLost;
+        }
+    }
+    connection.newestAck = ack;
+}
+
+void ReliableTransport::_receiveData(Connection &connection, std::span<const uint8_t> body, std::vector<TransportEvent> &out) {
+    if (body.size() < 3)
+        return;
+
+    const uint8_t *cursor = body.data();
+    const uint8_t  flags  = take<uint8_t>(cursor);
+    const auto     kind   = static_cast<NetChannel>(flags & ~FRAGMENTED);
+    const uint16_t id     = take<uint16_t>(cursor);
+
+    uint16_t fragment  = 0;
+    uint16_t fragments = 1;
+    if (flags & FRAGMENTED) {
+        if (body.size() < 7)
+            return;
+        fragment  = take<uint16_t>(cursor);
+        fragments = take<uint16_t>(cursor);
+        if (fragments < 2 || fragments > MAX_FRAGMENTS || fragment >= fragments)
+            return;
+    }
+
+    const std::span<const uint8_t> payload(cursor, body.data() + body.size());
+    if (fragments > 1 && (fragment + 1 < fragments ? payload.size() != FRAGMENT_SIZE : payload.size() > FRAGMENT_SIZE))
+        return;
+
+    switch (kind) {
+        case NetChannel::Unreliable:
+        case NetChannel::UnreliableSequenced: {
+            UnreliableChannel &channel   = connection.unreliable[kind == NetChannel::Unreliable ? 0 : 1];
+            const bool         sequenced = kind == NetChannel::UnreliableSequenced;
+            if (sequenced && channel.delivered && !newer(id, channel.lastDelivered))
+                return;
+
+            PacketBuffer data;
+            if (fragments == 1) {
+                data = PacketPool::Copy(payload);
+            } else {
+                InMessage &partial = channel.partial;
+                if (!partial.active || (partial.id != id && newer(id, partial.id)))
+                    _beginMessage(partial, id, fragments);
+                else if (partial.id != id || partial.fragments != fragments)
+                    return; // a fragment of an older message than the one in progress
+                if (!_addFragment(partial, fragment, payload))
+                    return;
+                partial.active = false;
+                data           = std::move(partial.data);
+            }
+            if (sequenced) {
+                channel.lastDelivered = id;
+                channel.delivered     = true;
+            }
+            _deliver(connection.peer, kind, std::move(data), out);
+            return;
+        }
+
+        case NetChannel::ReliableUnordered:
+        case NetChannel::ReliableOrdered: {
+            ReliableChannel &channel = connection.reliable[kind == NetChannel::ReliableUnordered ? 0 : 1];
+            if (static_cast<uint16_t>(id - channel.expected) >= WINDOW)
+                return; // delivered already (a resend whose ack got lost) or beyond the window
+
+            InMessage &message = channel.in[id % WINDOW];
+            if (!message.active || message.id != id)
+                _beginMessage(message, id, fragments);
+            else if (message.complete || message.fragments != fragments)
+                return;
+            if (!_addFragment(message, fragment, payload))
+                return;
+
+            message.complete = true;
+            if (kind == NetChannel::ReliableUnordered)
+                _deliver(connection.peer, kind, std::move(message.data), out);
+
+            // Slide the window over everything complete; the ordered channel delivers here
+            for (;;) {
+                InMessage &next = channel.in[channel.expected % WINDOW];
+                if (!next.active || next.id != channel.expected || !next.complete)
+                    break;
+                if (kind == NetChannel::ReliableOrdered)
+                    _deliver(connection.peer, kind, std::move(next.data), out);
+                next.active = false;
+                next.data.Reset();
+                ++channel.expected;
+            }
+            return;
+        }
+    }
+}
+
+void ReliableTransport::_beginMessage(InMessage &message, uint16_t id, uint16_t fragments) {
+    message.active    = true;
+    message.complete  = false;
+    message.id        = id;
+    message.fragments = fragments;
+    message.received  = 0;
+    message.receivedFragments.reset();
+    message.data.Reset();
+}
+
+bool ReliableTransport::_addFragment(InMessage &message, uint16_t fragment, std::span<const uint8_t> payload) {
+    if (message.receivedFragments[fragment])
+        return false;
+    message.receivedFragments.set(fragment);
+
+    if (message.fragments == 1) {
+        message.data = PacketPool::Copy(payload);
+    } else {
+        if (!message.data)
+            message.data = PacketPool::Acquire(message.fragments * FRAGMENT_SIZE);
+        std::memcpy(message.data.Data() + fragment * FRAGMENT_SIZE, payload.data(), payload.size());
+        if (fragment + 1 == message.fragments)
+            message.data.Resize(fragment * FRAGMENT_SIZE + static_cast<uint32_t>(payload.size()));
+    }
+    return ++message.received == message.fragments;
+}
+
+void ReliableTransport::_deliver(Net::Peer peer, NetChannel channel, PacketBuffer data, std::vector<TransportEvent> &out) {
+    TransportEvent event;
+    event.type    = TransportEvent::Receive;
+    event.peer    = peer;
+    event.data    = std::move(data);
+    event.channel = channel;
+    out.push_back(std::move(event));
+}
+
+// ── Sending ───────────────────────────────────────────────────────────────────
+
+void ReliableTransport::_sendMessage(Connection &connection, std::span<const uint8_t> data, NetChannel channel) {
+    if (data.size() > MAX_FRAGMENTS * FRAGMENT_SIZE) {
+        LOG_WARNING("Net: {} byte message is over the {} byte limit, not sent", data.size(), MAX_FRAGMENTS * FRAGMENT_SIZE);
+        return;
+    }
+
+    if (isReliable(channel)) {
+        const uint32_t   index    = channel == NetChannel::ReliableUnordered ? 0 : 1;
+        ReliableChannel &reliable = connection.reliable[index];
+        if (!reliable.backlog.empty() || static_cast<uint16_t>(reliable.nextId - reliable.oldest) >= WINDOW)
+            reliable.backlog.push_back(PacketPool::Copy(data)); // window full: waits in order
+        else
+            _queueReliable(connection, reliable, index, PacketPool::Copy(data), connection.connected);
+        return;
+    }
+
+    if (!connection.connected)
+        return; // unreliable traffic before the handshake is simply lost
+
+    UnreliableChannel &unreliable = connection.unreliable[channel == NetChannel::Unreliable ? 0 : 1];
+    const uint16_t     id         = unreliable.nextId++;
+    const uint16_t     fragments  = fragmentCount(data.size());
+    for (uint16_t fragment = 0; fragment < fragments; ++fragment) {
+        const size_t offset = static_cast<size_t>(fragment) * FRAGMENT_SIZE;
+        _sendData(connection, channel, id, fragment, fragments,
+            fragments == 1 ? data : data.subspan(offset, std::min<size_t>(FRAGMENT_SIZE, data.size() - offset)), NO_MESSAGE);
+    }
+}
+
+void ReliableTransport::_queueReliable(Connection &connection, ReliableChannel &channel, uint32_t index, PacketBuffer data, bool send) {
+    OutMessage &message = channel.out[channel.nextId % WINDOW];
+    message.active      = true;
+    message.id          = channel.nextId++;
+    message.fragments   = fragmentCount(data.Size());
+    message.acked       = 0;
+    message.ackedFragments.reset();
+    message.lastSent = 0;
+    message.sends    = 0;
+    message.data     = std::move(data);
+    if (send)
+        _sendFragments(connection, index, message, false);
+}
+
+void ReliableTransport::_sendFragments(Connection &connection, uint32_t index, OutMessage &message, bool unackedOnly) {
+    if (!message.active)
+        return;
+    if (message.sends > 0)
+        connection.resends += message.fragments - message.acked;
+    const NetChannel               channel = index == 0 ? NetChannel::ReliableUnordered : NetChannel::ReliableOrdered;
+    const std::span<const uint8_t> data    = message.data.Span();
+    for (uint16_t fragment = 0; fragment < message.fragments; ++fragment) {
+        if (unackedOnly && message.ackedFragments[fragment])
+            continue;
+        const size_t offset = static_cast<size_t>(fragment) * FRAGMENT_SIZE;
+        _sendData(connection, channel, message.id, fragment, message.fragments,
+            message.fragments == 1 ? data : data.subspan(offset, std::min<size_t>(FRAGMENT_SIZE, data.size() - offset)),
+            index << 16 | message.id);
+    }
+    message.lastSent = _clock();
+    ++message.sends;
+}
+
+void ReliableTransport::_sendData(Connection &connection, NetChannel channel, uint16_t id, uint16_t fragment, uint16_t fragments,
+    std::span<const uint8_t> payload, uint32_t message) {
+    uint8_t  body[MTU - HEADER_SIZE];
+    uint8_t *cursor = body;
+    put<uint8_t>(cursor, static_cast<uint8_t>(channel) | (fragments > 1 ? FRAGMENTED : 0));
+    put<uint16_t>(cursor, id);
+    if (fragments > 1) {
+        put<uint16_t>(cursor, fragment);
+        put<uint16_t>(cursor, fragments);
+    }
+    if (!payload.empty())
+        std::memcpy(cursor, payload.data(), payload.size());
+    cursor += payload.size();
+    _transmit(connection, Kind::Data, { body, static_cast<size_t>(cursor - body) }, message, fragment);
+}
+
+void ReliableTransport::_sendControl(Connection &connection, Kind kind, uint32_t a, uint32_t b) {
+    uint8_t  body[8];
+    uint8_t *cursor = body;
+    put<uint32_t>(cursor, a);
+    put<uint32_t>(cursor, b);
+    _transmit(connection, kind, { body, kind == Kind::Disconnect ? size_t(0) : sizeof(body) }, NO_MESSAGE, 0);
+}
+
+void ReliableTransport::_transmit(Connection &connection, Kind kind, std::span<const uint8_t> body, uint32_t message, uint16_t fragment) {
+    const uint64_t now = _clock();
+
+    uint8_t        packet[MTU];
+    uint8_t       *cursor   = packet;
+    const uint16_t sequence = connection.sequence++;
+    put<uint8_t>(cursor, static_cast<uint8_t>(kind));
+    put<uint16_t>(cursor, sequence);
+    put<uint16_t>(cursor, connection.remote);
+    put<uint32_t>(cursor, connection.remoteBits);
+    if (!body.empty())
+        std::memcpy(cursor, body.data(), body.size());
+    cursor += body.size();
+
+    // Data and keepalives are acked at the far end's next Poll; they're what RTT is measured on
+    if (kind == Kind::Data || kind == Kind::Keepalive)
+        connection.sent[sequence % SENT_PACKETS] = { sequence, true, now, message, fragment };
+
+    connection.lastSent   = now;
+    connection.unacked    = 0;
+    connection.traffic.out.bytes += static_cast<uint64_t>(cursor - packet);
+    ++connection.traffic.out.count;
+    _datagrams->Send(connection.peer, { packet, static_cast<size_t>(cursor - packet) }, NetChannel::Unreliable);
+}
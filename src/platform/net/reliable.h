@@ -0,0 +1,204 @@
+#pragma once
+
+// Connection layer that gives every NetChannel its guarantee over a transport that only moves
+// datagrams (one UDP socket natively, a loopback endpoint in tests). Everything it sends below
+// is a NetChannel::Unreliable datagram of at most MTU bytes:
+//
+//   header   u8 kind, u16 sequence, u16 ack, u32 ackBits                     (9 bytes)
+//   Data     u8 channel (| FRAGMENTED), u16 message id,
+//            [u16 fragment index, u16 fragment count], payload up to the end of the datagram
+//   ConnectRequest / ConnectAccept   u32 magic, u32 version / assigned peer id
+//
+// Every datagram carries the sender's packet sequence and acks the last 33 packets it received
+// (ack + a bitfield of the 32 before it), so acks ride along with traffic in both directions;
+// a peer with nothing to send answers with an Ack-only datagram during Poll, or at once after a
+// burst of 16 packets. An acked packet
+// gives an RTT sample (smoothed as in TCP, reported by Ping) and marks the message fragment it
+// carried as delivered. Unacked reliable fragments are resent after the retransmission timeout,
+// doubling per resend. Messages over one datagram are split into FRAGMENT_SIZE pieces and put
+// back together on the far side. A packet that falls out of the ack range unacked counts as
+// lost (CollectStats).
+//
+// Connections: a client repeats ConnectRequest until the server's ConnectAccept (which carries
+// its peer id) or CONNECT_TIMEOUT; keepalives flow while idle, and a peer that is silent for
+// TIMEOUT is dropped. Disconnect tells the other side, best effort.
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "platform/net/itransport.h"
+
+class ImpairedTransport;
+
+/// @cond INTERNAL
+class ReliableTransport : public ITransport {
+public:
+    /// Microseconds on any monotonic timeline; steady_clock unless SetClock replaces it.
+    using Clock = std::function<uint64_t()>;
+
+    static constexpr uint32_t MTU           = 1200; // datagram size limit, safe on every path
+    static constexpr uint32_t HEADER_SIZE   = 9;
+    static constexpr uint32_t SINGLE_SIZE   = MTU - HEADER_SIZE - 3; // payload of an unfragmented Data datagram
+    static constexpr uint32_t FRAGMENT_SIZE = MTU - HEADER_SIZE - 7; // payload of one fragment
+    static constexpr uint32_t MAX_FRAGMENTS = 256;                   // largest message: MAX_FRAGMENTS * FRAGMENT_SIZE
+    static constexpr uint16_t WINDOW        = 256;                   // reliable messages in flight per channel
+
+    static constexpr uint64_t CONNECT_RETRY   = 250'000;
+    static constexpr uint64_t CONNECT_TIMEOUT = 5'000'000;
+    static constexpr uint64_t KEEPALIVE       = 250'000;
+    static constexpr uint64_t TIMEOUT         = 10'000'000;
+
+    explicit ReliableTransport(std::unique_ptr<ITransport> datagrams);
+    ~ReliableTransport() override;
+
+    void SetClock(Clock clock) { _clock = std::move(clock); }
+
+    /// Puts an ImpairedTransport between this layer and its datagrams (once) and returns it.
+    ImpairedTransport &Impair();
+
+    bool Host(uint16_t port) override;
+    bool Connect(const std::string &address, uint16_t port) override;
+    void Disconnect() override;
+
+    bool      IsServer() const override { return _isServer; }
+    bool      IsClient() const override { return _isClient; }
+    Net::Peer SelfId() const override { return _selfId; }
+    uint32_t  PeerCount() const override;
+    uint32_t  Ping(Net::Peer peer) const override;
+
+    void Send(Net::Peer peer, std::span<const uint8_t> data, NetChannel channel) override;
+    void Broadcast(std::span<const uint8_t> data, NetChannel channel) override;
+    void Poll(std::vector<TransportEvent> &out) override;
+    void DropPeer(Net::Peer peer) override;
+
+    uint32_t MaxPacketSize() const override { return SINGLE_SIZE; }
+    void     CollectStats(std::vector<NetPeerStats> &out) const override;
+
+private:
+    enum class Kind : uint8_t { Data, Keepalive, Ack, ConnectRequest, ConnectAccept, Disconnect };
+
+    static constexpr uint16_t SENT_PACKETS = 1024; // ring of sent packets awaiting acks
+    static constexpr uint32_t NO_MESSAGE   = UINT32_MAX;
+
+    struct SentPacket {
+        uint16_t sequence = 0;
+        bool     valid    = false;
+        uint64_t sentAt   = 0;
+        uint32_t message  = NO_MESSAGE; // reliable channel index << 16 | message id
+        uint16_t fragment = 0;
+        bool     lost     = false; // left the ack range unacked; counted in packetsLost
+    };
+
+    // A reliable message until every fragment is acked
+    struct OutMessage {
+        bool                       active    = false;
+        uint16_t                   id        = 0;
+        uint16_t                   fragments = 0;
+        uint16_t                   acked     = 0;
+        std::bitset<MAX_FRAGMENTS> ackedFragments;
+        uint64_t                   lastSent = 0;
+        uint32_t                   sends    = 0;
+        PacketBuffer               data;
+    };
+
+    // A message being reassembled, or (ordered channel) complete and waiting for earlier ones
+    struct InMessage {
+        bool                       active   = false;
+        bool                       complete = false;
+        uint16_t                   id       = 0;
+        uint16_t                   fragments = 0;
+        uint16_t                   received  = 0;
+        std::bitset<MAX_FRAGMENTS> receivedFragments;
+        PacketBuffer               data;
+    };
+
+    struct ReliableChannel {
+        std::array<OutMessage, WINDOW> out;
+        uint16_t                       nextId = 0; // next id to send
+        uint16_t                       oldest = 0; // oldest id not yet fully acked
+        std::vector<PacketBuffer>      backlog;    // waiting for a free window slot
+
+        std::array<InMessage, WINDOW> in;
+        uint16_t                      expected = 0; // next id to deliver (ordered) / window base (unordered)
+    };
+
+    struct UnreliableChannel {
+        uint16_t  nextId = 0;
+        InMessage partial;           // the newest fragmented message
+        uint16_t  lastDelivered = 0; // sequenced: newest id handed out
+        bool      delivered     = false;
+    };
+
+    struct Connection {
+        bool      connected    = false;
+        Net::Peer peer         = 0;
+        uint64_t  started      = 0;
+        uint64_t  lastReceived = 0;
+        uint64_t  lastSent     = 0;
+        uint64_t  lastRequest  = 0;
+
+        uint16_t                             sequence    = 0; // next outgoing packet
+        uint16_t                             remote      = 0; // newest packet received
+        uint32_t                             remoteBits  = 0; // bit n: remote - n - 1 received too
+        bool                                 anyReceived = false;
+        uint32_t                             unacked     = 0; // packets received since we last sent an ack
+        std::array<SentPacket, SENT_PACKETS> sent;
+
+        double rtt    = 0.0; // smoothed, microseconds
+        double rttVar = 0.0;
+
+        // Statistics for CollectStats: totals only, Net turns them into rates
+        NetTraffic   traffic;
+        uint64_t     resends      = 0;
+        uint64_t     packetsAcked = 0;
+        uint64_t     packetsLost  = 0;
+        uint16_t     newestAck    = 0; // newest ack received; packets 33 and more behind it can't be acked any more
+        bool         anyAck       = false;
+        NetHistogram rttHistogram;
+        NetHistogram jitterHistogram;
+
+        std::array<UnreliableChannel, 2> unreliable; // Unreliable, UnreliableSequenced
+        std::array<ReliableChannel, 2>   reliable;   // ReliableUnordered, ReliableOrdered
+    };
+
+    Connection *_find(Net::Peer peer);
+    Connection &_open(Net::Peer peer);
+    void        _close(Net::Peer peer, std::vector<TransportEvent> *out);
+
+    void _receive(Net::Peer from, std::span<const uint8_t> datagram, std::vector<TransportEvent> &out);
+    void _receiveData(Connection &connection, std::span<const uint8_t> body, std::vector<TransportEvent> &out);
+    void _processAcks(Connection &connection, uint16_t ack, uint32_t ackBits);
+    void _countLost(Connection &connection, uint16_t ack);
+    void _update(Connection &connection);
+    void _beginMessage(InMessage &message, uint16_t id, uint16_t fragments);
+    bool _addFragment(InMessage &message, uint16_t fragment, std::span<const uint8_t> payload);
+
+    void _sendMessage(Connection &connection, std::span<const uint8_t> data, NetChannel channel);
+    void _queueReliable(Connection &connection, ReliableChannel &channel, uint32_t index, PacketBuffer data, bool send);
+    void _sendFragments(Connection &connection, uint32_t index, OutMessage &message, bool unackedOnly);
+    void _sendData(Connection &connection, NetChannel channel, uint16_t id, uint16_t fragment, uint16_t fragments,
+        std::span<const uint8_t> payload, uint32_t message);
+    void _sendControl(Connection &connection, Kind kind, uint32_t a = 0, uint32_t b = 0);
+    void _transmit(Connection &connection, Kind kind, std::span<const uint8_t> body, uint32_t message, uint16_t fragment);
+
+    void     _deliver(Net::Peer peer, NetChannel channel, PacketBuffer data, std::vector<TransportEvent> &out);
+    uint64_t _retransmitTimeout(const Connection &connection) const;
+
+    std::unique_ptr<ITransport> _datagrams;
+    ImpairedTransport          *_impaired = nullptr;
+    Clock                       _clock;
+
+    bool      _isServer = false;
+    bool      _isClient = false;
+    Net::Peer _selfId   = 0;
+
+    std::unordered_map<Net::Peer, std::unique_ptr<Connection>> _connections;
+    std::vector<TransportEvent>                                _incoming; // scratch for the datagram Poll
+    std::vector<Net::Peer>                                     _closing;  // timed out during _update
+};
+/// @endcond
@@ -0,0 +1,317 @@
+#include "platform/net/replication.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace {
+struct SnapshotMessage { };
+struct SnapshotAck {
+    uint32_t sequence;
+};
+
+constexpr uint32_t BASELINE_BITS = 6; // sequence - baseline < HISTORY
+static_assert(ReplicationServer::HISTORY == 1u << BASELINE_BITS);
+
+// What the client will decode: only the schema's fields, floats quantized, the rest zero
+void normalize(const ReplicaSchema &schema, const uint8_t *state, uint8_t *out) {
+    std::memset(out, 0, schema.StateSize());
+    for (const ReplicaSchema::Field &field : schema.Fields()) {
+        std::memcpy(out + field.offset, state + field.offset, field.size);
+        for (uint32_t i = 0; i < field.floats; ++i) {
+            float value;
+            std::memcpy(&value, out + field.offset + i * sizeof(float), sizeof(float));
+            value = field.quantizer.Decode(field.quantizer.Encode(value));
+            std::memcpy(out + field.offset + i * sizeof(float), &value, sizeof(float));
+        }
+    }
+}
+
+void writeFull(BitWriter &writer, const ReplicaSchema::Field &field, const uint8_t *state) {
+    if (field.floats == 0) {
+        writer.WriteBytes(state + field.offset, field.size);
+        return;
+    }
+    for (uint32_t i = 0; i < field.floats; ++i) {
+        float value;
+        std::memcpy(&value, state + field.offset + i * sizeof(float), sizeof(float));
+        writer.WriteFloat(value, field.quantizer);
+    }
+}
+
+void readFull(BitReader &reader, const ReplicaSchema::Field &field, uint8_t *state) {
+    if (field.floats == 0) {
+        reader.ReadBytes(state + field.offset, field.size);
+        return;
+    }
+    for (uint32_t i = 0; i < field.floats; ++i) {
+        const float value = reader.ReadFloat(field.quantizer);
+        std::memcpy(state + field.offset + i * sizeof(float), &value, sizeof(float));
+    }
+}
+
+// A raw field as the XOR with its baseline, 4 bytes at a time: the bit count, then the bits
+void writeXor(BitWriter &writer, const ReplicaSchema::Field &field, const uint8_t *state, const uint8_t *baseline) {
+    for (uint32_t offset = 0; offset < field.size; offset += 4) {
+        uint32_t current = 0, previous = 0;
+        const uint32_t chunk = std::min<uint32_t>(4, field.size - offset);
+        std::memcpy(&current, state + field.offset + offset, chunk);
+        std::memcpy(&previous, baseline + field.offset + offset, chunk);
+        const uint32_t diff = current ^ previous;
+        const uint32_t bits = static_cast<uint32_t>(std::bit_width(diff));
+        writer.WriteBits(bits, 6);
+        writer.WriteBits(diff, bits);
+    }
+}
+
+void readXor(BitReader &reader, const ReplicaSchema::Field &field, uint8_t *state) {
+    for (uint32_t offset = 0; offset < field.size; offset += 4) {
+        uint32_t value = 0;
+        const uint32_t chunk = std::min<uint32_t>(4, field.size - offset);
+        std::memcpy(&value, state + field.offset + offset, chunk);
+        const uint32_t bits = std::min<uint32_t>(reader.ReadBits(6), 32);
+        value ^= reader.ReadBits(bits);
+        std::memcpy(state + field.offset + offset, &value, chunk);
+    }
+}
+
+bool fieldChanged(const ReplicaSchema::Field &field, const uint8_t *state, const uint8_t *baseline) {
+    return std::memcmp(state + field.offset, baseline + field.offset, field.size) != 0;
+}
+} // namespace
+
+// ── Server ────────────────────────────────────────────────────────────────────
+
+ReplicationServer::ReplicationServer(ReplicaSchema schema)
+    : _schema(std::move(schema))
+    , _history(HISTORY) { }
+
+void ReplicationServer::Set(uint32_t entity, const void *state) {
+    const uint32_t size = _schema.StateSize();
+    auto           it   = std::lower_bound(_ids.begin(), _ids.end(), entity);
+    const size_t   slot = it - _ids.begin();
+    if (it == _ids.end() || *it != entity) {
+        _ids.insert(it, entity);
+        _states.insert(_states.begin() + slot * size, size, 0);
+    }
+    std::memcpy(_states.data() + slot * size, state, size);
+}
+
+void ReplicationServer::Remove(uint32_t entity) {
+    auto it = std::lower_bound(_ids.begin(), _ids.end(), entity);
+    if (it == _ids.end() || *it != entity)
+        return;
+    const size_t   slot = it - _ids.begin();
+    const uint32_t size = _schema.StateSize();
+    _ids.erase(it);
+    _states.erase(_states.begin() + slot * size, _states.begin() + (slot + 1) * size);
+}
+
+uint32_t ReplicationServer::Capture() {
+    ReplicaSnapshot &snapshot = _history[++_sequence % HISTORY];
+    snapshot.sequence         = _sequence;
+    snapshot.ids.assign(_ids.begin(), _ids.end());
+    snapshot.states.resize(_states.size());
+    for (size_t i = 0; i < snapshot.ids.size(); ++i)
+        normalize(_schema, _states.data() + i * _schema.StateSize(), snapshot.states.data() + i * _schema.StateSize());
+    return _sequence;
+}
+
+const ReplicaSnapshot *ReplicationServer::_baselineFor(Net::Peer peer) const {
+    auto it = _acked.find(peer);
+    if (it == _acked.end() || _sequence - it->second >= HISTORY)
+        return nullptr;
+    const ReplicaSnapshot &snapshot = _history[it->second % HISTORY];
+    return snapshot.sequence == it->second ? &snapshot : nullptr;
+}
+
+void ReplicationServer::Encode(Net::Peer peer, std::vector<uint8_t> &out) {
+    BitWriter writer(out);
+    if (_sequence == 0)
+        return;
+
+    const ReplicaSnapshot &current  = _history[_sequence % HISTORY];
+    const ReplicaSnapshot *baseline = _baselineFor(peer);
+    const uint32_t         size     = _schema.StateSize();
+    const auto            &fields   = _schema.Fields();
+
+    writer.WriteBits(current.sequence, 32);
+    writer.WriteBool(baseline != nullptr);
+    if (baseline)
+        writer.WriteBits(current.sequence - baseline->sequence, BASELINE_BITS);
+
+    static const std::vector<uint32_t> none;
+    const std::vector<uint32_t>       &baseIds = baseline ? baseline->ids : none;
+
+    uint32_t next = 0; // ids are sent as the gap from the previous one + 1
+    auto     entry = [&](uint32_t id) {
+        writer.WriteBool(true);
+        writer.WriteVarUint(id - next);
+        next = id + 1;
+    };
+
+    size_t i = 0, j = 0;
+    while (i < current.ids.size() || j < baseIds.size()) {
+        if (j == baseIds.size() || (i < current.ids.size() && current.ids[i] < baseIds[j])) { // new
+            entry(current.ids[i]);
+            writer.WriteBool(false);
+            writer.WriteBool(false);
+            for (const auto &field : fields)
+                writeFull(writer, field, current.states.data() + i * size);
+            ++i;
+        } else if (i == current.ids.size() || baseIds[j] < current.ids[i]) { // removed
+            entry(baseIds[j]);
+            writer.WriteBool(false);
+            writer.WriteBool(true);
+            ++j;
+        } else {
+            const uint8_t *state = current.states.data() + i * size;
+            const uint8_t *base  = baseline->states.data() + j * size;
+            if (std::memcmp(state, base, size) != 0) {
+                entry(current.ids[i]);
+                writer.WriteBool(true);
+                for (const auto &field : fields)
+                    writer.WriteBool(fieldChanged(field, state, base));
+                for (const auto &field : fields) {
+                    if (!fieldChanged(field, state, base))
+                        continue;
+                    if (field.floats == 0)
+                        writeXor(writer, field, state, base);
+                    else
+                        writeFull(writer, field, state);
+                }
+            }
+            ++i;
+            ++j;
+        }
+    }
+    writer.WriteBool(false);
+}
+
+void ReplicationServer::Acknowledge(Net::Peer peer, uint32_t sequence) {
+    if (sequence == 0 || sequence > _sequence)
+        return;
+    auto [it, added] = _acked.try_emplace(peer, sequence);
+    if (!added && sequence > it->second)
+        it->second = sequence;
+}
+
+void ReplicationServer::Forget(Net::Peer peer) { _acked.erase(peer); }
+
+void ReplicationServer::Send(Net::Peer peer) {
+    Encode(peer, _scratch);
+    if (!_scratch.empty())
+        Net::SendBytes(peer, Net::MessageId<SnapshotMessage>(), _scratch, NetChannel::UnreliableSequenced);
+}
+
+void ReplicationServer::Listen() {
+    Net::On<SnapshotAck>([this](Net::Peer peer, const SnapshotAck &ack) { Acknowledge(peer, ack.sequence); });
+}
+
+// ── Client ────────────────────────────────────────────────────────────────────
+
+ReplicationClient::ReplicationClient(ReplicaSchema schema)
+    : _schema(std::move(schema))
+    , _history(HISTORY + 1) { } // the extra slot is where a snapshot is decoded before it counts
+
+bool ReplicationClient::Decode(std::span<const uint8_t> data, uint32_t &sequence) {
+    BitReader      reader(data);
+    const uint32_t size   = _schema.StateSize();
+    const auto    &fields = _schema.Fields();
+
+    const uint32_t snapshotSequence = reader.ReadBits(32);
+    if (reader.Overflowed() || snapshotSequence == 0 || (_latest != 0 && snapshotSequence <= _latest))
+        return false;
+
+    const ReplicaSnapshot *baseline = nullptr;
+    if (reader.ReadBool()) {
+        const uint32_t         baseSequence = snapshotSequence - reader.ReadBits(BASELINE_BITS);
+        const ReplicaSnapshot &slot         = _history[baseSequence % HISTORY];
+        if (slot.sequence != baseSequence || baseSequence == snapshotSequence)
+            return false; // the baseline is gone: wait for one against something newer
+        baseline = &slot;
+    }
+
+    ReplicaSnapshot &out = _history[HISTORY];
+    out.ids.clear();
+    out.states.clear();
+
+    static const ReplicaSnapshot empty;
+    const ReplicaSnapshot       &base = baseline ? *baseline : empty;
+    size_t                       j    = 0;
+    auto                         keep = [&](size_t index) {
+        out.ids.push_back(base.ids[index]);
+        out.states.insert(out.states.end(), base.states.begin() + index * size, base.states.begin() + (index + 1) * size);
+    };
+
+    uint32_t next = 0;
+    while (reader.ReadBool()) {
+        const uint32_t id = next + reader.ReadVarUint();
+        if (reader.Overflowed() || id < next)
+            return false;
+        next = id + 1;
+        while (j < base.ids.size() && base.ids[j] < id)
+            keep(j++);
+        const bool inBase = j < base.ids.size() && base.ids[j] == id;
+
+        if (reader.ReadBool()) { // delta
+            if (!inBase)
+                return false;
+            keep(j++);
+            uint8_t *state   = out.states.data() + (out.ids.size() - 1) * size;
+            uint64_t changed = 0;
+            for (size_t f = 0; f < fields.size(); ++f)
+                changed |= static_cast<uint64_t>(reader.ReadBool()) << f;
+            for (size_t f = 0; f < fields.size(); ++f) {
+                if (!(changed & (uint64_t(1) << f)))
+                    continue;
+                if (fields[f].floats == 0)
+                    readXor(reader, fields[f], state);
+                else
+                    readFull(reader, fields[f], state);
+            }
+        } else if (reader.ReadBool()) { // removed
+            if (!inBase)
+                return false;
+            ++j;
+        } else { // full
+            if (inBase)
+                ++j;
+            out.ids.push_back(id);
+            out.states.resize(out.states.size() + size, 0);
+            uint8_t *state = out.states.data() + (out.ids.size() - 1) * size;
+            for (const auto &field : fields)
+                readFull(reader, field, state);
+        }
+        if (reader.Overflowed())
+            return false;
+    }
+    while (j < base.ids.size())
+        keep(j++);
+    if (reader.Overflowed())
+        return false;
+
+    out.sequence = snapshotSequence;
+    std::swap(out, _history[snapshotSequence % HISTORY]);
+    _latest  = snapshotSequence;
+    sequence = snapshotSequence;
+    return true;
+}
+
+const void *ReplicationClient::Find(uint32_t entity) const {
+    if (_latest == 0)
+        return nullptr;
+    const ReplicaSnapshot &snapshot = _history[_latest % HISTORY];
+    auto                   it       = std::lower_bound(snapshot.ids.begin(), snapshot.ids.end(), entity);
+    if (it == snapshot.ids.end() || *it != entity)
+        return nullptr;
+    return snapshot.states.data() + (it - snapshot.ids.begin()) * _schema.StateSize();
+}
+
+void ReplicationClient::Listen() {
+    Net::OnBytes(Net::MessageId<SnapshotMessage>(), [this](Net::Peer, std::span<const uint8_t> data) {
+        uint32_t sequence;
+        if (Decode(data, sequence))
+            Net::Send(Net::SERVER_PEER, SnapshotAck { sequence });
+    });
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+// Snapshot replication: the server keeps a world of entities (id → trivially-copyable state
+// struct), captures it into numbered snapshots, and sends each client only what changed since
+// the last snapshot that client acknowledged. Opt-in and separate from the typed messages: the
+// struct's layout is described once by a ReplicaSchema, field by field.
+//
+// Encoding, bit-packed (bitstream.h):
+//
+//   snapshot sequence, [sequence - baseline] or "no baseline",
+//   then per changed entity in id order, each behind a "one more" bit:
+//     id gap, removed | full state | field mask + changed fields
+//
+// Float fields are quantized to the schema's precision; other fields travel as the XOR with
+// their baseline value, significant bits only. Snapshots store what the client will decode
+// (floats quantized, bytes outside the fields zeroed), so server and client baselines are
+// bit-identical and a field counts as changed only if the client would see a difference.
+//
+// A client that acked nothing recent enough gets a full snapshot; the server keeps HISTORY
+// snapshots to delta against, the client as many to decode against. Loss just means the next
+// delta goes against an older baseline.
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "platform/net/bitstream.h"
+#include "platform/net/net.h"
+
+/// @brief Field-by-field layout of a replicated state struct.
+///
+/// Bytes no field covers aren't sent; on the client they stay zero.
+class ReplicaSchema {
+public:
+    static constexpr size_t MAX_FIELDS = 64;
+
+    /// @brief Starts a schema for state struct T; add its fields with Raw, Float and Vector.
+    template <typename T>
+    static ReplicaSchema Of() {
+        static_assert(std::is_trivially_copyable_v<T>, "Replicated state must be trivially copyable");
+        ReplicaSchema schema;
+        schema._stateSize = sizeof(T);
+        return schema;
+    }
+
+    /// @brief A field sent as is (ints, enums, flags, ids), delta-encoded as an XOR with its baseline.
+    template <typename T, typename M>
+    ReplicaSchema &Raw(M T::*member) {
+        static_assert(std::is_trivially_copyable_v<M>);
+        return _add({ _offsetOf(member), sizeof(M), 0, {} });
+    }
+
+    /// @brief A float quantized to `precision` within [min, max].
+    template <typename T>
+    ReplicaSchema &Float(float T::*member, float min, float max, float precision) {
+        return _add({ _offsetOf(member), sizeof(float), 1, { min, max, Quantizer::BitsFor(min, max, precision) } });
+    }
+
+    /// @brief A vector of floats (glm::vec2, float[3], ...), every component quantized alike.
+    template <typename T, typename V>
+    ReplicaSchema &Vector(V T::*member, float min, float max, float precision) {
+        static_assert(sizeof(V) % sizeof(float) == 0, "Vector fields hold floats only");
+        return _add({ _offsetOf(member), sizeof(V), sizeof(V) / sizeof(float), { min, max, Quantizer::BitsFor(min, max, precision) } });
+    }
+
+    uint32_t StateSize() const { return _stateSize; }
+
+    /// @cond INTERNAL
+    struct Field {
+        uint32_t  offset;
+        uint32_t  size;
+        uint32_t  floats; // 0 for a raw field
+        Quantizer quantizer;
+    };
+
+    const std::vector<Field> &Fields() const { return _fields; }
+    /// @endcond
+
+private:
+    ReplicaSchema &_add(const Field &field) {
+        assert(_fields.size() < MAX_FIELDS && field.offset + field.size <= _stateSize);
+        _fields.push_back(field);
+        return *this;
+    }
+
+    template <typename T, typename M>
+    static uint32_t _offsetOf(M T::*member) {
+        union Probe {
+            Probe() { }
+            ~Probe() { }
+            T    object;
+            char bytes[sizeof(T)];
+        } probe;
+        return static_cast<uint32_t>(reinterpret_cast<const char *>(&(probe.object.*member)) - probe.bytes);
+    }
+
+    uint32_t           _stateSize = 0;
+    std::vector<Field> _fields;
+};
+
+/// @cond INTERNAL
+// One captured world: entity ids in ascending order, their states packed alongside
+struct ReplicaSnapshot {
+    uint32_t              sequence = 0; // 0: empty slot
+    std::vector<uint32_t> ids;
+    std::vector<uint8_t>  states;
+};
+/// @endcond
+
+/// @brief Server side: the authoritative world and the per-client delta encoder.
+class ReplicationServer {
+public:
+    static constexpr uint32_t HISTORY = 64; ///< Snapshots kept as baselines (about 1 s at 60 Hz).
+
+    explicit ReplicationServer(ReplicaSchema schema);
+
+    /// @brief Adds or updates an entity; `state` points to the schema's state struct.
+    void Set(uint32_t entity, const void *state);
+    template <typename T>
+    void Set(uint32_t entity, const T &state) { Set(entity, static_cast<const void *>(&state)); }
+    void Remove(uint32_t entity);
+    size_t EntityCount() const { return _ids.size(); }
+
+    /// @brief Freezes the current world as the next snapshot and returns its sequence number.
+    uint32_t Capture();
+
+    /// @brief Encodes the latest snapshot for a peer, against the newest snapshot it acknowledged.
+    void Encode(Net::Peer peer, std::vector<uint8_t> &out);
+    /// @brief Records that a peer decoded a snapshot, making it the peer's baseline.
+    void Acknowledge(Net::Peer peer, uint32_t sequence);
+    /// @brief Drops a peer's baseline (it disconnected); its next snapshot is a full one.
+    void Forget(Net::Peer peer);
+
+    /// @brief Encodes and sends the latest snapshot on NetChannel::UnreliableSequenced.
+    void Send(Net::Peer peer);
+    /// @brief Routes the clients' acknowledgements (sent by ReplicationClient::Listen) to this server.
+    void Listen();
+
+private:
+    const ReplicaSnapshot *_baselineFor(Net::Peer peer) const;
+
+    ReplicaSchema                           _schema;
+    std::vector<uint32_t>                   _ids; // the live world, ascending
+    std::vector<uint8_t>                    _states;
+    std::vector<ReplicaSnapshot>            _history;
+    uint32_t                                _sequence = 0;
+    std::unordered_map<Net::Peer, uint32_t> _acked;
+    std::vector<uint8_t>                    _scratch;
+};
+
+/// @brief Client side: decodes snapshots and holds the replicated world.
+class ReplicationClient {
+public:
+    static constexpr uint32_t HISTORY = ReplicationServer::HISTORY;
+
+    explicit ReplicationClient(ReplicaSchema schema);
+
+    /// @brief Decodes a snapshot from the server.
+    /// @return False if it was stale, malformed or its baseline is gone; otherwise `sequence`
+    ///         is the snapshot to acknowledge.
+    bool Decode(std::span<const uint8_t> data, uint32_t &sequence);
+
+    /// @brief Sequence of the newest decoded snapshot (0 before the first).
+    uint32_t Latest() const { return _latest; }
+
+    /// @brief The entity's state in the newest snapshot, or null.
+    const void *Find(uint32_t entity) const;
+    template <typename T>
+    const T *Find(uint32_t entity) const { return static_cast<const T *>(Find(entity)); }
+
+    /// @brief Calls fn(entity, const void *state) for every entity of the newest snapshot, in id order.
+    template <typename F>
+    void ForEach(F &&fn) const {
+        const ReplicaSnapshot &snapshot = _history[_latest % HISTORY];
+        for (size_t i = 0; i < snapshot.ids.size(); ++i)
+            fn(snapshot.ids[i], snapshot.states.data() + i * _schema.StateSize());
+    }
+
+    /// @brief Decodes snapshots as they arrive through Net and acknowledges each to the server.
+    void Listen();
+
+private:
+    ReplicaSchema                _schema;
+    std::vector<ReplicaSnapshot> _history;
+    uint32_t                     _latest = 0;
+};
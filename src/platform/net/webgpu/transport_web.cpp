@@ -23,8 +23,8 @@ public:
     Net::Peer SelfId() const override { return 0; }
     uint32_t  PeerCount() const override { return 0; }
     uint32_t  Ping(Net::Peer) const override { return 0; }
-    void      Send(Net::Peer, const void *, uint32_t, bool) override { }
-    void      Broadcast(const void *, uint32_t, bool) override { }
+    void      Send(Net::Peer, std::span<const uint8_t>, NetChannel) override { }
+    void      Broadcast(std::span<const uint8_t>, NetChannel) override { }
     void      Poll(std::vector<TransportEvent> &) override { }
 };
 } // namespace
@@ -8,6 +8,9 @@
 #include <unordered_map>
 #include "platform/audio/audio.h"
 
+#include "core/timestep/timestep.h"
+#include "platform/input/replay.h"
+
 #include "assets/assethandler.h"
 
 #include "util/helpers.h"
@@ -15,6 +18,7 @@
 #include "renderer/renderer.h"
 #include "platform/window/window_backend.h"
 #include "profiler/perf.h"
+#include "profiler/profiler.h"
 #include "draw/draw.h"
 
 #include <SDL3_image/SDL_image.h>
@@ -276,6 +280,7 @@ void Window::_processEvent(SDL_Event *event) {
         resizeEventData.emplace("width", event->window.data1);
         resizeEventData.emplace("height", event->window.data2);
         EventBus::Fire(SystemEvent::WINDOW_RESIZE, resizeEventData);
+        EventBus::Emit(WindowResizeEvent { event->window.data1, event->window.data2 });
 
         if (WindowBackend::HandleResize(event->window.data1, event->window.data2, _webGpuScaleMode)) {
             _sizeDirty = true;
@@ -314,6 +319,7 @@ void Window::_processEvent(SDL_Event *event) {
         _setSize(_lastWindowWidth, _lastWindowHeight);
 
         EventBus::Fire(SystemEvent::WINDOW_RESIZE, restoreEventData);
+        EventBus::Emit(WindowResizeEvent { _lastWindowWidth, _lastWindowHeight });
         break;
     }
     case SDL_EventType::SDL_EVENT_TEXT_INPUT:
@@ -484,21 +490,10 @@ void Window::_setSize(int width, int height) {
     _sizeDirty = true;
 }
 
-void Window::_startFrame() {
+void Window::_beginTick() {
+    // Shared per-tick prologue of StartFrame and RenderAll, up to (not including) Renderer::StartFrame
+    LUMI_ZONE("Window::BeginTick");
     _inFrame = true;
-    Lerp::UpdateLerps();
-
-    Window::HandleInput();
-
-    // A pending reset (format/MSAA-class change) needs a full rebuild; a plain resize only
-    // needs the cheap path (camera + window-sized MSAA targets) — pipelines and desktop-sized
-    // targets/geometry survive, so we skip the costly pass release()+init() on resize.
-    if (Renderer::ConsumePendingReset())
-        Renderer::Reset();
-    if (_sizeDirty) {
-        Renderer::OnResize();
-        _sizeDirty = false;
-    }
 
     EngineState::frameCount++;
     EngineState::previousTime = EngineState::currentTime;
@@ -517,6 +512,41 @@ void Window::_startFrame() {
     constexpr double kMaxFrameTime = 0.1;
     EngineState::lastFrameTime     = (EngineState::frameCount <= 1) ? 0.0 : std::min(rawFrameTime, kMaxFrameTime);
 
+    // Record this frame's delta, or swap in the recorded one while replaying
+    Replay::BeginFrame();
+
+    Tween::Update((float)EngineState::lastFrameTime);
+
+    {
+        LUMI_ZONE("Window::HandleInput");
+        Window::HandleInput();
+        Replay::EndInput(); // capture (or replace) the input HandleInput just polled
+    }
+    {
+        LUMI_ZONE("EventBus::Flush");
+        EventBus::Flush(); // events queued last frame (and by this frame's input)
+    }
+
+    // A pending reset (format/MSAA-class change) needs a full rebuild; a plain resize only
+    // needs the cheap path (camera + window-sized MSAA targets) — pipelines and desktop-sized
+    // targets/geometry survive, so we skip the costly pass release()+init() on resize.
+    if (Renderer::ConsumePendingReset())
+        Renderer::Reset();
+    if (_sizeDirty) {
+        Renderer::OnResize();
+        _sizeDirty = false;
+    }
+
+    // Glyphs the font workers finished since last frame go into their atlas pages
+    AssetHandler::UpdateFontAtlases();
+
+    // Fixed-rate simulation ticks due this frame, with this frame's input already applied
+    Timestep::Advance(EngineState::lastFrameTime);
+}
+
+void Window::_startFrame() {
+    _beginTick();
+
     Renderer::StartFrame();
 
     Perf::FrameStart(); // mark the start of this frame's CPU work
@@ -673,27 +703,8 @@ void Window::_renderAll(const std::function<void(WindowHandle)> &fn) {
     // Remember the render callback so the resize event watch can repaint a window mid-drag.
     _renderFn = fn;
 
-    // ── per-tick prologue (mirrors _startFrame up to Renderer::StartFrame) ──────
-    _inFrame = true;
-    Lerp::UpdateLerps();
-    Window::HandleInput();
-
-    if (Renderer::ConsumePendingReset())
-        Renderer::Reset();
-    if (_sizeDirty) {
-        Renderer::OnResize();
-        _sizeDirty = false;
-    }
-
-    EngineState::frameCount++;
-    EngineState::previousTime = EngineState::currentTime;
-    EngineState::currentTime  = std::chrono::high_resolution_clock::now();
-    double rawFrameTime       = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
-                              EngineState::currentTime - EngineState::previousTime)
-                              .count()
-        / 1e9;
-    constexpr double kMaxFrameTime = 0.1;
-    EngineState::lastFrameTime     = (EngineState::frameCount <= 1) ? 0.0 : std::min(rawFrameTime, kMaxFrameTime);
+    // ── per-tick prologue (shared with _startFrame) ─────────────────────────────
+    _beginTick();
 
     Perf::FrameStart();
 
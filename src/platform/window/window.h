@@ -448,6 +448,8 @@ private:
 
     void _setScaledSize(int width, int height, int scale = 0);
 
+    void _beginTick();
+
     void _startFrame();
 
     void _endFrame();
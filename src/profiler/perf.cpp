@@ -8,6 +8,8 @@
 #include "renderer/renderer.h"
 #include "renderer/passes/spriterenderpass.h"
 #include "gpu/presets.h"
+#include "profiler/profiler.h"
+#include "platform/net/net.h"
 
 static const char *kPerfPass = "__perfOverlay__";
 static const char *kPerfFB   = "__perfOverlayFB__";
@@ -211,6 +213,13 @@ static float steppedCeil(float v) {
     return std::ceil(v / step) * step;
 }
 
+void Perf::_setVisible(bool visible) {
+    _visible = visible;
+    Profiler::SetEnabled(visible); // zone statistics only cost anything while someone looks at them
+    if (visible)
+        _ramThrottle = 0; // sample RAM and memory at the next frame end instead of up to 30 frames later
+}
+
 void Perf::_frameStart() {
     _cpuStart = std::chrono::high_resolution_clock::now();
 }
@@ -228,7 +237,13 @@ void Perf::_frameEnd() {
     if (--_ramThrottle <= 0) {
         _ramMB       = _queryRamMB();
         _ramThrottle = 30;
+        if (_visible) {
+            _memory = GpuMemory::GetReport();
+            std::sort(_memory.categories.begin(), _memory.categories.end(),
+                [](const GpuMemoryCategoryStats &a, const GpuMemoryCategoryStats &b) { return a.current > b.current; });
+        }
     }
+    Profiler::EndFrame();
 }
 
 void Perf::_pushFrame(float ms) {
@@ -317,7 +332,19 @@ void Perf::_render() {
     const float panelW = 340.0f, graphH = 46.0f;
     const float headerH = line * 5.0f + pad;                                     // 5 text rows
     const float namesH  = line * 2.0f;                                           // CPU + GPU name rows (bottom)
-    const float panelH  = headerH + (graphH + pad) * 3.0f + namesH + pad * 2.0f; // fps + cpu + gpu graphs
+    const auto &zones   = Profiler::GetTopZones();
+    const float zonesH  = zones.empty() ? 0.0f : line * (float)(zones.size() + 1); // title + one row per zone
+    const auto &passes  = Renderer::GetGpu().ScopeTimings();
+    const int   passN   = std::min((int)passes.size(), PASS_ROWS);
+    const float passesH = passN == 0 ? 0.0f : line * (float)(passN + 1);
+    const int   memN    = std::min((int)_memory.categories.size(), MEM_ROWS);
+    const float memH    = memN == 0 ? 0.0f : line * (float)(memN + 1);
+    const auto &net     = Net::GetStats();
+    const bool  netOn   = _netVisible && !net.peers.empty();
+    const int   msgN    = netOn ? std::min((int)net.messages.size(), NET_ROWS) : 0;
+    const int   peerN   = netOn ? std::min((int)net.peers.size(), NET_ROWS) : 0;
+    const float netH    = netOn ? line * (float)(msgN + peerN + 3) : 0.0f; // two titles + total row
+    const float panelH  = headerH + (graphH + pad) * 3.0f + zonesH + passesH + memH + netH + namesH + pad * 2.0f; // fps + cpu + gpu graphs
     const vf2d  org { 8.0f, 8.0f };
 
     auto        font = AssetHandler::GetDefaultFont();
@@ -327,6 +354,7 @@ void Perf::_render() {
     const Color gpuC { 255, 170, 70, 255 };   // gpu              (orange)
     const Color memC { 200, 170, 255, 255 };  // ram/vram         (violet)
     const Color drawC { 230, 220, 140, 255 }; // draws/tris       (yellow)
+    const Color netC { 255, 140, 180, 255 };  // network          (pink)
     const Color gridC { 40, 70, 90, 255 };    // guide lines
     const Color labelC { 150, 180, 200, 255 };
 
@@ -346,7 +374,7 @@ void Perf::_render() {
     std::snprintf(buf, sizeof(buf), "GPU %.2f ms", _gpuMs);
     Text::DrawText(font, { tx + 165.0f, ty }, buf, gpuC, ts);
     ty += line;
-    std::snprintf(buf, sizeof(buf), "RAM %.0f MB   VRAM %.0f MB", _ramMB, _vramBytes / (1024.0 * 1024.0));
+    std::snprintf(buf, sizeof(buf), "RAM %.0f MB   VRAM %.0f MB", _ramMB, _memory.total.current / (1024.0 * 1024.0));
     Text::DrawText(font, { tx, ty }, buf, memC, ts);
     ty += line;
     std::snprintf(buf, sizeof(buf), "draws %u   tris %.0fk", _drawCalls, (_drawVerts / 3) / 1000.0);
@@ -386,6 +414,74 @@ void Perf::_render() {
     drawGraph(gy, _gpuHist, gpuC, std::max(steppedCeil((float)maxGpu * 1.1f), 1.0f), false, "gpu");
     gy += graphH + pad;
 
+    // Most expensive profiler zones over the last HUD window: ms per frame and calls per frame.
+    if (!zones.empty()) {
+        Text::DrawText(font, { gx, gy }, "zone                      ms/frame  calls", labelC, 14.0f);
+        gy += line;
+        for (const ProfileZoneStats &zone : zones) {
+            std::snprintf(buf, sizeof(buf), "%-26.26s %7.2f %6.0f", zone.name, zone.ms, zone.calls);
+            Text::DrawText(font, { gx, gy }, buf, cpuC, 14.0f);
+            gy += line;
+        }
+    }
+
+    // Per-pass time of the latest finished frame, nested scopes indented. Without timestamp
+    // queries (no backend reads them yet) these are CPU times spent recording each pass.
+    if (passN > 0) {
+        const bool gpuTimed = Renderer::GetGpu().HasGpuTimestamps();
+        Text::DrawText(font, { gx, gy }, gpuTimed ? "pass                       gpu ms" : "pass                       cpu ms (no timestamps)", labelC, 14.0f);
+        gy += line;
+        for (int i = 0; i < passN; i++) {
+            const GpuScopeTiming &pass   = passes[i];
+            const int             indent = (int)std::min(pass.depth, 3u) * 2;
+            std::snprintf(buf, sizeof(buf), "%*s%-*.*s %7.2f", indent, "", 26 - indent, 26 - indent, pass.name ? pass.name : "?", pass.ms);
+            Text::DrawText(font, { gx, gy }, buf, gpuTimed ? gpuC : cpuC, 14.0f);
+            gy += line;
+        }
+    }
+
+    // Tracked memory by category (GpuMemory), largest first; wasted is allocated-but-unused capacity.
+    if (memN > 0) {
+        Text::DrawText(font, { gx, gy }, "memory                 MB    peak  wasted", labelC, 14.0f);
+        gy += line;
+        for (int i = 0; i < memN; i++) {
+            const GpuMemoryCategoryStats &c  = _memory.categories[i];
+            const double                  mb = 1024.0 * 1024.0;
+            std::snprintf(buf, sizeof(buf), "%-18.18s %7.1f %7.1f %7.1f", GpuMemory::CategoryName(c.category), c.current / mb, c.peak / mb, c.wasted / mb);
+            Text::DrawText(font, { gx, gy }, buf, (c.budget && c.current > c.budget) ? gpuC : memC, 14.0f);
+            gy += line;
+        }
+    }
+
+    // Network: wire traffic in total and per message type (once per Send, before coalescing), then
+    // per peer the smoothed RTT and its deviation, the 95th percentile of the RTT histogram, the
+    // share of last second's packets lost, reliable resends and queued reliable messages.
+    if (netOn) {
+        const double kb = 1024.0;
+        Text::DrawText(font, { gx, gy }, "network         in KB/s out KB/s  in/s out/s", labelC, 14.0f);
+        gy += line;
+        std::snprintf(buf, sizeof(buf), "%-14s %8.1f %8.1f %5.0f %5.0f", "total", net.traffic.in.bytesPerSecond / kb,
+            net.traffic.out.bytesPerSecond / kb, net.traffic.in.countPerSecond, net.traffic.out.countPerSecond);
+        Text::DrawText(font, { gx, gy }, buf, netC, 14.0f);
+        gy += line;
+        for (int i = 0; i < msgN; i++) {
+            const NetTraffic &t = net.messages[i].traffic;
+            std::snprintf(buf, sizeof(buf), "msg %08x   %8.1f %8.1f %5.0f %5.0f", net.messages[i].id, t.in.bytesPerSecond / kb,
+                t.out.bytesPerSecond / kb, t.in.countPerSecond, t.out.countPerSecond);
+            Text::DrawText(font, { gx, gy }, buf, netC, 14.0f);
+            gy += line;
+        }
+        Text::DrawText(font, { gx, gy }, "peer    rtt  dev  p95  loss  resends queue", labelC, 14.0f);
+        gy += line;
+        for (int i = 0; i < peerN; i++) {
+            const NetPeerStats &p = net.peers[i];
+            std::snprintf(buf, sizeof(buf), "%-6u %4u %4u %4.0f %4.1f%% %8llu %5u", p.peer, p.rttMs, p.jitterMs, p.rtt.Percentile(0.95f),
+                p.loss * 100.0f, (unsigned long long)p.resends, p.inFlight + p.backlog);
+            Text::DrawText(font, { gx, gy }, buf, p.loss > 0.02f ? gpuC : netC, 14.0f);
+            gy += line;
+        }
+    }
+
     // Hardware names (bottom); GPU line shows the graphics API too.
     float ny = gy;
     Text::DrawText(font, { org.x + pad, ny }, ("CPU: " + cpuName()).c_str(), labelC, 14.0f);
@@ -2,13 +2,20 @@
 #include <chrono>
 #include <cstdint>
 
+#include "gpu/memory/gpumemory.h"
+
 /**
  * Lightweight performance HUD. Custom-drawn (no ImGui) with Draw::/Text:: into the current
  * frame: a translucent panel, a frame-time line graph with scale labels, and FPS / CPU ms /
  * GPU ms / RAM / VRAM readouts. Driven by the engine frame loop:
  *   Window::_startFrame() -> Perf::FrameStart()   (marks the CPU-work start)
  *   Window::_endFrame()   -> Perf::FrameEnd()     (computes CPU ms, samples, draws if visible)
- * GPU ms and VRAM are pushed in by the renderer/backend via ReportGPUms / ReportVRAM.
+ * GPU ms is pushed in by the renderer via ReportGPUms; VRAM and the per-category memory table
+ * come from GpuMemory.
+ * While visible it also turns on Profiler zone statistics and lists the most expensive zones,
+ * and has the renderer time each pass (IGpu timed scopes) for a per-pass GPU breakdown.
+ * While Net has peers, a network section shows its traffic, busiest message types and per-peer
+ * round trip, loss and queues (Net::GetStats).
  */
 class Perf {
 public:
@@ -22,8 +29,6 @@ public:
     static void Render() { Get()._render(); }
     /// @brief Reports GPU frame time in ms (from the renderer's fence timing).
     static void ReportGPUms(double ms) { Get()._gpuMs = ms; }
-    /// @brief Reports current VRAM usage in bytes (from the GPU backend).
-    static void ReportVRAM(int64_t bytes) { Get()._vramBytes = bytes; }
     /// @brief Reports this frame's draw-call and vertex counts.
     /// @param calls Number of draw calls. @param verts Number of vertices submitted.
     static void ReportDraws(uint32_t calls, uint64_t verts) {
@@ -32,11 +37,13 @@ public:
     }
 
     /// @brief Shows or hides the performance HUD.
-    static void SetVisible(bool v) { Get()._visible = v; }
+    static void SetVisible(bool v) { Get()._setVisible(v); }
     /// @brief Toggles HUD visibility.
-    static void Toggle() { Get()._visible = !Get()._visible; }
+    static void Toggle() { Get()._setVisible(!Get()._visible); }
     /// @brief Returns whether the HUD is currently visible.
     static bool Visible() { return Get()._visible; }
+    /// @brief Shows or hides the HUD's network section (shown by default while Net has peers).
+    static void SetNetworkVisible(bool v) { Get()._netVisible = v; }
 
 private:
     Perf() = default;
@@ -45,6 +52,7 @@ private:
         return instance;
     }
 
+    void   _setVisible(bool visible);
     void   _frameStart();
     void   _frameEnd();
     void   _pushFrame(float ms);
@@ -54,14 +62,18 @@ private:
 
     bool _fbReady = false;
 
-    static constexpr int HIST = 128; // frame-time history samples
+    static constexpr int HIST      = 128; // frame-time history samples
+    static constexpr int PASS_ROWS = 10;  // per-pass timing rows shown
+    static constexpr int MEM_ROWS  = 6;   // memory categories shown
+    static constexpr int NET_ROWS  = 4;   // message types, and peers, shown
 
-    bool                                           _visible = false; // toggled by the app (lumiquake: F8)
+    bool                                           _visible    = false; // toggled by the app (lumiquake: F8)
+    bool                                           _netVisible = true;
     std::chrono::high_resolution_clock::time_point _cpuStart;
-    double                                         _cpuMs     = 0.0;
-    double                                         _gpuMs     = 0.0; // set by the renderer (fence timing)
-    int64_t                                        _vramBytes = 0;   // set by the GPU backend (tracked allocations)
-    double                                         _ramMB     = 0.0;
+    double                                         _cpuMs = 0.0;
+    double                                         _gpuMs = 0.0; // set by the renderer (fence timing)
+    double                                         _ramMB = 0.0;
+    GpuMemoryReport                                _memory; // refreshed with the RAM sample
 
     float    _frameMs[HIST] = { 0.0f };
     float    _cpuHist[HIST] = { 0.0f };
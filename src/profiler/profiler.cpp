@@ -0,0 +1,232 @@
+#include "profiler/profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+#include "core/log/log.h"
+#include "util/spscqueue.h"
+
+struct Profiler::ThreadBuffer {
+    SpscQueue<ZoneEvent, RING_SIZE> ring;
+    uint32_t                        index = 0;
+    std::string                     name; // guarded by _threadsMutex
+};
+
+namespace {
+thread_local void *threadBuffer = nullptr; // this thread's Profiler::ThreadBuffer, owned by Profiler
+
+void writeJsonString(FILE *file, const char *text) {
+    std::fputc('"', file);
+    for (const char *c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\')
+            std::fputc('\\', file);
+        if (static_cast<unsigned char>(*c) >= 0x20)
+            std::fputc(*c, file);
+    }
+    std::fputc('"', file);
+}
+} // namespace
+
+Profiler::Profiler()
+    : _anchorTicks(Now())
+    , _anchorTime(std::chrono::steady_clock::now()) { }
+
+Profiler::~Profiler() = default;
+
+void Profiler::_setEnabled(bool enabled) {
+    if (_enabled == enabled)
+        return;
+
+    _enabled = enabled;
+    _totals.clear();
+    _windowFrames = 0;
+    if (!enabled)
+        _topZones.clear();
+    _updateActive();
+}
+
+void Profiler::_beginCapture(size_t maxEvents) {
+    _drain(); // zones recorded before the capture don't belong in it
+
+    _capture.clear();
+    _capture.reserve(std::min<size_t>(maxEvents, size_t(1) << 16));
+    _captureLimit = maxEvents;
+    _capturing    = true;
+    _dropped.store(0, std::memory_order_relaxed);
+    _updateActive();
+}
+
+bool Profiler::_endCapture(const std::string &path) {
+    if (!_capturing)
+        return false;
+
+    _drain();
+    _capturing = false;
+    _updateActive();
+
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        LOG_WARNING("Profiler: can't write {}", path);
+        _capture.clear();
+        return false;
+    }
+
+    const double ticksPerUs = _ticksPerMs() / 1000.0;
+    uint64_t     origin     = UINT64_MAX;
+    for (const CaptureEvent &event : _capture)
+        origin = std::min(origin, event.start);
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    {
+        std::lock_guard lock(_threadsMutex);
+        for (const auto &thread : _threads) {
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", thread->index);
+            writeJsonString(file, thread->name.empty() ? ("Thread " + std::to_string(thread->index)).c_str() : thread->name.c_str());
+            std::fputs("}}", file);
+            first = false;
+        }
+    }
+    for (const CaptureEvent &event : _capture) {
+        std::fputs(first ? "{\"name\":" : ",\n{\"name\":", file);
+        writeJsonString(file, event.name);
+        const double ts = static_cast<double>(event.start - origin) / ticksPerUs;
+        switch (event.kind) {
+            case CaptureEvent::Kind::Zone:
+                std::fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}", ts,
+                    static_cast<double>(event.end - event.start) / ticksPerUs, event.thread);
+                break;
+            case CaptureEvent::Kind::Frame:
+                std::fprintf(file, ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", ts, event.thread);
+                break;
+            case CaptureEvent::Kind::Counter:
+                std::fprintf(file, ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{", ts);
+                writeJsonString(file, event.series);
+                std::fprintf(file, ":%.4f}}", event.value);
+                break;
+        }
+        first = false;
+    }
+    std::fputs("\n]}\n", file);
+    const bool ok = std::fclose(file) == 0;
+
+    LOG_INFO("Profiler: wrote {} zones to {} ({} dropped)", _capture.size(), path, GetDroppedZones());
+    _capture.clear();
+    _capture.shrink_to_fit();
+    return ok;
+}
+
+void Profiler::_setThreadName(const char *name) {
+    ThreadBuffer   &buffer = _threadBuffer();
+    std::lock_guard lock(_threadsMutex);
+    buffer.name = name ? name : "";
+}
+
+void Profiler::_record(const char *name, uint64_t start, uint64_t end) {
+    if (!_threadBuffer().ring.Push({ name, start, end }))
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::_recordCounter(const char *track, const char *series, double value) {
+    if (!_capturing)
+        return;
+    if (_capture.size() < _captureLimit)
+        _capture.push_back({ CaptureEvent::Kind::Counter, track, Now(), 0, 0, series, value });
+    else
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::_updateActive() {
+    _active.store(_enabled || _capturing, std::memory_order_relaxed);
+}
+
+Profiler::ThreadBuffer &Profiler::_threadBuffer() {
+    if (!threadBuffer) {
+        // Owned by the profiler, not the thread: a worker that exits leaves its ring behind, so
+        // the main thread never drains a freed buffer
+        auto            buffer = std::make_unique<ThreadBuffer>();
+        std::lock_guard lock(_threadsMutex);
+        buffer->index = static_cast<uint32_t>(_threads.size());
+        threadBuffer  = buffer.get();
+        _threads.push_back(std::move(buffer));
+    }
+    return *static_cast<ThreadBuffer *>(threadBuffer);
+}
+
+void Profiler::_drain() {
+    std::lock_guard lock(_threadsMutex);
+    for (const auto &thread : _threads) {
+        const uint32_t index = thread->index;
+        thread->ring.Drain([&](const ZoneEvent &event) {
+            if (_enabled) {
+                ZoneTotals &totals = _totals[event.name];
+                totals.ticks += event.end - event.start;
+                totals.maxTicks = std::max(totals.maxTicks, event.end - event.start);
+                ++totals.calls;
+            }
+            if (_capturing) {
+                if (_capture.size() < _captureLimit)
+                    _capture.push_back({ CaptureEvent::Kind::Zone, event.name, event.start, event.end, index, nullptr, 0.0 });
+                else
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+}
+
+void Profiler::_endFrame() {
+    ThreadBuffer &main = _threadBuffer();
+    if (main.index == 0 && main.name.empty()) {
+        std::lock_guard lock(_threadsMutex);
+        main.name = "Main";
+    }
+
+    _drain();
+
+    if (_capturing && _capture.size() < _captureLimit) {
+        const uint64_t now = Now();
+        _capture.push_back({ CaptureEvent::Kind::Frame, "Frame", now, now, main.index, nullptr, 0.0 });
+    }
+
+    if (!_enabled || ++_windowFrames < HUD_WINDOW)
+        return;
+
+    const double msPerTick = 1.0 / _ticksPerMs();
+    _topZones.clear();
+    for (const auto &[name, totals] : _totals) {
+        _topZones.push_back({ name.data(), totals.ticks * msPerTick / _windowFrames, totals.maxTicks * msPerTick,
+            static_cast<double>(totals.calls) / _windowFrames });
+    }
+    const size_t keep = std::min<size_t>(_topZones.size(), TOP_ZONES);
+    std::partial_sort(_topZones.begin(), _topZones.begin() + keep, _topZones.end(),
+        [](const ProfileZoneStats &a, const ProfileZoneStats &b) { return a.ms > b.ms; });
+    _topZones.resize(keep);
+
+    _totals.clear();
+    _windowFrames = 0;
+}
+
+const char *Profiler::_intern(std::string_view name) {
+    std::lock_guard lock(_namesMutex);
+    auto            it = _names.find(name);
+    if (it == _names.end())
+        it = _names.emplace(name).first;
+    return it->c_str();
+}
+
+double Profiler::_ticksPerMs() {
+#ifdef LUMI_PROFILER_RDTSC
+    // The TSC rate isn't reported anywhere portable; measure it against steady_clock over
+    // everything since startup (waiting briefly if that's still too short to be accurate)
+    auto elapsed = std::chrono::steady_clock::now() - _anchorTime;
+    if (elapsed < std::chrono::milliseconds(20)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20) - elapsed);
+        elapsed = std::chrono::steady_clock::now() - _anchorTime;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    return static_cast<double>(Now() - _anchorTicks) / ms;
+#else
+    return 1.0e6; // ticks are steady_clock nanoseconds
+#endif
+}
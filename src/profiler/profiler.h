@@ -0,0 +1,243 @@
+#pragma once
+
+// Scoped CPU instrumentation. LUMI_ZONE("name") times the enclosing scope; each thread pushes its
+// finished zones into its own lock-free ring, and the main thread drains every ring once a frame
+// (Perf::FrameEnd -> Profiler::EndFrame) into per-zone totals for the perf HUD and, while a
+// capture is running, into an event list that EndCapture writes as Chrome trace JSON (open it in
+// chrome://tracing or ui.perfetto.dev).
+//
+// Cost model: while neither the HUD nor a capture is active a zone is one relaxed atomic load.
+// Active, it's two timestamp reads (rdtsc on x86, steady_clock elsewhere) and one ring push.
+// Zones compile to nothing with LUMINOVEAU_PROFILER=0 (the LUMINOVEAU_ENABLE_PROFILER CMake option).
+//
+// Zone names given as const char* must outlive the capture: string literals or __func__. A
+// std::string (a pass name, an asset path) is copied into an intern table, only while active.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define LUMI_PROFILER_RDTSC 1
+#endif
+
+#ifndef LUMINOVEAU_PROFILER
+#define LUMINOVEAU_PROFILER 1
+#endif
+
+#define LUMI_ZONE_CONCAT_INNER(a, b) a##b
+#define LUMI_ZONE_CONCAT(a, b) LUMI_ZONE_CONCAT_INNER(a, b)
+
+#if LUMINOVEAU_PROFILER
+#define LUMI_ZONE(name) ProfileZone LUMI_ZONE_CONCAT(_lumiZone, __LINE__) { name }
+#define LUMI_ZONE_FUNCTION() LUMI_ZONE(__func__)
+#else
+#define LUMI_ZONE(name) ((void)0)
+#define LUMI_ZONE_FUNCTION() ((void)0)
+#endif
+
+/// @brief Per-frame timing of one zone name, averaged over the HUD window.
+struct ProfileZoneStats {
+    const char *name;
+    double      ms;    ///< Inclusive time per frame, summed over all threads
+    double      maxMs; ///< Longest single call in the window
+    double      calls; ///< Calls per frame
+};
+
+/**
+ * @brief Scoped CPU zone profiler with Chrome trace export.
+ */
+class Profiler {
+public:
+    /// @brief Current timestamp in profiler ticks (CPU cycles on x86, nanoseconds elsewhere).
+    static uint64_t Now() {
+#ifdef LUMI_PROFILER_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+#endif
+    }
+
+    /// @brief True while zones are being recorded (HUD statistics on, or a capture running).
+    static bool IsActive() { return Get()._active.load(std::memory_order_relaxed); }
+
+    /// @brief Records zones for GetTopZones (the perf HUD turns this on while it is visible).
+    static void SetEnabled(bool enabled) { Get()._setEnabled(enabled); }
+
+    /**
+     * @brief Starts collecting every zone for export.
+     *
+     * @param maxEvents Zones kept; later ones are counted in GetDroppedZones instead.
+     */
+    static void BeginCapture(size_t maxEvents = size_t(1) << 20) { Get()._beginCapture(maxEvents); }
+
+    /**
+     * @brief Stops the capture and writes it as Chrome trace JSON.
+     *
+     * @return False if no capture was running or the file can't be written.
+     */
+    static bool EndCapture(const std::string &path) { return Get()._endCapture(path); }
+
+    static bool IsCapturing() { return Get()._capturing; }
+
+    /// @brief Names the calling thread in exported traces (default "Thread N"; the first is "Main").
+    static void SetThreadName(const char *name) { Get()._setThreadName(name); }
+
+    /// @brief The most expensive zones, slowest first, refreshed every HUD window (30 frames).
+    static const std::vector<ProfileZoneStats> &GetTopZones() { return Get()._topZones; }
+
+    /// @brief Zones lost to full per-thread rings or the capture limit.
+    static uint64_t GetDroppedZones() { return Get()._dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Adds a counter sample to the running capture (main thread; ignored when not capturing).
+     *
+     * Exported as a Chrome trace counter: one track per `track` / `series` pair. The renderer
+     * records each pass's GPU time this way, under "GPU ms".
+     */
+    static void RecordCounter(const char *track, const char *series, double value) { Get()._recordCounter(track, series, value); }
+
+    /// @brief Returns a pointer to a stored copy of `name` that stays valid for the process lifetime.
+    static const char *Intern(std::string_view name) { return Get()._intern(name); }
+
+    /// @cond INTERNAL
+    // Main thread, once per frame: drains the thread rings into the stats and the capture
+    static void EndFrame() { Get()._endFrame(); }
+
+    static void Record(const char *name, uint64_t start, uint64_t end) { Get()._record(name, start, end); }
+    /// @endcond
+
+private:
+    static constexpr int    TOP_ZONES  = 6;
+    static constexpr int    HUD_WINDOW = 30; // frames averaged per GetTopZones refresh
+    static constexpr size_t RING_SIZE  = 8192;
+
+    struct ZoneEvent {
+        const char *name;
+        uint64_t    start;
+        uint64_t    end;
+    };
+
+    struct CaptureEvent {
+        enum class Kind : uint8_t { Zone,
+            Frame,
+            Counter };
+
+        Kind        kind;
+        const char *name;
+        uint64_t    start;
+        uint64_t    end;    ///< zones only
+        uint32_t    thread; ///< zones and frames
+        const char *series; ///< counters only
+        double      value;  ///< counters only
+    };
+
+    struct ZoneTotals {
+        uint64_t ticks    = 0;
+        uint64_t maxTicks = 0;
+        uint32_t calls    = 0;
+    };
+
+    struct ThreadBuffer; // per-thread ring, defined in profiler.cpp
+
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+    };
+
+    void          _setEnabled(bool enabled);
+    void          _beginCapture(size_t maxEvents);
+    bool          _endCapture(const std::string &path);
+    void          _setThreadName(const char *name);
+    void          _endFrame();
+    void          _record(const char *name, uint64_t start, uint64_t end);
+    void          _recordCounter(const char *track, const char *series, double value);
+    void          _updateActive();
+    ThreadBuffer &_threadBuffer();
+    void          _drain();
+    double        _ticksPerMs();
+    const char   *_intern(std::string_view name);
+
+    std::atomic<bool>     _active { false };
+    std::atomic<uint64_t> _dropped { 0 };
+    bool                  _enabled   = false;
+    bool                  _capturing = false;
+
+    std::mutex                                 _threadsMutex; // guards _threads (registration vs drain)
+    std::vector<std::unique_ptr<ThreadBuffer>> _threads;
+
+    std::mutex                                                   _namesMutex;
+    std::unordered_set<std::string, NameHash, std::equal_to<>> _names;
+
+    std::vector<CaptureEvent> _capture;
+    size_t                    _captureLimit = 0;
+
+    std::unordered_map<std::string_view, ZoneTotals> _totals;
+    std::vector<ProfileZoneStats>                    _topZones;
+    int                                              _windowFrames = 0;
+
+    // Tick -> time conversion, measured against steady_clock from construction on
+    uint64_t                              _anchorTicks = 0;
+    std::chrono::steady_clock::time_point _anchorTime;
+
+public:
+    /// @cond INTERNAL
+    Profiler(const Profiler &) = delete;
+
+    static Profiler &Get() {
+        static Profiler instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    Profiler();
+    ~Profiler();
+};
+
+/**
+ * @brief Times its scope as one profiler zone. Use through LUMI_ZONE / LUMI_ZONE_FUNCTION.
+ */
+class ProfileZone {
+public:
+    explicit ProfileZone(const char *name)
+        : _name(name)
+        , _start(Profiler::IsActive() ? Profiler::Now() : 0) { }
+
+    /// @brief For names without static storage; interned only while the profiler is active.
+    explicit ProfileZone(std::string_view name)
+        : _name(nullptr)
+        , _start(0) {
+        if (Profiler::IsActive()) {
+            _name  = Profiler::Intern(name);
+            _start = Profiler::Now();
+        }
+    }
+
+    ~ProfileZone() {
+        if (_start != 0)
+            Profiler::Record(_name, _start, Profiler::Now());
+    }
+
+    ProfileZone(const ProfileZone &)            = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *_name;
+    uint64_t    _start;
+};
@@ -7,7 +7,25 @@
 #include <vector>
 #include <utility>
 #include <cstring>
+#include <new>
 
+namespace {
+template <typename T>
+const T *copyToArena(Arena &arena, const T *data, size_t count) {
+    if (count == 0)
+        return nullptr;
+    T *copy = arena.AllocateArray<T>(count);
+    std::memcpy(copy, data, sizeof(T) * count);
+    return copy;
+}
+
+template <typename Pair>
+void sortBySlot(std::vector<Pair> &bindings) {
+    std::sort(bindings.begin(), bindings.end(), [](const Pair &a, const Pair &b) { return a.first < b.first; });
+}
+} // namespace
+
+/// @cond INTERNAL
 void Compute::_clearBuilderState() {
     _pipeline = 0;
     _tcX = _tcY = _tcZ = 1;
@@ -59,15 +77,15 @@ void Compute::_bindReadWriteBuffer(uint32_t slot, GpuBufferHandle buf) {
 }
 
 void Compute::_pushUniform(uint32_t slot, const void *data, uint32_t size) {
-    std::vector<uint8_t> bytes(
-        static_cast<const uint8_t *>(data),
-        static_cast<const uint8_t *>(data) + size);
-    auto it = std::find_if(_uniforms.begin(), _uniforms.end(),
-        [slot](const auto &p) { return p.first == slot; });
+    // Copied now, so the caller's value may go out of scope before the dispatch is queued
+    const uint8_t *bytes = copyToArena(_frameArena, static_cast<const uint8_t *>(data), size);
+    auto           it    = std::find_if(_uniforms.begin(), _uniforms.end(),
+        [slot](const UniformRecord &u) { return u.slot == slot; });
     if (it != _uniforms.end()) {
-        it->second = std::move(bytes);
+        it->size = size;
+        it->data = bytes;
     } else {
-        _uniforms.push_back({ slot, std::move(bytes) });
+        _uniforms.push_back({ slot, size, bytes });
     }
 }
 
@@ -77,20 +95,39 @@ void Compute::_enqueueDispatch(uint32_t gx, uint32_t gy, uint32_t gz) {
         LOG_ERROR("Compute::Dispatch called without SetPipeline");
         return;
     }
+    sortBySlot(_readWriteTextures);
+    sortBySlot(_readWriteBuffers);
+
     DispatchRecord rec;
-    rec.pipeline          = _pipeline;
-    rec.threadCountX      = _tcX;
-    rec.threadCountY      = _tcY;
-    rec.threadCountZ      = _tcZ;
-    rec.readTextures      = _readTextures;
-    rec.readWriteTextures = _readWriteTextures;
-    rec.readBuffers       = _readBuffers;
-    rec.readWriteBuffers  = _readWriteBuffers;
-    rec.uniforms          = _uniforms;
-    rec.groupX            = gx;
-    rec.groupY            = gy;
-    rec.groupZ            = gz;
-    _queue.push_back(std::move(rec));
+    rec.pipeline = _pipeline;
+    rec.groupX   = gx;
+    rec.groupY   = gy;
+    rec.groupZ   = gz;
+
+    rec.readTextures     = copyToArena(_frameArena, _readTextures.data(), _readTextures.size());
+    rec.readTextureCount = static_cast<uint32_t>(_readTextures.size());
+    rec.readBuffers      = copyToArena(_frameArena, _readBuffers.data(), _readBuffers.size());
+    rec.readBufferCount  = static_cast<uint32_t>(_readBuffers.size());
+    rec.uniforms         = copyToArena(_frameArena, _uniforms.data(), _uniforms.size());
+    rec.uniformCount     = static_cast<uint32_t>(_uniforms.size());
+
+    if (!_readWriteTextures.empty()) {
+        auto *bindings = _frameArena.AllocateArray<GpuStorageTextureBinding>(_readWriteTextures.size());
+        for (size_t i = 0; i < _readWriteTextures.size(); ++i) {
+            const RWTextureBind &bind = _readWriteTextures[i].second;
+            new (&bindings[i]) GpuStorageTextureBinding { bind.tex, bind.mipLevel, bind.layer, false };
+        }
+        rec.readWriteTextures     = bindings;
+        rec.readWriteTextureCount = static_cast<uint32_t>(_readWriteTextures.size());
+    }
+    if (!_readWriteBuffers.empty()) {
+        auto *bindings = _frameArena.AllocateArray<GpuStorageBufferBinding>(_readWriteBuffers.size());
+        for (size_t i = 0; i < _readWriteBuffers.size(); ++i)
+            new (&bindings[i]) GpuStorageBufferBinding { _readWriteBuffers[i].second, false };
+        rec.readWriteBuffers     = bindings;
+        rec.readWriteBufferCount = static_cast<uint32_t>(_readWriteBuffers.size());
+    }
+    _queue.push_back(rec);
     _clearBuilderState();
 }
 /// @endcond
@@ -158,37 +195,16 @@ void Compute::_destroyBuffer(GpuBufferHandle buffer) {
 // -----------------------------------------------------------------
 
 void Compute::_executeQueued(GpuCmdBufferHandle cmdBuf) {
-    if (_queue.empty())
-        return;
-    IGpu &gpu = Renderer::GetGpu();
+    if (!_queue.empty())
+        _executeQueued(Renderer::GetGpu(), cmdBuf);
+}
 
+void Compute::_executeQueued(IGpu &gpu, GpuCmdBufferHandle cmdBuf) {
     for (const auto &rec : _queue) {
-        auto rwTexSorted = rec.readWriteTextures;
-        std::sort(rwTexSorted.begin(), rwTexSorted.end(),
-            [](const auto &a, const auto &b) { return a.first < b.first; });
-
-        std::vector<GpuStorageTextureBinding> rwTexBindings;
-        rwTexBindings.reserve(rwTexSorted.size());
-        for (const auto &[slot, bind] : rwTexSorted) {
-            rwTexBindings.push_back({ bind.tex, bind.mipLevel, bind.layer, false });
-        }
-
-        auto rwBufSorted = rec.readWriteBuffers;
-        std::sort(rwBufSorted.begin(), rwBufSorted.end(),
-            [](const auto &a, const auto &b) { return a.first < b.first; });
-
-        std::vector<GpuStorageBufferBinding> rwBufBindings;
-        rwBufBindings.reserve(rwBufSorted.size());
-        for (const auto &[slot, buf] : rwBufSorted) {
-            rwBufBindings.push_back({ buf, false });
-        }
-
         GpuComputePassHandle computePass = gpu.BeginComputePass(
             cmdBuf,
-            rwTexBindings.empty() ? nullptr : rwTexBindings.data(),
-            static_cast<uint32_t>(rwTexBindings.size()),
-            rwBufBindings.empty() ? nullptr : rwBufBindings.data(),
-            static_cast<uint32_t>(rwBufBindings.size()));
+            rec.readWriteTextures, rec.readWriteTextureCount,
+            rec.readWriteBuffers, rec.readWriteBufferCount);
 
         if (!computePass) {
             LOG_ERROR("Compute::ExecuteQueued: beginComputePass failed");
@@ -197,22 +213,16 @@ void Compute::_executeQueued(GpuCmdBufferHandle cmdBuf) {
 
         gpu.BindComputePipeline(computePass, rec.pipeline);
 
-        for (const auto &[slot, bytes] : rec.uniforms) {
-            gpu.PushComputeUniformData(cmdBuf, slot, bytes.data(),
-                static_cast<uint32_t>(bytes.size()));
+        for (uint32_t i = 0; i < rec.uniformCount; ++i) {
+            const UniformRecord &uniform = rec.uniforms[i];
+            gpu.PushComputeUniformData(cmdBuf, uniform.slot, uniform.data, uniform.size);
         }
 
-        if (!rec.readTextures.empty()) {
-            gpu.BindComputeStorageTextures(computePass, 0,
-                rec.readTextures.data(),
-                static_cast<uint32_t>(rec.readTextures.size()));
-        }
+        if (rec.readTextureCount > 0)
+            gpu.BindComputeStorageTextures(computePass, 0, rec.readTextures, rec.readTextureCount);
 
-        if (!rec.readBuffers.empty()) {
-            gpu.BindComputeStorageBuffers(computePass, 0,
-                rec.readBuffers.data(),
-                static_cast<uint32_t>(rec.readBuffers.size()));
-        }
+        if (rec.readBufferCount > 0)
+            gpu.BindComputeStorageBuffers(computePass, 0, rec.readBuffers, rec.readBufferCount);
 
         gpu.DispatchCompute(computePass, rec.groupX, rec.groupY, rec.groupZ);
         gpu.EndComputePass(computePass);
@@ -222,5 +232,6 @@ void Compute::_executeQueued(GpuCmdBufferHandle cmdBuf) {
 void Compute::_reset() {
     _queue.clear();
     _clearBuilderState();
+    _frameArena.Reset();
 }
 /// @endcond
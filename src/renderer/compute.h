@@ -7,6 +7,11 @@
 #include "gpu/types.h"
 #include "assets/compute/computepipeline.h"
 #include "assets/texture/texture.h"
+#include "util/arena.h"
+
+class IGpu;
+struct GpuStorageTextureBinding;
+struct GpuStorageBufferBinding;
 
 /**
  * @brief Compute dispatch API — mirrors the Draw:: pattern for graphics.
@@ -19,6 +24,10 @@
  *
  * All queued dispatches execute at the start of EndFrame, before any render
  * passes, so their outputs are ready for sampling in the same frame.
+ *
+ * Queued dispatches and their bindings and uniform bytes are recorded in a per-frame
+ * arena that is rewound after they execute, so once the arena has grown to a frame's
+ * worth, recording doesn't touch the heap.
  */
 class Compute {
 public:
@@ -148,6 +157,8 @@ public:
     /// @cond INTERNAL
     // Internal — called by Renderer::_endFrame()
     static void ExecuteQueued(GpuCmdBufferHandle cmdBuf) { Get()._executeQueued(cmdBuf); }
+    // Same, on a given device (tests and benchmarks record into a fake one)
+    static void ExecuteQueued(IGpu &gpu, GpuCmdBufferHandle cmdBuf) { Get()._executeQueued(gpu, cmdBuf); }
     static void Reset() { Get()._reset(); }
     /// @endcond
 
@@ -159,17 +170,26 @@ private:
         uint32_t         layer;
     };
 
-    struct DispatchRecord {
-        GpuComputePipelineHandle pipeline     = 0;
-        uint32_t                 threadCountX = 1, threadCountY = 1, threadCountZ = 1;
-
-        std::vector<GpuTextureHandle>                          readTextures;
-        std::vector<std::pair<uint32_t, RWTextureBind>>        readWriteTextures;
-        std::vector<GpuBufferHandle>                           readBuffers;
-        std::vector<std::pair<uint32_t, GpuBufferHandle>>      readWriteBuffers;
-        std::vector<std::pair<uint32_t, std::vector<uint8_t>>> uniforms;
+    struct UniformRecord {
+        uint32_t       slot;
+        uint32_t       size;
+        const uint8_t *data; // in _frameArena
+    };
 
-        uint32_t groupX = 1, groupY = 1, groupZ = 1;
+    // Trivially destructible: bindings (read-write ones already sorted by slot) and uniform
+    // bytes point into _frameArena and are dropped with it.
+    struct DispatchRecord {
+        GpuComputePipelineHandle pipeline = 0;
+        uint32_t                 groupX = 1, groupY = 1, groupZ = 1;
+
+        const GpuTextureHandle         *readTextures      = nullptr;
+        const GpuStorageTextureBinding *readWriteTextures = nullptr;
+        const GpuBufferHandle          *readBuffers       = nullptr;
+        const GpuStorageBufferBinding  *readWriteBuffers  = nullptr;
+        const UniformRecord            *uniforms          = nullptr;
+        uint32_t                        readTextureCount = 0, readWriteTextureCount = 0;
+        uint32_t                        readBufferCount = 0, readWriteBufferCount = 0;
+        uint32_t                        uniformCount = 0;
     };
     /// @endcond
 
@@ -190,25 +210,31 @@ private:
     void            _destroyBuffer(GpuBufferHandle buffer);
 
     void _executeQueued(GpuCmdBufferHandle cmdBuf);
+    void _executeQueued(IGpu &gpu, GpuCmdBufferHandle cmdBuf);
     void _reset();
 
     void _clearBuilderState();
     void _enqueueDispatch(uint32_t gx, uint32_t gy, uint32_t gz);
 
     // -----------------------------------------------------------------
-    // Builder state
+    // Builder state (cleared per dispatch; the vectors keep their capacity)
     // -----------------------------------------------------------------
 
     GpuComputePipelineHandle _pipeline = 0;
     uint32_t                 _tcX = 1, _tcY = 1, _tcZ = 1;
 
-    std::vector<GpuTextureHandle>                          _readTextures;
-    std::vector<std::pair<uint32_t, RWTextureBind>>        _readWriteTextures;
-    std::vector<GpuBufferHandle>                           _readBuffers;
-    std::vector<std::pair<uint32_t, GpuBufferHandle>>      _readWriteBuffers;
-    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> _uniforms;
+    std::vector<GpuTextureHandle>                     _readTextures;
+    std::vector<std::pair<uint32_t, RWTextureBind>>   _readWriteTextures;
+    std::vector<GpuBufferHandle>                      _readBuffers;
+    std::vector<std::pair<uint32_t, GpuBufferHandle>> _readWriteBuffers;
+    std::vector<UniformRecord>                        _uniforms; // bytes already in _frameArena
+
+    // -----------------------------------------------------------------
+    // Frame queue: records in order, payloads in the arena; both reset by _reset()
+    // -----------------------------------------------------------------
 
     std::vector<DispatchRecord> _queue;
+    Arena                       _frameArena { 16 * 1024 };
 
 public:
     /// @cond INTERNAL
@@ -10,6 +10,7 @@
 #include "core/log/log.h"
 #include "gpu/IGpu.h"
 #include "gpu/presets.h"
+#include "gpu/memory/gpumemory.h"
 #include "platform/window/window.h"
 #include "assets/shaders_generated.h"
 
@@ -174,6 +175,7 @@ bool Model3DRenderPass::Init(
 
     // ── Shadow resources (directional caster) ────────────────────────────────
     {
+        GpuMemoryScope       memScope(GpuMemoryCategory::ShadowMaps, "Model3DRenderPass");
         GpuTextureCreateInfo sc {};
         sc.width        = SHADOW_RES;
         sc.height       = SHADOW_RES;
@@ -224,6 +226,7 @@ bool Model3DRenderPass::Init(
 
     // ── Point-light cube shadow resources ────────────────────────────────────
     {
+        GpuMemoryScope       memScope(GpuMemoryCategory::ShadowMaps, "Model3DRenderPass");
         GpuTextureCreateInfo cc {};
         cc.width         = CUBE_SHADOW_RES;
         cc.height        = CUBE_SHADOW_RES;
@@ -375,9 +378,10 @@ void Model3DRenderPass::_uploadModelToGPU(ModelAsset *model) {
     if (model->vertexBuffer && model->indexBuffer)
         return; // already uploaded
 
-    IGpu    &gpu   = Renderer::GetGpu();
-    uint32_t vSize = static_cast<uint32_t>(model->vertices.size() * sizeof(Vertex3D));
-    uint32_t iSize = static_cast<uint32_t>(model->indices.size() * sizeof(uint32_t));
+    IGpu          &gpu   = Renderer::GetGpu();
+    GpuMemoryScope memScope(GpuMemoryCategory::Meshes, "Model3DRenderPass");
+    uint32_t       vSize = static_cast<uint32_t>(model->vertices.size() * sizeof(Vertex3D));
+    uint32_t       iSize = static_cast<uint32_t>(model->indices.size() * sizeof(uint32_t));
 
     model->vertexBuffer = gpu.CreateBuffer({ vSize, GpuBufferUsage::Vertex });
     model->indexBuffer  = gpu.CreateBuffer({ iSize, GpuBufferUsage::Index });
@@ -518,6 +522,7 @@ void Model3DRenderPass::Render(
             sdt.storeOp    = GpuStoreOp::DontCare;
             sdt.clearDepth = 1.0f;
 
+            GpuTimedScope       shadowScope(gpu, cmdBuffer, "Shadow map");
             GpuRenderPassHandle sp = gpu.BeginRenderPass(cmdBuffer, &sct, 1, &sdt);
             gpu.SetViewport(sp, 0.0f, 0.0f, (float)SHADOW_RES, (float)SHADOW_RES, 0.0f, 1.0f);
             gpu.BindGraphicsPipeline(sp, _shadowPipeline);
@@ -551,6 +556,8 @@ void Model3DRenderPass::Render(
 
         // ── Point-light cube shadow pass: render the scene into the 6 cube faces ──
         if (pointShadowLight >= 0 && _cubeShadowPipeline) {
+            GpuTimedScope cubeScope(gpu, cmdBuffer, "Shadow cube");
+
             // Cube faces must match HLSL TextureCube.Sample's D3D (left-handed) convention, so use
             // LH view + projection and the standard D3D face orientations. Layer order is
             // +X,-X,+Y,-Y,+Z,-Z.
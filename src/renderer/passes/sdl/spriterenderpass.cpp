@@ -11,9 +11,14 @@
 
 #include "core/log/log.h"
 #include "platform/window/window.h"
+#include "assets/effect/effects.h"
 #include "assets/shaders_generated.h"
 #include "draw/draw.h"
+#include "file/filehandler.h"
+#include "gpu/memory/gpumemory.h"
 #include "math/constants.h"
+#include "profiler/profiler.h"
+#include "renderer/shaders.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_gpu.h>
@@ -73,7 +78,8 @@ bool SpriteRenderPass::Init(
     _surfaceHeight   = surfaceHeight;
     _swapchainFormat = swapchainTextureFormat;
 
-    IGpu &gpu   = Renderer::GetGpu();
+    IGpu          &gpu = Renderer::GetGpu();
+    GpuMemoryScope memScope(GpuMemoryCategory::RenderTargets, _passname);
     renderQueue = BufferManager::Create<Renderable>(_passname + "_renderQueue", capacity > 0 ? capacity : MAX_SPRITES);
 
     _createShaders();
@@ -120,14 +126,17 @@ bool SpriteRenderPass::Init(
         return false;
     }
 
-    _spriteDataTransferBuffer = gpu.CreateTransferBuffer({
-        static_cast<uint32_t>(MAX_SPRITES * sizeof(CompactSpriteInstance)),
-        GpuTransferUsage::Upload,
-    });
-    _spriteDataBuffer         = gpu.CreateBuffer({
-        static_cast<uint32_t>(MAX_SPRITES * sizeof(CompactSpriteInstance)),
-        GpuBufferUsage::StorageRead,
-    });
+    {
+        GpuMemoryScope instanceScope(GpuMemoryCategory::SpriteInstances, _passname);
+        _spriteDataTransferBuffer = gpu.CreateTransferBuffer({
+            static_cast<uint32_t>(MAX_SPRITES * sizeof(CompactSpriteInstance)),
+            GpuTransferUsage::Upload,
+        });
+        _spriteDataBuffer         = gpu.CreateBuffer({
+            static_cast<uint32_t>(MAX_SPRITES * sizeof(CompactSpriteInstance)),
+            GpuBufferUsage::StorageRead,
+        });
+    }
 
     if (logInit) {
         LOG_INFO("Render pass initialized: {}", _passname.c_str());
@@ -201,12 +210,13 @@ void SpriteRenderPass::Render(
     // Convert float32 to float16 and pack pairs into uint32
 
     size_t spriteCount = renderQueue->Count();
-    size_t threadCount = _threadPool.GetThreadCount();
+    size_t threadCount = std::max(1, _threadPool.GetThreadCount());
     size_t chunkSize   = spriteCount / threadCount + 1;
 
     for (size_t start = 0; start < spriteCount; start += chunkSize) {
         size_t end = std::min(start + chunkSize, spriteCount);
         _threadPool.Enqueue([this, dataPtr, start, end]() {
+            LUMI_ZONE("SpriteRenderPass::PackInstances");
             for (size_t i = start; i < end; ++i) {
                 const auto &sprite   = (*renderQueue)[i];
                 float       x        = sprite.x;
@@ -245,6 +255,10 @@ void SpriteRenderPass::Render(
     }
     _threadPool.WaitAll();
 
+    // The instance buffers hold MAX_SPRITES; GpuMemory counts the rest as wasted
+    GpuMemory::SetUsed(_spriteDataBuffer, spriteCount * sizeof(CompactSpriteInstance));
+    GpuMemory::SetUsed(_spriteDataTransferBuffer, spriteCount * sizeof(CompactSpriteInstance));
+
     // Build batches respecting z-order, geometry, and texture changes
     std::vector<Batch> batches;
     batches.reserve(64);
@@ -523,6 +537,7 @@ void SpriteRenderPass::OnResize(uint32_t surfaceWidth, uint32_t surfaceHeight) {
     _surfaceWidth  = surfaceWidth;
     _surfaceHeight = surfaceHeight;
 
+    GpuMemoryScope       memScope(GpuMemoryCategory::RenderTargets, _passname);
     GpuTextureCreateInfo depthInfo {};
     depthInfo.width          = surfaceWidth;
     depthInfo.height         = surfaceHeight;
@@ -625,6 +640,13 @@ void SpriteRenderPass::_releaseEffectResources() {
             gpu.ReleaseGraphicsPipeline(pipeline);
     }
     _effectPipelineCache.clear();
+    for (auto &[key, fused] : _fusedEffects) {
+        if (fused->effect.fragShader.gpuShader)
+            gpu.ReleaseShader(fused->effect.fragShader.gpuShader);
+    }
+    _fusedEffects.clear();
+    _effectPlans.clear();
+    _effectStages.clear();
     if (_effectQuadVbuf) {
         gpu.ReleaseBuffer(_effectQuadVbuf);
         _effectQuadVbuf = 0;
@@ -637,6 +659,95 @@ void SpriteRenderPass::_releaseEffectResources() {
     _effectQuadUvScaleY = -1.0f;
 }
 
+const EffectStage &SpriteRenderPass::_effectStage(const ShaderAsset &fragShader) {
+    auto &stage = _effectStages[fragShader.gpuShader];
+    if (!stage) {
+        stage = std::make_unique<EffectStage>(EffectStage::Parse(FileHandler::ReadTextFile(fragShader.shaderFilename)));
+        if (!stage->pointwise)
+            LOG_DEBUG("Effect '{}' can't be fused into the pass before it: {}", fragShader.shaderFilename, stage->reason);
+    }
+    return *stage;
+}
+
+const std::vector<SpriteRenderPass::EffectPass> &SpriteRenderPass::_planEffectPasses(const std::vector<EffectAsset> &effects) {
+    if (!EffectFusion::IsEnabled() || effects.size() < 2) {
+        _unfusedPasses.resize(effects.size());
+        for (size_t i = 0; i < effects.size(); ++i)
+            _unfusedPasses[i] = { i, 1, nullptr };
+        return _unfusedPasses;
+    }
+
+    EffectChainKey key;
+    key.reserve(effects.size() * 2);
+    for (const auto &effect : effects) {
+        key.push_back(effect.vertShader.gpuShader);
+        key.push_back(effect.fragShader.gpuShader);
+    }
+    if (auto it = _effectPlans.find(key); it != _effectPlans.end())
+        return it->second;
+
+    std::vector<const EffectStage *> stages;
+    std::vector<uint64_t>            vertShaders;
+    for (const auto &effect : effects) {
+        stages.push_back(&_effectStage(effect.fragShader));
+        vertShaders.push_back(effect.vertShader.gpuShader);
+    }
+
+    std::vector<EffectPass> passes;
+    for (const auto &run : EffectFusion::Plan(stages, vertShaders)) {
+        FusedEffect *fused = run.count > 1 ? _fuseEffects(effects, stages, run.first, run.count) : nullptr;
+        if (run.count > 1 && !fused) {
+            for (size_t i = run.first; i < run.first + run.count; ++i)
+                passes.push_back({ i, 1, nullptr });
+        } else {
+            passes.push_back({ run.first, run.count, fused });
+        }
+    }
+    return _effectPlans.emplace(std::move(key), std::move(passes)).first->second;
+}
+
+SpriteRenderPass::FusedEffect *SpriteRenderPass::_fuseEffects(const std::vector<EffectAsset> &effects,
+    const std::vector<const EffectStage *> &stages, size_t first, size_t count) {
+    // Keyed by the run's own shaders, so chains sharing a run share its fused shader
+    EffectChainKey key;
+    for (size_t i = first; i < first + count; ++i) {
+        key.push_back(effects[i].vertShader.gpuShader);
+        key.push_back(effects[i].fragShader.gpuShader);
+    }
+    auto &fused = _fusedEffects[key];
+    if (fused)
+        return fused->effect.fragShader.gpuShader ? fused.get() : nullptr;
+    fused = std::make_unique<FusedEffect>();
+
+    std::string names;
+    for (size_t i = first; i < first + count; ++i)
+        names += (i > first ? " + " : "") + effects[i].fragShader.shaderFilename;
+
+    std::vector<const EffectStage *> runStages(stages.begin() + first, stages.begin() + first + count);
+    std::string                      source = EffectFusion::Generate(runStages);
+    ShaderAsset                      frag   = Shaders::CreateShaderAssetFromSource(EffectFusion::ShaderName(source), source, GpuShaderStage::Fragment);
+    if (!frag.gpuShader) {
+        LOG_WARNING("Could not fuse effects {}; drawing them as separate passes", names);
+        return nullptr;
+    }
+
+    // Each stage's block lands at its members' offsets in the merged block
+    fused->effect = EffectHandler::Create(effects[first].vertShader, frag);
+    for (size_t s = 0; s < count; ++s) {
+        const ShaderAsset &stageFrag = effects[first + s].fragShader;
+        for (const auto &[name, offset] : stageFrag.uniformOffsets) {
+            auto to = frag.uniformOffsets.find(EffectFusion::MemberName(s, name));
+            if (to == frag.uniformOffsets.end())
+                continue;
+            size_t size = std::min(stageFrag.uniformSizes.at(name), frag.uniformSizes.at(to->first));
+            fused->uniformCopies.push_back({ s, offset, to->second, size });
+        }
+    }
+    EffectFusion::CountFusedShader();
+    LOG_INFO("Fused effects {} into one pass", names);
+    return fused.get();
+}
+
 void SpriteRenderPass::_applyEffects(GpuCmdBufferHandle cmdBuffer, const std::vector<EffectAsset> &effects,
     GpuTextureHandle sourceTexture, GpuTextureHandle targetTexture, const glm::mat4 &camera,
     GpuTextureFormat targetFormat, bool isFirstBatch,
@@ -687,8 +798,11 @@ void SpriteRenderPass::_applyEffects(GpuCmdBufferHandle cmdBuffer, const std::ve
         _effectQuadUvScaleY = uvScaleY;
     }
 
+    // One pass per effect, except runs of per-pixel effects fused into one
+    const auto &passes = _planEffectPasses(effects);
+
     GpuTextureHandle readTex  = sourceTexture;
-    GpuTextureHandle writeTex = (effects.size() == 1) ? targetTexture : effectTempB.gpuTexture;
+    GpuTextureHandle writeTex = (passes.size() == 1) ? targetTexture : effectTempB.gpuTexture;
 
     GpuVertexAttribute vertexAttribs[] = {
         { .location = 0, .binding = 0, .format = GpuVertexElementFormat::Float2, .offset = 0 },
@@ -696,9 +810,13 @@ void SpriteRenderPass::_applyEffects(GpuCmdBufferHandle cmdBuffer, const std::ve
     };
     GpuVertexBinding vertBinding = { .binding = 0, .stride = 16, .instanceStepping = false };
 
-    for (size_t i = 0; i < effects.size(); ++i) {
-        const auto &effect = effects[i];
-        bool        isLast = (i == effects.size() - 1);
+    float vpW = std::min((float)Window::GetPhysicalWidth(), (float)_surfaceWidth);
+    float vpH = std::min((float)Window::GetPhysicalHeight(), (float)_surfaceHeight);
+
+    for (size_t p = 0; p < passes.size(); ++p) {
+        const EffectPass  &pass   = passes[p];
+        const EffectAsset &effect = pass.fused ? pass.fused->effect : effects[pass.first];
+        bool               isLast = (p == passes.size() - 1);
         if (isLast)
             writeTex = targetTexture;
 
@@ -772,11 +890,7 @@ void SpriteRenderPass::_applyEffects(GpuCmdBufferHandle cmdBuffer, const std::ve
         ct.storeOp = GpuStoreOp::Store;
 
         GpuRenderPassHandle effectPass = gpu.BeginRenderPass(cmdBuffer, &ct, 1, nullptr);
-        {
-            float vpW = std::min((float)Window::GetPhysicalWidth(), (float)_surfaceWidth);
-            float vpH = std::min((float)Window::GetPhysicalHeight(), (float)_surfaceHeight);
-            gpu.SetViewport(effectPass, 0.0f, 0.0f, vpW, vpH, 0.0f, 1.0f);
-        }
+        gpu.SetViewport(effectPass, 0.0f, 0.0f, vpW, vpH, 0.0f, 1.0f);
         gpu.BindGraphicsPipeline(effectPass, pipeline);
 
         std::vector<GpuTextureSamplerBinding> textureBindings;
@@ -790,6 +904,12 @@ void SpriteRenderPass::_applyEffects(GpuCmdBufferHandle cmdBuffer, const std::ve
         gpu.BindFragmentSamplers(effectPass, 0, textureBindings.data(),
             static_cast<uint32_t>(textureBindings.size()));
 
+        if (pass.fused) {
+            for (const auto &copy : pass.fused->uniformCopies) {
+                const auto *from = static_cast<const uint8_t *>(effects[pass.first + copy.stage].uniforms->GetBufferPointer());
+                effect.uniforms->Write(copy.to, from + copy.from, copy.size);
+            }
+        }
         if (effect.uniforms && effect.uniforms->GetBufferSize() > 0) {
             gpu.PushFragmentUniformData(cmdBuffer, 0,
                 effect.uniforms->GetBufferPointer(),
@@ -814,4 +934,7 @@ void SpriteRenderPass::_applyEffects(GpuCmdBufferHandle cmdBuffer, const std::ve
             writeTex = (readTex == effectTempA.gpuTexture) ? effectTempB.gpuTexture : effectTempA.gpuTexture;
         }
     }
+
+    // Each pass reads and writes the viewport once (RGBA8)
+    EffectFusion::CountPasses(effects.size(), passes.size(), passes.size() * static_cast<uint64_t>(vpW * vpH) * 4 * 2);
 }
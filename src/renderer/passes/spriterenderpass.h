@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <map>
+#include <memory>
 #include <string>
 #include <thread>
 #include <tuple>
@@ -18,6 +19,7 @@
 
 #include "assets/texture/texture.h"
 #include "assets/effect/effect.h"
+#include "assets/effect/effectfusion.h"
 
 #include "assets/assethandler.h"
 #include "gpu/renderable.h"
@@ -26,17 +28,13 @@
 #include "gpu/renderpass.h"
 #include "gpu/buffer/buffermanager.h"
 
+#include "util/helpers.h"
 #include "util/threadpool.h"
 
 class SpriteRenderPass : public RenderPass {
 
-    // Emscripten without -pthread can't spawn std::thread; default to single-threaded
-    // sprite packing on that platform. All other targets use one worker per core.
-#ifdef __EMSCRIPTEN__
-    ThreadPool _threadPool = ThreadPool(0);
-#else
-    ThreadPool _threadPool = ThreadPool(std::max(1u, std::thread::hardware_concurrency()));
-#endif
+    // The engine's shared frame pool, sized by the thread budget (inline on Emscripten)
+    ThreadPool &_threadPool = Platform::Workers(ThreadRole::Frame);
 
     // ── Shared pipeline + sprite-data buffers ─────────────────────────────────
     GpuGraphicsPipelineHandle _pipeline                 = 0;
@@ -206,6 +204,30 @@ private:
     float           _effectQuadUvScaleX = -1.0f;
     float           _effectQuadUvScaleY = -1.0f;
 
+    // Effect-chain fusion (SDL): runs of per-pixel effects share one pass through a generated
+    // shader (assets/effect/effectfusion.h). Stages are parsed once per fragment shader, chains
+    // planned once per shader sequence, and fused shaders kept per run of (vert, frag) handles.
+    struct FusedEffect {
+        struct UniformCopy {
+            size_t stage, from, to, size;
+        };
+        EffectAsset              effect; // fragShader.gpuShader is 0 if the fused source didn't compile
+        std::vector<UniformCopy> uniformCopies;
+    };
+    struct EffectPass {
+        size_t       first = 0, count = 1;
+        FusedEffect *fused = nullptr;
+    };
+    using EffectChainKey = std::vector<GpuShaderHandle>;
+    std::unordered_map<GpuShaderHandle, std::unique_ptr<EffectStage>> _effectStages;
+    std::map<EffectChainKey, std::vector<EffectPass>>                 _effectPlans;
+    std::map<EffectChainKey, std::unique_ptr<FusedEffect>>            _fusedEffects;
+    std::vector<EffectPass>                                           _unfusedPasses;
+
+    const EffectStage             &_effectStage(const ShaderAsset &fragShader);
+    const std::vector<EffectPass> &_planEffectPasses(const std::vector<EffectAsset> &effects);
+    FusedEffect                   *_fuseEffects(const std::vector<EffectAsset> &effects, const std::vector<const EffectStage *> &stages, size_t first, size_t count);
+
     void _createEffectResources();
     void _releaseEffectResources();
     void _applyEffects(GpuCmdBufferHandle cmdBuffer, const std::vector<EffectAsset> &effects,
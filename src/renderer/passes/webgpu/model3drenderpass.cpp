@@ -16,6 +16,7 @@
 #include "core/log/log.h"
 #include "gpu/IGpu.h"
 #include "gpu/presets.h"
+#include "gpu/memory/gpumemory.h"
 #include "platform/window/window.h"
 #include "assets/shaders_generated.h"
 
@@ -154,6 +155,7 @@ bool Model3DRenderPass::Init(
 
     // ── Directional shadow resources ─────────────────────────────────────────
     {
+        GpuMemoryScope       memScope(GpuMemoryCategory::ShadowMaps, "Model3DRenderPass");
         GpuTextureCreateInfo sc {};
         sc.width        = SHADOW_RES;
         sc.height       = SHADOW_RES;
@@ -202,6 +204,7 @@ bool Model3DRenderPass::Init(
 
     // ── Point-light cube shadow resources ────────────────────────────────────
     {
+        GpuMemoryScope       memScope(GpuMemoryCategory::ShadowMaps, "Model3DRenderPass");
         GpuTextureCreateInfo cc {};
         cc.width         = CUBE_SHADOW_RES;
         cc.height        = CUBE_SHADOW_RES;
@@ -345,9 +348,10 @@ void Model3DRenderPass::_uploadModelToGPU(ModelAsset *model) {
     if (model->vertexBuffer && model->indexBuffer)
         return; // already uploaded
 
-    IGpu    &gpu   = Renderer::GetGpu();
-    uint32_t vSize = static_cast<uint32_t>(model->vertices.size() * sizeof(Vertex3D));
-    uint32_t iSize = static_cast<uint32_t>(model->indices.size() * sizeof(uint32_t));
+    IGpu          &gpu   = Renderer::GetGpu();
+    GpuMemoryScope memScope(GpuMemoryCategory::Meshes, "Model3DRenderPass");
+    uint32_t       vSize = static_cast<uint32_t>(model->vertices.size() * sizeof(Vertex3D));
+    uint32_t       iSize = static_cast<uint32_t>(model->indices.size() * sizeof(uint32_t));
 
     model->vertexBuffer = gpu.CreateBuffer({ vSize, GpuBufferUsage::Vertex });
     model->indexBuffer  = gpu.CreateBuffer({ iSize, GpuBufferUsage::Index });
@@ -475,6 +479,7 @@ void Model3DRenderPass::Render(
             sdt.storeOp    = GpuStoreOp::DontCare;
             sdt.clearDepth = 1.0f;
 
+            GpuTimedScope       shadowScope(gpu, cmdBuffer, "Shadow map");
             GpuRenderPassHandle sp = gpu.BeginRenderPass(cmdBuffer, &sct, 1, &sdt);
             gpu.SetViewport(sp, 0.0f, 0.0f, (float)SHADOW_RES, (float)SHADOW_RES, 0.0f, 1.0f);
             gpu.BindGraphicsPipeline(sp, _shadowPipeline);
@@ -508,6 +513,8 @@ void Model3DRenderPass::Render(
 
         // ── Point-light cube shadow pass (6 faces) ─────────────────────────────
         if (pointShadowLight >= 0 && _cubeShadowPipeline) {
+            GpuTimedScope cubeScope(gpu, cmdBuffer, "Shadow cube");
+
             // LH view + projection with D3D face orientations, matching texture_cube sampling.
             // Layer order +X,-X,+Y,-Y,+Z,-Z.
             glm::mat4 proj = glm::perspectiveLH_ZO(glm::radians(90.0f), 1.0f, 0.5f, POINT_FAR);
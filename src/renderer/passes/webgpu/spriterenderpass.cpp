@@ -12,6 +12,7 @@
 #include "core/log/log.h"
 #include "platform/window/window.h"
 #include "draw/draw.h"
+#include "gpu/memory/gpumemory.h"
 
 // ── Embedded WGSL: sprite vertex + fragment shaders ──────────────────────────
 static constexpr const char *SPRITE_VERT_WGSL = R"(
@@ -243,7 +244,8 @@ bool SpriteRenderPass::Init(
     _surfaceHeight   = surfaceHeight;
     _swapchainFormat = swapchainTextureFormat;
 
-    IGpu &gpu   = Renderer::GetGpu();
+    IGpu          &gpu = Renderer::GetGpu();
+    GpuMemoryScope memScope(GpuMemoryCategory::RenderTargets, _passname);
     renderQueue = BufferManager::Create<Renderable>(_passname + "_renderQueue", capacity > 0 ? capacity : MAX_SPRITES);
 
     _createShaders();
@@ -302,14 +304,17 @@ bool SpriteRenderPass::Init(
         }
     }
 
-    _spriteDataTransferBuffer = gpu.CreateTransferBuffer({
-        static_cast<uint32_t>(MAX_SPRITES * sizeof(CompactSpriteInstance)),
-        GpuTransferUsage::Upload,
-    });
-    _spriteDataBuffer         = gpu.CreateBuffer({
-        static_cast<uint32_t>(MAX_SPRITES * sizeof(CompactSpriteInstance)),
-        GpuBufferUsage::StorageRead,
-    });
+    {
+        GpuMemoryScope instanceScope(GpuMemoryCategory::SpriteInstances, _passname);
+        _spriteDataTransferBuffer = gpu.CreateTransferBuffer({
+            static_cast<uint32_t>(MAX_SPRITES * sizeof(CompactSpriteInstance)),
+            GpuTransferUsage::Upload,
+        });
+        _spriteDataBuffer         = gpu.CreateBuffer({
+            static_cast<uint32_t>(MAX_SPRITES * sizeof(CompactSpriteInstance)),
+            GpuBufferUsage::StorageRead,
+        });
+    }
 
     // Unit quad geometry (CompactVertex2D — posXy and uv packed as uint32 half-floats).
     struct QuadVertex {
@@ -496,6 +501,7 @@ void SpriteRenderPass::Render(
             }
             _effectTexW = std::max(pw, _effectTexW);
             _effectTexH = std::max(ph, _effectTexH);
+            GpuMemoryScope       memScope(GpuMemoryCategory::RenderTargets, _passname);
             GpuTextureCreateInfo texInfo {};
             texInfo.width       = _effectTexW;
             texInfo.height      = _effectTexH;
@@ -560,6 +566,10 @@ void SpriteRenderPass::Render(
     }
     gpu.UnmapTransferBuffer(_spriteDataTransferBuffer);
 
+    // The instance buffers hold MAX_SPRITES; GpuMemory counts the rest as wasted
+    GpuMemory::SetUsed(_spriteDataBuffer, spriteCount * sizeof(CompactSpriteInstance));
+    GpuMemory::SetUsed(_spriteDataTransferBuffer, spriteCount * sizeof(CompactSpriteInstance));
+
     // Upload to GPU buffer
     gpu.UploadToBuffer(cmdBuffer, _spriteDataTransferBuffer, 0, _spriteDataBuffer, 0,
         static_cast<uint32_t>(spriteCount * sizeof(CompactSpriteInstance)));
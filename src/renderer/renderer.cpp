@@ -5,6 +5,7 @@
 #include <chrono>
 #include "platform/audio/audio.h"
 #include "profiler/perf.h"
+#include "profiler/profiler.h"
 
 #include "assets/assethandler.h"
 #include "assets/shaders_generated.h"
@@ -15,6 +16,7 @@
 
 #include "gpu/renderpass.h"
 #include "gpu/presets.h"
+#include "gpu/memory/gpumemory.h"
 
 #include "renderer/passes/spriterenderpass.h"
 #include "renderer/passes/model3drenderpass.h"
@@ -166,12 +168,20 @@ void Renderer::_endFrame() {
     if (!_gpu)
         return;
 
+    LUMI_ZONE("Renderer::EndFrame");
+
     Draw::FlushPixels();
     Input::GetVirtualControls().Render();
     _gpu->ProcessPendingScreenshots();
 
     // ── Acquire command buffer and swapchain (IGpu interface) ─────────────────
-    _cmdbuf = _gpu->AcquireCommandBuffer();
+    uint32_t scWidth = 0, scHeight = 0;
+    {
+        LUMI_ZONE("Renderer::Acquire");
+        _cmdbuf = _gpu->AcquireCommandBuffer();
+        if (_cmdbuf)
+            _swapchainTexture = _gpu->AcquireSwapchainTexture(_cmdbuf, scWidth, scHeight);
+    }
     if (!_cmdbuf) {
         LOG_WARNING("Failed to acquire GPU command buffer");
 #ifdef LUMINOVEAU_WITH_IMGUI
@@ -180,8 +190,6 @@ void Renderer::_endFrame() {
         return;
     }
 
-    uint32_t scWidth = 0, scHeight = 0;
-    _swapchainTexture = _gpu->AcquireSwapchainTexture(_cmdbuf, scWidth, scHeight);
     if (scWidth > 0 && scHeight > 0) {
         // Authoritative present size -> Window::GetPhysicalWidth/Height. Drives viewport + blit
         // UV so they match the swapchain even when SDL_GetWindowSizeInPixels lies (Wayland
@@ -201,6 +209,8 @@ void Renderer::_endFrame() {
         // _onResize() reads GetPhysicalWidth/Height, which == the swapchain size set just above.
         _onResize();
     }
+    if (scWidth > 0 && scHeight > 0)
+        _reportWindowTargetUse(scWidth, scHeight);
 
     if (!_swapchainTexture) {
         Compute::Reset();
@@ -220,6 +230,10 @@ void Renderer::_endFrame() {
 
     Draw::ReleaseFramePixelTextures();
 
+    // Per-pass timing (perf HUD, profiler counters): every pass and the compute group below
+    // run in a timed scope while someone is looking at the numbers
+    _gpu->SetTimedScopesEnabled(Perf::Visible() || Profiler::IsCapturing());
+
     // ── MSAA-aware render-pass scheduling with pre/post compute split ──────────
     bool useMSAA = (_currentSampleCount > GpuSampleCount::X1);
 
@@ -248,6 +262,9 @@ void Renderer::_endFrame() {
                 bool isLastPass                 = (i == framebuffer->renderpasses.size() - 1);
                 bool nextNeedsResolved          = useThisMSAA && !isLastPass && framebuffer->renderpasses[i + 1].second->NeedsResolvedInput();
                 renderpass->renderTargetResolve = (useThisMSAA && (isLastPass || nextNeedsResolved)) ? framebuffer->fbContent : 0;
+
+                LUMI_ZONE(std::string_view(passname));
+                GpuTimedScope gpuScope(*_gpu, _cmdbuf, _gpu->TimedScopesEnabled() ? Profiler::Intern(passname) : nullptr);
                 renderpass->Render(_cmdbuf, renderTarget, fbCamera);
             }
         }
@@ -259,13 +276,26 @@ void Renderer::_endFrame() {
 #endif
 
     runPasses(true);
-    Particles::PrepareFrame(_cmdbuf);
-    Compute::ExecuteQueued(_cmdbuf);
-    Compute::Reset();
+    {
+        LUMI_ZONE("Renderer::Compute");
+        {
+            GpuTimedScope gpuScope(*_gpu, _cmdbuf, "Particles");
+            Particles::PrepareFrame(_cmdbuf);
+        }
+        {
+            GpuTimedScope gpuScope(*_gpu, _cmdbuf, "Compute");
+            Compute::ExecuteQueued(_cmdbuf);
+        }
+        Compute::Reset();
+    }
     runPasses(false);
 
     // ── Blit framebuffer to swapchain (IGpu interface) ────────────────────────
-    _renderFrameBuffer(_cmdbuf);
+    {
+        LUMI_ZONE("Renderer::Blit");
+        GpuTimedScope gpuScope(*_gpu, _cmdbuf, "Composite");
+        _renderFrameBuffer(_cmdbuf);
+    }
 
     // ── UI overlays (RmlUI is SDL-only today; opt-in via cmake flag) ──────────
 #ifdef LUMINOVEAU_WITH_RMLUI
@@ -311,6 +341,8 @@ void Renderer::_endFrame() {
     // When the perf HUD is open, fence the final submit and wait for GPU completion to time
     // real GPU work. Near-free when vsync-bound (the CPU would idle for the GPU anyway); zero
     // cost when the HUD is hidden.
+    LUMI_ZONE("Renderer::SubmitPresent");
+    _gpu->ResolveTimedScopes(_cmdbuf);
     if (Perf::Visible()) {
         auto           t0    = std::chrono::high_resolution_clock::now();
         GpuFenceHandle fence = _gpu->SubmitCommandBufferAndAcquireFence(_cmdbuf);
@@ -346,6 +378,16 @@ void Renderer::_endFrame() {
         have        = true;
     }
 
+    // A newly completed frame of pass timings -> the running profiler capture (the HUD reads
+    // them straight from the GPU). Lags the CPU by a few frames with real GPU timestamps.
+    if (_gpu->ScopeTimingsSerial() != _scopeTimingsSerial) {
+        _scopeTimingsSerial = _gpu->ScopeTimingsSerial();
+        if (Profiler::IsCapturing()) {
+            for (const GpuScopeTiming &timing : _gpu->ScopeTimings())
+                Profiler::RecordCounter(_gpu->HasGpuTimestamps() ? "GPU ms" : "Pass CPU ms", timing.name, timing.ms);
+        }
+    }
+
     // Per-frame draw stats -> perf HUD.
     if (Perf::Visible())
         Perf::ReportDraws(_gpu->FrameDrawCalls(), _gpu->FrameDrawVerts());
@@ -384,6 +426,7 @@ void Renderer::_useWindowTargets(void *sdlWindow, int w, int h) {
             _gpu->ReleaseTexture(t.depthMSAA);
         t = WindowTargets {};
 
+        GpuMemoryScope       memScope(GpuMemoryCategory::RenderTargets, "Renderer window targets");
         bool                 useMSAA = (_currentSampleCount > GpuSampleCount::X1);
         GpuTextureFormat     fmt     = _gpu->GetSwapchainFormat();
         GpuTextureCreateInfo contentInfo {
@@ -435,6 +478,28 @@ void Renderer::_useWindowTargets(void *sdlWindow, int w, int h) {
     fb->textureView.gpuTexture = t.content;
 }
 
+void Renderer::_reportWindowTargetUse(uint32_t width, uint32_t height) {
+    // Window targets are display-sized and grow-only: whatever lies outside the window counts as
+    // wasted in GpuMemory. Reported again only when the window (swapchain) size changes.
+    FrameBuffer *fb = _getFramebuffer("primaryFramebuffer");
+    if (!fb)
+        return;
+    for (auto &[win, t] : _windowTargets) {
+        if (t.content != fb->fbContent || (t.usedW == width && t.usedH == height))
+            continue;
+        t.usedW                    = width;
+        t.usedH                    = height;
+        const uint32_t         w   = std::min(width, (uint32_t)t.w);
+        const uint32_t         h   = std::min(height, (uint32_t)t.h);
+        const GpuTextureFormat fmt = _gpu->GetSwapchainFormat();
+        GpuMemory::SetUsed(t.content, GpuMemory::TextureBytes({ w, h, 1, 1, fmt }));
+        if (t.contentMSAA)
+            GpuMemory::SetUsed(t.contentMSAA, GpuMemory::TextureBytes({ w, h, 1, 1, fmt, t.samples }));
+        if (t.depthMSAA)
+            GpuMemory::SetUsed(t.depthMSAA, GpuMemory::TextureBytes({ w, h, 1, 1, GpuTextureFormat::D32_Float, t.samples }));
+    }
+}
+
 void Renderer::_releaseWindowTargets(void *sdlWindow) {
     auto it = _windowTargets.find(sdlWindow);
     if (it == _windowTargets.end())
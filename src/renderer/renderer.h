@@ -481,6 +481,7 @@ private:
     std::vector<std::pair<std::string, std::string>> _pendingFbCaptures; // (fbName, file)
 
     std::unique_ptr<IGpu> _gpu;
+    uint64_t              _scopeTimingsSerial = 0; // last pass-timing frame handed to the profiler
 
     uint32_t _zIndex = 0;
 
@@ -494,11 +495,13 @@ private:
         GpuTextureHandle depthMSAA   = 0; // MSAA depth (0 when MSAA off)
         int              w = 0, h = 0;
         GpuSampleCount   samples = GpuSampleCount::X1;
+        uint32_t         usedW = 0, usedH = 0; // window size last reported to GpuMemory
     };
     std::unordered_map<void *, WindowTargets> _windowTargets;
     void                                      _useWindowTargets(void *sdlWindow, int w, int h);
     void                                      _releaseWindowTargets(void *sdlWindow);
     void                                      _releaseAllWindowTargets();
+    void                                      _reportWindowTargetUse(uint32_t width, uint32_t height);
 
     void
     _addShaderPass(const std::string &passname, const ShaderAsset &vertShader, const ShaderAsset &fragShader, std::vector<std::string> targetBuffers);
@@ -23,12 +23,13 @@
 #include <sstream>
 #include <iomanip>
 
-#include "picosha2.h"
+#include "util/hash.h"
 
 // ── ShaderMetadata serialization ─────────────────────────────────────────────────
 std::string ShaderMetadata::Serialize() const {
     std::ostringstream oss;
     oss << "source_hash=" << sourceHash << "\n";
+    oss << "source_stamp=" << sourceStamp << "\n";
     oss << "shader_format=" << static_cast<int>(shaderFormat) << "\n";
     oss << "num_samplers=" << numSamplers << "\n";
     oss << "num_uniform_buffers=" << numUniformBuffers << "\n";
@@ -58,6 +59,8 @@ ShaderMetadata ShaderMetadata::Deserialize(const std::string &data) {
 
         if (key == "source_hash") {
             metadata.sourceHash = value;
+        } else if (key == "source_stamp") {
+            metadata.sourceStamp = value;
         } else if (key == "shader_format") {
             metadata.shaderFormat = static_cast<uint32_t>(std::stoi(value));
         } else if (key == "num_samplers") {
@@ -91,6 +94,7 @@ ShaderMetadata ShaderMetadata::Deserialize(const std::string &data) {
 static std::string           computeSourceHash(const std::string &source);
 static std::string           getCachePath(const std::string &filename, const std::string &extension);
 static std::string           getMetadataPath(const std::string &filename);
+static SDL_GPUShaderFormat   getRuntimeShaderFormat();
 static ShaderMetadata        extractMetadataFromSPIRV(const std::vector<uint32_t> &spirv);
 static std::vector<uint32_t> compileGLSLtoSPIRV(const std::string &source, EShLanguage shaderStage);
 static void                  fillResources(TBuiltInResource *resource);
@@ -142,7 +146,7 @@ void Shaders::_quit() {
 /// @cond INTERNAL
 // ── File-local cache + reflection helpers ────────────────────────────────────────
 static std::string computeSourceHash(const std::string &source) {
-    return picosha2::hash256_hex_string(source);
+    return ContentHash::Of(source).ToHex();
 }
 
 static std::string getCachePath(const std::string &filename, const std::string &extension) {
@@ -156,6 +160,16 @@ static std::string getMetadataPath(const std::string &filename) {
     return getCachePath(filename, ".meta");
 }
 
+static SDL_GPUShaderFormat getRuntimeShaderFormat() {
+    auto        formats = SDL_GetGPUShaderFormats(Renderer::GetDevice());
+    const char *driver  = SDL_GetGPUDeviceDriver(Renderer::GetDevice());
+    if (strcmp(driver, "direct3d12") == 0 || strcmp(driver, "direct3d11") == 0)
+        return (formats & SDL_GPU_SHADERFORMAT_DXIL) ? SDL_GPU_SHADERFORMAT_DXIL : SDL_GPU_SHADERFORMAT_DXBC;
+    if (strcmp(driver, "metal") == 0)
+        return SDL_GPU_SHADERFORMAT_METALLIB;
+    return SDL_GPU_SHADERFORMAT_SPIRV;
+}
+
 bool Shaders::_loadCachedShader(const std::string &cacheKey, std::vector<uint8_t> &outData) {
     if (!_shaderCache || !_shaderCache->HasFile(cacheKey))
         return false;
@@ -263,18 +277,8 @@ PhysFSFileData Shaders::_getShader(const std::string &filename) {
     }
 
     // Always cache SPIRV; cross-compile at runtime (SDL_shadercross doesn't expose DXIL extraction).
-    auto                formats = SDL_GetGPUShaderFormats(Renderer::GetDevice());
-    SDL_GPUShaderFormat runtimeFormat;
-    std::string         formatExt = ".spv";
-
-    const char *driver = SDL_GetGPUDeviceDriver(Renderer::GetDevice());
-    if (strcmp(driver, "direct3d12") == 0 || strcmp(driver, "direct3d11") == 0) {
-        runtimeFormat = (formats & SDL_GPU_SHADERFORMAT_DXIL) ? SDL_GPU_SHADERFORMAT_DXIL : SDL_GPU_SHADERFORMAT_DXBC;
-    } else if (strcmp(driver, "metal") == 0) {
-        runtimeFormat = SDL_GPU_SHADERFORMAT_METALLIB;
-    } else {
-        runtimeFormat = SDL_GPU_SHADERFORMAT_SPIRV;
-    }
+    SDL_GPUShaderFormat runtimeFormat = getRuntimeShaderFormat();
+    std::string         formatExt     = ".spv";
 
     std::string cachePath    = getCachePath(filename, formatExt);
     std::string metadataPath = getMetadataPath(filename);
@@ -282,12 +286,27 @@ PhysFSFileData Shaders::_getShader(const std::string &filename) {
     std::vector<uint8_t> cachedData;
     ShaderMetadata       cachedMetadata;
 
+    // Stamped before the source is read, so an edit made while compiling shows up next time
+    FileStamp sourceStamp = FileHandler::GetFileStamp(filename);
+
     if (_loadCachedShader(cachePath, cachedData) && _loadCachedMetadata(metadataPath, cachedMetadata)) {
-        auto        sourceFile = FileHandler::GetFileFromPhysFS(filename);
-        std::string source(static_cast<char *>(sourceFile.data), sourceFile.fileSize);
-        std::string sourceHash = computeSourceHash(source);
+        // Untouched since it was cached: no need to read or hash the source
+        bool valid = FileStamp::Parse(cachedMetadata.sourceStamp).Matches(sourceStamp);
+        if (!valid) {
+            auto        sourceFile = FileHandler::GetFileFromPhysFS(filename);
+            std::string source(static_cast<char *>(sourceFile.data), sourceFile.fileSize);
+            free(sourceFile.data);
+            valid = computeSourceHash(source) == cachedMetadata.sourceHash;
+
+            // Same content, new or untrusted stamp: re-stamp (saved with the pack at shutdown)
+            if (valid && sourceStamp.Valid() && _shaderCache) {
+                cachedMetadata.sourceStamp = sourceStamp.Serialize();
+                std::string metadataStr    = cachedMetadata.Serialize();
+                _shaderCache->AddFile(metadataPath, std::vector<uint8_t>(metadataStr.begin(), metadataStr.end()));
+            }
+        }
 
-        if (sourceHash == cachedMetadata.sourceHash) {
+        if (valid) {
             LOG_INFO("Loaded cached shader: {}", filename.c_str());
             filedata.fileDataVector = std::move(cachedData);
             filedata.data           = filedata.fileDataVector.data();
@@ -308,6 +327,7 @@ PhysFSFileData Shaders::_getShader(const std::string &filename) {
 
     auto        sourceFile = FileHandler::GetFileFromPhysFS(filename);
     std::string source(static_cast<char *>(sourceFile.data), sourceFile.fileSize);
+    free(sourceFile.data);
 
     auto spirvBlob = compileGLSLtoSPIRV(source, shaderStage);
     if (spirvBlob.empty()) {
@@ -316,6 +336,7 @@ PhysFSFileData Shaders::_getShader(const std::string &filename) {
 
     ShaderMetadata metadata = extractMetadataFromSPIRV(spirvBlob);
     metadata.sourceHash     = computeSourceHash(source);
+    metadata.sourceStamp    = sourceStamp.Valid() ? sourceStamp.Serialize() : "";
     metadata.shaderFormat   = runtimeFormat;
 
     std::vector<uint8_t> spirvBytes(
@@ -416,6 +437,59 @@ ShaderAsset Shaders::_createShaderAsset(const std::string &filename, GpuShaderSt
     return asset;
 }
 
+std::vector<uint32_t> Shaders::CompileGLSL(const std::string &source, GpuShaderStage stage) {
+    if (stage != GpuShaderStage::Vertex && stage != GpuShaderStage::Fragment) {
+        LOG_ERROR("Unsupported shader stage");
+        return {};
+    }
+    return compileGLSLtoSPIRV(source, stage == GpuShaderStage::Vertex ? EShLangVertex : EShLangFragment);
+}
+
+ShaderAsset Shaders::_createShaderAssetFromSource(const std::string &name, const std::string &source, GpuShaderStage stage) {
+    if (stage != GpuShaderStage::Vertex && stage != GpuShaderStage::Fragment) {
+        LOG_ERROR("Unsupported shader stage");
+        return {};
+    }
+
+    // Registered under `name` like a file, so _createShaderAsset and the disk cache find it.
+    // The name carries the source hash; the sourceHash check only guards against collisions.
+    if (!_shaderDataCache.contains(name)) {
+        std::string          cachePath    = getCachePath(name, ".spv");
+        std::string          metadataPath = getMetadataPath(name);
+        std::vector<uint8_t> spirvBytes;
+        ShaderMetadata       metadata;
+
+        if (_loadCachedShader(cachePath, spirvBytes) && _loadCachedMetadata(metadataPath, metadata)
+            && metadata.sourceHash == computeSourceHash(source)) {
+            LOG_INFO("Loaded cached shader: {}", name.c_str());
+        } else {
+            LOG_INFO("Compiling shader: {}", name.c_str());
+            auto spirvBlob = CompileGLSL(source, stage);
+            if (spirvBlob.empty()) {
+                LOG_ERROR("failed to compile generated shader to SPIRV: {}", name);
+                return {};
+            }
+
+            metadata              = extractMetadataFromSPIRV(spirvBlob);
+            metadata.sourceHash   = computeSourceHash(source);
+            metadata.shaderFormat = getRuntimeShaderFormat();
+            spirvBytes.assign(reinterpret_cast<const uint8_t *>(spirvBlob.data()),
+                reinterpret_cast<const uint8_t *>(spirvBlob.data() + spirvBlob.size()));
+
+            _saveCachedShader(cachePath, spirvBytes);
+            _saveCachedMetadata(metadataPath, metadata);
+        }
+
+        PhysFSFileData &filedata = _shaderDataCache[name];
+        filedata.fileDataVector  = std::move(spirvBytes);
+        filedata.data            = filedata.fileDataVector.data();
+        filedata.fileSize        = static_cast<int>(filedata.fileDataVector.size());
+        _metadataCache[name]     = metadata;
+    }
+
+    return _createShaderAsset(name, stage);
+}
+
 ComputePipelineAsset Shaders::_createComputePipeline(const std::string &filename) {
     PhysFSFileData shaderData = _getShader(filename);
     if (!shaderData.data || shaderData.fileSize == 0) {
@@ -25,6 +25,7 @@
  */
 struct ShaderMetadata {
     std::string                             sourceHash;     ///< Hash of the source the blob was built from.
+    std::string                             sourceStamp;    ///< FileStamp of that source; lets a warm load skip hashing.
     std::vector<std::string>                samplerNames;   ///< Reflected sampler binding names.
     std::unordered_map<std::string, size_t> uniformOffsets; ///< Reflected uniform byte offsets.
     std::unordered_map<std::string, size_t> uniformSizes;   ///< Reflected uniform byte sizes.
@@ -69,6 +70,23 @@ public:
      */
     static ShaderAsset CreateShaderAsset(const std::string &filename, GpuShaderStage stage) { return Get()._createShaderAsset(filename, stage); }
 
+    /**
+     * @brief Compiles GLSL generated at runtime (e.g. a fused effect chain) into a shader asset.
+     * @param name Cache name; include a hash of the source so a cached blob always matches it.
+     * @param source GLSL source.
+     * @param stage Vertex or fragment.
+     * @return The shader asset; gpuShader is 0 if the source didn't compile.
+     */
+    static ShaderAsset CreateShaderAssetFromSource(const std::string &name, const std::string &source, GpuShaderStage stage) { return Get()._createShaderAssetFromSource(name, source, stage); }
+
+    /**
+     * @brief Compiles GLSL to SPIRV with glslang, without creating a GPU shader (SDL backend only).
+     * @param source GLSL source.
+     * @param stage Vertex or fragment.
+     * @return The SPIRV words; empty if the source didn't compile (the errors are logged).
+     */
+    static std::vector<uint32_t> CompileGLSL(const std::string &source, GpuShaderStage stage);
+
     /**
      * @brief Loads a compute shader and creates its pipeline via the active backend.
      * @param filename Compute shader path inside the resource pack.
@@ -98,6 +116,7 @@ private:
     const char *_getComputeEntryPoint();
 
     ShaderAsset          _createShaderAsset(const std::string &filename, GpuShaderStage stage);
+    ShaderAsset          _createShaderAssetFromSource(const std::string &name, const std::string &source, GpuShaderStage stage);
     ComputePipelineAsset _createComputePipeline(const std::string &filename);
     ComputePipelineAsset _createComputePipelineFromBytes(const uint8_t *spirvBytes, size_t spirvSize);
 
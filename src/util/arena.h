@@ -0,0 +1,109 @@
+#pragma once
+
+// Bump-pointer arena for short-lived data (per-frame queues, scratch lists). Allocation is a
+// pointer bump; nothing is freed individually — Reset() rewinds the whole arena in O(1) and
+// keeps its memory, so after the first few frames a per-frame arena never touches the heap.
+//
+// Objects placed with New<T>() are NOT destroyed on Reset; use it for trivially destructible
+// data, or destroy them yourself first. Not thread-safe.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// @brief Growable bump allocator; Reset() frees everything at once.
+class Arena {
+public:
+    /// @param blockSize Size of each backing block. Allocations larger than this get their own block.
+    explicit Arena(size_t blockSize = 64 * 1024)
+        : _blockSize(blockSize) { }
+
+    Arena(const Arena &)            = delete;
+    Arena &operator=(const Arena &) = delete;
+    Arena(Arena &&)                 = default;
+    Arena &operator=(Arena &&)      = default;
+
+    /// @brief Returns `size` bytes aligned to `align` (a power of two). Never returns nullptr.
+    void *Allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        if (_current < _blocks.size()) {
+            Block    &block   = _blocks[_current];
+            uintptr_t base    = reinterpret_cast<uintptr_t>(block.data.get());
+            uintptr_t aligned = (base + _offset + align - 1) & ~(uintptr_t(align) - 1);
+            if (aligned + size <= base + block.size) {
+                _offset = (aligned - base) + size;
+                _used += size;
+                return reinterpret_cast<void *>(aligned);
+            }
+        }
+        return _allocateSlow(size, align);
+    }
+
+    /// @brief Constructs a T in the arena. Its destructor is never run by the arena.
+    template <typename T, typename... Args>
+    T *New(Args &&...args) {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /// @brief Uninitialized storage for `count` Ts.
+    template <typename T>
+    T *AllocateArray(size_t count) {
+        return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// @brief Rewinds to empty. If the last cycle spilled into several blocks they're merged into
+    /// one block of the combined size, so a steady workload settles on a single block.
+    void Reset() {
+        if (_blocks.size() > 1) {
+            size_t total = 0;
+            for (const auto &block : _blocks)
+                total += block.size;
+            _blocks.clear();
+            _blocks.push_back({ std::make_unique<std::byte[]>(total), total });
+        }
+        _current = 0;
+        _offset  = 0;
+        _used    = 0;
+    }
+
+    /// @brief Bytes handed out since the last Reset (excluding alignment padding).
+    size_t GetBytesUsed() const { return _used; }
+
+    /// @brief Total bytes of backing memory currently owned.
+    size_t GetCapacity() const {
+        size_t total = 0;
+        for (const auto &block : _blocks)
+            total += block.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t                       size = 0;
+    };
+
+    void *_allocateSlow(size_t size, size_t align) {
+        // Move on to the next block that can hold it (blocks past _current are free), or add one
+        while (++_current < _blocks.size()) {
+            if (_blocks[_current].size >= size + align)
+                break;
+        }
+        if (_current >= _blocks.size()) {
+            const size_t blockSize = std::max(_blockSize, size + align);
+            _blocks.push_back({ std::make_unique<std::byte[]>(blockSize), blockSize });
+            _current = _blocks.size() - 1;
+        }
+        _offset = 0;
+        return Allocate(size, align);
+    }
+
+    std::vector<Block> _blocks;
+    size_t             _blockSize;
+    size_t             _current = 0;
+    size_t             _offset  = 0;
+    size_t             _used    = 0;
+};
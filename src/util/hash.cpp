@@ -0,0 +1,90 @@
+#include "util/hash.h"
+
+#include <charconv>
+#include <filesystem>
+
+#include "util/helpers.h"
+
+// Everything xxHash is static to this file
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+struct ContentHasher::State {
+    XXH3_state_t xxh;
+};
+
+namespace {
+ContentHash fromXxh(XXH128_hash_t hash) {
+    return { hash.low64, hash.high64 };
+}
+} // namespace
+
+ContentHash ContentHash::Of(const void *data, size_t size) {
+    return fromXxh(XXH3_128bits(data, size));
+}
+
+std::string ContentHash::ToHex() const {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+
+    std::string hex(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        hex[15 - i] = DIGITS[(high >> (i * 4)) & 0xF];
+        hex[31 - i] = DIGITS[(low >> (i * 4)) & 0xF];
+    }
+    return hex;
+}
+
+ContentHasher::ContentHasher()
+    : _state(std::make_unique<State>()) {
+    Reset();
+}
+
+ContentHasher::~ContentHasher() = default;
+
+void ContentHasher::Update(const void *data, size_t size) {
+    XXH3_128bits_update(&_state->xxh, data, size);
+}
+
+ContentHash ContentHasher::Digest() const {
+    return fromXxh(XXH3_128bits_digest(&_state->xxh));
+}
+
+void ContentHasher::Reset() {
+    XXH3_128bits_reset(&_state->xxh);
+}
+
+FileStamp FileStamp::Of(const std::string &path) {
+    FileStamp stamp;
+    stamp.modified = static_cast<int64_t>(Helpers::GetFileModificationTime(path));
+    if (!stamp.Valid())
+        return stamp;
+
+    std::error_code error;
+    stamp.size  = std::filesystem::file_size(path, error);
+    stamp.taken = static_cast<int64_t>(std::time(nullptr));
+    if (error)
+        stamp.modified = 0;
+    return stamp;
+}
+
+std::string FileStamp::Serialize() const {
+    return std::to_string(modified) + ":" + std::to_string(size) + ":" + std::to_string(taken);
+}
+
+FileStamp FileStamp::Parse(std::string_view text) {
+    FileStamp   stamp;
+    const char *end = text.data() + text.size();
+
+    auto field = [&](const char *from, auto &value, char separator) -> const char * {
+        auto [ptr, error] = std::from_chars(from, end, value);
+        if (error != std::errc() || (separator && (ptr == end || *ptr != separator)))
+            return nullptr;
+        return separator ? ptr + 1 : ptr;
+    };
+    const char *next = field(text.data(), stamp.modified, ':');
+    next             = next ? field(next, stamp.size, ':') : nullptr;
+    next             = next ? field(next, stamp.taken, 0) : nullptr;
+    if (!next || next != end)
+        return {};
+    return stamp;
+}
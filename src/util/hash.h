@@ -0,0 +1,83 @@
+#pragma once
+
+// Content hashing for cache keys (font cache, shader cache): XXH3-128 from the vendored xxHash
+// (src/extern/xxhash.h), which takes the widest SIMD path the build targets (SSE2/AVX2/NEON,
+// scalar elsewhere). It detects changed content; it isn't cryptographic.
+//
+//   ContentHash::Of(data, size)               one shot
+//   ContentHasher h; h.Update(..); h.Digest()  streaming; same result as one shot over it all
+//
+// FileStamp is the cheap check in front of it: a file's mtime and size, plus when they were
+// read. A cache entry whose stamp still matches can skip reading and hashing its source. A file
+// written in the same second as its stamp was taken could change again without its mtime
+// moving, so such a stamp isn't trusted; the caller hashes once more and re-stamps.
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/// @brief A 128-bit content hash.
+struct ContentHash {
+    uint64_t low  = 0;
+    uint64_t high = 0;
+
+    /// @brief Hash of a byte range.
+    static ContentHash Of(const void *data, size_t size);
+    /// @brief Hash of a string's bytes.
+    static ContentHash Of(std::string_view text) { return Of(text.data(), text.size()); }
+
+    /// @brief 32 lowercase hex digits, high half first.
+    std::string ToHex() const;
+
+    bool operator==(const ContentHash &) const = default;
+};
+
+/// @brief Incremental ContentHash over data that arrives in pieces (e.g. a file read in chunks).
+class ContentHasher {
+public:
+    ContentHasher();
+    ~ContentHasher();
+
+    ContentHasher(const ContentHasher &)            = delete;
+    ContentHasher &operator=(const ContentHasher &) = delete;
+
+    /// @brief Appends bytes.
+    void Update(const void *data, size_t size);
+    /// @brief Hash of everything appended so far; more can be appended afterwards.
+    ContentHash Digest() const;
+    /// @brief Starts over, as if newly constructed.
+    void Reset();
+
+private:
+    struct State;
+    std::unique_ptr<State> _state;
+};
+
+/// @brief A file's modification time and size, as a pre-check before hashing its content.
+struct FileStamp {
+    /// mtimes within this many seconds of the stamp aren't trusted (FAT has 2 s granularity)
+    static constexpr int64_t MTIME_SLACK = 2;
+
+    int64_t  modified = 0; ///< mtime in seconds; 0 = nothing on disk to stamp
+    uint64_t size     = 0; ///< bytes
+    int64_t  taken    = 0; ///< when the stamp was read
+
+    /// @brief Stamps a file on the real filesystem (Helpers::GetFileModificationTime).
+    static FileStamp Of(const std::string &path);
+
+    bool Valid() const { return modified != 0; }
+
+    /// @brief True if `current` describes the same, untouched file as this stored stamp.
+    bool Matches(const FileStamp &current) const {
+        return Valid() && modified == current.modified && size == current.size
+            && modified + MTIME_SLACK < taken;
+    }
+
+    /// @brief "modified:size:taken", for cache metadata.
+    std::string Serialize() const;
+    /// @brief Parses Serialize's output; an invalid stamp on malformed input.
+    static FileStamp Parse(std::string_view text);
+};
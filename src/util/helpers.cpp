@@ -1,6 +1,9 @@
 #include "helpers.h"
 
 #include "assets/assethandler.h"
+#include "platform/cpu/cputopology.h"
+#include "util/random.h"
+#include "util/threadpool.h"
 
 #include "SDL3/SDL.h"
 
@@ -16,6 +19,7 @@
 #elif defined(__linux__) && !defined(__ANDROID__)
 #include <sys/sysinfo.h>
 #elif defined(__APPLE__)
+#include <pthread/qos.h>
 #include <sys/types.h>
 #include <sys/sysctl.h>
 #elif defined(__ANDROID__)
@@ -118,24 +122,11 @@ std::vector<std::pair<vf2d, vf2d>> Helpers::GetLinesFromRectangle(rectf rect) {
 }
 
 bool Helpers::RandomChance(const float required) {
-
-    std::default_random_engine             generator(time(0));
-    std::uniform_real_distribution<double> distribution;
-
-    const float chance = distribution(generator);
-
-    if (chance > (required / 100.0f))
-        return true;
-    return false;
+    return Random::Chance(required);
 }
 
 int Helpers::GetRandomValue(int min, int max) {
-    static std::mt19937 gen = []() {
-        std::random_device rd;
-        return std::mt19937(rd());
-    }();
-    std::uniform_int_distribution<> distr(min, max);
-    return distr(gen);
+    return Random::Range(min, max);
 }
 
 const char *Helpers::TextFormat(const char *text, ...) {
@@ -273,3 +264,84 @@ time_t Helpers::GetFileModificationTime(const std::string &filepath) {
     }
     return 0; // Return 0 if file doesn't exist or error
 }
+
+Platform::Platform()  = default;
+Platform::~Platform() = default;
+
+const CpuTopology &Platform::_topology() {
+    std::call_once(_cpuDetected, [this] {
+        _cpu = std::make_unique<CpuTopology>(CpuTopology::Detect());
+        LOG_INFO("CPU: {} cores / {} threads ({} performance, {} efficiency), {} cores allowed{}",
+            _cpu->physicalCores, _cpu->logicalCores, _cpu->performanceCores, _cpu->efficiencyCores, _cpu->allowedPhysical,
+            _cpu->cpuQuota > 0.0 ? fmt::format(", cgroup quota {:.2f} CPUs", _cpu->cpuQuota) : std::string());
+    });
+    return *_cpu;
+}
+
+unsigned int Platform::_threadBudget() {
+#ifdef __EMSCRIPTEN__
+    return 1u;
+#else
+    const unsigned int budget = _budgetOverride;
+    return budget > 0 ? budget : _topology().UsableCores();
+#endif
+}
+
+unsigned int Platform::_workerCount(ThreadRole role) {
+#ifdef __EMSCRIPTEN__
+    LUMI_UNUSED(role);
+    return 0u; // no std::thread without -pthread: pools run inline
+#else
+    // The thread that queued frame work waits for it, so the workers get the whole budget
+    const unsigned int budget = _threadBudget();
+    if (budget <= 1)
+        return 0u;
+    return role == ThreadRole::Frame ? budget : std::max(1u, budget / 2);
+#endif
+}
+
+ThreadPool &Platform::_workers(ThreadRole role) {
+    std::lock_guard<std::mutex> lock(_poolMutex);
+    std::unique_ptr<ThreadPool> &pool = _pools[static_cast<int>(role)];
+    if (!pool)
+        pool = std::make_unique<ThreadPool>(_workerCount(role), [role](size_t index) { Platform::ApplyThreadHints(role, index); });
+    return *pool;
+}
+
+void Platform::_applyThreadHints(ThreadRole role, size_t index) {
+    const ThreadAffinity affinity = _affinity;
+    if (affinity != ThreadAffinity::None) {
+        const CpuTopology &cpu = _topology();
+
+        // Frame work on the performance cores; background work on the efficiency cores if the
+        // CPU has any, else anywhere
+        const bool                             wantEfficiency = role == ThreadRole::Background;
+        std::vector<const CpuTopology::Core *> cores;
+        for (const CpuTopology::Core &core : cpu.cores) {
+            if (core.efficiency == wantEfficiency)
+                cores.push_back(&core);
+        }
+
+        std::vector<int> cpus;
+        if (affinity == ThreadAffinity::Pinned && role == ThreadRole::Frame && !cores.empty()) {
+            cpus = cores[index % cores.size()]->cpus;
+        } else if (!wantEfficiency || cpu.IsHybrid()) {
+            for (const CpuTopology::Core *core : cores)
+                cpus.insert(cpus.end(), core->cpus.begin(), core->cpus.end());
+        }
+        if (!cpus.empty() && !CpuTopology::PinCurrentThread(cpus))
+            LOG_WARNING("Could not set the affinity of a worker thread");
+
+#if defined(__APPLE__)
+        // macOS has no CPU affinity; the utility QoS class is what keeps a thread on E-cores
+        if (wantEfficiency)
+            pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#endif
+    }
+
+    switch (static_cast<ThreadPriority>(_priority[static_cast<int>(role)])) {
+    case ThreadPriority::Low: SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_LOW); break;
+    case ThreadPriority::Normal: break;
+    case ThreadPriority::High: SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_HIGH); break;
+    }
+}
@@ -4,9 +4,12 @@
 #include "math/vectors.h"
 #include "math/rectangles.h"
 
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <regex>
 
 #ifndef _MSC_VER
@@ -26,26 +29,79 @@
 template <typename... T>
 inline void LUMI_UNUSED(T &&...) { } // NOLINT(readability-identifier-naming) — macro-style unused-arg sink
 
-/// @brief Platform-specific queries (thread budget, and future host-capability hooks).
+struct CpuTopology;
+class ThreadPool;
+
+/// @brief What a worker pool is for; decides its size and the hints applied to its threads.
+enum class ThreadRole {
+    Frame,      ///< Work the frame waits on (sprite packing): the whole budget, normal priority.
+    Background, ///< Work nothing waits on this frame (glyph rasterization): half the budget, low priority.
+};
+
+/// @brief Where the engine's worker threads may run. A hint: platforms without hard affinity ignore it.
+enum class ThreadAffinity {
+    None,     ///< Wherever the OS schedules them (default).
+    CoreType, ///< Hybrid CPUs: frame workers on performance cores, background workers on efficiency cores.
+    Pinned,   ///< As CoreType, and each frame worker kept on a physical core of its own.
+};
+
+/// @brief Scheduling priority hint for a role's worker threads.
+enum class ThreadPriority { Low, Normal, High };
+
+/// @brief Platform-specific queries: CPU topology, the engine-wide thread budget and the worker
+/// pools sized from it.
+///
+/// The budget is the number of cores compute-bound work can keep busy: physical cores in the
+/// process's affinity mask, capped by a container's CPU quota (platform/cpu/cputopology.h), or
+/// Settings::SetThreadBudget. Every engine pool is sized from it, so the pools together don't
+/// oversubscribe the machine.
 class Platform {
 public:
-    /**
-     * @brief Returns a sensible default thread count for parallelizable work.
-     *
-     * Used for e.g. MSDF atlas generation and texture decompression. Returns 1 on
-     * Emscripten without -pthread (can't spawn std::thread); elsewhere scales toward
-     * hardware concurrency, capped to avoid oversubscribing many-core machines.
-     */
-    static unsigned int DefaultThreadCount() { return Get()._defaultThreadCount(); }
+    /// @brief The detected CPU topology (read once, on first use).
+    static const CpuTopology &Topology() { return Get()._topology(); }
+
+    /// @brief Threads parallel work should use: Settings::SetThreadBudget if set, else the usable
+    /// cores of the topology. 1 on Emscripten without -pthread.
+    static unsigned int ThreadBudget() { return Get()._threadBudget(); }
+
+    /// @brief Worker threads a pool for `role` gets: the whole budget for frame work, half of it
+    /// for background work. 0 (run inline) where threads can't be spawned or the budget is 1.
+    static unsigned int WorkerCount(ThreadRole role) { return Get()._workerCount(role); }
+
+    /// @brief The engine's shared pool for `role`, created on first use. Game code may queue on it
+    /// too (e.g. SpatialIndex::Rebuild); it lives until exit.
+    static ThreadPool &Workers(ThreadRole role) { return Get()._workers(role); }
+
+    /// @brief Applies the configured affinity and priority for `role` to the calling thread;
+    /// `index` tells Pinned which core. The shared pools call it on each worker; call it at
+    /// the top of a thread of your own that does the same kind of work.
+    static void ApplyThreadHints(ThreadRole role, size_t index) { Get()._applyThreadHints(role, index); }
+
+    /// @brief Same as ThreadBudget().
+    static unsigned int DefaultThreadCount() { return Get()._threadBudget(); }
+
+    /// @cond INTERNAL
+    // Settings forwards here. Pools created before a change keep their size and hints.
+    static void SetThreadBudget(unsigned int threads) { Get()._budgetOverride = threads; }
+    static void SetThreadAffinity(ThreadAffinity affinity) { Get()._affinity = affinity; }
+    static void SetThreadPriority(ThreadRole role, ThreadPriority priority) { Get()._priority[static_cast<int>(role)] = priority; }
+    /// @endcond
 
 private:
-    unsigned int _defaultThreadCount() {
-#ifdef __EMSCRIPTEN__
-        return 1u;
-#else
-        return 8u;
-#endif
-    }
+    const CpuTopology &_topology();
+    unsigned int       _threadBudget();
+    unsigned int       _workerCount(ThreadRole role);
+    ThreadPool        &_workers(ThreadRole role);
+    void               _applyThreadHints(ThreadRole role, size_t index);
+
+    std::once_flag               _cpuDetected;
+    std::unique_ptr<CpuTopology> _cpu;
+    std::mutex                   _poolMutex;
+    std::unique_ptr<ThreadPool>  _pools[2];
+
+    std::atomic<unsigned int>   _budgetOverride { 0 };
+    std::atomic<ThreadAffinity> _affinity { ThreadAffinity::None };
+    std::atomic<ThreadPriority> _priority[2] { ThreadPriority::Normal, ThreadPriority::Low };
 
 public:
     /// @cond INTERNAL
@@ -58,7 +114,8 @@ public:
     /// @endcond
 
 private:
-    Platform() = default;
+    Platform(); // out of line: CpuTopology and ThreadPool are incomplete here
+    ~Platform(); // joins the pools
 };
 
 /// @brief Assorted math, random, geometry and string utility helpers.
@@ -85,7 +142,7 @@ public:
     /// @brief printf-style formats text into a rotating static buffer (raylib-style).
     static const char *TextFormat(const char *text, ...);
 
-    /// @brief Returns a random integer in the inclusive [min, max] range.
+    /// @brief Returns a random integer in the inclusive [min, max] range (Random's main stream).
     static int GetRandomValue(int min, int max);
 
     /// @brief Returns total system RAM in bytes.
@@ -1,42 +1,62 @@
 #include "util/lerp.h"
 
-#include "platform/window/window.h"
+#include <cmath>
 
-LerpAnimator *Lerp::_getLerp(const char *name, float startValue, float change, float duration) {
+#include "core/log/log.h"
 
-    if (_lerpList.find(name) == _lerpList.end()) {
-        _tempLerp             = new LerpAnimator();
-        _tempLerp->time       = 0.0f;
-        _tempLerp->startValue = startValue;
-        _tempLerp->change     = change;
-        _tempLerp->duration   = duration;
-        _lerpList.try_emplace(name, _tempLerp);
-        _tempLerp = nullptr;
+LerpEasingAlias &LerpEasingAlias::operator=(float (*ease)(float time, float startValue, float change, float duration)) {
+    // Function pointers can't be compared (math/easings.h is static inline per translation unit),
+    // so identify the curve by sampling it
+    for (size_t e = 0; e < static_cast<size_t>(Easing::Count); ++e) {
+        const auto easing  = static_cast<Easing>(e);
+        bool       matches = true;
+        for (int i = 1; i < 16 && matches; ++i) {
+            const float t = static_cast<float>(i) / 16.0f;
+            matches       = std::fabs(ease(t, 0.0f, 1.0f, 1.0f) - Tween::Evaluate(easing, t)) < 1e-4f;
+        }
+        if (matches) {
+            Tween::SetEasing(handle, easing);
+            return *this;
+        }
     }
-    return _lerpList[name];
+
+    LOG_WARNING("LerpAnimator::callback: not a built-in easing curve, ignored (use SetEasing)");
+    return *this;
 }
 
-LerpAnimator *Lerp::_getLerp(const char *name) {
-    if (_lerpList.contains(name)) {
-        return _lerpList[name];
+LerpAnimator *Lerp::_getLerp(const char *name, float startValue, float change, float duration) {
+    auto it = _lerpList.find(name);
+    if (it == _lerpList.end()) {
+        LerpAnimator animator;
+        animator.name             = name;
+        animator.handle           = Tween::Start(startValue, startValue + change, duration);
+        animator.startValue       = startValue;
+        animator.change           = change;
+        animator.duration         = duration;
+        animator.callback.handle  = animator.handle;
+        animator.time.handle      = animator.handle;
+        animator.started.handle   = animator.handle;
+        animator.canDelete.handle = animator.handle;
+        it                        = _lerpList.try_emplace(name, animator).first;
     }
+    return &it->second;
+}
 
-    return nullptr;
+LerpAnimator *Lerp::_getLerp(const char *name) {
+    auto it = _lerpList.find(name);
+    return it != _lerpList.end() ? &it->second : nullptr;
 }
 
 void Lerp::_resetTime(const char *name) {
-    if (_lerpList.contains(name))
-        _lerpList[name]->time = 0.0f;
+    auto it = _lerpList.find(name);
+    if (it != _lerpList.end())
+        Tween::Restart(it->second.handle);
 }
 
-void Lerp::_updateLerps() {
-    for (auto &lerp : _lerpList) {
-        if (lerp.second->started) {
-            if (lerp.second->IsFinished())
-                lerp.second->canDelete = true;
-            else {
-                lerp.second->time += (float)Window::GetFrameTime();
-            }
-        }
+void Lerp::_removeLerp(const char *name) {
+    auto it = _lerpList.find(name);
+    if (it != _lerpList.end()) {
+        Tween::Stop(it->second.handle);
+        _lerpList.erase(it);
     }
 }
@@ -1,35 +1,88 @@
 #pragma once
 
-#include <vector>
-#include <functional>
 #include <algorithm>
 #include <unordered_map>
 
-#include "math/easings.h"
+#include "util/tween.h"
 
 /**
- * @brief Struct for linear interpolation (lerp) animation.
+ * @brief Stand-in for LerpAnimator's old `callback` member, kept so existing assignments compile.
+ *
+ * Assigning an easing function (the math/easings.h ones, e.g. EaseQuadOut) selects the
+ * matching curve through SetEasing. The tween pool only runs its built-in curves, so any other
+ * function logs a warning and leaves the curve unchanged.
+ */
+struct LerpEasingAlias {
+    TweenHandle handle; /**< The animator's tween. */
+
+    [[deprecated("Use LerpAnimator::SetEasing")]] LerpEasingAlias &operator=(float (*ease)(float time, float startValue, float change, float duration));
+};
+
+/**
+ * @brief Stand-in for LerpAnimator's old `time` member: seconds played, read from and sought on
+ * the animator's tween.
+ */
+struct LerpTimeAlias {
+    TweenHandle handle; /**< The animator's tween. */
+
+    [[deprecated("Use Tween::GetTime")]] operator float() const { return Tween::GetTime(handle); }
+
+    [[deprecated("Use Tween::Seek, or Lerp::ResetTime to rewind")]] LerpTimeAlias &operator=(float time) {
+        Tween::Seek(handle, time);
+        return *this;
+    }
+
+    [[deprecated("Use Tween::Seek")]] LerpTimeAlias &operator+=(float dt) {
+        Tween::Seek(handle, Tween::GetTime(handle) + dt);
+        return *this;
+    }
+};
+
+/**
+ * @brief Stand-in for LerpAnimator's old `started` member: false while the tween is paused.
+ * Assigning pauses or resumes it.
+ */
+struct LerpStartedAlias {
+    TweenHandle handle; /**< The animator's tween. */
+
+    [[deprecated("Use Tween::IsPaused")]] operator bool() const { return !Tween::IsPaused(handle); }
+
+    [[deprecated("Use Tween::Pause / Tween::Resume")]] LerpStartedAlias &operator=(bool started) {
+        if (started)
+            Tween::Resume(handle);
+        else
+            Tween::Pause(handle);
+        return *this;
+    }
+};
+
+/**
+ * @brief Stand-in for LerpAnimator's old `canDelete` member: true once the animation finished.
+ * Read-only; the engine never acted on it.
+ */
+struct LerpCanDeleteAlias {
+    TweenHandle handle; /**< The animator's tween. */
+
+    [[deprecated("Use LerpAnimator::IsFinished")]] operator bool() const { return Tween::IsFinished(handle); }
+};
+
+/**
+ * @brief Named lerp animation, backed by a tween in the Tween pool.
+ *
+ * Kept for the name-keyed Lerp API; new code can hold a TweenHandle directly.
  */
 struct LerpAnimator {
 public:
-    const char *name;                 /**< The name of the animator. */
-    bool        canDelete    = false; /**< Flag indicating if the animator can be deleted. */
-    bool        shouldDelete = false; /**< Flag indicating if the animator should be deleted. */
-    bool        started      = true;  /**< Flag indicating if the animation has started. */
-    float       time;                 /**< Current time of the animation. */
-    float       startValue;           /**< Starting value of the animation. */
-    float       change;               /**< Change in value over the animation. */
-    float       duration;             /**< Duration of the animation. */
+    const char *name;       /**< The name of the animator. */
+    TweenHandle handle;     /**< The underlying tween. */
+    float       startValue; /**< Starting value of the animation. */
+    float       change;     /**< Change in value over the animation. */
+    float       duration;   /**< Duration of the animation. */
 
-    /**
-     * @brief Callback function to compute the interpolated value.
-     *
-     * The default callback performs linear interpolation.
-     */
-    std::function<float(float time, float startValue, float change, float duration)> callback = [](float time, float startValue, float change,
-                                                                                                    float duration) {
-        return (change * time / duration + startValue);
-    };
+    LerpEasingAlias    callback;  /**< Deprecated: use SetEasing. */
+    LerpTimeAlias      time;      /**< Deprecated: use Tween::GetTime / Tween::Seek on `handle`. */
+    LerpStartedAlias   started;   /**< Deprecated: use Tween::Pause / Tween::Resume on `handle`. */
+    LerpCanDeleteAlias canDelete; /**< Deprecated: use IsFinished. */
 
     /**
      * @brief Checks if the animation has finished.
@@ -37,24 +90,30 @@ public:
      * @return True if the animation has finished, false otherwise.
      */
     bool IsFinished() const {
-        return time >= duration;
+        return Tween::IsFinished(handle);
     }
 
     /**
      * @brief Gets the current interpolated value of the animation.
      *
-     * @return The current interpolated value.
+     * @return The current interpolated value, clamped to [startValue, startValue + change].
      */
-    float GetValue() {
-        // Compute interpolated value using the callback function
-        float result = callback(time, startValue, change, duration);
-
+    float GetValue() const {
         // Calculate the minimum and maximum possible values
         float minValue = std::min(startValue, startValue + change);
         float maxValue = std::max(startValue, startValue + change);
 
         // Clamp the result within the range [minValue, maxValue]
-        return std::clamp(result, minValue, maxValue);
+        return std::clamp(Tween::GetValue(handle), minValue, maxValue);
+    }
+
+    /**
+     * @brief Sets the easing curve (linear by default).
+     *
+     * @param easing The curve to use from now on.
+     */
+    void SetEasing(Easing easing) {
+        Tween::SetEasing(handle, easing);
     }
 };
 /**
@@ -95,15 +154,22 @@ public:
     }
 
     /**
-     * @brief Updates all active lerps.
+     * @brief Removes the lerp animator with the specified name and releases its tween.
+     *
+     * @param name The name of the lerp animator.
      */
-    static void UpdateLerps() {
-        Get()._updateLerps();
+    static void RemoveLerp(const char *name) {
+        Get()._removeLerp(name);
     }
 
+    /**
+     * @brief Lerps are advanced with every other tween by Tween::Update, which Window calls
+     * each frame; kept so existing callers still compile.
+     */
+    [[deprecated("Lerps are updated by Tween::Update every frame")]] static void UpdateLerps() { }
+
 private:
-    std::unordered_map<const char *, LerpAnimator *> _lerpList;
-    LerpAnimator                                    *_tempLerp = nullptr;
+    std::unordered_map<const char *, LerpAnimator> _lerpList;
 
     LerpAnimator *_getLerp(const char *name, float startValue, float change, float duration);
 
@@ -111,7 +177,7 @@ private:
 
     void _resetTime(const char *name);
 
-    void _updateLerps();
+    void _removeLerp(const char *name);
 
 public:
     /// @cond INTERNAL
@@ -0,0 +1,93 @@
+#pragma once
+
+// Bounded multi-producer/single-consumer ring (Vyukov's sequence-numbered slots). Producers
+// claim a slot with one CAS and fill it in place, so large records are never copied and no
+// producer ever waits on another's lock. Capacity must be a power of two.
+//
+// Only one thread may consume at a time; serialize Drain externally if several can.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Fixed-capacity MPSC queue. Any number of threads may push; one drains.
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < Capacity; ++i)
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Producer side. Claims a slot and calls fill(T &) to construct the element in place.
+     * @return false (and never calls fill) if the ring is full.
+     */
+    template <typename F>
+    bool TryPush(F &&fill) {
+        size_t pos = _head.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot          &slot = _slots[pos & kMask];
+            const size_t   seq  = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false; // full: the consumer hasn't released this slot yet
+            } else {
+                pos = _head.load(std::memory_order_relaxed);
+            }
+        }
+        Slot &slot = _slots[pos & kMask];
+        fill(slot.value);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Hands every published element to fn(T &) in order, then releases it.
+     *
+     * Stops at the first slot whose producer is still filling it, so a stalled producer delays
+     * (but never reorders) what comes after it.
+     */
+    template <typename F>
+    size_t Drain(F &&fn) {
+        size_t tail  = _tail.load(std::memory_order_relaxed);
+        size_t count = 0;
+        for (;;) {
+            Slot        &slot = _slots[tail & kMask];
+            const size_t seq  = slot.sequence.load(std::memory_order_acquire);
+            if (seq != tail + 1)
+                break;
+            fn(slot.value);
+            slot.sequence.store(tail + Capacity, std::memory_order_release);
+            ++tail;
+            ++count;
+        }
+        _tail.store(tail, std::memory_order_relaxed);
+        return count;
+    }
+
+    /// @brief Approximate element count (claimed slots, including ones still being filled).
+    size_t Size() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_relaxed); }
+
+    static constexpr size_t GetCapacity() { return Capacity; }
+
+private:
+    static constexpr size_t kMask      = Capacity - 1;
+    static constexpr size_t kCacheLine = 64;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T                   value;
+    };
+
+    std::array<Slot, Capacity> _slots;
+
+    alignas(kCacheLine) std::atomic<size_t> _head { 0 }; // next slot to claim (producers)
+    alignas(kCacheLine) std::atomic<size_t> _tail { 0 }; // next slot to drain (written by the consumer)
+};
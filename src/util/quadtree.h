@@ -10,6 +10,8 @@
 
 #include "draw/draw.h"
 
+// Pointer-based quadtree, built by inserting points one at a time. For many moving entities
+// rebuilt every frame, prefer SpatialIndex (util/spatialindex.h).
 class QuadTree {
 public:
     struct qtPoint {
@@ -82,8 +84,9 @@ public:
         }
 
         bool containsPoint(const qtPoint &point) {
-            const double d = pow(point.x - _x, 2) + pow(point.y - _y, 2);
-            return d <= static_cast<double>(_r) * static_cast<double>(_r);
+            const float dx = point.x - _x;
+            const float dy = point.y - _y;
+            return dx * dx + dy * dy <= _r * _r;
         }
 
         bool intersectsAABB(const AABB &range) {
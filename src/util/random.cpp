@@ -0,0 +1,105 @@
+#include "util/random.h"
+
+#include <random>
+#include <utility>
+
+namespace {
+struct ThreadStream {
+    Rng      rng;
+    uint64_t stream     = 0;
+    uint32_t generation = 0;
+    bool     assigned   = false;
+};
+
+thread_local ThreadStream threadStream;
+} // namespace
+
+uint32_t Rng::Below(uint32_t bound) {
+    // Lemire's multiply-shift with rejection: one multiply in the common case, no division
+    // unless the low half lands in the (small) biased zone
+    uint64_t product = static_cast<uint64_t>(Next()) * bound;
+    auto     low     = static_cast<uint32_t>(product);
+    if (low < bound) {
+        const uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = static_cast<uint64_t>(Next()) * bound;
+            low     = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+int Rng::Range(int min, int max) {
+    if (max < min)
+        std::swap(min, max);
+
+    // Span as unsigned so [INT_MIN, INT_MAX] doesn't overflow; the full range is every 32-bit value
+    const uint32_t span = static_cast<uint32_t>(max) - static_cast<uint32_t>(min) + 1u;
+    const uint32_t r    = span == 0 ? Next() : Below(span);
+    return static_cast<int>(static_cast<uint32_t>(min) + r);
+}
+
+void Rng::Fill(float *out, size_t count, float min, float max) {
+    const float scale = (max - min) * 0x1.0p-24f;
+    for (size_t i = 0; i < count; ++i)
+        out[i] = min + static_cast<float>(Next() >> 8) * scale;
+}
+
+void Rng::Fill(uint32_t *out, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        out[i] = Next();
+}
+
+void Rng::Advance(uint64_t delta) {
+    // Brown's LCG jump-ahead: compose the step (x -> a*x + c) with itself by squaring
+    uint64_t accMult = 1, accPlus = 0;
+    uint64_t curMult = MULTIPLIER, curPlus = _increment;
+    while (delta > 0) {
+        if (delta & 1u) {
+            accMult *= curMult;
+            accPlus = accPlus * curMult + curPlus;
+        }
+        curPlus = (curMult + 1) * curPlus;
+        curMult *= curMult;
+        delta >>= 1;
+    }
+    _state = accMult * _state + accPlus;
+}
+
+Random::Random() {
+    std::random_device rd;
+    _setSeed((static_cast<uint64_t>(rd()) << 32) | rd());
+}
+
+void Random::_setSeed(uint64_t seed) {
+    _seed.store(seed, std::memory_order_relaxed);
+    _global.Seed(seed, MAIN_STREAM);
+    _generation.fetch_add(1, std::memory_order_release);
+}
+
+Rng &Random::ThreadLocal() {
+    Random &random = Get();
+
+    ThreadStream &local = threadStream;
+    if (!local.assigned) {
+        local.stream   = THREAD_STREAM_BASE + random._threadCount.fetch_add(1, std::memory_order_relaxed);
+        local.assigned = true;
+    }
+
+    const uint32_t generation = random._generation.load(std::memory_order_acquire);
+    if (local.generation != generation) {
+        local.rng.Seed(random._seed.load(std::memory_order_relaxed), local.stream);
+        local.generation = generation;
+    }
+    return local.rng;
+}
+
+uint64_t Random::_hashName(std::string_view name) {
+    // FNV-1a, folded into the named-stream range
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (const char c : name) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 0x100000001b3ull;
+    }
+    return h & (MAIN_STREAM - 1);
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+// Engine-wide random numbers. Rng is a small PCG32 generator (64-bit state, XSH-RR output): a few
+// cycles per number, 2^63 independent streams per seed, and jump-ahead. Random owns the master
+// seed and hands out generators derived from it:
+//
+//   Random::Range(0, 9)                        main-thread stream (what Helpers::GetRandomValue uses)
+//   Random::Stream("particles")                a system's own stream; reproducible for a given seed
+//   Random::ThreadLocal()                      this thread's stream; for jobs, no locking
+//
+// Random::SetSeed reseeds the main stream and every thread stream (each thread picks the new
+// seed up on its next ThreadLocal call). Streams already handed out keep going; ask for them
+// again after reseeding if they should follow the new seed.
+//
+// Random::Hash / HashFloat are the stateless PCG hash: the same input always gives the same
+// value, for per-index picks that don't need a stream.
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief PCG32 random number generator.
+ *
+ * Cheap to copy and to create; not thread-safe (give each thread its own).
+ */
+class Rng {
+public:
+    static constexpr uint64_t DEFAULT_SEED = 0x853c49e6748fea9bull;
+
+    explicit Rng(uint64_t seed = DEFAULT_SEED, uint64_t stream = 0) { Seed(seed, stream); }
+
+    /// @brief Restarts the generator: the same (seed, stream) always gives the same sequence.
+    void Seed(uint64_t seed, uint64_t stream = 0) {
+        _state     = 0;
+        _increment = (stream << 1) | 1u;
+        Next();
+        _state += seed;
+        Next();
+    }
+
+    /// @brief Next 32 random bits.
+    uint32_t Next() {
+        const uint64_t old = _state;
+        _state             = old * MULTIPLIER + _increment;
+
+        const auto xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        return std::rotr(xorShifted, static_cast<int>(old >> 59));
+    }
+
+    /// @brief Uniform integer in [0, bound); 0 when bound is 0. Unbiased.
+    uint32_t Below(uint32_t bound);
+
+    /// @brief Uniform integer in the inclusive [min, max] range (either order).
+    int Range(int min, int max);
+
+    /// @brief Uniform float in [0, 1), 24 bits of precision.
+    float Float() { return static_cast<float>(Next() >> 8) * 0x1.0p-24f; }
+
+    /// @brief Uniform float in [min, max).
+    float Range(float min, float max) { return min + (max - min) * Float(); }
+
+    /// @brief Uniform double in [0, 1), 53 bits of precision.
+    double Double() {
+        const uint64_t bits = (static_cast<uint64_t>(Next()) << 32) | Next();
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+    }
+
+    /// @brief True with the given probability (0–1).
+    bool Chance(float probability) { return Float() < probability; }
+
+    /// @brief Fills `out` with uniform floats in [min, max): the same values as `count` Range calls.
+    void Fill(float *out, size_t count, float min = 0.0f, float max = 1.0f);
+
+    /// @brief Fills `out` with raw 32-bit values: the same values as `count` Next calls.
+    void Fill(uint32_t *out, size_t count);
+
+    /// @brief Skips `delta` numbers in O(log delta); e.g. to give each worker its own slice of a sequence.
+    void Advance(uint64_t delta);
+
+    bool operator==(const Rng &other) const { return _state == other._state && _increment == other._increment; }
+
+private:
+    static constexpr uint64_t MULTIPLIER = 6364136223846793005ull;
+
+    uint64_t _state     = 0;
+    uint64_t _increment = 1;
+};
+
+/**
+ * @brief Seeded, engine-wide random number service.
+ */
+class Random {
+public:
+    /// @brief Sets the master seed. By default it comes from std::random_device at startup.
+    static void SetSeed(uint64_t seed) { Get()._setSeed(seed); }
+
+    static uint64_t GetSeed() { return Get()._seed.load(std::memory_order_relaxed); }
+
+    /// @brief The main-thread generator behind the shortcuts below.
+    static Rng &Global() { return Get()._global; }
+
+    /**
+     * @brief This thread's generator, seeded from the master seed and a per-thread stream.
+     *
+     * Which stream a thread gets depends on the order threads first ask, so use Stream() where
+     * results have to be reproducible.
+     */
+    static Rng &ThreadLocal();
+
+    /// @brief A new generator for one system, derived from the master seed and the system's name.
+    static Rng Stream(std::string_view name) { return Rng(GetSeed(), _hashName(name)); }
+
+    /// @brief A new generator for one system, derived from the master seed and an id (below 2^61).
+    static Rng Stream(uint64_t id) { return Rng(GetSeed(), id); }
+
+    static uint32_t Next() { return Get()._global.Next(); }
+
+    static int Range(int min, int max) { return Get()._global.Range(min, max); }
+
+    static float Range(float min, float max) { return Get()._global.Range(min, max); }
+
+    static float Float() { return Get()._global.Float(); }
+
+    static bool Chance(float probability) { return Get()._global.Chance(probability); }
+
+    static void Fill(float *out, size_t count, float min = 0.0f, float max = 1.0f) { Get()._global.Fill(out, count, min, max); }
+
+    /// @brief Stateless PCG hash (Jarzynski & Olano) of a 32-bit value.
+    static constexpr uint32_t Hash(uint32_t value) {
+        const uint32_t state = value * 747796405u + 2891336453u;
+        const uint32_t word  = ((state >> ((state >> 28) + 4u)) ^ state) * 277803737u;
+        return (word >> 22) ^ word;
+    }
+
+    /// @brief Hash(value) as a float in [0, 1).
+    static constexpr float HashFloat(uint32_t value) { return static_cast<float>(Hash(value) >> 8) * 0x1.0p-24f; }
+
+private:
+    // Stream ids are 63 bits. Named and numbered streams live below MAIN_STREAM; the main and
+    // thread streams sit above them so Stream(0) or Stream("...") can't alias either.
+    static constexpr uint64_t MAIN_STREAM        = 1ull << 61;
+    static constexpr uint64_t THREAD_STREAM_BASE = 1ull << 62;
+
+    void _setSeed(uint64_t seed);
+
+    static uint64_t _hashName(std::string_view name);
+
+    std::atomic<uint64_t> _seed { 0 };
+    Rng                   _global;
+    std::atomic<uint32_t> _generation { 0 }; ///< bumped by SetSeed; thread streams reseed when it changes
+    std::atomic<uint32_t> _threadCount { 0 };
+
+public:
+    /// @cond INTERNAL
+    Random(const Random &) = delete;
+
+    static Random &Get() {
+        static Random instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    Random();
+};
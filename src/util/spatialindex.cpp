@@ -0,0 +1,260 @@
+#include "util/spatialindex.h"
+
+#include <limits>
+
+#include "util/threadpool.h"
+
+namespace {
+
+constexpr int      RADIX_BITS   = 11;
+constexpr uint32_t RADIX_SIZE   = 1u << RADIX_BITS;
+constexpr size_t   MIN_PER_TASK = 16 * 1024; // below this, fanning out costs more than it saves
+
+// Splits [0, count) into one chunk per worker (or a single inline chunk) and waits for all of them.
+// Returns the number of chunks used; fn(chunk, begin, end).
+template <typename F>
+size_t parallelChunks(ThreadPool *pool, size_t count, F &&fn) {
+    size_t chunks = 1;
+    if (pool && pool->GetThreadCount() > 0)
+        chunks = std::clamp<size_t>(count / MIN_PER_TASK, 1, static_cast<size_t>(pool->GetThreadCount()));
+
+    if (chunks == 1) {
+        fn(size_t(0), size_t(0), count);
+        return 1;
+    }
+
+    const size_t step = (count + chunks - 1) / chunks;
+    for (size_t c = 0; c < chunks; ++c) {
+        const size_t begin = c * step, end = std::min(count, begin + step);
+        pool->Enqueue([&fn, c, begin, end] { fn(c, begin, end); });
+    }
+    pool->WaitAll();
+    return chunks;
+}
+
+uint32_t interleave(uint32_t v) {
+    // Spread the low 16 bits of v to the even bit positions
+    v &= 0xFFFF;
+    v = (v | (v << 8)) & 0x00FF00FF;
+    v = (v | (v << 4)) & 0x0F0F0F0F;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+} // namespace
+
+SpatialIndexBase::SpatialIndexBase(const SpatialIndexSettings &settings)
+    : _settings(settings) {
+    _settings.maxDepth     = std::clamp(_settings.maxDepth, 0, 15);
+    _settings.leafCapacity = std::max(_settings.leafCapacity, 1);
+    _settings.cellSize     = std::max(_settings.cellSize, 1e-3f);
+    _invCellSize           = 1.0f / _settings.cellSize;
+}
+
+void SpatialIndexBase::_rebuild(const float *x, const float *y, const float *radius, size_t count, ThreadPool *pool) {
+    count = std::min<size_t>(count, std::numeric_limits<uint32_t>::max());
+
+    _root      = nullptr;
+    _nodeCount = 0;
+    _arena.Reset();
+
+    _maxRadius = 0.0f;
+    if (radius) {
+        for (size_t i = 0; i < count; ++i)
+            _maxRadius = std::max(_maxRadius, radius[i]);
+    }
+
+    if (_settings.type == SpatialIndexType::UniformGrid) {
+        // About one bucket per entity keeps buckets short without making the table sparse
+        const uint32_t tableSize = std::bit_ceil(static_cast<uint32_t>(std::clamp<size_t>(count, 16, size_t(1) << 22)));
+        _tableMask               = tableSize - 1;
+    }
+
+    _computeKeys(x, y, radius, count, pool);
+    _sortKeys(pool);
+
+    if (_settings.type == SpatialIndexType::UniformGrid)
+        _buildGrid();
+    else if (count > 0)
+        _root = _buildNode(0, static_cast<uint32_t>(count), 0);
+
+    // Copy the entities into their final (cell) order
+    _order.resize(count);
+    _x.resize(count);
+    _y.resize(count);
+    _r.resize(count);
+    parallelChunks(pool, count, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const BuildEntry &entry = _entries[i];
+            _order[i]               = entry.index;
+            _x[i]                   = entry.x;
+            _y[i]                   = entry.y;
+            _r[i]                   = entry.r;
+        }
+    });
+}
+
+void SpatialIndexBase::_computeKeys(const float *x, const float *y, const float *radius, size_t count, ThreadPool *pool) {
+    _entries.resize(count);
+
+    if (_settings.type == SpatialIndexType::UniformGrid) {
+        parallelChunks(pool, count, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                _entries[i] = { _cellHash(_cellCoord(x[i]), _cellCoord(y[i])), static_cast<uint32_t>(i), x[i], y[i], radius ? radius[i] : 0.0f };
+        });
+        return;
+    }
+
+    // Quadtree: Morton code of the deepest-level cell holding the centre
+    const int    maxDepth = _settings.maxDepth;
+    const float  side     = static_cast<float>(1u << maxDepth);
+    const rectf &bounds   = _settings.bounds;
+    const float  scaleX   = bounds.width > 0.0f ? side / bounds.width : 0.0f;
+    const float  scaleY   = bounds.height > 0.0f ? side / bounds.height : 0.0f;
+
+    parallelChunks(pool, count, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float gx = std::clamp((x[i] - bounds.x) * scaleX, 0.0f, side - 1.0f);
+            const float gy = std::clamp((y[i] - bounds.y) * scaleY, 0.0f, side - 1.0f);
+
+            const uint32_t key = interleave(static_cast<uint32_t>(gx)) | (interleave(static_cast<uint32_t>(gy)) << 1);
+            _entries[i]        = { key, static_cast<uint32_t>(i), x[i], y[i], radius ? radius[i] : 0.0f };
+        }
+    });
+}
+
+void SpatialIndexBase::_sortKeys(ThreadPool *pool) {
+    // LSD radix sort (stable) on the key. Each chunk histograms its slice; the prefix sum over
+    // (digit, chunk) gives every chunk a private output range, so the scatter is parallel too.
+    const size_t count = _entries.size();
+    const int    bits  = _settings.type == SpatialIndexType::UniformGrid ? std::bit_width(_tableMask) : 2 * _settings.maxDepth;
+    _scratch.resize(count);
+
+    size_t maxChunks = 1;
+    if (pool && pool->GetThreadCount() > 0)
+        maxChunks = static_cast<size_t>(pool->GetThreadCount());
+    _histograms.resize(maxChunks * RADIX_SIZE);
+
+    for (int shift = 0; shift < bits; shift += RADIX_BITS) {
+        std::fill(_histograms.begin(), _histograms.end(), 0u);
+
+        // Both parallelChunks calls below split [0, count) identically, so chunk c's histogram
+        // row lines up with its scatter range
+        const size_t chunks = parallelChunks(pool, count, [&](size_t chunk, size_t begin, size_t end) {
+            uint32_t *histogram = _histograms.data() + chunk * RADIX_SIZE;
+            for (size_t i = begin; i < end; ++i)
+                ++histogram[(_entries[i].key >> shift) & (RADIX_SIZE - 1)];
+        });
+
+        // All keys share this digit: the pass would be an identity copy
+        bool trivial = false;
+        for (uint32_t digit = 0; digit < RADIX_SIZE && !trivial; ++digit) {
+            uint32_t total = 0;
+            for (size_t c = 0; c < chunks; ++c)
+                total += _histograms[c * RADIX_SIZE + digit];
+            trivial = total == count;
+        }
+        if (trivial)
+            continue;
+
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < RADIX_SIZE; ++digit) {
+            for (size_t c = 0; c < chunks; ++c) {
+                uint32_t &slot = _histograms[c * RADIX_SIZE + digit];
+                const uint32_t n = slot;
+                slot             = offset;
+                offset += n;
+            }
+        }
+
+        parallelChunks(pool, count, [&](size_t chunk, size_t begin, size_t end) {
+            uint32_t *cursor = _histograms.data() + chunk * RADIX_SIZE;
+            for (size_t i = begin; i < end; ++i)
+                _scratch[cursor[(_entries[i].key >> shift) & (RADIX_SIZE - 1)]++] = _entries[i];
+        });
+        _entries.swap(_scratch);
+    }
+}
+
+void SpatialIndexBase::_buildGrid() {
+    // Keys are sorted, so bucket b is the run [_cellStart[b], _cellStart[b + 1])
+    const uint32_t buckets = _tableMask + 1;
+    _cellStart.assign(buckets + 1, 0);
+    for (const BuildEntry &entry : _entries)
+        ++_cellStart[entry.key + 1];
+    for (uint32_t b = 0; b < buckets; ++b)
+        _cellStart[b + 1] += _cellStart[b];
+}
+
+SpatialIndexBase::Node *SpatialIndexBase::_buildNode(uint32_t begin, uint32_t end, int depth) {
+    Node *node = _arena.New<Node>();
+    *node      = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+        std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), begin, end, end, { nullptr, nullptr, nullptr, nullptr } };
+    ++_nodeCount;
+
+    const bool leaf = end - begin <= static_cast<uint32_t>(_settings.leafCapacity) || depth == _settings.maxDepth;
+    if (!leaf) {
+        // Entities too big for the children stay here: a loose child (cell size s, holding
+        // circles up to s/2) can't take a radius above a quarter of this node's cell. A stable
+        // partition keeps the rest in key order so each child's entities stay one contiguous run.
+        const float keepAbove = std::min(_settings.bounds.width, _settings.bounds.height) / static_cast<float>(4u << depth);
+        uint32_t    keep      = 0;
+        if (_maxRadius > keepAbove) {
+            for (uint32_t i = begin; i < end; ++i)
+                keep += _entries[i].r > keepAbove;
+        }
+
+        if (keep > 0) {
+            uint32_t front = begin, back = 0;
+            for (uint32_t i = begin; i < end; ++i) {
+                if (_entries[i].r > keepAbove)
+                    _entries[front++] = _entries[i];
+                else
+                    _scratch[back++] = _entries[i];
+            }
+            std::copy_n(_scratch.begin(), back, _entries.begin() + front);
+        }
+        node->split = begin + keep;
+
+        const int shift  = 2 * (_settings.maxDepth - depth - 1);
+        uint32_t  cursor = node->split;
+        for (uint32_t quadrant = 0; quadrant < 4; ++quadrant) {
+            const auto last = std::partition_point(_entries.begin() + cursor, _entries.begin() + end, [&](const BuildEntry &entry) {
+                return ((entry.key >> shift) & 3u) <= quadrant;
+            });
+            const auto next = static_cast<uint32_t>(last - _entries.begin());
+            if (next > cursor) {
+                Node *child = _buildNode(cursor, next, depth + 1);
+                node->children[quadrant] = child;
+                node->minX               = std::min(node->minX, child->minX);
+                node->minY               = std::min(node->minY, child->minY);
+                node->maxX               = std::max(node->maxX, child->maxX);
+                node->maxY               = std::max(node->maxY, child->maxY);
+            }
+            cursor = next;
+        }
+    }
+
+    for (uint32_t i = begin; i < node->split; ++i) {
+        const BuildEntry &entry = _entries[i];
+        node->minX              = std::min(node->minX, entry.x - entry.r);
+        node->minY              = std::min(node->minY, entry.y - entry.r);
+        node->maxX              = std::max(node->maxX, entry.x + entry.r);
+        node->maxY              = std::max(node->maxY, entry.y + entry.r);
+    }
+    return node;
+}
+
+int SpatialIndexBase::_cellCoord(float v) const {
+    // Clamped so far-away (or non-finite) positions can't overflow the int conversion; floor by
+    // truncating and stepping down for negatives, which beats a libm call in the key loop
+    const float scaled = std::clamp(v * _invCellSize, -1073741824.0f, 1073741824.0f);
+    const int   cell   = static_cast<int>(scaled);
+    return cell - (scaled < static_cast<float>(cell));
+}
+
+uint32_t SpatialIndexBase::_cellHash(int cx, int cy) const {
+    const uint32_t h = static_cast<uint32_t>(cx) * 0x8DA6B343u ^ static_cast<uint32_t>(cy) * 0xD8163841u;
+    return (h ^ (h >> 15)) & _tableMask;
+}
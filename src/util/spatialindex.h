@@ -0,0 +1,324 @@
+#pragma once
+
+// Spatial index for many moving entities: a loose quadtree or a hashed uniform grid behind one
+// API. Instead of inserting entities one at a time, the index is rebuilt wholesale from SoA
+// position arrays (typically once per frame): entities are radix-sorted by cell key and copied
+// into cell order, so every query ends up scanning contiguous runs of x/y/radius with 4-wide
+// SIMD overlap tests. Quadtree nodes live in an Arena that is rewound on rebuild, and all other
+// storage is reused, so a steady-state rebuild does not touch the heap.
+//
+// Entities are circles (radius 0 = point). A query reports each entity whose circle overlaps the
+// query shape exactly once, through a callback or by appending to a vector of typed IDs.
+// Querying a built index from several threads is fine; Rebuild must not overlap queries.
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "math/rectangles.h"
+#include "math/simd.h"
+#include "util/arena.h"
+
+class ThreadPool;
+
+enum class SpatialIndexType : uint8_t {
+    LooseQuadTree, ///< Adapts to clustered entities and mixed sizes; needs world bounds up front.
+    UniformGrid,   ///< Unbounded, cheapest to rebuild; best when entities are similar in size.
+};
+
+struct SpatialIndexSettings {
+    SpatialIndexType type         = SpatialIndexType::UniformGrid;
+    float            cellSize     = 64.0f;                                ///< Grid: cell edge length; ~2x the typical query radius works well.
+    rectf            bounds       = rectf(0.0f, 0.0f, 4096.0f, 4096.0f); ///< Quadtree: world area; entities outside land in the edge cells.
+    int              maxDepth     = 10;                                   ///< Quadtree: deepest level (at most 15).
+    int              leafCapacity = 32;                                   ///< Quadtree: nodes with at most this many entities aren't split.
+};
+
+/// @brief Untyped core of SpatialIndex: storage, rebuild and traversal.
+class SpatialIndexBase {
+public:
+    /// @brief Number of entities in the last Rebuild.
+    size_t GetCount() const { return _x.size(); }
+
+    SpatialIndexType GetType() const { return _settings.type; }
+
+    /// @brief Quadtree nodes, or grid buckets, built by the last Rebuild.
+    size_t GetNodeCount() const { return _settings.type == SpatialIndexType::LooseQuadTree ? _nodeCount : _cellStart.size() - (_cellStart.empty() ? 0 : 1); }
+
+protected:
+    explicit SpatialIndexBase(const SpatialIndexSettings &settings);
+
+    void _rebuild(const float *x, const float *y, const float *radius, size_t count, ThreadPool *pool);
+
+    template <typename Emit>
+    void _queryRect(float minX, float minY, float maxX, float maxY, Emit &&emit) const;
+
+    template <typename Emit>
+    void _queryCircle(float x, float y, float radius, Emit &&emit) const;
+
+    /// Cell order → the caller's entity index.
+    std::vector<uint32_t> _order;
+
+private:
+    struct Node {
+        float    minX, minY, maxX, maxY; ///< Tight bounds of every entity circle in the subtree
+        uint32_t begin;                  ///< Subtree entities are [begin, end) ...
+        uint32_t split;                  ///< ... of which [begin, split) belong to this node itself
+        uint32_t end;
+        Node    *children[4];
+    };
+
+    // Sorted by key. Position and radius ride along so the final copy into cell order is a
+    // sequential read instead of a gather through `index`.
+    struct BuildEntry {
+        uint32_t key;
+        uint32_t index;
+        float    x, y, r;
+    };
+
+    void  _computeKeys(const float *x, const float *y, const float *radius, size_t count, ThreadPool *pool);
+    void  _sortKeys(ThreadPool *pool);
+    void  _buildGrid();
+    Node *_buildNode(uint32_t begin, uint32_t end, int depth);
+
+    int      _cellCoord(float v) const;
+    uint32_t _cellHash(int cx, int cy) const;
+
+    template <typename Emit>
+    void _filterRect(uint32_t begin, uint32_t end, float cx, float cy, float halfW, float halfH, Emit &emit) const;
+
+    template <typename Emit>
+    void _filterCircle(uint32_t begin, uint32_t end, float cx, float cy, float radius, Emit &emit) const;
+
+    template <typename Filter>
+    void _visitCells(float minX, float minY, float maxX, float maxY, Filter &&filter) const;
+
+    SpatialIndexSettings _settings;
+    std::vector<float>   _x, _y, _r; ///< Entity data in cell order
+    float                _maxRadius = 0.0f;
+
+    // Uniform grid: cell (cx, cy) hashes into one of _cellStart.size() - 1 buckets
+    std::vector<uint32_t> _cellStart;
+    uint32_t              _tableMask   = 0;
+    float                 _invCellSize = 0.0f;
+
+    // Loose quadtree
+    Arena  _arena;
+    Node  *_root      = nullptr;
+    size_t _nodeCount = 0;
+
+    // Rebuild scratch, kept between rebuilds
+    std::vector<BuildEntry> _entries, _scratch;
+    std::vector<uint32_t>   _histograms;
+};
+
+/**
+ * @brief Spatial index over circles, reporting hits as typed IDs.
+ *
+ * @tparam Id Entity identifier type reported by queries (an entity handle, index, enum...).
+ */
+template <typename Id = uint32_t>
+class SpatialIndex : public SpatialIndexBase {
+public:
+    explicit SpatialIndex(const SpatialIndexSettings &settings = {})
+        : SpatialIndexBase(settings) { }
+
+    /**
+     * @brief Replaces the contents with `count` entities given as SoA arrays.
+     *
+     * @param radius Per-entity radius, or nullptr for points.
+     * @param ids Per-entity ID, or nullptr to report each entity's array index (as Id).
+     * @param pool Spreads key computation and sorting over the pool's workers; nullptr runs inline.
+     */
+    void Rebuild(const float *x, const float *y, const float *radius, size_t count, const Id *ids = nullptr, ThreadPool *pool = nullptr) {
+        _rebuild(x, y, radius, count, pool);
+        _ids.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            _ids[i] = ids ? ids[_order[i]] : static_cast<Id>(_order[i]);
+    }
+
+    /// @brief Calls `visit(Id)` for every entity overlapping `rect`.
+    template <typename F>
+    void QueryRect(const rectf &rect, F &&visit) const {
+        _queryRect(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height, [&](uint32_t i) { visit(_ids[i]); });
+    }
+
+    /// @brief Calls `visit(Id)` for every entity overlapping the circle.
+    template <typename F>
+    void QueryCircle(float x, float y, float radius, F &&visit) const {
+        _queryCircle(x, y, radius, [&](uint32_t i) { visit(_ids[i]); });
+    }
+
+    /// @brief Appends the IDs overlapping `rect` to `out`; returns how many were added.
+    size_t QueryRect(const rectf &rect, std::vector<Id> &out) const {
+        const size_t before = out.size();
+        QueryRect(rect, [&](const Id &id) { out.push_back(id); });
+        return out.size() - before;
+    }
+
+    /// @brief Appends the IDs overlapping the circle to `out`; returns how many were added.
+    size_t QueryCircle(float x, float y, float radius, std::vector<Id> &out) const {
+        const size_t before = out.size();
+        QueryCircle(x, y, radius, [&](const Id &id) { out.push_back(id); });
+        return out.size() - before;
+    }
+
+private:
+    std::vector<Id> _ids; ///< In cell order
+};
+
+// ── Traversal ────────────────────────────────────────────────────────────────
+
+template <typename Emit>
+void SpatialIndexBase::_filterRect(uint32_t begin, uint32_t end, float cx, float cy, float halfW, float halfH, Emit &emit) const {
+    // Circle/rect overlap: distance from the centre to the rect, per axis, against the radius
+    const float *x = _x.data(), *y = _y.data(), *r = _r.data();
+    const auto   vcx = Simd::Set1(cx), vcy = Simd::Set1(cy), vhw = Simd::Set1(halfW), vhh = Simd::Set1(halfH), zero = Simd::Zero();
+
+    uint32_t i = begin;
+    for (; i + Simd::Width <= end; i += Simd::Width) {
+        const auto dx   = Simd::Max(Simd::Sub(Simd::Abs(Simd::Sub(Simd::Load(x + i), vcx)), vhw), zero);
+        const auto dy   = Simd::Max(Simd::Sub(Simd::Abs(Simd::Sub(Simd::Load(y + i), vcy)), vhh), zero);
+        const auto rr   = Simd::Load(r + i);
+        int        mask = Simd::LessEqualMask(Simd::MulAdd(dx, dx, Simd::Mul(dy, dy)), Simd::Mul(rr, rr));
+        while (mask) {
+            const int lane = std::countr_zero(static_cast<unsigned>(mask));
+            emit(i + lane);
+            mask &= mask - 1;
+        }
+    }
+    for (; i < end; ++i) {
+        const float dx = std::max(std::fabs(x[i] - cx) - halfW, 0.0f);
+        const float dy = std::max(std::fabs(y[i] - cy) - halfH, 0.0f);
+        if (dx * dx + dy * dy <= r[i] * r[i])
+            emit(i);
+    }
+}
+
+template <typename Emit>
+void SpatialIndexBase::_filterCircle(uint32_t begin, uint32_t end, float cx, float cy, float radius, Emit &emit) const {
+    const float *x = _x.data(), *y = _y.data(), *r = _r.data();
+    const auto   vcx = Simd::Set1(cx), vcy = Simd::Set1(cy), vr = Simd::Set1(radius);
+
+    uint32_t i = begin;
+    for (; i + Simd::Width <= end; i += Simd::Width) {
+        const auto dx   = Simd::Sub(Simd::Load(x + i), vcx);
+        const auto dy   = Simd::Sub(Simd::Load(y + i), vcy);
+        const auto rr   = Simd::Add(Simd::Load(r + i), vr);
+        int        mask = Simd::LessEqualMask(Simd::MulAdd(dx, dx, Simd::Mul(dy, dy)), Simd::Mul(rr, rr));
+        while (mask) {
+            const int lane = std::countr_zero(static_cast<unsigned>(mask));
+            emit(i + lane);
+            mask &= mask - 1;
+        }
+    }
+    for (; i < end; ++i) {
+        const float dx = x[i] - cx, dy = y[i] - cy, rr = r[i] + radius;
+        if (dx * dx + dy * dy <= rr * rr)
+            emit(i);
+    }
+}
+
+template <typename Filter>
+void SpatialIndexBase::_visitCells(float minX, float minY, float maxX, float maxY, Filter &&filter) const {
+    const uint32_t total = static_cast<uint32_t>(_x.size());
+    if (total == 0)
+        return;
+
+    // Entities are bucketed by centre, so widen the query by the largest radius
+    const int cx0 = _cellCoord(minX - _maxRadius), cx1 = _cellCoord(maxX + _maxRadius);
+    const int cy0 = _cellCoord(minY - _maxRadius), cy1 = _cellCoord(maxY + _maxRadius);
+
+    const uint64_t cells = uint64_t(int64_t(cx1) - cx0 + 1) * uint64_t(int64_t(cy1) - cy0 + 1);
+    if (cells > _tableMask) {
+        // Covers (at least) every bucket — one pass over everything is cheaper than hashing
+        filter(0u, total);
+        return;
+    }
+
+    // Distinct cells can share a bucket; visit each bucket once so nothing is reported twice
+    uint32_t              local[64];
+    std::vector<uint32_t> spill;
+    uint32_t             *buckets = local;
+    if (cells > 64) {
+        spill.resize(cells);
+        buckets = spill.data();
+    }
+    size_t used = 0;
+    for (int cy = cy0; cy <= cy1; ++cy)
+        for (int cx = cx0; cx <= cx1; ++cx)
+            buckets[used++] = _cellHash(cx, cy);
+    std::sort(buckets, buckets + used);
+    used = std::unique(buckets, buckets + used) - buckets;
+
+    for (size_t b = 0; b < used; ++b) {
+        const uint32_t begin = _cellStart[buckets[b]], end = _cellStart[buckets[b] + 1];
+        if (begin != end)
+            filter(begin, end);
+    }
+}
+
+template <typename Emit>
+void SpatialIndexBase::_queryRect(float minX, float minY, float maxX, float maxY, Emit &&emit) const {
+    const float cx = (minX + maxX) * 0.5f, cy = (minY + maxY) * 0.5f;
+    const float halfW = (maxX - minX) * 0.5f, halfH = (maxY - minY) * 0.5f;
+    auto        filter = [&](uint32_t begin, uint32_t end) { _filterRect(begin, end, cx, cy, halfW, halfH, emit); };
+
+    if (_settings.type == SpatialIndexType::UniformGrid) {
+        _visitCells(minX, minY, maxX, maxY, filter);
+        return;
+    }
+
+    const Node *stack[64];
+    int         top = 0;
+    if (_root)
+        stack[top++] = _root;
+    while (top > 0) {
+        const Node *node = stack[--top];
+        if (node->minX > maxX || node->maxX < minX || node->minY > maxY || node->maxY < minY)
+            continue;
+
+        // Subtree entirely inside the query: every entity in it is a hit, no tests needed
+        if (node->minX >= minX && node->maxX <= maxX && node->minY >= minY && node->maxY <= maxY) {
+            for (uint32_t i = node->begin; i < node->end; ++i)
+                emit(i);
+            continue;
+        }
+
+        filter(node->begin, node->split);
+        for (const Node *child : node->children)
+            if (child)
+                stack[top++] = child;
+    }
+}
+
+template <typename Emit>
+void SpatialIndexBase::_queryCircle(float x, float y, float radius, Emit &&emit) const {
+    auto filter = [&](uint32_t begin, uint32_t end) { _filterCircle(begin, end, x, y, radius, emit); };
+
+    if (_settings.type == SpatialIndexType::UniformGrid) {
+        _visitCells(x - radius, y - radius, x + radius, y + radius, filter);
+        return;
+    }
+
+    const float radiusSq = radius * radius;
+    const Node *stack[64];
+    int         top = 0;
+    if (_root)
+        stack[top++] = _root;
+    while (top > 0) {
+        const Node *node = stack[--top];
+        const float dx   = std::max({ node->minX - x, 0.0f, x - node->maxX });
+        const float dy   = std::max({ node->minY - y, 0.0f, y - node->maxY });
+        if (dx * dx + dy * dy > radiusSq)
+            continue;
+
+        filter(node->begin, node->split);
+        for (const Node *child : node->children)
+            if (child)
+                stack[top++] = child;
+    }
+}
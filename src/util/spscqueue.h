@@ -0,0 +1,78 @@
+#pragma once
+
+// Bounded single-producer/single-consumer ring. Lock-free and wait-free on both ends, so it's
+// safe to drain from a real-time thread (the audio callback) — no allocations, no mutexes.
+// Capacity must be a power of two; one slot is never left empty, all N slots are usable.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+/// @brief Fixed-capacity SPSC queue. Exactly one thread may push and exactly one may pop.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscQueue elements are copied across threads; keep them POD");
+
+public:
+    /// @brief Producer side. Returns false (and drops nothing) if the ring is full.
+    bool Push(const T &value) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _cachedTail == Capacity) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head - _cachedTail == Capacity)
+                return false;
+        }
+        _slots[head & kMask] = value;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Consumer side. Returns false if the ring is empty.
+    bool Pop(T &out) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _cachedHead) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail == _cachedHead)
+                return false;
+        }
+        out = _slots[tail & kMask];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Consumer side. Pops everything currently visible and hands each element to fn.
+    template <typename F>
+    size_t Drain(F &&fn) {
+        size_t count = 0;
+        T      value;
+        while (Pop(value)) {
+            fn(value);
+            ++count;
+        }
+        return count;
+    }
+
+    /// @brief Approximate element count (exact only when neither side is running).
+    size_t Size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    bool Empty() const { return Size() == 0; }
+
+    static constexpr size_t GetCapacity() { return Capacity; }
+
+private:
+    static constexpr size_t kMask      = Capacity - 1;
+    static constexpr size_t kCacheLine = 64;
+
+    std::array<T, Capacity> _slots {};
+
+    // Each index on its own line so the two threads don't false-share. The cached copies let each
+    // side skip the other's (contended) atomic until the ring actually looks full/empty.
+    alignas(kCacheLine) std::atomic<size_t> _head { 0 }; // written by the producer
+    size_t _cachedTail = 0;                              // producer's view of _tail
+    alignas(kCacheLine) std::atomic<size_t> _tail { 0 }; // written by the consumer
+    size_t _cachedHead = 0;                              // consumer's view of _head
+};
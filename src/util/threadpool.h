@@ -3,8 +3,11 @@
 // A small fixed-size worker pool for fan-out/join work (used by the sprite packer).
 // Falls back to inline execution when constructed with zero workers — e.g. Emscripten
 // without -pthread — so Enqueue + WaitAll still make progress instead of deadlocking.
+// The engine's own pools come from Platform::Workers (util/helpers.h), sized by the thread
+// budget; onStart is how they apply affinity/priority hints to each worker.
 
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -31,10 +34,13 @@ class ThreadPool {
 public:
     using Task = std::unique_ptr<TaskBase>;
 
-    ThreadPool(size_t numThreads)
+    /// @param onStart Called on each worker thread, with its index, before it takes any task.
+    ThreadPool(size_t numThreads, std::function<void(size_t)> onStart = {})
         : _tasksRunning(0) {
         for (size_t i = 0; i < numThreads; ++i) {
-            _workers.emplace_back([this] {
+            _workers.emplace_back([this, i, onStart] {
+                if (onStart)
+                    onStart(i);
                 while (true) {
                     Task task;
                     {
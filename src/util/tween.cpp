@@ -0,0 +1,439 @@
+#include "util/tween.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "math/easings.h"
+#include "math/simd.h"
+#include "profiler/profiler.h"
+
+namespace {
+
+using Simd::Float4;
+
+// Batch update for curves with a Simd form. `curve` maps normalized time to eased progress;
+// the last (count % 4) tweens go through a zero-padded lane group so each curve is written once.
+template <typename Curve>
+void advanceVector(const float *start, const float *change, float *time, const float *duration,
+                   const float *invDuration, float *value, size_t count, float dt, Curve curve) {
+    const Float4 step = Simd::Set1(dt);
+    const Float4 one  = Simd::Set1(1.0f);
+
+    auto lanes = [&](const float *b, const float *c, float *t, const float *d, const float *inv, float *v) {
+        const Float4 now = Simd::Min(Simd::Add(Simd::Load(t), step), Simd::Load(d));
+        Simd::Store(t, now);
+        const Float4 u = Simd::Min(Simd::Mul(now, Simd::Load(inv)), one);
+        Simd::Store(v, Simd::MulAdd(Simd::Load(c), curve(u), Simd::Load(b)));
+    };
+
+    size_t i = 0;
+    for (; i + Simd::Width <= count; i += Simd::Width)
+        lanes(start + i, change + i, time + i, duration + i, invDuration + i, value + i);
+
+    if (i < count) {
+        float        b[4] = {}, c[4] = {}, t[4] = {}, d[4] = {}, inv[4] = {}, v[4] = {};
+        const size_t tail = count - i;
+        std::copy_n(start + i, tail, b);
+        std::copy_n(change + i, tail, c);
+        std::copy_n(time + i, tail, t);
+        std::copy_n(duration + i, tail, d);
+        std::copy_n(invDuration + i, tail, inv);
+        lanes(b, c, t, d, inv, v);
+        std::copy_n(t, tail, time + i);
+        std::copy_n(v, tail, value + i);
+    }
+}
+
+// Batch update for the transcendental curves, straight through the easings.h functions
+template <float (*Ease)(float, float, float, float)>
+void advanceScalar(const float *start, const float *change, float *time, const float *duration,
+                   const float *invDuration, float *value, size_t count, float dt) {
+    for (size_t i = 0; i < count; ++i) {
+        const float now = std::min(time[i] + dt, duration[i]);
+        time[i]         = now;
+        value[i]        = start[i] + change[i] * Ease(std::min(now * invDuration[i], 1.0f), 0.0f, 1.0f, 1.0f);
+    }
+}
+
+// Polynomial curves in normalized form. InOut curves are evaluated branch-free as
+// in(min(u, ½)) + out(max(u, ½)) − ½, which matches the piecewise Penner curve because the
+// halves meet at ½.
+const Float4 HALF  = Simd::Set1(0.5f);
+const Float4 ONE   = Simd::Set1(1.0f);
+const Float4 TWO   = Simd::Set1(2.0f);
+const Float4 ZERO  = Simd::Zero();
+constexpr float BACK_S        = 1.70158f;
+constexpr float BACK_S_IN_OUT = 1.70158f * 1.525f;
+
+Float4 circSqrt(Float4 x) { return Simd::Sqrt(Simd::Max(Simd::Sub(ONE, Simd::Mul(x, x)), ZERO)); }
+Float4 lowerHalf(Float4 u) { return Simd::Mul(Simd::Min(u, HALF), TWO); }                 // 2·min(u, ½)
+Float4 upperHalf(Float4 u) { return Simd::Sub(Simd::Mul(Simd::Max(u, HALF), TWO), TWO); } // 2·max(u, ½) − 2
+
+Float4 backPoly(Float4 x, float s, float sign) {
+    // x²·((s + 1)·x ± s)
+    return Simd::Mul(Simd::Mul(x, x), Simd::MulAdd(Simd::Set1(s + 1.0f), x, Simd::Set1(sign * s)));
+}
+
+} // namespace
+
+float Tween::Evaluate(Easing easing, float t) {
+    switch (easing) {
+    case Easing::Linear: return EaseLinearNone(t, 0.0f, 1.0f, 1.0f);
+    case Easing::SineIn: return EaseSineIn(t, 0.0f, 1.0f, 1.0f);
+    case Easing::SineOut: return EaseSineOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::SineInOut: return EaseSineInOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::CircIn: return EaseCircIn(t, 0.0f, 1.0f, 1.0f);
+    case Easing::CircOut: return EaseCircOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::CircInOut: return EaseCircInOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::CubicIn: return EaseCubicIn(t, 0.0f, 1.0f, 1.0f);
+    case Easing::CubicOut: return EaseCubicOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::CubicInOut: return EaseCubicInOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::QuadIn: return EaseQuadIn(t, 0.0f, 1.0f, 1.0f);
+    case Easing::QuadOut: return EaseQuadOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::QuadInOut: return EaseQuadInOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::ExpoIn: return EaseExpoIn(t, 0.0f, 1.0f, 1.0f);
+    case Easing::ExpoOut: return EaseExpoOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::ExpoInOut: return EaseExpoInOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::BackIn: return EaseBackIn(t, 0.0f, 1.0f, 1.0f);
+    case Easing::BackOut: return EaseBackOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::BackInOut: return EaseBackInOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::BounceIn: return EaseBounceIn(t, 0.0f, 1.0f, 1.0f);
+    case Easing::BounceOut: return EaseBounceOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::BounceInOut: return EaseBounceInOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::ElasticIn: return EaseElasticIn(t, 0.0f, 1.0f, 1.0f);
+    case Easing::ElasticOut: return EaseElasticOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::ElasticInOut: return EaseElasticInOut(t, 0.0f, 1.0f, 1.0f);
+    case Easing::Count: break;
+    }
+    return t;
+}
+
+void Tween::_evaluatePool(Easing easing, Pool &pool, float dt) {
+    const size_t n = pool.active;
+    float *const b = pool.start.data(), *const c = pool.change.data(), *const t = pool.time.data();
+    float *const d = pool.duration.data(), *const inv = pool.invDuration.data(), *const v = pool.value.data();
+
+    switch (easing) {
+    case Easing::Linear:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) { return u; });
+        break;
+
+    case Easing::QuadIn:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) { return Simd::Mul(u, u); });
+        break;
+    case Easing::QuadOut:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) { return Simd::Mul(u, Simd::Sub(TWO, u)); });
+        break;
+    case Easing::QuadInOut:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) {
+            const Float4 lo = Simd::Min(u, HALF), rest = Simd::Sub(ONE, Simd::Max(u, HALF));
+            return Simd::Add(Simd::Mul(Simd::Mul(lo, lo), TWO), Simd::Sub(HALF, Simd::Mul(Simd::Mul(rest, rest), TWO)));
+        });
+        break;
+
+    case Easing::CubicIn:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) { return Simd::Mul(Simd::Mul(u, u), u); });
+        break;
+    case Easing::CubicOut:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) {
+            const Float4 x = Simd::Sub(u, ONE);
+            return Simd::MulAdd(Simd::Mul(x, x), x, ONE);
+        });
+        break;
+    case Easing::CubicInOut:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) {
+            const Float4 a = lowerHalf(u), x = upperHalf(u);
+            return Simd::MulAdd(Simd::Add(Simd::Mul(Simd::Mul(a, a), a), Simd::Mul(Simd::Mul(x, x), x)), HALF, HALF);
+        });
+        break;
+
+    case Easing::CircIn:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) { return Simd::Sub(ONE, circSqrt(u)); });
+        break;
+    case Easing::CircOut:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) { return circSqrt(Simd::Sub(u, ONE)); });
+        break;
+    case Easing::CircInOut:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) {
+            return Simd::MulAdd(Simd::Sub(circSqrt(upperHalf(u)), circSqrt(lowerHalf(u))), HALF, HALF);
+        });
+        break;
+
+    case Easing::BackIn:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) { return backPoly(u, BACK_S, -1.0f); });
+        break;
+    case Easing::BackOut:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) { return Simd::Add(backPoly(Simd::Sub(u, ONE), BACK_S, 1.0f), ONE); });
+        break;
+    case Easing::BackInOut:
+        advanceVector(b, c, t, d, inv, v, n, dt, [](Float4 u) {
+            const Float4 sum = Simd::Add(backPoly(lowerHalf(u), BACK_S_IN_OUT, -1.0f), backPoly(upperHalf(u), BACK_S_IN_OUT, 1.0f));
+            return Simd::MulAdd(sum, HALF, HALF);
+        });
+        break;
+
+    case Easing::SineIn: advanceScalar<EaseSineIn>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::SineOut: advanceScalar<EaseSineOut>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::SineInOut: advanceScalar<EaseSineInOut>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::ExpoIn: advanceScalar<EaseExpoIn>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::ExpoOut: advanceScalar<EaseExpoOut>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::ExpoInOut: advanceScalar<EaseExpoInOut>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::BounceIn: advanceScalar<EaseBounceIn>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::BounceOut: advanceScalar<EaseBounceOut>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::BounceInOut: advanceScalar<EaseBounceInOut>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::ElasticIn: advanceScalar<EaseElasticIn>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::ElasticOut: advanceScalar<EaseElasticOut>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::ElasticInOut: advanceScalar<EaseElasticInOut>(b, c, t, d, inv, v, n, dt); break;
+    case Easing::Count: break;
+    }
+}
+
+void Tween::_update(float dt) {
+    LUMI_ZONE("Tween::Update");
+    _completed.clear();
+
+    for (size_t e = 0; e < static_cast<size_t>(Easing::Count); ++e) {
+        Pool &pool = _pools[e];
+        if (pool.active == 0)
+            continue;
+
+        _evaluatePool(static_cast<Easing>(e), pool, dt);
+
+        // Retire finished tweens out of the running prefix; walking backwards keeps the swaps local
+        for (size_t i = pool.active; i-- > 0;) {
+            if (pool.time[i] < pool.duration[i])
+                continue;
+
+            const uint32_t slotIndex = pool.slot[i];
+            Slot          &slot      = _slots[slotIndex];
+            pool.value[i]            = pool.start[i] + pool.change[i];
+            slot.state               = State::Finished;
+            _completed.push_back({ { slotIndex, slot.generation }, slot.tag, pool.value[i] });
+            _deactivate(slot);
+        }
+    }
+}
+
+TweenHandle Tween::_start(float from, float to, float duration, Easing easing, uint32_t tag) {
+    if (easing >= Easing::Count)
+        easing = Easing::Linear;
+
+    uint32_t slotIndex;
+    if (!_freeSlots.empty()) {
+        slotIndex = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        slotIndex = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    Slot &slot = _slots[slotIndex];
+    if (++slot.generation == 0)
+        slot.generation = 1;
+    slot.tag    = tag;
+    slot.easing = easing;
+    slot.state  = State::Running;
+
+    _insert(slot, slotIndex, from, to - from, 0.0f, std::max(duration, 0.0f), from);
+    _activate(slot);
+    ++_liveCount;
+
+    return { slotIndex, slot.generation };
+}
+
+void Tween::_stop(TweenHandle handle) {
+    Slot *slot = _resolve(handle);
+    if (!slot)
+        return;
+
+    _remove(*slot);
+    slot->state = State::Free;
+    _freeSlots.push_back(handle.index);
+    --_liveCount;
+}
+
+void Tween::_restart(TweenHandle handle) {
+    Slot *slot = _resolve(handle);
+    if (!slot)
+        return;
+
+    Pool &pool             = _pools[static_cast<size_t>(slot->easing)];
+    pool.time[slot->index] = 0.0f;
+    pool.value[slot->index] = pool.start[slot->index];
+    slot->state            = State::Running;
+    _activate(*slot);
+}
+
+void Tween::_setPaused(TweenHandle handle, bool paused) {
+    Slot *slot = _resolve(handle);
+    if (!slot)
+        return;
+
+    if (paused && slot->state == State::Running) {
+        slot->state = State::Paused;
+        _deactivate(*slot);
+    } else if (!paused && slot->state == State::Paused) {
+        slot->state = State::Running;
+        _activate(*slot);
+    }
+}
+
+void Tween::_seek(TweenHandle handle, float time) {
+    Slot *slot = _resolve(handle);
+    if (!slot)
+        return;
+
+    Pool        &pool = _pools[static_cast<size_t>(slot->easing)];
+    const size_t i    = slot->index;
+    const float  now  = std::clamp(time, 0.0f, pool.duration[i]);
+    pool.time[i]      = now;
+    if (now >= pool.duration[i]) {
+        pool.value[i] = pool.start[i] + pool.change[i];
+        if (slot->state == State::Running) {
+            slot->state = State::Finished;
+            _deactivate(*slot);
+        }
+        return;
+    }
+
+    pool.value[i] = pool.start[i] + pool.change[i] * Evaluate(slot->easing, now * pool.invDuration[i]);
+    if (slot->state == State::Finished) {
+        slot->state = State::Running;
+        _activate(*slot);
+    }
+}
+
+void Tween::_setEasing(TweenHandle handle, Easing easing) {
+    Slot *slot = _resolve(handle);
+    if (!slot || easing >= Easing::Count || easing == slot->easing)
+        return;
+
+    const Pool  &from   = _pools[static_cast<size_t>(slot->easing)];
+    const size_t i      = slot->index;
+    const float  start  = from.start[i];
+    const float  change = from.change[i];
+    const float  time   = from.time[i];
+    const float  length = from.duration[i];
+    const float  value  = slot->state == State::Finished ? from.value[i] : start + change * Evaluate(easing, length > 0.0f ? time / length : 0.0f);
+
+    _remove(*slot);
+    slot->easing = easing;
+    _insert(*slot, handle.index, start, change, time, length, value);
+    if (slot->state == State::Running)
+        _activate(*slot);
+}
+
+float Tween::_getValue(TweenHandle handle) {
+    Slot *slot = _resolve(handle);
+    return slot ? _pools[static_cast<size_t>(slot->easing)].value[slot->index] : 0.0f;
+}
+
+float Tween::_getProgress(TweenHandle handle) {
+    Slot *slot = _resolve(handle);
+    if (!slot)
+        return 0.0f;
+    if (slot->state == State::Finished)
+        return 1.0f;
+
+    const Pool &pool = _pools[static_cast<size_t>(slot->easing)];
+    return std::min(pool.time[slot->index] * pool.invDuration[slot->index], 1.0f);
+}
+
+float Tween::_getTime(TweenHandle handle) {
+    Slot *slot = _resolve(handle);
+    return slot ? _pools[static_cast<size_t>(slot->easing)].time[slot->index] : 0.0f;
+}
+
+bool Tween::_isFinished(TweenHandle handle) {
+    Slot *slot = _resolve(handle);
+    return !slot || slot->state == State::Finished;
+}
+
+bool Tween::_isPaused(TweenHandle handle) {
+    Slot *slot = _resolve(handle);
+    return slot && slot->state == State::Paused;
+}
+
+void Tween::_clear() {
+    for (auto &pool : _pools)
+        pool = Pool {};
+
+    _freeSlots.clear();
+    for (uint32_t i = static_cast<uint32_t>(_slots.size()); i-- > 0;) {
+        _slots[i].state = State::Free;
+        _freeSlots.push_back(i);
+    }
+    _completed.clear();
+    _liveCount = 0;
+}
+
+size_t Tween::_getActiveCount() const {
+    size_t count = 0;
+    for (const auto &pool : _pools)
+        count += pool.active;
+    return count;
+}
+
+Tween::Slot *Tween::_resolve(TweenHandle handle) {
+    if (handle.index >= _slots.size())
+        return nullptr;
+
+    Slot &slot = _slots[handle.index];
+    if (slot.state == State::Free || slot.generation != handle.generation)
+        return nullptr;
+    return &slot;
+}
+
+void Tween::_swap(Pool &pool, size_t a, size_t b) {
+    if (a == b)
+        return;
+
+    std::swap(pool.start[a], pool.start[b]);
+    std::swap(pool.change[a], pool.change[b]);
+    std::swap(pool.time[a], pool.time[b]);
+    std::swap(pool.duration[a], pool.duration[b]);
+    std::swap(pool.invDuration[a], pool.invDuration[b]);
+    std::swap(pool.value[a], pool.value[b]);
+    std::swap(pool.slot[a], pool.slot[b]);
+    _slots[pool.slot[a]].index = static_cast<uint32_t>(a);
+    _slots[pool.slot[b]].index = static_cast<uint32_t>(b);
+}
+
+void Tween::_activate(Slot &slot) {
+    Pool &pool = _pools[static_cast<size_t>(slot.easing)];
+    if (slot.index >= pool.active)
+        _swap(pool, slot.index, pool.active++);
+}
+
+void Tween::_deactivate(Slot &slot) {
+    Pool &pool = _pools[static_cast<size_t>(slot.easing)];
+    if (slot.index < pool.active)
+        _swap(pool, slot.index, --pool.active);
+}
+
+void Tween::_remove(Slot &slot) {
+    _deactivate(slot);
+
+    Pool &pool = _pools[static_cast<size_t>(slot.easing)];
+    _swap(pool, slot.index, pool.Size() - 1);
+    pool.start.pop_back();
+    pool.change.pop_back();
+    pool.time.pop_back();
+    pool.duration.pop_back();
+    pool.invDuration.pop_back();
+    pool.value.pop_back();
+    pool.slot.pop_back();
+}
+
+void Tween::_insert(Slot &slot, uint32_t slotIndex, float start, float change, float time, float duration, float value) {
+    // Lands in the idle region; callers _activate() running tweens
+    Pool &pool = _pools[static_cast<size_t>(slot.easing)];
+    slot.index = static_cast<uint32_t>(pool.Size());
+    pool.start.push_back(start);
+    pool.change.push_back(change);
+    pool.time.push_back(time);
+    pool.duration.push_back(duration);
+    pool.invDuration.push_back(duration > 0.0f ? 1.0f / duration : 0.0f);
+    pool.value.push_back(value);
+    pool.slot.push_back(slotIndex);
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+// Pooled tween engine. Tweens are plain floats stored structure-of-arrays in one pool per easing
+// curve, so the per-frame update is a tight batch loop (SIMD for the polynomial curves) instead
+// of a walk over heap-allocated animators. Callers hold a small generational TweenHandle; a
+// stale handle (tween stopped, slot reused) is detected and reads as dead.
+//
+// Completion is reported through GetCompleted(): the list of tweens that finished during the
+// last Update(). Window advances the pool once per frame before input is handled, so the list
+// is readable for the whole frame. Not thread-safe — main thread only.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Easing curves; the same set (and results) as the functions in math/easings.h.
+enum class Easing : uint8_t {
+    Linear,
+    SineIn,
+    SineOut,
+    SineInOut,
+    CircIn,
+    CircOut,
+    CircInOut,
+    CubicIn,
+    CubicOut,
+    CubicInOut,
+    QuadIn,
+    QuadOut,
+    QuadInOut,
+    ExpoIn,
+    ExpoOut,
+    ExpoInOut,
+    BackIn,
+    BackOut,
+    BackInOut,
+    BounceIn,
+    BounceOut,
+    BounceInOut,
+    ElasticIn,
+    ElasticOut,
+    ElasticInOut,
+    Count
+};
+
+/// @brief Reference to a tween in the pool. Default-constructed handles are invalid.
+struct TweenHandle {
+    uint32_t index      = 0;
+    uint32_t generation = 0; ///< 0 = never issued
+
+    bool IsValid() const { return generation != 0; }
+    bool operator==(const TweenHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const TweenHandle &other) const { return !(*this == other); }
+};
+
+/// @brief One entry of Tween::GetCompleted().
+struct TweenEvent {
+    TweenHandle handle;
+    uint32_t    tag;   ///< The tag passed to Tween::Start
+    float       value; ///< Final value (the `to` of the tween)
+};
+
+/**
+ * @brief Handle-based, pooled tweening of float values.
+ */
+class Tween {
+public:
+    /**
+     * @brief Starts a tween from `from` to `to` over `duration` seconds.
+     *
+     * The tween holds its end value once finished, until Stop() releases it.
+     *
+     * @param tag Free-form value echoed back in the completion event.
+     */
+    static TweenHandle Start(float from, float to, float duration, Easing easing = Easing::Linear, uint32_t tag = 0) {
+        return Get()._start(from, to, duration, easing, tag);
+    }
+
+    /// @brief Releases the tween; the handle (and any copy of it) becomes dead.
+    static void Stop(TweenHandle handle) { Get()._stop(handle); }
+
+    /// @brief Rewinds to the start value and runs again (also resumes a paused tween).
+    static void Restart(TweenHandle handle) { Get()._restart(handle); }
+
+    /// @brief Freezes the tween at its current value until Resume().
+    static void Pause(TweenHandle handle) { Get()._setPaused(handle, true); }
+
+    static void Resume(TweenHandle handle) { Get()._setPaused(handle, false); }
+
+    /**
+     * @brief Jumps to `time` seconds in (clamped to the duration), keeping a paused tween paused.
+     *
+     * Seeking a finished tween back runs it again; seeking to the end finishes it without a
+     * completion event.
+     */
+    static void Seek(TweenHandle handle, float time) { Get()._seek(handle, time); }
+
+    /// @brief Switches the curve of a running tween; progress is kept.
+    static void SetEasing(TweenHandle handle, Easing easing) { Get()._setEasing(handle, easing); }
+
+    /// @brief Current value, or 0 for a dead handle.
+    static float GetValue(TweenHandle handle) { return Get()._getValue(handle); }
+
+    /// @brief Normalized progress in [0, 1], or 0 for a dead handle.
+    static float GetProgress(TweenHandle handle) { return Get()._getProgress(handle); }
+
+    /// @brief Seconds played so far (at most the duration), or 0 for a dead handle.
+    static float GetTime(TweenHandle handle) { return Get()._getTime(handle); }
+
+    /// @brief True once the tween reached its end (and for dead handles).
+    static bool IsFinished(TweenHandle handle) { return Get()._isFinished(handle); }
+
+    /// @brief True while the tween is paused.
+    static bool IsPaused(TweenHandle handle) { return Get()._isPaused(handle); }
+
+    /// @brief True while the handle refers to a live tween.
+    static bool IsAlive(TweenHandle handle) { return Get()._resolve(handle) != nullptr; }
+
+    /// @brief Tweens that finished during the last Update(). Valid until the next Update().
+    static const std::vector<TweenEvent> &GetCompleted() { return Get()._completed; }
+
+    /// @brief Advances every running tween by `dt` seconds. Called by Window each frame.
+    static void Update(float dt) { Get()._update(dt); }
+
+    /// @brief Stops every tween; all handles become dead.
+    static void Clear() { Get()._clear(); }
+
+    /// @brief Number of live tweens (running, paused or finished-and-held).
+    static size_t GetCount() { return Get()._liveCount; }
+
+    /// @brief Number of tweens that will advance on the next Update().
+    static size_t GetActiveCount() { return Get()._getActiveCount(); }
+
+    /// @brief Evaluates a curve at normalized time `t` in [0, 1] (0 → 0, 1 → 1).
+    static float Evaluate(Easing easing, float t);
+
+private:
+    enum class State : uint8_t { Free, Running, Paused, Finished };
+
+    // Per-slot bookkeeping: where the tween's data lives and whether the handle is current
+    struct Slot {
+        uint32_t generation = 0;
+        uint32_t index      = 0; ///< Position in its pool
+        uint32_t tag        = 0;
+        Easing   easing     = Easing::Linear;
+        State    state      = State::Free;
+    };
+
+    // SoA storage for one curve. Entries [0, active) are running, [active, size) are paused or
+    // finished, so the batch update only ever walks a dense prefix.
+    struct Pool {
+        std::vector<float>    start;
+        std::vector<float>    change;
+        std::vector<float>    time;
+        std::vector<float>    duration;
+        std::vector<float>    invDuration;
+        std::vector<float>    value;
+        std::vector<uint32_t> slot;
+        size_t                active = 0;
+
+        size_t Size() const { return slot.size(); }
+    };
+
+    TweenHandle _start(float from, float to, float duration, Easing easing, uint32_t tag);
+    void        _stop(TweenHandle handle);
+    void        _restart(TweenHandle handle);
+    void        _setPaused(TweenHandle handle, bool paused);
+    void        _seek(TweenHandle handle, float time);
+    void        _setEasing(TweenHandle handle, Easing easing);
+    float       _getValue(TweenHandle handle);
+    float       _getProgress(TweenHandle handle);
+    float       _getTime(TweenHandle handle);
+    bool        _isFinished(TweenHandle handle);
+    bool        _isPaused(TweenHandle handle);
+    void        _update(float dt);
+    void        _clear();
+    size_t      _getActiveCount() const;
+
+    Slot *_resolve(TweenHandle handle);
+    void  _swap(Pool &pool, size_t a, size_t b);
+    void  _activate(Slot &slot);
+    void  _deactivate(Slot &slot);
+    void  _remove(Slot &slot);
+    void  _insert(Slot &slot, uint32_t slotIndex, float start, float change, float time, float duration, float value);
+
+    static void _evaluatePool(Easing easing, Pool &pool, float dt);
+
+    std::vector<Slot>       _slots;
+    std::vector<uint32_t>   _freeSlots;
+    Pool                    _pools[static_cast<size_t>(Easing::Count)];
+    std::vector<TweenEvent> _completed;
+    size_t                  _liveCount = 0;
+
+public:
+    /// @cond INTERNAL
+    Tween(const Tween &) = delete;
+
+    static Tween &Get() {
+        static Tween instance;
+        return instance;
+    }
+    /// @endcond
+
+private:
+    Tween() { }
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+// Counts every heap allocation in the process: replaces the global operator new/delete (all
+// twelve forms) and bumps `allocations` on each new. For the "no allocation once warm" checks.
+// The replacements are ordinary definitions, so include this from the test's one .cpp only.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/// @cond INTERNAL
+inline std::atomic<uint64_t> allocations { 0 };
+
+inline void *countedAlloc(size_t size, size_t alignment) {
+    ++allocations;
+    void *p = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                                                    : std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+/// @endcond
+
+void *operator new(size_t size) { return countedAlloc(size, 0); }
+void *operator new[](size_t size) { return countedAlloc(size, 0); }
+void *operator new(size_t size, std::align_val_t al) { return countedAlloc(size, static_cast<size_t>(al)); }
+void *operator new[](size_t size, std::align_val_t al) { return countedAlloc(size, static_cast<size_t>(al)); }
+void  operator delete(void *p) noexcept { std::free(p); }
+void  operator delete[](void *p) noexcept { std::free(p); }
+void  operator delete(void *p, size_t) noexcept { std::free(p); }
+void  operator delete[](void *p, size_t) noexcept { std::free(p); }
+void  operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void  operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void  operator delete(void *p, size_t, std::align_val_t) noexcept { std::free(p); }
+void  operator delete[](void *p, size_t, std::align_val_t) noexcept { std::free(p); }
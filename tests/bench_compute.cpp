@@ -0,0 +1,65 @@
+// Cost of recording and executing a frame of 10k compute dispatches against a fake IGpu, so it
+// measures Compute's own bookkeeping. Not a CTest test: run it by hand (Release build, quiet
+// machine); it prints the best of 30 frames.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "renderer/compute.h"
+
+#include "fakegpu.h"
+
+namespace {
+constexpr uint32_t DISPATCHES = 10000;
+constexpr int      FRAMES     = 30;
+
+struct Params {
+    float    dt;
+    uint32_t count;
+    float    pad[6];
+};
+
+void record() {
+    ComputePipelineAsset pipeline;
+    pipeline.pipeline     = 7;
+    pipeline.threadCountX = 64;
+    pipeline.threadCountY = pipeline.threadCountZ = 1;
+    for (uint32_t i = 0; i < DISPATCHES; ++i) {
+        Compute::SetPipeline(pipeline);
+        Compute::BindReadBuffer(0, 11);
+        Compute::BindReadBuffer(1, 12);
+        Compute::BindReadWriteBuffer(1, 22);
+        Compute::BindReadWriteBuffer(0, 21);
+        Compute::BindReadWriteTexture(0, 31, 1, 0);
+        Compute::PushUniform(0, Params { 0.016f, i, {} });
+        Compute::PushUniform(1, i);
+        Compute::DispatchAuto(1000 + i);
+    }
+}
+
+double milliseconds(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+} // namespace
+
+int main() {
+    FakeGpu gpu;
+    double  bestRecord = 1e9, bestExecute = 1e9, bestReset = 1e9;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        const auto start = std::chrono::steady_clock::now();
+        record();
+        const auto recorded = std::chrono::steady_clock::now();
+        Compute::ExecuteQueued(gpu, 1);
+        const auto executed = std::chrono::steady_clock::now();
+        Compute::Reset();
+        const auto reset = std::chrono::steady_clock::now();
+        bestRecord       = std::min(bestRecord, milliseconds(start, recorded));
+        bestExecute      = std::min(bestExecute, milliseconds(recorded, executed));
+        bestReset        = std::min(bestReset, milliseconds(executed, reset));
+    }
+    std::printf("%u dispatches: record %.3f ms, execute %.3f ms, reset %.3f ms (checksum %016llx)\n", DISPATCHES, bestRecord, bestExecute,
+        bestReset, static_cast<unsigned long long>(gpu.checksum));
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Throughput of each Dsp effect in frames per second: stereo, 512-frame blocks, the way the
+// mixer hands them to a channel insert. Not a CTest test: run it by hand (Release build, quiet
+// machine). One core at 48 kHz needs 0.048 Mframes/s per effect instance.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "platform/audio/dsp.h"
+#include "util/random.h"
+
+namespace {
+constexpr uint32_t CHANNELS = 2, BLOCK = 512, BLOCKS = 4000;
+
+std::vector<float> noise(size_t count) {
+    Rng                rng(1);
+    std::vector<float> out(count);
+    rng.Fill(out.data(), out.size(), -1.0f, 1.0f);
+    return out;
+}
+
+void bench(const char *name, Dsp::Effect &effect) {
+    std::vector<float> block = noise(BLOCK * CHANNELS);
+    effect.Process(block.data(), BLOCK, CHANNELS); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BLOCKS; ++i)
+        effect.Process(block.data(), BLOCK, CHANNELS);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-36s %8.2f Mframes/s\n", name, BLOCKS * BLOCK / seconds / 1e6);
+}
+} // namespace
+
+int main() {
+    Dsp::Biquad biquad(Dsp::BiquadType::Peak, 1000.0f, 1.0f, 6.0f);
+    bench("Biquad", biquad);
+
+    Dsp::Biquad      bands[5] = { Dsp::Biquad(Dsp::BiquadType::LowShelf, 100.0f, 0.7f, 3.0f), Dsp::Biquad(Dsp::BiquadType::Peak, 400.0f),
+             Dsp::Biquad(Dsp::BiquadType::Peak, 1500.0f), Dsp::Biquad(Dsp::BiquadType::Peak, 5000.0f),
+             Dsp::Biquad(Dsp::BiquadType::HighShelf, 10000.0f, 0.7f, -3.0f) };
+    Dsp::EffectChain eq;
+    for (Dsp::Biquad &band : bands)
+        eq.Add(band);
+    bench("EffectChain (5-band EQ)", eq);
+
+    Dsp::Compressor compressor;
+    bench("Compressor", compressor);
+    Dsp::Limiter limiter;
+    bench("Limiter", limiter);
+
+    const std::vector<float> ir = noise(48000 * CHANNELS);
+    Dsp::ConvolutionReverb   reverb(256);
+    reverb.SetImpulseResponse(ir.data(), 48000, CHANNELS);
+    bench("ConvolutionReverb (1 s IR, B=256)", reverb);
+
+    Dsp::Delay delay;
+    bench("Delay", delay);
+    Dsp::Bitcrusher crusher(6.0f, 2);
+    bench("Bitcrusher", crusher);
+
+    struct Source {
+        static void Generate(float *out, uint32_t frames, uint32_t channels, void *) {
+            for (uint32_t i = 0; i < frames * channels; ++i)
+                out[i] = 0.5f;
+        }
+    };
+    Dsp::Resampler     resampler(&Source::Generate, nullptr, CHANNELS, 44100.0f);
+    std::vector<float> out(BLOCK * CHANNELS);
+    const auto         start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BLOCKS; ++i)
+        resampler.Process(out.data(), BLOCK, CHANNELS);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-36s %8.2f Mframes/s\n", "Resampler (44.1 -> 48 kHz)", BLOCKS * BLOCK / seconds / 1e6);
+    return 0;
+}
@@ -0,0 +1,54 @@
+// Events per second through EventBus, one subscriber: the named path (string key, EventData map
+// built per event), typed Emit, and typed Enqueue + Flush at 5000 events per frame. Not a CTest
+// test: run it by hand (Release build, quiet machine).
+
+#include <chrono>
+#include <cstdio>
+
+#include "core/eventbus/eventbus.h"
+
+namespace {
+constexpr int EVENTS    = 2'000'000;
+constexpr int PER_FRAME = 5000;
+
+struct Damage {
+    int   target;
+    float amount;
+};
+
+volatile float sink = 0.0f;
+
+template <typename F>
+void bench(const char *name, F &&run) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-34s %8.2f M events/s\n", name, EVENTS / seconds / 1e6);
+}
+} // namespace
+
+int main() {
+    EventBus::Register("damage", [](EventData data) { sink = sink + std::get<float>(data["amount"]); });
+    EventBus::Subscribe<Damage>([](const Damage &e) { sink = sink + e.amount; });
+
+    bench("named Fire (EventData)", [] {
+        for (int i = 0; i < EVENTS; ++i) {
+            EventData data;
+            data.emplace("target", i);
+            data.emplace("amount", 1.0f);
+            EventBus::Fire("damage", data);
+        }
+    });
+    bench("typed Emit", [] {
+        for (int i = 0; i < EVENTS; ++i)
+            EventBus::Emit(Damage { i, 1.0f });
+    });
+    bench("typed Enqueue + Flush (5000/frame)", [] {
+        for (int frame = 0; frame < EVENTS / PER_FRAME; ++frame) {
+            for (int i = 0; i < PER_FRAME; ++i)
+                EventBus::Enqueue(Damage { i, 1.0f });
+            EventBus::Flush();
+        }
+    });
+    return 0;
+}
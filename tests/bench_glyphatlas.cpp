@@ -0,0 +1,87 @@
+// Glyph atlas throughput without msdfgen: 4000 CJK codepoints requested at once and packed, with
+// a synthetic rasterizer that either costs nothing (the atlas's own scheduling and packing) or
+// burns a fixed amount of CPU per glyph (standing in for msdfgen), inline and on worker pools.
+// Then the main-thread cost of Update per frame while glyphs stream in, 4 new ones a frame; the
+// worst frame is a page doubling. msdfgen's own per-glyph cost isn't measured here. Not a CTest
+// test: run it by hand (Release build, quiet machine).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include "assets/font/glyphatlas.h"
+#include "util/threadpool.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t GLYPHS = 4000;
+
+std::atomic<double> sink;
+int                 work = 0; // square roots per glyph
+
+bool rasterize(uint32_t codepoint, GlyphBitmap &out) {
+    out.metrics.codepoint = codepoint;
+    out.metrics.advance   = 0.5;
+    out.width             = 20 + static_cast<int>(codepoint * 7 % 40);
+    out.height            = 30 + static_cast<int>(codepoint * 13 % 45);
+    out.metrics.ar        = out.width - 0.5;
+    out.metrics.at        = out.height - 0.5;
+    out.rgba.assign(static_cast<size_t>(out.width) * out.height * 4, static_cast<uint8_t>(codepoint));
+
+    double sum = 0.0;
+    for (int i = 0; i < work; ++i)
+        sum += std::sqrt(static_cast<double>(i));
+    sink.store(sum, std::memory_order_relaxed);
+    return true;
+}
+} // namespace
+
+int main() {
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%u hardware threads\n", threads);
+
+    for (const int perGlyph : { 0, 20000 }) {
+        work = perGlyph;
+        for (const unsigned workers : { 0u, 1u, threads }) {
+            ThreadPool              pool(workers);
+            GlyphAtlas              atlas(rasterize, pool, 1);
+            const Clock::time_point start = Clock::now();
+            for (uint32_t codepoint = 0x4E00; codepoint < 0x4E00 + GLYPHS; ++codepoint)
+                atlas.Request(codepoint);
+            atlas.Finish();
+            const double            seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            const GlyphAtlas::Stats stats   = atlas.GetStats();
+            std::printf("%5d sqrt/glyph, %2u workers: %8.0f glyphs/s  (%u pages, %.1f MB)\n", perGlyph, workers, GLYPHS / seconds, stats.pages,
+                stats.bytes / 1048576.0);
+        }
+    }
+
+    work = 0;
+    ThreadPool pool(threads);
+    GlyphAtlas atlas(rasterize, pool, 1);
+    double     total = 0.0, worst = 0.0;
+    int        frames = 0;
+    for (uint32_t codepoint = 0x4E00; codepoint < 0x4E00 + 2000; codepoint += 4) {
+        for (uint32_t k = 0; k < 4; ++k)
+            atlas.Request(codepoint + k);
+        std::this_thread::sleep_for(std::chrono::microseconds(200)); // the rest of the frame
+        const Clock::time_point start = Clock::now();
+        atlas.Update();
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        for (GlyphAtlas::Page &page : atlas.Pages()) { // what AssetHandler does after uploading
+            page.resized = false;
+            page.dirtyX0 = page.dirtyX1 = 0;
+        }
+        total += us;
+        worst = std::max(worst, us);
+        ++frames;
+    }
+    atlas.Finish();
+    std::printf("Update: %.1f us mean, %.1f us worst per frame (4 glyphs a frame)\n", total / frames, worst);
+    return 0;
+}
@@ -0,0 +1,56 @@
+// Cache-key hashing before and after: SHA256 (picosha2, the old font cache key, hex digest over a
+// std::string copy as it was called) against ContentHash (XXH3-128) at 2 KB, the 119 KB embedded
+// default font and a 20 MB CJK-sized font; then what a warm load pays instead when the FileStamp
+// matches. Not a CTest test: run it by hand (Release build, quiet machine).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "picosha2.h"
+#include "util/hash.h"
+#include "util/random.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+volatile char sink;
+
+template <typename F>
+void measure(const char *name, size_t size, int repeats, F &&hash) {
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < repeats; ++i)
+        hash();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count() / repeats;
+    std::printf("  %-8s %9zu B: %10.4f ms  %8.2f GB/s\n", name, size, seconds * 1e3, size / seconds / 1e9);
+}
+} // namespace
+
+int main() {
+    Rng                  rng(47);
+    std::vector<uint8_t> data(20 << 20);
+    for (uint8_t &byte : data)
+        byte = static_cast<uint8_t>(rng.Next());
+
+    for (const size_t size : { size_t(2048), size_t(119380), data.size() }) {
+        const int repeats = size > 1'000'000 ? 3 : 200;
+        measure("sha256", size, repeats, [&] {
+            const std::string copy(reinterpret_cast<const char *>(data.data()), size);
+            sink = picosha2::hash256_hex_string(copy)[0];
+        });
+        measure("xxh3-128", size, repeats * 10, [&] { sink = ContentHash::Of(data.data(), size).ToHex()[0]; });
+    }
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "lumi_bench_hash.bin";
+    std::ofstream(path) << "hello";
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < 10000; ++i)
+        sink = static_cast<char>(FileStamp::Of(path.string()).size);
+    std::printf("  FileStamp::Of: %.2f us\n", std::chrono::duration<double, std::micro>(Clock::now() - start).count() / 10000);
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Logging cost, FileSink against BinaryFileSink: a typical per-frame line (int, float, int, string)
+// logged in a tight loop from one thread and from four. Reports what the calling thread pays per
+// call and the end-to-end rate including the sink thread writing the file out. Calls past the ring
+// are dropped by design, so the loop paces itself to the ring size; that's the sustained rate a
+// game can log at. Not a CTest test: run it by hand (Release build, quiet machine).
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/log/log.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int CALLS = 1'000'000, BURST = 1000;
+
+void run(bool binary, int threads) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / (binary ? "lumi_bench_log.lumilog" : "lumi_bench_log.log");
+    std::filesystem::remove(path);
+    Log::ClearSinks();
+    if (binary)
+        Log::AddSink(std::make_unique<BinaryFileSink>(path.string()));
+    else
+        Log::AddSink(std::make_unique<FileSink>(path.string()));
+    Log::FlushAll();
+
+    std::vector<double>      callNs(threads);
+    std::vector<std::thread> workers;
+    const Clock::time_point  start = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            double inCalls = 0.0;
+            for (int i = 0; i < CALLS / threads; i += BURST) {
+                const Clock::time_point burst = Clock::now();
+                for (int k = i; k < i + BURST; ++k)
+                    LOG_DEBUG("frame {} dt {:.3f} ms entities {} state {}", k, 16.6f + k % 7 * 0.1f, 1024 + k % 50, "running");
+                inCalls += std::chrono::duration<double, std::nano>(Clock::now() - burst).count();
+                std::this_thread::sleep_for(std::chrono::microseconds(200)); // the rest of the frame
+            }
+            callNs[t] = inCalls / (CALLS / threads);
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+    Log::FlushAll();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    Log::ClearSinks();
+
+    double perCall = 0.0;
+    for (const double ns : callNs)
+        perCall += ns / threads;
+    std::printf("%-14s %d thread%s: %6.1f ns/call on the caller, %6.2f M lines/s end-to-end, %6.1f MB file\n",
+        binary ? "BinaryFileSink" : "FileSink", threads, threads > 1 ? "s" : " ", perCall, CALLS / seconds / 1e6,
+        std::filesystem::file_size(path) / 1048576.0);
+    std::filesystem::remove(path);
+}
+} // namespace
+
+int main() {
+    for (const int threads : { 1, 4 })
+        for (const bool binary : { false, true })
+            run(binary, threads);
+    return 0;
+}
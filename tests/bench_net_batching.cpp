@@ -0,0 +1,91 @@
+// Packets and bytes per tick with and without Net's coalescing: a server broadcasting N small
+// entity updates (unreliable) and one ordered chat message per tick, and a 3 KB reliable message
+// every 100 ticks, to bare ReliableTransport clients over loopback. "Unbatched" calls Net::Flush
+// after every send, which is what each send cost before batching. Datagrams count both directions
+// (acks included) and stand in for send syscalls; wire bytes add 28 bytes of UDP/IPv4 header per
+// datagram. Not a CTest test: run it by hand.
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "platform/net/itransport.h"
+#include "platform/net/loopback.h"
+#include "platform/net/net.h"
+#include "platform/net/reliable.h"
+
+namespace {
+constexpr uint16_t PORT  = 7300;
+constexpr int      TICKS = 600;
+
+struct EntityUpdate {
+    uint32_t id;
+    float    x, y, angle;
+    uint16_t animation, flags;
+};
+struct Chat {
+    uint32_t sequence;
+};
+struct Snapshot {
+    uint8_t bytes[3000];
+};
+
+uint64_t now = 1'000'000;
+
+void run(bool batched, int clientCount, int updates) {
+    LoopbackNetwork network;
+    auto           *server = new ReliableTransport(network.CreateEndpoint());
+    server->SetClock([] { return now; });
+    Net::UseTransport(server);
+    Net::Host(PORT);
+
+    std::vector<std::unique_ptr<ReliableTransport>> clients;
+    for (int i = 0; i < clientCount; ++i) {
+        clients.push_back(std::make_unique<ReliableTransport>(network.CreateEndpoint()));
+        clients.back()->SetClock([] { return now; });
+        clients.back()->Connect("loopback", PORT);
+    }
+    std::vector<TransportEvent> events;
+    auto                        tick = [&] {
+        Net::Update();
+        for (auto &client : clients) {
+            events.clear();
+            client->Poll(events);
+        }
+        now += 16'667;
+    };
+    for (int i = 0; i < 10; ++i)
+        tick();
+
+    const uint64_t packets = network.GetPacketsDelivered(), bytes = network.GetBytesDelivered();
+    for (int t = 0; t < TICKS; ++t) {
+        for (int e = 0; e < updates; ++e) {
+            Net::Broadcast(EntityUpdate { uint32_t(e), 1.0f, 2.0f, 3.0f, 4, 5 });
+            if (!batched)
+                Net::Flush();
+        }
+        Net::BroadcastReliable(Chat { uint32_t(t) });
+        if (t % 100 == 0)
+            Net::BroadcastReliable(Snapshot {});
+        tick();
+    }
+    for (int i = 0; i < 20; ++i)
+        tick(); // the last acks
+
+    const double datagrams = double(network.GetPacketsDelivered() - packets) / TICKS;
+    const double wire      = (double(network.GetBytesDelivered() - bytes) + datagrams * TICKS * 28.0) / TICKS;
+    std::printf("%-9s %d clients x %3d updates: %7.1f datagrams/tick  %8.0f wire bytes/tick  (%6.1f KB/s at 60 Hz)\n",
+        batched ? "batched" : "unbatched", clientCount, updates, datagrams, wire, wire * 60.0 / 1024.0);
+    Net::Shutdown();
+}
+} // namespace
+
+int main() {
+    for (const auto &[clients, updates] : { std::pair { 8, 50 }, std::pair { 2, 5 }, std::pair { 16, 200 } }) {
+        run(false, clients, updates);
+        run(true, clients, updates);
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Overhead per profiler zone, against the same loop without one: inactive (HUD hidden, no
+// capture), active (a timestamp pair and a ring push), active with a std::string name (interned),
+// and while a capture is running. Build with LUMINOVEAU_ENABLE_PROFILER=OFF to see zones compile
+// away. Not a CTest test: run it by hand (Release build, quiet machine).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "profiler/profiler.h"
+
+namespace {
+constexpr int ZONES_PER_FRAME = 2000, FRAMES = 500;
+
+volatile uint64_t sink = 0;
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+void work() {
+    sink = sink + 1;
+}
+
+// Nanoseconds per iteration of `body`, one EndFrame (ring drain) per ZONES_PER_FRAME iterations
+template <typename F>
+double nsPerZone(F &&body) {
+    double total = 0.0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ZONES_PER_FRAME; ++i)
+            body();
+        total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        Profiler::EndFrame();
+    }
+    return total / (double(FRAMES) * ZONES_PER_FRAME);
+}
+} // namespace
+
+int main() {
+    const double base     = nsPerZone([] { work(); });
+    const double inactive = nsPerZone([] {
+        LUMI_ZONE("Zone");
+        work();
+    });
+
+    Profiler::SetEnabled(true);
+    const double active = nsPerZone([] {
+        LUMI_ZONE("Zone");
+        work();
+    });
+    const std::string name     = "Pass: sprites";
+    const double      interned = nsPerZone([&] {
+        LUMI_ZONE(std::string_view(name));
+        work();
+    });
+    Profiler::SetEnabled(false);
+
+    Profiler::BeginCapture(size_t(FRAMES) * (ZONES_PER_FRAME + 1)); // and a marker per frame
+    const double capturing = nsPerZone([] {
+        LUMI_ZONE("Zone");
+        work();
+    });
+    const std::filesystem::path trace = std::filesystem::temp_directory_path() / "lumi_bench_profiler.json";
+    Profiler::EndCapture(trace.string());
+    std::filesystem::remove(trace);
+
+    std::printf("baseline                   %6.2f ns per iteration\n", base);
+    std::printf("inactive zone              %+6.2f ns\n", inactive - base);
+    std::printf("active zone                %+6.2f ns\n", active - base);
+    std::printf("active zone, string name   %+6.2f ns\n", interned - base);
+    std::printf("capturing zone             %+6.2f ns\n", capturing - base);
+    std::printf("(zones %s, %llu dropped)\n", LUMINOVEAU_PROFILER ? "compiled in" : "compiled out",
+        static_cast<unsigned long long>(Profiler::GetDroppedZones()));
+    return 0;
+}
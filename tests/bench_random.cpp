@@ -0,0 +1,80 @@
+// Throughput of Rng against the std::mt19937 setup it replaced. Not a CTest test: run it by hand
+// (Release build, quiet machine) and compare the ns/op columns.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "util/random.h"
+
+namespace {
+constexpr size_t COUNT = 1u << 24;
+
+// Keeps results alive so the loops aren't optimized away
+volatile uint32_t sink;
+
+template <typename Fn>
+void bench(const char *name, Fn &&fn) {
+    const auto     start = std::chrono::steady_clock::now();
+    const uint32_t value = fn();
+    const auto     end   = std::chrono::steady_clock::now();
+    sink                 = value;
+    const double ns      = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-28s %6.2f ns/op\n", name, ns / COUNT);
+}
+} // namespace
+
+int main() {
+    bench("Rng::Next", [] {
+        Rng      rng(1);
+        uint32_t acc = 0;
+        for (size_t i = 0; i < COUNT; ++i)
+            acc ^= rng.Next();
+        return acc;
+    });
+    bench("std::mt19937", [] {
+        std::mt19937 gen(1);
+        uint32_t     acc = 0;
+        for (size_t i = 0; i < COUNT; ++i)
+            acc ^= gen();
+        return acc;
+    });
+    bench("Rng::Range(0, 99)", [] {
+        Rng      rng(1);
+        uint32_t acc = 0;
+        for (size_t i = 0; i < COUNT; ++i)
+            acc += static_cast<uint32_t>(rng.Range(0, 99));
+        return acc;
+    });
+    bench("uniform_int_distribution", [] {
+        std::mt19937                  gen(1);
+        std::uniform_int_distribution distr(0, 99);
+        uint32_t                      acc = 0;
+        for (size_t i = 0; i < COUNT; ++i)
+            acc += static_cast<uint32_t>(distr(gen));
+        return acc;
+    });
+    bench("Rng::Fill(float)", [] {
+        Rng                rng(1);
+        std::vector<float> out(COUNT);
+        rng.Fill(out.data(), out.size(), -1.0f, 1.0f);
+        return static_cast<uint32_t>(out[COUNT / 2] * 1000.0f);
+    });
+    bench("uniform_real_distribution", [] {
+        std::mt19937                          gen(1);
+        std::uniform_real_distribution<float> distr(-1.0f, 1.0f);
+        std::vector<float>                    out(COUNT);
+        for (float &value : out)
+            value = distr(gen);
+        return static_cast<uint32_t>(out[COUNT / 2] * 1000.0f);
+    });
+    bench("Random::Hash", [] {
+        uint32_t acc = 0;
+        for (size_t i = 0; i < COUNT; ++i)
+            acc ^= Random::Hash(static_cast<uint32_t>(i));
+        return acc;
+    });
+    return 0;
+}
@@ -0,0 +1,93 @@
+// SpatialIndex against QuadTree at 10k, 100k and 1M points in a 4096x4096 world: the time to
+// build (QuadTree: insert every point into a fresh tree; SpatialIndex: Rebuild, inline and on a
+// pool) and to answer 1000 circle queries of radius 50. Not a CTest test: run it by hand
+// (Release build, quiet machine).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "util/quadtree.h"
+#include "util/random.h"
+#include "util/spatialindex.h"
+#include "util/threadpool.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int   QUERIES = 1000;
+constexpr float WORLD = 4096.0f, RADIUS = 50.0f;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(size_t count, const char *name, double buildMs, double queryMs, size_t hits) {
+    std::printf("n=%7zu  %-20s build %9.2f ms   %d queries %8.2f ms  (%zu hits)\n", count, name, buildMs, QUERIES, queryMs, hits);
+}
+} // namespace
+
+int main() {
+    Rng        rng(1);
+    ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+
+    for (const size_t count : { size_t(10'000), size_t(100'000), size_t(1'000'000) }) {
+        std::vector<float> x(count), y(count), qx(QUERIES), qy(QUERIES);
+        rng.Fill(x.data(), count, 0.0f, WORLD);
+        rng.Fill(y.data(), count, 0.0f, WORLD);
+        rng.Fill(qx.data(), QUERIES, 0.0f, WORLD);
+        rng.Fill(qy.data(), QUERIES, 0.0f, WORLD);
+
+        {
+            QuadTree                      tree(rectf(0.0f, 0.0f, WORLD, WORLD));
+            std::vector<QuadTree::qtPoint> points(count);
+            for (size_t i = 0; i < count; ++i)
+                points[i] = { x[i], y[i], reinterpret_cast<void *>(i + 1) };
+
+            auto start = Clock::now();
+            for (QuadTree::qtPoint &point : points)
+                tree.insert(point);
+            const double build = msSince(start);
+
+            size_t              hits = 0;
+            std::vector<void *> found;
+            start = Clock::now();
+            for (int q = 0; q < QUERIES; ++q) {
+                found.clear();
+                tree.query(QuadTree::AABBCircle(qx[q], qy[q], RADIUS), &found);
+                hits += found.size();
+            }
+            report(count, "QuadTree", build, msSince(start), hits);
+            tree.reset();
+        }
+
+        for (const SpatialIndexType type : { SpatialIndexType::LooseQuadTree, SpatialIndexType::UniformGrid }) {
+            for (ThreadPool *threads : { static_cast<ThreadPool *>(nullptr), &pool }) {
+                SpatialIndexSettings settings;
+                settings.type = type;
+                settings.cellSize = 2.0f * RADIUS; // bounds: the default 4096x4096 world
+                SpatialIndex<> index(settings);
+                index.Rebuild(x.data(), y.data(), nullptr, count, nullptr, threads); // warm up
+
+                auto start = Clock::now();
+                for (int i = 0; i < 5; ++i)
+                    index.Rebuild(x.data(), y.data(), nullptr, count, nullptr, threads);
+                const double build = msSince(start) / 5;
+
+                size_t hits = 0;
+                start       = Clock::now();
+                for (int q = 0; q < QUERIES; ++q)
+                    index.QueryCircle(qx[q], qy[q], RADIUS, [&](uint32_t) { ++hits; });
+
+                const bool grid = type == SpatialIndexType::UniformGrid;
+                report(count, grid ? (threads ? "UniformGrid, pool" : "UniformGrid") : (threads ? "LooseQuadTree, pool" : "LooseQuadTree"), build,
+                    msSince(start), hits);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+// Cost of headless simulation ticks: Timestep::Step with an empty callback (the dispatch itself)
+// and with a 10k-particle integration, and Advance over a run of variable frames. Not a CTest
+// test: run it by hand (Release build, quiet machine).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "core/timestep/timestep.h"
+
+namespace {
+template <typename F>
+void bench(const char *name, int ticks, F &&run) {
+    const auto start = std::chrono::steady_clock::now();
+    run();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-34s %10.1f ns/tick  %8.2f M ticks/s\n", name, seconds / ticks * 1e9, ticks / seconds / 1e6);
+}
+} // namespace
+
+int main() {
+    constexpr int TICKS = 1'000'000;
+
+    uint64_t count = 0;
+    Timestep::SetTickCallback([&](double) { ++count; });
+    bench("Step, empty tick", TICKS, [] { Timestep::Step(TICKS); });
+
+    // 60 Hz frames of variable length: ~1 tick each, sometimes 0 or 2
+    const double frames[] = { 0.016, 0.017, 0.015, 0.020, 0.013, 0.0167 };
+    Timestep::Reset();
+    bench("Advance, variable frames", TICKS, [&] {
+        while (Timestep::GetTickCount() < TICKS)
+            for (const double frame : frames)
+                Timestep::Advance(frame);
+    });
+
+    constexpr int      PARTICLES = 10'000, SIM_TICKS = 2000;
+    std::vector<float> y(PARTICLES, 100.0f), velocity(PARTICLES, 0.0f);
+    Timestep::SetTickCallback([&](double dt) {
+        const float step = static_cast<float>(dt);
+        for (int i = 0; i < PARTICLES; ++i) {
+            velocity[i] -= 9.81f * step;
+            y[i] += velocity[i] * step;
+        }
+    });
+    bench("Step, 10k-particle integration", SIM_TICKS, [] { Timestep::Step(SIM_TICKS); });
+
+    std::printf("(%llu empty ticks, y[0] = %.1f)\n", static_cast<unsigned long long>(count), y[0]);
+    return 0;
+}
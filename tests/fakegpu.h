@@ -0,0 +1,160 @@
+#pragma once
+
+// IGpu that draws nothing: every call succeeds with a made-up handle, and compute passes are
+// recorded as the device would see them, so tests can check what the engine encoded without a
+// GPU. Recording appends to `dispatches`; reserve it up front to keep the fake off the heap.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gpu/IGpu.h"
+
+/// @cond INTERNAL
+class FakeGpu final : public IGpu {
+public:
+    static constexpr uint32_t MAX_BINDINGS = 8;
+
+    struct Uniform {
+        uint32_t slot = 0;
+        uint32_t size = 0;
+        uint8_t  bytes[64] {}; // the first 64
+    };
+
+    // One compute pass: its bindings, uniform pushes and the dispatch it ran
+    struct Dispatch {
+        GpuComputePipelineHandle pipeline = 0;
+        uint32_t                 groups[3] {};
+        GpuStorageTextureBinding readWriteTextures[MAX_BINDINGS] {};
+        GpuStorageBufferBinding  readWriteBuffers[MAX_BINDINGS] {};
+        GpuTextureHandle         readTextures[MAX_BINDINGS] {};
+        GpuBufferHandle          readBuffers[MAX_BINDINGS] {};
+        Uniform                  uniforms[MAX_BINDINGS] {};
+        uint32_t readWriteTextureCount = 0, readWriteBufferCount = 0, readTextureCount = 0, readBufferCount = 0, uniformCount = 0;
+    };
+
+    std::vector<Dispatch> dispatches;
+    uint64_t              checksum = 0; // every handle, group count and uniform byte, in order
+
+    bool Init(void *) override { return true; }
+    void Shutdown() override { }
+    void WaitIdle() override { }
+
+    GpuCmdBufferHandle AcquireCommandBuffer() override { return 1; }
+    void               SubmitCommandBuffer(GpuCmdBufferHandle) override { }
+
+    GpuTextureHandle AcquireSwapchainTexture(GpuCmdBufferHandle, uint32_t &width, uint32_t &height) override {
+        width = height = 1;
+        return 1;
+    }
+    GpuTextureFormat GetSwapchainFormat() const override { return {}; }
+
+    GpuRenderPassHandle BeginRenderPass(GpuCmdBufferHandle, const GpuColorTargetInfo *, uint32_t, const GpuDepthStencilTargetInfo *) override { return 1; }
+    void                EndRenderPass(GpuRenderPassHandle) override { }
+
+    GpuComputePassHandle BeginComputePass(GpuCmdBufferHandle, const GpuStorageTextureBinding *readWriteTextures, uint32_t readWriteTextureCount,
+        const GpuStorageBufferBinding *readWriteBuffers, uint32_t readWriteBufferCount) override {
+        _open                       = {};
+        _open.readWriteTextureCount = readWriteTextureCount;
+        _open.readWriteBufferCount  = readWriteBufferCount;
+        std::copy_n(readWriteTextures, std::min(readWriteTextureCount, MAX_BINDINGS), _open.readWriteTextures);
+        std::copy_n(readWriteBuffers, std::min(readWriteBufferCount, MAX_BINDINGS), _open.readWriteBuffers);
+        for (uint32_t i = 0; i < readWriteTextureCount; ++i)
+            _mix(readWriteTextures[i].texture ^ readWriteTextures[i].mipLevel << 16 ^ uint64_t(readWriteTextures[i].layer) << 32);
+        for (uint32_t i = 0; i < readWriteBufferCount; ++i)
+            _mix(readWriteBuffers[i].buffer);
+        return 1;
+    }
+    void EndComputePass(GpuComputePassHandle) override { }
+
+    void BindGraphicsPipeline(GpuRenderPassHandle, GpuGraphicsPipelineHandle) override { }
+    void BindComputePipeline(GpuComputePassHandle, GpuComputePipelineHandle pipeline) override {
+        _open.pipeline = pipeline;
+        _mix(pipeline);
+    }
+
+    void BindVertexBuffers(GpuRenderPassHandle, uint32_t, const GpuBufferBinding *, uint32_t) override { }
+    void BindIndexBuffer(GpuRenderPassHandle, GpuBufferBinding, bool) override { }
+    void BindVertexSamplers(GpuRenderPassHandle, uint32_t, const GpuTextureSamplerBinding *, uint32_t) override { }
+    void BindFragmentSamplers(GpuRenderPassHandle, uint32_t, const GpuTextureSamplerBinding *, uint32_t) override { }
+    void BindFragmentStorageTextures(GpuRenderPassHandle, uint32_t, const GpuTextureHandle *, uint32_t) override { }
+    void BindVertexStorageBuffers(GpuRenderPassHandle, uint32_t, const GpuBufferHandle *, uint32_t) override { }
+    void BindComputeSamplers(GpuComputePassHandle, uint32_t, const GpuTextureSamplerBinding *, uint32_t) override { }
+
+    void BindComputeStorageTextures(GpuComputePassHandle, uint32_t, const GpuTextureHandle *textures, uint32_t count) override {
+        _open.readTextureCount = count;
+        std::copy_n(textures, std::min(count, MAX_BINDINGS), _open.readTextures);
+        for (uint32_t i = 0; i < count; ++i)
+            _mix(textures[i]);
+    }
+    void BindComputeStorageBuffers(GpuComputePassHandle, uint32_t, const GpuBufferHandle *buffers, uint32_t count) override {
+        _open.readBufferCount = count;
+        std::copy_n(buffers, std::min(count, MAX_BINDINGS), _open.readBuffers);
+        for (uint32_t i = 0; i < count; ++i)
+            _mix(buffers[i]);
+    }
+
+    void PushVertexUniformData(GpuCmdBufferHandle, uint32_t, const void *, uint32_t) override { }
+    void PushFragmentUniformData(GpuCmdBufferHandle, uint32_t, const void *, uint32_t) override { }
+    void PushComputeUniformData(GpuCmdBufferHandle, uint32_t slot, const void *data, uint32_t size) override {
+        if (_open.uniformCount < MAX_BINDINGS) {
+            Uniform &uniform = _open.uniforms[_open.uniformCount];
+            uniform.slot     = slot;
+            uniform.size     = size;
+            std::memcpy(uniform.bytes, data, std::min<size_t>(size, sizeof(uniform.bytes)));
+        }
+        ++_open.uniformCount;
+        _mix(slot);
+        for (uint32_t i = 0; i < size; ++i)
+            _mix(static_cast<const uint8_t *>(data)[i]);
+    }
+
+    void DrawPrimitives(GpuRenderPassHandle, uint32_t, uint32_t, uint32_t, uint32_t) override { }
+    void DrawIndexedPrimitives(GpuRenderPassHandle, uint32_t, uint32_t, uint32_t, int32_t, uint32_t) override { }
+
+    void DispatchCompute(GpuComputePassHandle, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override {
+        _open.groups[0] = groupsX;
+        _open.groups[1] = groupsY;
+        _open.groups[2] = groupsZ;
+        _mix(groupsX ^ uint64_t(groupsY) << 20 ^ uint64_t(groupsZ) << 40);
+        if (dispatches.size() < dispatches.capacity())
+            dispatches.push_back(_open);
+    }
+
+    void SetScissor(GpuRenderPassHandle, int32_t, int32_t, uint32_t, uint32_t) override { }
+    void SetViewport(GpuRenderPassHandle, float, float, float, float, float, float) override { }
+
+    GpuTextureHandle          CreateTexture(const GpuTextureCreateInfo &) override { return ++_nextHandle; }
+    GpuBufferHandle           CreateBuffer(const GpuBufferCreateInfo &) override { return ++_nextHandle; }
+    GpuTransferBufferHandle   CreateTransferBuffer(const GpuTransferBufferCreateInfo &) override { return ++_nextHandle; }
+    GpuSamplerHandle          CreateSampler(const GpuSamplerCreateInfo &) override { return ++_nextHandle; }
+    GpuShaderHandle           CreateShader(const GpuShaderCreateInfo &) override { return ++_nextHandle; }
+    GpuGraphicsPipelineHandle CreateGraphicsPipeline(const GpuGraphicsPipelineCreateInfo &) override { return ++_nextHandle; }
+    GpuComputePipelineHandle  CreateComputePipeline(const GpuComputePipelineCreateInfo &) override { return ++_nextHandle; }
+    GpuShaderHandle           CreateShaderFromSPIRV(const GpuShaderCreateInfo &) override { return ++_nextHandle; }
+    GpuComputePipelineHandle  CreateComputePipelineFromSPIRV(const uint8_t *, size_t, const char *, GpuComputeReflection *) override { return ++_nextHandle; }
+
+    void ReleaseTexture(GpuTextureHandle) override { }
+    void ReleaseBuffer(GpuBufferHandle) override { }
+    void ReleaseTransferBuffer(GpuTransferBufferHandle) override { }
+    void ReleaseSampler(GpuSamplerHandle) override { }
+    void ReleaseShader(GpuShaderHandle) override { }
+    void ReleaseGraphicsPipeline(GpuGraphicsPipelineHandle) override { }
+    void ReleaseComputePipeline(GpuComputePipelineHandle) override { }
+
+    void *MapTransferBuffer(GpuTransferBufferHandle, bool) override { return nullptr; }
+    void  UnmapTransferBuffer(GpuTransferBufferHandle) override { }
+    void  UploadToTexture(GpuCmdBufferHandle, const GpuTransferBufferRegion &, const GpuTextureRegion &, bool) override { }
+    void  UploadToBuffer(GpuCmdBufferHandle, GpuTransferBufferHandle, uint32_t, GpuBufferHandle, uint32_t, uint32_t, bool) override { }
+    void  DownloadFromTexture(GpuCmdBufferHandle, const GpuTextureRegion &, const GpuTransferBufferRegion &) override { }
+    void  BlitTexture(GpuCmdBufferHandle, GpuTextureHandle, GpuTextureHandle, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t,
+         uint32_t, uint32_t, GpuFilter) override { }
+
+private:
+    void _mix(uint64_t value) { checksum = (checksum ^ value) * 0x100000001b3ull; }
+
+    Dispatch  _open;
+    uintptr_t _nextHandle = 0;
+};
+/// @endcond
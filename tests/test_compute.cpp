@@ -0,0 +1,124 @@
+// Compute: what a recorded frame of dispatches encodes on the device (fake IGpu), and that once
+// the frame arena has grown, recording, executing and resetting 10k dispatches a frame makes
+// no heap allocation (replaced global operator new counts them all).
+
+#include <cstdint>
+#include <cstring>
+
+#include "renderer/compute.h"
+
+#include "alloc_counter.h"
+#include "fakegpu.h"
+#include "testing.h"
+
+namespace {
+constexpr uint32_t DISPATCHES = 10000;
+
+struct Params {
+    float    dt;
+    uint32_t count;
+    float    pad[6];
+};
+
+ComputePipelineAsset pipeline(GpuComputePipelineHandle handle, uint32_t threadsX, uint32_t threadsY = 1) {
+    ComputePipelineAsset asset;
+    asset.pipeline     = handle;
+    asset.threadCountX = threadsX;
+    asset.threadCountY = threadsY;
+    asset.threadCountZ = 1;
+    return asset;
+}
+
+// A particle-update-like dispatch: two read buffers, two read-write buffers bound out of slot
+// order, a read-write texture and three uniform pushes (one overwriting another)
+void record(uint32_t i) {
+    Compute::SetPipeline(pipeline(7, 64));
+    Compute::BindReadBuffer(0, 11);
+    Compute::BindReadBuffer(1, 12);
+    Compute::BindReadWriteBuffer(1, 22);
+    Compute::BindReadWriteBuffer(0, 21);
+    Compute::BindReadWriteTexture(0, 31, 1, 0);
+    Compute::PushUniform(0, Params { 0.016f, i, {} });
+    Compute::PushUniform(0, Params { 0.016f, i + 1, {} });
+    Compute::PushUniform(1, i);
+    Compute::DispatchAuto(1000 + i);
+}
+
+void encoding() {
+    FakeGpu gpu;
+    gpu.dispatches.reserve(8);
+
+    record(5);
+    {
+        Params scoped { 2.0f, 77, {} }; // gone before the frame executes
+        Compute::SetPipeline(pipeline(9, 8, 8));
+        Compute::BindReadTexture(2, 41);
+        Compute::PushUniform(3, scoped);
+        Compute::DispatchAuto(100, 30);
+    }
+    Compute::Dispatch(4, 4); // no pipeline: the previous dispatch cleared it, so this is refused
+    Compute::ExecuteQueued(gpu, 1);
+    Compute::Reset();
+
+    CHECK(gpu.dispatches.size() == 2);
+    if (gpu.dispatches.size() != 2)
+        return;
+
+    const FakeGpu::Dispatch &first = gpu.dispatches[0];
+    CHECK(first.pipeline == 7);
+    CHECK(first.groups[0] == 16 && first.groups[1] == 1 && first.groups[2] == 1); // ceil(1005 / 64)
+    CHECK(first.readBufferCount == 2 && first.readBuffers[0] == 11 && first.readBuffers[1] == 12);
+    CHECK(first.readWriteBufferCount == 2 && first.readWriteBuffers[0].buffer == 21 && first.readWriteBuffers[1].buffer == 22);
+    CHECK(first.readWriteTextureCount == 1 && first.readWriteTextures[0].texture == 31 && first.readWriteTextures[0].mipLevel == 1);
+    CHECK(first.readTextureCount == 0);
+    CHECK(first.uniformCount == 2);
+    Params params;
+    std::memcpy(&params, first.uniforms[0].bytes, sizeof(params));
+    CHECK(first.uniforms[0].slot == 0 && first.uniforms[0].size == sizeof(Params) && params.count == 6); // the later push won
+    uint32_t index;
+    std::memcpy(&index, first.uniforms[1].bytes, sizeof(index));
+    CHECK(first.uniforms[1].slot == 1 && first.uniforms[1].size == sizeof(uint32_t) && index == 5);
+
+    const FakeGpu::Dispatch &second = gpu.dispatches[1];
+    CHECK(second.pipeline == 9);
+    CHECK(second.groups[0] == 13 && second.groups[1] == 4 && second.groups[2] == 1);
+    CHECK(second.readBufferCount == 0 && second.readWriteBufferCount == 0 && second.readWriteTextureCount == 0);
+    CHECK(second.readTextureCount == 3 && second.readTextures[0] == 0 && second.readTextures[2] == 41);
+    std::memcpy(&params, second.uniforms[0].bytes, sizeof(params));
+    CHECK(second.uniformCount == 1 && second.uniforms[0].slot == 3 && params.dt == 2.0f && params.count == 77);
+
+    // Nothing left over for the next frame
+    FakeGpu next;
+    Compute::ExecuteQueued(next, 1);
+    CHECK(next.checksum == 0);
+}
+
+void steadyStateAllocations() {
+    FakeGpu gpu;
+    for (int frame = 0; frame < 3; ++frame) {
+        for (uint32_t i = 0; i < DISPATCHES; ++i)
+            record(i);
+        Compute::ExecuteQueued(gpu, 1);
+        Compute::Reset();
+    }
+    const uint64_t warmChecksum = gpu.checksum;
+
+    const uint64_t before = allocations.load();
+    for (uint32_t i = 0; i < DISPATCHES; ++i)
+        record(i);
+    const uint64_t recorded = allocations.load();
+    Compute::ExecuteQueued(gpu, 1);
+    Compute::Reset();
+    const uint64_t after = allocations.load();
+
+    CHECK_MSG(recorded == before, "%llu allocations recording %u dispatches", static_cast<unsigned long long>(recorded - before), DISPATCHES);
+    CHECK_MSG(after == recorded, "%llu allocations executing them", static_cast<unsigned long long>(after - recorded));
+    CHECK(gpu.checksum != warmChecksum);
+}
+} // namespace
+
+int main() {
+    encoding();
+    steadyStateAllocations();
+    return TestResult("test_compute");
+}
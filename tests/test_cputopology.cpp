@@ -0,0 +1,190 @@
+// CPU topology detection on Linux, fed fixture file contents instead of the real sysfs and
+// procfs: SMT siblings folded into cores, Intel hybrid (cpu_atom) and ARM big.LITTLE
+// (cpu_capacity) core classes, offline CPUs, affinity masks (including one naming no online
+// CPU), and the cgroup v2 cpu.max / v1 CFS quota, tightest up the hierarchy, down to
+// UsableCores.
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "platform/cpu/cputopology.h"
+
+#include "testing.h"
+
+namespace {
+using Files = std::map<std::string, std::string>;
+
+const std::string CPU = "sys/devices/system/cpu/";
+
+CpuTopology detect(const Files &files, const std::vector<int> &allowed = {}) {
+    return CpuTopology::_detectLinux(
+        [&files](const std::string &path) {
+            auto it = files.find(path);
+            return it == files.end() ? std::string() : it->second;
+        },
+        allowed);
+}
+
+// One physical core: every CPU in it lists all of them as siblings, as the kernel writes it
+void core(Files &files, const std::string &siblings, const std::vector<int> &cpus) {
+    for (int cpu : cpus)
+        files[CPU + "cpu" + std::to_string(cpu) + "/topology/core_cpus_list"] = siblings + "\n";
+}
+
+// Intel hybrid: 6 P-cores with SMT (CPUs 0-11), 8 E-cores without (12-19)
+Files hybrid() {
+    Files files;
+    files[CPU + "online"] = "0-19\n";
+    for (int cpu = 0; cpu < 12; cpu += 2)
+        core(files, std::to_string(cpu) + "-" + std::to_string(cpu + 1), { cpu, cpu + 1 });
+    for (int cpu = 12; cpu < 20; ++cpu)
+        core(files, std::to_string(cpu), { cpu });
+    files["sys/devices/cpu_atom/cpus"] = "12-19\n";
+    return files;
+}
+
+// 4 cores with SMT, CPUs 0-7, siblings n and n+4 (the usual x86 numbering), in a cgroup
+Files container(const std::string &cgroup) {
+    Files files;
+    files[CPU + "online"] = "0-7\n";
+    for (int cpu = 0; cpu < 4; ++cpu)
+        core(files, std::to_string(cpu) + "," + std::to_string(cpu + 4), { cpu, cpu + 4 });
+    files["proc/self/cgroup"] = cgroup;
+    return files;
+}
+
+void hybridCores() {
+    const CpuTopology topology = detect(hybrid());
+    CHECK(topology.logicalCores == 20 && topology.physicalCores == 14);
+    CHECK(topology.performanceCores == 6 && topology.efficiencyCores == 8 && topology.IsHybrid());
+    CHECK(topology.allowedLogical == 20 && topology.allowedPhysical == 14 && topology.cpuQuota == 0.0);
+    CHECK(topology.UsableCores() == 14);
+
+    // Performance cores first, each with its SMT pair
+    CHECK(topology.cores.size() == 14);
+    if (topology.cores.size() == 14) {
+        CHECK((topology.cores[0].cpus == std::vector<int> { 0, 1 }) && !topology.cores[0].efficiency);
+        CHECK((topology.cores[5].cpus == std::vector<int> { 10, 11 }) && !topology.cores[5].efficiency);
+        CHECK((topology.cores[6].cpus == std::vector<int> { 12 }) && topology.cores[6].efficiency);
+        CHECK((topology.cores[13].cpus == std::vector<int> { 19 }) && topology.cores[13].efficiency);
+    }
+}
+
+void bigLittle() {
+    // 4 LITTLE cores listed first, then 4 big ones; older kernels only have thread_siblings_list
+    Files files;
+    files[CPU + "online"] = "0-7\n";
+    for (int cpu = 0; cpu < 8; ++cpu) {
+        files[CPU + "cpu" + std::to_string(cpu) + "/topology/thread_siblings_list"] = std::to_string(cpu) + "\n";
+        files[CPU + "cpu" + std::to_string(cpu) + "/cpu_capacity"]                  = cpu < 4 ? "446\n" : "1024\n";
+    }
+    const CpuTopology topology = detect(files);
+    CHECK(topology.logicalCores == 8 && topology.physicalCores == 8);
+    CHECK(topology.performanceCores == 4 && topology.efficiencyCores == 4);
+    CHECK(topology.cores.size() == 8 && topology.cores[0].cpus.front() == 4 && topology.cores[4].cpus.front() == 0);
+
+    // Same capacity everywhere: one class
+    for (int cpu = 0; cpu < 8; ++cpu)
+        files[CPU + "cpu" + std::to_string(cpu) + "/cpu_capacity"] = "1024\n";
+    CHECK(!detect(files).IsHybrid() && detect(files).performanceCores == 8);
+}
+
+void offlineAndUnknown() {
+    // CPUs 4-7 still have topology entries but are offline
+    Files files           = container("");
+    files[CPU + "online"] = "0-3\n";
+    CpuTopology topology  = detect(files);
+    CHECK(topology.logicalCores == 4 && topology.physicalCores == 4);
+    CHECK(topology.cores.size() == 4 && topology.cores[0].cpus == std::vector<int> { 0 });
+
+    // No topology files at all: every CPU is its own core
+    topology = detect({ { CPU + "online", "0,2,5-6\n" } });
+    CHECK(topology.logicalCores == 4 && topology.physicalCores == 4);
+    CHECK(topology.cores.size() == 4 && topology.cores[2].cpus == std::vector<int> { 5 });
+
+    // No sysfs: the std::thread::hardware_concurrency() fallback, quota still read
+    topology = detect({ { "proc/self/cgroup", "0::/\n" }, { "sys/fs/cgroup/cpu.max", "200000 100000\n" } });
+    CHECK(topology.logicalCores >= 1 && topology.cpuQuota == 2.0 && topology.efficiencyCores == 0);
+}
+
+void affinity() {
+    // One CPU of the first P-core, both of the second, two E-cores
+    CpuTopology topology = detect(hybrid(), { 0, 2, 3, 12, 13 });
+    CHECK(topology.logicalCores == 20 && topology.physicalCores == 14);
+    CHECK(topology.allowedLogical == 5 && topology.allowedPhysical == 4 && topology.UsableCores() == 4);
+    CHECK(topology.cores.size() == 4);
+    if (topology.cores.size() == 4) {
+        CHECK(topology.cores[0].cpus == std::vector<int> { 0 });
+        CHECK((topology.cores[1].cpus == std::vector<int> { 2, 3 }));
+        CHECK(topology.cores[2].cpus == std::vector<int> { 12 } && topology.cores[2].efficiency);
+        CHECK(topology.cores[3].cpus == std::vector<int> { 13 } && topology.cores[3].efficiency);
+    }
+
+    // E-cores only: the classes still count the whole CPU
+    topology = detect(hybrid(), { 16, 17, 18, 19 });
+    CHECK(topology.allowedPhysical == 4 && topology.performanceCores == 6 && topology.cores.front().efficiency);
+
+    // Siblings n and n+4: a mask of 0-3 is four cores, one thread each
+    topology = detect(container(""), { 0, 1, 2, 3 });
+    CHECK(topology.allowedLogical == 4 && topology.allowedPhysical == 4);
+
+    // A mask naming no online CPU is ignored rather than leaving nothing
+    topology = detect(hybrid(), { 40, 41 });
+    CHECK(topology.allowedLogical == 20 && topology.allowedPhysical == 14);
+}
+
+void quotas() {
+    // cgroup v2, no limit: cpu.max says "max"
+    Files files                                          = container("0::/user.slice/game.scope\n");
+    files["sys/fs/cgroup/user.slice/game.scope/cpu.max"] = "max 100000\n";
+    files["sys/fs/cgroup/user.slice/cpu.max"]            = "max 100000\n";
+    CpuTopology topology                                 = detect(files);
+    CHECK(topology.cpuQuota == 0.0 && topology.UsableCores() == 4);
+
+    // 1.5 CPUs: rounded down to one worker
+    files["sys/fs/cgroup/user.slice/game.scope/cpu.max"] = "150000 100000\n";
+    topology                                             = detect(files);
+    CHECK(topology.cpuQuota == 1.5 && topology.UsableCores() == 1);
+
+    // The tightest limit up the hierarchy wins
+    files["sys/fs/cgroup/user.slice/game.scope/cpu.max"] = "400000 100000\n";
+    files["sys/fs/cgroup/user.slice/cpu.max"]            = "300000 100000\n";
+    files["sys/fs/cgroup/cpu.max"]                       = "max 100000\n";
+    CHECK(detect(files).cpuQuota == 3.0 && detect(files).UsableCores() == 3);
+
+    // Fewer allowed cores than the quota: the cores are the limit
+    files["sys/fs/cgroup/user.slice/cpu.max"] = "1600000 100000\n";
+    CHECK(detect(files).cpuQuota == 4.0 && detect(files, { 0, 1 }).UsableCores() == 2);
+
+    // Under a CPU: still one worker
+    files["sys/fs/cgroup/user.slice/game.scope/cpu.max"] = "50000 100000\n";
+    CHECK(detect(files).cpuQuota == 0.5 && detect(files).UsableCores() == 1);
+
+    // cgroup v1: the CFS quota of the cpu controller's group; -1 is unlimited
+    files                                                           = container("12:cpu,cpuacct:/docker/abc\n11:memory:/docker/abc\n");
+    files["sys/fs/cgroup/cpu,cpuacct/docker/abc/cpu.cfs_quota_us"]  = "250000\n";
+    files["sys/fs/cgroup/cpu,cpuacct/docker/abc/cpu.cfs_period_us"] = "100000\n";
+    CHECK(detect(files).cpuQuota == 2.5 && detect(files).UsableCores() == 2);
+    files["sys/fs/cgroup/cpu,cpuacct/docker/abc/cpu.cfs_quota_us"] = "-1\n";
+    CHECK(detect(files).cpuQuota == 0.0);
+
+    // v1 mounted as plain "cpu"
+    files                                                = container("4:cpu:/limited\n");
+    files["sys/fs/cgroup/cpu/limited/cpu.cfs_quota_us"]  = "200000\n";
+    files["sys/fs/cgroup/cpu/limited/cpu.cfs_period_us"] = "100000\n";
+    CHECK(detect(files).cpuQuota == 2.0);
+
+    // No cgroup file (not Linux-in-a-container, or /proc hidden): unlimited
+    CHECK(detect(container("")).cpuQuota == 0.0);
+}
+} // namespace
+
+int main() {
+    hybridCores();
+    bigLittle();
+    offlineAndUnknown();
+    affinity();
+    quotas();
+    return TestResult("test_cputopology");
+}
@@ -0,0 +1,209 @@
+// Dsp effects against reference results: FFT convolution against direct convolution, filter
+// and dynamics response on sine inputs, delay tap position, bit-crusher quantization and
+// resampling accuracy. Blocks are fed in odd sizes so the block-boundary paths are exercised.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+#include "platform/audio/dsp.h"
+#include "util/random.h"
+
+#include "testing.h"
+
+namespace {
+constexpr float RATE = Dsp::DEFAULT_SAMPLE_RATE;
+
+std::vector<float> sine(float hz, uint32_t frames, uint32_t channels, float amplitude = 1.0f) {
+    std::vector<float> out(frames * channels);
+    for (uint32_t i = 0; i < frames; ++i)
+        for (uint32_t c = 0; c < channels; ++c)
+            out[i * channels + c] = amplitude * std::sin(2.0f * std::numbers::pi_v<float> * hz * static_cast<float>(i) / RATE);
+    return out;
+}
+
+float peak(const std::vector<float> &samples, size_t from = 0) {
+    float result = 0.0f;
+    for (size_t i = from; i < samples.size(); ++i)
+        result = std::max(result, std::abs(samples[i]));
+    return result;
+}
+
+// Feeds the buffer through in blocks of varying size (137..436 frames)
+void processInBlocks(Dsp::Effect &effect, std::vector<float> &samples, uint32_t channels) {
+    const auto frames = static_cast<uint32_t>(samples.size() / channels);
+    for (uint32_t pos = 0; pos < frames;) {
+        const uint32_t count = std::min(frames - pos, 137 + pos % 300);
+        effect.Process(samples.data() + pos * channels, count, channels);
+        pos += count;
+    }
+}
+
+void convolution() {
+    constexpr uint32_t CHANNELS = 2, IR_FRAMES = 3000, FRAMES = 20000;
+    Rng                rng(27);
+    std::vector<float> ir(IR_FRAMES * CHANNELS), input(FRAMES * CHANNELS);
+    rng.Fill(ir.data(), ir.size(), -1.0f, 1.0f);
+    rng.Fill(input.data(), input.size(), -1.0f, 1.0f);
+
+    Dsp::ConvolutionReverb reverb(256);
+    reverb.SetImpulseResponse(ir.data(), IR_FRAMES, CHANNELS, false);
+    reverb.SetDry(0.0f);
+    reverb.SetWet(1.0f);
+    std::vector<float> output = input;
+    processInBlocks(reverb, output, CHANNELS);
+
+    // Wet output is the direct convolution, delayed by the partition size
+    const uint32_t latency = reverb.GetLatencyFrames();
+    CHECK(latency == 256);
+    double maxError = 0.0;
+    for (uint32_t frame = latency; frame < FRAMES; frame += 7) {
+        for (uint32_t c = 0; c < CHANNELS; ++c) {
+            const uint32_t t   = frame - latency;
+            double         sum = 0.0;
+            for (uint32_t k = 0; k < IR_FRAMES && k <= t; ++k)
+                sum += static_cast<double>(ir[k * CHANNELS + c]) * input[(t - k) * CHANNELS + c];
+            maxError = std::max(maxError, std::abs(sum - output[frame * CHANNELS + c]));
+        }
+    }
+    CHECK_MSG(maxError < 1e-3, "convolution error %g", maxError);
+}
+
+void biquad() {
+    // 100 Hz low-pass: 10 kHz is ~80 dB down, 20 Hz passes
+    Dsp::Biquad        lowPass(Dsp::BiquadType::LowPass, 100.0f);
+    std::vector<float> high = sine(10000.0f, 4800, 2);
+    processInBlocks(lowPass, high, 2);
+    CHECK_MSG(peak(high, high.size() / 2) < 1e-3f, "10 kHz through a 100 Hz low-pass: %g", peak(high, high.size() / 2));
+
+    Dsp::Biquad        lowPass2(Dsp::BiquadType::LowPass, 100.0f);
+    std::vector<float> low = sine(20.0f, 48000, 2);
+    processInBlocks(lowPass2, low, 2);
+    CHECK(std::abs(peak(low, low.size() / 2) - 1.0f) < 0.05f);
+
+    // +6 dB peak at its own frequency
+    Dsp::Biquad        bell(Dsp::BiquadType::Peak, 1000.0f, 1.0f, 6.0f);
+    std::vector<float> tone = sine(1000.0f, 24000, 1, 0.25f);
+    processInBlocks(bell, tone, 1);
+    CHECK(std::abs(peak(tone, tone.size() / 2) - 0.25f * std::pow(10.0f, 6.0f / 20.0f)) < 0.01f);
+}
+
+void dynamics() {
+    // Hard knee, 4:1 above -20 dB: a 0 dB sine settles at 15 dB of reduction
+    Dsp::Compressor    compressor(-20.0f, 4.0f, 1.0f, 50.0f, 0.0f);
+    std::vector<float> tone = sine(100.0f, 48000, 2);
+    processInBlocks(compressor, tone, 2);
+    CHECK_MSG(std::abs(compressor.GetGainReduction() - 15.0f) < 1.0f, "gain reduction %g dB", compressor.GetGainReduction());
+    CHECK(std::abs(peak(tone, tone.size() / 2) - std::pow(10.0f, -15.0f / 20.0f)) < 0.02f);
+
+    // The limiter never lets a sample past its ceiling, transient or not
+    Dsp::Limiter       limiter(-6.0f);
+    std::vector<float> loud = sine(100.0f, 4800, 2);
+    processInBlocks(limiter, loud, 2);
+    CHECK(peak(loud) <= std::pow(10.0f, -6.0f / 20.0f) + 1e-6f);
+    CHECK(limiter.GetGainReduction() > 3.0f);
+}
+
+void delay() {
+    Dsp::Delay echo(1.0f);
+    echo.SetTime(0.001f); // 48 frames
+    echo.SetMix(1.0f);
+    echo.SetFeedback(0.0f);
+    std::vector<float> impulse(200 * 2, 0.0f);
+    impulse[0] = impulse[1] = 1.0f;
+    echo.Process(impulse.data(), 200, 2);
+    for (uint32_t i = 0; i < 200; ++i) {
+        CHECK(impulse[i * 2] == (i == 48 ? 1.0f : 0.0f));
+        CHECK(impulse[i * 2 + 1] == impulse[i * 2]);
+    }
+}
+
+void bitcrusher() {
+    // 2 bits: steps of 0.5
+    Dsp::Bitcrusher crusher(2.0f);
+    float           samples[8]  = { 0.1f, 0.3f, 0.6f, -0.9f, 0.2f, 0.26f, -0.26f, 1.0f };
+    const float     expected[8] = { 0.0f, 0.5f, 0.5f, -1.0f, 0.0f, 0.5f, -0.5f, 1.0f };
+    crusher.Process(samples, 4, 2);
+    for (int i = 0; i < 8; ++i)
+        CHECK_MSG(samples[i] == expected[i], "sample %d: %g, expected %g", i, samples[i], expected[i]);
+
+    // Downsampling by 2 holds every other frame
+    Dsp::Bitcrusher holder(24.0f, 2);
+    float           held[4] = { 0.25f, 0.5f, 0.75f, 1.0f };
+    holder.Process(held, 4, 1);
+    CHECK(held[0] == 0.25f && held[1] == 0.25f && held[2] == 0.75f && held[3] == 0.75f);
+
+    crusher.SetBypass(true);
+    float untouched[2] = { 0.1f, 0.3f };
+    crusher.Process(untouched, 1, 2);
+    CHECK(untouched[0] == 0.1f && untouched[1] == 0.3f);
+}
+
+void chain() {
+    // A chain is its effects in order: low-pass then limiter equals the two applied by hand
+    Dsp::Biquad      lowPassA(Dsp::BiquadType::LowPass, 2000.0f), lowPassB(Dsp::BiquadType::LowPass, 2000.0f);
+    Dsp::Limiter     limiterA(-3.0f), limiterB(-3.0f);
+    Dsp::EffectChain chain;
+    CHECK(chain.Add(lowPassA) && chain.Add(limiterA) && chain.GetCount() == 2);
+
+    Rng                rng(31);
+    std::vector<float> a(4096 * 2);
+    rng.Fill(a.data(), a.size(), -1.0f, 1.0f);
+    std::vector<float> b = a;
+    chain.Process(a.data(), 4096, 2);
+    lowPassB.Process(b.data(), 4096, 2);
+    limiterB.Process(b.data(), 4096, 2);
+    CHECK(a == b);
+}
+
+struct SineSource {
+    float    hz;
+    float    rate;
+    uint32_t frame = 0;
+
+    static void Generate(float *out, uint32_t frames, uint32_t channels, void *userData) {
+        auto *self = static_cast<SineSource *>(userData);
+        for (uint32_t i = 0; i < frames; ++i, ++self->frame) {
+            const float value = std::sin(2.0f * std::numbers::pi_v<float> * self->hz * static_cast<float>(self->frame) / self->rate);
+            for (uint32_t c = 0; c < channels; ++c)
+                out[i * channels + c] = value;
+        }
+    }
+};
+
+void resampler() {
+    // 24 kHz -> 48 kHz: every output frame is the source sine at half the frame index
+    SineSource         source { 1000.0f, 24000.0f };
+    Dsp::Resampler     up(&SineSource::Generate, &source, 2, 24000.0f, RATE);
+    std::vector<float> out(4800 * 2);
+    Dsp::Resampler::Generate(out.data(), 4800, 2, &up);
+    double maxError = 0.0;
+    for (uint32_t i = 100; i < 4800; ++i) {
+        const double expected = std::sin(2.0 * std::numbers::pi * 1000.0 * ((i - 4) / 2.0) / 24000.0);
+        maxError              = std::max(maxError, std::abs(expected - out[i * 2]));
+        CHECK(out[i * 2] == out[i * 2 + 1]);
+    }
+    CHECK_MSG(maxError < 1e-3, "resampler error %g", maxError);
+
+    // Varispeed at the clamp limits stays finite and bounded
+    SineSource     fast { 1000.0f, 384000.0f };
+    Dsp::Resampler down(&SineSource::Generate, &fast, 2, 384000.0f, RATE);
+    down.SetRatio(8.0f);
+    Dsp::Resampler::Generate(out.data(), 4800, 2, &down);
+    for (const float value : out)
+        CHECK(std::isfinite(value) && std::abs(value) <= 1.01f);
+}
+} // namespace
+
+int main() {
+    convolution();
+    biquad();
+    dynamics();
+    delay();
+    bitcrusher();
+    chain();
+    resampler();
+    return TestResult("test_dsp");
+}
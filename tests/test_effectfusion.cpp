@@ -0,0 +1,216 @@
+// Effect fusion: EffectStage::Parse on the post-FX example shaders and a few that break the
+// effect interface; EffectFusion::Plan splitting chains at effects that sample away from their
+// pixel, at unfusable ones and at a change of vertex shader; and EffectFusion::Generate for runs
+// of two and three effects, whose output glslang compiles (Shaders::CompileGLSL) with every
+// stage's names kept apart.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "assets/effect/effectfusion.h"
+#include "renderer/shaders.h"
+
+#include "testing.h"
+
+namespace {
+// examples/12_post_fx/assets/shaders/grayscale.frag
+const char *const GRAYSCALE = R"(#version 450
+
+// Desaturates the framebuffer toward luminance.
+
+layout(set = 2, binding = 0) uniform sampler2D input_texture;   // SDL_shadercross: frag samplers in set 2
+
+layout(location = 0) in vec2 tex_coords;
+layout(location = 0) out vec4 out_color;
+
+layout(set = 3, binding = 0) uniform EffectParams {   // SDL_shadercross: frag uniform buffers in set 3
+    float amount;   // 0 = original, 1 = fully grey
+} params;
+
+void main() {
+    vec4 c = texture(input_texture, tex_coords);
+    float g = dot(c.rgb, vec3(0.299, 0.587, 0.114));
+    out_color = vec4(mix(c.rgb, vec3(g), params.amount), c.a);
+}
+)";
+
+// examples/12_post_fx/assets/shaders/vignette.frag
+const char *const VIGNETTE = R"(#version 450
+
+// Darkens the corners for a lens-vignette look.
+
+layout(set = 2, binding = 0) uniform sampler2D input_texture;   // SDL_shadercross: frag samplers in set 2
+
+layout(location = 0) in vec2 tex_coords;
+layout(location = 0) out vec4 out_color;
+
+layout(set = 3, binding = 0) uniform EffectParams {   // SDL_shadercross: frag uniform buffers in set 3
+    float strength;
+} params;
+
+void main() {
+    vec4 c = texture(input_texture, tex_coords);
+    vec2 d = tex_coords - 0.5;
+    float v = smoothstep(0.85, 0.25, length(d) * params.strength);
+    out_color = vec4(c.rgb * v, c.a);
+}
+)";
+
+// examples/12_post_fx/assets/shaders/wave.frag: samples a neighbouring pixel
+const char *const WAVE = R"(#version 450
+
+// Horizontal wobble — offsets each row's sample by an animated sine.
+
+layout(set = 2, binding = 0) uniform sampler2D input_texture;   // SDL_shadercross: frag samplers in set 2
+
+layout(location = 0) in vec2 tex_coords;
+layout(location = 0) out vec4 out_color;
+
+layout(set = 3, binding = 0) uniform EffectParams {   // SDL_shadercross: frag uniform buffers in set 3
+    float time;
+    float strength;
+} params;
+
+void main() {
+    vec2 uv = tex_coords;
+    uv.x += sin(uv.y * 20.0 + params.time * 3.0) * params.strength;
+    out_color = texture(input_texture, uv);
+}
+)";
+
+// Different names for everything, an instance-less block whose `amount` and a helper whose
+// local `c` clash with grayscale's, a struct and constants
+const char *const TINT = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(set = 2, binding = 0) uniform sampler2D src;
+layout(location = 0) in vec2 uv;
+layout(location = 0) out vec4 fragColor;
+
+struct Grade {
+    vec3  tint;
+    float gamma;
+};
+
+const float EPSILON = 1e-4, HALF = 0.5;
+
+layout(set = 3, binding = 0) uniform TintParams {
+    Grade grade;
+    float amount;
+};
+
+vec3 toLinear(vec3 c, Grade g) { return pow(max(c, vec3(EPSILON)), vec3(g.gamma)); }
+
+void main() {
+    vec4 c    = texture(src, uv);
+    fragColor = vec4(mix(c.rgb, toLinear(c.rgb, grade) * grade.tint, amount * HALF), c.a);
+}
+)";
+
+bool contains(const std::string &text, const std::string &part) { return text.find(part) != std::string::npos; }
+
+void parse() {
+    const EffectStage grayscale = EffectStage::Parse(GRAYSCALE);
+    CHECK_MSG(grayscale.fusable && grayscale.pointwise, "grayscale: %s", grayscale.reason.c_str());
+    CHECK(grayscale.sampler == "input_texture" && grayscale.input == "tex_coords" && grayscale.output == "out_color");
+    CHECK(grayscale.hasBlock && grayscale.instance == "params" && grayscale.memberNames.contains("amount"));
+
+    const EffectStage tint = EffectStage::Parse(TINT);
+    CHECK_MSG(tint.fusable && tint.pointwise, "tint: %s", tint.reason.c_str());
+    CHECK(tint.instance.empty() && tint.members.size() == 2 && tint.extensions.size() == 1);
+    CHECK(tint.structs.contains("Grade") && tint.globals.contains("toLinear"));
+    CHECK(tint.globals.contains("EPSILON") && tint.globals.contains("HALF"));
+
+    // Samples at a moved uv: may start a run, can't continue one
+    const EffectStage wave = EffectStage::Parse(WAVE);
+    CHECK(wave.fusable && !wave.pointwise && !wave.reason.empty());
+
+    // Not the effect interface
+    const std::string header = "#version 450\nlayout(set = 2, binding = 0) uniform sampler2D s;\nlayout(location = 0) in vec2 uv;\n"
+                               "layout(location = 0) out vec4 color;\n";
+    const std::string body   = "void main() { color = texture(s, uv); }\n";
+    CHECK(EffectStage::Parse(header + body).pointwise);
+    CHECK(EffectStage::Parse(header + "void main() { color = texture(s, uv) * float(textureSize(s, 0).x); }\n").pointwise);
+    CHECK(!EffectStage::Parse(header + "#define SCALE 2.0\n" + body).fusable);
+    CHECK(!EffectStage::Parse(header + "void main() { color = texture(s, uv); if (color.a < 0.5) discard; }\n").fusable);
+    CHECK(!EffectStage::Parse(header + "layout(set = 2, binding = 1) uniform sampler2D mask;\n" + body).fusable);
+    CHECK(!EffectStage::Parse(header + "layout(location = 1) in vec2 uv2;\n" + body).fusable);
+    CHECK(!EffectStage::Parse(header + "layout(push_constant) uniform P { float x; } p;\n" + body).fusable);
+    CHECK(!EffectStage::Parse(header + "uniform float loose;\n" + body).fusable);
+    CHECK(!EffectStage::Parse(header + "void main() { color = texture(s, uv)\n").fusable);
+    CHECK(!EffectStage::Parse(header).fusable); // no main
+}
+
+void plan() {
+    const EffectStage grayscale = EffectStage::Parse(GRAYSCALE);
+    const EffectStage vignette  = EffectStage::Parse(VIGNETTE);
+    const EffectStage tint      = EffectStage::Parse(TINT);
+    const EffectStage wave      = EffectStage::Parse(WAVE);
+    const EffectStage broken    = EffectStage::Parse("void main() { }");
+
+    auto runs = [](const std::vector<EffectFusion::Run> &plan) {
+        std::string text;
+        for (const EffectFusion::Run &run : plan)
+            text += std::to_string(run.first) + "+" + std::to_string(run.count) + " ";
+        return text;
+    };
+
+    // Point-wise effects fuse; wave needs its input in a texture, then grayscale joins it
+    CHECK(runs(EffectFusion::Plan({ &grayscale, &vignette, &tint, &wave, &grayscale }, { 1, 1, 1, 1, 1 })) == "0+3 3+2 ");
+    CHECK(runs(EffectFusion::Plan({ &wave, &wave }, { 1, 1 })) == "0+1 1+1 ");
+    CHECK(runs(EffectFusion::Plan({ &tint }, { 1 })) == "0+1 ");
+    CHECK(EffectFusion::Plan({}, {}).empty());
+
+    // A different vertex shader starts a new pass
+    CHECK(runs(EffectFusion::Plan({ &grayscale, &vignette, &tint }, { 1, 2, 2 })) == "0+1 1+2 ");
+
+    // An unfusable effect runs alone and nothing joins it
+    CHECK(runs(EffectFusion::Plan({ &grayscale, &broken, &vignette, &tint }, { 1, 1, 1, 1 })) == "0+1 1+1 2+2 ");
+}
+
+void generate() {
+    const EffectStage grayscale = EffectStage::Parse(GRAYSCALE);
+    const EffectStage vignette  = EffectStage::Parse(VIGNETTE);
+    const EffectStage tint      = EffectStage::Parse(TINT);
+    const EffectStage wave      = EffectStage::Parse(WAVE);
+
+    struct Case {
+        const char                      *name;
+        std::vector<const EffectStage *> stages;
+    };
+    const Case cases[] = {
+        { "grayscale+vignette", { &grayscale, &vignette } },
+        { "grayscale+vignette+tint", { &grayscale, &vignette, &tint } },
+        { "wave+tint+grayscale", { &wave, &tint, &grayscale } },
+    };
+    for (const Case &fused : cases) {
+        const std::string source = EffectFusion::Generate(fused.stages);
+        CHECK_MSG(!Shaders::CompileGLSL(source, GpuShaderStage::Fragment).empty(), "%s didn't compile:\n%s", fused.name, source.c_str());
+        CHECK(EffectFusion::ShaderName(source) == EffectFusion::ShaderName(EffectFusion::Generate(fused.stages)));
+    }
+
+    // Each stage's names moved apart; only the first stage samples the input
+    const std::string source = EffectFusion::Generate({ &grayscale, &vignette, &tint });
+    CHECK(contains(source, "lfx0_amount") && contains(source, "lfx1_strength") && contains(source, "lfx2_amount"));
+    CHECK(contains(source, "struct lfx2_Grade") && contains(source, "lfx2_Grade lfx2_grade;") && contains(source, "lfx2_toLinear("));
+    CHECK(contains(source, "lfx2_EPSILON") && contains(source, "#extension GL_ARB_separate_shader_objects"));
+    CHECK(contains(source, "texture(lfx_input, lfx_uv)"));
+    CHECK(contains(source, "void lfx0_main()") && contains(source, "void lfx2_main()"));
+    CHECK(!contains(source, "params.") && !contains(source, "input_texture") && !contains(source, "out_color"));
+    CHECK(EffectFusion::ShaderName(source) != EffectFusion::ShaderName(EffectFusion::Generate({ &grayscale, &vignette })));
+
+    // Uniform bytes are copied by name: MemberName must match what Generate writes
+    CHECK(EffectFusion::MemberName(1, "strength") == "lfx1_strength");
+
+    // A broken generator must not pass: the compile check itself rejects bad GLSL
+    CHECK(Shaders::CompileGLSL(source + "\nvoid main() { }\n", GpuShaderStage::Fragment).empty());
+}
+} // namespace
+
+int main() {
+    parse();
+    plan();
+    generate();
+    return TestResult("test_effectfusion");
+}
@@ -0,0 +1,223 @@
+// EventBus, typed and named. Typed: Subscribe/Emit, subscribing and unsubscribing from inside a
+// handler, Enqueue/Flush ordering, destruction of non-trivial payloads and follow-ups queued
+// during a flush; and no heap allocation once a frame of Emit, Enqueue and Flush has warmed up
+// (replaced global operator new). Named: string and SystemEvent handlers still get their data.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/eventbus/eventbus.h"
+
+#include "alloc_counter.h"
+#include "testing.h"
+
+namespace {
+// Each test uses its own event types, so handlers left subscribed by one don't see another's events
+struct Damage {
+    int   target;
+    float amount;
+};
+
+void emit() {
+    float total = 0.0f;
+    int   other = 0;
+    const SubscriptionId a = EventBus::Subscribe<Damage>([&](const Damage &e) { total += e.amount; });
+    const SubscriptionId b = EventBus::Subscribe<Damage>([&](const Damage &) { ++other; });
+    CHECK(a != b);
+
+    EventBus::Emit(Damage { 1, 2.5f });
+    EventBus::Emit(Damage { 2, 1.0f });
+    CHECK(total == 3.5f && other == 2);
+
+    EventBus::Unsubscribe(a);
+    EventBus::Unsubscribe(a); // already removed: ignored
+    EventBus::Unsubscribe(0xFFFF'0000'0001ull); // unknown type: ignored
+    EventBus::Emit(Damage { 1, 10.0f });
+    CHECK(total == 3.5f && other == 3);
+    EventBus::Unsubscribe(b);
+
+    // A type nobody subscribed to
+    struct Unheard {
+        int value;
+    };
+    EventBus::Emit(Unheard { 1 });
+}
+
+struct Hit {
+    int target;
+};
+
+void reentrancy() {
+    int            calls = 0, added = 0, later = 0;
+    SubscriptionId self = 0, next = 0;
+
+    // Unsubscribing itself and subscribing another from inside its own dispatch: the running
+    // handler finishes, the new one starts with the next event
+    self = EventBus::Subscribe<Hit>([&](const Hit &) {
+        ++calls;
+        EventBus::Unsubscribe(self);
+        next = EventBus::Subscribe<Hit>([&](const Hit &) { ++added; });
+    });
+    // A handler after it in the list still runs for this event
+    const SubscriptionId after = EventBus::Subscribe<Hit>([&](const Hit &) { ++later; });
+
+    EventBus::Emit(Hit { 1 });
+    CHECK(calls == 1 && added == 0 && later == 1);
+    EventBus::Emit(Hit { 2 });
+    CHECK(calls == 1 && added == 1 && later == 2);
+
+    // Unsubscribing a handler that hasn't run yet in this dispatch skips it
+    int            skipped = 0;
+    SubscriptionId victim  = 0;
+    EventBus::Unsubscribe(after);
+    EventBus::Unsubscribe(next);
+    const auto killer = EventBus::Subscribe<Hit>([&](const Hit &) { EventBus::Unsubscribe(victim); });
+    victim            = EventBus::Subscribe<Hit>([&](const Hit &) { ++skipped; });
+    EventBus::Emit(Hit { 3 });
+    EventBus::Emit(Hit { 4 });
+    CHECK(skipped == 0);
+    EventBus::Unsubscribe(killer);
+
+    // Emitting from inside a handler (nested dispatch of the same type)
+    int        depth = 0, deepest = 0;
+    const auto nest  = EventBus::Subscribe<Hit>([&](const Hit &e) {
+        deepest = std::max(deepest, ++depth);
+        if (e.target < 3)
+            EventBus::Emit(Hit { e.target + 1 });
+        --depth;
+    });
+    EventBus::Emit(Hit { 0 });
+    CHECK(deepest == 4 && depth == 0);
+    EventBus::Unsubscribe(nest);
+}
+
+struct Order {
+    int index;
+};
+struct Other {
+    int index;
+};
+
+// Counts live copies, so leaked or doubly destroyed payloads show up
+struct Named {
+    static inline int live = 0;
+
+    std::string name;
+    int         value;
+
+    Named(std::string n, int v) : name(std::move(n)), value(v) { ++live; }
+    Named(const Named &other) : name(other.name), value(other.value) { ++live; }
+    Named(Named &&other) noexcept : name(std::move(other.name)), value(other.value) { ++live; }
+    ~Named() { --live; }
+};
+
+void queue() {
+    std::vector<int> orders, others;
+    EventBus::Subscribe<Order>([&](const Order &e) {
+        orders.push_back(e.index);
+        if (e.index == 2)
+            EventBus::Enqueue(Order { 100 }); // during a flush: delivered by the next one
+    });
+    EventBus::Subscribe<Other>([&](const Other &e) { others.push_back(e.index); });
+
+    for (int i = 0; i < 4; ++i) {
+        EventBus::Enqueue(Order { i });
+        EventBus::Enqueue(Other { i });
+    }
+    CHECK(orders.empty() && others.empty()); // nothing until Flush
+    EventBus::Flush();
+    CHECK((orders == std::vector<int> { 0, 1, 2, 3 }));
+    CHECK((others == std::vector<int> { 0, 1, 2, 3 }));
+    EventBus::Flush();
+    CHECK((orders == std::vector<int> { 0, 1, 2, 3, 100 }));
+    EventBus::Flush(); // nothing queued
+    CHECK(orders.size() == 5);
+
+    // Non-trivial payloads survive until delivered and are destroyed exactly once, after it
+    int         sum = 0;
+    std::string last;
+    EventBus::Subscribe<Named>([&](const Named &e) {
+        sum += e.value;
+        last = e.name;
+    });
+    for (int i = 0; i < 1000; ++i)
+        EventBus::Enqueue(Named("a string long enough to live on the heap, #" + std::to_string(i), 1));
+    CHECK(Named::live == 1000);
+    EventBus::Flush();
+    CHECK(sum == 1000 && last == "a string long enough to live on the heap, #999");
+    CHECK(Named::live == 0);
+}
+
+struct Tick {
+    uint32_t frame;
+    float    dt;
+};
+struct Pickup {
+    uint32_t item;
+};
+
+void noAllocations() {
+    uint64_t ticks = 0, pickups = 0;
+    EventBus::Subscribe<Tick>([&](const Tick &) { ++ticks; });
+    EventBus::Subscribe<Pickup>([&](const Pickup &e) {
+        ++pickups;
+        if (e.item == 0)
+            EventBus::Enqueue(Tick { e.item, 0.0f }); // a follow-up for the next frame
+    });
+
+    auto frame = [](uint32_t f) {
+        for (uint32_t i = 0; i < 2000; ++i)
+            EventBus::Emit(Tick { f, 0.016f });
+        for (uint32_t i = 0; i < 3000; ++i) {
+            EventBus::Enqueue(Pickup { i });
+            EventBus::Enqueue(Tick { f, 0.016f });
+        }
+        EventBus::Flush();
+    };
+    for (uint32_t f = 0; f < 4; ++f)
+        frame(f);
+
+    ticks = pickups = 0;
+    const uint64_t before = allocations.load();
+    for (uint32_t f = 0; f < 100; ++f)
+        frame(f);
+    const uint64_t during = allocations.load() - before;
+    CHECK_MSG(during == 0, "%llu heap allocations in 100 warm frames", static_cast<unsigned long long>(during));
+    CHECK(pickups == 100 * 3000);
+    CHECK(ticks == 100 * 5001); // each frame also delivers the previous frame's follow-up
+}
+
+void named() {
+    float amount = 0.0f;
+    int   plain  = 0;
+    EventBus::Register("damage", [&](EventData data) { amount += std::get<float>(data["amount"]); });
+    EventBus::Register("reset", [&]() { ++plain; });
+
+    EventData data;
+    data.emplace("target", 3);
+    data.emplace("amount", 1.5f);
+    EventBus::Fire("damage", data);
+    EventBus::Fire("damage", data);
+    EventBus::Fire("reset");
+    CHECK(amount == 3.0f && plain == 1);
+
+    int width = 0;
+    EventBus::Register(SystemEvent::WINDOW_RESIZE, [&](EventData resize) { width = std::get<int>(resize["width"]); });
+    EventData resize;
+    resize.emplace("width", 1280);
+    resize.emplace("height", 720);
+    EventBus::Fire(SystemEvent::WINDOW_RESIZE, resize);
+    CHECK(width == 1280);
+}
+} // namespace
+
+int main() {
+    emit();
+    reentrancy();
+    queue();
+    noAllocations();
+    named();
+    return TestResult("test_eventbus");
+}
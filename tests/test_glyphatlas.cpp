@@ -0,0 +1,190 @@
+// The dynamic glyph atlas without msdfgen: a synthetic rasterizer gives every codepoint its own
+// size and pixels. SkylinePacker never overlaps rectangles, and growing it keeps them in place.
+// GlyphAtlas queues a glyph on first Find, reports it pending until Update packs it, marks
+// glyphs the font lacks (or too large for a page) missing, and gives whitespace an advance but no
+// pixels. After thousands of glyphs across grown and extra pages, every glyph's atlas bounds
+// point at exactly its own pixels, no two glyphs share a pixel, and the dirty rectangle covers
+// what was written. Destroying an atlas with glyphs still on the workers waits for them.
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "assets/font/glyphatlas.h"
+#include "assets/font/skylinepacker.h"
+#include "util/random.h"
+#include "util/threadpool.h"
+
+#include "testing.h"
+
+namespace {
+int widthOf(uint32_t codepoint) { return 20 + static_cast<int>(codepoint * 7 % 40); }
+int heightOf(uint32_t codepoint) { return 30 + static_cast<int>(codepoint * 13 % 45); }
+bool inFont(uint32_t codepoint) { return codepoint % 97 != 5; }
+
+// Pixels encode the codepoint and their index in the bitmap; atlas bounds follow msdf-atlas-gen
+// (half a pixel inside the bitmap, y up)
+bool rasterize(uint32_t codepoint, GlyphBitmap &out) {
+    if (!inFont(codepoint))
+        return false;
+    out.metrics.codepoint = codepoint;
+    out.metrics.advance   = 0.5;
+    if (codepoint == ' ')
+        return true;
+    if (codepoint == 0x2FFFF) { // larger than a page can be
+        out.width = out.height = GlyphAtlas::MAX_PAGE_SIZE + 1;
+        out.rgba.resize(static_cast<size_t>(out.width) * out.height * 4);
+        return true;
+    }
+    out.width      = widthOf(codepoint);
+    out.height     = heightOf(codepoint);
+    out.metrics.al = 0.5;
+    out.metrics.ar = out.width - 0.5;
+    out.metrics.ab = 0.5;
+    out.metrics.at = out.height - 0.5;
+    out.rgba.resize(static_cast<size_t>(out.width) * out.height * 4);
+    for (int i = 0; i < out.width * out.height; ++i) {
+        out.rgba[i * 4]     = codepoint & 0xFF;
+        out.rgba[i * 4 + 1] = (codepoint >> 8) & 0xFF;
+        out.rgba[i * 4 + 2] = i & 0xFF;
+        out.rgba[i * 4 + 3] = 255;
+    }
+    return true;
+}
+
+void packer() {
+    Rng                             rng(46);
+    SkylinePacker                   packer(64, 64);
+    std::vector<std::array<int, 4>> rects; // x, y, w, h
+    for (int i = 0; i < 2000; ++i) {
+        const int w = 1 + static_cast<int>(rng.Below(17)), h = 1 + static_cast<int>(rng.Below(17));
+        int       x, y;
+        if (packer.Pack(w, h, x, y)) {
+            rects.push_back({ x, y, w, h });
+        } else if (packer.Width() < 512) {
+            packer.Grow(packer.Width() * 2, packer.Height() * 2);
+        } else {
+            break;
+        }
+    }
+    CHECK(packer.Width() == 512 && rects.size() > 1000);
+
+    std::vector<uint8_t> used(static_cast<size_t>(packer.Width()) * packer.Height());
+    long long            area = 0, overlaps = 0, outside = 0;
+    for (const auto &[x, y, w, h] : rects) {
+        outside += x < 0 || y < 0 || x + w > packer.Width() || y + h > packer.Height();
+        for (int row = y; row < y + h; ++row)
+            for (int column = x; column < x + w; ++column)
+                overlaps += used[static_cast<size_t>(row) * packer.Width() + column]++ != 0;
+        area += static_cast<long long>(w) * h;
+    }
+    CHECK(outside == 0 && overlaps == 0);
+    CHECK(packer.UsedArea() == area);
+    CHECK_MSG(double(area) / (packer.Width() * packer.Height()) > 0.5, "occupancy %.2f", double(area) / (packer.Width() * packer.Height()));
+
+    int x, y;
+    CHECK(!packer.Pack(0, 5, x, y) && !packer.Pack(513, 1, x, y));
+}
+
+// Every ready glyph's bounds cover its own pixels and nobody else's
+int misplaced(GlyphAtlas &atlas, const std::vector<uint32_t> &codepoints) {
+    std::vector<GlyphAtlas::Page>     &pages = atlas.Pages();
+    std::vector<std::vector<uint32_t>> owner(pages.size());
+    for (size_t p = 0; p < pages.size(); ++p)
+        owner[p].assign(static_cast<size_t>(pages[p].width) * pages[p].height, 0);
+
+    int wrong = 0;
+    for (const uint32_t codepoint : codepoints) {
+        const CachedGlyph *glyph = atlas.Find(codepoint);
+        if (!inFont(codepoint) || codepoint == ' ') {
+            wrong += inFont(codepoint) ? !glyph || glyph->ar != glyph->al : glyph != nullptr || atlas.IsPending(codepoint);
+            continue;
+        }
+        if (!glyph || glyph->page < atlas.FirstPage() || glyph->page - atlas.FirstPage() >= int(pages.size())) {
+            ++wrong;
+            continue;
+        }
+        const size_t            index = glyph->page - atlas.FirstPage();
+        const GlyphAtlas::Page &page  = pages[index];
+        const int               w = widthOf(codepoint), h = heightOf(codepoint);
+        const int               x = static_cast<int>(glyph->al - 0.5);
+        const int               y = page.height - static_cast<int>(glyph->ab - 0.5) - h; // top-down
+        if (glyph->ar - glyph->al != w - 1 || glyph->at - glyph->ab != h - 1 || x < 0 || y < 0 || x + w > page.width || y + h > page.height) {
+            ++wrong;
+            continue;
+        }
+        for (int row = 0; row < h; ++row) {
+            for (int column = 0; column < w; ++column) {
+                const size_t   at = static_cast<size_t>(y + row) * page.width + x + column;
+                const uint8_t *px = &page.pixels[at * 4];
+                wrong += owner[index][at] != 0 || px[0] != (codepoint & 0xFF) || px[1] != ((codepoint >> 8) & 0xFF) || px[2] != ((row * w + column) & 0xFF);
+                owner[index][at] = codepoint;
+            }
+        }
+    }
+    return wrong;
+}
+
+void atlas() {
+    ThreadPool pool(4);
+    GlyphAtlas atlas(rasterize, pool, 1);
+
+    // First use queues; the glyph shows up after the workers are done and Update ran
+    CHECK(atlas.Find('A') == nullptr && atlas.IsPending('A'));
+    atlas.Request('A'); // already known: not queued twice
+    CHECK(atlas.GetStats().pending == 1);
+    atlas.Finish();
+    const CachedGlyph *a = atlas.Find('A');
+    CHECK(a && a->page == 1 && a->codepoint == 'A' && !atlas.IsPending('A'));
+    CHECK(atlas.Pages().size() == 1 && atlas.Pages()[0].width == GlyphAtlas::FIRST_PAGE_SIZE && atlas.Pages()[0].resized);
+
+    // Written since the last upload: just that glyph
+    GlyphAtlas::Page &first = atlas.Pages()[0];
+    CHECK(first.dirtyX1 - first.dirtyX0 == widthOf('A') && first.dirtyY1 - first.dirtyY0 == heightOf('A'));
+    first.resized = false;
+    first.dirtyX0 = first.dirtyX1 = 0;
+
+    // Whitespace, a glyph the font lacks, one too large for any page
+    atlas.Request(' ');
+    atlas.Request(5);
+    atlas.Request(0x2FFFF);
+    atlas.Finish();
+    const CachedGlyph *space = atlas.Find(' ');
+    CHECK(space && space->advance == 0.5 && space->ar == space->al);
+    CHECK(atlas.Find(5) == nullptr && !atlas.IsPending(5));
+    CHECK(atlas.Find(0x2FFFF) == nullptr && !atlas.IsPending(0x2FFFF));
+    CHECK(atlas.GetStats().missing == 2 && first.dirtyX0 >= first.dirtyX1);
+
+    // Thousands of glyphs in bursts, packed in between: pages grow to the maximum, then more open
+    std::vector<uint32_t> codepoints;
+    uint32_t              lacking = 0;
+    for (uint32_t codepoint = 0x20; codepoint < 0x20 + 3000; ++codepoint) {
+        codepoints.push_back(codepoint);
+        lacking += !inFont(codepoint);
+    }
+    for (size_t i = 0; i < codepoints.size(); ++i) {
+        atlas.Find(codepoints[i]);
+        if (i % 50 == 0)
+            atlas.Update();
+    }
+    atlas.Finish();
+
+    const GlyphAtlas::Stats stats = atlas.GetStats();
+    CHECK(stats.pending == 0 && stats.pages >= 2);
+    CHECK(stats.missing == 2 + lacking); // and 5 and 0x2FFFF
+    CHECK(stats.glyphs + stats.missing == codepoints.size() + 2);
+    CHECK(atlas.Pages()[0].width == GlyphAtlas::MAX_PAGE_SIZE && atlas.Pages()[0].resized);
+    const int wrong = misplaced(atlas, codepoints);
+    CHECK_MSG(wrong == 0, "%d glyph pixels or bounds are wrong", wrong);
+
+    // Gone with glyphs still on the workers
+    for (uint32_t codepoint = 0x10000; codepoint < 0x10400; ++codepoint)
+        atlas.Request(codepoint);
+}
+} // namespace
+
+int main() {
+    packer();
+    atlas();
+    return TestResult("test_glyphatlas");
+}
@@ -0,0 +1,216 @@
+// GPU memory accounting, driven without a device: budgets fire once per crossing (per category and
+// for the total, on growth in place too) and re-arm once usage drops back under; nested
+// GpuMemoryScopes tag allocations with the innermost category and owner, per thread, and untagged
+// ones fall back on their usage flags; wasted bytes follow SetUsed and resizes and leave with the
+// allocation; CPU staging stays out of the GPU total; texture sizes for block-compressed formats,
+// mip chains, cube maps, arrays and MSAA.
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gpu/memory/gpumemory.h"
+
+#include "testing.h"
+
+namespace {
+const GpuMemoryOwnerStats *findOwner(const GpuMemoryReport &report, const char *owner, GpuMemoryCategory category) {
+    for (const GpuMemoryOwnerStats &stats : report.owners) {
+        if (std::string(stats.owner) == owner && stats.category == category)
+            return &stats;
+    }
+    return nullptr;
+}
+
+void budgets() {
+    std::vector<GpuMemoryBudgetEvent> events;
+    GpuMemory::SetBudget(GpuMemoryCategory::ShadowMaps, 1000, [&](const GpuMemoryBudgetEvent &event) { events.push_back(event); });
+
+    GpuMemory::Track(0x100, GpuMemoryCategory::ShadowMaps, "cascades", 600);
+    GpuMemory::Track(0x101, GpuMemoryCategory::ShadowMaps, "cascades", 400);
+    CHECK(events.empty()); // exactly on budget isn't over it
+
+    GpuMemory::Track(0x102, GpuMemoryCategory::ShadowMaps, "spot lights", 500);
+    CHECK(events.size() == 1);
+    CHECK(events[0].category == GpuMemoryCategory::ShadowMaps && events[0].current == 1500 && events[0].budget == 1000);
+    CHECK(std::string(events[0].owner) == "spot lights" && events[0].bytes == 500);
+
+    // Still over: no second report until it's been back under
+    GpuMemory::Track(0x103, GpuMemoryCategory::ShadowMaps, "spot lights", 100);
+    CHECK(events.size() == 1);
+    GpuMemory::Untrack(0x102);
+    GpuMemory::Untrack(0x103);
+    CHECK(GpuMemory::GetCurrentBytes(GpuMemoryCategory::ShadowMaps) == 1000);
+
+    // Growing an allocation in place crosses too
+    GpuMemory::Track(0x101, GpuMemoryCategory::ShadowMaps, "cascades", 450);
+    CHECK(events.size() == 2 && events[1].current == 1050 && events[1].bytes == 450);
+
+    // The total budget counts every GPU category
+    const uint64_t before = GpuMemory::GetCurrentBytes();
+    GpuMemory::SetBudget(GpuMemoryCategory::Total, before + 100, [&](const GpuMemoryBudgetEvent &event) { events.push_back(event); });
+    GpuMemory::Track(0x104, GpuMemoryCategory::Meshes, "terrain", 80);
+    CHECK(events.size() == 2);
+    GpuMemory::Track(0x105, GpuMemoryCategory::Fonts, "ui", 80);
+    CHECK(events.size() == 3 && events[2].category == GpuMemoryCategory::Total && events[2].current == before + 160);
+    CHECK(std::string(events[2].owner) == "ui");
+
+    const GpuMemoryReport report = GpuMemory::GetReport();
+    CHECK(report.total.budget == before + 100);
+    for (const GpuMemoryCategoryStats &stats : report.categories) {
+        if (stats.category == GpuMemoryCategory::ShadowMaps)
+            CHECK(stats.budget == 1000 && stats.current == 1050 && stats.peak == 1600 && stats.allocations == 2);
+    }
+
+    for (uintptr_t id = 0x100; id <= 0x105; ++id)
+        GpuMemory::Untrack(id);
+    GpuMemory::SetBudget(GpuMemoryCategory::ShadowMaps, 0);
+    GpuMemory::SetBudget(GpuMemoryCategory::Total, 0);
+    CHECK(GpuMemory::GetCurrentBytes() == 0);
+}
+
+void scopes() {
+    GpuTextureCreateInfo texture;
+    texture.width  = 16;
+    texture.height = 16;
+
+    GpuTextureCreateInfo target = texture;
+    target.usage                = GpuTextureUsage::ColorTarget | GpuTextureUsage::Sampler;
+
+    GpuBufferCreateInfo vertices { 256, GpuBufferUsage::Vertex };
+    GpuBufferCreateInfo indirect { 64, GpuBufferUsage::Indirect | GpuBufferUsage::StorageWrite };
+
+    {
+        GpuMemoryScope outer(GpuMemoryCategory::Particles, "ParticlePass");
+        GpuMemory::TrackBuffer(0x200, vertices);
+        {
+            GpuMemoryScope inner(GpuMemoryCategory::ShadowMaps, std::string("Model3D") + "RenderPass"); // interned
+            CHECK(GpuMemoryScope::Current() == &inner);
+            GpuMemory::TrackTexture(0x201, target);
+
+            // Another thread isn't in any scope
+            std::thread([&] {
+                CHECK(GpuMemoryScope::Current() == nullptr);
+                GpuMemory::TrackTexture(0x202, target);
+            }).join();
+        }
+        CHECK(GpuMemoryScope::Current() == &outer);
+        GpuMemory::TrackTransferBuffer(0x203, { 128, GpuTransferUsage::Upload });
+    }
+    CHECK(GpuMemoryScope::Current() == nullptr);
+
+    // Outside any scope: by usage, under "untagged"
+    GpuMemory::TrackTexture(0x204, texture);
+    GpuMemory::TrackBuffer(0x205, vertices);
+    GpuMemory::TrackBuffer(0x206, indirect);
+    GpuMemory::TrackTransferBuffer(0x207, { 32, GpuTransferUsage::Download });
+
+    const GpuMemoryReport      report    = GpuMemory::GetReport();
+    const GpuMemoryOwnerStats *particles = findOwner(report, "ParticlePass", GpuMemoryCategory::Particles);
+    const GpuMemoryOwnerStats *shadows   = findOwner(report, "Model3DRenderPass", GpuMemoryCategory::ShadowMaps);
+    const GpuMemoryOwnerStats *targets   = findOwner(report, "untagged", GpuMemoryCategory::RenderTargets);
+    const GpuMemoryOwnerStats *textures  = findOwner(report, "untagged", GpuMemoryCategory::Textures);
+    const GpuMemoryOwnerStats *geometry  = findOwner(report, "untagged", GpuMemoryCategory::Geometry);
+    const GpuMemoryOwnerStats *compute   = findOwner(report, "untagged", GpuMemoryCategory::Compute);
+    const GpuMemoryOwnerStats *transfer  = findOwner(report, "untagged", GpuMemoryCategory::Transfer);
+    CHECK(particles && particles->allocations == 2 && particles->current == 256 + 128);
+    CHECK(shadows && shadows->allocations == 1 && shadows->current == 16 * 16 * 4);
+    CHECK(targets && targets->allocations == 1 && targets->current == 16 * 16 * 4);
+    CHECK(textures && textures->allocations == 1 && geometry && geometry->current == 256);
+    CHECK(compute && compute->current == 64 && transfer && transfer->current == 32);
+
+    // Interning gives the same owner pointer for the same name, so it's one owner entry
+    CHECK(GpuMemory::Intern("Model3DRenderPass") == shadows->owner);
+
+    for (uintptr_t id = 0x200; id <= 0x207; ++id)
+        GpuMemory::Untrack(id);
+    CHECK(GpuMemory::GetCurrentBytes() == 0);
+}
+
+void wasted() {
+    GpuMemory::Track(0x300, GpuMemoryCategory::SpriteInstances, "SpriteRenderPass", 1000);
+    CHECK(GpuMemory::GetWastedBytes(GpuMemoryCategory::SpriteInstances) == 0); // starts fully used
+
+    GpuMemory::SetUsed(0x300, 300);
+    CHECK(GpuMemory::GetWastedBytes(GpuMemoryCategory::SpriteInstances) == 700 && GpuMemory::GetWastedBytes() == 700);
+
+    // Grown: the used bytes stay, the new capacity is waste
+    GpuMemory::Track(0x300, GpuMemoryCategory::Other, "someone else", 2000);
+    CHECK(GpuMemory::GetWastedBytes(GpuMemoryCategory::SpriteInstances) == 1700);
+    CHECK(GpuMemory::GetCurrentBytes(GpuMemoryCategory::SpriteInstances) == 2000 && GpuMemory::GetCurrentBytes(GpuMemoryCategory::Other) == 0);
+
+    // Shrunk below what was used: used clamps to the size
+    GpuMemory::Track(0x300, GpuMemoryCategory::SpriteInstances, "SpriteRenderPass", 200);
+    CHECK(GpuMemory::GetWastedBytes(GpuMemoryCategory::SpriteInstances) == 0);
+    GpuMemory::SetUsed(0x300, 5000);
+    CHECK(GpuMemory::GetWastedBytes(GpuMemoryCategory::SpriteInstances) == 0);
+    GpuMemory::SetUsed(0x300, 50);
+    GpuMemory::Track(0x301, GpuMemoryCategory::SpriteInstances, "SpriteRenderPass", 100);
+    GpuMemory::SetUsed(0x301, 60);
+    GpuMemory::SetUsed(0x399, 1); // not tracked: ignored
+
+    const GpuMemoryOwnerStats *owner = findOwner(GpuMemory::GetReport(), "SpriteRenderPass", GpuMemoryCategory::SpriteInstances);
+    CHECK(owner && owner->current == 300 && owner->wasted == 150 + 40 && owner->peak == 2000 && owner->allocations == 2);
+
+    // CPU staging is counted on its own, not in the GPU total
+    GpuMemory::Track(0x302, GpuMemoryCategory::CpuStaging, "BufferManager", 4096);
+    GpuMemory::SetUsed(0x302, 1024);
+    CHECK(GpuMemory::GetWastedBytes(GpuMemoryCategory::CpuStaging) == 3072 && GpuMemory::GetWastedBytes() == 190);
+    CHECK(GpuMemory::GetCurrentBytes() == 300);
+
+    GpuMemory::Untrack(0x300);
+    GpuMemory::Untrack(0x301);
+    GpuMemory::Untrack(0x302);
+    GpuMemory::Untrack(0x302);
+    CHECK(GpuMemory::GetWastedBytes() == 0 && GpuMemory::GetWastedBytes(GpuMemoryCategory::CpuStaging) == 0);
+    CHECK(GpuMemory::GetCurrentBytes() == 0 && GpuMemory::GetPeakBytes(GpuMemoryCategory::CpuStaging) == 4096);
+}
+
+uint64_t textureBytes(uint32_t width, uint32_t height, uint32_t levels, GpuTextureFormat format,
+    GpuTextureType type = GpuTextureType::Tex2D, uint32_t layers = 1, GpuSampleCount samples = GpuSampleCount::X1) {
+    GpuTextureCreateInfo info;
+    info.width         = width;
+    info.height        = height;
+    info.numLevels     = levels;
+    info.format        = format;
+    info.type          = type;
+    info.depthOrLayers = layers;
+    info.sampleCount   = samples;
+    return GpuMemory::TextureBytes(info);
+}
+
+void textureSizes() {
+    CHECK(textureBytes(256, 256, 1, GpuTextureFormat::R8G8B8A8_Unorm) == 256 * 256 * 4);
+
+    // Full mip chain, 256 down to 1: 4 bytes * (4^9 - 1) / 3 texels
+    CHECK(textureBytes(256, 256, 9, GpuTextureFormat::R8G8B8A8_Unorm) == 4 * 87381);
+
+    // Non-square: 8x2, 4x1, 2x1, 1x1
+    CHECK(textureBytes(8, 2, 4, GpuTextureFormat::R8G8B8A8_Unorm) == 4 * (16 + 4 + 2 + 1));
+
+    // BC7 / ASTC 4x4: a byte per texel in whole 4x4 blocks, so the 2x2 and 1x1 mips still take a block
+    CHECK(textureBytes(256, 256, 9, GpuTextureFormat::BC7_Unorm) == 65536 + 16384 + 4096 + 1024 + 256 + 64 + 16 + 16 + 16);
+    CHECK(textureBytes(130, 66, 1, GpuTextureFormat::BC7_Unorm) == 132 * 68);
+    CHECK(textureBytes(130, 66, 1, GpuTextureFormat::ASTC_4x4_Unorm) == textureBytes(130, 66, 1, GpuTextureFormat::BC7_Unorm));
+    CHECK(textureBytes(1, 1, 1, GpuTextureFormat::BC7_Unorm) == 16);
+
+    // Cube faces and array layers multiply the whole chain; MSAA multiplies by samples
+    CHECK(textureBytes(64, 64, 7, GpuTextureFormat::R16G16B16A16_Float, GpuTextureType::TexCube, 6) == 6 * 8 * 5461);
+    CHECK(textureBytes(64, 64, 7, GpuTextureFormat::R16G16B16A16_Float, GpuTextureType::TexCube, 1) == 6 * 8 * 5461);
+    CHECK(textureBytes(512, 512, 1, GpuTextureFormat::D32_Float, GpuTextureType::Tex2DArray, 4) == 4 * 512 * 512 * 4);
+    CHECK(textureBytes(1280, 720, 1, GpuTextureFormat::D32_Float, GpuTextureType::Tex2D, 1, GpuSampleCount::X4) == 1280 * 720 * 4 * 4);
+    CHECK(textureBytes(64, 64, 1, GpuTextureFormat::R8_Unorm) == 4096 && textureBytes(64, 64, 1, GpuTextureFormat::R32G32B32A32_Float) == 65536);
+
+    // Zero sizes and level counts count as 1
+    CHECK(textureBytes(0, 0, 0, GpuTextureFormat::R8G8B8A8_Unorm) == 4);
+}
+} // namespace
+
+int main() {
+    budgets();
+    scopes();
+    wasted();
+    textureSizes();
+    return TestResult("test_gpumemory");
+}
@@ -0,0 +1,111 @@
+// Content hashing for cache keys: ContentHash is XXH3-128 (the canonical value for empty input)
+// and stays the same from build to build, since the font and shader caches store it on disk;
+// ContentHasher fed any split of the data, at sizes around XXH3's internal thresholds, gives the
+// one-shot hash; a flipped bit changes it. FileStamp round-trips through Serialize/Parse, rejects
+// malformed text, doesn't trust a stamp taken in the same second as the write, and stamps real
+// files by mtime and size.
+
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "util/hash.h"
+#include "util/random.h"
+
+#include "testing.h"
+
+namespace {
+void oneShot() {
+    CHECK(ContentHash::Of("", 0).ToHex() == "99aa06d3014798d86001c324468d497f"); // XXH3-128, seed 0
+    CHECK(ContentHash::Of(std::string_view()) == ContentHash::Of("", 0));
+
+    // Pinned: a change here invalidates every cache entry on players' disks
+    CHECK(ContentHash::Of("a").ToHex() == "a96faf705af16834e6c632b61e964e1f");
+    CHECK(ContentHash::Of("The quick brown fox jumps over the lazy dog").ToHex() == "ddd650205ca3e7fa24a1cc2e3a8a7651");
+    std::string ramp(1000, '\0');
+    for (size_t i = 0; i < ramp.size(); ++i)
+        ramp[i] = static_cast<char>(i * 31);
+    CHECK(ContentHash::Of(ramp).ToHex() == "62b179b903bc3a072a7a65d13a1450eb");
+
+    // ToHex: high half first, zero padded
+    const ContentHash known { 0x0123456789abcdefull, 0xfedcba9876543210ull };
+    CHECK(known.ToHex() == "fedcba98765432100123456789abcdef");
+    CHECK(ContentHash {}.ToHex() == std::string(32, '0'));
+}
+
+void streaming() {
+    Rng                  rng(47);
+    std::vector<uint8_t> data(1 << 21);
+    for (uint8_t &byte : data)
+        byte = static_cast<uint8_t>(rng.Next());
+
+    // XXH3 switches strategy at 16, 128 and 240 bytes and works in 1 KB stripes and 64 B blocks
+    int mismatches = 0;
+    for (const size_t size : { 0, 1, 3, 4, 8, 9, 16, 17, 128, 129, 240, 241, 1023, 1024, 1025, 65537, 1 << 21 }) {
+        const ContentHash expected = ContentHash::Of(data.data(), size);
+        for (int trial = 0; trial < 20; ++trial) {
+            ContentHasher hasher;
+            for (size_t at = 0; at < size;) {
+                const size_t piece = std::min<size_t>(size - at, trial == 0 ? 1 : 1 + rng.Below(5000));
+                hasher.Update(data.data() + at, piece);
+                at += piece;
+            }
+            mismatches += !(hasher.Digest() == expected);
+        }
+    }
+    CHECK_MSG(mismatches == 0, "%d streamed digests differ from one shot", mismatches);
+
+    // Digest doesn't end the stream; Reset starts over
+    ContentHasher hasher;
+    hasher.Update("abc", 3);
+    CHECK(hasher.Digest() == ContentHash::Of("abc"));
+    hasher.Update("def", 3);
+    CHECK(hasher.Digest() == ContentHash::Of("abcdef"));
+    hasher.Reset();
+    hasher.Update("xyz", 3);
+    CHECK(hasher.Digest() == ContentHash::Of("xyz"));
+
+    // Any flipped bit shows
+    const ContentHash before = ContentHash::Of(data.data(), 4096);
+    int               same   = 0;
+    for (size_t bit = 0; bit < 4096 * 8; bit += 61) {
+        data[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        same += ContentHash::Of(data.data(), 4096) == before;
+        data[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+    }
+    CHECK(same == 0);
+}
+
+void stamps() {
+    const FileStamp stamp { 1000, 42, 1005 };
+    const FileStamp parsed = FileStamp::Parse(stamp.Serialize());
+    CHECK(stamp.Serialize() == "1000:42:1005");
+    CHECK(parsed.modified == 1000 && parsed.size == 42 && parsed.taken == 1005);
+
+    CHECK(parsed.Matches({ 1000, 42, 2000 }));
+    CHECK(!parsed.Matches({ 1001, 42, 2000 }) && !parsed.Matches({ 1000, 43, 2000 }));
+    CHECK((!FileStamp { 1000, 42, 1001 }.Matches({ 1000, 42, 2000 }))); // taken as the file was written
+    CHECK(!FileStamp {}.Matches({}));
+
+    for (const char *bad : { "", "1:2", "1:2:3x", "a:2:3", "1:2:3:", "1::3", ":2:3", "1:-2:3" })
+        CHECK_MSG(!FileStamp::Parse(bad).Valid(), "\"%s\" parsed", bad);
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "lumi_test_hash.bin";
+    std::ofstream(path) << "hello";
+    const FileStamp file = FileStamp::Of(path.string());
+    std::filesystem::remove(path);
+    CHECK(file.Valid() && file.size == 5 && file.taken >= file.modified && file.taken <= std::time(nullptr));
+    CHECK(!file.Matches(file)); // just written: hash once more
+    CHECK(!FileStamp::Of(path.string()).Valid());
+}
+} // namespace
+
+int main() {
+    oneShot();
+    streaming();
+    stamps();
+    return TestResult("test_hash");
+}
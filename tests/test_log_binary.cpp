@@ -0,0 +1,115 @@
+// Binary logs round-trip: the same calls go to a FileSink and a BinaryFileSink, and
+// tools/log_decoder turns the binary file back into exactly the FileSink's lines. Covers calls
+// without arguments (escaped braces), every encoded argument type with format specs, messages too
+// long to encode that go in formatted, and a call site logged many times (one Site block). The
+// decoder's --min-level filter keeps only the matching lines, and a file cut short mid-block still
+// decodes up to the cut. The decoder's path comes from the build (LOG_DECODER).
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/log/log.h"
+
+#include "testing.h"
+
+namespace {
+const std::filesystem::path dir     = std::filesystem::temp_directory_path();
+const std::filesystem::path text    = dir / "lumi_test_log.log";
+const std::filesystem::path binary  = dir / "lumi_test_log.lumilog";
+const std::filesystem::path decoded = dir / "lumi_test_log.decoded";
+
+std::vector<std::string> readLines(const std::filesystem::path &path) {
+    std::vector<std::string> lines;
+    std::ifstream            in(path);
+    for (std::string line; std::getline(in, line);)
+        lines.push_back(line);
+    return lines;
+}
+
+// Runs log_decoder on the binary log; its text output lands in `decoded`
+int decode(const std::string &options = "") {
+    std::string command = "\"" LOG_DECODER "\" \"" + binary.string() + "\" " + options + " > \"" + decoded.string() + "\"";
+#ifdef _WIN32
+    command = "\"" + command + "\""; // cmd strips one pair of outer quotes
+#endif
+    return std::system(command.c_str());
+}
+
+void logEverything() {
+    std::filesystem::remove(text);
+    std::filesystem::remove(binary);
+    Log::ClearSinks();
+    Log::AddSink(std::make_unique<BinaryFileSink>(binary.string()));
+    Log::AddSink(std::make_unique<FileSink>(text.string())); // its "sink added" line goes to both
+
+    const std::string      name  = "player";
+    const std::string_view view  = "level_03";
+    int                    local = 0;
+    LOG_INFO("Plain message, {{braces}} kept");
+    LOG_DEBUG("ints {} {} {} {:#x} {:>6}", -5, 7u, -(int64_t(1) << 40), 255, 42);
+    LOG_INFO("floats {} {:.3f} {:e} {}", 1.5, 0.1f, 6.02e23, -0.0f);
+    LOG_INFO("misc {} {} {} {}", true, 'Z', static_cast<const void *>(&local), static_cast<const void *>(nullptr));
+    LOG_WARNING("strings '{}' '{}' '{}' '{:>10}'", "literal", name, view, std::string());
+    LOG_INFO("too long to encode: {}", std::string(LogRecord::MESSAGE_CAPACITY + 100, 'x'));
+    LOG_INFO("{}", std::string(LogRecord::MESSAGE_CAPACITY - 20, 'y')); // encodes, formats longer than a slot
+    for (int i = 0; i < 500; ++i)
+        LOG_INFO("frame {} dt {:.2f} state {}", i, 16.6f + i % 7 * 0.1f, i % 3 ? "running" : "paused");
+    LOG_WARNING("last line");
+
+    Log::FlushAll();
+    Log::ClearSinks(); // closes both files
+}
+
+void roundTrip() {
+    const std::vector<std::string> expected = readLines(text);
+    CHECK(expected.size() == 509);
+    CHECK(decode() == 0);
+    const std::vector<std::string> lines = readLines(decoded);
+
+    // The binary log also has the FileSink's "sink added" line first
+    CHECK_MSG(lines.size() == expected.size() + 1, "decoded %zu lines, FileSink wrote %zu", lines.size(), expected.size());
+    int differ = 0;
+    for (size_t i = 0; i < expected.size() && i + 1 < lines.size(); ++i) {
+        if (lines[i + 1] != expected[i] && differ++ < 3)
+            std::printf("  line %zu:\n    text:    %s\n    decoded: %s\n", i, expected[i].c_str(), lines[i + 1].c_str());
+    }
+    CHECK_MSG(differ == 0, "%d decoded lines differ from the FileSink's", differ);
+
+    // Call sites are written once and nothing is formatted: smaller than the text
+    CHECK(std::filesystem::file_size(binary) < std::filesystem::file_size(text));
+
+    CHECK(decode("--min-level warning") == 0);
+    const std::vector<std::string> warnings = readLines(decoded);
+    CHECK(warnings.size() == 2);
+    CHECK(!warnings.empty() && warnings.back().find("last line") != std::string::npos);
+}
+
+void truncated() {
+    const std::vector<std::string> full = readLines(text);
+    std::filesystem::resize_file(binary, std::filesystem::file_size(binary) * 2 / 3);
+    CHECK(decode() == 0);
+    const std::vector<std::string> lines = readLines(decoded);
+    CHECK(lines.size() > 100 && lines.size() < full.size());
+    bool prefix = true;
+    for (size_t i = 1; i < lines.size(); ++i)
+        prefix &= i - 1 < full.size() && lines[i] == full[i - 1];
+    CHECK(prefix);
+
+    std::filesystem::remove(text);
+    std::filesystem::remove(binary);
+    std::filesystem::remove(decoded);
+}
+} // namespace
+
+int main() {
+    logEverything();
+    roundTrip();
+    truncated();
+    return TestResult("test_log_binary");
+}
@@ -0,0 +1,107 @@
+// Net over a loopback endpoint: once the pool, the batches and the event lists have warmed up,
+// a tick of typed sends, coalescing, delivery and dispatch must not reach the heap. Every
+// allocation in the process is counted (replaced global operator new), so this also catches
+// allocations in the loopback transport and the PacketPool.
+//
+// Net is the client; the server is a bare loopback endpoint that echoes each packet back, so
+// the client's handlers see batched and lone messages, small and oversized.
+
+#include <cstdint>
+#include <vector>
+
+#include "platform/net/itransport.h"
+#include "platform/net/loopback.h"
+#include "platform/net/net.h"
+#include "platform/net/packetpool.h"
+
+#include "alloc_counter.h"
+#include "testing.h"
+
+namespace {
+struct Small {
+    uint32_t tick;
+    uint32_t index;
+};
+
+struct alignas(16) Transform {
+    float    position[4];
+    float    rotation[4];
+    uint32_t tick;
+};
+
+struct Snapshot {
+    uint32_t tick;
+    uint8_t  bytes[2000]; // more than one packet: travels alone
+};
+
+constexpr uint16_t PORT           = 7000;
+constexpr int      SMALL_PER_TICK = 40;
+constexpr int      WARMUP_TICKS   = 64;
+constexpr int      MEASURED_TICKS = 2000;
+
+uint64_t smallReceived = 0, transformsReceived = 0, snapshotsReceived = 0;
+
+// Server side: echo every packet to the client it came from, on the same channel
+void echo(ITransport &server, std::vector<TransportEvent> &events) {
+    events.clear();
+    server.Poll(events);
+    for (const TransportEvent &event : events)
+        if (event.type == TransportEvent::Receive)
+            server.Send(event.peer, event.data.Span(), event.channel);
+    events.clear();
+}
+
+void tick(ITransport &server, std::vector<TransportEvent> &events, uint32_t tick) {
+    for (uint32_t i = 0; i < SMALL_PER_TICK; ++i)
+        Net::Send(Net::SERVER_PEER, Small { tick, i });
+    Transform transform {};
+    transform.tick = tick;
+    Net::SendReliable(Net::SERVER_PEER, transform);
+    if (tick % 8 == 0) {
+        Snapshot snapshot {};
+        snapshot.tick = tick;
+        Net::Send(Net::SERVER_PEER, snapshot, NetChannel::ReliableUnordered);
+    }
+    Net::Update(); // flushes the sends
+    echo(server, events);
+    Net::Update(); // dispatches the echoes
+}
+} // namespace
+
+int main() {
+    LoopbackNetwork network;
+    auto            server = network.CreateEndpoint();
+    CHECK(server->Host(PORT));
+
+    Net::UseTransport(network.CreateEndpoint().release());
+    CHECK(Net::Connect("loopback", PORT));
+
+    Net::On<Small>([](Net::Peer, const Small &) { ++smallReceived; });
+    Net::On<Transform>([](Net::Peer, const Transform &) { ++transformsReceived; });
+    Net::On<Snapshot>([](Net::Peer, const Snapshot &) { ++snapshotsReceived; });
+
+    std::vector<TransportEvent> events;
+    events.reserve(64);
+    uint32_t frame = 0;
+    for (; frame < WARMUP_TICKS; ++frame)
+        tick(*server, events, frame);
+
+    smallReceived = transformsReceived = snapshotsReceived = 0;
+    const uint64_t poolMisses = PacketPool::GetStats().heapAllocations;
+    const uint64_t before     = allocations.load();
+    for (int i = 0; i < MEASURED_TICKS; ++i, ++frame)
+        tick(*server, events, frame);
+    const uint64_t during = allocations.load() - before;
+
+    CHECK_MSG(during == 0, "%llu heap allocations in %d warm ticks", static_cast<unsigned long long>(during), MEASURED_TICKS);
+    CHECK(PacketPool::GetStats().heapAllocations == poolMisses);
+    CHECK(smallReceived == uint64_t(SMALL_PER_TICK) * MEASURED_TICKS);
+    CHECK(transformsReceived == uint64_t(MEASURED_TICKS));
+    CHECK(snapshotsReceived == uint64_t(MEASURED_TICKS / 8));
+
+    // Coalescing: the small messages of a tick share packets, far fewer than one each
+    CHECK(network.GetPacketsDelivered() < uint64_t(frame) * SMALL_PER_TICK / 4);
+
+    Net::Shutdown();
+    return TestResult("test_net_alloc");
+}
@@ -0,0 +1,246 @@
+// Net's per-tick coalescing, seen from the wire: a server Net over ReliableTransport and loopback,
+// clients as bare ReliableTransports decoding the batch format themselves. Every message of a
+// tick arrives, packed into packets no larger than MaxPacketSize and far fewer than one per
+// message; Flush sends early; oversized messages travel alone without overtaking what was queued
+// before them; sends and broadcasts on one ordered channel keep call order. On the receiving side,
+// Net dispatches every record of a batch and stops cleanly at a truncated one.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "platform/net/itransport.h"
+#include "platform/net/loopback.h"
+#include "platform/net/net.h"
+#include "platform/net/reliable.h"
+
+#include "testing.h"
+
+namespace {
+constexpr uint16_t PORT = 7200;
+
+struct EntityUpdate {
+    uint32_t id;
+    float    x, y, angle;
+    uint16_t animation, flags;
+};
+struct Chat {
+    uint32_t sequence;
+};
+struct Snapshot {
+    uint32_t sequence;
+    uint8_t  bytes[3000];
+};
+
+uint64_t now = 1'000'000;
+
+// What one client saw: messages in arrival order, and the packets they came in
+struct Client {
+    std::unique_ptr<ReliableTransport> transport;
+    std::vector<uint32_t>              updates;       // EntityUpdate ids
+    std::vector<uint32_t>              ordered;       // Chat and Snapshot sequence numbers, in arrival order
+    uint32_t                           packets   = 0;
+    uint32_t                           largest   = 0; // bytes, unreliable packets only
+    bool                               malformed = false;
+
+    void Record(uint32_t typeId, const uint8_t *payload, uint32_t size) {
+        uint32_t value;
+        std::memcpy(&value, payload, sizeof(value));
+        if (typeId == Net::MessageId<EntityUpdate>() && size == sizeof(EntityUpdate))
+            updates.push_back(value);
+        else if ((typeId == Net::MessageId<Chat>() && size == sizeof(Chat)) || (typeId == Net::MessageId<Snapshot>() && size == sizeof(Snapshot)))
+            ordered.push_back(value);
+        else
+            malformed = true;
+    }
+
+    // Splits a packet the way Net's receive path does
+    void Decode(const TransportEvent &event) {
+        const uint8_t *data = event.data.Data();
+        const uint32_t size = event.data.Size();
+        ++packets;
+        if (event.channel == NetChannel::Unreliable)
+            largest = std::max(largest, size);
+
+        uint32_t typeId;
+        std::memcpy(&typeId, data, sizeof(typeId));
+        if (typeId != 0) {
+            Record(typeId, data + 4, size - 4);
+            return;
+        }
+        for (uint32_t offset = 4; offset < size;) {
+            uint32_t recordSize;
+            std::memcpy(&recordSize, data + offset, 4);
+            std::memcpy(&typeId, data + offset + 4, 4);
+            offset += 8;
+            malformed |= recordSize > size - offset;
+            if (malformed)
+                return;
+            Record(typeId, data + offset, recordSize);
+            offset = (offset + recordSize + 3) & ~3u;
+        }
+    }
+};
+
+struct Session {
+    LoopbackNetwork             network;
+    std::vector<Client>         clients;
+    std::vector<TransportEvent> events;
+
+    explicit Session(int count) {
+        auto *server = new ReliableTransport(network.CreateEndpoint());
+        server->SetClock([] { return now; });
+        Net::UseTransport(server);
+        CHECK(Net::Host(PORT));
+        for (int i = 0; i < count; ++i) {
+            Client client;
+            client.transport = std::make_unique<ReliableTransport>(network.CreateEndpoint());
+            client.transport->SetClock([] { return now; });
+            CHECK(client.transport->Connect("loopback", PORT));
+            clients.push_back(std::move(client));
+        }
+        for (int i = 0; i < 10 && Net::GetPeerCount() < uint32_t(count); ++i)
+            Tick();
+        CHECK(Net::GetPeerCount() == uint32_t(count));
+        for (Client &client : clients)
+            client.packets = 0;
+    }
+    ~Session() { Net::Shutdown(); }
+
+    void Poll() {
+        for (Client &client : clients) {
+            events.clear();
+            client.transport->Poll(events);
+            for (const TransportEvent &event : events)
+                if (event.type == TransportEvent::Receive)
+                    client.Decode(event);
+        }
+        events.clear();
+    }
+
+    void Tick() {
+        Net::Update();
+        Poll();
+        now += 16'667;
+    }
+};
+
+void coalescing() {
+    constexpr int CLIENTS = 4, UPDATES = 200, TICKS = 50;
+    Session       session(CLIENTS);
+
+    const uint64_t before = session.network.GetPacketsDelivered();
+    for (int tick = 0; tick < TICKS; ++tick) {
+        for (uint32_t id = 0; id < UPDATES; ++id)
+            Net::Broadcast(EntityUpdate { id, 1.0f, 2.0f, 3.0f, 4, 5 });
+        Net::BroadcastReliable(Chat { uint32_t(tick) });
+        session.Tick();
+    }
+    for (int i = 0; i < 10; ++i)
+        session.Tick();
+
+    // 200 x 32-byte records: 6400 bytes, six packets of at most MaxPacketSize per client and tick
+    const uint32_t limit = ReliableTransport::SINGLE_SIZE; // its MaxPacketSize
+    for (const Client &client : session.clients) {
+        CHECK(!client.malformed);
+        CHECK(client.updates.size() == size_t(UPDATES) * TICKS);
+        for (size_t i = 0; i < client.updates.size(); ++i)
+            CHECK(client.updates[i] == i % UPDATES); // in send order: loopback doesn't reorder
+        CHECK(client.ordered.size() == size_t(TICKS));
+        CHECK(client.largest <= limit && client.largest > limit - 64);
+        CHECK_MSG(client.packets <= uint32_t(TICKS) * 8, "%u packets for %d ticks", client.packets, TICKS);
+    }
+    // Datagrams both ways (updates, chats, acks): a small fraction of one per message
+    const uint64_t datagrams = session.network.GetPacketsDelivered() - before;
+    CHECK_MSG(datagrams < uint64_t(CLIENTS) * TICKS * 12, "%llu datagrams", static_cast<unsigned long long>(datagrams));
+
+    // Flush sends what's queued without waiting for Update
+    const uint32_t packets = session.clients[0].packets;
+    Net::Broadcast(EntityUpdate { 7, 0.0f, 0.0f, 0.0f, 0, 0 });
+    Net::Broadcast(EntityUpdate { 8, 0.0f, 0.0f, 0.0f, 0, 0 });
+    Net::Flush();
+    session.Poll();
+    CHECK(session.clients[0].packets == packets + 1 && session.clients[0].updates.back() == 8);
+}
+
+void ordering() {
+    Session session(2);
+
+    // Small, oversized and small again on the ordered channel: the snapshot goes out alone
+    // but after the chat queued before it
+    uint32_t sequence = 0;
+    Snapshot snapshot {};
+    for (int tick = 0; tick < 20; ++tick) {
+        for (int k = 0; k < 7; ++k) {
+            if (k == 3) {
+                snapshot.sequence = sequence++;
+                Net::BroadcastReliable(snapshot);
+            } else if ((k + tick) % 3 == 0) {
+                Net::BroadcastReliable(Chat { sequence++ });
+            } else {
+                // Unicast to each client in turn: the same sequence number, once per peer
+                for (Net::Peer peer = 1; peer <= 2; ++peer)
+                    Net::SendReliable(peer, Chat { sequence });
+                ++sequence;
+            }
+        }
+        session.Tick();
+    }
+    for (int i = 0; i < 10; ++i)
+        session.Tick();
+
+    for (const Client &client : session.clients) {
+        CHECK(!client.malformed);
+        CHECK(client.ordered.size() == sequence);
+        for (uint32_t i = 0; i < client.ordered.size(); ++i)
+            CHECK_MSG(client.ordered[i] == i, "message %u arrived as #%u", client.ordered[i], i);
+    }
+}
+
+void receiving() {
+    // Net as the client; the server a bare endpoint sending hand-built batches
+    LoopbackNetwork network;
+    auto            server = network.CreateEndpoint();
+    CHECK(server->Host(PORT));
+    Net::UseTransport(network.CreateEndpoint().release());
+    CHECK(Net::Connect("loopback", PORT));
+
+    std::vector<uint32_t> chats;
+    Net::On<Chat>([&](Net::Peer, const Chat &chat) { chats.push_back(chat.sequence); });
+    std::vector<TransportEvent> events;
+    server->Poll(events);
+    Net::Update();
+
+    // [0] then three records of [size 4][Chat id][sequence]
+    const uint32_t zero = 0, four = 4, id = Net::MessageId<Chat>();
+    uint8_t        batch[4 + 3 * 12];
+    std::memcpy(batch, &zero, 4);
+    for (uint32_t i = 0; i < 3; ++i) {
+        std::memcpy(batch + 4 + i * 12, &four, 4);
+        std::memcpy(batch + 8 + i * 12, &id, 4);
+        std::memcpy(batch + 12 + i * 12, &i, 4);
+    }
+    server->Broadcast(batch, NetChannel::Unreliable);
+    Net::Update();
+    CHECK((chats == std::vector<uint32_t> { 0, 1, 2 }));
+
+    // The last record claims more bytes than the packet has: the ones before it still dispatch
+    const uint32_t tooLong = 100;
+    std::memcpy(batch + 4 + 2 * 12, &tooLong, 4);
+    chats.clear();
+    server->Broadcast(batch, NetChannel::Unreliable);
+    Net::Update();
+    CHECK((chats == std::vector<uint32_t> { 0, 1 }));
+
+    Net::Shutdown();
+}
+} // namespace
+
+int main() {
+    coalescing();
+    ordering();
+    receiving();
+    return TestResult("test_net_batching");
+}
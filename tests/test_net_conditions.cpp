@@ -0,0 +1,497 @@
+// ImpairedTransport and ReliableTransport under simulated loss, duplication, reordering and
+// latency, over loopback endpoints on a hand-driven clock. Every scenario has a fixed seed, so
+// the runs (and the statistical bounds, all several standard deviations wide) are deterministic.
+//
+// First the impairment layer on its own: the rates it applies, that unreliable packets are the
+// only ones it drops, copies or reorders, that a seed replays the same run, and that what was
+// sent before a disconnect still goes out (ReliableTransport's goodbye rides on that). Then the
+// reliability layer on top of an impaired link in both directions: every reliable message
+// arrives once (in order on the ordered channel, reassembled when fragmented), and the
+// sequenced channel never goes backwards. Last, the counts CollectStats reports (Net::GetStats
+// turns them into rates): lost packets, resends and round-trip histograms under a fixed loss
+// rate, and a late ack taking back a loss already counted.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "platform/net/impairment.h"
+#include "platform/net/itransport.h"
+#include "platform/net/loopback.h"
+#include "platform/net/reliable.h"
+
+#include "testing.h"
+
+namespace {
+constexpr uint16_t PORT = 7100;
+
+uint64_t now = 0; // microseconds, the clock of every transport below
+
+uint32_t indexOf(const TransportEvent &event) {
+    uint32_t index;
+    std::memcpy(&index, event.data.Data(), sizeof(index));
+    return index;
+}
+
+// ── Impairment layer ─────────────────────────────────────────────────────────
+
+struct Run {
+    std::vector<uint32_t>    received; // packet indices in arrival order
+    ImpairedTransport::Stats stats;
+};
+
+// Sends `count` numbered packets from an impaired client to a plain server, one per millisecond,
+// then lets a second pass for anything held back
+Run send(const NetConditions &conditions, uint32_t count, NetChannel channel) {
+    LoopbackNetwork network;
+    auto            server = network.CreateEndpoint();
+    CHECK(server->Host(PORT));
+
+    ImpairedTransport client(network.CreateEndpoint());
+    client.SetClock([] { return now; });
+    client.SetConditions(conditions, {});
+    CHECK(client.Connect("loopback", PORT));
+
+    Run                         run;
+    std::vector<TransportEvent> events;
+    auto                        poll = [&] {
+        events.clear();
+        client.Poll(events);
+        events.clear();
+        server->Poll(events);
+        for (const TransportEvent &event : events)
+            if (event.type == TransportEvent::Receive)
+                run.received.push_back(indexOf(event));
+    };
+
+    now = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        client.Send(Net::SERVER_PEER, { reinterpret_cast<const uint8_t *>(&i), sizeof(i) }, channel);
+        poll();
+        now += 1000;
+    }
+    now += 1'000'000;
+    poll();
+
+    run.stats = client.GetStats();
+    CHECK(run.stats.queued == 0);
+    return run;
+}
+
+// How many times each index arrived
+std::vector<uint32_t> histogram(const Run &run, uint32_t count) {
+    std::vector<uint32_t> times(count, 0);
+    for (const uint32_t index : run.received)
+        if (index < count)
+            ++times[index];
+    return times;
+}
+
+void within(double value, double expected, double tolerance, const char *what) {
+    CHECK_MSG(std::abs(value - expected) <= tolerance, "%s: %f, expected %f +- %f", what, value, expected, tolerance);
+}
+
+void loss() {
+    constexpr uint32_t COUNT = 20000;
+    NetConditions      conditions;
+    conditions.loss = 0.25f;
+    conditions.seed = 0x10557;
+
+    const Run run = send(conditions, COUNT, NetChannel::Unreliable);
+    CHECK(run.stats.dropped + run.received.size() == COUNT);
+    CHECK(run.stats.duplicated == 0 && run.stats.reordered == 0);
+    within(static_cast<double>(run.stats.dropped) / COUNT, 0.25, 0.02, "loss rate");
+    CHECK(std::is_sorted(run.received.begin(), run.received.end())); // no reordering asked for
+    CHECK(std::adjacent_find(run.received.begin(), run.received.end()) == run.received.end());
+
+    // The same seed drops the same packets; another seed doesn't
+    CHECK(send(conditions, COUNT, NetChannel::Unreliable).received == run.received);
+    conditions.seed = 0x10558;
+    CHECK(send(conditions, COUNT, NetChannel::Unreliable).received != run.received);
+}
+
+void duplication() {
+    constexpr uint32_t COUNT = 20000;
+    NetConditions      conditions;
+    conditions.duplicate = 0.1f;
+    conditions.seed      = 0xd0b1e;
+
+    const Run run = send(conditions, COUNT, NetChannel::Unreliable);
+    CHECK(run.received.size() == COUNT + run.stats.duplicated);
+    within(static_cast<double>(run.stats.duplicated) / COUNT, 0.1, 0.015, "duplication rate");
+    for (const uint32_t times : histogram(run, COUNT))
+        CHECK(times == 1 || times == 2);
+}
+
+void reordering() {
+    constexpr uint32_t COUNT = 20000;
+    NetConditions      conditions;
+    conditions.reorder        = 0.2f;
+    conditions.reorderDelayMs = 20.0f;
+    conditions.seed           = 0x5e0de5;
+
+    const Run run = send(conditions, COUNT, NetChannel::Unreliable);
+    CHECK(run.received.size() == COUNT);
+    within(static_cast<double>(run.stats.reordered) / COUNT, 0.2, 0.02, "reorder rate");
+    for (const uint32_t times : histogram(run, COUNT))
+        CHECK(times == 1);
+
+    // A held-back packet arrives behind the ~20 sent during its 20 ms delay, never further back
+    uint32_t late = 0, maxDistance = 0;
+    for (size_t position = 0; position < run.received.size(); ++position) {
+        const uint32_t index = run.received[position];
+        if (position > index) {
+            ++late;
+            maxDistance = std::max(maxDistance, static_cast<uint32_t>(position - index));
+        }
+    }
+    CHECK(late > 0);
+    CHECK(maxDistance <= 21);
+}
+
+void latency() {
+    NetConditions conditions;
+    conditions.latencyMs = 50.0f;
+    conditions.jitterMs  = 10.0f;
+    conditions.seed      = 0x1a7;
+
+    LoopbackNetwork network;
+    auto            server = network.CreateEndpoint();
+    CHECK(server->Host(PORT));
+    ImpairedTransport client(network.CreateEndpoint());
+    client.SetClock([] { return now; });
+    client.SetConditions(conditions, {});
+    CHECK(client.Connect("loopback", PORT));
+
+    std::vector<TransportEvent> events;
+    server->Poll(events); // the connect
+    events.clear();
+
+    now                 = 0;
+    const uint32_t zero = 0;
+    client.Send(Net::SERVER_PEER, { reinterpret_cast<const uint8_t *>(&zero), sizeof(zero) }, NetChannel::Unreliable);
+    for (; now < 49'000; now += 1000) {
+        client.Poll(events);
+        server->Poll(events);
+    }
+    CHECK(events.empty());
+    for (; now <= 60'000; now += 1000) {
+        client.Poll(events);
+        server->Poll(events);
+    }
+    CHECK(events.size() == 1);
+}
+
+// Packets still held back when the link disconnects go out first, ahead of the disconnect
+void disconnectFlushes() {
+    NetConditions conditions;
+    conditions.latencyMs = 40.0f;
+    conditions.seed      = 0xd15c;
+
+    LoopbackNetwork network;
+    auto            server = network.CreateEndpoint();
+    CHECK(server->Host(PORT));
+    ImpairedTransport client(network.CreateEndpoint());
+    client.SetClock([] { return now; });
+    client.SetConditions(conditions, {});
+    CHECK(client.Connect("loopback", PORT));
+
+    std::vector<TransportEvent> events;
+    server->Poll(events); // the connect
+    events.clear();
+
+    now = 0;
+    for (uint32_t i = 0; i < 3; ++i)
+        client.Send(Net::SERVER_PEER, { reinterpret_cast<const uint8_t *>(&i), sizeof(i) }, NetChannel::Unreliable);
+    client.Disconnect();
+    server->Poll(events);
+    CHECK(events.size() == 4 && events[3].type == TransportEvent::Disconnect);
+    for (uint32_t i = 0; i < 3 && i < events.size(); ++i)
+        CHECK(events[i].type == TransportEvent::Receive && indexOf(events[i]) == i);
+    CHECK(client.GetStats().queued == 0);
+}
+
+// Loss, duplication and reordering leave reliable packets alone: once each, in order
+void reliablePassThrough() {
+    constexpr uint32_t COUNT = 5000;
+    NetConditions      conditions;
+    conditions.loss      = 0.3f;
+    conditions.duplicate = 0.3f;
+    conditions.reorder   = 0.3f;
+    conditions.jitterMs  = 10.0f;
+    conditions.seed      = 0x5afe;
+
+    const Run run = send(conditions, COUNT, NetChannel::ReliableOrdered);
+    CHECK(run.stats.dropped == 0 && run.stats.duplicated == 0 && run.stats.reordered == 0);
+    CHECK(run.received.size() == COUNT);
+    CHECK(std::is_sorted(run.received.begin(), run.received.end()));
+    CHECK(std::adjacent_find(run.received.begin(), run.received.end()) == run.received.end());
+}
+
+// ── Reliability layer over an impaired link ──────────────────────────────────
+
+void reliableOverImpairedLink() {
+    constexpr uint32_t ORDERED = 2000, UNORDERED = 200, SEQUENCED = 2000;
+    constexpr uint32_t LARGE   = 3000; // unordered messages: three fragments each
+
+    // Per direction and side, so a datagram crosses two of these. No jitter: it reorders nearly
+    // every packet of a burst, and most of them then land outside the 33-packet ack range
+    NetConditions conditions;
+    conditions.loss      = 0.1f;
+    conditions.duplicate = 0.1f;
+    conditions.reorder   = 0.1f;
+    conditions.latencyMs = 30.0f;
+
+    LoopbackNetwork   network;
+    ReliableTransport server(network.CreateEndpoint());
+    ReliableTransport client(network.CreateEndpoint());
+    for (ReliableTransport *side : { &server, &client }) {
+        side->SetClock([] { return now; });
+        side->Impair().SetClock([] { return now; });
+        conditions.seed += 0x9e37; // a different stream per side and direction
+        NetConditions receive = conditions;
+        receive.seed += 1;
+        side->Impair().SetConditions(conditions, receive);
+    }
+
+    now = 1'000'000;
+    CHECK(server.Host(PORT));
+    CHECK(client.Connect("loopback", PORT));
+
+    std::vector<uint32_t>       ordered, unordered, sequenced;
+    bool                        corrupt = false;
+    std::vector<TransportEvent> events;
+    auto                        tick    = [&] {
+        events.clear();
+        client.Poll(events);
+        events.clear();
+        server.Poll(events);
+        for (const TransportEvent &event : events) {
+            if (event.type != TransportEvent::Receive)
+                continue;
+            const uint32_t index = indexOf(event);
+            switch (event.channel) {
+            case NetChannel::ReliableOrdered:
+                ordered.push_back(index);
+                break;
+            case NetChannel::ReliableUnordered:
+                unordered.push_back(index);
+                corrupt |= event.data.Size() != LARGE;
+                for (uint32_t i = sizeof(uint32_t); i < event.data.Size() && !corrupt; ++i)
+                    corrupt |= event.data.Data()[i] != static_cast<uint8_t>(index + i);
+                break;
+            case NetChannel::UnreliableSequenced:
+                sequenced.push_back(index);
+                break;
+            default:
+                break;
+            }
+        }
+        now += 5000;
+    };
+
+    for (int i = 0; i < 1000 && (server.PeerCount() == 0 || client.PeerCount() == 0); ++i)
+        tick();
+    CHECK(server.PeerCount() == 1 && client.PeerCount() == 1);
+
+    std::vector<uint8_t> large(LARGE);
+    for (uint32_t i = 0; i < SEQUENCED; ++i) {
+        client.Send(Net::SERVER_PEER, { reinterpret_cast<const uint8_t *>(&i), sizeof(i) }, NetChannel::ReliableOrdered);
+        client.Send(Net::SERVER_PEER, { reinterpret_cast<const uint8_t *>(&i), sizeof(i) }, NetChannel::UnreliableSequenced);
+        if (i < UNORDERED) {
+            std::memcpy(large.data(), &i, sizeof(i));
+            for (uint32_t b = sizeof(uint32_t); b < LARGE; ++b)
+                large[b] = static_cast<uint8_t>(i + b);
+            client.Send(Net::SERVER_PEER, large, NetChannel::ReliableUnordered);
+        }
+        tick();
+    }
+    // Up to a simulated minute for the resends to get through
+    for (int i = 0; i < 12000 && (ordered.size() < ORDERED || unordered.size() < UNORDERED); ++i)
+        tick();
+
+    CHECK(ordered.size() == ORDERED);
+    for (uint32_t i = 0; i < ordered.size(); ++i)
+        CHECK_MSG(ordered[i] == i, "ordered message %u arrived as #%u", ordered[i], i);
+
+    std::sort(unordered.begin(), unordered.end());
+    CHECK(unordered.size() == UNORDERED);
+    for (uint32_t i = 0; i < unordered.size(); ++i)
+        CHECK(unordered[i] == i);
+    CHECK(!corrupt);
+
+    // Sequenced: lost messages are gone, but what arrives only ever moves forward
+    CHECK(std::adjacent_find(sequenced.begin(), sequenced.end(), std::greater_equal<>()) == sequenced.end());
+    CHECK(sequenced.size() > SEQUENCED / 2 && sequenced.size() < SEQUENCED);
+
+    std::vector<NetPeerStats> stats;
+    client.CollectStats(stats);
+    CHECK(stats.size() == 1 && stats[0].resends > 0 && stats[0].packetsLost > 0);
+    CHECK(client.Impair().GetStats().dropped > 0 && server.Impair().GetStats().dropped > 0);
+}
+
+
+// ── Statistics ───────────────────────────────────────────────────────────────
+
+// A connected ReliableTransport pair on the hand-driven clock, 5 ms per tick
+struct Pair {
+    LoopbackNetwork   network;
+    ReliableTransport server { network.CreateEndpoint() };
+    ReliableTransport client { network.CreateEndpoint() };
+
+    std::vector<TransportEvent> events;
+
+    Pair() {
+        for (ReliableTransport *side : { &server, &client }) {
+            side->SetClock([] { return now; });
+            side->Impair().SetClock([] { return now; });
+        }
+        condition(0.0f);
+        now = 1'000'000;
+        CHECK(server.Host(PORT));
+        CHECK(client.Connect("loopback", PORT));
+        for (int i = 0; i < 100 && client.PeerCount() == 0; ++i)
+            tick();
+        CHECK(client.PeerCount() == 1 && server.PeerCount() == 1);
+
+        // A clean run-in, so the numbers below start from a settled round-trip time
+        for (int i = 0; i < 40; ++i) {
+            send(NetChannel::ReliableOrdered);
+            tick();
+        }
+        for (int i = 0; i < 40; ++i)
+            tick();
+    }
+
+    // 20 ms each way (or the given latency from the server), and the client loses `clientLoss` of what it sends
+    void condition(float clientLoss, float serverLatencyMs = 20.0f) {
+        NetConditions up;
+        up.latencyMs = 20.0f;
+        up.loss      = clientLoss;
+        up.seed      = 0x57a7;
+        client.Impair().SetConditions(up, {});
+
+        NetConditions down;
+        down.latencyMs = serverLatencyMs;
+        down.seed      = 0x57a8;
+        server.Impair().SetConditions(down, {});
+    }
+
+    void tick() {
+        events.clear();
+        client.Poll(events);
+        server.Poll(events);
+        now += 5000;
+    }
+
+    void send(NetChannel channel) {
+        const uint32_t index = 0;
+        client.Send(Net::SERVER_PEER, { reinterpret_cast<const uint8_t *>(&index), sizeof(index) }, channel);
+    }
+
+    NetPeerStats stats() const {
+        std::vector<NetPeerStats> stats;
+        client.CollectStats(stats);
+        return stats.size() == 1 ? stats[0] : NetPeerStats {};
+    }
+};
+
+uint32_t samplesFrom(const NetHistogram &histogram, uint32_t bucket) {
+    uint32_t count = 0;
+    for (; bucket < NetHistogram::BUCKETS; ++bucket)
+        count += histogram.counts[bucket];
+    return count;
+}
+
+// The client loses 20% of what it sends; the server's acks all arrive. Every dropped packet is
+// then exactly one lost packet and one resend, every other one an acked packet and a round-trip
+// sample, and all of the samples sit in the 32-64 ms bucket
+void statsUnderLoss() {
+    constexpr uint32_t MESSAGES = 1000, TAIL = 40;
+
+    Pair               pair;
+    const NetPeerStats before  = pair.stats();
+    const uint64_t     dropped = pair.client.Impair().GetStats().dropped;
+    CHECK(before.packetsLost == 0 && before.resends == 0 && dropped == 0);
+
+    pair.condition(0.2f);
+    for (uint32_t i = 0; i < MESSAGES; ++i) {
+        pair.send(NetChannel::ReliableOrdered);
+        pair.tick();
+    }
+    // Clean again, and enough traffic after the last loss for every packet to be resolved
+    pair.condition(0.0f);
+    for (uint32_t i = 0; i < TAIL; ++i) {
+        pair.send(NetChannel::ReliableOrdered);
+        pair.tick();
+    }
+    for (int i = 0; i < 2000 && pair.stats().inFlight > 0; ++i)
+        pair.tick();
+
+    const NetPeerStats after = pair.stats();
+    const uint64_t     lost  = pair.client.Impair().GetStats().dropped - dropped;
+    const uint64_t     acked = after.packetsAcked - before.packetsAcked;
+    const uint64_t     sent  = after.traffic.out.count - before.traffic.out.count;
+    within(static_cast<double>(lost) / static_cast<double>(sent), 0.2, 0.04, "share of the client's packets dropped");
+    CHECK_MSG(after.packetsLost == lost && after.resends == lost, "%llu dropped, %llu counted lost, %llu resent",
+        static_cast<unsigned long long>(lost), static_cast<unsigned long long>(after.packetsLost),
+        static_cast<unsigned long long>(after.resends));
+    CHECK(acked == MESSAGES + TAIL && after.inFlight == 0);
+
+    // One round-trip sample per acked packet: 40-50 ms with the ticks, so all in [32, 64) ms,
+    // and the smoothed time they're compared against never strays by a millisecond
+    CHECK(after.rtt.Total() - before.rtt.Total() == acked && after.rtt.counts[6] - before.rtt.counts[6] == acked);
+    CHECK(after.jitter.Total() - before.jitter.Total() == acked && after.jitter.counts[0] - before.jitter.counts[0] == acked);
+    CHECK(after.rttMs >= 40 && after.rttMs <= 50);
+}
+
+// The server's acks for a burst are held back long enough for a later, faster ack to move 33
+// packets past them: those packets count as lost, until the held acks land and take it back
+void stragglerAck() {
+    constexpr uint32_t BURST = 40;
+
+    Pair               pair;
+    const NetPeerStats before = pair.stats();
+
+    // All in one tick, so the server has taken them in before any of its acks gets through
+    pair.condition(0.0f, 500.0f);
+    for (uint32_t i = 0; i < BURST; ++i)
+        pair.send(NetChannel::Unreliable);
+    for (int i = 0; i < 10; ++i)
+        pair.tick();
+
+    // One more packet, acked on the fast path: that ack reaches 32 back, the burst's first 8 are older
+    pair.condition(0.0f);
+    pair.send(NetChannel::Unreliable);
+    for (int i = 0; i < 20; ++i)
+        pair.tick();
+    const NetPeerStats overtaken = pair.stats();
+
+    for (int i = 0; i < 120; ++i)
+        pair.tick();
+    const NetPeerStats after = pair.stats();
+    CHECK(overtaken.packetsLost - before.packetsLost == 8); // the burst's first 8 fell out of the ack range
+    CHECK(overtaken.packetsAcked - before.packetsAcked == BURST + 1 - 8);
+
+    // The held acks arrive 500 ms late: the 8 were delivered after all, with slow round trips
+    CHECK(after.packetsLost == before.packetsLost);
+    CHECK(after.packetsAcked - overtaken.packetsAcked >= 8);
+    CHECK(samplesFrom(after.rtt, 10) - samplesFrom(before.rtt, 10) == 8); // 512 ms and up
+}
+} // namespace
+
+int main() {
+    loss();
+    duplication();
+    reordering();
+    latency();
+    disconnectFlushes();
+    reliablePassThrough();
+    reliableOverImpairedLink();
+    statsUnderLoss();
+    stragglerAck();
+    return TestResult("test_net_conditions");
+}
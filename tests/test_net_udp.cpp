@@ -0,0 +1,147 @@
+// The native transport for real: this executable hosts a server on a localhost UDP port and runs
+// itself again as the client, so two processes talk through SdlUdpTransport under
+// ReliableTransport, with 20% simulated loss on everything either side sends. Numbered reliable
+// messages come back echoed exactly once and in order, a 20 KB message is fragmented, reassembled
+// and echoed intact, and the client's handshake, ping and goodbye all go through the socket.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "platform/net/net.h"
+
+#include "testing.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr uint16_t PORT     = 7300; // the first free one from here up is used
+constexpr uint32_t MESSAGES = 400, BIG = 20000;
+
+struct Numbered {
+    uint32_t index;
+    uint32_t check;
+};
+
+struct BigTag;
+constexpr uint32_t BIG_ID = Net::MessageId<BigTag>();
+
+std::vector<uint8_t> bigMessage() {
+    std::vector<uint8_t> bytes(BIG);
+    for (uint32_t i = 0; i < BIG; ++i)
+        bytes[i] = static_cast<uint8_t>(i * 131 + (i >> 8));
+    return bytes;
+}
+
+NetConditions lossy(uint64_t seed) {
+    NetConditions conditions;
+    conditions.loss = 0.2f;
+    conditions.seed = seed;
+    return conditions;
+}
+
+void tick() {
+    Net::Update();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+int client(uint16_t port) {
+    Net::SetConditions(lossy(2));
+    CHECK(Net::Connect("127.0.0.1", port));
+
+    const Clock::time_point start = Clock::now();
+    while (Net::GetPeerCount() == 0 && Clock::now() - start < std::chrono::seconds(5))
+        tick();
+    CHECK_MSG(Net::IsClient() && Net::GetPeerCount() == 1, "no handshake with the server on port %u", port);
+
+    uint32_t echoed = 0, outOfOrder = 0;
+    bool     bigEchoed = false;
+    Net::On<Numbered>([&](Net::Peer peer, const Numbered &message) {
+        outOfOrder += peer != Net::SERVER_PEER || message.index != echoed || message.check != ~message.index;
+        ++echoed;
+    });
+    const std::vector<uint8_t> big = bigMessage();
+    Net::OnBytes(BIG_ID, [&](Net::Peer, std::span<const uint8_t> bytes) {
+        CHECK(!bigEchoed && std::vector<uint8_t>(bytes.begin(), bytes.end()) == big);
+        bigEchoed = true;
+    });
+
+    Net::SendBytes(Net::SERVER_PEER, BIG_ID, big, NetChannel::ReliableOrdered);
+    uint32_t sent = 0;
+    while ((echoed < MESSAGES || !bigEchoed) && Clock::now() - start < std::chrono::seconds(30)) {
+        for (int i = 0; i < 8 && sent < MESSAGES; ++i, ++sent)
+            Net::SendReliable(Net::SERVER_PEER, Numbered { sent, ~sent });
+        tick();
+    }
+    CHECK_MSG(echoed == MESSAGES && outOfOrder == 0, "%u of %u echoes, %u out of order", echoed, MESSAGES, outOfOrder);
+    CHECK(bigEchoed);
+    CHECK(Net::GetPing(Net::SERVER_PEER) > 0);
+
+    Net::SetConditions({}); // so the goodbye isn't dropped
+    Net::Disconnect();
+    Net::Shutdown();
+    return TestResult("test_net_udp (client)");
+}
+
+int server(const std::string &self) {
+    CHECK(Net::Init());
+    Net::SetConditions(lossy(1));
+    uint16_t port = 0;
+    for (uint16_t candidate = PORT; candidate < PORT + 32 && !port; ++candidate)
+        port = Net::Host(candidate) ? candidate : 0;
+    CHECK(port != 0 && Net::IsServer());
+    if (!port)
+        return TestResult("test_net_udp");
+
+    uint32_t received = 0, outOfOrder = 0, peers = 0;
+    bool     bigReceived = false;
+    Net::On<Numbered>([&](Net::Peer peer, const Numbered &message) {
+        outOfOrder += message.index != received || message.check != ~message.index;
+        ++received;
+        Net::SendReliable(peer, message);
+    });
+    const std::vector<uint8_t> big = bigMessage();
+    Net::OnBytes(BIG_ID, [&](Net::Peer peer, std::span<const uint8_t> bytes) {
+        bigReceived = std::vector<uint8_t>(bytes.begin(), bytes.end()) == big;
+        Net::SendBytes(peer, BIG_ID, bytes, NetChannel::ReliableOrdered);
+    });
+
+    std::atomic<bool> done { false };
+    int               status = -1;
+    std::thread       child([&] {
+        status = std::system(("\"" + self + "\" client " + std::to_string(port)).c_str());
+        done   = true;
+    });
+    while (!done) {
+        tick();
+        peers = std::max(peers, Net::GetPeerCount());
+    }
+    child.join();
+
+    CHECK_MSG(status == 0, "the client process failed (status %d)", status);
+    CHECK(peers == 1);
+    CHECK_MSG(received == MESSAGES && outOfOrder == 0, "%u of %u messages, %u out of order", received, MESSAGES, outOfOrder);
+    CHECK(bigReceived);
+
+    // The client said goodbye on the way out: gone at once, not after the 10 s timeout
+    const Clock::time_point start = Clock::now();
+    while (Net::GetPeerCount() > 0 && Clock::now() - start < std::chrono::seconds(1))
+        tick();
+    CHECK(Net::GetPeerCount() == 0);
+
+    Net::Shutdown();
+    return TestResult("test_net_udp");
+}
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc == 3 && std::string(argv[1]) == "client")
+        return client(static_cast<uint16_t>(std::atoi(argv[2])));
+    return server(argv[0]);
+}
@@ -0,0 +1,163 @@
+// Profiler: zones cost nothing and record nothing while inactive; enabled, the HUD statistics
+// (GetTopZones) count calls and inclusive time per frame, across threads and for interned names;
+// full rings and the capture limit count dropped zones; and a capture exports Chrome trace JSON
+// with thread names, every zone, frame markers, counters and escaped names.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "profiler/profiler.h"
+
+#include "testing.h"
+
+namespace {
+const ProfileZoneStats *findZone(const char *name) {
+    for (const ProfileZoneStats &zone : Profiler::GetTopZones())
+        if (std::string(zone.name) == name)
+            return &zone;
+    return nullptr;
+}
+
+size_t countOf(const std::string &text, const std::string &needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + needle.size()))
+        ++count;
+    return count;
+}
+
+// One HUD window (30 frames), `body` once per frame
+template <typename F>
+void hudWindow(F &&body) {
+    for (int frame = 0; frame < 30; ++frame) {
+        body();
+        Profiler::EndFrame();
+    }
+}
+
+void inactive() {
+    CHECK(!Profiler::IsActive());
+    hudWindow([] {
+        for (int i = 0; i < 100; ++i)
+            LUMI_ZONE("Inactive");
+    });
+    CHECK(Profiler::GetTopZones().empty());
+}
+
+void statistics() {
+    Profiler::SetEnabled(true);
+    CHECK(Profiler::IsActive());
+
+    const std::string pass = "Pass: sprites";
+    hudWindow([&] {
+        LUMI_ZONE("Outer");
+        for (int i = 0; i < 10; ++i)
+            LUMI_ZONE("Inner");
+        {
+            LUMI_ZONE(std::string_view(pass)); // interned copy
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    const ProfileZoneStats *outer = findZone("Outer"), *inner = findZone("Inner"), *named = findZone("Pass: sprites");
+    CHECK(outer && inner && named);
+    if (outer && inner && named) {
+        CHECK(outer->calls == 1.0 && inner->calls == 10.0 && named->calls == 1.0);
+        CHECK(named->ms >= 1.0 && named->maxMs >= 1.0);
+        CHECK(outer->ms >= named->ms); // inclusive: the pass ran inside it
+        CHECK(Profiler::GetTopZones().front().ms >= Profiler::GetTopZones().back().ms);
+    }
+    CHECK(Profiler::Intern(pass) == Profiler::Intern("Pass: sprites"));
+
+    // Worker threads' zones land in the same totals
+    hudWindow([] {
+        std::thread worker([] {
+            for (int i = 0; i < 4; ++i)
+                LUMI_ZONE("Job");
+        });
+        worker.join();
+    });
+    const ProfileZoneStats *job = findZone("Job");
+    CHECK(job && job->calls == 4.0);
+
+    // More zones in a frame than a thread's ring holds
+    hudWindow([] {});
+    const uint64_t dropped = Profiler::GetDroppedZones();
+    for (int i = 0; i < 10000; ++i)
+        LUMI_ZONE("Flood");
+    Profiler::EndFrame();
+    CHECK(Profiler::GetDroppedZones() - dropped == 10000 - 8192);
+
+    Profiler::SetEnabled(false);
+    CHECK(!Profiler::IsActive() && Profiler::GetTopZones().empty());
+}
+
+void capture() {
+    const std::string path = (std::filesystem::temp_directory_path() / "lumi_test_profiler.json").string();
+    CHECK(!Profiler::EndCapture(path)); // nothing to end
+
+    Profiler::BeginCapture();
+    CHECK(Profiler::IsCapturing() && Profiler::IsActive());
+
+    std::thread worker([] {
+        Profiler::SetThreadName("Loader \"A\"");
+        for (int i = 0; i < 50; ++i)
+            LUMI_ZONE("Load");
+    });
+    worker.join();
+    for (int frame = 0; frame < 5; ++frame) {
+        {
+            LUMI_ZONE("Frame \"work\"\\");
+            for (int i = 0; i < 3; ++i)
+                LUMI_ZONE_FUNCTION();
+        }
+        Profiler::RecordCounter("GPU ms", "Sprites", 0.25 * frame);
+        Profiler::EndFrame();
+    }
+    CHECK(Profiler::EndCapture(path));
+    CHECK(!Profiler::IsCapturing() && !Profiler::IsActive());
+
+    std::ifstream     file(path);
+    const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::filesystem::remove(path);
+
+    CHECK(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    CHECK(json.find("\n]}\n") == json.size() - 4);
+    CHECK(countOf(json, "\"ph\":\"X\"") == 50 + 5 * 4);
+    CHECK(countOf(json, "\"name\":\"Load\"") == 50);
+    CHECK(countOf(json, "\"name\":\"capture\"") == 15); // __func__
+    CHECK(countOf(json, "\"name\":\"Frame \\\"work\\\"\\\\\"") == 5);
+    CHECK(countOf(json, "\"ph\":\"i\"") == 5);
+    CHECK(countOf(json, "\"ph\":\"C\"") == 5 && countOf(json, "{\"Sprites\":") == 5);
+    CHECK(json.find("\"args\":{\"name\":\"Main\"}") != std::string::npos);
+    CHECK(json.find("\"args\":{\"name\":\"Loader \\\"A\\\"\"}") != std::string::npos);
+    CHECK(std::count(json.begin(), json.end(), '{') == std::count(json.begin(), json.end(), '}'));
+
+    // The capture limit: zones past it are dropped and counted
+    Profiler::BeginCapture(10);
+    for (int i = 0; i < 25; ++i)
+        LUMI_ZONE("Limited");
+    Profiler::EndFrame();
+    CHECK(Profiler::GetDroppedZones() == 15);
+    CHECK(Profiler::EndCapture(path));
+    std::filesystem::remove(path);
+
+    // An unwritable path fails and ends the capture
+    Profiler::BeginCapture();
+    CHECK(!Profiler::EndCapture((std::filesystem::temp_directory_path() / "no such dir" / "trace.json").string()));
+    CHECK(!Profiler::IsCapturing());
+}
+} // namespace
+
+int main() {
+    inactive();
+    statistics();
+    capture();
+    return TestResult("test_profiler");
+}
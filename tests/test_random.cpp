@@ -0,0 +1,177 @@
+// Random / Rng: PCG32 reference output, jump-ahead, bulk fills, bounded ranges, seeding and
+// streams, and chi-square uniformity. Every generator is seeded explicitly, so the statistical
+// checks are deterministic (no flaky failures); their bounds are 99.9th percentiles.
+
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "util/random.h"
+
+#include "testing.h"
+
+namespace {
+template <size_t Bins>
+double chiSquare(const std::array<uint64_t, Bins> &counts, uint64_t total) {
+    const double expected = static_cast<double>(total) / Bins;
+    double       sum      = 0.0;
+    for (const uint64_t count : counts) {
+        const double d = static_cast<double>(count) - expected;
+        sum += d * d / expected;
+    }
+    return sum;
+}
+
+void referenceVectors() {
+    // pcg32-demo (pcg32_srandom_r(42, 54)), from the PCG reference implementation
+    Rng            rng(42, 54);
+    const uint32_t expected[] = { 0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e };
+    for (const uint32_t value : expected)
+        CHECK(rng.Next() == value);
+
+    // PCG hash (Jarzynski & Olano)
+    CHECK(Random::Hash(0) == 0x07bb2fe2u);
+    CHECK(Random::Hash(1) == 0xa8beea3cu);
+    CHECK(Random::Hash(2) == 0x7a7ecc88u);
+    CHECK(Random::Hash(12345) == 0xf45ead0eu);
+    CHECK(Random::Hash(0xffffffffu) == 0xe62a4902u);
+    CHECK(Random::HashFloat(1) == static_cast<float>(0xa8beea3cu >> 8) * 0x1.0p-24f);
+}
+
+void advance() {
+    for (const uint64_t n : { 0ull, 1ull, 2ull, 1000ull, 123457ull }) {
+        Rng stepped(7, 3), jumped(7, 3);
+        for (uint64_t i = 0; i < n; ++i)
+            stepped.Next();
+        jumped.Advance(n);
+        CHECK_MSG(stepped == jumped, "Advance(%llu)", static_cast<unsigned long long>(n));
+        CHECK(stepped.Next() == jumped.Next());
+    }
+
+    // The period is 2^64: going forward n and then 2^64 - n lands back on the start
+    Rng start(99, 1), rng(99, 1);
+    rng.Advance(5000);
+    rng.Advance(0ull - 5000ull);
+    CHECK(rng == start);
+}
+
+void fills() {
+    Rng                   a(11, 2), b(11, 2);
+    std::vector<float>    floats(1001);
+    std::vector<uint32_t> words(1001);
+    a.Fill(floats.data(), floats.size(), -2.0f, 3.0f);
+    a.Fill(words.data(), words.size());
+    for (const float value : floats) {
+        CHECK(value == b.Range(-2.0f, 3.0f));
+        CHECK(value >= -2.0f && value < 3.0f);
+    }
+    for (const uint32_t value : words)
+        CHECK(value == b.Next());
+}
+
+void ranges() {
+    Rng rng(5, 5);
+    for (int i = 0; i < 10000; ++i) {
+        const int r = rng.Range(-3, 3);
+        CHECK(r >= -3 && r <= 3);
+        const int swapped = rng.Range(9, 1);
+        CHECK(swapped >= 1 && swapped <= 9);
+        CHECK(rng.Below(1) == 0);
+        const float f = rng.Float();
+        CHECK(f >= 0.0f && f < 1.0f);
+        const double d = rng.Double();
+        CHECK(d >= 0.0 && d < 1.0);
+    }
+    CHECK(rng.Range(4, 4) == 4);
+    CHECK(rng.Below(0) == 0);
+
+    // The full int range must not overflow, and must reach both halves
+    bool negative = false, positive = false;
+    for (int i = 0; i < 64; ++i) {
+        const int r = rng.Range(INT_MIN, INT_MAX);
+        negative |= r < 0;
+        positive |= r > 0;
+    }
+    CHECK(negative && positive);
+}
+
+void seeding() {
+    Random::SetSeed(1234);
+    CHECK(Random::GetSeed() == 1234);
+    int first[16];
+    for (int &value : first)
+        value = Random::Range(0, 1000000);
+
+    Random::SetSeed(1234);
+    for (const int value : first)
+        CHECK(Random::Range(0, 1000000) == value);
+
+    // Named streams depend only on the seed and the name
+    Rng sparks = Random::Stream("sparks"), again = Random::Stream("sparks"), other = Random::Stream("smoke");
+    CHECK(sparks == again);
+    CHECK(!(sparks == other));
+
+    // Thread streams pick up a new seed on their next ThreadLocal call, and reproduce with it
+    auto threadValues = [] {
+        uint32_t values[2];
+        std::thread([&values] {
+            values[0] = Random::ThreadLocal().Next();
+            values[1] = Random::ThreadLocal().Next();
+        }).join();
+        return std::array<uint32_t, 2> { values[0], values[1] };
+    };
+    Random::SetSeed(77);
+    const auto first77  = threadValues();
+    const auto second77 = threadValues(); // a different thread: a different stream
+    CHECK(first77 != second77);
+    CHECK(Random::ThreadLocal().Next() != first77[0]);
+}
+
+void uniformity() {
+    constexpr uint64_t DRAWS = 1u << 20;
+
+    Rng                       rng(2024, 1);
+    std::array<uint64_t, 256> high {}, low {};
+    std::array<uint64_t, 7>   below7 {};
+    for (uint64_t i = 0; i < DRAWS; ++i) {
+        const uint32_t value = rng.Next();
+        ++high[value >> 24];
+        ++low[value & 0xffu];
+        ++below7[rng.Below(7)];
+    }
+    const double highChi = chiSquare(high, DRAWS), lowChi = chiSquare(low, DRAWS), below7Chi = chiSquare(below7, DRAWS);
+    CHECK_MSG(highChi < 340.0, "top byte chi-square %.1f (255 dof)", highChi);
+    CHECK_MSG(lowChi < 340.0, "low byte chi-square %.1f (255 dof)", lowChi);
+    CHECK_MSG(below7Chi < 22.5, "Below(7) chi-square %.1f (6 dof)", below7Chi);
+
+    // The GPU hash over consecutive inputs (particle indices) must look uniform too
+    std::array<uint64_t, 256> hashed {};
+    for (uint32_t i = 0; i < DRAWS; ++i)
+        ++hashed[static_cast<uint32_t>(Random::HashFloat(i) * 256.0f)];
+    const double hashChi = chiSquare(hashed, DRAWS);
+    CHECK_MSG(hashChi < 340.0, "HashFloat chi-square %.1f (255 dof)", hashChi);
+
+    // Float mean and variance against U(0, 1): 1/2 and 1/12, well inside 5 sigma
+    double sum = 0.0, sumSquares = 0.0;
+    for (uint64_t i = 0; i < DRAWS; ++i) {
+        const double f = rng.Float();
+        sum += f;
+        sumSquares += f * f;
+    }
+    const double mean = sum / DRAWS, variance = sumSquares / DRAWS - mean * mean;
+    CHECK_MSG(mean > 0.4985 && mean < 0.5015, "Float mean %f", mean);
+    CHECK_MSG(variance > 0.0829 && variance < 0.0838, "Float variance %f", variance);
+}
+} // namespace
+
+int main() {
+    referenceVectors();
+    advance();
+    fills();
+    ranges();
+    seeding();
+    uniformity();
+    return TestResult("test_random");
+}
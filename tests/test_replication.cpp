@@ -0,0 +1,300 @@
+// Bit-packed serialization and snapshot replication. BitWriter/BitReader round-trip seeded random
+// fields of every width and var-uints at their group edges, and a short read flags overflow
+// instead of reading on. Quantizer meets the precision it was sized for. Then a server and a
+// client exchange snapshots of a changing 500-entity world directly (no transport) over a lossy,
+// delayed link: after every decoded snapshot the client's world equals the server's at that
+// snapshot within the schema's precision, deltas are much smaller than full snapshots, and stale,
+// truncated, junk and baseline-less snapshots are rejected.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "platform/net/bitstream.h"
+#include "platform/net/replication.h"
+#include "util/random.h"
+
+#include "testing.h"
+
+namespace {
+void bitstream() {
+    Rng                   rng(44);
+    std::vector<uint32_t> values(5000), widths(5000);
+    std::vector<uint8_t>  bytes;
+    size_t                bits = 0;
+    {
+        BitWriter writer(bytes);
+        for (size_t i = 0; i < values.size(); ++i) {
+            widths[i] = 1 + rng.Below(32);
+            values[i] = rng.Next() & (widths[i] == 32 ? ~0u : (1u << widths[i]) - 1);
+            writer.WriteBits(values[i] | (widths[i] < 32 ? 1u << widths[i] : 0u), widths[i]); // bits above the width are ignored
+            bits += widths[i];
+        }
+        CHECK(writer.BitsWritten() == bits);
+    }
+    CHECK(bytes.size() == (bits + 7) / 8);
+
+    BitReader reader(bytes);
+    bool      same = true;
+    for (size_t i = 0; i < values.size(); ++i)
+        same &= reader.ReadBits(widths[i]) == values[i];
+    CHECK(same && !reader.Overflowed());
+
+    // Var-uints: 5 bits per 4-bit group
+    const uint32_t edges[] = { 0, 15, 16, 255, 256, 0xFFFF, 1234567, 0xFFFFFFFF };
+    {
+        BitWriter writer(bytes);
+        for (const uint32_t value : edges)
+            writer.WriteVarUint(value);
+        writer.WriteBool(true);
+        CHECK(writer.BitsWritten() == 5 * (1 + 1 + 2 + 2 + 3 + 4 + 6 + 8) + 1);
+    }
+    BitReader varReader(bytes);
+    for (const uint32_t value : edges)
+        CHECK(varReader.ReadVarUint() == value);
+    CHECK(varReader.ReadBool() && !varReader.Overflowed());
+
+    // Past the end: zeros and a sticky flag
+    const uint8_t two[2] = { 0xFF, 0xFF };
+    BitReader     shortReader(two);
+    CHECK(shortReader.ReadBits(12) == 0xFFF && !shortReader.Overflowed());
+    CHECK(shortReader.ReadBits(8) == 0 && shortReader.Overflowed());
+    CHECK(shortReader.ReadBits(8) == 0 && shortReader.Overflowed());
+
+    // A var-uint that never ends
+    const uint8_t endless[8] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    BitReader     endlessReader(endless);
+    CHECK(endlessReader.ReadVarUint() == 0 && endlessReader.Overflowed());
+}
+
+void quantizer() {
+    CHECK(Quantizer::BitsFor(-10.0f, 10.0f, 0.001f) == 15);
+    CHECK(Quantizer::BitsFor(0.0f, 1.0f, 1.0f) == 1);
+    CHECK(Quantizer::BitsFor(-1e9f, 1e9f, 1e-9f) == 32);
+
+    Rng rng(45);
+    for (const float precision : { 0.5f, 0.01f, 0.0001f }) {
+        const Quantizer quantizer { -4096.0f, 4096.0f, Quantizer::BitsFor(-4096.0f, 4096.0f, precision) };
+        float           worst = 0.0f;
+        for (int i = 0; i < 10000; ++i) {
+            const float value = rng.Range(-4096.0f, 4096.0f);
+            worst             = std::max(worst, std::abs(quantizer.Decode(quantizer.Encode(value)) - value));
+        }
+        CHECK_MSG(worst <= precision, "precision %g: error %g", precision, worst);
+        CHECK(quantizer.Decode(quantizer.Encode(-4096.0f)) == -4096.0f && quantizer.Decode(quantizer.Encode(4096.0f)) == 4096.0f);
+        CHECK(quantizer.Decode(quantizer.Encode(1e9f)) == 4096.0f); // clamped
+        CHECK(quantizer.Encode(NAN) == quantizer.Encode(-4096.0f));
+    }
+}
+
+// ── Replication ──────────────────────────────────────────────────────────────
+
+struct Entity {
+    float    position[2];
+    float    angle;
+    float    velocity[2];
+    uint16_t hp;
+    uint8_t  animation, team;
+    uint32_t flags;
+};
+
+constexpr float POSITION_PRECISION = 0.01f, ANGLE_PRECISION = 0.005f, VELOCITY_PRECISION = 0.05f;
+
+ReplicaSchema schema() {
+    return ReplicaSchema::Of<Entity>()
+        .Vector(&Entity::position, -4096.0f, 4096.0f, POSITION_PRECISION)
+        .Float(&Entity::angle, 0.0f, 6.2832f, ANGLE_PRECISION)
+        .Vector(&Entity::velocity, -512.0f, 512.0f, VELOCITY_PRECISION)
+        .Raw(&Entity::hp)
+        .Raw(&Entity::animation)
+        .Raw(&Entity::team)
+        .Raw(&Entity::flags);
+}
+
+struct World {
+    std::vector<Entity> entities;
+    std::vector<bool>   alive;
+};
+
+void step(World &world, Rng &rng) {
+    for (size_t i = 0; i < world.entities.size(); ++i) {
+        Entity &e = world.entities[i];
+        if (i % 4 == 0) { // a quarter of the world moves
+            if (rng.Chance(0.05f)) {
+                e.velocity[0] = rng.Range(-100.0f, 100.0f);
+                e.velocity[1] = rng.Range(-100.0f, 100.0f);
+            }
+            e.position[0] += e.velocity[0] / 60.0f;
+            e.position[1] += e.velocity[1] / 60.0f;
+            e.angle = std::fmod(e.angle + 0.05f, 6.28f);
+        }
+        if (rng.Chance(0.01f))
+            e.hp -= 1;
+        if (rng.Chance(0.02f))
+            e.animation = (e.animation + 1) % 8;
+        if (rng.Chance(0.01f))
+            e.flags ^= 1u << rng.Below(32);
+        if (rng.Chance(0.002f))
+            world.alive[i] = !world.alive[i];
+    }
+}
+
+// Entities the client has that the world doesn't, or with a field off by more than its precision
+int mismatches(const ReplicationClient &client, const World &world) {
+    int    wrong = 0;
+    size_t count = 0;
+    client.ForEach([&](uint32_t id, const void *state) {
+        const Entity &got = *static_cast<const Entity *>(state);
+        ++count;
+        if (id >= world.entities.size() || !world.alive[id]) {
+            ++wrong;
+            return;
+        }
+        const Entity &want = world.entities[id];
+        wrong += std::abs(got.position[0] - want.position[0]) > POSITION_PRECISION || std::abs(got.position[1] - want.position[1]) > POSITION_PRECISION ||
+                 std::abs(got.angle - want.angle) > ANGLE_PRECISION || std::abs(got.velocity[0] - want.velocity[0]) > VELOCITY_PRECISION ||
+                 std::abs(got.velocity[1] - want.velocity[1]) > VELOCITY_PRECISION || got.hp != want.hp || got.animation != want.animation ||
+                 got.team != want.team || got.flags != want.flags;
+    });
+    for (const bool alive : world.alive)
+        count -= alive;
+    return wrong + (count != 0);
+}
+
+// A snapshot in flight, and the world it was captured from
+struct InFlight {
+    uint32_t             arrives; // tick
+    std::vector<uint8_t> bytes;
+    World                world;
+};
+
+void replicate(float loss, size_t &deltaBytes, size_t &deltas) {
+    constexpr uint32_t ENTITIES = 500, TICKS = 400, DELAY = 3; // ticks each way
+    constexpr uint32_t CLIENT   = 1;
+
+    Rng   rng(46);
+    World world { std::vector<Entity>(ENTITIES), std::vector<bool>(ENTITIES, true) };
+    for (Entity &e : world.entities) {
+        e             = {};
+        e.position[0] = rng.Range(-2000.0f, 2000.0f);
+        e.position[1] = rng.Range(-2000.0f, 2000.0f);
+        e.angle       = rng.Range(0.0f, 6.28f);
+        e.hp          = 100;
+        e.team        = static_cast<uint8_t>(rng.Below(4));
+    }
+
+    ReplicationServer                         server(schema());
+    ReplicationClient                         client(schema());
+    std::deque<InFlight>                      snapshots;
+    std::deque<std::pair<uint32_t, uint32_t>> acks; // (arrives, sequence)
+    int                                       decoded = 0, wrong = 0;
+
+    for (uint32_t tick = 0; tick < TICKS + 40; ++tick) {
+        if (tick < TICKS) // then nothing changes and the client catches up
+            step(world, rng);
+        for (uint32_t i = 0; i < ENTITIES; ++i) {
+            if (world.alive[i])
+                server.Set(i, world.entities[i]);
+            else
+                server.Remove(i);
+        }
+        server.Capture();
+
+        InFlight snapshot { tick + DELAY, {}, world };
+        server.Encode(CLIENT, snapshot.bytes);
+        if (tick > 0 && tick < TICKS) {
+            deltaBytes += snapshot.bytes.size();
+            ++deltas;
+        }
+        if (!rng.Chance(loss))
+            snapshots.push_back(std::move(snapshot));
+
+        while (!snapshots.empty() && snapshots.front().arrives == tick) {
+            uint32_t sequence = 0;
+            if (client.Decode(snapshots.front().bytes, sequence)) {
+                ++decoded;
+                wrong += mismatches(client, snapshots.front().world);
+                if (!rng.Chance(loss))
+                    acks.emplace_back(tick + DELAY, sequence);
+
+                // The same snapshot again is stale
+                uint32_t again = 0;
+                CHECK(!client.Decode(snapshots.front().bytes, again));
+            }
+            snapshots.pop_front();
+        }
+        while (!acks.empty() && acks.front().first == tick) {
+            server.Acknowledge(CLIENT, acks.front().second);
+            acks.pop_front();
+        }
+    }
+
+    CHECK_MSG(wrong == 0, "loss %g: %d mismatching snapshots of %d", loss, wrong, decoded);
+    CHECK(decoded > int((TICKS + 40) * (1.0f - loss) * 0.8f));
+    CHECK(client.Latest() > TICKS); // caught up during the quiet ticks
+    CHECK(mismatches(client, world) == 0);
+}
+
+void replication() {
+    size_t lossless = 0, losslessCount = 0, lossy = 0, lossyCount = 0;
+    replicate(0.0f, lossless, losslessCount);
+    replicate(0.1f, lossy, lossyCount);
+
+    // Full snapshots of the same world, for scale
+    ReplicationServer    server(schema());
+    std::vector<uint8_t> full;
+    Entity               e {};
+    for (uint32_t i = 0; i < 500; ++i) {
+        e.position[0] = float(i);
+        e.hp          = 100;
+        server.Set(i, e);
+    }
+    server.Capture();
+    server.Encode(1, full);
+    const double delta = double(lossless) / losslessCount;
+    CHECK_MSG(delta * 4 < full.size(), "delta %.0f bytes vs full %zu", delta, full.size());
+    CHECK(double(lossy) / lossyCount < full.size() / 2.0); // older baselines cost more, still far less
+
+    // Decoding errors
+    ReplicationClient client(schema());
+    uint32_t          sequence = 0;
+    CHECK(client.Find(0) == nullptr && client.Latest() == 0);
+
+    std::vector<uint8_t> junk(37, 0xAB);
+    CHECK(!client.Decode(junk, sequence));
+    CHECK(!client.Decode({}, sequence));
+    CHECK(!client.Decode(std::span(full).first(full.size() / 2), sequence)); // truncated
+    CHECK(client.Latest() == 0);
+
+    CHECK(client.Decode(full, sequence) && sequence == 1 && std::abs(client.Find<Entity>(7)->position[0] - 7.0f) <= POSITION_PRECISION);
+
+    // A delta against a baseline this client never decoded
+    server.Acknowledge(1, 1);
+    e.hp = 50;
+    server.Set(3, e);
+    server.Capture();
+    std::vector<uint8_t> delta2;
+    server.Encode(1, delta2);
+    ReplicationClient fresh(schema());
+    CHECK(!fresh.Decode(delta2, sequence));
+    CHECK(client.Decode(delta2, sequence) && sequence == 2 && client.Find<Entity>(3)->hp == 50);
+
+    // Forget: the next snapshot is a full one again
+    server.Forget(1);
+    server.Capture();
+    std::vector<uint8_t> again;
+    server.Encode(1, again);
+    CHECK(fresh.Decode(again, sequence) && sequence == 3 && fresh.Find<Entity>(3)->hp == 50 && fresh.Find<Entity>(499));
+}
+} // namespace
+
+int main() {
+    bitstream();
+    quantizer();
+    replication();
+    return TestResult("test_replication");
+}
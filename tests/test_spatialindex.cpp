@@ -0,0 +1,171 @@
+// SpatialIndex against brute force: for both index types, points and circles (a few of them
+// huge), inline and pooled rebuilds, every rect and circle query reports exactly the entities
+// whose circle overlaps the query shape, each once. Also typed IDs, entities outside the
+// quadtree bounds, empty and clustered inputs, and that a steady-state rebuild doesn't touch the
+// heap (replaced global operator new).
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "util/random.h"
+#include "util/spatialindex.h"
+#include "util/threadpool.h"
+
+#include "alloc_counter.h"
+#include "testing.h"
+
+namespace {
+enum class EntityId : uint32_t {};
+
+struct Entities {
+    std::vector<float> x, y, r;
+};
+
+// Spread over (and a little past) the default 4096 quadtree bounds; with radii, 1 in 100 is huge
+Entities scatter(Rng &rng, size_t count, bool radii) {
+    Entities e { std::vector<float>(count), std::vector<float>(count), std::vector<float>(count, 0.0f) };
+    for (size_t i = 0; i < count; ++i) {
+        e.x[i] = rng.Range(-100.0f, 4200.0f);
+        e.y[i] = rng.Range(-100.0f, 4200.0f);
+        if (radii)
+            e.r[i] = i % 100 == 0 ? 900.0f : rng.Range(0.0f, 40.0f);
+    }
+    return e;
+}
+
+bool overlapsRect(const Entities &e, size_t i, const rectf &rect) {
+    const float halfW = rect.width * 0.5f, halfH = rect.height * 0.5f;
+    const float dx    = std::max(std::fabs(e.x[i] - (rect.x + halfW)) - halfW, 0.0f);
+    const float dy    = std::max(std::fabs(e.y[i] - (rect.y + halfH)) - halfH, 0.0f);
+    return dx * dx + dy * dy <= e.r[i] * e.r[i];
+}
+
+bool overlapsCircle(const Entities &e, size_t i, float x, float y, float radius) {
+    const float dx = e.x[i] - x, dy = e.y[i] - y, rr = e.r[i] + radius;
+    return dx * dx + dy * dy <= rr * rr;
+}
+
+// Sorted hits; a duplicate report shows up as a repeated element
+std::vector<uint32_t> sorted(const std::vector<EntityId> &hits) {
+    std::vector<uint32_t> out;
+    for (const EntityId id : hits)
+        out.push_back(static_cast<uint32_t>(id));
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+void compare(const SpatialIndex<EntityId> &index, const Entities &e, Rng &rng, const char *what) {
+    int mismatches = 0;
+    for (int q = 0; q < 300; ++q) {
+        // Mostly small queries, every tenth one covering a large part of the world
+        const float scale = q % 10 == 0 ? 100.0f : 5.0f;
+        const rectf rect(rng.Range(-100.0f, 4200.0f), rng.Range(-100.0f, 4200.0f), rng.Range(0.0f, 40.0f) * scale, rng.Range(0.0f, 200.0f));
+
+        std::vector<EntityId> hits;
+        index.QueryRect(rect, hits);
+        std::vector<uint32_t> expected;
+        for (size_t i = 0; i < e.x.size(); ++i)
+            if (overlapsRect(e, i, rect))
+                expected.push_back(static_cast<uint32_t>(i));
+        mismatches += sorted(hits) != expected;
+
+        const float x = rng.Range(-100.0f, 4200.0f), y = rng.Range(-100.0f, 4200.0f);
+        const float radius = rng.Range(0.0f, 40.0f) * scale * 0.5f;
+        hits.clear();
+        index.QueryCircle(x, y, radius, hits);
+        expected.clear();
+        for (size_t i = 0; i < e.x.size(); ++i)
+            if (overlapsCircle(e, i, x, y, radius))
+                expected.push_back(static_cast<uint32_t>(i));
+        mismatches += sorted(hits) != expected;
+    }
+    CHECK_MSG(mismatches == 0, "%s: %d of 600 queries differ from brute force", what, mismatches);
+}
+
+void bruteForce() {
+    Rng        rng(33);
+    ThreadPool pool(4);
+    for (const SpatialIndexType type : { SpatialIndexType::LooseQuadTree, SpatialIndexType::UniformGrid }) {
+        SpatialIndexSettings settings;
+        settings.type = type;
+        const char *name = type == SpatialIndexType::UniformGrid ? "grid" : "quadtree";
+
+        for (const bool radii : { false, true }) {
+            // 40k entities: enough for the pooled rebuild to split into several chunks
+            const Entities         e = scatter(rng, 40000, radii);
+            SpatialIndex<EntityId> index(settings);
+            index.Rebuild(e.x.data(), e.y.data(), radii ? e.r.data() : nullptr, e.x.size());
+            CHECK(index.GetCount() == e.x.size() && index.GetType() == type && index.GetNodeCount() > 1);
+            compare(index, e, rng, name);
+
+            index.Rebuild(e.x.data(), e.y.data(), radii ? e.r.data() : nullptr, e.x.size(), nullptr, &pool);
+            compare(index, e, rng, name);
+        }
+
+        // Everything in one spot: the quadtree stops at maxDepth, the grid at one bucket
+        Entities clustered { std::vector<float>(5000, 7.0f), std::vector<float>(5000, 9.0f), std::vector<float>(5000, 0.0f) };
+        SpatialIndex<EntityId> index(settings);
+        index.Rebuild(clustered.x.data(), clustered.y.data(), nullptr, 5000);
+        std::vector<EntityId> hits;
+        CHECK(index.QueryCircle(7.0f, 9.0f, 0.0f, hits) == 5000);
+        CHECK(sorted(hits).back() == 4999 && std::adjacent_find(hits.begin(), hits.end()) == hits.end());
+
+        // Empty
+        index.Rebuild(nullptr, nullptr, nullptr, 0);
+        hits.clear();
+        CHECK(index.GetCount() == 0 && index.QueryRect(rectf(-1e6f, -1e6f, 2e6f, 2e6f), hits) == 0);
+    }
+}
+
+void typedIds() {
+    // IDs given per entity come back for that entity, whatever the cell order
+    struct Handle {
+        uint32_t index = 0, generation = 0;
+    };
+    const float          x[3] = { 10.0f, 500.0f, 10.0f }, y[3] = { 10.0f, 500.0f, 30.0f };
+    const Handle         ids[3] = { { 0, 7 }, { 1, 8 }, { 2, 9 } };
+    SpatialIndex<Handle> index;
+    index.Rebuild(x, y, nullptr, 3, ids);
+
+    uint32_t generations = 0, count = 0;
+    index.QueryRect(rectf(0.0f, 0.0f, 50.0f, 50.0f), [&](const Handle &h) {
+        generations += h.generation;
+        ++count;
+    });
+    CHECK(count == 2 && generations == 16);
+}
+
+void steadyStateRebuild() {
+    Rng rng(34);
+    for (const SpatialIndexType type : { SpatialIndexType::LooseQuadTree, SpatialIndexType::UniformGrid }) {
+        SpatialIndexSettings settings;
+        settings.type = type;
+        Entities               e = scatter(rng, 20000, true);
+        SpatialIndex<EntityId> index(settings);
+        index.Rebuild(e.x.data(), e.y.data(), e.r.data(), e.x.size());
+
+        // Entities move a little each frame; the count stays the same
+        uint64_t during = 0;
+        for (int frame = 0; frame < 20; ++frame) {
+            for (size_t i = 0; i < e.x.size(); ++i) {
+                e.x[i] += rng.Range(-2.0f, 2.0f);
+                e.y[i] += rng.Range(-2.0f, 2.0f);
+            }
+            const uint64_t before = allocations.load();
+            index.Rebuild(e.x.data(), e.y.data(), e.r.data(), e.x.size());
+            if (frame > 0) // the first may still grow the quadtree arena
+                during += allocations.load() - before;
+        }
+        CHECK_MSG(during == 0, "%llu heap allocations in warm rebuilds", static_cast<unsigned long long>(during));
+    }
+}
+} // namespace
+
+int main() {
+    bruteForce();
+    typedIds();
+    steadyStateRebuild();
+    return TestResult("test_spatialindex");
+}
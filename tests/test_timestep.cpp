@@ -0,0 +1,177 @@
+// Timestep, headless: the same stretch of time cut into different frame patterns runs the same
+// ticks and leaves a simulation in bit-identical state; alpha and Interpolate; the per-frame tick
+// cap and the backlog it drops; rate changes keeping alpha; Step, disabling, InTick and Reset.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "core/timestep/timestep.h"
+#include "util/random.h"
+
+#include "testing.h"
+
+namespace {
+// A falling, bouncing ball with drag: floating-point heavy, so any difference in the dt sequence
+// shows up in the low bits
+struct Ball {
+    double y = 100.0, velocity = 0.0;
+
+    void Tick(double dt) {
+        velocity -= 9.81 * dt;
+        velocity *= 1.0 - 0.1 * dt;
+        y += velocity * dt;
+        if (y < 0.0) {
+            y        = -y;
+            velocity = -velocity * 0.8;
+        }
+    }
+    bool operator==(const Ball &) const = default;
+};
+
+// Fresh defaults, a ball, and a callback ticking it
+void start(Ball &ball) {
+    Timestep::SetTickRate(60.0);
+    Timestep::SetMaxTicksPerFrame(8);
+    Timestep::Reset();
+    ball = {};
+    Timestep::SetTickCallback([&ball](double dt) { ball.Tick(dt); });
+}
+
+// Advances frames until `seconds` have passed; returns the ticks run
+uint64_t run(const std::vector<double> &frames, double seconds) {
+    double elapsed = 0.0;
+    for (size_t i = 0; elapsed < seconds; ++i) {
+        const double frame = std::min(frames[i % frames.size()], seconds - elapsed);
+        Timestep::Advance(frame);
+        elapsed += frame;
+    }
+    return Timestep::GetTickCount();
+}
+
+void frameRateIndependence() {
+    // Ten seconds and half a tick, so rounding in the frame sums can't move a tick boundary
+    const double seconds = 10.0 + 0.5 / 60.0;
+
+    Ball reference;
+    start(reference);
+    CHECK(run({ 1.0 / 60.0 }, seconds) == 600);
+    CHECK(std::abs(Timestep::GetAlpha() - 0.5f) < 1e-3f);
+    const Ball at60 = reference;
+
+    Ball ball;
+    for (const std::vector<double> &frames : { std::vector<double> { 1.0 / 30.0 }, std::vector<double> { 1.0 / 144.0 },
+             std::vector<double> { 0.016, 0.033, 0.007, 0.05, 0.016, 0.016, 0.001, 0.09 } }) {
+        start(ball);
+        CHECK(run(frames, seconds) == 600);
+        CHECK(ball == at60);
+    }
+
+    // Jittered frames around 60 fps
+    Rng                 rng(34);
+    std::vector<double> jittered(1000);
+    for (double &frame : jittered)
+        frame = rng.Range(0.004f, 0.03f);
+    start(ball);
+    CHECK(run(jittered, seconds) == 600);
+    CHECK(ball == at60);
+    CHECK(Timestep::GetDroppedTime() == 0.0);
+}
+
+void alpha() {
+    Ball ball;
+    start(ball);
+    double previous = 0.0, current = 0.0;
+    Timestep::SetTickCallback([&](double dt) {
+        previous = current;
+        current += 10.0 * dt;
+    });
+
+    CHECK(Timestep::Advance(0.010) == 0);
+    CHECK(std::abs(Timestep::GetAlpha() - 0.6f) < 1e-4f);
+    CHECK(Timestep::Advance(0.010) == 1 && Timestep::GetTicksThisFrame() == 1);
+    CHECK(std::abs(Timestep::GetAlpha() - (0.020 - 1.0 / 60.0) * 60.0) < 1e-4);
+
+    // Interpolate blends the last two ticks' state by alpha
+    Timestep::Advance(1.0 / 60.0 * 1.5 - 0.020 + 1.0 / 60.0); // lands halfway into the next tick
+    CHECK(std::abs(Timestep::GetAlpha() - 0.5f) < 1e-4f);
+    CHECK(std::abs(Timestep::Interpolate(previous, current) - (previous + current) / 2.0) < 1e-6);
+
+    // Negative frame times (clock going backwards) add nothing
+    const float before = Timestep::GetAlpha();
+    CHECK(Timestep::Advance(-1.0) == 0 && Timestep::GetAlpha() == before);
+}
+
+void spiralOfDeath() {
+    Ball ball;
+    start(ball);
+
+    // A one-second hitch: 8 ticks run, the other 52 are dropped, not carried into the next frame
+    CHECK(Timestep::Advance(1.0) == 8);
+    CHECK(Timestep::GetTickCount() == 8);
+    CHECK(std::abs(Timestep::GetDroppedTime() - 52.0 / 60.0) < 1e-9);
+    CHECK(Timestep::GetAlpha() >= 0.0f && Timestep::GetAlpha() < 1e-3f);
+    CHECK(Timestep::Advance(1.0 / 60.0) == 1);
+
+    // Part of a tick survives the drop
+    Timestep::Reset();
+    CHECK(Timestep::Advance(0.5 + 0.25 / 60.0) == 8);
+    CHECK(std::abs(Timestep::GetAlpha() - 0.25f) < 1e-4f);
+    CHECK(std::abs(Timestep::GetDroppedTime() - 22.0 / 60.0) < 1e-9);
+
+    // The cap is at least one tick
+    Timestep::SetMaxTicksPerFrame(0);
+    CHECK(Timestep::GetMaxTicksPerFrame() == 1);
+    CHECK(Timestep::Advance(0.1) == 1);
+    Timestep::SetMaxTicksPerFrame(3);
+    CHECK(Timestep::Advance(0.1) == 3);
+}
+
+void tickRate() {
+    Ball ball;
+    start(ball);
+    double seenDt = 0.0;
+    bool   inTick = false;
+    Timestep::SetTickCallback([&](double dt) {
+        seenDt = dt;
+        inTick = Timestep::InTick();
+    });
+
+    // A rate change keeps how far into the current tick we are
+    Timestep::Advance(0.025);
+    const float before = Timestep::GetAlpha();
+    Timestep::SetTickRate(120.0);
+    CHECK(Timestep::GetTickRate() == 120.0 && Timestep::GetTickDelta() == 1.0 / 120.0);
+    CHECK(Timestep::GetAlpha() == before);
+    CHECK(Timestep::Advance((1.0f - before) / 120.0 + 1e-9) == 1);
+    CHECK(seenDt == 1.0 / 120.0 && inTick && !Timestep::InTick());
+
+    // Step ignores the clock, the cap and the accumulator
+    const float    alpha = Timestep::GetAlpha();
+    const uint64_t ticks = Timestep::GetTickCount();
+    CHECK(Timestep::Step(100) == 100);
+    CHECK(Timestep::GetTickCount() == ticks + 100 && Timestep::GetAlpha() == alpha);
+    CHECK(Timestep::Step(-3) == 0);
+
+    // Rate 0 disables ticks
+    Timestep::SetTickRate(0.0);
+    CHECK(Timestep::GetTickDelta() == 0.0);
+    CHECK(Timestep::Advance(1.0) == 0 && Timestep::Step(5) == 0 && Timestep::GetAlpha() == 0.0f);
+    CHECK(Timestep::GetTickCount() == ticks + 100);
+
+    Timestep::SetTickRate(60.0);
+    Timestep::Reset();
+    CHECK(Timestep::GetTickCount() == 0 && Timestep::GetTicksThisFrame() == 0 && Timestep::GetDroppedTime() == 0.0 && Timestep::GetAlpha() == 0.0f);
+    Timestep::SetTickCallback(nullptr);
+    CHECK(Timestep::Step(2) == 2); // no callback: ticks still count
+}
+} // namespace
+
+int main() {
+    frameRateIndependence();
+    alpha();
+    spiralOfDeath();
+    tickRate();
+    return TestResult("test_timestep");
+}
@@ -0,0 +1,141 @@
+// Tween pool: every curve's batch update (the SIMD polynomial forms and the scalar easings.h
+// loop alike) gives what its math/easings.h function gives, across the whole [0, 1] range and
+// for pools whose size isn't a multiple of the vector width; finished tweens land exactly on
+// their end value and are reported once. Seek, GetTime and IsPaused, and the deprecated
+// LerpAnimator time / started / canDelete stand-ins that sit on them.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "util/lerp.h"
+#include "util/tween.h"
+
+#include "testing.h"
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations" // the LerpAnimator stand-ins are tested on purpose
+#elif defined(_MSC_VER)
+#pragma warning(disable : 4996)
+#endif
+
+namespace {
+constexpr size_t TWEENS = 67; // 16 full vector groups and a tail of 3
+
+const char *const NAMES[] = { "Linear", "SineIn", "SineOut", "SineInOut", "CircIn", "CircOut", "CircInOut", "CubicIn", "CubicOut",
+    "CubicInOut", "QuadIn", "QuadOut", "QuadInOut", "ExpoIn", "ExpoOut", "ExpoInOut", "BackIn", "BackOut", "BackInOut", "BounceIn",
+    "BounceOut", "BounceInOut", "ElasticIn", "ElasticOut", "ElasticInOut" };
+
+void curves() {
+    for (size_t e = 0; e < static_cast<size_t>(Easing::Count); ++e) {
+        const auto easing = static_cast<Easing>(e);
+        Tween::Clear();
+
+        // Staggered along the curve so one Update evaluates it at 67 points, some of them on the
+        // InOut curves' halfway seam
+        std::vector<TweenHandle> handles;
+        std::vector<float>       from, change, duration;
+        for (size_t i = 0; i < TWEENS; ++i) {
+            from.push_back(-50.0f + 3.0f * i);
+            change.push_back(i % 2 ? 200.0f : -80.0f);
+            duration.push_back(0.5f + 0.25f * (i % 5));
+            handles.push_back(Tween::Start(from[i], from[i] + change[i], duration[i], easing));
+            Tween::Seek(handles[i], duration[i] * i / TWEENS);
+        }
+
+        float  worst = 0.0f, drift = 0.0f, elapsed = 0.0f;
+        size_t completed = 0;
+        for (const float dt : { 0.0f, 0.001f, 0.0173f, 0.1f, 0.37f }) {
+            Tween::Update(dt);
+            elapsed += dt;
+            completed += Tween::GetCompleted().size();
+            for (size_t i = 0; i < TWEENS; ++i) {
+                const float time     = Tween::GetTime(handles[i]);
+                const float expected = from[i] + change[i] * Tween::Evaluate(easing, time / duration[i]);
+                worst                = std::max(worst, std::fabs(Tween::GetValue(handles[i]) - expected) / std::fabs(change[i]));
+                drift                = std::max(drift, std::fabs(time - std::min(duration[i] * i / TWEENS + elapsed, duration[i])));
+            }
+        }
+        CHECK_MSG(worst < 1e-5f, "%s: batch update off the scalar curve by %g of the change", NAMES[e], worst);
+        CHECK_MSG(drift < 1e-5f, "%s: time off by %g s", NAMES[e], drift);
+
+        // Run out: every tween ends exactly on its target, reported once
+        for (int frame = 0; frame < 200; ++frame) {
+            Tween::Update(0.05f);
+            completed += Tween::GetCompleted().size();
+        }
+        int off = 0;
+        for (size_t i = 0; i < TWEENS; ++i)
+            off += Tween::GetValue(handles[i]) != from[i] + change[i] || !Tween::IsFinished(handles[i]);
+        CHECK_MSG(completed == TWEENS && off == 0, "%s: %zu completions, %d tweens off their end value", NAMES[e], completed, off);
+    }
+    Tween::Clear();
+}
+
+void seek() {
+    const TweenHandle tween = Tween::Start(0.0f, 10.0f, 2.0f);
+    Tween::Update(0.5f);
+    CHECK(Tween::GetTime(tween) == 0.5f && Tween::GetValue(tween) == 2.5f);
+
+    Tween::Seek(tween, 1.5f);
+    CHECK(Tween::GetTime(tween) == 1.5f && Tween::GetValue(tween) == 7.5f && !Tween::IsFinished(tween));
+
+    // To the end: finished, no completion event; back again: running
+    Tween::Seek(tween, 5.0f);
+    CHECK(Tween::GetTime(tween) == 2.0f && Tween::GetValue(tween) == 10.0f && Tween::IsFinished(tween));
+    CHECK(Tween::GetActiveCount() == 0);
+    Tween::Update(0.1f);
+    CHECK(Tween::GetCompleted().empty());
+    Tween::Seek(tween, -1.0f);
+    CHECK(Tween::GetTime(tween) == 0.0f && Tween::GetValue(tween) == 0.0f && !Tween::IsFinished(tween));
+    Tween::Update(1.0f);
+    CHECK(Tween::GetValue(tween) == 5.0f);
+
+    // Paused stays paused wherever it's moved
+    Tween::Pause(tween);
+    CHECK(Tween::IsPaused(tween));
+    Tween::Seek(tween, 0.4f);
+    Tween::Update(1.0f);
+    CHECK(Tween::IsPaused(tween) && Tween::GetTime(tween) == 0.4f);
+    Tween::Resume(tween);
+    CHECK(!Tween::IsPaused(tween));
+
+    Tween::Stop(tween);
+    CHECK(Tween::GetTime(tween) == 0.0f && !Tween::IsPaused(tween));
+    Tween::Seek(tween, 1.0f); // dead handle: ignored
+    Tween::Clear();
+}
+
+void lerpAliases() {
+    LerpAnimator *lerp = Lerp::GetLerp("test_tween", 100.0f, -50.0f, 1.0f);
+    CHECK(lerp->started && !lerp->canDelete && float(lerp->time) == 0.0f);
+
+    Tween::Update(0.25f);
+    CHECK(float(lerp->time) == 0.25f && lerp->GetValue() == 87.5f);
+
+    lerp->time = 0.5f;
+    CHECK(lerp->GetValue() == 75.0f);
+    lerp->time += 0.25f;
+    CHECK(float(lerp->time) == 0.75f);
+
+    lerp->started = false;
+    Tween::Update(0.1f);
+    CHECK(!lerp->started && float(lerp->time) == 0.75f);
+    lerp->started = true;
+    Tween::Update(0.5f);
+    CHECK(lerp->canDelete && lerp->IsFinished() && lerp->GetValue() == 50.0f);
+
+    lerp->time = 0.0f; // what Lerp::ResetTime does
+    CHECK(!lerp->canDelete && lerp->GetValue() == 100.0f);
+    Lerp::RemoveLerp("test_tween");
+    Tween::Clear();
+}
+} // namespace
+
+int main() {
+    curves();
+    seek();
+    lerpAliases();
+    return TestResult("test_tween");
+}
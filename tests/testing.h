@@ -0,0 +1,43 @@
+#pragma once
+
+// Minimal checks for the engine tests (no framework dependency). A failed CHECK prints the
+// expression and where it failed, and the test keeps going; CHECK is safe from any thread.
+// main() returns TestResult(), which is non-zero if anything failed, for CTest.
+
+#include <atomic>
+#include <cstdio>
+
+/// @cond INTERNAL
+inline std::atomic<int> &testFailures() {
+    static std::atomic<int> failures { 0 };
+    return failures;
+}
+/// @endcond
+
+#define CHECK(expr)                                                                        \
+    do {                                                                                   \
+        if (!(expr)) {                                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #expr);  \
+            ++testFailures();                                                              \
+        }                                                                                  \
+    } while (0)
+
+#define CHECK_MSG(expr, ...)                                                               \
+    do {                                                                                   \
+        if (!(expr)) {                                                                     \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s: ", __FILE__, __LINE__, #expr); \
+            std::fprintf(stderr, __VA_ARGS__);                                             \
+            std::fputc('\n', stderr);                                                      \
+            ++testFailures();                                                              \
+        }                                                                                  \
+    } while (0)
+
+/// @brief Prints a summary; returns the process exit code.
+inline int TestResult(const char *name) {
+    if (testFailures() == 0) {
+        std::printf("%s: passed\n", name);
+        return 0;
+    }
+    std::printf("%s: %d check(s) failed\n", name, testFailures().load());
+    return 1;
+}
@@ -0,0 +1,210 @@
+// log_decoder — offline tool that reads a binary log written by BinaryFileSink and prints it as the
+// engine's normal text log lines (same layout as FileSink, or coloured like the console).
+//
+// Usage: log_decoder <file.lumilog> [--color] [--min-level debug|info|warning|error|critical]
+//
+// Formatting happens here instead of in the game: encoded records are rebuilt from their call
+// site's format string plus the raw argument bytes with the same LogArgs::Format the engine uses.
+
+#include "core/log/logentry.h"
+#include "core/log/logrecord.h"
+#include "core/log/sinks/binaryfilesink.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Site {
+    uint32_t    line = 0;
+    std::string file;
+    std::string function;
+    std::string format;
+};
+
+// Bounds-checked cursor over the whole file
+class Reader {
+public:
+    explicit Reader(const std::vector<char> &data)
+        : _data(data) { }
+
+    bool AtEnd() const { return _pos >= _data.size(); }
+
+    bool Bytes(void *out, size_t size) {
+        if (_data.size() - _pos < size) {
+            return false;
+        }
+        std::memcpy(out, _data.data() + _pos, size);
+        _pos += size;
+        return true;
+    }
+
+    template <typename T>
+    bool Value(T &out) { return Bytes(&out, sizeof(T)); }
+
+    bool String(std::string &out) {
+        uint32_t length = 0;
+        if (!Value(length) || _data.size() - _pos < length) {
+            return false;
+        }
+        out.assign(_data.data() + _pos, length);
+        _pos += length;
+        return true;
+    }
+
+    size_t Position() const { return _pos; }
+
+private:
+    const std::vector<char> &_data;
+    size_t                   _pos = 0;
+};
+
+std::chrono::system_clock::time_point fromNanoseconds(int64_t ns) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+bool parseLevel(const char *name, LogLevel &out) {
+    static const char *names[] = { "debug", "info", "warning", "error", "critical" };
+    for (int i = 0; i < 5; ++i) {
+        if (std::strcmp(name, names[i]) == 0) {
+            out = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *path     = nullptr;
+    bool        color    = false;
+    LogLevel    minLevel = LogLevel::Debug;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--color") == 0) {
+            color = true;
+        } else if (std::strcmp(argv[i], "--min-level") == 0 && i + 1 < argc) {
+            if (!parseLevel(argv[++i], minLevel)) {
+                std::fprintf(stderr, "log_decoder: unknown level '%s'\n", argv[i]);
+                return 2;
+            }
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            path = nullptr;
+            break;
+        }
+    }
+    if (!path) {
+        std::fprintf(stderr, "usage: log_decoder <file.lumilog> [--color] [--min-level debug|info|warning|error|critical]\n");
+        return 2;
+    }
+
+    FILE *file = std::fopen(path, "rb");
+    if (!file) {
+        std::fprintf(stderr, "log_decoder: cannot open %s\n", path);
+        return 1;
+    }
+    std::vector<char> data;
+    char              chunk[64 * 1024];
+    size_t            got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + got);
+    }
+    std::fclose(file);
+
+    Reader   in(data);
+    char     magic[sizeof(BinaryFileSink::MAGIC)];
+    uint32_t version = 0;
+    if (!in.Bytes(magic, sizeof(magic)) || std::memcmp(magic, BinaryFileSink::MAGIC, sizeof(magic)) != 0 || !in.Value(version)) {
+        std::fprintf(stderr, "log_decoder: %s is not a binary log\n", path);
+        return 1;
+    }
+    if (version != BinaryFileSink::VERSION) {
+        std::fprintf(stderr, "log_decoder: unsupported log version %u (expected %u)\n", version, BinaryFileSink::VERSION);
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, Site> sites;
+    std::string                        payload;
+    size_t                             printed = 0;
+
+    auto emit = [&](const LogEntry &entry) {
+        if (entry.level < minLevel) {
+            return;
+        }
+        std::printf("%s\n", color ? entry.ToColoredString().c_str() : entry.ToString().c_str());
+        ++printed;
+    };
+
+    while (!in.AtEnd()) {
+        const size_t blockStart = in.Position();
+        uint8_t      kind       = 0;
+        bool         ok         = in.Value(kind);
+
+        if (ok && kind == static_cast<uint8_t>(BinaryFileSink::Block::Site)) {
+            uint32_t id = 0;
+            Site     site;
+            ok = in.Value(id) && in.Value(site.line) && in.String(site.file) && in.String(site.function) && in.String(site.format);
+            if (ok) {
+                sites[id] = std::move(site);
+            }
+        } else if (ok && kind == static_cast<uint8_t>(BinaryFileSink::Block::Record)) {
+            uint32_t siteId = 0, size = 0;
+            uint8_t  level = 0, flags = 0;
+            int64_t  timestamp = 0;
+            ok = in.Value(siteId) && in.Value(level) && in.Value(flags) && in.Value(timestamp) && in.Value(size);
+            payload.resize(size);
+            ok = ok && in.Bytes(payload.data(), size);
+
+            auto site = sites.find(siteId);
+            if (ok && site != sites.end()) {
+                LogEntry entry;
+                entry.timestamp    = fromNanoseconds(timestamp);
+                entry.level        = static_cast<LogLevel>(level);
+                entry.file         = site->second.file;
+                entry.line         = static_cast<int>(site->second.line);
+                entry.function     = site->second.function;
+                entry.isUserFacing = (flags & BinaryFileSink::FLAG_USER_FACING) != 0;
+                entry.message      = (flags & BinaryFileSink::FLAG_ENCODED)
+                         ? LogArgs::Format(site->second.format, payload.data(), payload.size())
+                         : payload;
+                emit(entry);
+            } else if (ok) {
+                std::fprintf(stderr, "log_decoder: record at offset %zu references unknown site %u\n", blockStart, siteId);
+            }
+        } else if (ok && kind == static_cast<uint8_t>(BinaryFileSink::Block::Entry)) {
+            LogEntry entry;
+            uint8_t  level = 0, flags = 0;
+            int64_t  timestamp = 0;
+            uint32_t line      = 0;
+            ok = in.Value(level) && in.Value(flags) && in.Value(timestamp) && in.Value(line)
+                && in.String(entry.file) && in.String(entry.function) && in.String(entry.message);
+            if (ok) {
+                entry.timestamp    = fromNanoseconds(timestamp);
+                entry.level        = static_cast<LogLevel>(level);
+                entry.line         = static_cast<int>(line);
+                entry.isUserFacing = (flags & BinaryFileSink::FLAG_USER_FACING) != 0;
+                emit(entry);
+            }
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            // A log cut short by a crash ends mid-block; everything before it is still good
+            std::fprintf(stderr, "log_decoder: truncated or corrupt block at offset %zu, stopping\n", blockStart);
+            break;
+        }
+    }
+
+    std::fprintf(stderr, "log_decoder: %zu entries, %zu call sites\n", printed, sites.size());
+    return 0;
+}